@@ -0,0 +1,112 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+
+#include <iostream>
+#include <cstdlib>
+#include <vector>
+
+#include "brics_3d/core/ColorSpaceConvertor.h"
+#include "brics_3d/core/PointCloud3DContiguous.h"
+#include "brics_3d/algorithm/filtering/ColorBasedROIExtractorHSV.h"
+#include "brics_3d/algorithm/filtering/ColorBasedROIExtractorRGB.h"
+#include "brics_3d/util/Timer.h"
+#include "brics_3d/util/Benchmark.h"
+
+
+using namespace std;
+using namespace brics_3d;
+
+/*
+ * Color segmentation of random 640x480 frames. Measured are the scalar and the batch RGB to HSV
+ * conversion of all pixels as well as the HSV and RGB ROI extraction on a colored
+ * PointCloud3DContiguous.
+ */
+int main(int argc, char **argv) {
+
+	int numberOfRuns = 20;
+	const unsigned int width = 640;
+	const unsigned int height = 480;
+	const unsigned int numberOfPixels = width * height;
+	unsigned int seed = 0; // make sure, seed is always the same.
+	long double tmpTimeStamp;
+
+	Timer timer0;
+	ColorSpaceConvertor colorConvertor;
+	ColorBasedROIExtractorHSV hsvFilter;
+	hsvFilter.setMinH(80);
+	hsvFilter.setMaxH(100);
+	hsvFilter.setMinS(100);
+	hsvFilter.setMaxS(255);
+	ColorBasedROIExtractorRGB rgbFilter;
+	rgbFilter.setGreen(255);
+	rgbFilter.setDistanceThresholdMaximum(130.0);
+
+	Benchmark benchColor("colorSegmentation_cost");
+	benchColor.output << "#Color segmentation of a " << width << "x" << height << " frame. All times in [ms]." << endl;
+	benchColor.output << "#run\t scalarHSV\t batchHSV\t hsvExtraction\t hsvSize\t rgbExtraction\t rgbSize\t" << endl;
+
+	std::srand(seed);
+	PointCloud3DContiguous frame;
+	frame.reserve(numberOfPixels);
+	frame.enableColors();
+	for (unsigned int i = 0; i < numberOfPixels; ++i) {
+		frame.addPoint(static_cast<double>(i % width), static_cast<double>(i / width), 1.0);
+	}
+	std::vector<double> scalarHsv(3 * numberOfPixels);
+	std::vector<unsigned char> batchHsv(3 * numberOfPixels);
+
+	for (int i = 1; i <= numberOfRuns; ++i) {
+		unsigned char* rgb = frame.getColors();
+		for (unsigned int j = 0; j < 3 * numberOfPixels; ++j) {
+			rgb[j] = static_cast<unsigned char>(std::rand() % 256);
+		}
+		benchColor.output << i << "\t";
+
+		timer0.reset();
+		for (unsigned int j = 0; j < numberOfPixels; ++j) {
+			colorConvertor.rgbToHsv(rgb[3 * j], rgb[3 * j + 1], rgb[3 * j + 2], &scalarHsv[3 * j], &scalarHsv[3 * j + 1], &scalarHsv[3 * j + 2]);
+		}
+		tmpTimeStamp = timer0.getElapsedTime();
+		benchColor.output << tmpTimeStamp << "\t";
+
+		timer0.reset();
+		ColorSpaceConvertor::rgbToHsv(rgb, &batchHsv[0], numberOfPixels);
+		tmpTimeStamp = timer0.getElapsedTime();
+		benchColor.output << tmpTimeStamp << "\t";
+
+		PointCloud3DContiguous result;
+		timer0.reset();
+		hsvFilter.filter(&frame, &result);
+		tmpTimeStamp = timer0.getElapsedTime();
+		benchColor.output << tmpTimeStamp << "\t" << result.getSize() << "\t";
+
+		timer0.reset();
+		rgbFilter.filter(&frame, &result);
+		tmpTimeStamp = timer0.getElapsedTime();
+		benchColor.output << tmpTimeStamp << "\t" << result.getSize() << endl;
+
+		cout << "Processed frame " << i << "." << endl;
+	}
+
+	cout << "Done." << endl;
+}
+
+
+/* EOF */
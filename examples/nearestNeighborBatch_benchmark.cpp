@@ -0,0 +1,132 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+
+#include <iostream>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "brics_3d/core/PointCloud3D.h"
+#include "brics_3d/algorithm/nearestNeighbor/NearestNeighborANN.h"
+#include "brics_3d/algorithm/nearestNeighbor/NearestNeighborFLANN.h"
+#include "brics_3d/algorithm/nearestNeighbor/NearestNeighborSTANN.h"
+#include "brics_3d/algorithm/nearestNeighbor/NearestNeighborKDTree.h"
+#include "brics_3d/util/Timer.h"
+#include "brics_3d/util/Benchmark.h"
+
+
+using namespace std;
+using namespace brics_3d;
+
+/*
+ * Throughput of the batch k nearest neighbor queries compared to one query per point. Every point
+ * of the (stacked and jittered) example scans is queried against the scans themselves, as it is done
+ * by e.g. the normal estimation. The batch is measured with a single thread and with as many threads
+ * as the hardware supports; only STANN and the built-in kd-tree support concurrent queries.
+ */
+template <typename NearestNeighborT>
+static void measureQueries(NearestNeighborT* nearestNeighborSearch, PointCloud3D* pointCloud, unsigned int k, Benchmark& benchmark, Timer& timer) {
+	long double tmpTimeStamp;
+	nearestNeighborSearch->setData(pointCloud);
+
+	std::vector<int> resultIndices;
+	std::vector<double> squaredDistances;
+	unsigned int numberOfNeighbors = 0;
+	timer.reset();
+	for (unsigned int i = 0; i < pointCloud->getSize(); ++i) {
+		nearestNeighborSearch->findNearestNeighbors(&(*pointCloud->getPointCloud())[i], &resultIndices, &squaredDistances, k);
+		numberOfNeighbors += static_cast<unsigned int>(resultIndices.size());
+	}
+	tmpTimeStamp = timer.getElapsedTime();
+	benchmark.output << tmpTimeStamp << "\t";
+
+	NearestNeighborBatchResult result;
+	nearestNeighborSearch->setMaxNumberOfThreads(1);
+	timer.reset();
+	nearestNeighborSearch->findNearestNeighbors(pointCloud, &result, k);
+	tmpTimeStamp = timer.getElapsedTime();
+	benchmark.output << tmpTimeStamp << "\t";
+
+	nearestNeighborSearch->setMaxNumberOfThreads(0);
+	timer.reset();
+	nearestNeighborSearch->findNearestNeighbors(pointCloud, &result, k);
+	tmpTimeStamp = timer.getElapsedTime();
+	benchmark.output << tmpTimeStamp << "\t";
+
+	if (result.indices.size() != numberOfNeighbors) {
+		cout << "WARNING: batch and single queries found a different number of neighbors." << endl;
+	}
+}
+
+int main(int argc, char **argv) {
+
+	int numberOfRuns = 5;
+	unsigned int k = 10;
+	unsigned int seed = 0; // make sure, seed is always the same.
+	double jitter = 0.005;
+
+	const char* scanNames[] = {"/scan1.txt", "/scan2.txt", "/scan3.txt"};
+	PointCloud3D scans;
+	for (int i = 0; i < 3; ++i) {
+		string filename = string(BRICS_MODELS_DIR) + scanNames[i];
+		scans.readFromTxtFile(filename);
+	}
+	if (scans.getSize() == 0) {
+		cout << "ERROR: could not load the scans from " << BRICS_MODELS_DIR << endl;
+		return -1;
+	}
+
+	Timer timer0;
+	NearestNeighborANN nearestNeighborANN;
+	NearestNeighborFLANN nearestNeighborFLANN;
+	NearestNeighborSTANN nearestNeighborSTANN;
+	NearestNeighborKDTree nearestNeighborKDTree;
+
+	Benchmark benchBatch("nearestNeighborBatch_cost");
+	benchBatch.output << "#k nearest neighbors (k=" << k << ") of every point of the stacked example scans: one query per point, batch with one thread and batch with all threads. All times in [ms]." << endl;
+	benchBatch.output << "#nPts\t singleANN\t batchANN\t batchANNMultiThread\t singleFLANN\t batchFLANN\t batchFLANNMultiThread\t singleSTANN\t batchSTANN\t batchSTANNMultiThread\t singleKDTree\t batchKDTree\t batchKDTreeMultiThread\t" << endl;
+
+	std::srand(seed);
+	for (int i = 1; i <= numberOfRuns; ++i) {
+		PointCloud3D pointCloud;
+		for (int copy = 0; copy < i * 2; ++copy) {
+			for (unsigned int j = 0; j < scans.getSize(); ++j) {
+				Point3D& point = (*scans.getPointCloud())[j];
+				pointCloud.addPoint(Point3D(point.getX() + jitter * (std::rand() / (RAND_MAX + 1.0) - 0.5),
+						point.getY() + jitter * (std::rand() / (RAND_MAX + 1.0) - 0.5),
+						point.getZ() + jitter * (std::rand() / (RAND_MAX + 1.0) - 0.5)));
+			}
+		}
+		benchBatch.output << pointCloud.getSize() << "\t";
+
+		measureQueries(&nearestNeighborANN, &pointCloud, k, benchBatch, timer0);
+		measureQueries(&nearestNeighborFLANN, &pointCloud, k, benchBatch, timer0);
+		measureQueries(&nearestNeighborSTANN, &pointCloud, k, benchBatch, timer0);
+		measureQueries(&nearestNeighborKDTree, &pointCloud, k, benchBatch, timer0);
+		benchBatch.output << endl;
+
+		cout << "Processed " << pointCloud.getSize() << " points." << endl;
+	}
+
+	cout << "Done." << endl;
+}
+
+
+/* EOF */
@@ -0,0 +1,127 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+
+#include <iostream>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "brics_3d/core/PointCloud3D.h"
+#include "brics_3d/algorithm/nearestNeighbor/NearestNeighborANN.h"
+#include "brics_3d/algorithm/nearestNeighbor/NearestNeighborFLANN.h"
+#include "brics_3d/algorithm/nearestNeighbor/NearestNeighborSTANN.h"
+#include "brics_3d/algorithm/nearestNeighbor/NearestNeighborVoxelHash.h"
+#include "brics_3d/util/Timer.h"
+#include "brics_3d/util/Benchmark.h"
+
+
+using namespace std;
+using namespace brics_3d;
+
+/*
+ * Fixed radius neighborhoods with the hash grid compared to the trees of ANN, FLANN and STANN. Every point
+ * of the (stacked and jittered) example scans is queried against the scans themselves: once with a radius
+ * search as done by the Euclidean clustering and once for its k nearest neighbors as done by the normal
+ * estimation. The cell size of the grid equals the radius. The build is timed separately, the queries
+ * are issued one by one with a single thread.
+ */
+template <typename NearestNeighborT>
+static void measureQueries(NearestNeighborT* nearestNeighborSearch, PointCloud3D* pointCloud, double radius, unsigned int k, Benchmark& benchmark, Timer& timer) {
+	long double tmpTimeStamp;
+	timer.reset();
+	nearestNeighborSearch->setData(pointCloud);
+	tmpTimeStamp = timer.getElapsedTime();
+	benchmark.output << tmpTimeStamp << "\t";
+
+	std::vector<int> resultIndices;
+	std::vector<double> squaredDistances;
+	unsigned int numberOfNeighbors = 0;
+	timer.reset();
+	for (unsigned int i = 0; i < pointCloud->getSize(); ++i) {
+		nearestNeighborSearch->findNeighborsWithinRadius(&(*pointCloud->getPointCloud())[i], radius, &resultIndices, &squaredDistances);
+		numberOfNeighbors += static_cast<unsigned int>(resultIndices.size());
+	}
+	tmpTimeStamp = timer.getElapsedTime();
+	benchmark.output << tmpTimeStamp << "\t" << numberOfNeighbors << "\t";
+
+	timer.reset();
+	for (unsigned int i = 0; i < pointCloud->getSize(); ++i) {
+		nearestNeighborSearch->findNearestNeighbors(&(*pointCloud->getPointCloud())[i], &resultIndices, &squaredDistances, k);
+	}
+	tmpTimeStamp = timer.getElapsedTime();
+	benchmark.output << tmpTimeStamp << "\t";
+}
+
+int main(int argc, char **argv) {
+
+	int numberOfRuns = 5;
+	unsigned int k = 10;
+	double radius = 0.05;
+	unsigned int seed = 0; // make sure, seed is always the same.
+	double jitter = 0.005;
+
+	const char* scanNames[] = {"/scan1.txt", "/scan2.txt", "/scan3.txt"};
+	PointCloud3D scans;
+	for (int i = 0; i < 3; ++i) {
+		string filename = string(BRICS_MODELS_DIR) + scanNames[i];
+		scans.readFromTxtFile(filename);
+	}
+	if (scans.getSize() == 0) {
+		cout << "ERROR: could not load the scans from " << BRICS_MODELS_DIR << endl;
+		return -1;
+	}
+
+	Timer timer0;
+	NearestNeighborANN nearestNeighborANN;
+	NearestNeighborFLANN nearestNeighborFLANN;
+	NearestNeighborSTANN nearestNeighborSTANN;
+	NearestNeighborVoxelHash nearestNeighborVoxelHash(radius);
+
+	Benchmark benchVoxelHash("nearestNeighborVoxelHash_cost");
+	benchVoxelHash.output << "#Build, radius search (r=" << radius << ") and k nearest neighbors (k=" << k << ") for every point of the stacked example scans. All times in [ms], radius search times are followed by the number of neighbors." << endl;
+	benchVoxelHash.output << "#nPts\t buildANN\t radiusANN\t\t kNearestANN\t buildFLANN\t radiusFLANN\t\t kNearestFLANN\t buildSTANN\t radiusSTANN\t\t kNearestSTANN\t buildVoxelHash\t radiusVoxelHash\t\t kNearestVoxelHash\t" << endl;
+
+	std::srand(seed);
+	for (int i = 1; i <= numberOfRuns; ++i) {
+		PointCloud3D pointCloud;
+		for (int copy = 0; copy < i * 2; ++copy) {
+			for (unsigned int j = 0; j < scans.getSize(); ++j) {
+				Point3D& point = (*scans.getPointCloud())[j];
+				pointCloud.addPoint(Point3D(point.getX() + jitter * (std::rand() / (RAND_MAX + 1.0) - 0.5),
+						point.getY() + jitter * (std::rand() / (RAND_MAX + 1.0) - 0.5),
+						point.getZ() + jitter * (std::rand() / (RAND_MAX + 1.0) - 0.5)));
+			}
+		}
+		benchVoxelHash.output << pointCloud.getSize() << "\t";
+
+		measureQueries(&nearestNeighborANN, &pointCloud, radius, k, benchVoxelHash, timer0);
+		measureQueries(&nearestNeighborFLANN, &pointCloud, radius, k, benchVoxelHash, timer0);
+		measureQueries(&nearestNeighborSTANN, &pointCloud, radius, k, benchVoxelHash, timer0);
+		measureQueries(&nearestNeighborVoxelHash, &pointCloud, radius, k, benchVoxelHash, timer0);
+		benchVoxelHash.output << endl;
+
+		cout << "Processed " << pointCloud.getSize() << " points." << endl;
+	}
+
+	cout << "Done." << endl;
+}
+
+
+/* EOF */
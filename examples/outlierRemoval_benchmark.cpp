@@ -0,0 +1,135 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+
+#include <iostream>
+#include <cstdlib>
+#include <algorithm>
+#include <string>
+
+#include "brics_3d/core/PointCloud3D.h"
+#include "brics_3d/algorithm/filtering/StatisticalOutlierRemoval.h"
+#include "brics_3d/algorithm/filtering/RadiusOutlierRemoval.h"
+#include "brics_3d/algorithm/nearestNeighbor/NearestNeighborANN.h"
+#include "brics_3d/algorithm/nearestNeighbor/NearestNeighborFLANN.h"
+#include "brics_3d/algorithm/nearestNeighbor/NearestNeighborSTANN.h"
+#include "brics_3d/util/Timer.h"
+#include "brics_3d/util/Benchmark.h"
+
+
+using namespace std;
+using namespace brics_3d;
+
+/*
+ * Outlier removal on the example scans. Every run stacks the scans several times with a small
+ * jitter (to get bigger point clouds) and adds 1% uniformly distributed noise points. The
+ * StatisticalOutlierRemoval and the RadiusOutlierRemoval are measured with the ANN and the FLANN
+ * search as well as with the STANN search with one and with all available threads.
+ */
+static void measure(NeighborDistanceFilter* filter, PointCloud3D* pointCloud, Benchmark& benchmark, Timer& timer) {
+	long double tmpTimeStamp;
+	PointCloud3D result;
+	timer.reset();
+	filter->filter(pointCloud, &result);
+	tmpTimeStamp = timer.getElapsedTime();
+	benchmark.output << tmpTimeStamp << "\t" << result.getSize() << "\t";
+}
+
+int main(int argc, char **argv) {
+
+	int numberOfRuns = 5;
+	unsigned int seed = 0; // make sure, seed is always the same.
+	double jitter = 0.005;
+	double noiseRatio = 0.01;
+
+	const char* scanNames[] = {"/scan1.txt", "/scan2.txt", "/scan3.txt"};
+	PointCloud3D scans;
+	for (int i = 0; i < 3; ++i) {
+		string filename = string(BRICS_MODELS_DIR) + scanNames[i];
+		scans.readFromTxtFile(filename);
+	}
+	if (scans.getSize() == 0) {
+		cout << "ERROR: could not load the scans from " << BRICS_MODELS_DIR << endl;
+		return -1;
+	}
+
+	/* bounding box for the noise */
+	double minX = (*scans.getPointCloud())[0].getX(), maxX = minX;
+	double minY = (*scans.getPointCloud())[0].getY(), maxY = minY;
+	double minZ = (*scans.getPointCloud())[0].getZ(), maxZ = minZ;
+	for (unsigned int i = 0; i < scans.getSize(); ++i) {
+		Point3D& point = (*scans.getPointCloud())[i];
+		minX = std::min(minX, point.getX()); maxX = std::max(maxX, point.getX());
+		minY = std::min(minY, point.getY()); maxY = std::max(maxY, point.getY());
+		minZ = std::min(minZ, point.getZ()); maxZ = std::max(maxZ, point.getZ());
+	}
+
+	Timer timer0;
+	StatisticalOutlierRemoval statisticalFilter(8, 1.0);
+	RadiusOutlierRemoval radiusFilter(0.05, 4);
+
+	Benchmark benchOutlier("outlierRemoval_cost");
+	benchOutlier.output << "#Outlier removal on the example scans with " << noiseRatio * 100 << "% noise. All times in [ms], followed by the remaining points." << endl;
+	benchOutlier.output << "#nPts\t statANN\t\t statFLANN\t\t statSTANNSingleThread\t\t statSTANNMultiThread\t\t radiusANN\t\t radiusFLANN\t\t radiusSTANNSingleThread\t\t radiusSTANNMultiThread\t\t" << endl;
+
+	std::srand(seed);
+	for (int i = 1; i <= numberOfRuns; ++i) {
+		PointCloud3D pointCloud;
+		for (int copy = 0; copy < i * 10; ++copy) {
+			for (unsigned int j = 0; j < scans.getSize(); ++j) {
+				Point3D& point = (*scans.getPointCloud())[j];
+				pointCloud.addPoint(Point3D(point.getX() + jitter * (std::rand() / (RAND_MAX + 1.0) - 0.5),
+						point.getY() + jitter * (std::rand() / (RAND_MAX + 1.0) - 0.5),
+						point.getZ() + jitter * (std::rand() / (RAND_MAX + 1.0) - 0.5)));
+			}
+		}
+		unsigned int numberOfNoisePoints = static_cast<unsigned int>(pointCloud.getSize() * noiseRatio);
+		for (unsigned int j = 0; j < numberOfNoisePoints; ++j) {
+			pointCloud.addPoint(Point3D(minX + (maxX - minX) * std::rand() / RAND_MAX,
+					minY + (maxY - minY) * std::rand() / RAND_MAX,
+					minZ + (maxZ - minZ) * std::rand() / RAND_MAX));
+		}
+		benchOutlier.output << pointCloud.getSize() << "\t";
+
+		NeighborDistanceFilter* filters[] = {&statisticalFilter, &radiusFilter};
+		for (int f = 0; f < 2; ++f) {
+			filters[f]->setMaxNumberOfThreads(0);
+			filters[f]->setNearestNeighborAlgorithm(new NearestNeighborANN());
+			measure(filters[f], &pointCloud, benchOutlier, timer0);
+
+			filters[f]->setNearestNeighborAlgorithm(new NearestNeighborFLANN());
+			measure(filters[f], &pointCloud, benchOutlier, timer0);
+
+			filters[f]->setNearestNeighborAlgorithm(new NearestNeighborSTANN());
+			filters[f]->setMaxNumberOfThreads(1);
+			measure(filters[f], &pointCloud, benchOutlier, timer0);
+
+			filters[f]->setMaxNumberOfThreads(0);
+			measure(filters[f], &pointCloud, benchOutlier, timer0);
+		}
+		benchOutlier.output << endl;
+
+		cout << "Processed " << pointCloud.getSize() << " points." << endl;
+	}
+
+	cout << "Done." << endl;
+}
+
+
+/* EOF */
@@ -0,0 +1,111 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+#include <iostream>
+#include <cstdlib>
+
+#include "brics_3d/core/PointCloud3D.h"
+#include "brics_3d/core/ColoredPoint3D.h"
+#include "brics_3d/core/Point3DArena.h"
+#include "brics_3d/util/Timer.h"
+#include "brics_3d/util/Benchmark.h"
+
+
+using namespace std;
+using namespace brics_3d;
+
+/*
+ * Allocation throughput of decorated points on the heap compared to a per frame arena.
+ * One "frame" creates a colored point cloud, clones all points into a second point cloud
+ * (as the ROI extractors and the segmentation do) and releases both point clouds again.
+ * Both point clouds use the given arena; a null pointer means the heap.
+ */
+static void processFrame(int numberOfPoints, Point3DArena::Point3DArenaPtr arena, Benchmark& benchmark, Timer& timer) {
+	long double tmpTimeStamp;
+	PointCloud3D* pointCloud = new PointCloud3D();
+	PointCloud3D* resultPointCloud = new PointCloud3D();
+	pointCloud->setArena(arena);
+	resultPointCloud->setArena(arena);
+	ColoredPoint3D prototype(new Point3D(), 1, 2, 3);
+
+	timer.reset();
+	pointCloud->reserve(numberOfPoints);
+	for (int j = 0; j < numberOfPoints; ++j) {
+		prototype.setX(std::rand());
+		prototype.setY(std::rand());
+		prototype.setZ(std::rand());
+		pointCloud->addPointClone(prototype);
+	}
+	tmpTimeStamp = timer.getElapsedTime();
+	benchmark.output << tmpTimeStamp << "\t";
+
+	timer.reset();
+	resultPointCloud->reserve(numberOfPoints);
+	for (int j = 0; j < numberOfPoints; ++j) {
+		resultPointCloud->addPointClone((*pointCloud->getPointCloud())[j]);
+	}
+	tmpTimeStamp = timer.getElapsedTime();
+	benchmark.output << tmpTimeStamp << "\t";
+
+	timer.reset();
+	delete resultPointCloud;
+	delete pointCloud;
+	tmpTimeStamp = timer.getElapsedTime();
+	benchmark.output << tmpTimeStamp << "\t";
+}
+
+int main(int argc, char **argv) {
+
+	int numberOfRuns = 15;
+	int stepSize = 100000;
+	unsigned int seed = 0; // make sure, seed is always the same.
+	long double tmpTimeStamp;
+
+	Timer timer0;
+	Point3DArena::Point3DArenaPtr frameArena(new Point3DArena());
+
+	Benchmark benchArena("point3D_cost_arenaAllocation");
+	benchArena.output << "#Allocation of ColoredPoint3D objects: heap vs. Point3DArena. All times in [ms]." << endl;
+	benchArena.output << "#Size of decorated ColoredPoint3D: " << sizeof(ColoredPoint3D) << " + " << sizeof(Point3D) << endl;
+	benchArena.output << "#nPts\t heapCreate\t heapClone\t heapRelease\t arenaCreate\t arenaClone\t arenaRelease\t arenaReset\t" << endl;
+
+	for (int i = 1; i <= numberOfRuns; ++i) {
+		int numberOfPoints = i * stepSize;
+		benchArena.output << numberOfPoints << "\t";
+
+		/* global allocator */
+		std::srand(seed);
+		processFrame(numberOfPoints, Point3DArena::Point3DArenaPtr(), benchArena, timer0);
+
+		/* per frame arena */
+		std::srand(seed);
+		processFrame(numberOfPoints, frameArena, benchArena, timer0);
+		timer0.reset();
+		frameArena->reset();
+		tmpTimeStamp = timer0.getElapsedTime();
+		benchArena.output << tmpTimeStamp << endl; // time to release the arena itself
+
+		cout << "Processed " << numberOfPoints << " points." << endl;
+	}
+
+	cout << "Done." << endl;
+}
+
+
+/* EOF */
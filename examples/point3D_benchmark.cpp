@@ -23,7 +23,8 @@
 #include "brics_3d/core/PointCloud3D.h"
 #include "brics_3d/core/ColoredPoint3D.h"
 #include "brics_3d/core/HomogeneousMatrix44.h"
-#include "brics_3d/util/OSGPointCloudVisualizer.h"
+#include "brics_3d/core/PointCloud3DContiguous.h"
+#include "brics_3d/core/HomogeneousTransformationKernel.h"
 #include "brics_3d/util/Timer.h"
 #include "brics_3d/util/Benchmark.h"
 
@@ -33,6 +34,7 @@ using namespace brics_3d;
 
 #define STD_POINT
 //#define RGB_POINT
+#define CONTIGUOUS_POINT
 
 int main(int argc, char **argv) {
 
@@ -46,6 +48,7 @@ int main(int argc, char **argv) {
 	Timer timer0;
 	PointCloud3D* pointCloud = new PointCloud3D();
 	PointCloud3D* coloredPointCloud = new PointCloud3D();
+	PointCloud3DContiguous* contiguousPointCloud = new PointCloud3DContiguous();
 	IHomogeneousMatrix44* transfomation = new HomogeneousMatrix44(1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 1.0, 2.0, 3.0);
 
 #ifdef STD_POINT
@@ -60,6 +63,14 @@ int main(int argc, char **argv) {
 	benchHomogenTransRGB.output <<	"#nPts\t transformTime\t" << endl;
 #endif /* RGB_POINT */
 
+#ifdef CONTIGUOUS_POINT
+	Benchmark benchHomogenTransContiguous("point3D_cost_homogenTransContiguous");
+	benchHomogenTransContiguous.output << "#Comparison of the per point transformation of a PointCloud3D with the batched kernel of a PointCloud3DContiguous" << endl;
+	benchHomogenTransContiguous.output << "#Parallel threshold of the kernel: " << HomogeneousTransformationKernel::parallelThreshold << " points" << endl;
+	benchHomogenTransContiguous.output <<	"#nPts\t perPointTransformTime\t kernelTransformTime\t" << endl;
+	PointCloud3D* referencePointCloud = new PointCloud3D();
+#endif /* CONTIGUOUS_POINT */
+
 	for (int i = 0; i < numberOfRuns; ++i) {
 
 #ifdef STD_POINT
@@ -79,6 +90,15 @@ int main(int argc, char **argv) {
 		benchHomogenTransRGB.output << coloredPointCloud->getSize() << "\t";
 #endif /* RGB_POINT */
 
+#ifdef CONTIGUOUS_POINT
+		for (int j = 0; j < stepSize; ++j) {
+			Point3D tmpPoint = Point3D(std::rand(), std::rand(), std::rand());
+			referencePointCloud->addPoint(tmpPoint);
+			contiguousPointCloud->addPoint(tmpPoint);
+		}
+		benchHomogenTransContiguous.output << contiguousPointCloud->getSize() << "\t";
+#endif /* CONTIGUOUS_POINT */
+
 
 		/*
 		 * perform all needed tests
@@ -102,11 +122,28 @@ int main(int argc, char **argv) {
 //		cout << timer0.getElapsedTime();
 #endif /* RGB_POINT */
 
+#ifdef CONTIGUOUS_POINT
+		/* old per point path vs. batched kernel on the same data */
+		timer0.reset();
+		referencePointCloud->homogeneousTransformation(transfomation);
+		tmpTimeStamp = timer0.getElapsedTime();
+		benchHomogenTransContiguous.output << tmpTimeStamp << "\t";
+
+		timer0.reset();
+		contiguousPointCloud->homogeneousTransformation(transfomation);
+		tmpTimeStamp = timer0.getElapsedTime();
+		benchHomogenTransContiguous.output << tmpTimeStamp << endl;
+#endif /* CONTIGUOUS_POINT */
+
 	}
 
 //	OSGPointCloudVisualizer* visualizer = new OSGPointCloudVisualizer();
 //	visualizer->visualizePointCloud(pointCloud);
+#ifdef CONTIGUOUS_POINT
+	delete referencePointCloud;
+#endif /* CONTIGUOUS_POINT */
 	delete transfomation;
+	delete contiguousPointCloud;
 	delete coloredPointCloud;
 	delete pointCloud;
 	cout << "Done." << endl;
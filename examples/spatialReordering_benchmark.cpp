@@ -0,0 +1,162 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+
+#include <iostream>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "brics_3d/core/PointCloud3D.h"
+#include "brics_3d/core/NormalSet3D.h"
+#include "brics_3d/core/SpatialReordering.h"
+#include "brics_3d/algorithm/featureExtraction/NormalEstimation.h"
+#include "brics_3d/algorithm/segmentation/EuclideanClustering.h"
+#include "brics_3d/algorithm/nearestNeighbor/NearestNeighborANN.h"
+#include "brics_3d/algorithm/filtering/StrideSubsampling.h"
+#include "brics_3d/util/Timer.h"
+#include "brics_3d/util/Benchmark.h"
+
+
+using namespace std;
+using namespace brics_3d;
+
+/*
+ * Effect of the spatial reordering on neighborhood based algorithms. Every run stacks the example scans
+ * several times with a small jitter, as if several scans of the same scene were merged. Thus points that
+ * are close in space are far apart in memory. The NormalEstimation is measured on the point cloud in
+ * its original order as well as in Morton and Hilbert order. The EuclideanClustering is measured on a
+ * subsampled version, as it is much more expensive.
+ */
+static void measureNormalEstimation(PointCloud3D* pointCloud, Benchmark& benchmark, Timer& timer) {
+	long double tmpTimeStamp;
+	NormalEstimation normalEstimator;
+	NearestNeighborANN nearestNeighborSearch;
+	NormalSet3D normals;
+	timer.reset();
+	normalEstimator.setInputCloud(pointCloud);
+	normalEstimator.setSearchMethod(&nearestNeighborSearch);
+	normalEstimator.setkneighbours(10);
+	normalEstimator.computeFeature(&normals);
+	tmpTimeStamp = timer.getElapsedTime();
+	benchmark.output << tmpTimeStamp << "\t";
+}
+
+static void measureClustering(PointCloud3D* pointCloud, Benchmark& benchmark, Timer& timer) {
+	long double tmpTimeStamp;
+	EuclideanClustering clusterExtractor;
+	clusterExtractor.setClusterTolerance(0.05);
+	clusterExtractor.setMinClusterSize(10);
+	clusterExtractor.setMaxClusterSize(pointCloud->getSize());
+	std::vector<PointCloud3D*> clusters;
+	timer.reset();
+	clusterExtractor.setPointCloud(pointCloud);
+	clusterExtractor.segment();
+	tmpTimeStamp = timer.getElapsedTime();
+	clusterExtractor.getExtractedClusters(clusters);
+	benchmark.output << tmpTimeStamp << "\t" << clusters.size() << "\t";
+	for (unsigned int i = 0; i < clusters.size(); ++i) {
+		delete clusters[i];
+	}
+}
+
+static void copyPointCloud(PointCloud3D* source, PointCloud3D* destination) {
+	destination->reserve(source->getSize());
+	for (unsigned int i = 0; i < source->getSize(); ++i) {
+		destination->addPointPtr((*source->getPointCloud())[i].clone());
+	}
+}
+
+int main(int argc, char **argv) {
+
+	int numberOfRuns = 5;
+	unsigned int seed = 0; // make sure, seed is always the same.
+	double jitter = 0.005;
+	unsigned int clusteringStride = 20;
+
+	const char* scanNames[] = {"/scan1.txt", "/scan2.txt", "/scan3.txt"};
+	PointCloud3D scans;
+	for (int i = 0; i < 3; ++i) {
+		string filename = string(BRICS_MODELS_DIR) + scanNames[i];
+		scans.readFromTxtFile(filename);
+	}
+	if (scans.getSize() == 0) {
+		cout << "ERROR: could not load the scans from " << BRICS_MODELS_DIR << endl;
+		return -1;
+	}
+
+	Timer timer0;
+	long double tmpTimeStamp;
+	SpatialReordering mortonReordering(SpatialReordering::mortonOrder);
+	SpatialReordering hilbertReordering(SpatialReordering::hilbertOrder);
+	StrideSubsampling subsampling(clusteringStride);
+
+	Benchmark benchReordering("spatialReordering_cost");
+	benchReordering.output << "#Normal estimation (k=10) and Euclidean clustering on stacked example scans in original, Morton and Hilbert order. All times in [ms], clustering times are followed by the number of clusters." << endl;
+	benchReordering.output << "#nPts\t reorderMorton\t reorderHilbert\t normalsOriginal\t normalsMorton\t normalsHilbert\t nPtsClustering\t clusteringOriginal\t\t clusteringMorton\t\t clusteringHilbert\t\t" << endl;
+
+	std::srand(seed);
+	for (int i = 1; i <= numberOfRuns; ++i) {
+		PointCloud3D pointCloud;
+		for (int copy = 0; copy < i * 4; ++copy) {
+			for (unsigned int j = 0; j < scans.getSize(); ++j) {
+				Point3D& point = (*scans.getPointCloud())[j];
+				pointCloud.addPoint(Point3D(point.getX() + jitter * (std::rand() / (RAND_MAX + 1.0) - 0.5),
+						point.getY() + jitter * (std::rand() / (RAND_MAX + 1.0) - 0.5),
+						point.getZ() + jitter * (std::rand() / (RAND_MAX + 1.0) - 0.5)));
+			}
+		}
+		benchReordering.output << pointCloud.getSize() << "\t";
+
+		PointCloud3D mortonPointCloud;
+		copyPointCloud(&pointCloud, &mortonPointCloud);
+		timer0.reset();
+		mortonReordering.reorder(&mortonPointCloud);
+		tmpTimeStamp = timer0.getElapsedTime();
+		benchReordering.output << tmpTimeStamp << "\t";
+
+		PointCloud3D hilbertPointCloud;
+		copyPointCloud(&pointCloud, &hilbertPointCloud);
+		timer0.reset();
+		hilbertReordering.reorder(&hilbertPointCloud);
+		tmpTimeStamp = timer0.getElapsedTime();
+		benchReordering.output << tmpTimeStamp << "\t";
+
+		measureNormalEstimation(&pointCloud, benchReordering, timer0);
+		measureNormalEstimation(&mortonPointCloud, benchReordering, timer0);
+		measureNormalEstimation(&hilbertPointCloud, benchReordering, timer0);
+
+		PointCloud3D subsampledPointCloud;
+		subsampling.filter(&pointCloud, &subsampledPointCloud);
+		benchReordering.output << subsampledPointCloud.getSize() << "\t";
+		measureClustering(&subsampledPointCloud, benchReordering, timer0);
+		mortonReordering.reorder(&subsampledPointCloud);
+		measureClustering(&subsampledPointCloud, benchReordering, timer0);
+		hilbertReordering.reorder(&subsampledPointCloud);
+		measureClustering(&subsampledPointCloud, benchReordering, timer0);
+		benchReordering.output << endl;
+
+		cout << "Processed " << pointCloud.getSize() << " points." << endl;
+	}
+
+	cout << "Done." << endl;
+}
+
+
+/* EOF */
@@ -0,0 +1,109 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+#include <iostream>
+#include <cstdlib>
+
+#include "brics_3d/core/PointCloud3D.h"
+#include "brics_3d/core/PointCloud3DContiguous.h"
+#include "brics_3d/algorithm/filtering/Octree.h"
+#include "brics_3d/algorithm/filtering/VoxelGridFilter.h"
+#include "brics_3d/util/Timer.h"
+#include "brics_3d/util/Benchmark.h"
+
+
+using namespace std;
+using namespace brics_3d;
+
+/*
+ * Size reduction of random point clouds (10m x 10m x 10m) with the Octree reduction filter
+ * and the VoxelGridFilter. The VoxelGridFilter is measured on a PointCloud3D as well as on
+ * a PointCloud3DContiguous with one and with all available threads.
+ */
+int main(int argc, char **argv) {
+
+	int numberOfRuns = 10;
+	int stepSize = 100000;
+	double voxelSize = 0.1;
+	unsigned int seed = 0; // make sure, seed is always the same.
+	long double tmpTimeStamp;
+
+	if (argc == 2) {
+		voxelSize = atof(argv[1]);
+	} else {
+		cout << "Usage: " << argv[0] << " <voxelSize>" << endl;
+		cout << "Using default voxel size " << voxelSize << endl;
+	}
+
+	Timer timer0;
+	Octree octree;
+	octree.setVoxelSize(voxelSize);
+	VoxelGridFilter voxelGrid(voxelSize);
+
+	Benchmark benchVoxelGrid("voxelGrid_cost_reduction");
+	benchVoxelGrid.output << "#Size reduction with voxel size " << voxelSize << ". All times in [ms]." << endl;
+	benchVoxelGrid.output << "#nPts\t octree\t octreeSize\t voxelGrid\t voxelGridSize\t contiguousSingleThread\t contiguousMultiThread\t" << endl;
+
+	std::srand(seed);
+	for (int i = 1; i <= numberOfRuns; ++i) {
+		int numberOfPoints = i * stepSize;
+		benchVoxelGrid.output << numberOfPoints << "\t";
+
+		PointCloud3D pointCloud;
+		pointCloud.reserve(numberOfPoints);
+		for (int j = 0; j < numberOfPoints; ++j) {
+			pointCloud.addPoint(Point3D(std::rand() % 10000 / 1000.0, std::rand() % 10000 / 1000.0, std::rand() % 10000 / 1000.0));
+		}
+		PointCloud3DContiguous contiguousCloud;
+		contiguousCloud.copyFrom(&pointCloud);
+
+		PointCloud3D octreeResult;
+		timer0.reset();
+		octree.filter(&pointCloud, &octreeResult);
+		tmpTimeStamp = timer0.getElapsedTime();
+		benchVoxelGrid.output << tmpTimeStamp << "\t" << octreeResult.getSize() << "\t";
+
+		PointCloud3D voxelGridResult;
+		voxelGrid.setMaxNumberOfThreads(0);
+		timer0.reset();
+		voxelGrid.filter(&pointCloud, &voxelGridResult);
+		tmpTimeStamp = timer0.getElapsedTime();
+		benchVoxelGrid.output << tmpTimeStamp << "\t" << voxelGridResult.getSize() << "\t";
+
+		PointCloud3DContiguous contiguousResult;
+		voxelGrid.setMaxNumberOfThreads(1);
+		timer0.reset();
+		voxelGrid.filter(contiguousCloud, contiguousResult);
+		tmpTimeStamp = timer0.getElapsedTime();
+		benchVoxelGrid.output << tmpTimeStamp << "\t";
+
+		voxelGrid.setMaxNumberOfThreads(0);
+		timer0.reset();
+		voxelGrid.filter(contiguousCloud, contiguousResult);
+		tmpTimeStamp = timer0.getElapsedTime();
+		benchVoxelGrid.output << tmpTimeStamp << endl;
+
+		cout << "Processed " << numberOfPoints << " points." << endl;
+	}
+
+	cout << "Done." << endl;
+}
+
+
+/* EOF */
@@ -49,6 +49,9 @@ void DepthImageToPointCloudTransformation::transformDepthImageToPointCloud(IplIm
 		return;
 	}
 
+	/* worst case: every pixel becomes a point */
+	pointCloud->reserve(pointCloud->getSize() + depthImage->height * depthImage->width);
+
 	/* loop over all pixels and add those who are above a certain threshold */
 	for (int row = 0; row < depthImage->height; ++row) {
 		for (int col = 0; col < depthImage->width; ++col) {
@@ -72,7 +75,7 @@ void DepthImageToPointCloudTransformation::transformDepthImageToPointCloud(IplIm
 				assert((0.0 <= pixelValue) && (pixelValue <= 255.0)); //comment out for optimization
 				y = MAX_DEPTHIMAGE_VALUE - pixelValue; // invert here because bright regions appears nearer (at least for zcam) TODO: check if this common
 				z = depthImage->height - row; //flips the image (because of negative y axis definition in depth images)
-				pointCloud->addPoint(Point3D(x,y,z));
+				pointCloud->addPoint(x, y, z);
 			}
 		}
 	}
@@ -21,13 +21,90 @@
 #include "BoundingBox3DExtractor.h"
 #include "brics_3d/core/HomogeneousMatrix44.h"
 #include "brics_3d/core/Logger.h"
+#include "brics_3d/core/PointCloud3DAdaptor.h"
+#include "brics_3d/core/ParallelProcessing.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
 
 using brics_3d::Logger;
 
 namespace brics_3d {
 
-DensityExtractor::DensityExtractor() {
+namespace {
+
+inline bool isFinite(double x, double y, double z) {
+	const double largest = std::numeric_limits<double>::max();
+	return std::fabs(x) <= largest && std::fabs(y) <= largest && std::fabs(z) <= largest; // false for NaN
+}
+
+/// Partial bounding box of the points [begin, end): min x, y, z followed by max x, y, z.
+template <typename AccessorT>
+void computeBoundsRange(const AccessorT* points, unsigned int begin, unsigned int end, double* bounds) {
+	for (unsigned int i = begin; i < end; ++i) {
+		double x = points->x(i);
+		double y = points->y(i);
+		double z = points->z(i);
+		if (!isFinite(x, y, z)) {
+			continue;
+		}
+		bounds[0] = std::min(bounds[0], x);
+		bounds[1] = std::min(bounds[1], y);
+		bounds[2] = std::min(bounds[2], z);
+		bounds[3] = std::max(bounds[3], x);
+		bounds[4] = std::max(bounds[4], y);
+		bounds[5] = std::max(bounds[5], z);
+	}
+}
 
+/// Partial histogram of the points [begin, end). counts has to be zero initialized with one element per cell of the grid.
+template <typename AccessorT>
+void computeHistogramRange(const AccessorT* points, unsigned int begin, unsigned int end, const DensityGrid* grid, unsigned int* counts) {
+	const double inverseVoxelSize = 1.0 / grid->voxelSize;
+	const unsigned int maxX = grid->dimensionX - 1;
+	const unsigned int maxY = grid->dimensionY - 1;
+	const unsigned int maxZ = grid->dimensionZ - 1;
+	const unsigned int strideZ = grid->dimensionX * grid->dimensionY;
+	for (unsigned int i = begin; i < end; ++i) {
+		double x = points->x(i);
+		double y = points->y(i);
+		double z = points->z(i);
+		if (!isFinite(x, y, z)) {
+			continue;
+		}
+		/* coordinates are within the bounding box, so only the upper border needs to be clamped */
+		unsigned int cellX = std::min(static_cast<unsigned int>((x - grid->originX) * inverseVoxelSize), maxX);
+		unsigned int cellY = std::min(static_cast<unsigned int>((y - grid->originY) * inverseVoxelSize), maxY);
+		unsigned int cellZ = std::min(static_cast<unsigned int>((z - grid->originZ) * inverseVoxelSize), maxZ);
+		counts[cellX + grid->dimensionX * cellY + strideZ * cellZ]++;
+	}
+}
+
+/// Add the partial histograms to the cells [begin, end) of counts and count the occupied cells.
+void mergeHistogramsRange(const std::vector<std::vector<unsigned int> >* partialCounts, unsigned int begin, unsigned int end,
+		unsigned int* counts, unsigned int* numberOfOccupiedVoxels) {
+	for (unsigned int p = 0; p < partialCounts->size(); ++p) {
+		const unsigned int* partial = &(*partialCounts)[p][0];
+		for (unsigned int i = begin; i < end; ++i) {
+			counts[i] += partial[i];
+		}
+	}
+	unsigned int occupied = 0;
+	for (unsigned int i = begin; i < end; ++i) {
+		occupied += (counts[i] > 0) ? 1 : 0;
+	}
+	*numberOfOccupiedVoxels = occupied;
+}
+
+}
+
+DensityExtractor::DensityExtractor() {
+	this->maxNumberOfThreads = 0;
 }
 
 DensityExtractor::~DensityExtractor() {
@@ -77,6 +154,125 @@ Density DensityExtractor::computeDensity(IPoint3DIterator::IPoint3DIteratorPtr i
 		return result;
 }
 
+Density DensityExtractor::computeDensityGrid(PointCloud3D* inputPointCloud, double voxelSize, DensityGrid* grid) {
+	assert(inputPointCloud != 0);
+	return computeDensityGrid(PointCloud3DAdaptor(inputPointCloud), inputPointCloud->getSize(), voxelSize, grid);
+}
+
+template <typename ScalarT>
+Density DensityExtractor::computeDensityGrid(const PointCloud3DContiguousT<ScalarT>& inputPointCloud, double voxelSize, DensityGrid* grid) {
+	return computeDensityGrid(PointCloud3DContiguousAdaptor<ScalarT>(&inputPointCloud), inputPointCloud.getSize(), voxelSize, grid);
+}
+
+void DensityExtractor::setMaxNumberOfThreads(unsigned int maxNumberOfThreads) {
+	this->maxNumberOfThreads = maxNumberOfThreads;
+}
+
+unsigned int DensityExtractor::getMaxNumberOfThreads() {
+	return this->maxNumberOfThreads;
+}
+
+template <typename AccessorT>
+Density DensityExtractor::computeDensityGrid(const AccessorT& points, unsigned int count, double voxelSize, DensityGrid* grid) {
+	assert(grid != 0);
+	if (!(voxelSize > 0.0)) {
+		throw std::runtime_error("DensityExtractor: voxelSize has to be positive.");
+	}
+
+	unsigned int numberOfThreads = ParallelProcessing::getNumberOfThreads(count, parallelThreshold, maxNumberOfThreads);
+	unsigned int chunkSize = count / numberOfThreads;
+
+	/* bounding box: one partial box per thread; the last range is processed by the calling thread */
+	const double largest = std::numeric_limits<double>::max();
+	std::vector<double> bounds(6 * numberOfThreads);
+	for (unsigned int i = 0; i < numberOfThreads; ++i) {
+		std::fill(&bounds[6 * i], &bounds[6 * i + 3], largest);
+		std::fill(&bounds[6 * i + 3], &bounds[6 * i + 6], -largest);
+	}
+	boost::thread_group workers;
+	for (unsigned int i = 0; i < numberOfThreads - 1; ++i) {
+		workers.create_thread(boost::bind(&computeBoundsRange<AccessorT>, &points, i * chunkSize, (i + 1) * chunkSize, &bounds[6 * i]));
+	}
+	computeBoundsRange(&points, (numberOfThreads - 1) * chunkSize, count, &bounds[6 * (numberOfThreads - 1)]);
+	workers.join_all();
+	for (unsigned int i = 1; i < numberOfThreads; ++i) {
+		for (int axis = 0; axis < 3; ++axis) {
+			bounds[axis] = std::min(bounds[axis], bounds[6 * i + axis]);
+			bounds[3 + axis] = std::max(bounds[3 + axis], bounds[6 * i + 3 + axis]);
+		}
+	}
+
+	grid->voxelSize = voxelSize;
+	grid->counts.clear();
+	grid->numberOfOccupiedVoxels = 0;
+	Density result;
+	result.numberOfPoints = 0;
+	result.volume = 0.0;
+	result.density = 0.0;
+	if (bounds[0] > bounds[3]) { // no valid point at all
+		grid->originX = grid->originY = grid->originZ = 0.0;
+		grid->dimensionX = grid->dimensionY = grid->dimensionZ = 0;
+		return result;
+	}
+
+	double dimensions[3];
+	for (int axis = 0; axis < 3; ++axis) {
+		dimensions[axis] = std::floor((bounds[3 + axis] - bounds[axis]) / voxelSize) + 1.0;
+	}
+	if (dimensions[0] * dimensions[1] * dimensions[2] > maxNumberOfVoxels) {
+		throw std::runtime_error("DensityExtractor: too many voxels for the density grid. Please increase the voxelSize.");
+	}
+	grid->originX = bounds[0];
+	grid->originY = bounds[1];
+	grid->originZ = bounds[2];
+	grid->dimensionX = static_cast<unsigned int>(dimensions[0]);
+	grid->dimensionY = static_cast<unsigned int>(dimensions[1]);
+	grid->dimensionZ = static_cast<unsigned int>(dimensions[2]);
+	unsigned int numberOfVoxels = grid->dimensionX * grid->dimensionY * grid->dimensionZ;
+	grid->counts.assign(numberOfVoxels, 0);
+
+	/*
+	 * histogram: every helper thread counts into its own partial histogram, the calling thread directly into the grid.
+	 * The partial histograms count against maxNumberOfVoxels, and a thread only gets one if it counts at least as
+	 * many points as the grid has cells. Otherwise clearing and merging the copy costs more than it saves.
+	 */
+	unsigned int numberOfHistograms = std::min(numberOfThreads, maxNumberOfVoxels / numberOfVoxels);
+	numberOfHistograms = std::max(1u, std::min(numberOfHistograms, count / numberOfVoxels));
+	unsigned int histogramChunkSize = count / numberOfHistograms;
+	std::vector<std::vector<unsigned int> > partialCounts(numberOfHistograms - 1, std::vector<unsigned int>(numberOfVoxels, 0));
+	for (unsigned int i = 0; i < numberOfHistograms - 1; ++i) {
+		workers.create_thread(boost::bind(&computeHistogramRange<AccessorT>, &points, i * histogramChunkSize, (i + 1) * histogramChunkSize, grid, &partialCounts[i][0]));
+	}
+	computeHistogramRange(&points, (numberOfHistograms - 1) * histogramChunkSize, count, grid, &grid->counts[0]);
+	workers.join_all();
+
+	/* reduction: every thread sums up a range of cells over all partial histograms */
+	unsigned int numberOfMergeThreads = (numberOfVoxels < parallelThreshold) ? 1 : numberOfThreads;
+	unsigned int mergeChunkSize = numberOfVoxels / numberOfMergeThreads;
+	std::vector<unsigned int> occupiedVoxels(numberOfMergeThreads, 0);
+	for (unsigned int i = 0; i < numberOfMergeThreads - 1; ++i) {
+		workers.create_thread(boost::bind(&mergeHistogramsRange, &partialCounts, i * mergeChunkSize, (i + 1) * mergeChunkSize, &grid->counts[0], &occupiedVoxels[i]));
+	}
+	mergeHistogramsRange(&partialCounts, (numberOfMergeThreads - 1) * mergeChunkSize, numberOfVoxels, &grid->counts[0], &occupiedVoxels[numberOfMergeThreads - 1]);
+	workers.join_all();
+
+	for (unsigned int i = 0; i < numberOfMergeThreads; ++i) {
+		grid->numberOfOccupiedVoxels += occupiedVoxels[i];
+	}
+	unsigned int numberOfPoints = 0;
+	for (unsigned int i = 0; i < numberOfVoxels; ++i) {
+		numberOfPoints += grid->counts[i];
+	}
+
+	result.numberOfPoints = static_cast<int>(numberOfPoints);
+	result.volume = grid->numberOfOccupiedVoxels * voxelSize * voxelSize * voxelSize;
+	result.density = result.numberOfPoints / result.volume;
+	return result;
+}
+
+template Density DensityExtractor::computeDensityGrid<double>(const PointCloud3DContiguousT<double>& inputPointCloud, double voxelSize, DensityGrid* grid);
+template Density DensityExtractor::computeDensityGrid<float>(const PointCloud3DContiguousT<float>& inputPointCloud, double voxelSize, DensityGrid* grid);
+
 
 
 } /* namespace brics_3d */
@@ -22,6 +22,9 @@
 
 #include "brics_3d/core/PointCloud3D.h"
 #include "brics_3d/core/PointCloud3DIterator.h"
+#include "brics_3d/core/PointCloud3DContiguous.h"
+
+#include <vector>
 
 namespace brics_3d {
 
@@ -34,6 +37,39 @@ struct Density {
 	double volume;
 };
 
+/**
+ * @brief Voxel-level density field: number of points per cell of an axis aligned grid.
+ *
+ * The grid starts at the minimum corner of the bounding box of the point cloud. The cells are
+ * stored with x running fastest: index = x + dimensionX * (y + dimensionY * z).
+ */
+struct DensityGrid {
+	double originX;
+	double originY;
+	double originZ;
+	double voxelSize;
+	unsigned int dimensionX;
+	unsigned int dimensionY;
+	unsigned int dimensionZ;
+	unsigned int numberOfOccupiedVoxels;
+
+	/// Number of points per cell.
+	std::vector<unsigned int> counts;
+
+	unsigned int getIndex(unsigned int x, unsigned int y, unsigned int z) const {
+		return x + dimensionX * (y + dimensionY * z);
+	}
+
+	unsigned int getCount(unsigned int x, unsigned int y, unsigned int z) const {
+		return counts[getIndex(x, y, z)];
+	}
+
+	/// Points per volume of a cell.
+	double getDensity(unsigned int x, unsigned int y, unsigned int z) const {
+		return getCount(x, y, z) / (voxelSize * voxelSize * voxelSize);
+	}
+};
+
 /**
  * @brief Extracts the density of a given point cloud.
  *
@@ -41,10 +77,24 @@ struct Density {
  * cloud to the volume of its estimated oriented bounding box.
  * The bounding box estimtion is based on PCA.
  *
+ * Alternatively computeDensityGrid() counts the points per cell of a voxel grid. This yields
+ * a density field (e.g. for adaptive downsampling or sensor diagnostics) and the density with
+ * respect to the occupied volume. The histogram is built by multiple threads for large point
+ * clouds: every thread counts a range of points into its own partial histogram, the partial
+ * histograms are summed up in parallel afterwards. Fine grids with many cells per point are
+ * counted by fewer threads, as every partial histogram has the size of the whole grid.
+ *
  * @ingroup featureExtraction
  */
 class DensityExtractor {
 public:
+
+	/// Threshold for ParallelProcessing::getNumberOfThreads().
+	static const unsigned int parallelThreshold = 100000;
+
+	/// Upper limit for the number of cells of a density grid, including the partial histograms of the threads.
+	static const unsigned int maxNumberOfVoxels = 1u << 26;
+
 	DensityExtractor();
 	virtual ~DensityExtractor();
 
@@ -52,6 +102,43 @@ public:
 	Density computeDensity(PointCloud3D::PointCloud3DPtr inputPointCloud);
 	Density computeDensity(IPoint3DIterator::IPoint3DIteratorPtr inputPointCloud);
 
+	/**
+	 * @brief Count the points per cell of an axis aligned voxel grid.
+	 *
+	 * Points with non finite coordinates are ignored. The returned density refers to the volume of
+	 * all occupied cells. A grid with more than maxNumberOfVoxels cells throws a runtime_error. For
+	 * smaller grids the number of threads is reduced until the grid and the partial histograms of
+	 * all threads together stay within maxNumberOfVoxels cells.
+	 * @param[in] inputPointCloud The point cloud.
+	 * @param[in] voxelSize Edge length of the cells. Must be positive.
+	 * @param[out] grid The density field. The content is replaced.
+	 * @return Number of valid points, occupied volume and density.
+	 */
+	Density computeDensityGrid(PointCloud3D* inputPointCloud, double voxelSize, DensityGrid* grid);
+
+	/**
+	 * @brief Count the points per cell of an axis aligned voxel grid.
+	 * @see computeDensityGrid(PointCloud3D*, double, DensityGrid*)
+	 */
+	template <typename ScalarT>
+	Density computeDensityGrid(const PointCloud3DContiguousT<ScalarT>& inputPointCloud, double voxelSize, DensityGrid* grid);
+
+	/**
+	 * @brief Limit the number of threads.
+	 * @param maxNumberOfThreads Upper limit, see ParallelProcessing::getNumberOfThreads().
+	 */
+	void setMaxNumberOfThreads(unsigned int maxNumberOfThreads);
+
+	unsigned int getMaxNumberOfThreads();
+
+private:
+
+	/// Bounding box, partial histograms and their reduction for any kind of coordinate access.
+	template <typename AccessorT>
+	Density computeDensityGrid(const AccessorT& points, unsigned int count, double voxelSize, DensityGrid* grid);
+
+	unsigned int maxNumberOfThreads;
+
 };
 
 } /* namespace brics_3d */
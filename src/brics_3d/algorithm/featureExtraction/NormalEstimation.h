@@ -22,6 +22,7 @@
 #define BRICS_3D_NORMALESTIMATION_H_
 
 #include <Eigen/Dense>
+#include <algorithm>
 
 #include "brics_3d/core/HomogeneousMatrix44.h" // for eigen declarations
 #include "brics_3d/core/PointCloud3D.h"
@@ -259,6 +260,9 @@ private:
 	/** \brief Number of k-nearest neighbours to be used */
 	int k_neighbours;
 
+	/** \brief If positive, all neighbours within this radius are used instead of the k nearest ones */
+	double searchRadius;
+
 	/** \brief Represents the point-cloud to be processed*/
 	PointCloud3D* inputPointCloud;
 
@@ -270,6 +274,7 @@ public:
 		this->vpy = 0;
 		this->vpz = 0;
 		this->k_neighbours = 10;
+		this->searchRadius = -1.0;
 
 	}
 
@@ -324,6 +329,18 @@ public:
 		return this->k_neighbours;
 	}
 
+	/** \brief Use all neighbours within a radius rather than a fixed number of neighbours.
+	 * The native radius search of the search method is used.
+	 * \param searchRadius The radius. A value <= 0 switches back to the k nearest neighbours.
+	 */
+	inline void setSearchRadius(double searchRadius){
+		this->searchRadius = searchRadius;
+	}
+
+	inline double getSearchRadius(){
+		return this->searchRadius;
+	}
+
 	/** \brief Compute the 3D (X-Y-Z) centroid of a set of points using their indices and return it as a 3D vector.
 	 * \param cloud the input point cloud
 	 * \param indices the point cloud indices that need to be used
@@ -398,10 +415,24 @@ public:
 //		std::vector<Point3D>* points;
 //		points = inputPointCloud->getPointCloud();
 
+		// The k nearest neighbours of all points are queried as one batch
+		NearestNeighborBatchResult neighbours;
+		if (searchRadius <= 0.0) {
+			nnSearchMethod->findNearestNeighbors(this->inputPointCloud, &neighbours, k_neighbours);
+		}
+
 		for (size_t idx = 0; idx < this->inputPointCloud->getSize(); ++idx)
 		{
 
-			nnSearchMethod->findNearestNeighbors(&(*inputPointCloud->getPointCloud())[idx], &nn_indices, k_neighbours);
+			if (searchRadius > 0.0) {
+				nnSearchMethod->findNeighborsWithinRadius(&(*inputPointCloud->getPointCloud())[idx], searchRadius, &nn_indices);
+			} else {
+				unsigned int numberOfNeighbours = neighbours.getNumberOfNeighbors(idx);
+				nn_indices.resize(numberOfNeighbours);
+				if (numberOfNeighbours > 0) {
+					std::copy(neighbours.getIndices(idx), neighbours.getIndices(idx) + numberOfNeighbours, nn_indices.begin());
+				}
+			}
 
 			if (nn_indices.size()==0)
 			{
@@ -18,20 +18,95 @@
 ******************************************************************************/
 
 #include "BoxROIExtractor.h"
-#include "brics_3d/core/HomogeneousMatrix44.h"
+#include "brics_3d/core/ParallelProcessing.h"
+#include "brics_3d/core/AffineTransform44.h"
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
 
 namespace brics_3d {
 
+/// Number of points that are gathered and tested at once.
+static const unsigned int boxBlockSize = 1024;
+
+/**
+ * Test a block of interleaved x,y,z coordinates against the box. The block is transformed in place
+ * if a transform is given. The position of every point that passes is appended to selected; the
+ * compaction is branch free, so the loop does not suffer from mispredictions.
+ * @return Number of selected positions.
+ */
+static inline unsigned int testBlock(double* xyz, unsigned int count, const double* inverseOrigin, const double* halfSize, unsigned int* selected) {
+	if (inverseOrigin != 0) {
+		AffineTransform44::transformPoints(inverseOrigin, xyz, count);
+	}
+	const double halfX = halfSize[0];
+	const double halfY = halfSize[1];
+	const double halfZ = halfSize[2];
+	unsigned int passed = 0;
+	for (unsigned int i = 0; i < count; ++i) {
+		const double* point = &xyz[3 * i];
+		selected[passed] = i;
+		passed += (point[0] >= -halfX) & (point[0] <= halfX) &
+				(point[1] >= -halfY) & (point[1] <= halfY) &
+				(point[2] >= -halfZ) & (point[2] <= halfZ);
+	}
+	return passed;
+}
+
+/// Test a range of a point cloud; the indices of the selected points are appended to result.
+static void selectRange(const boost::ptr_vector<Point3D>* points, unsigned int begin, unsigned int end,
+		const double* inverseOrigin, const double* halfSize, std::vector<unsigned int>* result) {
+	double xyz[3 * boxBlockSize];
+	unsigned int selected[boxBlockSize];
+	for (unsigned int blockBegin = begin; blockBegin < end; blockBegin += boxBlockSize) {
+		unsigned int count = std::min(boxBlockSize, end - blockBegin);
+		for (unsigned int i = 0; i < count; ++i) {
+			const Point3D& tmpPoint = (*points)[blockBegin + i];
+			xyz[3 * i] = tmpPoint.getX();
+			xyz[3 * i + 1] = tmpPoint.getY();
+			xyz[3 * i + 2] = tmpPoint.getZ();
+		}
+		unsigned int passed = testBlock(xyz, count, inverseOrigin, halfSize, selected);
+		for (unsigned int i = 0; i < passed; ++i) {
+			result->push_back(blockBegin + selected[i]);
+		}
+	}
+}
+
+/// Same as above for the coordinate columns of a contiguous point cloud.
+static void selectRangeContiguous(const Coordinate* x, const Coordinate* y, const Coordinate* z, unsigned int begin, unsigned int end,
+		const double* inverseOrigin, const double* halfSize, std::vector<unsigned int>* result) {
+	double xyz[3 * boxBlockSize];
+	unsigned int selected[boxBlockSize];
+	for (unsigned int blockBegin = begin; blockBegin < end; blockBegin += boxBlockSize) {
+		unsigned int count = std::min(boxBlockSize, end - blockBegin);
+		for (unsigned int i = 0; i < count; ++i) {
+			xyz[3 * i] = x[blockBegin + i];
+			xyz[3 * i + 1] = y[blockBegin + i];
+			xyz[3 * i + 2] = z[blockBegin + i];
+		}
+		unsigned int passed = testBlock(xyz, count, inverseOrigin, halfSize, selected);
+		for (unsigned int i = 0; i < passed; ++i) {
+			result->push_back(blockBegin + selected[i]);
+		}
+	}
+}
+
 BoxROIExtractor::BoxROIExtractor() {
 	this->sizeX = 1.0;
 	this->sizeY = 1.0;
 	this->sizeZ = 1.0;
+	this->maxNumberOfThreads = 0;
 }
 
 BoxROIExtractor::BoxROIExtractor(Coordinate sizeX, Coordinate sizeY, Coordinate sizeZ) {
 	this->sizeX = sizeX;
 	this->sizeY = sizeY;
 	this->sizeZ = sizeZ;
+	this->maxNumberOfThreads = 0;
 }
 
 BoxROIExtractor::~BoxROIExtractor() {
@@ -39,30 +114,119 @@ BoxROIExtractor::~BoxROIExtractor() {
 }
 
 void BoxROIExtractor::filter(PointCloud3D* originalPointCloud, PointCloud3D* resultPointCloud) {
-	if (boxOrigin == 0 || boxOrigin->isIdentity()) { //lazy evaluation...
-		for (unsigned int i = 0; i < originalPointCloud->getSize(); ++i) {
-			Point3D tmpPoint = (*originalPointCloud->getPointCloud())[i];
-			if (tmpPoint.getX() >= -sizeX/2 && tmpPoint.getX() <= sizeX/2 &&
-					tmpPoint.getY() >= -sizeY/2 && tmpPoint.getY() <= sizeY/2 &&
-					tmpPoint.getZ() >= -sizeZ/2 && tmpPoint.getZ() <= sizeZ/2) {
-				resultPointCloud->addPointPtr((*originalPointCloud->getPointCloud())[i].clone());
-			}
+	assert(originalPointCloud != 0);
+	assert(resultPointCloud != 0);
+	double inverseOrigin[AffineTransform44::matrixElements];
+	const double* transform = getInverseOrigin(inverseOrigin) ? inverseOrigin : 0;
+	double halfSize[3] = {sizeX/2, sizeY/2, sizeZ/2};
+
+	/* every thread collects the indices of a range; the ranges are concatenated in order */
+	const boost::ptr_vector<Point3D>* points = originalPointCloud->getPointCloud();
+	unsigned int count = originalPointCloud->getSize();
+	unsigned int numberOfThreads = ParallelProcessing::getNumberOfThreads(count, parallelThreshold, maxNumberOfThreads);
+	unsigned int chunkSize = count / numberOfThreads;
+	std::vector<std::vector<unsigned int> > selectedIndices(numberOfThreads);
+	{
+		boost::thread_group workers;
+		for (unsigned int i = 0; i < numberOfThreads - 1; ++i) {
+			workers.create_thread(boost::bind(&selectRange, points, i * chunkSize, (i + 1) * chunkSize, transform, halfSize, &selectedIndices[i]));
+		}
+		selectRange(points, (numberOfThreads - 1) * chunkSize, count, transform, halfSize, &selectedIndices[numberOfThreads - 1]);
+		workers.join_all();
+	}
+
+	unsigned int numberOfSelectedPoints = 0;
+	for (unsigned int i = 0; i < numberOfThreads; ++i) {
+		numberOfSelectedPoints += selectedIndices[i].size();
+	}
+	resultPointCloud->reserve(resultPointCloud->getSize() + numberOfSelectedPoints);
+	for (unsigned int i = 0; i < numberOfThreads; ++i) {
+		for (unsigned int j = 0; j < selectedIndices[i].size(); ++j) {
+			resultPointCloud->addPointClone((*points)[selectedIndices[i][j]]);
 		}
-	} else {
-		HomogeneousMatrix44* inverseOrigin = new HomogeneousMatrix44();
-		*inverseOrigin = *(boxOrigin.get());
-		inverseOrigin->inverse();
-		for (unsigned int i = 0; i < originalPointCloud->getSize(); ++i) {
-			Point3D tmpPoint = (*originalPointCloud->getPointCloud())[i];
-			tmpPoint.homogeneousTransformation(inverseOrigin); // move all points to the origin and then compare
-			if (tmpPoint.getX() >= -sizeX/2 && tmpPoint.getX() <= sizeX/2 &&
-					tmpPoint.getY() >= -sizeY/2 && tmpPoint.getY() <= sizeY/2 &&
-					tmpPoint.getZ() >= -sizeZ/2 && tmpPoint.getZ() <= sizeZ/2) {
-				resultPointCloud->addPointPtr((*originalPointCloud->getPointCloud())[i].clone());
-			}
+	}
+}
+
+void BoxROIExtractor::filter(PointCloud3DContiguous* originalPointCloud, PointCloud3DContiguous* resultPointCloud) {
+	assert(originalPointCloud != 0);
+	assert(resultPointCloud != 0);
+	assert(originalPointCloud != resultPointCloud);
+	double inverseOrigin[AffineTransform44::matrixElements];
+	const double* transform = getInverseOrigin(inverseOrigin) ? inverseOrigin : 0;
+	double halfSize[3] = {sizeX/2, sizeY/2, sizeZ/2};
+
+	const Coordinate* x = originalPointCloud->getXCoordinates();
+	const Coordinate* y = originalPointCloud->getYCoordinates();
+	const Coordinate* z = originalPointCloud->getZCoordinates();
+	unsigned int count = originalPointCloud->getSize();
+	unsigned int numberOfThreads = ParallelProcessing::getNumberOfThreads(count, parallelThreshold, maxNumberOfThreads);
+	unsigned int chunkSize = count / numberOfThreads;
+	std::vector<std::vector<unsigned int> > selectedIndices(numberOfThreads);
+	{
+		boost::thread_group workers;
+		for (unsigned int i = 0; i < numberOfThreads - 1; ++i) {
+			workers.create_thread(boost::bind(&selectRangeContiguous, x, y, z, i * chunkSize, (i + 1) * chunkSize, transform, halfSize, &selectedIndices[i]));
+		}
+		selectRangeContiguous(x, y, z, (numberOfThreads - 1) * chunkSize, count, transform, halfSize, &selectedIndices[numberOfThreads - 1]);
+		workers.join_all();
+	}
+
+	resultPointCloud->clear();
+	unsigned int numberOfSelectedPoints = 0;
+	for (unsigned int i = 0; i < numberOfThreads; ++i) {
+		numberOfSelectedPoints += selectedIndices[i].size();
+	}
+	resultPointCloud->reserve(numberOfSelectedPoints);
+	for (unsigned int i = 0; i < numberOfThreads; ++i) {
+		for (unsigned int j = 0; j < selectedIndices[i].size(); ++j) {
+			resultPointCloud->addPointFrom(*originalPointCloud, selectedIndices[i][j]);
+		}
+	}
+}
+
+unsigned int BoxROIExtractor::select(PointCloud3D* pointCloud, unsigned int* indices, unsigned int count) {
+	assert(pointCloud != 0);
+	double inverseOrigin[AffineTransform44::matrixElements];
+	const double* transform = getInverseOrigin(inverseOrigin) ? inverseOrigin : 0;
+	double halfSize[3] = {sizeX/2, sizeY/2, sizeZ/2};
+
+	boost::ptr_vector<Point3D>& points = *pointCloud->getPointCloud();
+	double xyz[3 * boxBlockSize];
+	unsigned int selected[boxBlockSize];
+	unsigned int passed = 0;
+	for (unsigned int blockBegin = 0; blockBegin < count; blockBegin += boxBlockSize) {
+		unsigned int blockCount = std::min(boxBlockSize, count - blockBegin);
+		for (unsigned int i = 0; i < blockCount; ++i) {
+			const Point3D& tmpPoint = points[indices[blockBegin + i]];
+			xyz[3 * i] = tmpPoint.getX();
+			xyz[3 * i + 1] = tmpPoint.getY();
+			xyz[3 * i + 2] = tmpPoint.getZ();
+		}
+		unsigned int blockPassed = testBlock(xyz, blockCount, transform, halfSize, selected);
+		for (unsigned int i = 0; i < blockPassed; ++i) {
+			indices[passed++] = indices[blockBegin + selected[i]]; // passed never overtakes the current block
 		}
-		delete inverseOrigin;
 	}
+	return passed;
+}
+
+void BoxROIExtractor::setMaxNumberOfThreads(unsigned int maxNumberOfThreads) {
+	this->maxNumberOfThreads = maxNumberOfThreads;
+}
+
+unsigned int BoxROIExtractor::getMaxNumberOfThreads() {
+	return this->maxNumberOfThreads;
+}
+
+bool BoxROIExtractor::getInverseOrigin(double* inverseOrigin) const {
+	if (boxOrigin == 0 || boxOrigin->isIdentity()) { //lazy evaluation...
+		return false;
+	}
+	AffineTransform44 transform(*boxOrigin);
+	transform.invert(); // move all points to the origin and then compare
+	const double* rawData = transform.getRawData();
+	std::copy(rawData, rawData + AffineTransform44::matrixElements, inverseOrigin);
+	return true;
 }
 
 }  // namespace brics_3d
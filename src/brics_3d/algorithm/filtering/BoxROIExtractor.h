@@ -21,15 +21,26 @@
 #define BRICS_3D_BOXROIEXTRACTOR_H_
 
 #include "IFiltering.h"
+#include "IPointSelector.h"
 #include "brics_3d/core/IHomogeneousMatrix44.h"
+#include "brics_3d/core/PointCloud3DContiguous.h"
 
 namespace brics_3d {
 
 /**
  * The origin of box is considered to be in the center of each size value.
+ *
+ * Points are tested in blocks: the coordinates of a block are gathered into a buffer, transformed
+ * into the box frame at once and compared without branches. Large point clouds are split into
+ * ranges that are tested by multiple threads; the selected points are written in the order of the
+ * input, thus the result does not depend on the number of threads.
  */
-class BoxROIExtractor : public IFiltering  {
+class BoxROIExtractor : public IFiltering, public IPointSelector  {
 public:
+
+	/// Threshold for ParallelProcessing::getNumberOfThreads().
+	static const unsigned int parallelThreshold = 100000;
+
 	BoxROIExtractor();
 
 	BoxROIExtractor(Coordinate sizeX, Coordinate sizeY, Coordinate sizeZ);
@@ -39,6 +50,23 @@ public:
 
 	void filter(PointCloud3D* originalPointCloud, PointCloud3D* resultPointCloud);
 
+	/**
+	 * Extracts the points inside the box. Works directly on the coordinate columns.
+	 * All attributes of the selected points are kept.
+	 * @param originalPointCloud Input point cloud.
+	 * @param resultPointCloud Extracted subset. Previous content will be replaced.
+	 */
+	void filter(PointCloud3DContiguous* originalPointCloud, PointCloud3DContiguous* resultPointCloud);
+
+	unsigned int select(PointCloud3D* pointCloud, unsigned int* indices, unsigned int count);
+
+	/**
+	 * @brief Limit the number of threads.
+	 * @param maxNumberOfThreads Upper limit, see ParallelProcessing::getNumberOfThreads().
+	 */
+	void setMaxNumberOfThreads(unsigned int maxNumberOfThreads);
+
+	unsigned int getMaxNumberOfThreads();
 
     Coordinate getSizeX() const
     {
@@ -82,12 +110,16 @@ public:
 
 private:
 
+	/// Fill the 16 values of the world to box transform; returns false if it is the identity.
+	bool getInverseOrigin(double* inverseOrigin) const;
+
     Coordinate sizeX;
     Coordinate sizeY;
     Coordinate sizeZ;
 
     IHomogeneousMatrix44::IHomogeneousMatrix44Ptr boxOrigin;
 
+	unsigned int maxNumberOfThreads;
 };
 
 }  // namespace brics_3d
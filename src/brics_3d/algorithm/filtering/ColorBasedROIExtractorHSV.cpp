@@ -22,9 +22,14 @@
 #include "brics_3d/core/ColorSpaceConvertor.h"
 #include "brics_3d/core/ColoredPoint3D.h"
 #include <stdio.h>
+#include <assert.h>
+#include <algorithm>
 
 namespace brics_3d {
 
+/// Number of colors that are converted at once.
+static const unsigned int colorBlockSize = 1024;
+
 ColorBasedROIExtractorHSV::ColorBasedROIExtractorHSV() {
 	this->maxH = 255;
 	this->minH	= 0;
@@ -107,78 +112,129 @@ void ColorBasedROIExtractorHSV::filter(brics_3d::PointCloud3D* originalPointClou
 		printf("[WARNING] Using maximum limits for HSV based ROI Extraction!!!\n");
 	}
 
-	int cloudSize =	originalPointCloud->getSize();
-	double tempH, tempS, tempV;
-	int tempR, tempG, tempB;
-	uint8_t tempChar;
-	bool passed;
-	brics_3d::ColorSpaceConvertor colorConvertor;
-	brics_3d::Point3D tempPoint3D;
-	resultPointCloud->getPointCloud()->clear();
+	unsigned int cloudSize = originalPointCloud->getSize();
+	boost::ptr_vector<Point3D>& points = *originalPointCloud->getPointCloud();
+	unsigned char rgb[3 * colorBlockSize];
+	unsigned char hsv[3 * colorBlockSize];
+	unsigned int blockIndices[colorBlockSize];
+	unsigned int selected[colorBlockSize];
+	unsigned char hueInLimits[256];
+	unsigned char saturationInLimits[256];
+	computeLimitTables(hueInLimits, saturationInLimits);
+	resultPointCloud->clear();
 
 	printf("Used H-S Limits for extraction: H:[%f %f] S:[%f %f]\n", minH, maxH, minS, maxS);
-	for (unsigned int i = 0; i < static_cast<unsigned int>(cloudSize); i++) {
-		passed = false;
-
-		if( (*originalPointCloud->getPointCloud())[i].asColoredPoint3D() == 0) {
-			continue; //this point does not contain color information so skip it
-		}
-
-		//Getting the HSV values for the RGB points
-		tempChar = (*originalPointCloud->getPointCloud())[i].asColoredPoint3D()->getR();
-		tempR = tempChar << 0;
-		tempR = abs(tempR);
-
-		tempChar = (*originalPointCloud->getPointCloud())[i].asColoredPoint3D()->getG();
-		tempG = tempChar << 0;
-		tempG = abs(tempG);
-
-		tempChar = (*originalPointCloud->getPointCloud())[i].asColoredPoint3D()->getB();
-		tempB = tempChar << 0;
-		tempB = abs(tempB);
-
-		colorConvertor.rgbToHsv(tempR, tempG, tempB, &tempH, &tempS, &tempV);
-		if(minH < maxH){
-
-
-			//Checking the values with the set limits
-			if (tempH <= maxH && tempH >= minH) {
-				if (tempS >= minS && tempS <= maxS) {
-					passed=true;
-
-				}
+	for (unsigned int blockBegin = 0; blockBegin < cloudSize; blockBegin += colorBlockSize) {
+		unsigned int blockEnd = std::min(cloudSize, blockBegin + colorBlockSize);
+
+		/* gather the colors of a block, then convert them at once */
+		unsigned int numberOfColors = 0;
+		for (unsigned int i = blockBegin; i < blockEnd; ++i) {
+			ColoredPoint3D* coloredPoint = points[i].asColoredPoint3D();
+			if (coloredPoint == 0) {
+				continue; //this point does not contain color information so skip it
 			}
+			rgb[3 * numberOfColors] = coloredPoint->getR();
+			rgb[3 * numberOfColors + 1] = coloredPoint->getG();
+			rgb[3 * numberOfColors + 2] = coloredPoint->getB();
+			blockIndices[numberOfColors++] = i;
+		}
+		ColorSpaceConvertor::rgbToHsv(rgb, hsv, numberOfColors);
 
+		unsigned int numberOfSelected = selectInRange(hsv, numberOfColors, hueInLimits, saturationInLimits, selected);
+		for (unsigned int j = 0; j < numberOfSelected; ++j) {
+			resultPointCloud->addPointClone(points[blockIndices[selected[j]]]);
+		}
+	}
+}
 
-			//		printf("H-S Limits: [%f %f %f %f]\n", minH, maxH, minS, maxS);
-			//		printf("Actual H-S Values: [%d %d %d %f %f]\n", tempR, tempG, tempB, tempH, tempS);
-			if(passed){
-				resultPointCloud->addPointPtr((*originalPointCloud->getPointCloud())[i].clone());
-			}
+void ColorBasedROIExtractorHSV::filter(PointCloud3DContiguous* originalPointCloud, PointCloud3DContiguous* resultPointCloud) {
+	assert(originalPointCloud != 0);
+	assert(resultPointCloud != 0);
+	assert(originalPointCloud != resultPointCloud);
 
+	if(this->minS == 0 && this->minH == 0 && this->minV == 0 && this->maxH == 255 &&
+			this->maxS == 255 && this->maxV == 255) {
+		printf("[WARNING] Using maximum limits for HSV based ROI Extraction!!!\n");
+	}
 
-		}else {
+	resultPointCloud->clear();
+	if (!originalPointCloud->hasColors()) {
+		return; // no point contains color information
+	}
 
-			//Checking the values with the set limits
-			if ((tempH <= 255 && tempH >= minH) || (tempH >= 0 && tempH <= maxH)) {
-				if (tempS >= minS && tempS <= maxS) {
-					passed=true;
+	const unsigned char* rgb = originalPointCloud->getColors();
+	unsigned int cloudSize = originalPointCloud->getSize();
+	unsigned char hsv[3 * colorBlockSize];
+	unsigned int selected[colorBlockSize];
+	unsigned char hueInLimits[256];
+	unsigned char saturationInLimits[256];
+	computeLimitTables(hueInLimits, saturationInLimits);
+
+	for (unsigned int blockBegin = 0; blockBegin < cloudSize; blockBegin += colorBlockSize) {
+		unsigned int blockSize = std::min(cloudSize - blockBegin, colorBlockSize);
+		ColorSpaceConvertor::rgbToHsv(&rgb[3 * blockBegin], hsv, blockSize);
+		unsigned int numberOfSelected = selectInRange(hsv, blockSize, hueInLimits, saturationInLimits, selected);
+		for (unsigned int j = 0; j < numberOfSelected; ++j) {
+			resultPointCloud->addPointFrom(*originalPointCloud, blockBegin + selected[j]);
+		}
+	}
+}
 
-				}
+unsigned int ColorBasedROIExtractorHSV::select(PointCloud3D* pointCloud, unsigned int* indices, unsigned int count) {
+	boost::ptr_vector<Point3D>& points = *pointCloud->getPointCloud();
+	unsigned char rgb[3 * colorBlockSize];
+	unsigned char hsv[3 * colorBlockSize];
+	unsigned int blockIndices[colorBlockSize];
+	unsigned int selected[colorBlockSize];
+	unsigned char hueInLimits[256];
+	unsigned char saturationInLimits[256];
+	computeLimitTables(hueInLimits, saturationInLimits);
+	unsigned int passed = 0;
+
+	for (unsigned int blockBegin = 0; blockBegin < count; blockBegin += colorBlockSize) {
+		unsigned int blockEnd = std::min(count, blockBegin + colorBlockSize);
+		unsigned int numberOfColors = 0;
+		for (unsigned int i = blockBegin; i < blockEnd; ++i) {
+			ColoredPoint3D* coloredPoint = points[indices[i]].asColoredPoint3D();
+			if (coloredPoint == 0) {
+				continue; //this point does not contain color information so skip it
 			}
+			rgb[3 * numberOfColors] = coloredPoint->getR();
+			rgb[3 * numberOfColors + 1] = coloredPoint->getG();
+			rgb[3 * numberOfColors + 2] = coloredPoint->getB();
+			blockIndices[numberOfColors++] = indices[i];
+		}
+		ColorSpaceConvertor::rgbToHsv(rgb, hsv, numberOfColors);
 
-
-			//		printf("H-S Limits: [%f %f %f %f]\n", minH, maxH, minS, maxS);
-			//		printf("Actual H-S Values: [%d %d %d %f %f]\n", tempR, tempG, tempB, tempH, tempS);
-			if(passed){
-				resultPointCloud->addPointPtr((*originalPointCloud->getPointCloud())[i].clone());
-			}
+		unsigned int numberOfSelected = selectInRange(hsv, numberOfColors, hueInLimits, saturationInLimits, selected);
+		for (unsigned int j = 0; j < numberOfSelected; ++j) { // passed never overtakes the current block
+			indices[passed++] = blockIndices[selected[j]];
 		}
 	}
-	//	printf("Output cloud size:%d\n", out_cloud->getSize());
+	return passed;
 }
 
+void ColorBasedROIExtractorHSV::computeLimitTables(unsigned char* hueInLimits, unsigned char* saturationInLimits) const {
+	bool isWrapped = !(minH < maxH); // hue limits with minH >= maxH wrap around
+	for (int i = 0; i < 256; ++i) {
+		double value = i;
+		hueInLimits[i] = isWrapped ? (((value <= 255) && (value >= minH)) || ((value >= 0) && (value <= maxH))) : ((value <= maxH) && (value >= minH));
+		saturationInLimits[i] = (value >= minS) && (value <= maxS);
+	}
+	hueInLimits[ColorSpaceConvertor::undefinedHue] = false; // gray values never pass
+}
 
+unsigned int ColorBasedROIExtractorHSV::selectInRange(const unsigned char* hsv, unsigned int count,
+		const unsigned char* hueInLimits, const unsigned char* saturationInLimits, unsigned int* selected) {
+	unsigned int passed = 0;
 
+	/* branch-free compaction: every position is written, but only passing ones are kept */
+	for (unsigned int j = 0; j < count; ++j) {
+		selected[passed] = j;
+		passed += hueInLimits[hsv[3 * j]] & saturationInLimits[hsv[3 * j + 1]];
+	}
+	return passed;
+}
 
 }
@@ -21,6 +21,8 @@
 #define BRICS_3D_COLORBASEDROIEXTRACTORHSV_H_
 
 #include "IFiltering.h"
+#include "IPointSelector.h"
+#include "brics_3d/core/PointCloud3DContiguous.h"
 
 namespace brics_3d {
 
@@ -28,7 +30,7 @@ namespace brics_3d {
  * @brief Extracts subset of input point cloud based on color-properties in HSV color space
  * @ingroup filtering
  */
-class ColorBasedROIExtractorHSV : public IFiltering {
+class ColorBasedROIExtractorHSV : public IFiltering, public IPointSelector {
 
 private:
 	/**
@@ -49,6 +51,25 @@ private:
 	double maxV;
 	double minV;
 
+	/**
+	 * Evaluate the hue and saturation limits for all 8-bit values. Hue limits with minH >= maxH wrap around.
+	 * The undefined hue of gray values is never in the limits.
+	 * @param hueInLimits 256 entries, 1 if a hue is in the limits, 0 otherwise
+	 * @param saturationInLimits 256 entries, 1 if a saturation is in the limits, 0 otherwise
+	 */
+	void computeLimitTables(unsigned char* hueInLimits, unsigned char* saturationInLimits) const;
+
+	/**
+	 * Check a block of HSV values against the limit tables of computeLimitTables().
+	 * @param hsv Interleaved h, s, v triples as delivered by ColorSpaceConvertor::rgbToHsv()
+	 * @param count Number of triples
+	 * @param hueInLimits Limit table for the hue
+	 * @param saturationInLimits Limit table for the saturation
+	 * @param selected Positions of the triples in the limits, in ascending order. Must have space for count values.
+	 * @return Number of selected positions
+	 */
+	static unsigned int selectInRange(const unsigned char* hsv, unsigned int count,
+			const unsigned char* hueInLimits, const unsigned char* saturationInLimits, unsigned int* selected);
 
 
 public:
@@ -67,6 +88,19 @@ public:
 	 */
 	virtual void filter(PointCloud3D* originalPointCloud, PointCloud3D* resultPointCloud);
 
+	/**
+	 * Extracts subset of input point cloud based on color-properties.
+	 * Streams over the packed color channel of the input. All attributes of the selected points are kept.
+	 * @param originalPointCloud Input pointcloud. Without a color channel the result is empty.
+	 * @param resultPointCloud Extracted Subset
+	 */
+	void filter(PointCloud3DContiguous* originalPointCloud, PointCloud3DContiguous* resultPointCloud);
+
+	/**
+	 * Keeps the indices of points with a color in the HSV limits. Points without color information do not pass.
+	 */
+	unsigned int select(PointCloud3D* pointCloud, unsigned int* indices, unsigned int count);
+
 	/**
 	 *
 	 * @return maximum Hue allowed
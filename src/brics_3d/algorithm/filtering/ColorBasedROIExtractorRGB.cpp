@@ -9,6 +9,8 @@
 #include "brics_3d/core/ColoredPoint3D.h"
 #include "brics_3d/core/Logger.h"
 
+#include <assert.h>
+
 namespace brics_3d {
 
 ColorBasedROIExtractorRGB::ColorBasedROIExtractorRGB() {
@@ -31,64 +33,73 @@ void ColorBasedROIExtractorRGB::filter(PointCloud3D *originalPointCloud, PointCl
 	}
 
 	unsigned int cloudSize = originalPointCloud->getSize();
-	int tempR, tempG, tempB;
-	uint8_t tempChar;
-	bool passed;
-	brics_3d::Point3D tempPoint3D;
-	resultPointCloud->getPointCloud()->clear();
+	boost::ptr_vector<Point3D>& points = *originalPointCloud->getPointCloud();
+	int squaredDifferences[3][256];
+	computeSquaredDifferences(red, squaredDifferences[0]);
+	computeSquaredDifferences(green, squaredDifferences[1]);
+	computeSquaredDifferences(blue, squaredDifferences[2]);
+	double minimumSquared, maximumSquared;
+	getSquaredThresholds(&minimumSquared, &maximumSquared);
 
+	resultPointCloud->clear();
 
 	for (unsigned int i = 0; i < cloudSize; i++) {
-		passed = false;
-
-		if( (*originalPointCloud->getPointCloud())[i].asColoredPoint3D() == 0) {
+		ColoredPoint3D* coloredPoint = points[i].asColoredPoint3D();
+		if (coloredPoint == 0) {
 			continue; //this point does not contain color information so skip it
 		}
 
-		//Getting the HSV values for the RGB points
-		tempChar = (*originalPointCloud->getPointCloud())[i].asColoredPoint3D()->getR();
-		tempR = tempChar << 0;
-		tempR = abs(tempR);
-
-		tempChar = (*originalPointCloud->getPointCloud())[i].asColoredPoint3D()->getG();
-		tempG = tempChar << 0;
-		tempG = abs(tempG);
-
-		tempChar = (*originalPointCloud->getPointCloud())[i].asColoredPoint3D()->getB();
-		tempB = tempChar << 0;
-		tempB = abs(tempB);
-
-//		printf("[INFO] Current R=%d, G=%d, B=%d, \n", tempR, tempG, tempB);
-
-		double redDistance = (double)(tempR-this->red);
-		double greenDistance = (double)(tempG-this->green);
-		double blueDistance = (double)(tempB-this->blue);
-
-		double currentDistance = (redDistance*redDistance) + (greenDistance*greenDistance) +
-									(blueDistance*blueDistance);
-		currentDistance = std::sqrt(currentDistance);
-
-		if (currentDistance <= distanceThresholdMaximum && currentDistance >= distanceThresholdMinimum) passed=true;
-
-		if(passed){
-//			brics_3d::Point3D *tempPoint3D =  new brics_3d::Point3D(originalPointCloud->getPointCloud()->data()[i].getX(),
-//					originalPointCloud->getPointCloud()->data()[i].getY(),
-//					originalPointCloud->getPointCloud()->data()[i].getZ());
-//
-//			brics_3d::ColoredPoint3D *tempColoredPoint3D = new brics_3d::ColoredPoint3D(tempPoint3D,
-//					originalPointCloud->getPointCloud()->data()[i].red,
-//					originalPointCloud->getPointCloud()->data()[i].green,
-//					originalPointCloud->getPointCloud()->data()[i].blue);
-//
-//			out_cloud->addPoint(tempColoredPoint3D);
-			resultPointCloud->addPointPtr((*originalPointCloud->getPointCloud())[i].clone());
-//			delete tempPoint3D;
-//			delete tempColoredPoint3D;
+		double currentDistance = squaredDifferences[0][coloredPoint->getR()] + squaredDifferences[1][coloredPoint->getG()] +
+				squaredDifferences[2][coloredPoint->getB()];
+		if (currentDistance <= maximumSquared && currentDistance >= minimumSquared) {
+			resultPointCloud->addPointClone(points[i]);
 		}
+	}
+}
+
+void ColorBasedROIExtractorRGB::filter(PointCloud3DContiguous* originalPointCloud, PointCloud3DContiguous* resultPointCloud) {
+	assert(originalPointCloud != 0);
+	assert(resultPointCloud != 0);
+	assert(originalPointCloud != resultPointCloud);
+
+	if(this->red == 0 && this->green == 0 && this->blue == 0 ) {
+		LOG(WARNING) << "[WARNING] Using limits: R=0, G=0, B=0 for RGB based ROI Extraction!!!";
+	}
 
+	resultPointCloud->clear();
+	if (!originalPointCloud->hasColors()) {
+		return; // no point contains color information
 	}
 
+	int squaredDifferences[3][256];
+	computeSquaredDifferences(red, squaredDifferences[0]);
+	computeSquaredDifferences(green, squaredDifferences[1]);
+	computeSquaredDifferences(blue, squaredDifferences[2]);
+	double minimumSquared, maximumSquared;
+	getSquaredThresholds(&minimumSquared, &maximumSquared);
+	const unsigned char* rgb = originalPointCloud->getColors();
+	unsigned int cloudSize = originalPointCloud->getSize();
+
+	for (unsigned int i = 0; i < cloudSize; i++) {
+		double currentDistance = squaredDifferences[0][rgb[0]] + squaredDifferences[1][rgb[1]] + squaredDifferences[2][rgb[2]];
+		if (currentDistance <= maximumSquared && currentDistance >= minimumSquared) {
+			resultPointCloud->addPointFrom(*originalPointCloud, i);
+		}
+		rgb += 3;
+	}
+}
+
+void ColorBasedROIExtractorRGB::computeSquaredDifferences(int reference, int* squaredDifferences) {
+	assert(squaredDifferences != 0);
+	for (int value = 0; value < 256; ++value) {
+		squaredDifferences[value] = (value - reference) * (value - reference);
+	}
+}
 
+void ColorBasedROIExtractorRGB::getSquaredThresholds(double* minimumSquared, double* maximumSquared) const {
+	/* compare squared distances to avoid the sqrt per point */
+	*minimumSquared = (distanceThresholdMinimum > 0.0) ? distanceThresholdMinimum * distanceThresholdMinimum : 0.0;
+	*maximumSquared = (distanceThresholdMaximum >= 0.0) ? distanceThresholdMaximum * distanceThresholdMaximum : -1.0;
 }
 
 }
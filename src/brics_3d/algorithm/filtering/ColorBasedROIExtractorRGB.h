@@ -9,6 +9,7 @@
 #define BRICS_3D_COLORBASEDROIEXTRACTORRGB_H_
 
 #include "IFiltering.h"
+#include "brics_3d/core/PointCloud3DContiguous.h"
 #include <stdlib.h>
 #include <cmath>
 #include <iostream>
@@ -28,10 +29,31 @@ class ColorBasedROIExtractorRGB : public IFiltering  {
 	int blue;
 	double distanceThresholdMinimum;
 	double distanceThresholdMaximum;
+
+	/**
+	 * Lookup table of the squared differences of all 8-bit values to a reference channel value.
+	 * @param reference Channel value of the reference color
+	 * @param squaredDifferences Table with 256 entries
+	 */
+	static void computeSquaredDifferences(int reference, int* squaredDifferences);
+
+	/**
+	 * Squared distance thresholds. A negative maximum lets no color pass.
+	 */
+	void getSquaredThresholds(double* minimumSquared, double* maximumSquared) const;
+
 public:
 	ColorBasedROIExtractorRGB();
 	virtual ~ColorBasedROIExtractorRGB();
 	void filter(PointCloud3D* originalPointCloud, PointCloud3D* resultPointCloud);
+
+	/**
+	 * Extracts subset of input point cloud based on the distance to the reference color.
+	 * Streams over the packed color channel of the input. All attributes of the selected points are kept.
+	 * @param originalPointCloud Input pointcloud. Without a color channel the result is empty.
+	 * @param resultPointCloud Extracted Subset
+	 */
+	void filter(PointCloud3DContiguous* originalPointCloud, PointCloud3DContiguous* resultPointCloud);
 //    void extractColorBasedROI(brics_3d::ColoredPointCloud3D *in_cloud, brics_3d::ColoredPointCloud3D *out_cloud);
 //    void extractColorBasedROI(brics_3d::ColoredPointCloud3D *in_cloud, brics_3d::PointCloud3D *out_cloud);
 
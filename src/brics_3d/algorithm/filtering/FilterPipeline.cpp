@@ -0,0 +1,206 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+#include "FilterPipeline.h"
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+using std::runtime_error;
+
+namespace brics_3d {
+
+const unsigned int FilterPipeline::defaultChunkSize;
+
+namespace {
+
+/// Measures the stages with boost, as the algorithm library does not link against brics3d_util (and its Timer).
+class StopWatch {
+public:
+
+	StopWatch() {
+		reset();
+	}
+
+	void reset() {
+		start = boost::posix_time::microsec_clock::universal_time();
+	}
+
+	/// Elapsed time in [ms] since the last reset().
+	long double getElapsedTime() const {
+		return (boost::posix_time::microsec_clock::universal_time() - start).total_microseconds() / 1000.0L;
+	}
+
+private:
+	boost::posix_time::ptime start;
+};
+
+}
+
+FilterPipeline::FilterPipeline() {
+	this->chunkSize = defaultChunkSize;
+	this->outputTime = 0.0;
+}
+
+FilterPipeline::~FilterPipeline() {
+
+}
+
+void FilterPipeline::addStage(IPointSelector* selector, const std::string& name) {
+	assert(selector != 0);
+	Stage stage;
+	stage.selector = selector;
+	stage.reduction = 0;
+	stage.name = name;
+	stage.time = 0.0;
+	stage.outputCount = 0;
+
+	if (!stages.empty() && stages.back().reduction != 0) {
+		stages.insert(stages.end() - 1, stage); // keep the reduction at the end
+	} else {
+		stages.push_back(stage);
+	}
+}
+
+void FilterPipeline::setReductionStage(IFiltering* reduction, const std::string& name) {
+	if (!stages.empty() && stages.back().reduction != 0) {
+		stages.pop_back();
+	}
+	if (reduction == 0) {
+		return;
+	}
+	Stage stage;
+	stage.selector = 0;
+	stage.reduction = reduction;
+	stage.name = name;
+	stage.time = 0.0;
+	stage.outputCount = 0;
+	stages.push_back(stage);
+}
+
+void FilterPipeline::clearStages() {
+	stages.clear();
+}
+
+void FilterPipeline::filter(PointCloud3D* originalPointCloud, PointCloud3D* resultPointCloud) {
+	assert(originalPointCloud != 0);
+	assert(resultPointCloud != 0);
+	assert(originalPointCloud != resultPointCloud);
+
+	IFiltering* reduction = (!stages.empty()) ? stages.back().reduction : 0;
+	unsigned int numberOfSelectors = (reduction != 0) ? stages.size() - 1 : stages.size();
+	for (unsigned int i = 0; i < stages.size(); ++i) {
+		stages[i].outputCount = 0;
+	}
+
+	boost::ptr_vector<Point3D>& points = *originalPointCloud->getPointCloud();
+	unsigned int numberOfPoints = originalPointCloud->getSize();
+	std::vector<unsigned int> indices(chunkSize);
+	PointCloud3D survivors; // only used for the reduction stage
+	StopWatch timer;
+
+	resultPointCloud->clear();
+
+	for (unsigned int chunkBegin = 0; chunkBegin < numberOfPoints; chunkBegin += chunkSize) {
+		unsigned int count = std::min(chunkSize, numberOfPoints - chunkBegin);
+		for (unsigned int i = 0; i < count; ++i) {
+			indices[i] = chunkBegin + i;
+		}
+
+		for (unsigned int stage = 0; stage < numberOfSelectors && count > 0; ++stage) {
+			timer.reset();
+			count = stages[stage].selector->select(originalPointCloud, &indices[0], count);
+			stages[stage].time += timer.getElapsedTime();
+			stages[stage].outputCount += count;
+		}
+
+		timer.reset();
+		if (reduction != 0) {
+			for (unsigned int i = 0; i < count; ++i) {
+				const Point3D& tmpPoint = points[indices[i]];
+				survivors.addPoint(Point3D(tmpPoint.getX(), tmpPoint.getY(), tmpPoint.getZ()));
+			}
+		} else {
+			for (unsigned int i = 0; i < count; ++i) {
+				resultPointCloud->addPointClone(points[indices[i]]);
+			}
+		}
+		outputTime += timer.getElapsedTime();
+	}
+
+	if (reduction != 0) {
+		timer.reset();
+		reduction->filter(&survivors, resultPointCloud);
+		stages.back().time += timer.getElapsedTime();
+		stages.back().outputCount = resultPointCloud->getSize();
+	}
+}
+
+unsigned int FilterPipeline::getNumberOfStages() const {
+	return static_cast<unsigned int>(stages.size());
+}
+
+const std::string& FilterPipeline::getStageName(unsigned int stage) const {
+	if (stage >= stages.size()) {
+		throw runtime_error("ERROR: FilterPipeline stage index out of range.");
+	}
+	return stages[stage].name;
+}
+
+long double FilterPipeline::getStageTime(unsigned int stage) const {
+	if (stage >= stages.size()) {
+		throw runtime_error("ERROR: FilterPipeline stage index out of range.");
+	}
+	return stages[stage].time;
+}
+
+long double FilterPipeline::getOutputTime() const {
+	return outputTime;
+}
+
+unsigned int FilterPipeline::getStageOutputCount(unsigned int stage) const {
+	if (stage >= stages.size()) {
+		throw runtime_error("ERROR: FilterPipeline stage index out of range.");
+	}
+	return stages[stage].outputCount;
+}
+
+void FilterPipeline::resetTimings() {
+	for (unsigned int i = 0; i < stages.size(); ++i) {
+		stages[i].time = 0.0;
+	}
+	outputTime = 0.0;
+}
+
+unsigned int FilterPipeline::getChunkSize() const {
+	return chunkSize;
+}
+
+void FilterPipeline::setChunkSize(unsigned int chunkSize) {
+	if (chunkSize == 0) {
+		throw runtime_error("ERROR: chunk size for FilterPipeline must be greater than 0.");
+	}
+	this->chunkSize = chunkSize;
+}
+
+}
+
+/* EOF */
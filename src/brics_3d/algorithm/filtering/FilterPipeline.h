@@ -0,0 +1,125 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+#ifndef BRICS_3D_FILTERPIPELINE_H_
+#define BRICS_3D_FILTERPIPELINE_H_
+
+#include "IFiltering.h"
+#include "IPointSelector.h"
+
+#include <string>
+#include <vector>
+
+namespace brics_3d {
+
+/**
+ * @brief Chain of filters that is evaluated in one pass over the input point cloud.
+ *
+ * Chaining IFiltering components creates a full intermediate point cloud after every stage.
+ * This pipeline instead walks over the input in chunks of point indices. Every chunk is passed
+ * through all IPointSelector stages, that only shrink the index list. Only the points that
+ * survive all stages are written:
+ *  - without a reduction stage the surviving points are cloned into the result (decorations are kept);
+ *  - with a reduction stage (e.g. brics_3d::Octree or brics_3d::VoxelGridFilter) the coordinates
+ *    of the surviving points are collected and reduced into the result.
+ *
+ * The stages are not owned by the pipeline. The time spent in each stage is accumulated, thus
+ * the cost of every stage can be compared in a running system.
+ * @ingroup filtering
+ */
+class FilterPipeline : public IFiltering {
+public:
+
+	/// Default number of points that are processed per chunk.
+	static const unsigned int defaultChunkSize = 4096;
+
+	FilterPipeline();
+
+	virtual ~FilterPipeline();
+
+	/**
+	 * @brief Append a selector stage. Stages are evaluated in the order they are added.
+	 * @param selector The selector. It has to stay valid as long as it is part of the pipeline.
+	 * @param name Name for reporting timings.
+	 */
+	void addStage(IPointSelector* selector, const std::string& name = "selector");
+
+	/**
+	 * @brief Set the stage that reduces the surviving points. It is always the last stage.
+	 * @param reduction The reduction filter. A null pointer removes the reduction stage.
+	 * @param name Name for reporting timings.
+	 */
+	void setReductionStage(IFiltering* reduction, const std::string& name = "reduction");
+
+	/**
+	 * @brief Remove all stages.
+	 */
+	void clearStages();
+
+	/**
+	 * @brief Run all stages on a point cloud.
+	 * @param[in] originalPointCloud The input point cloud. This data will not be modified.
+	 * @param[out] resultPointCloud The result is cleared first. It then holds the surviving points or,
+	 * with a reduction stage, whatever the reduction filter produces.
+	 */
+	void filter(PointCloud3D* originalPointCloud, PointCloud3D* resultPointCloud);
+
+	/// Number of stages including the reduction stage.
+	unsigned int getNumberOfStages() const;
+
+	const std::string& getStageName(unsigned int stage) const;
+
+	/// Accumulated time in [ms] spent in a stage since the last resetTimings().
+	long double getStageTime(unsigned int stage) const;
+
+	/// Accumulated time in [ms] for writing the surviving points since the last resetTimings().
+	long double getOutputTime() const;
+
+	/// Number of points that passed a stage in the last call of filter().
+	unsigned int getStageOutputCount(unsigned int stage) const;
+
+	void resetTimings();
+
+	unsigned int getChunkSize() const;
+
+	void setChunkSize(unsigned int chunkSize);
+
+private:
+
+	struct Stage {
+		IPointSelector* selector;
+		IFiltering* reduction;
+		std::string name;
+		long double time;
+		unsigned int outputCount;
+	};
+
+	/// Selector stages, the reduction stage (if any) is the last one.
+	std::vector<Stage> stages;
+
+	unsigned int chunkSize;
+
+	long double outputTime;
+};
+
+}
+
+#endif /* BRICS_3D_FILTERPIPELINE_H_ */
+
+/* EOF */
@@ -57,6 +57,20 @@ public:
 	 *
 	 */
 	virtual void partitionPointCloud(PointCloud3D* pointCloud, std::vector<PointCloud3D*>* pointCloudCells) = 0;
+
+	/**
+	 * @brief Partitions a point cloud into cells without copying any points.
+	 *
+	 * The result is a list of point indices that is ordered by cells: the points of the ith cell
+	 * are pointIndices[cellOffsets[i]] ... pointIndices[cellOffsets[i+1]-1]. cellOffsets has
+	 * one more entry than there are cells; the last entry equals the number of points.
+	 *
+	 * @param[in] pointCloud The input point cloud that will be partitioned. This data will not
+	 * be modified.
+	 * @param[out] pointIndices Indices into pointCloud, grouped by cells.
+	 * @param[out] cellOffsets Start of each cell in pointIndices.
+	 */
+	virtual void partitionPointCloud(PointCloud3D* pointCloud, std::vector<int>* pointIndices, std::vector<int>* cellOffsets) = 0;
 };
 
 }
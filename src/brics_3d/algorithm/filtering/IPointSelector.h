@@ -0,0 +1,55 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+#ifndef BRICS_3D_IPOINTSELECTOR_H_
+#define BRICS_3D_IPOINTSELECTOR_H_
+
+#include "brics_3d/core/PointCloud3D.h"
+
+namespace brics_3d {
+
+/**
+ * @brief Generic interface for a per point filter criterion that can be evaluated on parts of a point cloud.
+ *
+ * In contrast to IFiltering no result point cloud is created: a selector only narrows down a list of
+ * point indices. This allows to chain several criteria in one pass over the data without intermediate
+ * point clouds, see brics_3d::FilterPipeline.
+ * @ingroup filtering
+ */
+class IPointSelector {
+public:
+	IPointSelector(){};
+	virtual ~IPointSelector(){};
+
+	/**
+	 * @brief Keep the indices of the points that pass the criterion.
+	 * @param[in] pointCloud The input point cloud. This data will not be modified.
+	 * @param[in,out] indices Indices of the points that are tested. The indices that pass are moved to the
+	 * front, their order is preserved.
+	 * @param[in] count Number of indices to be tested.
+	 * @return Number of indices that passed.
+	 */
+	virtual unsigned int select(PointCloud3D* pointCloud, unsigned int* indices, unsigned int count) = 0;
+};
+
+}
+
+#endif /* BRICS_3D_IPOINTSELECTOR_H_ */
+
+/* EOF */
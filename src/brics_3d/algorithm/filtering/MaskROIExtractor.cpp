@@ -18,13 +18,37 @@
 ******************************************************************************/
 
 #include "MaskROIExtractor.h"
+#include "brics_3d/core/ParallelProcessing.h"
 #include "brics_3d/core/Logger.h"
 
+#include <algorithm>
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+
 namespace brics_3d {
 
+/// Copy the coordinates of the indexed input points into the (already allocated) output points [begin, end).
+static void copyIndexedRange(const boost::ptr_vector<Point3D>* input, const std::vector<int>* inliers, unsigned int begin, unsigned int end,
+		boost::ptr_vector<Point3D>* output) {
+	for (unsigned int i = begin; i < end; ++i) {
+		(*output)[i] = (*input)[(*inliers)[i]];
+	}
+}
+
+/// Append all indices in [begin, end) that are not flagged as inliers.
+static void collectNonIndexedRange(const std::vector<unsigned char>* isInlier, unsigned int begin, unsigned int end, std::vector<int>* result) {
+	result->reserve(end - begin);
+	for (unsigned int i = begin; i < end; ++i) {
+		if (!(*isInlier)[i]) {
+			result->push_back(i);
+		}
+	}
+}
+
 MaskROIExtractor::MaskROIExtractor() {
 	mask = 0;
 	useInvertedMask = false;
+	maxNumberOfThreads = 0;
 }
 
 MaskROIExtractor::~MaskROIExtractor() {
@@ -43,52 +67,63 @@ void MaskROIExtractor::filter(PointCloud3D* originalPointCloud, PointCloud3D* re
 	}
 }
 
-void MaskROIExtractor::extractIndexedPointCloud(brics_3d::PointCloud3D* inputPoinCloud, std::vector<int> inliers, brics_3d::PointCloud3D* outputPointCloud) {
+void MaskROIExtractor::extractIndexedPointCloud(brics_3d::PointCloud3D* inputPoinCloud, const std::vector<int>& inliers, brics_3d::PointCloud3D* outputPointCloud) {
 	assert(inputPoinCloud !=0);
 	assert(outputPointCloud !=0);
 
-	(*outputPointCloud->getPointCloud()).resize(inliers.size());
-	//copy over inliers
-	for (int i = 0; i < static_cast<int>(inliers.size()); ++i) {
-		(*outputPointCloud->getPointCloud())[i] = (*inputPoinCloud->getPointCloud())[inliers[i]];
+	/* allocate the output points up front; addPoint() places them into the arena of the output (if any) */
+	if (outputPointCloud->getSize() > inliers.size()) {
+		outputPointCloud->clear();
+	}
+	outputPointCloud->reserve(static_cast<unsigned int>(inliers.size()));
+	while (outputPointCloud->getSize() < inliers.size()) {
+		outputPointCloud->addPoint(0.0, 0.0, 0.0);
+	}
+
+	//copy over inliers; the points of the output already exist, so the ranges can be copied independently
+	unsigned int count = static_cast<unsigned int>(inliers.size());
+	unsigned int numberOfThreads = ParallelProcessing::getNumberOfThreads(count, parallelThreshold, maxNumberOfThreads);
+	unsigned int chunkSize = count / numberOfThreads;
+	boost::thread_group workers;
+	for (unsigned int i = 0; i < numberOfThreads - 1; ++i) {
+		workers.create_thread(boost::bind(&copyIndexedRange, inputPoinCloud->getPointCloud(), &inliers, i * chunkSize, (i + 1) * chunkSize, outputPointCloud->getPointCloud()));
 	}
+	copyIndexedRange(inputPoinCloud->getPointCloud(), &inliers, (numberOfThreads - 1) * chunkSize, count, outputPointCloud->getPointCloud());
+	workers.join_all();
 }
 
-void MaskROIExtractor::extractNonIndexedPointCloud(brics_3d::PointCloud3D* inputPoinCloud, std::vector<int> inliers, brics_3d::PointCloud3D* outputPointCloud) {
+void MaskROIExtractor::extractNonIndexedPointCloud(brics_3d::PointCloud3D* inputPoinCloud, const std::vector<int>& inliers, brics_3d::PointCloud3D* outputPointCloud) {
 	assert(inputPoinCloud !=0);
 	assert(outputPointCloud !=0);
-	std::vector<int> invertedInliers;
 
-	outputPointCloud->getPointCloud()->clear();
+	outputPointCloud->clear();
 
-	if(inliers.size() == inputPoinCloud->getSize()) {
-		return; //Nothing to do...
+	/* flag the inliers; everything else is collected in ranges and concatenated in order */
+	unsigned int count = inputPoinCloud->getSize();
+	std::vector<unsigned char> isInlier(count, 0);
+	for (unsigned int i = 0; i < inliers.size(); ++i) {
+		assert(inliers[i] >= 0 && static_cast<unsigned int>(inliers[i]) < count);
+		isInlier[inliers[i]] = 1;
 	}
 
-	int indliersIndex = 0;
-	int invertedIndliersIndex = 0;
-	std::sort(inliers.begin(), inliers.end());
-	invertedInliers.resize(inputPoinCloud->getSize()-inliers.size());
-	invertedInliers[invertedInliers.size()-1] = 0;//-1; FIXME
-	for (int i = 0; i < static_cast<int>(inputPoinCloud->getSize()); ++i) { // run ofer all input data and skip those that belong to inliers
-		if (i == inliers[indliersIndex]) {
-			indliersIndex++;
-			continue; // skip insertion
+	unsigned int numberOfThreads = ParallelProcessing::getNumberOfThreads(count, parallelThreshold, maxNumberOfThreads);
+	unsigned int chunkSize = count / numberOfThreads;
+	std::vector<std::vector<int> > partialInvertedInliers(numberOfThreads);
+	{
+		boost::thread_group workers;
+		for (unsigned int i = 0; i < numberOfThreads - 1; ++i) {
+			workers.create_thread(boost::bind(&collectNonIndexedRange, &isInlier, i * chunkSize, (i + 1) * chunkSize, &partialInvertedInliers[i]));
 		}
-		invertedInliers[invertedIndliersIndex] = i;
-		invertedIndliersIndex++;
+		collectNonIndexedRange(&isInlier, (numberOfThreads - 1) * chunkSize, count, &partialInvertedInliers[numberOfThreads - 1]);
+		workers.join_all();
 	}
-	LOG(DEBUG) << "invertedInliers[invertedInliers.size()-1] = " << invertedInliers[invertedInliers.size()-1] << " invertedIndliersIndex = " << invertedIndliersIndex;
-	LOG(DEBUG) << "inliers.size(), invertedInliers.size(), inputPoinCloud->getSize()" << inliers.size() << ", " << invertedInliers.size() << ", " << inputPoinCloud->getSize();
-	assert( invertedInliers[invertedInliers.size()-1] >= 0);
-//		assert(invertedInliers.size() == inputPoinCloud->getSize());
-
 
-//		for (int i = 0; i < static_cast<int>(inliers.size()); ++i) {
-//			invertedInliers.erase(invertedInliers.begin() + inliers[i]);
-//		}
-//	LOG(DEBUG) << "inliers.size(), invertedInliers.size(), inputPoinCloud->getSize()" << inliers.size() << ", " << invertedInliers.size() << ", " << inputPoinCloud->getSize();
-	assert(inliers.size() + invertedInliers.size() == inputPoinCloud->getSize());
+	std::vector<int> invertedInliers;
+	invertedInliers.reserve(count);
+	for (unsigned int i = 0; i < numberOfThreads; ++i) {
+		invertedInliers.insert(invertedInliers.end(), partialInvertedInliers[i].begin(), partialInvertedInliers[i].end());
+	}
+	LOG(DEBUG) << "inliers.size(), invertedInliers.size(), inputPoinCloud->getSize()" << inliers.size() << ", " << invertedInliers.size() << ", " << inputPoinCloud->getSize();
 	extractIndexedPointCloud(inputPoinCloud, invertedInliers, outputPointCloud);
 }
 
@@ -105,6 +140,14 @@ bool MaskROIExtractor::getUseInvertedMask() {
 	return this->useInvertedMask;
 }
 
+void MaskROIExtractor::setMaxNumberOfThreads(unsigned int maxNumberOfThreads) {
+	this->maxNumberOfThreads = maxNumberOfThreads;
+}
+
+unsigned int MaskROIExtractor::getMaxNumberOfThreads() {
+	return this->maxNumberOfThreads;
+}
+
 }
 
 /* EOF */
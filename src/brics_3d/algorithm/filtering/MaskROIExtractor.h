@@ -24,16 +24,28 @@
 
 namespace brics_3d {
 
+/**
+ * @brief Extracts the points of a point cloud that are listed in (or missing from) an index mask.
+ *
+ * Large point clouds are copied by multiple threads. The inverted mask is computed via a flag per
+ * point, the mask does not need to be sorted. The order of the result always follows the mask
+ * (or the input for the inverted mask).
+ * @ingroup filtering
+ */
 class MaskROIExtractor : public IFiltering {
 public:
+
+	/// Threshold for ParallelProcessing::getNumberOfThreads().
+	static const unsigned int parallelThreshold = 100000;
+
 	MaskROIExtractor();
 	virtual ~MaskROIExtractor();
 
 	void filter(PointCloud3D* originalPointCloud, PointCloud3D* resultPointCloud);
 
-	void extractIndexedPointCloud(brics_3d::PointCloud3D* inputPoinCloud, std::vector<int> inliers, brics_3d::PointCloud3D* outputPointCloud);
+	void extractIndexedPointCloud(brics_3d::PointCloud3D* inputPoinCloud, const std::vector<int>& inliers, brics_3d::PointCloud3D* outputPointCloud);
 
-	void extractNonIndexedPointCloud(brics_3d::PointCloud3D* inputPoinCloud, std::vector<int> inliers, brics_3d::PointCloud3D* outputPointCloud);
+	void extractNonIndexedPointCloud(brics_3d::PointCloud3D* inputPoinCloud, const std::vector<int>& inliers, brics_3d::PointCloud3D* outputPointCloud);
 
 	void setMask(std::vector<int>* mask);
 
@@ -41,12 +53,21 @@ public:
 
 	bool getUseInvertedMask();
 
+	/**
+	 * @brief Limit the number of threads.
+	 * @param maxNumberOfThreads Upper limit, see ParallelProcessing::getNumberOfThreads().
+	 */
+	void setMaxNumberOfThreads(unsigned int maxNumberOfThreads);
+
+	unsigned int getMaxNumberOfThreads();
+
 private:
 
 	std::vector<int>* mask;
 
 	bool useInvertedMask;
 
+	unsigned int maxNumberOfThreads;
 };
 
 }
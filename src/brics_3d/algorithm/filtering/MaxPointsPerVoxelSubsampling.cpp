@@ -0,0 +1,123 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+
+#include "MaxPointsPerVoxelSubsampling.h"
+
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+
+using std::runtime_error;
+
+namespace brics_3d {
+
+/// Number of bits per axis in a packed voxel index.
+static const int voxelKeyBits = 21;
+
+/// Offset that maps the voxel indices [-2^20, 2^20) of an axis to [0, 2^21).
+static const double voxelIndexOffset = static_cast<double>(1 << (voxelKeyBits - 1));
+
+/**
+ * Pack the voxel of a point into one key.
+ * @return False if the point is not valid or outside of the supported range.
+ */
+static inline bool getVoxelKey(double x, double y, double z, double inverseVoxelSize, boost::uint64_t* key) {
+	double ix = std::floor(x * inverseVoxelSize) + voxelIndexOffset;
+	double iy = std::floor(y * inverseVoxelSize) + voxelIndexOffset;
+	double iz = std::floor(z * inverseVoxelSize) + voxelIndexOffset;
+	const double limit = 2.0 * voxelIndexOffset;
+	if (!(ix >= 0.0 && ix < limit && iy >= 0.0 && iy < limit && iz >= 0.0 && iz < limit)) { // also catches NaN
+		return false;
+	}
+	*key = (static_cast<boost::uint64_t>(ix) << (2 * voxelKeyBits)) | (static_cast<boost::uint64_t>(iy) << voxelKeyBits) |
+			static_cast<boost::uint64_t>(iz);
+	return true;
+}
+
+MaxPointsPerVoxelSubsampling::MaxPointsPerVoxelSubsampling(double voxelSize, unsigned int maxPointsPerVoxel) {
+	this->voxelSize = 0.1;
+	setVoxelSize(voxelSize);
+	this->maxPointsPerVoxel = maxPointsPerVoxel;
+	reset();
+}
+
+MaxPointsPerVoxelSubsampling::~MaxPointsPerVoxelSubsampling() {
+
+}
+
+void MaxPointsPerVoxelSubsampling::reset() {
+	SubsamplingFilter::reset();
+	pointsPerVoxel.clear();
+	activeVoxelSize = voxelSize;
+	activeMaxPointsPerVoxel = maxPointsPerVoxel;
+}
+
+void MaxPointsPerVoxelSubsampling::addChunk(PointCloud3D* chunk, PointCloud3D* resultPointCloud) {
+	assert(chunk != 0);
+	assert(resultPointCloud != 0);
+	assert(chunk != resultPointCloud);
+
+	boost::ptr_vector<Point3D>& points = *chunk->getPointCloud();
+	unsigned int chunkSize = chunk->getSize();
+	numberOfProcessedPoints += chunkSize;
+	if (activeMaxPointsPerVoxel == 0) {
+		return;
+	}
+
+	double inverseVoxelSize = 1.0 / activeVoxelSize;
+	boost::uint64_t key;
+	for (unsigned int i = 0; i < chunkSize; ++i) {
+		if (!getVoxelKey(points[i].getX(), points[i].getY(), points[i].getZ(), inverseVoxelSize, &key)) {
+			continue;
+		}
+		unsigned int& count = pointsPerVoxel[key];
+		if (count < activeMaxPointsPerVoxel) {
+			count++;
+			resultPointCloud->addPointClone(points[i]);
+		}
+	}
+}
+
+double MaxPointsPerVoxelSubsampling::getVoxelSize() const {
+	return voxelSize;
+}
+
+void MaxPointsPerVoxelSubsampling::setVoxelSize(double voxelSize) {
+	if (!(voxelSize > 0.0)) {
+		throw runtime_error("ERROR: voxel size for MaxPointsPerVoxelSubsampling must be greater than 0.");
+	}
+	this->voxelSize = voxelSize;
+}
+
+unsigned int MaxPointsPerVoxelSubsampling::getMaxPointsPerVoxel() const {
+	return maxPointsPerVoxel;
+}
+
+void MaxPointsPerVoxelSubsampling::setMaxPointsPerVoxel(unsigned int maxPointsPerVoxel) {
+	this->maxPointsPerVoxel = maxPointsPerVoxel;
+}
+
+unsigned int MaxPointsPerVoxelSubsampling::getNumberOfVoxels() const {
+	return static_cast<unsigned int>(pointsPerVoxel.size());
+}
+
+}
+
+/* EOF */
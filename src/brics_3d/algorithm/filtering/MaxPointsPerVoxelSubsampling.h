@@ -0,0 +1,96 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+
+#ifndef BRICS_3D_MAXPOINTSPERVOXELSUBSAMPLING_H_
+#define BRICS_3D_MAXPOINTSPERVOXELSUBSAMPLING_H_
+
+#include "SubsamplingFilter.h"
+
+#include <boost/unordered_map.hpp>
+
+namespace brics_3d {
+
+/**
+ * @brief Limits the number of points per cell of a regular voxel grid.
+ *
+ * The first maxPointsPerVoxel points of the point cloud or stream that fall into a voxel are
+ * kept, all further points of that voxel are dropped. In contrast to the brics_3d::VoxelGridFilter
+ * dense regions are thinned out while the original points (including their decorations) and
+ * sparse regions stay untouched. Selected points are appended directly by addChunk().
+ *
+ * The grid is aligned with the origin, thus it does not depend on the extent of the data. Memory
+ * grows with the number of occupied voxels. Voxel indices are limited to +-2^20 per axis; points
+ * outside of that range as well as NaN or infinite coordinates are dropped.
+ * @ingroup filtering
+ */
+class MaxPointsPerVoxelSubsampling : public SubsamplingFilter {
+public:
+
+	/**
+	 * @brief Constructor.
+	 * @param voxelSize Edge length of a voxel. Must be greater than 0.
+	 * @param maxPointsPerVoxel Number of points that are kept per voxel.
+	 */
+	MaxPointsPerVoxelSubsampling(double voxelSize = 0.1, unsigned int maxPointsPerVoxel = 1);
+
+	virtual ~MaxPointsPerVoxelSubsampling();
+
+	void reset();
+
+	void addChunk(PointCloud3D* chunk, PointCloud3D* resultPointCloud);
+
+	double getVoxelSize() const;
+
+	/**
+	 * @brief Set the edge length of a voxel. Takes effect with the next reset().
+	 */
+	void setVoxelSize(double voxelSize);
+
+	unsigned int getMaxPointsPerVoxel() const;
+
+	/**
+	 * @brief Set the number of points that are kept per voxel. Takes effect with the next reset().
+	 */
+	void setMaxPointsPerVoxel(unsigned int maxPointsPerVoxel);
+
+	/// Number of occupied voxels in the current stream.
+	unsigned int getNumberOfVoxels() const;
+
+private:
+
+	/// Edge length of a voxel.
+	double voxelSize;
+
+	/// Number of points that are kept per voxel.
+	unsigned int maxPointsPerVoxel;
+
+	/// Parameters of the current stream.
+	double activeVoxelSize;
+	unsigned int activeMaxPointsPerVoxel;
+
+	/// Number of points so far per packed voxel index.
+	boost::unordered_map<boost::uint64_t, unsigned int> pointsPerVoxel;
+};
+
+}
+
+#endif /* BRICS_3D_MAXPOINTSPERVOXELSUBSAMPLING_H_ */
+
+/* EOF */
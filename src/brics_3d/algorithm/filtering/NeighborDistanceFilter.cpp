@@ -0,0 +1,152 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+#include "NeighborDistanceFilter.h"
+#include "brics_3d/algorithm/nearestNeighbor/NearestNeighborANN.h"
+#include "brics_3d/algorithm/nearestNeighbor/NearestNeighborBatchResult.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+namespace brics_3d {
+
+/// Number of points that are queried as one batch. This bounds the size of the batch result.
+static const unsigned int queryBlockSize = 16384;
+
+/**
+ * Reduce the neighbors of a batch of queries to one distance value per query. The search returns the
+ * squared distances along with the indices, so no coordinates need to be read again.
+ */
+static void computeDistancesBlock(const NearestNeighborBatchResult& neighbors, unsigned int k, bool useMean, double* distances) {
+	for (unsigned int i = 0; i < neighbors.getNumberOfQueries(); ++i) {
+		unsigned int numberOfNeighbors = neighbors.getNumberOfNeighbors(i);
+		const double* squaredDistances = (numberOfNeighbors > 0) ? neighbors.getSquaredDistances(i) : 0;
+
+		double sum = 0.0;
+		double largest = 0.0;
+		double smallest = -1.0;
+		for (unsigned int j = 0; j < numberOfNeighbors; ++j) {
+			double distance = std::sqrt(squaredDistances[j]);
+			sum += distance;
+			largest = std::max(largest, distance);
+			smallest = (smallest < 0.0) ? distance : std::min(smallest, distance);
+		}
+
+		/* the closest result is the point itself (or a duplicate of it) */
+		if (numberOfNeighbors > 0) {
+			sum -= smallest;
+			numberOfNeighbors--;
+		}
+		if (useMean) {
+			distances[i] = (numberOfNeighbors > 0) ? sum / numberOfNeighbors : 0.0;
+		} else {
+			distances[i] = (numberOfNeighbors < k) ? std::numeric_limits<double>::max() : largest; // e.g. limited by a maximum distance of the search
+		}
+	}
+}
+
+NeighborDistanceFilter::NeighborDistanceFilter() {
+	this->nearestNeighborAlgorithm = new NearestNeighborANN();
+	this->maxNumberOfThreads = 0;
+}
+
+NeighborDistanceFilter::NeighborDistanceFilter(INearestPoint3DNeighbor* nearestNeighborAlgorithm) {
+	assert(nearestNeighborAlgorithm != 0);
+	this->nearestNeighborAlgorithm = nearestNeighborAlgorithm;
+	this->maxNumberOfThreads = 0;
+}
+
+NeighborDistanceFilter::~NeighborDistanceFilter() {
+	if (nearestNeighborAlgorithm != 0) {
+		delete nearestNeighborAlgorithm;
+	}
+}
+
+INearestPoint3DNeighbor* NeighborDistanceFilter::getNearestNeighborAlgorithm() const {
+	return nearestNeighborAlgorithm;
+}
+
+void NeighborDistanceFilter::setNearestNeighborAlgorithm(INearestPoint3DNeighbor* nearestNeighborAlgorithm) {
+	assert(nearestNeighborAlgorithm != 0);
+	if (nearestNeighborAlgorithm != this->nearestNeighborAlgorithm) {
+		delete this->nearestNeighborAlgorithm;
+		this->nearestNeighborAlgorithm = nearestNeighborAlgorithm;
+	}
+}
+
+void NeighborDistanceFilter::setMaxNumberOfThreads(unsigned int maxNumberOfThreads) {
+	this->maxNumberOfThreads = maxNumberOfThreads;
+}
+
+unsigned int NeighborDistanceFilter::getMaxNumberOfThreads() {
+	return this->maxNumberOfThreads;
+}
+
+void NeighborDistanceFilter::computeNeighborDistances(PointCloud3D* pointCloud, unsigned int k, DistanceMeasure measure, std::vector<double>* distances) {
+	assert(pointCloud != 0);
+	assert(distances != 0);
+
+	unsigned int count = pointCloud->getSize();
+	distances->assign(count, 0.0);
+	if (count < 2 || k == 0) {
+		return; // no neighbors at all
+	}
+	k = std::min(k, count - 1);
+
+	nearestNeighborAlgorithm->setData(pointCloud);
+
+	/* the search distributes every batch over its threads (if it supports concurrent queries) */
+	INearestNeighborSetup* nearestNeighborSetup = dynamic_cast<INearestNeighborSetup*>(nearestNeighborAlgorithm);
+	if (nearestNeighborSetup != 0) {
+		nearestNeighborSetup->setMaxNumberOfThreads(maxNumberOfThreads);
+	}
+	bool useMean = (measure == meanDistance);
+
+	std::vector<int> queryIndices;
+	NearestNeighborBatchResult neighbors; // reused by all blocks
+	for (unsigned int blockBegin = 0; blockBegin < count; blockBegin += queryBlockSize) {
+		unsigned int blockEnd = std::min(count, blockBegin + queryBlockSize);
+		queryIndices.resize(blockEnd - blockBegin);
+		for (unsigned int i = blockBegin; i < blockEnd; ++i) {
+			queryIndices[i - blockBegin] = static_cast<int>(i);
+		}
+		nearestNeighborAlgorithm->findNearestNeighbors(pointCloud, queryIndices, &neighbors, k + 1);
+		computeDistancesBlock(neighbors, k, useMean, &(*distances)[blockBegin]);
+	}
+}
+
+void NeighborDistanceFilter::copySelectedPoints(PointCloud3D* originalPointCloud, const std::vector<unsigned char>& isSelected, PointCloud3D* resultPointCloud) {
+	assert(originalPointCloud != 0);
+	assert(resultPointCloud != 0);
+	assert(isSelected.size() == originalPointCloud->getSize());
+
+	boost::ptr_vector<Point3D>* points = originalPointCloud->getPointCloud();
+	resultPointCloud->reserve(resultPointCloud->getSize() + static_cast<unsigned int>(std::count(isSelected.begin(), isSelected.end(), 1)));
+	for (unsigned int i = 0; i < isSelected.size(); ++i) {
+		if (isSelected[i]) {
+			resultPointCloud->addPointClone((*points)[i]);
+		}
+	}
+}
+
+}
+
+/* EOF */
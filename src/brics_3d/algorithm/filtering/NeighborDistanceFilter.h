@@ -0,0 +1,112 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+#ifndef BRICS_3D_NEIGHBORDISTANCEFILTER_H_
+#define BRICS_3D_NEIGHBORDISTANCEFILTER_H_
+
+#include "IFiltering.h"
+#include "brics_3d/algorithm/nearestNeighbor/INearestPoint3DNeighbor.h"
+#include "brics_3d/algorithm/nearestNeighbor/INearestNeighborSetup.h"
+
+#include <vector>
+
+namespace brics_3d {
+
+/**
+ * @brief Common base for filters that judge every point by the distances to its nearest neighbors.
+ *
+ * The nearest neighbor search is done with an INearestPoint3DNeighbor strategy. Per default the exact
+ * brics_3d::NearestNeighborANN search is used. The queries are issued as batches over blocks of the
+ * point cloud, which bounds the size of the intermediate NearestNeighborBatchResult. If the strategy
+ * supports concurrent queries (see INearestPoint3DNeighbor::supportsConcurrentQueries()) it distributes
+ * every batch over multiple threads. This is the case for brics_3d::NearestNeighborSTANN, which is faster
+ * but might return approximate neighbors for regularly sampled data.
+ * @ingroup filtering
+ */
+class NeighborDistanceFilter : public IFiltering {
+public:
+
+	/**
+	 * @brief Standard constructor. Uses a NearestNeighborANN search.
+	 */
+	NeighborDistanceFilter();
+
+	/**
+	 * @brief Constructor that defines the nearest neighbor search strategy.
+	 * @param nearestNeighborAlgorithm The strategy. Ownership is taken over by this filter.
+	 */
+	NeighborDistanceFilter(INearestPoint3DNeighbor* nearestNeighborAlgorithm);
+
+	virtual ~NeighborDistanceFilter();
+
+	INearestPoint3DNeighbor* getNearestNeighborAlgorithm() const;
+
+	/**
+	 * @brief Set the nearest neighbor search strategy.
+	 * @param nearestNeighborAlgorithm The strategy. Ownership is taken over by this filter; the previous one is deleted.
+	 */
+	void setNearestNeighborAlgorithm(INearestPoint3DNeighbor* nearestNeighborAlgorithm);
+
+	/**
+	 * @brief Limit the number of threads.
+	 *
+	 * The limit is passed on to search strategies that implement INearestNeighborSetup.
+	 * @param maxNumberOfThreads Upper limit, see ParallelProcessing::getNumberOfThreads().
+	 */
+	void setMaxNumberOfThreads(unsigned int maxNumberOfThreads);
+
+	unsigned int getMaxNumberOfThreads();
+
+protected:
+
+	/// Which value represents the distances of the k neighbors of a point.
+	enum DistanceMeasure {
+		meanDistance,
+		maxDistance
+	};
+
+	/**
+	 * @brief Compute one distance value per point with respect to its k nearest neighbors.
+	 *
+	 * The point itself is not counted as neighbor. If the point cloud has less than k+1 points,
+	 * all other points are used. If the search returns less than k neighbors (e.g. due to a maximum
+	 * distance of the search strategy) the maximum distance is std::numeric_limits<double>::max().
+	 * @param[in] pointCloud The point cloud. It is set as data for the nearest neighbor search.
+	 * @param[in] k Number of neighbors.
+	 * @param[in] measure Mean or maximum distance to the neighbors.
+	 * @param[out] distances One value per point.
+	 */
+	void computeNeighborDistances(PointCloud3D* pointCloud, unsigned int k, DistanceMeasure measure, std::vector<double>* distances);
+
+	/// Clone the points that are flagged into the result.
+	void copySelectedPoints(PointCloud3D* originalPointCloud, const std::vector<unsigned char>& isSelected, PointCloud3D* resultPointCloud);
+
+private:
+
+	/// Internal handle to the nearest neighbor search strategy
+	INearestPoint3DNeighbor* nearestNeighborAlgorithm;
+
+	unsigned int maxNumberOfThreads;
+};
+
+}
+
+#endif /* BRICS_3D_NEIGHBORDISTANCEFILTER_H_ */
+
+/* EOF */
@@ -38,7 +38,7 @@ void Octree::filter(PointCloud3D* originalPointCloud, PointCloud3D* resultPointC
 	assert(originalPointCloud != 0);
 	assert(resultPointCloud != 0);
 
-	resultPointCloud->getPointCloud()->clear();
+	resultPointCloud->clear();
 
 	if(originalPointCloud->getSize() == 0) {
 		return; //Nothing to do here..
@@ -52,19 +52,15 @@ void Octree::filter(PointCloud3D* originalPointCloud, PointCloud3D* resultPointC
 	}
 
 	/* prepare data */
-	double** tmpPointCloudPoints = new double*[originalPointCloud->getSize()];
-	for (unsigned int i = 0; i < originalPointCloud->getSize(); i++) {
-		tmpPointCloudPoints[i] = new double[3];
-		tmpPointCloudPoints[i][0] = (*originalPointCloud->getPointCloud())[i].getX();
-		tmpPointCloudPoints[i][1] = (*originalPointCloud->getPointCloud())[i].getY();
-		tmpPointCloudPoints[i][2] = (*originalPointCloud->getPointCloud())[i].getZ();
-	}
+	std::vector<double> coordinates;
+	std::vector<double*> tmpPointCloudPoints;
+	prepareData(originalPointCloud, coordinates, tmpPointCloudPoints);
 
 	/* create octree */
-	OctTree *octree = new OctTree(tmpPointCloudPoints, originalPointCloud->getSize(), this->voxelSize);
+	OctTree *octree = new OctTree(&tmpPointCloudPoints[0], originalPointCloud->getSize(), this->voxelSize);
 
 	/* process results */
-	resultPointCloud->getPointCloud()->clear();
+	resultPointCloud->clear();
 	vector<double*> center;
 	center.clear();
 	octree->GetOctTreeCenter(center);
@@ -83,71 +79,101 @@ void Octree::filter(PointCloud3D* originalPointCloud, PointCloud3D* resultPointC
 
 	/* clean up */
 	delete octree;
-	for (int i = 0; i < static_cast<int>(originalPointCloud->getSize()); ++i) {
-		delete [] tmpPointCloudPoints[i];
-	}
-	delete [] tmpPointCloudPoints;
 }
 
 void Octree::partitionPointCloud(PointCloud3D* pointCloud, std::vector<PointCloud3D*>* pointCloudCells) {
 	assert(pointCloud != 0);
 	assert(pointCloudCells != 0);
 
-	unsigned int totalPointsCount = 0; //for plausibility check
-
 	pointCloudCells->clear();
-	if (voxelSize <=0) {
+	if (voxelSize <=0 && pointCloud->getSize() == 0) {
+		PointCloud3D* tmpPointCloud = new PointCloud3D(); // there is always one cell if no voxel size is set
+		tmpPointCloud->setArena(pointCloud->getArena());
+		pointCloudCells->push_back(tmpPointCloud);
+		return;
+	}
+
+	std::vector<int> pointIndices;
+	std::vector<int> cellOffsets;
+	partitionPointCloud(pointCloud, &pointIndices, &cellOffsets);
+
+	boost::ptr_vector<Point3D>* points = pointCloud->getPointCloud();
+	pointCloudCells->reserve(cellOffsets.size() - 1);
+	for (unsigned int i = 0; i + 1 < cellOffsets.size(); ++i) { // each partition/cell
 		PointCloud3D* tmpPointCloud = new PointCloud3D();
-		for (int i = 0; i < static_cast<int>(pointCloud->getSize()); ++i) { //just copy data
-			tmpPointCloud->addPoint((*pointCloud->getPointCloud())[i]);
-			totalPointsCount++;
+		tmpPointCloud->setArena(pointCloud->getArena()); // cells share the arena of the input (if any)
+		tmpPointCloud->reserve(cellOffsets[i + 1] - cellOffsets[i]);
+		for (int j = cellOffsets[i]; j < cellOffsets[i + 1]; ++j) { // each point in a partition/cell
+			const Point3D& tmpPoint = (*points)[pointIndices[j]];
+			tmpPointCloud->addPoint(Point3D(tmpPoint.getX(), tmpPoint.getY(), tmpPoint.getZ()));
 		}
 		pointCloudCells->push_back(tmpPointCloud);
-		assert (pointCloud->getSize() == totalPointsCount); //plausibility check
+	}
+}
+
+void Octree::partitionPointCloud(PointCloud3D* pointCloud, std::vector<int>* pointIndices, std::vector<int>* cellOffsets) {
+	assert(pointCloud != 0);
+	assert(pointIndices != 0);
+	assert(cellOffsets != 0);
+
+	unsigned int numberOfPoints = pointCloud->getSize();
+	pointIndices->clear();
+	pointIndices->reserve(numberOfPoints);
+	cellOffsets->clear();
+	cellOffsets->push_back(0);
+
+	if (numberOfPoints == 0) {
+		return; //Nothing to do here..
+	}
+
+	if (voxelSize <=0) { // one cell with all points
+		for (unsigned int i = 0; i < numberOfPoints; ++i) {
+			pointIndices->push_back(i);
+		}
+		cellOffsets->push_back(numberOfPoints);
 		return;
 	}
 
 	/* prepare data */
-	double** tmpPointCloudPoints = new double*[pointCloud->getSize()];
-	for (unsigned int i = 0; i < pointCloud->getSize(); i++) {
-		tmpPointCloudPoints[i] = new double[3];
-		tmpPointCloudPoints[i][0] = (*pointCloud->getPointCloud())[i].getX();
-		tmpPointCloudPoints[i][1] = (*pointCloud->getPointCloud())[i].getY();
-		tmpPointCloudPoints[i][2] = (*pointCloud->getPointCloud())[i].getZ();
-	}
+	std::vector<double> coordinates;
+	std::vector<double*> tmpPointCloudPoints;
+	prepareData(pointCloud, coordinates, tmpPointCloudPoints);
 
 	/* create octree */
-	OctTree *octree = new OctTree(tmpPointCloudPoints, pointCloud->getSize(), this->voxelSize);
+	OctTree *octree = new OctTree(&tmpPointCloudPoints[0], numberOfPoints, this->voxelSize);
 
-	/* process results */
+	/* process results: the octree stores pointers into coordinates, so the original index can be recovered */
 	vector<vector<double*> > partition;
-	partition.clear();
 	octree->GetOctTreePartition(partition);
 
+	const double* coordinatesBegin = &coordinates[0];
+	cellOffsets->reserve(partition.size() + 1);
 	for (unsigned int i = 0; i < partition.size(); ++i) { // each partition/cell
-		PointCloud3D* tmpPointCloud = new PointCloud3D();
-		for (unsigned int j = 0; j < partition[i].size(); ++j) { // each point in a partition/cell
-			Point3D tmpPoint = Point3D();
-			vector<double*> tmpResultPoint;
-			tmpResultPoint = partition[i];
-			tmpPoint.setX(tmpResultPoint[j][0]);
-			tmpPoint.setY(tmpResultPoint[j][1]);
-			tmpPoint.setZ(tmpResultPoint[j][2]);
-			tmpPointCloud->addPoint(tmpPoint);
-			totalPointsCount++;
+		const vector<double*>& cellPoints = partition[i];
+		for (unsigned int j = 0; j < cellPoints.size(); ++j) { // each point in a partition/cell
+			pointIndices->push_back(static_cast<int>((cellPoints[j] - coordinatesBegin) / 3));
 		}
-		pointCloudCells->push_back(tmpPointCloud);
+		cellOffsets->push_back(static_cast<int>(pointIndices->size()));
 	}
 
 	/* plausibility check */
-	assert (pointCloud->getSize() == totalPointsCount);
+	assert (numberOfPoints == pointIndices->size());
 
 	/* clean up */
 	delete octree;
-	for (int i = 0; i < static_cast<int>(pointCloud->getSize()); ++i) {
-		delete [] tmpPointCloudPoints[i];
+}
+
+void Octree::prepareData(PointCloud3D* pointCloud, std::vector<double>& coordinates, std::vector<double*>& points) {
+	unsigned int numberOfPoints = pointCloud->getSize();
+	coordinates.resize(3 * numberOfPoints);
+	points.resize(numberOfPoints);
+	for (unsigned int i = 0; i < numberOfPoints; i++) {
+		const Point3D& point = (*pointCloud->getPointCloud())[i];
+		coordinates[3 * i + 0] = point.getX();
+		coordinates[3 * i + 1] = point.getY();
+		coordinates[3 * i + 2] = point.getZ();
+		points[i] = &coordinates[3 * i];
 	}
-	delete [] tmpPointCloudPoints;
 }
 
 void Octree::setVoxelSize(double voxelSize) {
@@ -47,12 +47,22 @@ public:
 
 	void partitionPointCloud(PointCloud3D* pointCloud, std::vector<PointCloud3D*>* pointCloudCells);
 
+	void partitionPointCloud(PointCloud3D* pointCloud, std::vector<int>* pointIndices, std::vector<int>* cellOffsets);
+
 	void setVoxelSize(double voxelSize);
 
 	double getVoxelSize();
 
 private:
 
+	/**
+	 * @brief Copy the coordinates of a point cloud into one contiguous buffer as required by the 6dslam octree.
+	 * @param[in] pointCloud Input data.
+	 * @param[out] coordinates x,y,z triples.
+	 * @param[out] points Pointers to the triples. The index of a point is (points[i] - &coordinates[0]) / 3.
+	 */
+	void prepareData(PointCloud3D* pointCloud, std::vector<double>& coordinates, std::vector<double*>& points);
+
 	/// The maximum voxel size of the smallest cube in the Octree
 	double voxelSize;
 
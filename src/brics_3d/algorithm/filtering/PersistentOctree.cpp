@@ -0,0 +1,555 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+#include "PersistentOctree.h"
+#include "brics_3d/core/Logger.h"
+
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+
+using std::runtime_error;
+
+namespace brics_3d {
+
+/// Shift of the leaf indices: alternating bits, about 2^60. Keeps shifted indices positive.
+static const long long leafIndexOffset = 0x1555555555555555LL;
+
+/// Largest distance to the origin in voxels that can be represented with the shifted indices.
+static const double maxLeafIndex = 1.0e17;
+
+PersistentOctree::PersistentOctree() {
+	this->voxelSize = 0.1;
+	this->root = -1;
+	this->currentFrame = 0;
+}
+
+PersistentOctree::PersistentOctree(double voxelSize) {
+	this->voxelSize = 0.1;
+	this->root = -1;
+	this->currentFrame = 0;
+	setVoxelSize(voxelSize);
+}
+
+PersistentOctree::~PersistentOctree() {
+
+}
+
+void PersistentOctree::filter(PointCloud3D* originalPointCloud, PointCloud3D* resultPointCloud) {
+	assert(originalPointCloud != 0);
+	assert(resultPointCloud != 0);
+
+	resultPointCloud->clear();
+	std::vector<int> pointIndices;
+	std::vector<int> cellOffsets;
+	partitionPointCloud(originalPointCloud, &pointIndices, &cellOffsets);
+
+	/* one centroid per touched leaf */
+	resultPointCloud->reserve(cellOffsets.size() - 1);
+	for (unsigned int i = 0; i + 1 < cellOffsets.size(); ++i) {
+		const Point3D& point = (*originalPointCloud->getPointCloud())[pointIndices[cellOffsets[i]]];
+		long long leafIndex[3];
+		computeLeafIndex(point.getX(), point.getY(), point.getZ(), leafIndex);
+		Point3D centroid;
+		computeLeafCentroid(findNode(leafIndex, 0), centroid);
+		resultPointCloud->addPoint(centroid);
+	}
+}
+
+void PersistentOctree::partitionPointCloud(PointCloud3D* pointCloud, std::vector<PointCloud3D*>* pointCloudCells) {
+	assert(pointCloud != 0);
+	assert(pointCloudCells != 0);
+
+	pointCloudCells->clear();
+	std::vector<int> pointIndices;
+	std::vector<int> cellOffsets;
+	partitionPointCloud(pointCloud, &pointIndices, &cellOffsets);
+
+	boost::ptr_vector<Point3D>* points = pointCloud->getPointCloud();
+	pointCloudCells->reserve(cellOffsets.size() - 1);
+	for (unsigned int i = 0; i + 1 < cellOffsets.size(); ++i) { // each partition/cell
+		PointCloud3D* tmpPointCloud = new PointCloud3D();
+		tmpPointCloud->setArena(pointCloud->getArena()); // cells share the arena of the input (if any)
+		tmpPointCloud->reserve(cellOffsets[i + 1] - cellOffsets[i]);
+		for (int j = cellOffsets[i]; j < cellOffsets[i + 1]; ++j) {
+			const Point3D& tmpPoint = (*points)[pointIndices[j]];
+			tmpPointCloud->addPoint(Point3D(tmpPoint.getX(), tmpPoint.getY(), tmpPoint.getZ()));
+		}
+		pointCloudCells->push_back(tmpPointCloud);
+	}
+}
+
+void PersistentOctree::partitionPointCloud(PointCloud3D* pointCloud, std::vector<int>* pointIndices, std::vector<int>* cellOffsets) {
+	assert(pointCloud != 0);
+	assert(pointIndices != 0);
+	assert(cellOffsets != 0);
+
+	unsigned int numberOfPoints = pointCloud->getSize();
+	unsigned int frame = currentFrame++;
+
+	/* insert and remember the leaf of every point; leaves are numbered in the order they are first hit */
+	std::vector<int> leafOfPoint(numberOfPoints, -1);
+	std::vector<int> cellOfLeaf; // indexed by node; -1 for leaves that are not touched by this point cloud
+	std::vector<int> cellSizes;
+	for (unsigned int i = 0; i < numberOfPoints; ++i) {
+		const Point3D& point = (*pointCloud->getPointCloud())[i];
+		int leaf = insertPoint(point.getX(), point.getY(), point.getZ(), frame);
+		if (leaf < 0) {
+			continue; // invalid point
+		}
+		if (static_cast<int>(cellOfLeaf.size()) <= leaf) {
+			cellOfLeaf.resize(nodes.size(), -1);
+		}
+		if (cellOfLeaf[leaf] < 0) {
+			cellOfLeaf[leaf] = static_cast<int>(cellSizes.size());
+			cellSizes.push_back(0);
+		}
+		leafOfPoint[i] = cellOfLeaf[leaf];
+		cellSizes[cellOfLeaf[leaf]]++;
+	}
+
+	/* counting sort of the point indices by cells */
+	cellOffsets->assign(cellSizes.size() + 1, 0);
+	for (unsigned int i = 0; i < cellSizes.size(); ++i) {
+		(*cellOffsets)[i + 1] = (*cellOffsets)[i] + cellSizes[i];
+	}
+	pointIndices->resize(cellOffsets->back());
+	std::vector<int> insertPosition(cellOffsets->begin(), cellOffsets->end() - 1);
+	for (unsigned int i = 0; i < numberOfPoints; ++i) {
+		if (leafOfPoint[i] >= 0) {
+			(*pointIndices)[insertPosition[leafOfPoint[i]]++] = i;
+		}
+	}
+}
+
+void PersistentOctree::setVoxelSize(double voxelSize) {
+	if (voxelSize <= 0.0) {
+		throw runtime_error("ERROR: voxelSize for PersistentOctree must be greater than 0.");
+	}
+	if (voxelSize == this->voxelSize) {
+		return;
+	}
+
+	/* sort existing points into a tree with the new cell size */
+	std::vector<LeafPoint> allPoints;
+	allPoints.reserve(getSize());
+	for (unsigned int i = 0; i < nodes.size(); ++i) {
+		if (nodes[i].level == 0) {
+			allPoints.insert(allPoints.end(), nodes[i].points.begin(), nodes[i].points.end());
+		}
+	}
+	clear();
+	this->voxelSize = voxelSize;
+	for (unsigned int i = 0; i < allPoints.size(); ++i) {
+		insertPoint(allPoints[i].x, allPoints[i].y, allPoints[i].z, allPoints[i].frame);
+	}
+}
+
+double PersistentOctree::getVoxelSize() {
+	return this->voxelSize;
+}
+
+unsigned int PersistentOctree::insert(PointCloud3D* pointCloud) {
+	assert(pointCloud != 0);
+	unsigned int frame = currentFrame++;
+	for (unsigned int i = 0; i < pointCloud->getSize(); ++i) {
+		const Point3D& point = (*pointCloud->getPointCloud())[i];
+		insertPoint(point.getX(), point.getY(), point.getZ(), frame);
+	}
+	return frame;
+}
+
+void PersistentOctree::removeFramesOlderThan(unsigned int frame) {
+	if (root < 0) {
+		return;
+	}
+	if (pruneSubtree(root, frame) == 0) {
+		clear();
+		return;
+	}
+
+	/* shrink the tree from the top while the root has a single child */
+	while (nodes[root].level > 0) {
+		int onlyChild = -1;
+		int numberOfChildren = 0;
+		for (int i = 0; i < 8; ++i) {
+			if (nodes[root].children[i] >= 0) {
+				onlyChild = nodes[root].children[i];
+				numberOfChildren++;
+			}
+		}
+		if (numberOfChildren != 1) {
+			break;
+		}
+		releaseNode(root);
+		root = onlyChild;
+		nodes[root].parent = -1;
+	}
+}
+
+void PersistentOctree::clear() {
+	nodes.clear();
+	freeNodes.clear();
+	root = -1;
+}
+
+void PersistentOctree::getPointsInBox(const Point3D& minCorner, const Point3D& maxCorner, PointCloud3D* resultPointCloud) {
+	assert(resultPointCloud != 0);
+	if (root < 0) {
+		return;
+	}
+	double boxMin[3] = {minCorner.getX(), minCorner.getY(), minCorner.getZ()};
+	double boxMax[3] = {maxCorner.getX(), maxCorner.getY(), maxCorner.getZ()};
+	collectInBox(root, boxMin, boxMax, resultPointCloud);
+}
+
+void PersistentOctree::getPointsInRadius(const Point3D& center, double radius, PointCloud3D* resultPointCloud) {
+	assert(resultPointCloud != 0);
+	if (root < 0 || radius < 0.0) {
+		return;
+	}
+	double query[3] = {center.getX(), center.getY(), center.getZ()};
+	collectInRadius(root, query, radius, resultPointCloud);
+}
+
+void PersistentOctree::getReducedPointCloud(PointCloud3D* resultPointCloud) {
+	assert(resultPointCloud != 0);
+	if (root < 0) {
+		return;
+	}
+	resultPointCloud->reserve(resultPointCloud->getSize() + getNumberOfLeaves());
+	collectLeafCentroids(root, resultPointCloud);
+}
+
+unsigned int PersistentOctree::getOccupancy(const Point3D& position, unsigned int level) {
+	long long leafIndex[3];
+	computeLeafIndex(position.getX(), position.getY(), position.getZ(), leafIndex);
+	int node = findNode(leafIndex, static_cast<int>(level));
+	return (node < 0) ? 0 : nodes[node].count;
+}
+
+unsigned int PersistentOctree::getSize() {
+	return (root < 0) ? 0 : nodes[root].count;
+}
+
+unsigned int PersistentOctree::getDepth() {
+	return (root < 0) ? 0 : static_cast<unsigned int>(nodes[root].level);
+}
+
+unsigned int PersistentOctree::getNumberOfNodes() {
+	return static_cast<unsigned int>(nodes.size() - freeNodes.size());
+}
+
+unsigned int PersistentOctree::getNumberOfLeaves() {
+	unsigned int numberOfLeaves = 0;
+	for (unsigned int i = 0; i < nodes.size(); ++i) {
+		if (nodes[i].level == 0 && nodes[i].count > 0) {
+			numberOfLeaves++;
+		}
+	}
+	return numberOfLeaves;
+}
+
+unsigned int PersistentOctree::getCurrentFrame() {
+	return currentFrame;
+}
+
+long long PersistentOctree::coarserIndex(long long index, int levels) {
+	return index >> levels;
+}
+
+void PersistentOctree::computeLeafIndex(Coordinate x, Coordinate y, Coordinate z, long long* leafIndex) {
+	leafIndex[0] = static_cast<long long>(std::floor(x / voxelSize)) + leafIndexOffset;
+	leafIndex[1] = static_cast<long long>(std::floor(y / voxelSize)) + leafIndexOffset;
+	leafIndex[2] = static_cast<long long>(std::floor(z / voxelSize)) + leafIndexOffset;
+}
+
+bool PersistentOctree::contains(int node, const long long* leafIndex) {
+	const Node& tmpNode = nodes[node];
+	for (int i = 0; i < 3; ++i) {
+		if (coarserIndex(leafIndex[i], tmpNode.level) != tmpNode.index[i]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+int PersistentOctree::findOrCreateLeaf(const long long* leafIndex) {
+	if (root < 0) {
+		root = createNode(0, leafIndex[0], leafIndex[1], leafIndex[2], -1);
+		return root;
+	}
+
+	/* grow upwards until the root covers the cell */
+	while (!contains(root, leafIndex)) {
+		const Node& oldRoot = nodes[root];
+		int level = oldRoot.level + 1;
+		long long parentIndex[3];
+		int octant = 0;
+		for (int i = 0; i < 3; ++i) {
+			parentIndex[i] = coarserIndex(oldRoot.index[i], 1);
+			octant |= static_cast<int>(oldRoot.index[i] - 2 * parentIndex[i]) << i;
+		}
+		unsigned int count = oldRoot.count;
+		int newRoot = createNode(level, parentIndex[0], parentIndex[1], parentIndex[2], -1);
+		nodes[newRoot].children[octant] = root;
+		nodes[newRoot].count = count;
+		nodes[root].parent = newRoot;
+		root = newRoot;
+	}
+
+	/* descend and create missing nodes */
+	int node = root;
+	while (nodes[node].level > 0) {
+		int childLevel = nodes[node].level - 1;
+		long long childIndex[3];
+		int octant = 0;
+		for (int i = 0; i < 3; ++i) {
+			childIndex[i] = coarserIndex(leafIndex[i], childLevel);
+			octant |= static_cast<int>(childIndex[i] - 2 * nodes[node].index[i]) << i;
+		}
+		int child = nodes[node].children[octant];
+		if (child < 0) {
+			child = createNode(childLevel, childIndex[0], childIndex[1], childIndex[2], node);
+			nodes[node].children[octant] = child;
+		}
+		node = child;
+	}
+	return node;
+}
+
+int PersistentOctree::findNode(const long long* leafIndex, int level) {
+	if (root < 0 || level > nodes[root].level || !contains(root, leafIndex)) {
+		return -1;
+	}
+	int node = root;
+	while (nodes[node].level > level) {
+		int childLevel = nodes[node].level - 1;
+		int octant = 0;
+		for (int i = 0; i < 3; ++i) {
+			octant |= static_cast<int>(coarserIndex(leafIndex[i], childLevel) - 2 * nodes[node].index[i]) << i;
+		}
+		node = nodes[node].children[octant];
+		if (node < 0) {
+			return -1;
+		}
+	}
+	return node;
+}
+
+int PersistentOctree::createNode(int level, long long ix, long long iy, long long iz, int parent) {
+	int node;
+	if (!freeNodes.empty()) {
+		node = freeNodes.back();
+		freeNodes.pop_back();
+	} else {
+		node = static_cast<int>(nodes.size());
+		nodes.push_back(Node());
+	}
+	Node& tmpNode = nodes[node];
+	tmpNode.level = level;
+	tmpNode.index[0] = ix;
+	tmpNode.index[1] = iy;
+	tmpNode.index[2] = iz;
+	for (int i = 0; i < 8; ++i) {
+		tmpNode.children[i] = -1;
+	}
+	tmpNode.parent = parent;
+	tmpNode.count = 0;
+	tmpNode.points.clear();
+	return node;
+}
+
+void PersistentOctree::releaseNode(int node) {
+	nodes[node].level = -1; // marks unused nodes
+	nodes[node].count = 0;
+	std::vector<LeafPoint>().swap(nodes[node].points);
+	freeNodes.push_back(node);
+}
+
+int PersistentOctree::insertPoint(Coordinate x, Coordinate y, Coordinate z, unsigned int frame) {
+	if (!((x - x) + (y - y) + (z - z) == 0)) { // NaN or inf in any of the coordinates
+		return -1;
+	}
+	if (std::fabs(x) / voxelSize > maxLeafIndex || std::fabs(y) / voxelSize > maxLeafIndex || std::fabs(z) / voxelSize > maxLeafIndex) {
+		return -1;
+	}
+
+	long long leafIndex[3];
+	computeLeafIndex(x, y, z, leafIndex);
+	int leaf = findOrCreateLeaf(leafIndex);
+
+	LeafPoint point;
+	point.x = x;
+	point.y = y;
+	point.z = z;
+	point.frame = frame;
+	nodes[leaf].points.push_back(point);
+	for (int node = leaf; node >= 0; node = nodes[node].parent) {
+		nodes[node].count++;
+	}
+	return leaf;
+}
+
+void PersistentOctree::getNodeBounds(int node, double* minCorner, double& size) {
+	size = std::ldexp(voxelSize, nodes[node].level);
+	for (int i = 0; i < 3; ++i) {
+		minCorner[i] = static_cast<double>((nodes[node].index[i] << nodes[node].level) - leafIndexOffset) * voxelSize;
+	}
+}
+
+unsigned int PersistentOctree::pruneSubtree(int node, unsigned int oldestFrame) {
+	Node& tmpNode = nodes[node];
+	if (tmpNode.level == 0) {
+		std::vector<LeafPoint>& points = tmpNode.points;
+		unsigned int kept = 0;
+		for (unsigned int i = 0; i < points.size(); ++i) {
+			if (points[i].frame >= oldestFrame) {
+				points[kept++] = points[i];
+			}
+		}
+		points.resize(kept);
+		tmpNode.count = kept;
+		return kept;
+	}
+
+	unsigned int count = 0;
+	for (int i = 0; i < 8; ++i) {
+		int child = nodes[node].children[i];
+		if (child < 0) {
+			continue;
+		}
+		unsigned int childCount = pruneSubtree(child, oldestFrame);
+		if (childCount == 0) {
+			releaseNode(child);
+			nodes[node].children[i] = -1;
+		}
+		count += childCount;
+	}
+	nodes[node].count = count;
+	return count;
+}
+
+void PersistentOctree::collectInBox(int node, const double* minCorner, const double* maxCorner, PointCloud3D* resultPointCloud) {
+	double nodeMin[3];
+	double size;
+	getNodeBounds(node, nodeMin, size);
+	bool inside = true;
+	for (int i = 0; i < 3; ++i) {
+		if (nodeMin[i] > maxCorner[i] || nodeMin[i] + size < minCorner[i]) {
+			return; // no overlap
+		}
+		inside = inside && (nodeMin[i] >= minCorner[i]) && (nodeMin[i] + size <= maxCorner[i]);
+	}
+
+	const Node& tmpNode = nodes[node];
+	if (tmpNode.level == 0) {
+		for (unsigned int i = 0; i < tmpNode.points.size(); ++i) {
+			const LeafPoint& point = tmpNode.points[i];
+			if (inside || (point.x >= minCorner[0] && point.x <= maxCorner[0] &&
+					point.y >= minCorner[1] && point.y <= maxCorner[1] &&
+					point.z >= minCorner[2] && point.z <= maxCorner[2])) {
+				resultPointCloud->addPoint(Point3D(point.x, point.y, point.z));
+			}
+		}
+		return;
+	}
+	for (int i = 0; i < 8; ++i) {
+		if (tmpNode.children[i] >= 0) {
+			collectInBox(tmpNode.children[i], minCorner, maxCorner, resultPointCloud);
+		}
+	}
+}
+
+void PersistentOctree::collectInRadius(int node, const double* center, double radius, PointCloud3D* resultPointCloud) {
+	double nodeMin[3];
+	double size;
+	getNodeBounds(node, nodeMin, size);
+
+	/* squared distance between the query point and the cell */
+	double squaredDistance = 0.0;
+	for (int i = 0; i < 3; ++i) {
+		double delta = 0.0;
+		if (center[i] < nodeMin[i]) {
+			delta = nodeMin[i] - center[i];
+		} else if (center[i] > nodeMin[i] + size) {
+			delta = center[i] - (nodeMin[i] + size);
+		}
+		squaredDistance += delta * delta;
+	}
+	double squaredRadius = radius * radius;
+	if (squaredDistance > squaredRadius) {
+		return;
+	}
+
+	const Node& tmpNode = nodes[node];
+	if (tmpNode.level == 0) {
+		for (unsigned int i = 0; i < tmpNode.points.size(); ++i) {
+			const LeafPoint& point = tmpNode.points[i];
+			double dx = point.x - center[0];
+			double dy = point.y - center[1];
+			double dz = point.z - center[2];
+			if (dx * dx + dy * dy + dz * dz <= squaredRadius) {
+				resultPointCloud->addPoint(Point3D(point.x, point.y, point.z));
+			}
+		}
+		return;
+	}
+	for (int i = 0; i < 8; ++i) {
+		if (tmpNode.children[i] >= 0) {
+			collectInRadius(tmpNode.children[i], center, radius, resultPointCloud);
+		}
+	}
+}
+
+void PersistentOctree::collectLeafCentroids(int node, PointCloud3D* resultPointCloud) {
+	const Node& tmpNode = nodes[node];
+	if (tmpNode.level == 0) {
+		Point3D centroid;
+		computeLeafCentroid(node, centroid);
+		resultPointCloud->addPoint(centroid);
+		return;
+	}
+	for (int i = 0; i < 8; ++i) {
+		if (tmpNode.children[i] >= 0) {
+			collectLeafCentroids(tmpNode.children[i], resultPointCloud);
+		}
+	}
+}
+
+void PersistentOctree::computeLeafCentroid(int leaf, Point3D& centroid) {
+	assert(leaf >= 0);
+	const std::vector<LeafPoint>& points = nodes[leaf].points;
+	assert(!points.empty());
+	double sumX = 0.0;
+	double sumY = 0.0;
+	double sumZ = 0.0;
+	for (unsigned int i = 0; i < points.size(); ++i) {
+		sumX += points[i].x;
+		sumY += points[i].y;
+		sumZ += points[i].z;
+	}
+	centroid.setX(sumX / points.size());
+	centroid.setY(sumY / points.size());
+	centroid.setZ(sumZ / points.size());
+}
+
+}
+
+/* EOF */
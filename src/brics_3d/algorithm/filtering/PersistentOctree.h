@@ -0,0 +1,228 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+#ifndef BRICS_3D_PERSISTENTOCTREE_H_
+#define BRICS_3D_PERSISTENTOCTREE_H_
+
+#include "brics_3d/algorithm/filtering/IOctreeReductionFilter.h"
+#include "brics_3d/algorithm/filtering/IOctreePartition.h"
+#include "brics_3d/algorithm/filtering/IOctreeSetup.h"
+
+namespace brics_3d {
+
+/**
+ * @brief Octree that is kept alive as a spatial index and can be updated incrementally.
+ *
+ * In contrast to brics_3d::Octree the tree is not rebuilt for every call. Point clouds are
+ * inserted frame by frame with insert(). Every inserted point gets the frame number, so
+ * stale data can be removed later with removeFramesOlderThan().
+ *
+ * The leaf cells are the cells of a regular grid with edge length voxelSize that is aligned
+ * at the origin. An inner node at level l covers 2^l x 2^l x 2^l leaf cells. When points are
+ * inserted outside the current bounds, the tree grows upwards, so it never needs to be rebuilt.
+ * Every node keeps the number of points in its subtree, see getOccupancy().
+ *
+ * Inner nodes are not aligned at the origin: the leaf indices are shifted by a constant with
+ * alternating bits (0101...). Otherwise cells on both sides of the origin would only share the
+ * node at the highest possible level. With the shift the depth of the tree only depends on the
+ * extent of the data. Points farther than about 10^17 voxels from the origin are skipped.
+ *
+ * The IOctreeReductionFilter and IOctreePartition interfaces insert the given point cloud as a
+ * new frame. Their results refer to the given point cloud, but take the content of the index into account:
+ *  - filter() returns one point per leaf touched by the point cloud: the centroid of all points in that leaf,
+ *    including those of earlier frames.
+ *  - partitionPointCloud() groups the points of the given point cloud by leaves.
+ *
+ * @ingroup filtering
+ */
+class PersistentOctree : public IOctreeReductionFilter, public IOctreePartition, public IOctreeSetup {
+public:
+
+	/**
+	 * @brief Standard constructor.
+	 */
+	PersistentOctree();
+
+	/**
+	 * @brief Constructor with a voxel size.
+	 */
+	PersistentOctree(double voxelSize);
+
+	/**
+	 * @brief Standard destructor.
+	 */
+	virtual ~PersistentOctree();
+
+	void filter(PointCloud3D* originalPointCloud, PointCloud3D* resultPointCloud);
+
+	void partitionPointCloud(PointCloud3D* pointCloud, std::vector<PointCloud3D*>* pointCloudCells);
+
+	void partitionPointCloud(PointCloud3D* pointCloud, std::vector<int>* pointIndices, std::vector<int>* cellOffsets);
+
+	/**
+	 * @brief Set the edge length of the leaf cells.
+	 *
+	 * If the index is not empty, all points are sorted into a new tree with the new voxel size.
+	 * A voxel size of 0 is not allowed for the persistent octree.
+	 */
+	void setVoxelSize(double voxelSize);
+
+	double getVoxelSize();
+
+	/**
+	 * @brief Add the points of a point cloud as a new frame.
+	 * Points with NaN or infinite coordinates are ignored.
+	 * @return The frame number assigned to the points.
+	 */
+	unsigned int insert(PointCloud3D* pointCloud);
+
+	/**
+	 * @brief Remove all points that were inserted before the given frame. Empty nodes are pruned.
+	 * @param frame The oldest frame to keep.
+	 */
+	void removeFramesOlderThan(unsigned int frame);
+
+	/**
+	 * @brief Remove all points and nodes. The frame counter is not reset.
+	 */
+	void clear();
+
+	/**
+	 * @brief Append all points inside an axis aligned box to a point cloud.
+	 */
+	void getPointsInBox(const Point3D& minCorner, const Point3D& maxCorner, PointCloud3D* resultPointCloud);
+
+	/**
+	 * @brief Append all points within a given distance of a query point to a point cloud.
+	 */
+	void getPointsInRadius(const Point3D& center, double radius, PointCloud3D* resultPointCloud);
+
+	/**
+	 * @brief Append the centroid of each leaf cell to a point cloud. This is the reduced version of the complete index.
+	 */
+	void getReducedPointCloud(PointCloud3D* resultPointCloud);
+
+	/**
+	 * @brief Number of points in the node at a given level that contains a position.
+	 * @param position Query position.
+	 * @param level 0 for leaf cells. Each level above doubles the edge length.
+	 * @return 0 if there is no such node.
+	 */
+	unsigned int getOccupancy(const Point3D& position, unsigned int level = 0);
+
+	/// Number of points in the index.
+	unsigned int getSize();
+
+	/// Number of levels below the root. 0 if there is only a single leaf.
+	unsigned int getDepth();
+
+	/// Number of allocated nodes (inner nodes and leaves).
+	unsigned int getNumberOfNodes();
+
+	/// Number of occupied leaf cells.
+	unsigned int getNumberOfLeaves();
+
+	/// Frame number that will be assigned with the next insert().
+	unsigned int getCurrentFrame();
+
+private:
+
+	/// A point stored in a leaf.
+	struct LeafPoint {
+		Coordinate x;
+		Coordinate y;
+		Coordinate z;
+		unsigned int frame;
+	};
+
+	/// Node of the tree. Nodes are referenced by their index in nodes.
+	struct Node {
+		/// Level of the node. 0 for leaves.
+		int level;
+
+		/// Grid index of the node at its level (shifted, thus never negative).
+		long long index[3];
+
+		/// Child nodes in octant order (x is bit 0, y bit 1, z bit 2); -1 for none.
+		int children[8];
+
+		int parent;
+
+		/// Number of points in the subtree.
+		unsigned int count;
+
+		/// Only used for leaves.
+		std::vector<LeafPoint> points;
+	};
+
+	/// Grid index at a coarser level.
+	static long long coarserIndex(long long index, int levels);
+
+	/// Shifted leaf grid index of a position.
+	void computeLeafIndex(Coordinate x, Coordinate y, Coordinate z, long long* leafIndex);
+
+	/// Check if a leaf cell is covered by a node.
+	bool contains(int node, const long long* leafIndex);
+
+	/// Find the leaf for a position or create it. The tree grows if necessary.
+	int findOrCreateLeaf(const long long* leafIndex);
+
+	/// Find the node at a level that covers a leaf cell. -1 if it does not exist.
+	int findNode(const long long* leafIndex, int level);
+
+	int createNode(int level, long long ix, long long iy, long long iz, int parent);
+
+	void releaseNode(int node);
+
+	/// Add a point to the tree and return the leaf.
+	int insertPoint(Coordinate x, Coordinate y, Coordinate z, unsigned int frame);
+
+	/// Lower corner and edge length of a node.
+	void getNodeBounds(int node, double* minCorner, double& size);
+
+	/// Recompute counts after removal and prune empty children. Returns the new count.
+	unsigned int pruneSubtree(int node, unsigned int oldestFrame);
+
+	void collectInBox(int node, const double* minCorner, const double* maxCorner, PointCloud3D* resultPointCloud);
+
+	void collectInRadius(int node, const double* center, double radius, PointCloud3D* resultPointCloud);
+
+	void collectLeafCentroids(int node, PointCloud3D* resultPointCloud);
+
+	void computeLeafCentroid(int leaf, Point3D& centroid);
+
+	/// Leaf edge length.
+	double voxelSize;
+
+	/// All nodes; released nodes are reused via freeNodes.
+	std::vector<Node> nodes;
+
+	std::vector<int> freeNodes;
+
+	/// Index of the root node; -1 if the tree is empty.
+	int root;
+
+	unsigned int currentFrame;
+};
+
+}
+
+#endif /* BRICS_3D_PERSISTENTOCTREE_H_ */
+
+/* EOF */
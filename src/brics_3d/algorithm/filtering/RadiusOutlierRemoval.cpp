@@ -0,0 +1,89 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+#include "RadiusOutlierRemoval.h"
+
+#include <cassert>
+#include <stdexcept>
+
+using std::runtime_error;
+
+namespace brics_3d {
+
+RadiusOutlierRemoval::RadiusOutlierRemoval() {
+	this->radius = 0.1;
+	this->minNumberOfNeighbors = 2;
+}
+
+RadiusOutlierRemoval::RadiusOutlierRemoval(double radius, unsigned int minNumberOfNeighbors) {
+	this->radius = 0.1;
+	this->minNumberOfNeighbors = minNumberOfNeighbors;
+	setRadius(radius);
+}
+
+RadiusOutlierRemoval::~RadiusOutlierRemoval() {
+
+}
+
+void RadiusOutlierRemoval::filter(PointCloud3D* originalPointCloud, PointCloud3D* resultPointCloud) {
+	assert(originalPointCloud != 0);
+	assert(resultPointCloud != 0);
+	assert(originalPointCloud != resultPointCloud);
+
+	unsigned int count = originalPointCloud->getSize();
+	if (minNumberOfNeighbors == 0) { // every point passes
+		copySelectedPoints(originalPointCloud, std::vector<unsigned char>(count, 1), resultPointCloud);
+		return;
+	}
+	if (count <= minNumberOfNeighbors) { // not enough points for any point to pass
+		return;
+	}
+
+	std::vector<double> neighborDistances;
+	computeNeighborDistances(originalPointCloud, minNumberOfNeighbors, maxDistance, &neighborDistances);
+
+	std::vector<unsigned char> isInlier(count);
+	for (unsigned int i = 0; i < count; ++i) {
+		isInlier[i] = (neighborDistances[i] <= radius);
+	}
+	copySelectedPoints(originalPointCloud, isInlier, resultPointCloud);
+}
+
+double RadiusOutlierRemoval::getRadius() const {
+	return radius;
+}
+
+void RadiusOutlierRemoval::setRadius(double radius) {
+	if (radius <= 0.0) {
+		throw runtime_error("ERROR: radius for RadiusOutlierRemoval must be greater than 0.");
+	}
+	this->radius = radius;
+}
+
+unsigned int RadiusOutlierRemoval::getMinNumberOfNeighbors() const {
+	return minNumberOfNeighbors;
+}
+
+void RadiusOutlierRemoval::setMinNumberOfNeighbors(unsigned int minNumberOfNeighbors) {
+	this->minNumberOfNeighbors = minNumberOfNeighbors;
+}
+
+}
+
+/* EOF */
@@ -0,0 +1,79 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+#ifndef BRICS_3D_RADIUSOUTLIERREMOVAL_H_
+#define BRICS_3D_RADIUSOUTLIERREMOVAL_H_
+
+#include "NeighborDistanceFilter.h"
+
+namespace brics_3d {
+
+/**
+ * @brief Removes points that have less than a minimum number of neighbors within a radius.
+ *
+ * A point has at least n neighbors within the radius if its n-th nearest neighbor is within the
+ * radius, thus a k nearest neighbor search with k = n is sufficient.
+ * @ingroup filtering
+ */
+class RadiusOutlierRemoval : public NeighborDistanceFilter {
+public:
+
+	/**
+	 * @brief Standard constructor. Radius 0.1 and 2 neighbors.
+	 */
+	RadiusOutlierRemoval();
+
+	/**
+	 * @brief Constructor with parameters.
+	 * @param radius Search radius.
+	 * @param minNumberOfNeighbors Minimum number of neighbors (without the point itself) within the radius.
+	 */
+	RadiusOutlierRemoval(double radius, unsigned int minNumberOfNeighbors);
+
+	virtual ~RadiusOutlierRemoval();
+
+	/**
+	 * @brief Remove the outliers.
+	 * @param[in] originalPointCloud The input point cloud. This data will not be modified.
+	 * @param[out] resultPointCloud The inliers are appended; decorations of the points are kept.
+	 */
+	void filter(PointCloud3D* originalPointCloud, PointCloud3D* resultPointCloud);
+
+	double getRadius() const;
+
+	void setRadius(double radius);
+
+	unsigned int getMinNumberOfNeighbors() const;
+
+	void setMinNumberOfNeighbors(unsigned int minNumberOfNeighbors);
+
+private:
+
+	/// Search radius.
+	double radius;
+
+	/// Minimum number of neighbors within the radius.
+	unsigned int minNumberOfNeighbors;
+};
+
+}
+
+#endif /* BRICS_3D_RADIUSOUTLIERREMOVAL_H_ */
+
+/* EOF */
@@ -0,0 +1,156 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+
+#include "RandomSubsampling.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace brics_3d {
+
+/// Upper limit for a skip. Larger values (e.g. caused by an infinite logarithm) are clamped.
+static const double maxSkip = 1e18;
+
+RandomSubsampling::RandomSubsampling(unsigned int maxNumberOfPoints, boost::uint64_t seed) {
+	this->maxNumberOfPoints = maxNumberOfPoints;
+	this->seed = seed;
+	this->reservoirArena = new Point3DArena();
+	reset();
+}
+
+RandomSubsampling::~RandomSubsampling() {
+	clearReservoir();
+	delete reservoirArena;
+}
+
+void RandomSubsampling::reset() {
+	SubsamplingFilter::reset();
+	clearReservoir();
+	reservoirArena->reset();
+	reservoir.reserve(maxNumberOfPoints);
+	activeMaxNumberOfPoints = maxNumberOfPoints;
+	randomNumberGenerator.setSeed(seed);
+	numberOfReplacements = 0;
+	weight = 0.0;
+	nextReplacement = 0;
+}
+
+void RandomSubsampling::addChunk(PointCloud3D* chunk, PointCloud3D* resultPointCloud) {
+	assert(chunk != 0);
+	assert(resultPointCloud != 0);
+	assert(chunk != resultPointCloud);
+
+	boost::ptr_vector<Point3D>& points = *chunk->getPointCloud();
+	boost::uint64_t begin = numberOfProcessedPoints;
+	boost::uint64_t end = begin + chunk->getSize();
+	numberOfProcessedPoints = end;
+	if (activeMaxNumberOfPoints == 0) {
+		return;
+	}
+
+	/* the first points fill the reservoir */
+	for (boost::uint64_t index = begin; index < end && reservoir.size() < activeMaxNumberOfPoints; ++index) {
+		SamplePoint samplePoint;
+		samplePoint.index = index;
+		samplePoint.point = points[static_cast<std::size_t>(index - begin)].cloneInto(reservoirArena);
+		reservoir.push_back(samplePoint);
+		if (reservoir.size() == activeMaxNumberOfPoints) {
+			weight = std::exp(std::log(nextUniform()) / activeMaxNumberOfPoints);
+			nextReplacement = index + nextSkip() + 1;
+		}
+	}
+	if (reservoir.size() < activeMaxNumberOfPoints) {
+		return;
+	}
+
+	/* afterwards only the points that replace a random entry are touched; replaced points stay in the arena until it is compacted */
+	while (nextReplacement < end) {
+		SamplePoint& samplePoint = reservoir[randomNumberGenerator.nextUInt(activeMaxNumberOfPoints)];
+		samplePoint.index = nextReplacement;
+		samplePoint.point = points[static_cast<std::size_t>(nextReplacement - begin)].cloneInto(reservoirArena);
+		numberOfReplacements++;
+
+		weight *= std::exp(std::log(nextUniform()) / activeMaxNumberOfPoints);
+		nextReplacement += nextSkip() + 1;
+	}
+
+	if (numberOfReplacements > activeMaxNumberOfPoints) { // at most twice the memory of the sample
+		compactReservoir();
+	}
+}
+
+void RandomSubsampling::finish(PointCloud3D* resultPointCloud) {
+	assert(resultPointCloud != 0);
+
+	std::vector<SamplePoint> sample(reservoir);
+	std::sort(sample.begin(), sample.end()); // order of the stream
+
+	resultPointCloud->reserve(resultPointCloud->getSize() + static_cast<unsigned int>(sample.size()));
+	for (unsigned int i = 0; i < sample.size(); ++i) {
+		resultPointCloud->addPointClone(*sample[i].point);
+	}
+}
+
+unsigned int RandomSubsampling::getMaxNumberOfPoints() const {
+	return maxNumberOfPoints;
+}
+
+void RandomSubsampling::setMaxNumberOfPoints(unsigned int maxNumberOfPoints) {
+	this->maxNumberOfPoints = maxNumberOfPoints;
+}
+
+boost::uint64_t RandomSubsampling::getSeed() const {
+	return seed;
+}
+
+void RandomSubsampling::setSeed(boost::uint64_t seed) {
+	this->seed = seed;
+}
+
+double RandomSubsampling::nextUniform() {
+	return 1.0 - randomNumberGenerator.nextDouble();
+}
+
+boost::uint64_t RandomSubsampling::nextSkip() {
+	double skip = std::floor(std::log(nextUniform()) / std::log(1.0 - weight));
+	if (!(skip < maxSkip)) { // also catches NaN
+		skip = maxSkip;
+	}
+	return static_cast<boost::uint64_t>(skip);
+}
+
+void RandomSubsampling::clearReservoir() {
+	reservoir.clear(); // the points are released together with the arena
+}
+
+void RandomSubsampling::compactReservoir() {
+	Point3DArena* compactArena = new Point3DArena();
+	for (unsigned int i = 0; i < reservoir.size(); ++i) {
+		reservoir[i].point = reservoir[i].point->cloneInto(compactArena);
+	}
+	delete reservoirArena;
+	reservoirArena = compactArena;
+	numberOfReplacements = 0;
+}
+
+}
+
+/* EOF */
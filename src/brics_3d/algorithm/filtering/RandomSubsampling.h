@@ -0,0 +1,136 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+
+#ifndef BRICS_3D_RANDOMSUBSAMPLING_H_
+#define BRICS_3D_RANDOMSUBSAMPLING_H_
+
+#include "SubsamplingFilter.h"
+#include "brics_3d/core/RandomNumberGenerator.h"
+#include "brics_3d/core/Point3DArena.h"
+
+#include <vector>
+
+namespace brics_3d {
+
+/**
+ * @brief Uniform random subsampling to a maximum number of points with a reservoir.
+ *
+ * Every point of a point cloud or stream has the same probability to be part of the result.
+ * If the stream has less points than the maximum, all points are kept. The sample is only known
+ * at the end of the stream: addChunk() never appends points, finish() appends the sample in
+ * the order of the stream.
+ *
+ * Memory is bounded by the maximum number of points, independent of the length of the stream.
+ * The reservoir is maintained with Li's "Algorithm L": random numbers are only drawn when a point
+ * enters the sample, all other points are skipped without any work. The random sequence is
+ * defined by the seed, thus the result is reproducible and does not depend on the chunk sizes.
+ * @ingroup filtering
+ */
+class RandomSubsampling : public SubsamplingFilter {
+public:
+
+	/**
+	 * @brief Constructor.
+	 * @param maxNumberOfPoints Size of the sample.
+	 * @param seed Seed for the random number generator.
+	 */
+	RandomSubsampling(unsigned int maxNumberOfPoints = 10000, boost::uint64_t seed = 0);
+
+	virtual ~RandomSubsampling();
+
+	void reset();
+
+	void addChunk(PointCloud3D* chunk, PointCloud3D* resultPointCloud);
+
+	void finish(PointCloud3D* resultPointCloud);
+
+	unsigned int getMaxNumberOfPoints() const;
+
+	/**
+	 * @brief Set the size of the sample. Takes effect with the next reset().
+	 */
+	void setMaxNumberOfPoints(unsigned int maxNumberOfPoints);
+
+	boost::uint64_t getSeed() const;
+
+	/**
+	 * @brief Set the seed for the random number generator. Takes effect with the next reset().
+	 */
+	void setSeed(boost::uint64_t seed);
+
+private:
+
+	RandomSubsampling(const RandomSubsampling&);
+	RandomSubsampling& operator=(const RandomSubsampling&);
+
+	/// A point of the reservoir along with its position in the stream.
+	struct SamplePoint {
+		boost::uint64_t index;
+		Point3D* point;
+
+		bool operator<(const SamplePoint& other) const {
+			return index < other.index;
+		}
+	};
+
+	/// Random number in (0, 1].
+	double nextUniform();
+
+	/// Draw the number of points to be skipped until the next replacement.
+	boost::uint64_t nextSkip();
+
+	/// Remove all points from the reservoir. Their memory belongs to the arena.
+	void clearReservoir();
+
+	/// Move the reservoir into a fresh arena, so replaced points do not accumulate.
+	void compactReservoir();
+
+	/// Size of the sample.
+	unsigned int maxNumberOfPoints;
+
+	/// Size of the sample of the current stream.
+	unsigned int activeMaxNumberOfPoints;
+
+	/// Seed for the random number generator.
+	boost::uint64_t seed;
+
+	RandomNumberGenerator randomNumberGenerator;
+
+	/// The current sample.
+	std::vector<SamplePoint> reservoir;
+
+	/// Memory for the copies of the sampled points.
+	Point3DArena* reservoirArena;
+
+	/// Number of replacements since the last compaction.
+	unsigned int numberOfReplacements;
+
+	/// Variable w of Algorithm L.
+	double weight;
+
+	/// Position in the stream of the next point that enters the sample.
+	boost::uint64_t nextReplacement;
+};
+
+}
+
+#endif /* BRICS_3D_RANDOMSUBSAMPLING_H_ */
+
+/* EOF */
@@ -0,0 +1,102 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+#include "StatisticalOutlierRemoval.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+
+using std::runtime_error;
+
+namespace brics_3d {
+
+StatisticalOutlierRemoval::StatisticalOutlierRemoval() {
+	this->k = 8;
+	this->standardDeviationMultiplier = 1.0;
+	this->distanceThreshold = 0.0;
+}
+
+StatisticalOutlierRemoval::StatisticalOutlierRemoval(unsigned int k, double standardDeviationMultiplier) {
+	this->k = 8;
+	this->standardDeviationMultiplier = standardDeviationMultiplier;
+	this->distanceThreshold = 0.0;
+	setK(k);
+}
+
+StatisticalOutlierRemoval::~StatisticalOutlierRemoval() {
+
+}
+
+void StatisticalOutlierRemoval::filter(PointCloud3D* originalPointCloud, PointCloud3D* resultPointCloud) {
+	assert(originalPointCloud != 0);
+	assert(resultPointCloud != 0);
+	assert(originalPointCloud != resultPointCloud);
+
+	std::vector<double> meanDistances;
+	computeNeighborDistances(originalPointCloud, k, meanDistance, &meanDistances);
+	unsigned int count = static_cast<unsigned int>(meanDistances.size());
+	if (count == 0) {
+		return;
+	}
+
+	double sum = 0.0;
+	double squaredSum = 0.0;
+	for (unsigned int i = 0; i < count; ++i) {
+		sum += meanDistances[i];
+		squaredSum += meanDistances[i] * meanDistances[i];
+	}
+	double mean = sum / count;
+	double variance = (count > 1) ? (squaredSum - sum * mean) / (count - 1) : 0.0;
+	distanceThreshold = mean + standardDeviationMultiplier * std::sqrt(std::max(variance, 0.0));
+
+	std::vector<unsigned char> isInlier(count);
+	for (unsigned int i = 0; i < count; ++i) {
+		isInlier[i] = (meanDistances[i] <= distanceThreshold);
+	}
+	copySelectedPoints(originalPointCloud, isInlier, resultPointCloud);
+}
+
+unsigned int StatisticalOutlierRemoval::getK() const {
+	return k;
+}
+
+void StatisticalOutlierRemoval::setK(unsigned int k) {
+	if (k == 0) {
+		throw runtime_error("ERROR: StatisticalOutlierRemoval needs at least one neighbor.");
+	}
+	this->k = k;
+}
+
+double StatisticalOutlierRemoval::getStandardDeviationMultiplier() const {
+	return standardDeviationMultiplier;
+}
+
+void StatisticalOutlierRemoval::setStandardDeviationMultiplier(double standardDeviationMultiplier) {
+	this->standardDeviationMultiplier = standardDeviationMultiplier;
+}
+
+double StatisticalOutlierRemoval::getDistanceThreshold() const {
+	return distanceThreshold;
+}
+
+}
+
+/* EOF */
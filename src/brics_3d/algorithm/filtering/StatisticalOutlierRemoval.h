@@ -0,0 +1,86 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+#ifndef BRICS_3D_STATISTICALOUTLIERREMOVAL_H_
+#define BRICS_3D_STATISTICALOUTLIERREMOVAL_H_
+
+#include "NeighborDistanceFilter.h"
+
+namespace brics_3d {
+
+/**
+ * @brief Removes sparse outliers (e.g. speckle noise of a sensor) based on the distances to the nearest neighbors.
+ *
+ * For every point the mean distance to its k nearest neighbors is computed. Over all points the
+ * mean and the standard deviation of these values are estimated. Points with a mean distance above
+ * mean + standardDeviationMultiplier * standard deviation are removed.
+ * @ingroup filtering
+ */
+class StatisticalOutlierRemoval : public NeighborDistanceFilter {
+public:
+
+	/**
+	 * @brief Standard constructor. 8 neighbors and a multiplier of 1.0.
+	 */
+	StatisticalOutlierRemoval();
+
+	/**
+	 * @brief Constructor with parameters.
+	 * @param k Number of nearest neighbors.
+	 * @param standardDeviationMultiplier Threshold in multiples of the standard deviation.
+	 */
+	StatisticalOutlierRemoval(unsigned int k, double standardDeviationMultiplier);
+
+	virtual ~StatisticalOutlierRemoval();
+
+	/**
+	 * @brief Remove the outliers.
+	 * @param[in] originalPointCloud The input point cloud. This data will not be modified.
+	 * @param[out] resultPointCloud The inliers are appended; decorations of the points are kept.
+	 */
+	void filter(PointCloud3D* originalPointCloud, PointCloud3D* resultPointCloud);
+
+	unsigned int getK() const;
+
+	void setK(unsigned int k);
+
+	double getStandardDeviationMultiplier() const;
+
+	void setStandardDeviationMultiplier(double standardDeviationMultiplier);
+
+	/// Distance threshold that was applied in the last call of filter().
+	double getDistanceThreshold() const;
+
+private:
+
+	/// Number of nearest neighbors.
+	unsigned int k;
+
+	/// Threshold in multiples of the standard deviation.
+	double standardDeviationMultiplier;
+
+	/// Threshold of the last call of filter().
+	double distanceThreshold;
+};
+
+}
+
+#endif /* BRICS_3D_STATISTICALOUTLIERREMOVAL_H_ */
+
+/* EOF */
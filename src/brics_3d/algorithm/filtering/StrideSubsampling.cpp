@@ -0,0 +1,76 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+
+#include "StrideSubsampling.h"
+
+#include <cassert>
+#include <stdexcept>
+
+using std::runtime_error;
+
+namespace brics_3d {
+
+StrideSubsampling::StrideSubsampling(unsigned int stride) {
+	this->stride = 10;
+	setStride(stride);
+	this->activeStride = this->stride;
+}
+
+StrideSubsampling::~StrideSubsampling() {
+
+}
+
+void StrideSubsampling::addChunk(PointCloud3D* chunk, PointCloud3D* resultPointCloud) {
+	assert(chunk != 0);
+	assert(resultPointCloud != 0);
+	assert(chunk != resultPointCloud);
+
+	unsigned int chunkSize = chunk->getSize();
+	unsigned int first = static_cast<unsigned int>((activeStride - numberOfProcessedPoints % activeStride) % activeStride);
+	numberOfProcessedPoints += chunkSize;
+
+	boost::ptr_vector<Point3D>& points = *chunk->getPointCloud();
+	if (first < chunkSize) {
+		resultPointCloud->reserve(resultPointCloud->getSize() + (chunkSize - first - 1) / activeStride + 1);
+	}
+	for (unsigned int i = first; i < chunkSize; i += activeStride) {
+		resultPointCloud->addPointClone(points[i]);
+	}
+}
+
+void StrideSubsampling::reset() {
+	SubsamplingFilter::reset();
+	activeStride = stride;
+}
+
+unsigned int StrideSubsampling::getStride() const {
+	return stride;
+}
+
+void StrideSubsampling::setStride(unsigned int stride) {
+	if (stride == 0) {
+		throw runtime_error("ERROR: stride for StrideSubsampling must be greater than 0.");
+	}
+	this->stride = stride;
+}
+
+}
+
+/* EOF */
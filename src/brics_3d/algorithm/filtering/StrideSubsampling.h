@@ -0,0 +1,70 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+
+#ifndef BRICS_3D_STRIDESUBSAMPLING_H_
+#define BRICS_3D_STRIDESUBSAMPLING_H_
+
+#include "SubsamplingFilter.h"
+
+namespace brics_3d {
+
+/**
+ * @brief Keeps every n-th point of a point cloud or stream, starting with the first one.
+ *
+ * The position in the stream is kept across chunks, so a stream of chunks results in the
+ * same points as the concatenated point cloud.
+ * @ingroup filtering
+ */
+class StrideSubsampling : public SubsamplingFilter {
+public:
+
+	/**
+	 * @brief Constructor.
+	 * @param stride Distance between two selected points. Must be greater than 0.
+	 */
+	StrideSubsampling(unsigned int stride = 10);
+
+	virtual ~StrideSubsampling();
+
+	void reset();
+
+	void addChunk(PointCloud3D* chunk, PointCloud3D* resultPointCloud);
+
+	unsigned int getStride() const;
+
+	/**
+	 * @brief Set the distance between two selected points. Takes effect with the next reset().
+	 */
+	void setStride(unsigned int stride);
+
+private:
+
+	/// Distance between two selected points.
+	unsigned int stride;
+
+	/// Stride of the current stream.
+	unsigned int activeStride;
+};
+
+}
+
+#endif /* BRICS_3D_STRIDESUBSAMPLING_H_ */
+
+/* EOF */
@@ -0,0 +1,59 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+
+#include "SubsamplingFilter.h"
+
+#include <cassert>
+
+namespace brics_3d {
+
+SubsamplingFilter::SubsamplingFilter() {
+	this->numberOfProcessedPoints = 0;
+}
+
+SubsamplingFilter::~SubsamplingFilter() {
+
+}
+
+void SubsamplingFilter::filter(PointCloud3D* originalPointCloud, PointCloud3D* resultPointCloud) {
+	assert(originalPointCloud != 0);
+	assert(resultPointCloud != 0);
+	assert(originalPointCloud != resultPointCloud);
+
+	reset();
+	addChunk(originalPointCloud, resultPointCloud);
+	finish(resultPointCloud);
+}
+
+void SubsamplingFilter::reset() {
+	numberOfProcessedPoints = 0;
+}
+
+void SubsamplingFilter::finish(PointCloud3D* resultPointCloud) {
+
+}
+
+boost::uint64_t SubsamplingFilter::getNumberOfProcessedPoints() const {
+	return numberOfProcessedPoints;
+}
+
+}
+
+/* EOF */
@@ -0,0 +1,91 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+
+#ifndef BRICS_3D_SUBSAMPLINGFILTER_H_
+#define BRICS_3D_SUBSAMPLINGFILTER_H_
+
+#include "IFiltering.h"
+
+#include <boost/cstdint.hpp>
+
+namespace brics_3d {
+
+/**
+ * @brief Common base for filters that reduce a point cloud to a subset of its points.
+ *
+ * The input can be processed as a whole with filter() or as a stream of chunks:
+ *  @code
+ *	subsampling.reset();
+ *	while (... next chunk of a sensor ...) {
+ *		subsampling.addChunk(chunk, result); // appends the points that are already decided
+ *	}
+ *	subsampling.finish(result); // appends the points that are only known at the end of the stream
+ *	@endcode
+ * The work per chunk only depends on the chunk size (and the number of selected points), never on
+ * the amount of data that has been streamed before. For the same sequence of points the result
+ * does not depend on how the stream is split into chunks.
+ * @ingroup filtering
+ */
+class SubsamplingFilter : public IFiltering {
+public:
+
+	SubsamplingFilter();
+
+	virtual ~SubsamplingFilter();
+
+	/**
+	 * @brief Subsample a complete point cloud. Same as reset(), addChunk() and finish().
+	 * @param[in] originalPointCloud The input point cloud. This data will not be modified.
+	 * @param[out] resultPointCloud The selected points are appended; decorations of the points are kept.
+	 */
+	void filter(PointCloud3D* originalPointCloud, PointCloud3D* resultPointCloud);
+
+	/**
+	 * @brief Start a new stream.
+	 */
+	virtual void reset();
+
+	/**
+	 * @brief Process the next chunk of a stream.
+	 * @param[in] chunk The next points of the stream. This data will not be modified.
+	 * @param[out] resultPointCloud Points that are selected for sure are appended.
+	 */
+	virtual void addChunk(PointCloud3D* chunk, PointCloud3D* resultPointCloud) = 0;
+
+	/**
+	 * @brief End of the stream. Appends points that could only be decided with the whole stream.
+	 * The default implementation does nothing.
+	 */
+	virtual void finish(PointCloud3D* resultPointCloud);
+
+	/// Number of points that have been passed to addChunk() since the last reset().
+	boost::uint64_t getNumberOfProcessedPoints() const;
+
+protected:
+
+	/// Number of points of the current stream so far. Index of the next point in the stream.
+	boost::uint64_t numberOfProcessedPoints;
+};
+
+}
+
+#endif /* BRICS_3D_SUBSAMPLINGFILTER_H_ */
+
+/* EOF */
@@ -0,0 +1,468 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+#include "VoxelGridFilter.h"
+#include "brics_3d/core/ParallelProcessing.h"
+#include "brics_3d/core/Point3DArena.h"
+
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+#include <boost/bind.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/thread.hpp>
+
+using std::runtime_error;
+
+namespace brics_3d {
+
+/// Bits per axis of a packed voxel key.
+static const int voxelKeyBits = 21;
+
+/// Number of voxels per axis that can be addressed by a packed voxel key.
+static const boost::uint64_t maxVoxelsPerAxis = (static_cast<boost::uint64_t>(1) << voxelKeyBits);
+
+/// Marker for unused slots of the hash table. No valid key has all bits set.
+static const boost::uint64_t emptyKey = ~static_cast<boost::uint64_t>(0);
+
+/// Accumulated data of one occupied voxel.
+struct VoxelAccumulator {
+	boost::uint64_t key;
+	double sumX;
+	double sumY;
+	double sumZ;
+	unsigned int count;
+	unsigned int firstIndex;
+};
+
+/// Slot of the hash table. The key is stored along with the index to avoid an indirection while probing.
+struct VoxelSlot {
+	boost::uint64_t key;
+	unsigned int voxelIndex;
+};
+
+/**
+ * Open addressing hash table (linear probing) from packed voxel keys to accumulators.
+ * The accumulators are stored in the order of insertion.
+ */
+class VoxelBinning {
+public:
+
+	VoxelBinning() : tableMask(0), lastKey(emptyKey), lastVoxelIndex(0) {
+		resizeTable(1024);
+	}
+
+	/// Prepare the table for an expected amount of voxels to avoid rehashing.
+	void reserve(std::size_t expectedNumberOfVoxels) {
+		std::size_t size = table.size();
+		while (size < 2 * expectedNumberOfVoxels) {
+			size *= 2;
+		}
+		voxels.reserve(expectedNumberOfVoxels);
+		if (size > table.size()) {
+			resizeTable(size);
+		}
+	}
+
+	void add(boost::uint64_t key, double x, double y, double z, unsigned int index) {
+		if (key != lastKey) { // consecutive points of a scan often fall into the same voxel
+			findOrInsert(key, index);
+		}
+		VoxelAccumulator& voxel = voxels[lastVoxelIndex];
+		voxel.sumX += x;
+		voxel.sumY += y;
+		voxel.sumZ += z;
+		voxel.count++;
+	}
+
+	/// Merge the voxels of a binning of a later part of the input.
+	void merge(const VoxelBinning& other) {
+		for (std::size_t i = 0; i < other.voxels.size(); ++i) {
+			const VoxelAccumulator& otherVoxel = other.voxels[i];
+			VoxelAccumulator& voxel = findOrInsert(otherVoxel.key, otherVoxel.firstIndex);
+			voxel.sumX += otherVoxel.sumX;
+			voxel.sumY += otherVoxel.sumY;
+			voxel.sumZ += otherVoxel.sumZ;
+			voxel.count += otherVoxel.count;
+		}
+	}
+
+	std::vector<VoxelAccumulator> voxels;
+
+private:
+
+	/// 64 bit finalizer of MurmurHash3; all bits of the key affect the low bits used as table index.
+	static std::size_t hash(boost::uint64_t key) {
+		key ^= key >> 33;
+		key *= 0xff51afd7ed558ccdULL;
+		key ^= key >> 33;
+		key *= 0xc4ceb9fe1a85ec53ULL;
+		key ^= key >> 33;
+		return static_cast<std::size_t>(key);
+	}
+
+	VoxelAccumulator& findOrInsert(boost::uint64_t key, unsigned int index) {
+		std::size_t slot = hash(key) & tableMask;
+		while (table[slot].key != emptyKey) {
+			if (table[slot].key == key) {
+				lastKey = key;
+				lastVoxelIndex = table[slot].voxelIndex;
+				return voxels[lastVoxelIndex];
+			}
+			slot = (slot + 1) & tableMask;
+		}
+
+		VoxelAccumulator voxel;
+		voxel.key = key;
+		voxel.sumX = 0.0;
+		voxel.sumY = 0.0;
+		voxel.sumZ = 0.0;
+		voxel.count = 0;
+		voxel.firstIndex = index;
+		table[slot].key = key;
+		table[slot].voxelIndex = static_cast<unsigned int>(voxels.size());
+		lastKey = key;
+		lastVoxelIndex = table[slot].voxelIndex;
+		voxels.push_back(voxel);
+
+		if (2 * voxels.size() > table.size()) { // keep the load factor below 0.5
+			resizeTable(2 * table.size());
+		}
+		return voxels.back();
+	}
+
+	void resizeTable(std::size_t size) {
+		VoxelSlot empty;
+		empty.key = emptyKey;
+		empty.voxelIndex = 0;
+		table.assign(size, empty);
+		tableMask = size - 1;
+		for (unsigned int i = 0; i < voxels.size(); ++i) {
+			std::size_t slot = hash(voxels[i].key) & tableMask;
+			while (table[slot].key != emptyKey) {
+				slot = (slot + 1) & tableMask;
+			}
+			table[slot].key = voxels[i].key;
+			table[slot].voxelIndex = i;
+		}
+	}
+
+	/// The size is always a power of two.
+	std::vector<VoxelSlot> table;
+
+	std::size_t tableMask;
+
+	/// The most recently used voxel.
+	boost::uint64_t lastKey;
+	unsigned int lastVoxelIndex;
+};
+
+/// False for NaN or infinite coordinates, as x - x is NaN for those values.
+template <typename ScalarT>
+static inline bool isValidPoint(ScalarT x, ScalarT y, ScalarT z) {
+	return ((x - x) + (y - y) + (z - z)) == 0;
+}
+
+/// Compute the lower bound of all valid points in [begin, end). bounds holds minX, minY, minZ, maxX, maxY, maxZ.
+template <typename ScalarT>
+static void computeBounds(const ScalarT* x, const ScalarT* y, const ScalarT* z, unsigned int begin, unsigned int end, double* bounds) {
+	bounds[0] = bounds[1] = bounds[2] = std::numeric_limits<double>::max();
+	bounds[3] = bounds[4] = bounds[5] = -std::numeric_limits<double>::max();
+	for (unsigned int i = begin; i < end; ++i) {
+		if (!isValidPoint(x[i], y[i], z[i])) {
+			continue;
+		}
+		bounds[0] = std::min(bounds[0], static_cast<double>(x[i]));
+		bounds[1] = std::min(bounds[1], static_cast<double>(y[i]));
+		bounds[2] = std::min(bounds[2], static_cast<double>(z[i]));
+		bounds[3] = std::max(bounds[3], static_cast<double>(x[i]));
+		bounds[4] = std::max(bounds[4], static_cast<double>(y[i]));
+		bounds[5] = std::max(bounds[5], static_cast<double>(z[i]));
+	}
+}
+
+template <typename ScalarT>
+static void binPoints(const ScalarT* x, const ScalarT* y, const ScalarT* z, unsigned int begin, unsigned int end,
+		const double* origin, double inverseVoxelSize, VoxelBinning* binning) {
+	for (unsigned int i = begin; i < end; ++i) {
+		if (!isValidPoint(x[i], y[i], z[i])) {
+			continue;
+		}
+		boost::uint64_t ix = static_cast<boost::uint64_t>((x[i] - origin[0]) * inverseVoxelSize);
+		boost::uint64_t iy = static_cast<boost::uint64_t>((y[i] - origin[1]) * inverseVoxelSize);
+		boost::uint64_t iz = static_cast<boost::uint64_t>((z[i] - origin[2]) * inverseVoxelSize);
+		boost::uint64_t key = (ix << (2 * voxelKeyBits)) | (iy << voxelKeyBits) | iz;
+		binning->add(key, x[i], y[i], z[i], i);
+	}
+}
+
+/**
+ * Bin all points into voxels. The result holds one accumulator per occupied voxel in the
+ * order of the first occurrence. origin receives the lower corner of the grid.
+ */
+template <typename ScalarT>
+static void computeVoxels(const ScalarT* x, const ScalarT* y, const ScalarT* z, unsigned int count,
+		double voxelSize, unsigned int maxNumberOfThreads, VoxelBinning& result, double* origin) {
+
+	unsigned int numberOfThreads = ParallelProcessing::getNumberOfThreads(count, VoxelGridFilter::parallelThreshold, maxNumberOfThreads);
+	unsigned int chunkSize = count / numberOfThreads;
+
+	/* bounding box; the last chunk is processed by the calling thread */
+	std::vector<double> bounds(6 * numberOfThreads);
+	{
+		boost::thread_group workers;
+		for (unsigned int i = 0; i < numberOfThreads - 1; ++i) {
+			workers.create_thread(boost::bind(&computeBounds<ScalarT>, x, y, z, i * chunkSize, (i + 1) * chunkSize, &bounds[6 * i]));
+		}
+		computeBounds<ScalarT>(x, y, z, (numberOfThreads - 1) * chunkSize, count, &bounds[6 * (numberOfThreads - 1)]);
+		workers.join_all();
+	}
+	for (unsigned int i = 1; i < numberOfThreads; ++i) {
+		for (int j = 0; j < 3; ++j) {
+			bounds[j] = std::min(bounds[j], bounds[6 * i + j]);
+			bounds[3 + j] = std::max(bounds[3 + j], bounds[6 * i + 3 + j]);
+		}
+	}
+	if (bounds[0] > bounds[3]) { // no valid points at all
+		return;
+	}
+	origin[0] = bounds[0];
+	origin[1] = bounds[1];
+	origin[2] = bounds[2];
+
+	double inverseVoxelSize = 1.0 / voxelSize;
+	for (int j = 0; j < 3; ++j) {
+		if ((bounds[3 + j] - bounds[j]) * inverseVoxelSize >= static_cast<double>(maxVoxelsPerAxis - 1)) {
+			throw runtime_error("ERROR: voxelSize for VoxelGridFilter is too small for the extent of the point cloud.");
+		}
+	}
+
+	/* the number of points in a chunk and the number of cells of the grid limit the number of occupied voxels */
+	double numberOfCells = 1.0;
+	for (int j = 0; j < 3; ++j) {
+		numberOfCells *= std::floor((bounds[3 + j] - bounds[j]) * inverseVoxelSize) + 1.0;
+	}
+	std::size_t expectedNumberOfVoxels = static_cast<std::size_t>(std::min(numberOfCells, static_cast<double>(count / numberOfThreads + 1)));
+
+	/* binning: one table per chunk, merged in the order of the chunks to preserve the order of first occurrence */
+	std::vector<VoxelBinning> partialBinnings(numberOfThreads - 1);
+	result.reserve(expectedNumberOfVoxels);
+	for (unsigned int i = 0; i < partialBinnings.size(); ++i) {
+		partialBinnings[i].reserve(expectedNumberOfVoxels);
+	}
+	{
+		boost::thread_group workers;
+		for (unsigned int i = 1; i < numberOfThreads; ++i) {
+			unsigned int end = (i == numberOfThreads - 1) ? count : (i + 1) * chunkSize;
+			workers.create_thread(boost::bind(&binPoints<ScalarT>, x, y, z, i * chunkSize, end, origin, inverseVoxelSize, &partialBinnings[i - 1]));
+		}
+		binPoints<ScalarT>(x, y, z, 0, (numberOfThreads == 1) ? count : chunkSize, origin, inverseVoxelSize, &result);
+		workers.join_all();
+	}
+	for (unsigned int i = 0; i < partialBinnings.size(); ++i) {
+		result.merge(partialBinnings[i]);
+	}
+}
+
+/// Representative coordinates of a voxel according to the selection mode.
+template <typename ScalarT>
+static inline void getVoxelPoint(const VoxelAccumulator& voxel, VoxelGridFilter::SelectionMode mode, double voxelSize, const double* origin,
+		const ScalarT* x, const ScalarT* y, const ScalarT* z, double& resultX, double& resultY, double& resultZ) {
+	switch (mode) {
+	case VoxelGridFilter::voxelCenter: {
+		const boost::uint64_t mask = maxVoxelsPerAxis - 1;
+		resultX = origin[0] + (static_cast<double>((voxel.key >> (2 * voxelKeyBits)) & mask) + 0.5) * voxelSize;
+		resultY = origin[1] + (static_cast<double>((voxel.key >> voxelKeyBits) & mask) + 0.5) * voxelSize;
+		resultZ = origin[2] + (static_cast<double>(voxel.key & mask) + 0.5) * voxelSize;
+		break;
+	}
+	case VoxelGridFilter::firstPoint:
+		resultX = x[voxel.firstIndex];
+		resultY = y[voxel.firstIndex];
+		resultZ = z[voxel.firstIndex];
+		break;
+	default:
+		resultX = voxel.sumX / voxel.count;
+		resultY = voxel.sumY / voxel.count;
+		resultZ = voxel.sumZ / voxel.count;
+		break;
+	}
+}
+
+VoxelGridFilter::VoxelGridFilter() {
+	this->voxelSize = 0;
+	this->mode = voxelCentroid;
+	this->maxNumberOfThreads = 0;
+}
+
+VoxelGridFilter::VoxelGridFilter(double voxelSize, SelectionMode mode) {
+	this->voxelSize = 0;
+	setVoxelSize(voxelSize);
+	this->mode = mode;
+	this->maxNumberOfThreads = 0;
+}
+
+VoxelGridFilter::~VoxelGridFilter() {
+
+}
+
+void VoxelGridFilter::filter(PointCloud3D* originalPointCloud, PointCloud3D* resultPointCloud) {
+	assert(originalPointCloud != 0);
+	assert(resultPointCloud != 0);
+
+	resultPointCloud->clear();
+	unsigned int count = originalPointCloud->getSize();
+	if (count == 0) {
+		return; //Nothing to do here..
+	}
+
+	boost::ptr_vector<Point3D>* points = originalPointCloud->getPointCloud();
+	if (voxelSize <= 0) {
+		resultPointCloud->reserve(count);
+		for (unsigned int i = 0; i < count; ++i) { //just copy data
+			resultPointCloud->addPointClone((*points)[i]);
+		}
+		return;
+	}
+
+	/* gather the coordinates in one pass, so the binning works on contiguous memory */
+	std::vector<Coordinate> x(count);
+	std::vector<Coordinate> y(count);
+	std::vector<Coordinate> z(count);
+	for (unsigned int i = 0; i < count; ++i) {
+		const Point3D& point = (*points)[i];
+		x[i] = point.getX();
+		y[i] = point.getY();
+		z[i] = point.getZ();
+	}
+
+	VoxelBinning binning;
+	double origin[3];
+	computeVoxels<Coordinate>(&x[0], &y[0], &z[0], count, voxelSize, maxNumberOfThreads, binning, origin);
+
+	resultPointCloud->reserve(static_cast<unsigned int>(binning.voxels.size()));
+	for (std::size_t i = 0; i < binning.voxels.size(); ++i) {
+		const VoxelAccumulator& voxel = binning.voxels[i];
+		Point3D* resultPoint = (*points)[voxel.firstIndex].cloneInto(resultPointCloud->getArena().get()); // keeps the decorations of the first point
+		if (mode != firstPoint) {
+			double resultX, resultY, resultZ;
+			getVoxelPoint<Coordinate>(voxel, mode, voxelSize, origin, &x[0], &y[0], &z[0], resultX, resultY, resultZ);
+			resultPoint->setX(resultX);
+			resultPoint->setY(resultY);
+			resultPoint->setZ(resultZ);
+		}
+		resultPointCloud->addPointPtr(resultPoint);
+	}
+}
+
+template <typename ScalarT>
+void VoxelGridFilter::filter(const PointCloud3DContiguousT<ScalarT>& originalPointCloud, PointCloud3DContiguousT<ScalarT>& resultPointCloud) {
+	assert(&originalPointCloud != &resultPointCloud);
+	resultPointCloud.clear();
+	unsigned int count = originalPointCloud.getSize();
+	if (count == 0) {
+		return; //Nothing to do here..
+	}
+	if (voxelSize <= 0) {
+		resultPointCloud = originalPointCloud; //just copy data
+		return;
+	}
+
+	const ScalarT* x = originalPointCloud.getXCoordinates();
+	const ScalarT* y = originalPointCloud.getYCoordinates();
+	const ScalarT* z = originalPointCloud.getZCoordinates();
+	VoxelBinning binning;
+	double origin[3];
+	computeVoxels<ScalarT>(x, y, z, count, voxelSize, maxNumberOfThreads, binning, origin);
+
+	unsigned int resultSize = static_cast<unsigned int>(binning.voxels.size());
+	std::vector<ScalarT> resultX(resultSize);
+	std::vector<ScalarT> resultY(resultSize);
+	std::vector<ScalarT> resultZ(resultSize);
+	for (unsigned int i = 0; i < resultSize; ++i) {
+		double tmpX, tmpY, tmpZ;
+		getVoxelPoint<ScalarT>(binning.voxels[i], mode, voxelSize, origin, x, y, z, tmpX, tmpY, tmpZ);
+		resultX[i] = static_cast<ScalarT>(tmpX);
+		resultY[i] = static_cast<ScalarT>(tmpY);
+		resultZ[i] = static_cast<ScalarT>(tmpZ);
+	}
+	resultPointCloud.adoptCoordinates(resultX, resultY, resultZ);
+
+	/* attributes of the first point per voxel */
+	if (originalPointCloud.hasColors()) {
+		resultPointCloud.enableColors();
+		const unsigned char* colors = originalPointCloud.getColors();
+		for (unsigned int i = 0; i < resultSize; ++i) {
+			const unsigned char* color = &colors[3 * binning.voxels[i].firstIndex];
+			resultPointCloud.setColor(i, color[0], color[1], color[2]);
+		}
+	}
+	if (originalPointCloud.hasNormals()) {
+		resultPointCloud.enableNormals();
+		const float* normals = originalPointCloud.getNormals();
+		for (unsigned int i = 0; i < resultSize; ++i) {
+			const float* normal = &normals[3 * binning.voxels[i].firstIndex];
+			resultPointCloud.setNormal(i, normal[0], normal[1], normal[2]);
+		}
+	}
+	if (originalPointCloud.hasIntensities()) {
+		resultPointCloud.enableIntensities();
+		const float* intensities = originalPointCloud.getIntensities();
+		for (unsigned int i = 0; i < resultSize; ++i) {
+			resultPointCloud.setIntensity(i, intensities[binning.voxels[i].firstIndex]);
+		}
+	}
+}
+
+void VoxelGridFilter::setVoxelSize(double voxelSize) {
+	if (voxelSize < 0.0) {
+		throw runtime_error("ERROR: voxelSize for VoxelGridFilter cannot be less than 0.");
+	}
+	this->voxelSize = voxelSize;
+}
+
+double VoxelGridFilter::getVoxelSize() {
+	return this->voxelSize;
+}
+
+void VoxelGridFilter::setSelectionMode(SelectionMode mode) {
+	this->mode = mode;
+}
+
+VoxelGridFilter::SelectionMode VoxelGridFilter::getSelectionMode() {
+	return this->mode;
+}
+
+void VoxelGridFilter::setMaxNumberOfThreads(unsigned int maxNumberOfThreads) {
+	this->maxNumberOfThreads = maxNumberOfThreads;
+}
+
+unsigned int VoxelGridFilter::getMaxNumberOfThreads() {
+	return this->maxNumberOfThreads;
+}
+
+/* explicit instantiation for the supported precisions */
+template void VoxelGridFilter::filter<double>(const PointCloud3DContiguousT<double>&, PointCloud3DContiguousT<double>&);
+template void VoxelGridFilter::filter<float>(const PointCloud3DContiguousT<float>&, PointCloud3DContiguousT<float>&);
+
+}
+
+/* EOF */
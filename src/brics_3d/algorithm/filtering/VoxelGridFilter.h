@@ -0,0 +1,118 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+#ifndef BRICS_3D_VOXELGRIDFILTER_H_
+#define BRICS_3D_VOXELGRIDFILTER_H_
+
+#include "brics_3d/algorithm/filtering/IOctreeReductionFilter.h"
+#include "brics_3d/algorithm/filtering/IOctreeSetup.h"
+#include "brics_3d/core/PointCloud3DContiguous.h"
+
+namespace brics_3d {
+
+/**
+ * @brief Point cloud size reduction with a regular voxel grid.
+ *
+ * Alternative to the brics_3d::Octree reduction filter. Instead of building a tree the points
+ * are binned into the cells of a uniform grid with edge length voxelSize via a hash table
+ * in a single pass over the data. Each occupied voxel is represented by exactly one point.
+ * Depending on the SelectionMode this is:
+ *  - voxelCentroid: the mean of all points in the voxel (default)
+ *  - voxelCenter: the geometric center of the voxel
+ *  - firstPoint: the first point of the input that falls into the voxel
+ *
+ * The output order is the order in which the voxels are first hit by the input points.
+ * For firstPoint the complete point including its decorations (or color, normal and intensity
+ * channels of a brics_3d::PointCloud3DContiguous) is copied. For the other modes the attributes
+ * of the first point in a voxel are used.
+ *
+ * Large point clouds are binned by multiple threads. Points with NaN or infinite coordinates are ignored.
+ *
+ * @ingroup filtering
+ */
+class VoxelGridFilter : public IOctreeReductionFilter, public IOctreeSetup {
+public:
+
+	/// Defines which point represents a voxel.
+	enum SelectionMode {
+		voxelCentroid,
+		voxelCenter,
+		firstPoint
+	};
+
+	/// Threshold for ParallelProcessing::getNumberOfThreads().
+	static const unsigned int parallelThreshold = 200000;
+
+	/**
+	 * @brief Standard constructor.
+	 */
+	VoxelGridFilter();
+
+	/**
+	 * @brief Constructor with voxel size and selection mode.
+	 */
+	VoxelGridFilter(double voxelSize, SelectionMode mode = voxelCentroid);
+
+	/**
+	 * @brief Standard destructor.
+	 */
+	virtual ~VoxelGridFilter();
+
+	void filter(PointCloud3D* originalPointCloud, PointCloud3D* resultPointCloud);
+
+	/**
+	 * @brief Reduce the size of a contiguous point cloud.
+	 * @param[in] originalPointCloud The input point cloud. This data will not be modified.
+	 * @param[out] resultPointCloud The reduced point cloud. Previous content will be replaced.
+	 */
+	template <typename ScalarT>
+	void filter(const PointCloud3DContiguousT<ScalarT>& originalPointCloud, PointCloud3DContiguousT<ScalarT>& resultPointCloud);
+
+	void setVoxelSize(double voxelSize);
+
+	double getVoxelSize();
+
+	void setSelectionMode(SelectionMode mode);
+
+	SelectionMode getSelectionMode();
+
+	/**
+	 * @brief Limit the number of threads used for the binning.
+	 * @param maxNumberOfThreads Upper limit, see ParallelProcessing::getNumberOfThreads().
+	 */
+	void setMaxNumberOfThreads(unsigned int maxNumberOfThreads);
+
+	unsigned int getMaxNumberOfThreads();
+
+private:
+
+	/// Edge length of a voxel.
+	double voxelSize;
+
+	/// Which point represents a voxel.
+	SelectionMode mode;
+
+	unsigned int maxNumberOfThreads;
+};
+
+}
+
+#endif /* BRICS_3D_VOXELGRIDFILTER_H_ */
+
+/* EOF */
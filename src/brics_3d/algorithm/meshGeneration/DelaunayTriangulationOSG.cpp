@@ -105,6 +105,13 @@ void DelaunayTriangulationOSG::triangulate(PointCloud3D* pointCloud, ITriangleMe
 //		std::cout << triangle->_p2->_vertex<< ", ";
 //		std::cout << triangle->_p3->_vertex << "\n";
 //	}
+	/* the edge collector returns a triangle soup; let an indexed mesh share the vertices */
+	TriangleMeshImplicit* indexedMesh = dynamic_cast<TriangleMeshImplicit*>(mesh);
+	bool restoreWelding = (indexedMesh != 0) && !indexedMesh->isVertexWeldingEnabled();
+	if (restoreWelding) {
+		indexedMesh->enableVertexWelding();
+	}
+
 	Point3D tmpVertex1;
 	Point3D tmpVertex2;
 	Point3D tmpVertex3;
@@ -131,6 +138,10 @@ void DelaunayTriangulationOSG::triangulate(PointCloud3D* pointCloud, ITriangleMe
 
 	   mesh->addTriangle(tmpVertex1, tmpVertex2, tmpVertex3);
 	}
+
+	if (restoreWelding) {
+		indexedMesh->disableVertexWelding();
+	}
 }
 
 void DelaunayTriangulationOSG::generateMesh(PointCloud3D* pointCloud, ITriangleMesh* mesh) {
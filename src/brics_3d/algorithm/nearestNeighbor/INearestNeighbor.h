@@ -83,6 +83,30 @@ public:
 	 */
 	virtual void findNearestNeighbors(vector<double>* query, std::vector<int>* resultIndices, unsigned int k = 1) = 0;
 
+	/**
+	 * @brief Find the nearest neighbors of the query and their squared distances.
+	 * @param[in] query Vector that will be queried to the data.
+	 * @param[out] resultIndices Returns the indices of the $k$ nearest neighbors. Neighbors that exceed the maximum distance are omitted.
+	 * @param[out] squaredDistances Returns the squared distance for every element of resultIndices.
+	 * @param[in] k Sets how many nearest neighbors will be searched.
+	 *
+	 * <b>NOTE:</b> setData() must be invoked before.
+	 */
+	virtual void findNearestNeighbors(vector<double>* query, std::vector<int>* resultIndices, std::vector<double>* squaredDistances, unsigned int k) = 0;
+
+	/**
+	 * @brief Find all data vectors within a fixed radius around the query.
+	 *
+	 * The maximum distance of the search (if any) is not taken into account. The order of the results is not specified.
+	 * @param[in] query Vector that will be queried to the data.
+	 * @param[in] radius Search radius (not squared).
+	 * @param[out] resultIndices Returns the indices of all data vectors with a distance <= radius.
+	 * @param[out] squaredDistances Optional: returns the squared distance for every element of resultIndices.
+	 *
+	 * <b>NOTE:</b> setData() must be invoked before.
+	 */
+	virtual void findNeighborsWithinRadius(vector<double>* query, double radius, std::vector<int>* resultIndices, std::vector<double>* squaredDistances = 0) = 0;
+
 };
 
 }  // namespace brics_3d
@@ -33,7 +33,7 @@ public:
 	/**
 	 * @brief Standard constructor.
 	 */
-	INearestNeighborSetup(){};
+	INearestNeighborSetup() : maxNumberOfThreads(0) {};
 
 	/**
 	 * @brief Standard destructor.
@@ -71,6 +71,20 @@ public:
         this->maxDistance = maxDistance;
     }
 
+    /**
+     * @brief Limit the number of threads that process a batch of queries.
+     * @param maxNumberOfThreads Upper limit, see ParallelProcessing::getNumberOfThreads().
+     */
+    void setMaxNumberOfThreads(unsigned int maxNumberOfThreads)
+    {
+        this->maxNumberOfThreads = maxNumberOfThreads;
+    }
+
+    unsigned int getMaxNumberOfThreads() const
+    {
+        return maxNumberOfThreads;
+    }
+
 protected:
 
     /// Dimension of data sets search space e.g. 3 for 3D points, etc.
@@ -82,6 +96,8 @@ protected:
 	 * If this value is below 0.0 than it is neglected in the search queries.
 	 */
 	double maxDistance;
+
+	unsigned int maxNumberOfThreads;
 };
 
 }
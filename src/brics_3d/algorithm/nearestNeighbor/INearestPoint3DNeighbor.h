@@ -21,6 +21,7 @@
 #define BRICS_3D_INEARESTPOINT3DNEIGHBOR_H_
 
 #include "brics_3d/core/PointCloud3D.h"
+#include "brics_3d/algorithm/nearestNeighbor/NearestNeighborBatchResult.h"
 #include <vector>
 
 using std::vector;
@@ -66,6 +67,67 @@ public:
 	 * <b>NOTE:</b> setData() must be invoked before.
 	 */
 	virtual void findNearestNeighbors(Point3D* query, std::vector<int>* resultIndices, unsigned int k = 1) = 0; //TODO typo: findNearestNeighbors
+
+	/**
+	 * @brief Find the nearest neighbor points of the query and their squared distances.
+	 *
+	 * Same as findNearestNeighbors(Point3D*, std::vector<int>*, unsigned int), but the squared distances
+	 * that the search computes anyway are returned as well, so they do not need to be recomputed by the caller.
+	 * @param[in] query Point that will be queried to the data.
+	 * @param[out] resultIndices Returns the indices of the $k$ nearest neighbors with respect to the data point cloud.
+	 * Neighbors that exceed the maximum distance are omitted.
+	 * @param[out] squaredDistances Returns the squared distance for every element of resultIndices.
+	 * @param[in] k Sets how many nearest neighbors will be searched.
+	 *
+	 * <b>NOTE:</b> setData() must be invoked before.
+	 */
+	virtual void findNearestNeighbors(Point3D* query, std::vector<int>* resultIndices, std::vector<double>* squaredDistances, unsigned int k) = 0;
+
+	/**
+	 * @brief Find all points of the data point cloud within a fixed radius around the query.
+	 *
+	 * The maximum distance of the search (if any) is not taken into account. The order of the results is not specified.
+	 * @param[in] query Point that will be queried to the data.
+	 * @param[in] radius Search radius (not squared).
+	 * @param[out] resultIndices Returns the indices of all points with a distance <= radius.
+	 * @param[out] squaredDistances Optional: returns the squared distance for every element of resultIndices.
+	 *
+	 * <b>NOTE:</b> setData() must be invoked before.
+	 */
+	virtual void findNeighborsWithinRadius(Point3D* query, double radius, std::vector<int>* resultIndices, std::vector<double>* squaredDistances = 0) = 0;
+
+	/**
+	 * @brief Find the k nearest neighbors for every point of a query point cloud at once.
+	 *
+	 * This avoids a virtual call and result containers per query. Implementations that support concurrent
+	 * queries distribute the batch over multiple threads.
+	 * @param[in] queries Points that will be queried to the data.
+	 * @param[out] result The neighbors of query point i are at position i of the result. Neighbors that
+	 * exceed the maximum distance are omitted.
+	 * @param[in] k Sets how many nearest neighbors will be searched per query.
+	 *
+	 * <b>NOTE:</b> setData() must be invoked before.
+	 */
+	virtual void findNearestNeighbors(PointCloud3D* queries, NearestNeighborBatchResult* result, unsigned int k = 1) = 0;
+
+	/**
+	 * @brief Find the k nearest neighbors for a subset of the points of a query point cloud at once.
+	 *
+	 * Same as findNearestNeighbors(PointCloud3D*, NearestNeighborBatchResult*, unsigned int), but only the points
+	 * referred to by queryIndices are queried. The neighbors of (*queries)[queryIndices[i]] are at position i of the result.
+	 * This is e.g. useful to process the data point cloud itself in blocks.
+	 */
+	virtual void findNearestNeighbors(PointCloud3D* queries, const std::vector<int>& queryIndices, NearestNeighborBatchResult* result, unsigned int k = 1) = 0;
+
+	/**
+	 * @brief Check if findNearestNeighbors() may be called from multiple threads at the same time.
+	 *
+	 * setData() must never be called concurrently to queries.
+	 * @return True if concurrent queries are safe. The default is false.
+	 */
+	virtual bool supportsConcurrentQueries() const {
+		return false;
+	}
 };
 
 }  // namespace brics_3d
@@ -0,0 +1,460 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+
+#ifndef BRICS_3D_KDTREE3D_H_
+#define BRICS_3D_KDTREE3D_H_
+
+#include "brics_3d/core/PointCloud3DAdaptor.h"
+#include "brics_3d/core/ParallelProcessing.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+
+namespace brics_3d {
+
+/**
+ * @ingroup nearestNeighbor
+ * @brief Insert a candidate into k nearest neighbor results that are sorted by increasing squared distance.
+ *
+ * Used by the k-NN searches of the kd-trees and the voxel hash to collect their results in place.
+ * @param index Index of the candidate point.
+ * @param squaredDistance Squared distance of the candidate to the query.
+ * @param k Capacity of the results.
+ * @param[in,out] count Number of results so far, at most k.
+ * @param[in,out] resultIndices Indices of the results.
+ * @param[in,out] squaredDistances Squared distances of the results.
+ * @return False if the results are complete and the candidate is not closer than any of them.
+ */
+inline bool insertNearestNeighbor(int index, double squaredDistance, unsigned int k, unsigned int* count, int* resultIndices, double* squaredDistances) {
+	if (*count == k) {
+		if (squaredDistance >= squaredDistances[k - 1]) {
+			return false;
+		}
+	} else {
+		(*count)++;
+	}
+
+	unsigned int position = *count - 1;
+	while (position > 0 && squaredDistances[position - 1] > squaredDistance) {
+		squaredDistances[position] = squaredDistances[position - 1];
+		resultIndices[position] = resultIndices[position - 1];
+		position--;
+	}
+	squaredDistances[position] = squaredDistance;
+	resultIndices[position] = index;
+	return true;
+}
+
+/**
+ * @ingroup nearestNeighbor
+ * @brief Header-only 3D kd-tree that indexes the coordinates of a point cloud in place.
+ *
+ * The coordinates are read through an accessor (e.g. PointCloud3DAdaptor or PointCloud3DContiguousAdaptor)
+ * with the methods size(), x(i), y(i) and z(i). The tree itself only holds a permutation of the point indices
+ * and the nodes, the coordinates are never copied. The indexed data must not change as long as the tree is used.
+ *
+ * Every inner node splits its points at the median along the axis of the largest extent of its cell, so the
+ * tree is balanced. Nodes with at most getLeafSize() points are leaves that are scanned linearly. The two halves
+ * of the upper levels are built by separate threads for large point clouds.
+ * The queries only use local state, so they may be issued by multiple threads at the same time.
+ * They optionally skip points that are flagged as excluded, so points can be removed logically without a rebuild.
+ */
+template <typename AccessorT>
+class KDTree3D {
+public:
+
+	/// Default maximum number of points in a leaf.
+	static const unsigned int defaultLeafSize = 10;
+
+	/// Threshold for ParallelProcessing::getNumberOfThreads().
+	static const unsigned int parallelThreshold = 50000;
+
+	KDTree3D(unsigned int leafSize = defaultLeafSize) {
+		setLeafSize(leafSize);
+	}
+
+	/**
+	 * @brief Maximum number of points in a leaf. Takes effect with the next build().
+	 * Small leaves speed up the queries, large leaves speed up the build. Throws a runtime_error for 0.
+	 */
+	void setLeafSize(unsigned int leafSize) {
+		if (leafSize == 0) {
+			throw std::runtime_error("KDTree3D: the leaf size has to be at least 1.");
+		}
+		this->leafSize = leafSize;
+	}
+
+	unsigned int getLeafSize() const {
+		return leafSize;
+	}
+
+	/// Number of indexed points.
+	unsigned int getSize() const {
+		return static_cast<unsigned int>(indices.size());
+	}
+
+	const AccessorT& getPoints() const {
+		return points;
+	}
+
+	/**
+	 * @brief Build the tree.
+	 * @param points Accessor to the points. It is stored by value.
+	 * @param maxNumberOfThreads Upper limit, see ParallelProcessing::getNumberOfThreads().
+	 */
+	void build(const AccessorT& points, unsigned int maxNumberOfThreads = 0) {
+		this->points = points;
+		unsigned int count = points.size();
+		indices.resize(count);
+		nodes.clear();
+		if (count == 0) {
+			return;
+		}
+
+		/* the node layout is known in advance: the left child follows its parent, the right child follows the left subtree */
+		std::map<unsigned int, unsigned int> numberOfNodes;
+		nodes.resize(countNodes(count, &numberOfNodes));
+
+		double bounds[6];
+		for (int axis = 0; axis < 3; ++axis) {
+			bounds[axis] = std::numeric_limits<double>::max();
+			bounds[3 + axis] = -std::numeric_limits<double>::max();
+		}
+		for (unsigned int i = 0; i < count; ++i) {
+			const double point[3] = {points.x(i), points.y(i), points.z(i)};
+			for (int axis = 0; axis < 3; ++axis) {
+				bounds[axis] = std::min(bounds[axis], point[axis]);
+				bounds[3 + axis] = std::max(bounds[3 + axis], point[axis]);
+			}
+		}
+
+		unsigned int numberOfThreads = ParallelProcessing::getNumberOfThreads(count, parallelThreshold, maxNumberOfThreads);
+		/* scratch space for the median selection: the coordinate along the split axis and the point index */
+		std::vector<std::pair<double, int> > keys(count);
+		for (unsigned int i = 0; i < count; ++i) {
+			keys[i].second = static_cast<int>(i);
+		}
+		buildNode(0, 0, count, bounds, numberOfThreads, &numberOfNodes, &keys[0]);
+	}
+
+	/**
+	 * @brief Find the k nearest neighbors of a query.
+	 * @param[in] query x, y and z of the query.
+	 * @param[in] k Number of neighbors.
+	 * @param[out] resultIndices Array of at least k elements.
+	 * @param[out] squaredDistances Array of at least k elements.
+	 * @param[in] excluded Optional: one flag per point, points with a non-zero flag are skipped.
+	 * @param[in] maxSquaredDistance Optional: only points that are closer than this are reported. A tight bound,
+	 * e.g. from a search on another tree, prunes most of the tree.
+	 * @return The number of neighbors, i.e. the minimum of k and the number of points that are not excluded and close enough.
+	 * They are sorted by increasing distance.
+	 */
+	unsigned int findNearestNeighbors(const double* query, unsigned int k, int* resultIndices, double* squaredDistances,
+			const unsigned char* excluded = 0, double maxSquaredDistance = std::numeric_limits<double>::max()) const {
+		assert(query != 0);
+		KNearestSearch search;
+		search.query = query;
+		search.k = k;
+		search.count = 0;
+		search.resultIndices = resultIndices;
+		search.squaredDistances = squaredDistances;
+		search.excluded = excluded;
+		search.maxSquaredDistance = maxSquaredDistance;
+		if (k > 0 && !nodes.empty()) {
+			double offsets[3] = {0.0, 0.0, 0.0};
+			findNearestNeighbors(0, 0.0, offsets, &search);
+		}
+		return search.count;
+	}
+
+	/**
+	 * @brief Find all points within a radius around a query.
+	 * @param[in] query x, y and z of the query.
+	 * @param[in] radius Search radius (not squared).
+	 * @param[out] resultIndices Indices of all points with a distance <= radius. The order is not specified.
+	 * @param[out] squaredDistances Optional: the squared distance for every element of resultIndices.
+	 * @param[in] excluded Optional: one flag per point, points with a non-zero flag are skipped.
+	 */
+	void findNeighborsWithinRadius(const double* query, double radius, std::vector<int>* resultIndices, std::vector<double>* squaredDistances = 0,
+			const unsigned char* excluded = 0) const {
+		assert(query != 0);
+		assert(resultIndices != 0);
+		resultIndices->clear();
+		if (squaredDistances != 0) {
+			squaredDistances->clear();
+		}
+		if (radius < 0.0 || nodes.empty()) {
+			return;
+		}
+		double offsets[3] = {0.0, 0.0, 0.0};
+		findNeighborsWithinRadius(0, 0.0, offsets, query, radius * radius, resultIndices, squaredDistances, excluded);
+	}
+
+	/**
+	 * @brief Find all points within an axis aligned box.
+	 * @param[in] lowerBound x, y and z of the minimum corner.
+	 * @param[in] upperBound x, y and z of the maximum corner.
+	 * @param[out] resultIndices Indices of all points inside the box, including its border. The order is not specified.
+	 * @param[in] excluded Optional: one flag per point, points with a non-zero flag are skipped.
+	 */
+	void findPointsInBox(const double* lowerBound, const double* upperBound, std::vector<int>* resultIndices, const unsigned char* excluded = 0) const {
+		assert(lowerBound != 0);
+		assert(upperBound != 0);
+		assert(resultIndices != 0);
+		resultIndices->clear();
+		if (!nodes.empty()) {
+			findPointsInBox(0, lowerBound, upperBound, resultIndices, excluded);
+		}
+	}
+
+private:
+
+	struct Node {
+		/// Range of the points in indices.
+		unsigned int begin;
+		unsigned int end;
+		/// Split axis (0, 1 or 2) of an inner node, -1 for a leaf.
+		int axis;
+		/// Coordinate of the split plane. Points of the left child are <= split, points of the right child >= split.
+		double split;
+		/// Index of the right child. The left child is the next node.
+		unsigned int rightChild;
+	};
+
+	/// State of a k nearest neighbor search. The results are kept sorted by increasing distance.
+	struct KNearestSearch {
+		const double* query;
+		unsigned int k;
+		unsigned int count;
+		int* resultIndices;
+		double* squaredDistances;
+		const unsigned char* excluded;
+		double maxSquaredDistance;
+
+		/// Squared distance a point has to fall below to become a result.
+		double bound() const {
+			return (count == k) ? squaredDistances[k - 1] : maxSquaredDistance;
+		}
+	};
+
+	double coordinate(int index, int axis) const {
+		return (axis == 0) ? points.x(index) : ((axis == 1) ? points.y(index) : points.z(index));
+	}
+
+	double squaredDistance(const double* query, int index) const {
+		double dx = points.x(index) - query[0];
+		double dy = points.y(index) - query[1];
+		double dz = points.z(index) - query[2];
+		return dx * dx + dy * dy + dz * dz;
+	}
+
+	/// Number of nodes of a subtree with count points. Only O(log(count)) distinct sizes occur, so they are memorized.
+	unsigned int countNodes(unsigned int count, std::map<unsigned int, unsigned int>* numberOfNodes) const {
+		if (count <= leafSize) {
+			return 1;
+		}
+		std::map<unsigned int, unsigned int>::iterator known = numberOfNodes->find(count);
+		if (known != numberOfNodes->end()) {
+			return known->second;
+		}
+		unsigned int result = 1 + countNodes(count / 2, numberOfNodes) + countNodes(count - count / 2, numberOfNodes);
+		(*numberOfNodes)[count] = result;
+		return result;
+	}
+
+	/**
+	 * Build the subtree of the points [begin, end) into nodes[nodeIndex] and the following nodes.
+	 * numberOfNodes is only read here, as countNodes() has already visited all subtree sizes.
+	 * The median is selected on the pairs of coordinate and point index in keys[begin, end), so the coordinates
+	 * are read once per level rather than for every comparison. The leaves copy their point indices into indices.
+	 */
+	void buildNode(unsigned int nodeIndex, unsigned int begin, unsigned int end, const double* bounds, unsigned int numberOfThreads,
+			const std::map<unsigned int, unsigned int>* numberOfNodes, std::pair<double, int>* keys) {
+		Node& node = nodes[nodeIndex];
+		node.begin = begin;
+		node.end = end;
+		node.axis = -1;
+		node.split = 0.0;
+		node.rightChild = 0;
+		unsigned int count = end - begin;
+		if (count <= leafSize) {
+			for (unsigned int i = begin; i < end; ++i) {
+				indices[i] = keys[i].second;
+			}
+			return;
+		}
+
+		int axis = 0;
+		for (int i = 1; i < 3; ++i) {
+			if (bounds[3 + i] - bounds[i] > bounds[3 + axis] - bounds[axis]) {
+				axis = i;
+			}
+		}
+		unsigned int middle = begin + count / 2;
+		for (unsigned int i = begin; i < end; ++i) {
+			keys[i].first = coordinate(keys[i].second, axis);
+		}
+		std::nth_element(keys + begin, keys + middle, keys + end);
+
+		unsigned int leftCount = middle - begin;
+		unsigned int numberOfLeftNodes = (leftCount <= leafSize) ? 1 : numberOfNodes->find(leftCount)->second;
+		node.axis = axis;
+		node.split = keys[middle].first;
+		node.rightChild = nodeIndex + 1 + numberOfLeftNodes;
+
+		double leftBounds[6];
+		double rightBounds[6];
+		std::copy(bounds, bounds + 6, leftBounds);
+		std::copy(bounds, bounds + 6, rightBounds);
+		leftBounds[3 + axis] = node.split;
+		rightBounds[axis] = node.split;
+
+		if (numberOfThreads > 1 && count >= parallelThreshold) {
+			unsigned int rightThreads = numberOfThreads / 2;
+			boost::thread worker(boost::bind(&KDTree3D::buildNode, this, node.rightChild, middle, end, rightBounds, rightThreads, numberOfNodes, keys));
+			buildNode(nodeIndex + 1, begin, middle, leftBounds, numberOfThreads - rightThreads, numberOfNodes, keys);
+			worker.join();
+		} else {
+			buildNode(nodeIndex + 1, begin, middle, leftBounds, 1, numberOfNodes, keys);
+			buildNode(node.rightChild, middle, end, rightBounds, 1, numberOfNodes, keys);
+		}
+	}
+
+	/**
+	 * Search the subtree of a node. cellDistance is a lower bound of the squared distance between the query and
+	 * the cell of the node; offsets holds its contribution per axis, so it can be updated incrementally
+	 * when descending to the far child.
+	 */
+	void findNearestNeighbors(unsigned int nodeIndex, double cellDistance, double* offsets, KNearestSearch* search) const {
+		const Node& node = nodes[nodeIndex];
+		if (node.axis < 0) {
+			for (unsigned int i = node.begin; i < node.end; ++i) {
+				if (search->excluded != 0 && search->excluded[indices[i]] != 0) {
+					continue;
+				}
+				double distance = squaredDistance(search->query, indices[i]);
+				if (distance < search->bound()) {
+					insertNearestNeighbor(indices[i], distance, search->k, &search->count, search->resultIndices, search->squaredDistances);
+				}
+			}
+			return;
+		}
+
+		double difference = search->query[node.axis] - node.split;
+		unsigned int nearChild = (difference < 0.0) ? nodeIndex + 1 : node.rightChild;
+		unsigned int farChild = (difference < 0.0) ? node.rightChild : nodeIndex + 1;
+		findNearestNeighbors(nearChild, cellDistance, offsets, search);
+
+		double previousOffset = offsets[node.axis];
+		double farCellDistance = cellDistance - previousOffset * previousOffset + difference * difference;
+		if (farCellDistance < search->bound()) {
+			offsets[node.axis] = difference;
+			findNearestNeighbors(farChild, farCellDistance, offsets, search);
+			offsets[node.axis] = previousOffset;
+		}
+	}
+
+	/// Radius search in the subtree of a node. See findNearestNeighbors(unsigned int, double, double*, KNearestSearch*) for cellDistance and offsets.
+	void findNeighborsWithinRadius(unsigned int nodeIndex, double cellDistance, double* offsets, const double* query, double squaredRadius,
+			std::vector<int>* resultIndices, std::vector<double>* squaredDistances, const unsigned char* excluded) const {
+		const Node& node = nodes[nodeIndex];
+		if (node.axis < 0) {
+			for (unsigned int i = node.begin; i < node.end; ++i) {
+				if (excluded != 0 && excluded[indices[i]] != 0) {
+					continue;
+				}
+				double distance = squaredDistance(query, indices[i]);
+				if (distance <= squaredRadius) {
+					resultIndices->push_back(indices[i]);
+					if (squaredDistances != 0) {
+						squaredDistances->push_back(distance);
+					}
+				}
+			}
+			return;
+		}
+
+		double difference = query[node.axis] - node.split;
+		unsigned int nearChild = (difference < 0.0) ? nodeIndex + 1 : node.rightChild;
+		unsigned int farChild = (difference < 0.0) ? node.rightChild : nodeIndex + 1;
+		findNeighborsWithinRadius(nearChild, cellDistance, offsets, query, squaredRadius, resultIndices, squaredDistances, excluded);
+
+		double previousOffset = offsets[node.axis];
+		double farCellDistance = cellDistance - previousOffset * previousOffset + difference * difference;
+		if (farCellDistance <= squaredRadius) {
+			offsets[node.axis] = difference;
+			findNeighborsWithinRadius(farChild, farCellDistance, offsets, query, squaredRadius, resultIndices, squaredDistances, excluded);
+			offsets[node.axis] = previousOffset;
+		}
+	}
+
+	/// Box search in the subtree of a node. A child is only visited if the box reaches its side of the split plane.
+	void findPointsInBox(unsigned int nodeIndex, const double* lowerBound, const double* upperBound, std::vector<int>* resultIndices,
+			const unsigned char* excluded) const {
+		const Node& node = nodes[nodeIndex];
+		if (node.axis < 0) {
+			for (unsigned int i = node.begin; i < node.end; ++i) {
+				int index = indices[i];
+				if (excluded != 0 && excluded[index] != 0) {
+					continue;
+				}
+				double x = points.x(index);
+				double y = points.y(index);
+				double z = points.z(index);
+				if (x >= lowerBound[0] && x <= upperBound[0] && y >= lowerBound[1] && y <= upperBound[1] && z >= lowerBound[2] && z <= upperBound[2]) {
+					resultIndices->push_back(index);
+				}
+			}
+			return;
+		}
+
+		if (lowerBound[node.axis] <= node.split) {
+			findPointsInBox(nodeIndex + 1, lowerBound, upperBound, resultIndices, excluded);
+		}
+		if (upperBound[node.axis] >= node.split) {
+			findPointsInBox(node.rightChild, lowerBound, upperBound, resultIndices, excluded);
+		}
+	}
+
+	/// Maximum number of points in a leaf
+	unsigned int leafSize;
+
+	/// Access to the indexed points
+	AccessorT points;
+
+	/// Permutation of the point indices; every node refers to a range of it
+	std::vector<int> indices;
+
+	/// All nodes in depth first order, the root is the first one
+	std::vector<Node> nodes;
+};
+
+}
+
+#endif /* BRICS_3D_KDTREE3D_H_ */
+
+/* EOF */
@@ -18,6 +18,7 @@
 ******************************************************************************/
 
 #include "NearestNeighborANN.h"
+#include "NearestNeighborBatchQuery.h"
 #include <assert.h>
 #include <stdexcept>
 
@@ -25,10 +26,37 @@ using std::runtime_error;
 
 namespace brics_3d {
 
+namespace {
+
+/**
+ * Range search for a batch. ANNidx and ANNdist match the types of the result arrays, so annkSearch
+ * writes directly into the slots of the result.
+ */
+struct ANNBatchSearch {
+	ANNkd_tree* kdTree;
+	double eps;
+	double maxDistance;
+
+	void operator()(const NearestNeighborBatchQuery& queries, unsigned int begin, unsigned int end, unsigned int k, NearestNeighborBatchResult* result) {
+		ANNcoord queryPoint[3];
+		for (unsigned int i = begin; i < end; ++i) {
+			const Point3D& query = queries.getPoint(i);
+			queryPoint[0] = static_cast<ANNcoord>(query.getX());
+			queryPoint[1] = static_cast<ANNcoord>(query.getY());
+			queryPoint[2] = static_cast<ANNcoord>(query.getZ());
+			ANNidx* indices = &result->indices[i * k];
+			ANNdist* squaredDistances = &result->squaredDistances[i * k];
+			kdTree->annkSearch(queryPoint, static_cast<int>(k), indices, squaredDistances, eps);
+			result->offsets[i + 1] = NearestNeighborBatchQuery::applyMaxDistance(maxDistance, k, indices, squaredDistances);
+		}
+	}
+};
+
+}
+
 NearestNeighborANN::NearestNeighborANN() {
 	this->dimension = -1;
 	this->maxDistance = -1; //default = disable
-	k = 1;
 	eps	= 0;
 	maxPts = 1000;
 
@@ -114,102 +142,137 @@ void NearestNeighborANN::findNearestNeighbors(vector<float>* query, std::vector<
 }
 
 void NearestNeighborANN::findNearestNeighbors(vector<double>* query, std::vector<int>* resultIndices, unsigned int k) {
-	assert (query != 0);
 	assert (resultIndices != 0);
-//	assert (static_cast<int>(query->size()) == dimension);
-
-	if (static_cast<int>(query->size()) != dimension) {
-		throw runtime_error("Mismatch of query and data dimension.");
-	}
-	if (static_cast<int>(k) > kdTree->nPoints()) {
-		throw runtime_error("Number of neighbors k is bigger than the amount of data points.");
-	}
+	setQueryPoint(query);
+	findNearestNeighborsRaw(resultIndices, 0, k);
+}
 
-	this->k = static_cast<int>(k);
-	resultIndices->clear();
+void NearestNeighborANN::findNearestNeighbors(Point3D* query, std::vector<int>* resultIndices, unsigned int k) {
+	assert (resultIndices != 0);
+	setQueryPoint(query);
+	findNearestNeighborsRaw(resultIndices, 0, k);
+}
 
-	nnIndex = new ANNidx[k];					// allocate near neigh indices
-	distances = new ANNdist[k];					// allocate near neighbor distances
-	queryPoint = annAllocPt(dimension);			// allocate query point
+void NearestNeighborANN::findNearestNeighbors(vector<double>* query, std::vector<int>* resultIndices, std::vector<double>* squaredDistances, unsigned int k) {
+	assert (resultIndices != 0);
+	assert (squaredDistances != 0);
+	setQueryPoint(query);
+	findNearestNeighborsRaw(resultIndices, squaredDistances, k);
+}
 
-	for (int i = 0; i < dimension; ++i) {
-		queryPoint[i] = static_cast<ANNcoord>( (*query)[i] );
-	}
+void NearestNeighborANN::findNearestNeighbors(Point3D* query, std::vector<int>* resultIndices, std::vector<double>* squaredDistances, unsigned int k) {
+	assert (resultIndices != 0);
+	assert (squaredDistances != 0);
+	setQueryPoint(query);
+	findNearestNeighborsRaw(resultIndices, squaredDistances, k);
+}
 
-	kdTree->annkSearch(						// search
-			queryPoint,						// query point
-			this->k,							// number of near neighbors
-			nnIndex,						// nearest neighbors (returned)
-			distances,						// distance (returned)
-			eps);							// error bound
+void NearestNeighborANN::findNeighborsWithinRadius(vector<double>* query, double radius, std::vector<int>* resultIndices, std::vector<double>* squaredDistances) {
+	assert (resultIndices != 0);
+	setQueryPoint(query);
+	findNeighborsWithinRadiusRaw(radius, resultIndices, squaredDistances);
+}
 
-	brics_3d::Coordinate resultDistance; //distance has same data-type as Coordinate, although the meaning is different TODO: global distance typedef?
-	int resultIndex;
-	for (int i = 0; i < this->k; i++) {
-		resultDistance = static_cast<brics_3d::Coordinate>(sqrt(distances[i]));	//unsquare distance
-		resultIndex = nnIndex[i];
-		if (resultDistance <= maxDistance || maxDistance < 0.0) { //if max distance is < 0 then the distance should have no influence
-			resultIndices->push_back(resultIndex);
-		}
-	}
+void NearestNeighborANN::findNeighborsWithinRadius(Point3D* query, double radius, std::vector<int>* resultIndices, std::vector<double>* squaredDistances) {
+	assert (resultIndices != 0);
+	setQueryPoint(query);
+	findNeighborsWithinRadiusRaw(radius, resultIndices, squaredDistances);
+}
 
-	annDeallocPt(queryPoint);					// clean things up
-    delete [] nnIndex;
-    delete [] distances;
+void NearestNeighborANN::findNearestNeighbors(PointCloud3D* queries, NearestNeighborBatchResult* result, unsigned int k) {
+	findNearestNeighborsBatch(NearestNeighborBatchQuery(queries, 0), result, k);
+}
 
+void NearestNeighborANN::findNearestNeighbors(PointCloud3D* queries, const std::vector<int>& queryIndices, NearestNeighborBatchResult* result, unsigned int k) {
+	findNearestNeighborsBatch(NearestNeighborBatchQuery(queries, &queryIndices), result, k);
 }
 
-void NearestNeighborANN::findNearestNeighbors(Point3D* query, std::vector<int>* resultIndices, unsigned int k) {
-	assert (query != 0);
-	assert (resultIndices != 0);
+void NearestNeighborANN::findNearestNeighborsBatch(const NearestNeighborBatchQuery& queries, NearestNeighborBatchResult* result, unsigned int k) {
+	assert (result != 0);
 	assert (dimension == 3);
-
 	if (static_cast<int>(k) > kdTree->nPoints()) {
 		throw runtime_error("Number of neighbors k is bigger than the amount of data points.");
 	}
 
-	this->k = static_cast<int>(k);
-	resultIndices->clear();
+	ANNBatchSearch search;
+	search.kdTree = kdTree;
+	search.eps = eps;
+	search.maxDistance = maxDistance;
+	queries.process(search, k, maxNumberOfThreads, false, result); // ANN searches are not reentrant
+}
 
-	nnIndex = new ANNidx[k];					// allocate near neigh indices
-	distances = new ANNdist[k];					// allocate near neighbor distances
-	queryPoint = annAllocPt(dimension);			// allocate query point
+void NearestNeighborANN::setQueryPoint(vector<double>* query) {
+	assert (query != 0);
+	if (static_cast<int>(query->size()) != dimension) {
+		throw runtime_error("Mismatch of query and data dimension.");
+	}
+	queryPoint.assign(query->begin(), query->end());
+}
 
+void NearestNeighborANN::setQueryPoint(Point3D* query) {
+	assert (query != 0);
+	assert (dimension == 3);
+	queryPoint.resize(3);
 	queryPoint[0] = static_cast<ANNcoord>( query->getX() );
 	queryPoint[1] = static_cast<ANNcoord>( query->getY() );
 	queryPoint[2] = static_cast<ANNcoord>( query->getZ() );
+}
 
-	kdTree->annkSearch(						// search
-			queryPoint,						// query point
-			this->k,							// number of near neighbors
-			nnIndex,						// nearest neighbors (returned)
-			distances,						// distance (returned)
-			eps);							// error bound
-
-//	std::cout << "\tNN:\tIndex\tDistance\n";
-//	for (int i = 0; i < k; i++) {			// print summary
-//		distances[i] = sqrt(distances[i]);			// unsquare distance
-//		std::cout << "\t" << i << "\t" << nnIndex[i] << "\t" << distances[i] << "\n";
-//	}
+void NearestNeighborANN::findNearestNeighborsRaw(std::vector<int>* resultIndices, std::vector<double>* squaredDistances, unsigned int k) {
+	if (static_cast<int>(k) > kdTree->nPoints()) {
+		throw runtime_error("Number of neighbors k is bigger than the amount of data points.");
+	}
 
-	brics_3d::Coordinate resultDistance; //distance has same data-type as Coordinate, although the meaning is different TODO: global distance typedef?
-	int resultIndex;
-	for (int i = 0; i < this->k; i++) {
-		resultDistance = static_cast<brics_3d::Coordinate>(sqrt(distances[i]));	//unsquare distance
-		resultIndex = nnIndex[i];
+	resultIndices->clear();
+	if (squaredDistances != 0) {
+		squaredDistances->clear();
+	}
+	if (k == 0) {
+		return;
+	}
+	nnIndex.resize(k);
+	distances.resize(k);
 
-		if (resultDistance <= maxDistance || maxDistance < 0.0) { //if max distance is < 0 then the distance should have no influence
-			resultIndices->push_back(resultIndex);
+	kdTree->annkSearch(						// search
+			&queryPoint[0],					// query point
+			static_cast<int>(k),			// number of near neighbors
+			&nnIndex[0],					// nearest neighbors (returned)
+			&distances[0],					// squared distance (returned)
+			eps);							// error bound
 
+	for (unsigned int i = 0; i < k; i++) {
+		if (maxDistance < 0.0 || static_cast<brics_3d::Coordinate>(sqrt(distances[i])) <= maxDistance) { //if max distance is < 0 then the distance should have no influence
+			resultIndices->push_back(nnIndex[i]);
+			if (squaredDistances != 0) {
+				squaredDistances->push_back(distances[i]);
+			}
 		}
 	}
+}
 
+void NearestNeighborANN::findNeighborsWithinRadiusRaw(double radius, std::vector<int>* resultIndices, std::vector<double>* squaredDistances) {
+	resultIndices->clear();
+	if (squaredDistances != 0) {
+		squaredDistances->clear();
+	}
+	if (radius < 0.0) {
+		return;
+	}
+	ANNdist squaredRadius = static_cast<ANNdist>(radius * radius);
 
+	/* the first pass only counts the points, the second one retrieves exactly that many */
+	int count = kdTree->annkFRSearch(&queryPoint[0], squaredRadius, 0, 0, 0, eps);
+	if (count == 0) {
+		return;
+	}
+	nnIndex.resize(count);
+	distances.resize(count);
+	kdTree->annkFRSearch(&queryPoint[0], squaredRadius, count, &nnIndex[0], &distances[0], eps);
 
-	annDeallocPt(queryPoint);					// clean things up
-    delete [] nnIndex;
-    delete [] distances;
-
+	resultIndices->assign(nnIndex.begin(), nnIndex.begin() + count);
+	if (squaredDistances != 0) {
+		squaredDistances->assign(distances.begin(), distances.begin() + count);
+	}
 }
 
 }
@@ -28,6 +28,8 @@
 
 namespace brics_3d {
 
+class NearestNeighborBatchQuery;
+
 /**
  * @ingroup nearestNeighbor
  * @brief Implementation for the nearest neighbor search algorithm with the ANN library.
@@ -57,10 +59,36 @@ public:
 	void findNearestNeighbors(vector<double>* query, std::vector<int>* resultIndices, unsigned int k = 1);
 	void findNearestNeighbors(Point3D* query, std::vector<int>* resultIndices, unsigned int k = 1);
 
+	void findNearestNeighbors(vector<double>* query, std::vector<int>* resultIndices, std::vector<double>* squaredDistances, unsigned int k);
+	void findNearestNeighbors(Point3D* query, std::vector<int>* resultIndices, std::vector<double>* squaredDistances, unsigned int k);
+
+	/**
+	 * @brief Batch query. ANN keeps the state of a search in global variables, so the batch is
+	 * processed by the calling thread. The results are written directly into the result arrays.
+	 */
+	void findNearestNeighbors(PointCloud3D* queries, NearestNeighborBatchResult* result, unsigned int k = 1);
+	void findNearestNeighbors(PointCloud3D* queries, const std::vector<int>& queryIndices, NearestNeighborBatchResult* result, unsigned int k = 1);
+
+	/**
+	 * @brief Radius search based on the native fixed-radius search of ANN (annkFRSearch).
+	 */
+	void findNeighborsWithinRadius(vector<double>* query, double radius, std::vector<int>* resultIndices, std::vector<double>* squaredDistances = 0);
+	void findNeighborsWithinRadius(Point3D* query, double radius, std::vector<int>* resultIndices, std::vector<double>* squaredDistances = 0);
+
 private:
 
-	/// number of nearest neighbors
-	int k;
+	/// Copy a query into queryPoint. Throws if the dimension does not match the data.
+	void setQueryPoint(vector<double>* query);
+	void setQueryPoint(Point3D* query);
+
+	/// k nearest neighbor search for queryPoint.
+	void findNearestNeighborsRaw(std::vector<int>* resultIndices, std::vector<double>* squaredDistances, unsigned int k);
+
+	/// Fixed-radius search for queryPoint.
+	void findNeighborsWithinRadiusRaw(double radius, std::vector<int>* resultIndices, std::vector<double>* squaredDistances);
+
+	/// Common part of both batch queries.
+	void findNearestNeighborsBatch(const NearestNeighborBatchQuery& queries, NearestNeighborBatchResult* result, unsigned int k);
 
 	/// error bound
 	double eps;
@@ -71,14 +99,14 @@ private:
 	/// data points
 	ANNpointArray dataPoints;
 
-	/// query point
-	ANNpoint queryPoint;
+	/// query point, reused for all queries
+	std::vector<ANNcoord> queryPoint;
 
-	/// near neighbor indices
-	ANNidxArray nnIndex;
+	/// near neighbor indices, reused for all queries
+	std::vector<ANNidx> nnIndex;
 
-	/// near neighbor distances
-	ANNdistArray distances;
+	/// near neighbor squared distances, reused for all queries
+	std::vector<ANNdist> distances;
 
 	/// search structure
 	ANNkd_tree* kdTree;
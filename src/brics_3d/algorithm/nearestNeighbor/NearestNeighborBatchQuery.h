@@ -0,0 +1,179 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+
+#ifndef BRICS_3D_NEARESTNEIGHBORBATCHQUERY_H_
+#define BRICS_3D_NEARESTNEIGHBORBATCHQUERY_H_
+
+#include "brics_3d/algorithm/nearestNeighbor/NearestNeighborBatchResult.h"
+#include "brics_3d/core/PointCloud3D.h"
+#include "brics_3d/core/ParallelProcessing.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+
+namespace brics_3d {
+
+/**
+ * @ingroup nearestNeighbor
+ * @brief Query points of a batch of nearest neighbor queries and their common processing.
+ *
+ * This is a helper for the implementations of INearestPoint3DNeighbor. A batch is split into ranges
+ * of queries that are processed by a range search of the respective library. A range search writes the
+ * (at most k) neighbors of query i into the slot [i*k, (i+1)*k) of the result and their number into
+ * offsets[i+1]. Once all ranges are done the slots are compacted into the final layout of
+ * NearestNeighborBatchResult, so no per query containers are allocated.
+ */
+class NearestNeighborBatchQuery {
+public:
+
+	/// Threshold for ParallelProcessing::getNumberOfThreads().
+	static const unsigned int parallelThreshold = 1000;
+
+	/**
+	 * @brief Constructor.
+	 * @param queries The query points.
+	 * @param queryIndices Optional subset of the query points. If null, all points are queried.
+	 * Throws a runtime_error if an index is out of range.
+	 */
+	NearestNeighborBatchQuery(PointCloud3D* queries, const std::vector<int>* queryIndices) {
+		assert(queries != 0);
+		this->points = queries->getPointCloud();
+		this->queryIndices = queryIndices;
+		if (queryIndices != 0) {
+			int numberOfPoints = static_cast<int>(points->size());
+			for (unsigned int i = 0; i < queryIndices->size(); ++i) {
+				if ((*queryIndices)[i] < 0 || (*queryIndices)[i] >= numberOfPoints) {
+					throw std::runtime_error("Query index is out of range.");
+				}
+			}
+		}
+	}
+
+	unsigned int getSize() const {
+		return static_cast<unsigned int>((queryIndices != 0) ? queryIndices->size() : points->size());
+	}
+
+	const Point3D& getPoint(unsigned int query) const {
+		return (queryIndices != 0) ? (*points)[(*queryIndices)[query]] : (*points)[query];
+	}
+
+	/**
+	 * @brief Remove the neighbors that exceed maxDistance while preserving the order.
+	 * @param maxDistance Maximum distance (not squared). A value < 0 disables the check.
+	 * @return The number of remaining neighbors.
+	 */
+	static unsigned int applyMaxDistance(double maxDistance, unsigned int count, int* indices, double* squaredDistances) {
+		if (maxDistance < 0.0) {
+			return count;
+		}
+		unsigned int remaining = 0;
+		for (unsigned int i = 0; i < count; ++i) {
+			if (static_cast<brics_3d::Coordinate>(std::sqrt(squaredDistances[i])) <= maxDistance) {
+				indices[remaining] = indices[i];
+				squaredDistances[remaining] = squaredDistances[i];
+				remaining++;
+			}
+		}
+		return remaining;
+	}
+
+	/**
+	 * @brief Run a range search over all queries and compact the result.
+	 *
+	 * The range search is a functor with the signature
+	 * <code>void (const NearestNeighborBatchQuery& queries, unsigned int begin, unsigned int end, unsigned int k, NearestNeighborBatchResult* result)</code>.
+	 * Every thread works on its own copy of it, so it may hold buffers.
+	 * @param search The range search.
+	 * @param k Number of neighbors per query.
+	 * @param maxNumberOfThreads Upper limit, see ParallelProcessing::getNumberOfThreads().
+	 * @param supportsConcurrentQueries If false, all queries are processed by the calling thread.
+	 * @param[out] result The neighbors of all queries.
+	 */
+	template <typename RangeSearchT>
+	void process(RangeSearchT search, unsigned int k, unsigned int maxNumberOfThreads, bool supportsConcurrentQueries, NearestNeighborBatchResult* result) const {
+		assert(result != 0);
+		unsigned int count = getSize();
+		if (k > 0 && count > std::numeric_limits<unsigned int>::max() / k) {
+			throw std::runtime_error("Too many neighbors requested for a single batch.");
+		}
+		result->offsets.assign(count + 1, 0);
+		result->indices.resize(count * k);
+		result->squaredDistances.resize(count * k);
+		if (count == 0 || k == 0) {
+			result->indices.clear();
+			result->squaredDistances.clear();
+			return;
+		}
+
+		unsigned int numberOfThreads = 1;
+		if (supportsConcurrentQueries) {
+			numberOfThreads = ParallelProcessing::getNumberOfThreads(count, parallelThreshold, maxNumberOfThreads);
+		}
+		unsigned int chunkSize = count / numberOfThreads;
+
+		/* every thread writes the slots of its own range; the last range is processed by the calling thread */
+		boost::thread_group workers;
+		for (unsigned int i = 0; i < numberOfThreads - 1; ++i) {
+			workers.create_thread(boost::bind(&processRange<RangeSearchT>, search, this, i * chunkSize, (i + 1) * chunkSize, k, result));
+		}
+		processRange(search, this, (numberOfThreads - 1) * chunkSize, count, k, result);
+		workers.join_all();
+
+		/* move the slots together; offsets[i] is final once query i-1 is moved */
+		for (unsigned int i = 0; i < count; ++i) {
+			unsigned int numberOfNeighbors = result->offsets[i + 1];
+			unsigned int source = i * k;
+			unsigned int target = result->offsets[i];
+			if (target != source) {
+				for (unsigned int j = 0; j < numberOfNeighbors; ++j) {
+					result->indices[target + j] = result->indices[source + j];
+					result->squaredDistances[target + j] = result->squaredDistances[source + j];
+				}
+			}
+			result->offsets[i + 1] = target + numberOfNeighbors;
+		}
+		result->indices.resize(result->offsets[count]);
+		result->squaredDistances.resize(result->offsets[count]);
+	}
+
+private:
+
+	template <typename RangeSearchT>
+	static void processRange(RangeSearchT search, const NearestNeighborBatchQuery* queries, unsigned int begin, unsigned int end, unsigned int k, NearestNeighborBatchResult* result) {
+		search(*queries, begin, end, k, result);
+	}
+
+	/// All query points
+	boost::ptr_vector<Point3D>* points;
+
+	/// Optional subset of the query points
+	const std::vector<int>* queryIndices;
+};
+
+}
+
+#endif /* BRICS_3D_NEARESTNEIGHBORBATCHQUERY_H_ */
+
+/* EOF */
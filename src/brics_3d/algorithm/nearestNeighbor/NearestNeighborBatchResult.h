@@ -0,0 +1,70 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+
+#ifndef BRICS_3D_NEARESTNEIGHBORBATCHRESULT_H_
+#define BRICS_3D_NEARESTNEIGHBORBATCHRESULT_H_
+
+#include <vector>
+
+namespace brics_3d {
+
+/**
+ * @ingroup nearestNeighbor
+ * @brief Results of a batch of nearest neighbor queries in a flat (CSR-like) layout.
+ *
+ * The neighbors of query i are stored in indices[offsets[i]] ... indices[offsets[i+1]-1], the squared
+ * distances in the same range of squaredDistances. offsets has one element more than there are queries.
+ * The containers are reused by subsequent queries, so a result object should be kept alive across frames.
+ */
+struct NearestNeighborBatchResult {
+
+	/// Start of the neighbors of every query, followed by the total number of neighbors.
+	std::vector<unsigned int> offsets;
+
+	/// Neighbor indices with respect to the data of the search.
+	std::vector<int> indices;
+
+	/// Squared distance for every element of indices.
+	std::vector<double> squaredDistances;
+
+	unsigned int getNumberOfQueries() const {
+		return offsets.empty() ? 0 : static_cast<unsigned int>(offsets.size() - 1);
+	}
+
+	unsigned int getNumberOfNeighbors(unsigned int query) const {
+		return offsets[query + 1] - offsets[query];
+	}
+
+	/// Indices of the neighbors of a query. Only valid if getNumberOfNeighbors(query) > 0.
+	const int* getIndices(unsigned int query) const {
+		return &indices[offsets[query]];
+	}
+
+	/// Squared distances of the neighbors of a query. Only valid if getNumberOfNeighbors(query) > 0.
+	const double* getSquaredDistances(unsigned int query) const {
+		return &squaredDistances[offsets[query]];
+	}
+};
+
+}
+
+#endif /* BRICS_3D_NEARESTNEIGHBORBATCHRESULT_H_ */
+
+/* EOF */
@@ -0,0 +1,409 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+
+#include "NearestNeighborDynamicKDTree.h"
+#include "NearestNeighborBatchQuery.h"
+
+#include <assert.h>
+#include <limits>
+#include <stdexcept>
+
+using std::runtime_error;
+
+namespace brics_3d {
+
+/// Range search for a batch. Every thread works on its own copy, so the scratch space is not shared.
+struct NearestNeighborDynamicKDTree::BatchSearch {
+	const NearestNeighborDynamicKDTree* forest;
+	double maxDistance;
+	std::vector<int> candidateIndices;
+	std::vector<double> candidateDistances;
+
+	void operator()(const NearestNeighborBatchQuery& queries, unsigned int begin, unsigned int end, unsigned int k, NearestNeighborBatchResult* result) {
+		double queryPoint[3];
+		for (unsigned int i = begin; i < end; ++i) {
+			const Point3D& query = queries.getPoint(i);
+			queryPoint[0] = query.getX();
+			queryPoint[1] = query.getY();
+			queryPoint[2] = query.getZ();
+			int* indices = &result->indices[i * k];
+			double* squaredDistances = &result->squaredDistances[i * k];
+			unsigned int count = forest->findNearestNeighbors(queryPoint, k, indices, squaredDistances, &candidateIndices, &candidateDistances);
+			result->offsets[i + 1] = NearestNeighborBatchQuery::applyMaxDistance(maxDistance, count, indices, squaredDistances);
+		}
+	}
+};
+
+NearestNeighborDynamicKDTree::NearestNeighborDynamicKDTree(unsigned int leafSize, unsigned int bufferSize) {
+	this->dimension = 3;
+	this->maxDistance = -1; //default = disable
+	setLeafSize(leafSize);
+	if (bufferSize == 0) {
+		throw runtime_error("The buffer size has to be at least 1.");
+	}
+	this->bufferSize = bufferSize;
+	nextId = 0;
+	size = 0;
+}
+
+NearestNeighborDynamicKDTree::~NearestNeighborDynamicKDTree() {
+	clear();
+}
+
+void NearestNeighborDynamicKDTree::clear() {
+	for (unsigned int level = 0; level < levels.size(); ++level) {
+		delete levels[level];
+	}
+	levels.clear();
+	bufferCoordinates.clear();
+	bufferIds.clear();
+	nextId = 0;
+	size = 0;
+}
+
+void NearestNeighborDynamicKDTree::setData(PointCloud3D* data) {
+	assert(data != 0);
+	clear();
+	insertPoints(data);
+}
+
+int NearestNeighborDynamicKDTree::insertPoint(const Point3D& point) {
+	int id = nextId++;
+	bufferCoordinates.push_back(point.getX());
+	bufferCoordinates.push_back(point.getY());
+	bufferCoordinates.push_back(point.getZ());
+	bufferIds.push_back(id);
+	size++;
+	if (bufferIds.size() >= bufferSize) {
+		flushBuffer();
+	}
+	return id;
+}
+
+int NearestNeighborDynamicKDTree::insertPoints(PointCloud3D* points) {
+	assert(points != 0);
+	int firstId = nextId;
+	unsigned int count = points->getSize();
+	bufferCoordinates.reserve(bufferCoordinates.size() + 3 * count);
+	bufferIds.reserve(bufferIds.size() + count);
+	for (unsigned int i = 0; i < count; ++i) {
+		const Point3D& point = (*points->getPointCloud())[i];
+		bufferCoordinates.push_back(point.getX());
+		bufferCoordinates.push_back(point.getY());
+		bufferCoordinates.push_back(point.getZ());
+		bufferIds.push_back(nextId++);
+	}
+	size += count;
+
+	/* a large set of points goes directly to a level that is big enough, so it is built only once */
+	if (bufferIds.size() >= bufferSize) {
+		flushBuffer();
+	}
+	return firstId;
+}
+
+void NearestNeighborDynamicKDTree::flushBuffer() {
+	unsigned int count = static_cast<unsigned int>(bufferIds.size());
+	unsigned int level = 0;
+	double capacity = bufferSize; // double, as bufferSize * 2^level may exceed the range of unsigned int
+	while (true) {
+		if (level == levels.size()) {
+			levels.push_back(0);
+		}
+		if (levels[level] == 0 && count <= capacity) {
+			break;
+		}
+		if (levels[level] != 0) {
+			count += levels[level]->points.getSize() - levels[level]->numberOfRemovedPoints;
+		}
+		level++;
+		capacity *= 2.0;
+	}
+
+	std::vector<Coordinate> x;
+	std::vector<Coordinate> y;
+	std::vector<Coordinate> z;
+	std::vector<int> ids;
+	x.reserve(count);
+	y.reserve(count);
+	z.reserve(count);
+	ids.reserve(count);
+	for (unsigned int i = 0; i < bufferIds.size(); ++i) {
+		x.push_back(bufferCoordinates[3 * i]);
+		y.push_back(bufferCoordinates[3 * i + 1]);
+		z.push_back(bufferCoordinates[3 * i + 2]);
+	}
+	ids.insert(ids.end(), bufferIds.begin(), bufferIds.end());
+	bufferCoordinates.clear();
+	bufferIds.clear();
+
+	for (unsigned int i = 0; i < level; ++i) {
+		if (levels[i] != 0) {
+			collectPoints(*levels[i], &x, &y, &z, &ids);
+			delete levels[i];
+			levels[i] = 0;
+		}
+	}
+	levels[level] = createTree(x, y, z, ids);
+}
+
+NearestNeighborDynamicKDTree::Tree* NearestNeighborDynamicKDTree::createTree(std::vector<Coordinate>& x, std::vector<Coordinate>& y,
+		std::vector<Coordinate>& z, std::vector<int>& ids) {
+	Tree* tree = new Tree();
+	tree->points.adoptCoordinates(x, y, z);
+	tree->ids.swap(ids);
+	tree->removed.assign(tree->ids.size(), 0);
+	tree->numberOfRemovedPoints = 0;
+	tree->index.setLeafSize(leafSize);
+	tree->index.build(PointCloud3DContiguousAdaptor<Coordinate>(&tree->points), maxNumberOfThreads);
+	return tree;
+}
+
+void NearestNeighborDynamicKDTree::collectPoints(const Tree& tree, std::vector<Coordinate>* x, std::vector<Coordinate>* y,
+		std::vector<Coordinate>* z, std::vector<int>* ids) {
+	const Coordinate* xCoordinates = tree.points.getXCoordinates();
+	const Coordinate* yCoordinates = tree.points.getYCoordinates();
+	const Coordinate* zCoordinates = tree.points.getZCoordinates();
+	for (unsigned int i = 0; i < tree.ids.size(); ++i) {
+		if (tree.removed[i] == 0) {
+			x->push_back(xCoordinates[i]);
+			y->push_back(yCoordinates[i]);
+			z->push_back(zCoordinates[i]);
+			ids->push_back(tree.ids[i]);
+		}
+	}
+}
+
+unsigned int NearestNeighborDynamicKDTree::removePointsInBox(const Point3D& lowerBound, const Point3D& upperBound) {
+	const double lower[3] = {lowerBound.getX(), lowerBound.getY(), lowerBound.getZ()};
+	const double upper[3] = {upperBound.getX(), upperBound.getY(), upperBound.getZ()};
+	unsigned int removedCount = 0;
+
+	/* the buffer is small, so its points are removed right away */
+	unsigned int bufferCount = 0;
+	for (unsigned int i = 0; i < bufferIds.size(); ++i) {
+		const double* point = &bufferCoordinates[3 * i];
+		if (point[0] >= lower[0] && point[0] <= upper[0] && point[1] >= lower[1] && point[1] <= upper[1] && point[2] >= lower[2] && point[2] <= upper[2]) {
+			removedCount++;
+			continue;
+		}
+		bufferCoordinates[3 * bufferCount] = point[0];
+		bufferCoordinates[3 * bufferCount + 1] = point[1];
+		bufferCoordinates[3 * bufferCount + 2] = point[2];
+		bufferIds[bufferCount] = bufferIds[i];
+		bufferCount++;
+	}
+	bufferCoordinates.resize(3 * bufferCount);
+	bufferIds.resize(bufferCount);
+
+	std::vector<int> inside;
+	for (unsigned int level = 0; level < levels.size(); ++level) {
+		Tree* tree = levels[level];
+		if (tree == 0) {
+			continue;
+		}
+		tree->index.findPointsInBox(lower, upper, &inside, &tree->removed[0]);
+		for (unsigned int i = 0; i < inside.size(); ++i) {
+			tree->removed[inside[i]] = 1;
+		}
+		tree->numberOfRemovedPoints += static_cast<unsigned int>(inside.size());
+		removedCount += static_cast<unsigned int>(inside.size());
+
+		/* rebuild the tree when it is mostly made up of removed points */
+		if (2 * tree->numberOfRemovedPoints > tree->ids.size()) {
+			std::vector<Coordinate> x;
+			std::vector<Coordinate> y;
+			std::vector<Coordinate> z;
+			std::vector<int> ids;
+			collectPoints(*tree, &x, &y, &z, &ids);
+			delete tree;
+			levels[level] = ids.empty() ? 0 : createTree(x, y, z, ids);
+		}
+	}
+	size -= removedCount;
+	return removedCount;
+}
+
+unsigned int NearestNeighborDynamicKDTree::getSize() const {
+	return size;
+}
+
+unsigned int NearestNeighborDynamicKDTree::getNumberOfTrees() const {
+	unsigned int count = 0;
+	for (unsigned int level = 0; level < levels.size(); ++level) {
+		if (levels[level] != 0) {
+			count++;
+		}
+	}
+	return count;
+}
+
+unsigned int NearestNeighborDynamicKDTree::findNearestNeighbors(const double* query, unsigned int k, int* resultIndices, double* squaredDistances,
+		std::vector<int>* candidateIndices, std::vector<double>* candidateDistances) const {
+	unsigned int count = 0;
+	if (k == 0) {
+		return count;
+	}
+
+	/*
+	 * The biggest tree comes first. The k-th distance found so far bounds the searches on the smaller trees,
+	 * so they are mostly pruned at their upper nodes.
+	 */
+	candidateIndices->resize(k);
+	candidateDistances->resize(k);
+	for (unsigned int level = static_cast<unsigned int>(levels.size()); level > 0; --level) {
+		const Tree* tree = levels[level - 1];
+		if (tree == 0) {
+			continue;
+		}
+		double bound = (count == k) ? squaredDistances[k - 1] : std::numeric_limits<double>::max();
+		unsigned int candidateCount = tree->index.findNearestNeighbors(query, k, &(*candidateIndices)[0], &(*candidateDistances)[0], &tree->removed[0], bound);
+		for (unsigned int i = 0; i < candidateCount; ++i) {
+			/* the candidates are sorted, so none of the following ones fits either */
+			if (!insertNearestNeighbor(tree->ids[(*candidateIndices)[i]], (*candidateDistances)[i], k, &count, resultIndices, squaredDistances)) {
+				break;
+			}
+		}
+	}
+
+	for (unsigned int i = 0; i < bufferIds.size(); ++i) {
+		const double* point = &bufferCoordinates[3 * i];
+		double dx = point[0] - query[0];
+		double dy = point[1] - query[1];
+		double dz = point[2] - query[2];
+		insertNearestNeighbor(bufferIds[i], dx * dx + dy * dy + dz * dz, k, &count, resultIndices, squaredDistances);
+	}
+	return count;
+}
+
+void NearestNeighborDynamicKDTree::findNearestNeighbors(Point3D* query, std::vector<int>* resultIndices, unsigned int k) {
+	std::vector<double> squaredDistances;
+	findNearestNeighbors(query, resultIndices, &squaredDistances, k);
+}
+
+void NearestNeighborDynamicKDTree::findNearestNeighbors(Point3D* query, std::vector<int>* resultIndices, std::vector<double>* squaredDistances, unsigned int k) {
+	assert (query != 0);
+	assert (resultIndices != 0);
+	assert (squaredDistances != 0);
+	if (k > size) {
+		throw runtime_error("Number of neighbors k is bigger than the amount of data points.");
+	}
+
+	resultIndices->resize(k);
+	squaredDistances->resize(k);
+	if (k == 0) {
+		return;
+	}
+
+	double queryPoint[3] = {query->getX(), query->getY(), query->getZ()};
+	std::vector<int> candidateIndices;
+	std::vector<double> candidateDistances;
+	unsigned int count = findNearestNeighbors(queryPoint, k, &(*resultIndices)[0], &(*squaredDistances)[0], &candidateIndices, &candidateDistances);
+	count = NearestNeighborBatchQuery::applyMaxDistance(maxDistance, count, &(*resultIndices)[0], &(*squaredDistances)[0]);
+	resultIndices->resize(count);
+	squaredDistances->resize(count);
+}
+
+void NearestNeighborDynamicKDTree::findNeighborsWithinRadius(Point3D* query, double radius, std::vector<int>* resultIndices, std::vector<double>* squaredDistances) {
+	assert (query != 0);
+	assert (resultIndices != 0);
+	resultIndices->clear();
+	if (squaredDistances != 0) {
+		squaredDistances->clear();
+	}
+	if (radius < 0.0) {
+		return;
+	}
+
+	double queryPoint[3] = {query->getX(), query->getY(), query->getZ()};
+	double squaredRadius = radius * radius;
+	for (unsigned int i = 0; i < bufferIds.size(); ++i) {
+		const double* point = &bufferCoordinates[3 * i];
+		double dx = point[0] - queryPoint[0];
+		double dy = point[1] - queryPoint[1];
+		double dz = point[2] - queryPoint[2];
+		double distance = dx * dx + dy * dy + dz * dz;
+		if (distance <= squaredRadius) {
+			resultIndices->push_back(bufferIds[i]);
+			if (squaredDistances != 0) {
+				squaredDistances->push_back(distance);
+			}
+		}
+	}
+
+	std::vector<int> treeIndices;
+	std::vector<double> treeDistances;
+	for (unsigned int level = 0; level < levels.size(); ++level) {
+		const Tree* tree = levels[level];
+		if (tree == 0) {
+			continue;
+		}
+		tree->index.findNeighborsWithinRadius(queryPoint, radius, &treeIndices, (squaredDistances != 0) ? &treeDistances : 0, &tree->removed[0]);
+		for (unsigned int i = 0; i < treeIndices.size(); ++i) {
+			resultIndices->push_back(tree->ids[treeIndices[i]]);
+		}
+		if (squaredDistances != 0) {
+			squaredDistances->insert(squaredDistances->end(), treeDistances.begin(), treeDistances.end());
+		}
+	}
+}
+
+void NearestNeighborDynamicKDTree::findNearestNeighbors(PointCloud3D* queries, NearestNeighborBatchResult* result, unsigned int k) {
+	findNearestNeighborsBatch(NearestNeighborBatchQuery(queries, 0), result, k);
+}
+
+void NearestNeighborDynamicKDTree::findNearestNeighbors(PointCloud3D* queries, const std::vector<int>& queryIndices, NearestNeighborBatchResult* result, unsigned int k) {
+	findNearestNeighborsBatch(NearestNeighborBatchQuery(queries, &queryIndices), result, k);
+}
+
+void NearestNeighborDynamicKDTree::findNearestNeighborsBatch(const NearestNeighborBatchQuery& queries, NearestNeighborBatchResult* result, unsigned int k) {
+	assert (result != 0);
+	if (k > size) {
+		throw runtime_error("Number of neighbors k is bigger than the amount of data points.");
+	}
+
+	BatchSearch search;
+	search.forest = this;
+	search.maxDistance = maxDistance;
+	queries.process(search, k, maxNumberOfThreads, true, result);
+}
+
+bool NearestNeighborDynamicKDTree::supportsConcurrentQueries() const {
+	return true;
+}
+
+void NearestNeighborDynamicKDTree::setLeafSize(unsigned int leafSize) {
+	if (leafSize == 0) {
+		throw runtime_error("The leaf size has to be at least 1.");
+	}
+	this->leafSize = leafSize;
+}
+
+unsigned int NearestNeighborDynamicKDTree::getLeafSize() const {
+	return leafSize;
+}
+
+unsigned int NearestNeighborDynamicKDTree::getBufferSize() const {
+	return bufferSize;
+}
+
+}
+
+/* EOF */
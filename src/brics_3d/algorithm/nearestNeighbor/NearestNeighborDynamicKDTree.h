@@ -0,0 +1,190 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+
+#ifndef BRICS_3D_NEARESTNEIGHBORDYNAMICKDTREE_H_
+#define BRICS_3D_NEARESTNEIGHBORDYNAMICKDTREE_H_
+
+#include "brics_3d/algorithm/nearestNeighbor/INearestPoint3DNeighbor.h"
+#include "brics_3d/algorithm/nearestNeighbor/INearestNeighborSetup.h"
+#include "brics_3d/algorithm/nearestNeighbor/KDTree3D.h"
+#include "brics_3d/core/PointCloud3DContiguous.h"
+
+namespace brics_3d {
+
+class NearestNeighborBatchQuery;
+
+/**
+ * @ingroup nearestNeighbor
+ * @brief Nearest neighbor search on a point set that grows and shrinks, e.g. a map that is built from a stream of scans.
+ *
+ * The points are held in a logarithmic forest of KDTree3D trees (Bentley-Saxe method): new points are
+ * collected in a small buffer. When the buffer is full, it is merged with all trees of the lowest
+ * consecutive levels into one new tree. The tree of level j has at most getBufferSize() * 2^j points,
+ * so there are O(log(n)) trees and every point is rebuilt O(log(n)) times, i.e. an insertion costs
+ * amortized O(log(n)^2) and a query O(log(n)^2).
+ *
+ * Removed points are only flagged in their tree and skipped by the queries. A tree is rebuilt from its
+ * remaining points as soon as more than half of its points are removed.
+ *
+ * Every point keeps the id it was given on insertion, the results of the queries are these ids.
+ * The ids are consecutive, starting at 0 after setData() or clear(). Thus after setData() the ids are the indices
+ * into the point cloud, as for the other implementations. Ids of removed points are not reused.
+ *
+ * The points are copied. The queries may be issued concurrently, as long as no points are inserted or removed at the same time.
+ */
+class NearestNeighborDynamicKDTree : public INearestPoint3DNeighbor, public INearestNeighborSetup {
+public:
+
+	/// Default number of points that are collected before they are inserted into the trees.
+	static const unsigned int defaultBufferSize = 256;
+
+	/**
+	 * @brief Standard constructor
+	 * @param leafSize Maximum number of points in a leaf of the trees.
+	 * @param bufferSize Number of points that are collected before they are inserted into the trees.
+	 */
+	NearestNeighborDynamicKDTree(unsigned int leafSize = KDTree3D<PointCloud3DContiguousAdaptor<Coordinate> >::defaultLeafSize,
+			unsigned int bufferSize = defaultBufferSize);
+
+	/**
+	 * @brief Standard destructor
+	 */
+	virtual ~NearestNeighborDynamicKDTree();
+
+	/**
+	 * @brief Replace all points by the points of a point cloud. The ids equal the indices into the point cloud.
+	 */
+	void setData(PointCloud3D* data);
+
+	/**
+	 * @brief Insert a single point.
+	 * @return The id of the point.
+	 */
+	int insertPoint(const Point3D& point);
+
+	/**
+	 * @brief Insert all points of a point cloud.
+	 * @return The id of the first point. The following points have consecutive ids.
+	 */
+	int insertPoints(PointCloud3D* points);
+
+	/**
+	 * @brief Remove all points within an axis aligned box, including its border.
+	 * @param lowerBound Minimum corner of the box.
+	 * @param upperBound Maximum corner of the box.
+	 * @return Number of removed points.
+	 */
+	unsigned int removePointsInBox(const Point3D& lowerBound, const Point3D& upperBound);
+
+	/**
+	 * @brief Remove all points. The ids start at 0 again.
+	 */
+	void clear();
+
+	/// Number of points that are currently indexed.
+	unsigned int getSize() const;
+
+	/// Number of trees in the forest, not counting the insertion buffer.
+	unsigned int getNumberOfTrees() const;
+
+	void findNearestNeighbors(Point3D* query, std::vector<int>* resultIndices, unsigned int k = 1);
+	void findNearestNeighbors(Point3D* query, std::vector<int>* resultIndices, std::vector<double>* squaredDistances, unsigned int k);
+	void findNeighborsWithinRadius(Point3D* query, double radius, std::vector<int>* resultIndices, std::vector<double>* squaredDistances = 0);
+
+	/**
+	 * @brief Batch query. The queries are distributed over multiple threads.
+	 */
+	void findNearestNeighbors(PointCloud3D* queries, NearestNeighborBatchResult* result, unsigned int k = 1);
+	void findNearestNeighbors(PointCloud3D* queries, const std::vector<int>& queryIndices, NearestNeighborBatchResult* result, unsigned int k = 1);
+
+	/**
+	 * @brief The queries only use local state.
+	 */
+	bool supportsConcurrentQueries() const;
+
+	/**
+	 * @brief Maximum number of points in a leaf of the trees. Takes effect for trees that are built afterwards.
+	 */
+	void setLeafSize(unsigned int leafSize);
+
+	unsigned int getLeafSize() const;
+
+	unsigned int getBufferSize() const;
+
+private:
+
+	/// One tree of the forest. It owns the points, their ids and the flags for the removed points.
+	struct Tree {
+		PointCloud3DContiguous points;
+		std::vector<int> ids;
+		std::vector<unsigned char> removed;
+		unsigned int numberOfRemovedPoints;
+		KDTree3D<PointCloud3DContiguousAdaptor<Coordinate> > index;
+	};
+
+	/// Range search for a batch, defined in the implementation file.
+	struct BatchSearch;
+
+	/// Insert the buffer into the forest. It is merged with the trees of all levels below the first free level that can hold them.
+	void flushBuffer();
+
+	/// Build a tree from the coordinate columns and the ids. The vectors are swapped into the tree.
+	Tree* createTree(std::vector<Coordinate>& x, std::vector<Coordinate>& y, std::vector<Coordinate>& z, std::vector<int>& ids);
+
+	/// Append the remaining points of a tree to the coordinate columns and the ids.
+	static void collectPoints(const Tree& tree, std::vector<Coordinate>* x, std::vector<Coordinate>* y, std::vector<Coordinate>* z, std::vector<int>* ids);
+
+	/**
+	 * k nearest neighbor search over the buffer and all trees. The results are ids, sorted by increasing distance.
+	 * candidateIndices and candidateDistances are scratch space of the caller.
+	 */
+	unsigned int findNearestNeighbors(const double* query, unsigned int k, int* resultIndices, double* squaredDistances,
+			std::vector<int>* candidateIndices, std::vector<double>* candidateDistances) const;
+
+	/// Common part of both batch queries.
+	void findNearestNeighborsBatch(const NearestNeighborBatchQuery& queries, NearestNeighborBatchResult* result, unsigned int k);
+
+	/// Maximum number of points in a leaf
+	unsigned int leafSize;
+
+	/// Number of points that are collected in the buffer
+	unsigned int bufferSize;
+
+	/// Trees of the forest; levels[j] is null or has at most bufferSize * 2^j points
+	std::vector<Tree*> levels;
+
+	/// x, y and z of the points that are not yet inserted into a tree
+	std::vector<Coordinate> bufferCoordinates;
+
+	/// Ids of the points in the buffer
+	std::vector<int> bufferIds;
+
+	/// Id of the next inserted point
+	int nextId;
+
+	/// Number of indexed points
+	unsigned int size;
+};
+
+}
+
+#endif /* BRICS_3D_NEARESTNEIGHBORDYNAMICKDTREE_H_ */
+
+/* EOF */
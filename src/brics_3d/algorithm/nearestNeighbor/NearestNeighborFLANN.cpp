@@ -18,8 +18,10 @@
 ******************************************************************************/
 
 #include "NearestNeighborFLANN.h"
+#include "NearestNeighborBatchQuery.h"
 
 #include <assert.h>
+#include <algorithm>
 #include <stdexcept>
 #include <cmath>
 
@@ -45,25 +47,55 @@ NearestNeighborFLANN::NearestNeighborFLANN() {
 }
 
 NearestNeighborFLANN::~NearestNeighborFLANN() {
-	flann_free_index(index_id, &parameters);
+	if (index_id != 0) {
+		flann_free_index(index_id, &parameters);
+	}
+	if (dataMatrix != 0) { // the index refers to the matrix, so it is only released here
+		delete[] dataMatrix;
+	}
 }
 
-void NearestNeighborFLANN::setData(vector<vector<float> >* data) {
-	assert(false); //TODO: implement
+void NearestNeighborFLANN::prepareDataMatrix(int rows, int cols) {
+	if (index_id != 0) { // clean up if previous versions exist
+		flann_free_index(index_id, &parameters);
+		index_id = 0;
+	}
+	if (dataMatrix != 0) {
+		delete[] dataMatrix;
+		dataMatrix = 0;
+	}
+
+	this->rows = rows;
+	this->cols = cols;
+	dataMatrix = new float[rows * cols];
 }
 
-void NearestNeighborFLANN::setData(vector<vector<double> >* data) {
+void NearestNeighborFLANN::setData(vector<vector<float> >* data) {
 	assert(data != 0);
+	assert(data->size() >= 1); // at least one element!
 
-	if (index_id != 0) { // clean up if previous versions exist
-		flann_free_index(index_id, &parameters);
+	dimension = (*data)[0].size();
+	prepareDataMatrix(static_cast<int>(data->size()), dimension);
+
+	// copy data
+	int matrixIndex = 0;
+	for (int rowIndex = 0; rowIndex < rows; ++rowIndex) {
+		for (int j = 0; j < dimension; ++j) {
+			dataMatrix[matrixIndex + j] = (*data)[rowIndex][j];
+		}
+		matrixIndex += dimension;
 	}
 
-	dimension = (*data)[0].size();
-	rows = data->size();
-	cols = dimension;
+	// create underlying data structure
+	index_id = flann_build_index(dataMatrix, rows, cols, &speedup, &parameters);
+}
 
-	dataMatrix = new float[rows * cols];
+void NearestNeighborFLANN::setData(vector<vector<double> >* data) {
+	assert(data != 0);
+	assert(data->size() >= 1); // at least one element!
+
+	dimension = (*data)[0].size();
+	prepareDataMatrix(static_cast<int>(data->size()), dimension);
 
 	// convert data
 	int matrixIndex = 0;
@@ -81,15 +113,8 @@ void NearestNeighborFLANN::setData(vector<vector<double> >* data) {
 void NearestNeighborFLANN::setData(PointCloud3D* data) {
 	assert(data != 0);
 
-	if (index_id != 0) { // clean up if previous versions exist
-		flann_free_index(index_id, &parameters);
-	}
-
 	dimension = 3; //we work with a 3D points...
-	rows = data->getSize();
-	cols = dimension;
-
-	dataMatrix = new float[rows * cols];
+	prepareDataMatrix(static_cast<int>(data->getSize()), dimension);
 
 	// convert data
 	int matrixIndex = 0;
@@ -105,85 +130,250 @@ void NearestNeighborFLANN::setData(PointCloud3D* data) {
 
 }
 
-void NearestNeighborFLANN::findNearestNeighbors(vector<float>* query, std::vector<int>* resultIndices, unsigned int k) {
-	assert(false); //TODO: implement
+/* Interleave the coordinate columns of a contiguous point cloud into a row-major float matrix. */
+template <typename ScalarT>
+static void interleaveCoordinates(const PointCloud3DContiguousT<ScalarT>* data, float* matrix) {
+	const ScalarT* x = data->getXCoordinates();
+	const ScalarT* y = data->getYCoordinates();
+	const ScalarT* z = data->getZCoordinates();
+	unsigned int count = data->getSize();
+	for (unsigned int i = 0; i < count; ++i) {
+		matrix[0] = static_cast<float>(x[i]);
+		matrix[1] = static_cast<float>(y[i]);
+		matrix[2] = static_cast<float>(z[i]);
+		matrix += 3;
+	}
 }
 
-void NearestNeighborFLANN::findNearestNeighbors(vector<double>* query, std::vector<int>* resultIndices, unsigned int k) {
+void NearestNeighborFLANN::setData(PointCloud3DContiguous* data) {
+	assert(data != 0);
+
+	dimension = 3;
+	prepareDataMatrix(static_cast<int>(data->getSize()), dimension);
+	interleaveCoordinates(data, dataMatrix);
+
+	// create underlying data structure
+	index_id = flann_build_index(dataMatrix, rows, cols, &speedup, &parameters);
+}
+
+void NearestNeighborFLANN::setData(PointCloud3DContiguousFloat* data) {
+	assert(data != 0);
+
+	dimension = 3;
+	prepareDataMatrix(static_cast<int>(data->getSize()), dimension);
+	interleaveCoordinates(data, dataMatrix);
+
+	// create underlying data structure
+	index_id = flann_build_index(dataMatrix, rows, cols, &speedup, &parameters);
+}
+
+namespace {
+
+/**
+ * Range search for a batch. The queries are converted to float and passed in blocks to the
+ * multi-query search of FLANN, which writes the indices directly into the slots of the result.
+ */
+struct FLANNBatchSearch {
+	static const unsigned int blockSize = 4096;
+
+	FLANN_INDEX index;
+	FLANNParameters parameters;
+	double maxDistance;
+	std::vector<float> queryData;
+	std::vector<float> distanceData;
+
+	void operator()(const NearestNeighborBatchQuery& queries, unsigned int begin, unsigned int end, unsigned int k, NearestNeighborBatchResult* result) {
+		for (unsigned int blockBegin = begin; blockBegin < end; blockBegin += blockSize) {
+			unsigned int blockEnd = (end - blockBegin > blockSize) ? blockBegin + blockSize : end;
+			unsigned int count = blockEnd - blockBegin;
+			queryData.resize(3 * count);
+			distanceData.resize(k * count);
+			for (unsigned int i = 0; i < count; ++i) {
+				const Point3D& query = queries.getPoint(blockBegin + i);
+				queryData[3 * i + 0] = static_cast<float>(query.getX());
+				queryData[3 * i + 1] = static_cast<float>(query.getY());
+				queryData[3 * i + 2] = static_cast<float>(query.getZ());
+			}
+
+			flann_find_nearest_neighbors_index(index, &queryData[0], static_cast<int>(count), &result->indices[blockBegin * k], &distanceData[0],
+					static_cast<int>(k), parameters.checks, &parameters);
+
+			for (unsigned int i = 0; i < count; ++i) {
+				unsigned int slot = (blockBegin + i) * k;
+				for (unsigned int j = 0; j < k; ++j) {
+					result->squaredDistances[slot + j] = distanceData[i * k + j];
+				}
+				result->offsets[blockBegin + i + 1] = NearestNeighborBatchQuery::applyMaxDistance(maxDistance, k, &result->indices[slot], &result->squaredDistances[slot]);
+			}
+		}
+	}
+};
+
+}
+
+void NearestNeighborFLANN::findNearestNeighbors(vector<float>* query, std::vector<int>* resultIndices, unsigned int k) {
 	assert (query != 0);
 	assert (resultIndices != 0);
-//	assert (static_cast<int>(query->size()) == dimension);
 
 	if (static_cast<int>(query->size()) != dimension) {
 		throw runtime_error("Mismatch of query and data dimension.");
 	}
-	if (static_cast<int>(k) > this->rows) {
-		throw runtime_error("Number of neighbors k is bigger than the amount of data points.");
-	}
 
-	resultIndices->clear();
-	int nn = static_cast<int>(k);
-	int tcount = 1;
-	int* result = new int[nn];
-	float* dists = new float[nn];
+	findNearestNeighborsRaw(&(*query)[0], resultIndices, 0, k);
+}
 
-	float* queryData = new float[dimension]; //TODO: is there also a double version?!?
-	for (int i = 0; i < dimension; ++i) {
-		queryData[i] = static_cast<float>( (*query)[i] );
-	}
+void NearestNeighborFLANN::findNearestNeighbors(vector<double>* query, std::vector<int>* resultIndices, unsigned int k) {
+	assert (resultIndices != 0);
+
+	std::vector<float> queryData;
+	convertQuery(query, &queryData);
+	findNearestNeighborsRaw(&queryData[0], resultIndices, 0, k);
+}
 
-	flann_find_nearest_neighbors_index(index_id, queryData, tcount, result, dists, nn, parameters.checks, &parameters);
+void NearestNeighborFLANN::findNearestNeighbors(Point3D* query, std::vector<int>* resultIndices, unsigned int k) {
+	assert (query != 0);
+	assert (resultIndices != 0);
+	assert (dimension == 3);
 
-	brics_3d::Coordinate resultDistance; //distance has same data-type as Coordinate, although the meaning is different TODO: global distance typedef?
-	int resultIndex;
-	for (int i = 0; i < nn; i++) {
-		resultDistance = static_cast<brics_3d::Coordinate>(sqrt(dists[i])); //seems to return squared distance (although documentation does not suggest)
-		resultIndex = result[i];
-		if (resultDistance <= maxDistance || maxDistance < 0.0) { //if max distance is < 0 then the distance should have no influence
-			resultIndices->push_back(resultIndex);
-		}
-	}
+	float queryData[3];
+	queryData[0] = static_cast<float> (query->getX());
+	queryData[1] = static_cast<float> (query->getY());
+	queryData[2] = static_cast<float> (query->getZ());
 
-	delete[] queryData;
-	delete[] dists;
-	delete[] result;
+	findNearestNeighborsRaw(queryData, resultIndices, 0, k);
 }
 
-void NearestNeighborFLANN::findNearestNeighbors(Point3D* query, std::vector<int>* resultIndices, unsigned int k) {
+void NearestNeighborFLANN::findNearestNeighbors(vector<double>* query, std::vector<int>* resultIndices, std::vector<double>* squaredDistances, unsigned int k) {
+	assert (resultIndices != 0);
+	assert (squaredDistances != 0);
+
+	std::vector<float> queryData;
+	convertQuery(query, &queryData);
+	findNearestNeighborsRaw(&queryData[0], resultIndices, squaredDistances, k);
+}
+
+void NearestNeighborFLANN::findNearestNeighbors(Point3D* query, std::vector<int>* resultIndices, std::vector<double>* squaredDistances, unsigned int k) {
+	assert (query != 0);
+	assert (resultIndices != 0);
+	assert (squaredDistances != 0);
+	assert (dimension == 3);
+
+	float queryData[3];
+	queryData[0] = static_cast<float> (query->getX());
+	queryData[1] = static_cast<float> (query->getY());
+	queryData[2] = static_cast<float> (query->getZ());
+
+	findNearestNeighborsRaw(queryData, resultIndices, squaredDistances, k);
+}
+
+void NearestNeighborFLANN::findNeighborsWithinRadius(vector<double>* query, double radius, std::vector<int>* resultIndices, std::vector<double>* squaredDistances) {
+	assert (resultIndices != 0);
+
+	std::vector<float> queryData;
+	convertQuery(query, &queryData);
+	findNeighborsWithinRadiusRaw(&queryData[0], radius, resultIndices, squaredDistances);
+}
+
+void NearestNeighborFLANN::findNeighborsWithinRadius(Point3D* query, double radius, std::vector<int>* resultIndices, std::vector<double>* squaredDistances) {
 	assert (query != 0);
 	assert (resultIndices != 0);
 	assert (dimension == 3);
 
+	float queryData[3];
+	queryData[0] = static_cast<float> (query->getX());
+	queryData[1] = static_cast<float> (query->getY());
+	queryData[2] = static_cast<float> (query->getZ());
+
+	findNeighborsWithinRadiusRaw(queryData, radius, resultIndices, squaredDistances);
+}
+
+void NearestNeighborFLANN::findNearestNeighbors(PointCloud3D* queries, NearestNeighborBatchResult* result, unsigned int k) {
+	findNearestNeighborsBatch(NearestNeighborBatchQuery(queries, 0), result, k);
+}
+
+void NearestNeighborFLANN::findNearestNeighbors(PointCloud3D* queries, const std::vector<int>& queryIndices, NearestNeighborBatchResult* result, unsigned int k) {
+	findNearestNeighborsBatch(NearestNeighborBatchQuery(queries, &queryIndices), result, k);
+}
+
+void NearestNeighborFLANN::findNearestNeighborsBatch(const NearestNeighborBatchQuery& queries, NearestNeighborBatchResult* result, unsigned int k) {
+	assert (result != 0);
+	assert (dimension == 3);
+	if (static_cast<int>(k) > this->rows) {
+		throw runtime_error("Number of neighbors k is bigger than the amount of data points.");
+	}
+
+	FLANNBatchSearch search;
+	search.index = index_id;
+	search.parameters = parameters;
+	search.maxDistance = maxDistance;
+	queries.process(search, k, maxNumberOfThreads, false, result); // the index keeps the state of the current search
+}
+
+void NearestNeighborFLANN::convertQuery(vector<double>* query, std::vector<float>* queryData) {
+	assert (query != 0);
+
+	if (static_cast<int>(query->size()) != dimension) {
+		throw runtime_error("Mismatch of query and data dimension.");
+	}
+
+	queryData->resize(dimension); //FLANN works on float only
+	for (int i = 0; i < dimension; ++i) {
+		(*queryData)[i] = static_cast<float>( (*query)[i] );
+	}
+}
+
+void NearestNeighborFLANN::findNearestNeighborsRaw(const float* queryData, std::vector<int>* resultIndices, std::vector<double>* squaredDistances, unsigned int k) {
 	if (static_cast<int>(k) > this->rows) {
 		throw runtime_error("Number of neighbors k is bigger than the amount of data points.");
 	}
 
 	resultIndices->clear();
+	if (squaredDistances != 0) {
+		squaredDistances->clear();
+	}
+	if (k == 0) {
+		return;
+	}
 	int nn = static_cast<int>(k);
 	int tcount = 1;
-	int* result = new int[nn];
-	float* dists = new float[nn];
-
-	float* queryData = new float[dimension];
-	queryData[0] = static_cast<float> (query->getX());
-	queryData[1] = static_cast<float> (query->getY());
-	queryData[2] = static_cast<float> (query->getZ());
+	indexBuffer.resize(std::max(indexBuffer.size(), static_cast<size_t>(nn)));
+	distanceBuffer.resize(indexBuffer.size());
 
-	flann_find_nearest_neighbors_index(index_id, queryData, tcount, result, dists, nn, parameters.checks, &parameters);
+	flann_find_nearest_neighbors_index(index_id, const_cast<float*>(queryData), tcount, &indexBuffer[0], &distanceBuffer[0], nn, parameters.checks, &parameters);
 
-	brics_3d::Coordinate resultDistance; //distance has same data-type as Coordinate, although the meaning is different TODO: global distance typedef?
-	int resultIndex;
 	for (int i = 0; i < nn; i++) {
-		resultDistance = static_cast<brics_3d::Coordinate>(sqrt(dists[i])); //seems to return squared distance (although documentation does not suggest)
-		resultIndex = result[i];
-		if (resultDistance <= maxDistance || maxDistance < 0.0) { //if max distance is < 0 then the distance should have no influence
-			resultIndices->push_back(resultIndex);
+		if (maxDistance < 0.0 || static_cast<brics_3d::Coordinate>(sqrt(distanceBuffer[i])) <= maxDistance) { //FLANN returns squared distances; if max distance is < 0 then the distance should have no influence
+			resultIndices->push_back(indexBuffer[i]);
+			if (squaredDistances != 0) {
+				squaredDistances->push_back(distanceBuffer[i]);
+			}
 		}
 	}
+}
+
+void NearestNeighborFLANN::findNeighborsWithinRadiusRaw(const float* queryData, double radius, std::vector<int>* resultIndices, std::vector<double>* squaredDistances) {
+	resultIndices->clear();
+	if (squaredDistances != 0) {
+		squaredDistances->clear();
+	}
+	if (radius < 0.0 || rows == 0) {
+		return;
+	}
+
+	/* flann_radius_search writes all found neighbors without checking the buffer size */
+	indexBuffer.resize(std::max(indexBuffer.size(), static_cast<size_t>(rows)));
+	distanceBuffer.resize(indexBuffer.size());
+	int checks = rows; // allow to check every point, so no neighbor within the radius is missed
+	int count = flann_radius_search(index_id, const_cast<float*>(queryData), &indexBuffer[0], &distanceBuffer[0], rows,
+			static_cast<float>(radius * radius), checks, &parameters);
+	if (count <= 0) {
+		return;
+	}
 
-	delete[] queryData;
-	delete[] dists;
-	delete[] result;
+	resultIndices->assign(indexBuffer.begin(), indexBuffer.begin() + count);
+	if (squaredDistances != 0) {
+		squaredDistances->assign(distanceBuffer.begin(), distanceBuffer.begin() + count);
+	}
 }
 
 FLANNParameters NearestNeighborFLANN::getParameters() const {
@@ -23,10 +23,13 @@
 #include "brics_3d/algorithm/nearestNeighbor/INearestNeighbor.h"
 #include "brics_3d/algorithm/nearestNeighbor/INearestPoint3DNeighbor.h"
 #include "brics_3d/algorithm/nearestNeighbor/INearestNeighborSetup.h"
+#include "brics_3d/core/PointCloud3DContiguous.h"
 #include "flann/src/cpp/flann.h"
 
 namespace brics_3d {
 
+class NearestNeighborBatchQuery;
+
 /**
  * @ingroup nearestNeighbor
  * @brief Implementation for the nearest neighbor search algorithm with the FLANN library.
@@ -49,21 +52,62 @@ public:
 	void setData(vector< vector<double> >* data);
 	void setData(PointCloud3D* data);
 
+	/**
+	 * @brief Set the data from a contiguous point cloud.
+	 * The coordinate columns are directly interleaved into the float matrix of FLANN.
+	 */
+	void setData(PointCloud3DContiguous* data);
+
+	/**
+	 * @brief Set the data from a single precision contiguous point cloud.
+	 * FLANN works on float internally, so no precision conversion is involved.
+	 */
+	void setData(PointCloud3DContiguousFloat* data);
+
 	void findNearestNeighbors(vector<float>* query, std::vector<int>* resultIndices, unsigned int k = 1);
 	void findNearestNeighbors(vector<double>* query, std::vector<int>* resultIndices, unsigned int k = 1);
 	void findNearestNeighbors(Point3D* query, std::vector<int>* resultIndices, unsigned int k = 1);
 
+	void findNearestNeighbors(vector<double>* query, std::vector<int>* resultIndices, std::vector<double>* squaredDistances, unsigned int k);
+	void findNearestNeighbors(Point3D* query, std::vector<int>* resultIndices, std::vector<double>* squaredDistances, unsigned int k);
+
+	/**
+	 * @brief Batch query. The queries are passed in blocks to the multi-query search of FLANN.
+	 * The search structure of FLANN holds state of the current search, so the batch is processed by the calling thread.
+	 */
+	void findNearestNeighbors(PointCloud3D* queries, NearestNeighborBatchResult* result, unsigned int k = 1);
+	void findNearestNeighbors(PointCloud3D* queries, const std::vector<int>& queryIndices, NearestNeighborBatchResult* result, unsigned int k = 1);
+
+	/**
+	 * @brief Radius search based on the native radius search of FLANN (flann_radius_search).
+	 * In contrast to the k nearest neighbor search the tree is fully traversed, independent of the
+	 * configured number of checks, so all points within the radius are found.
+	 */
+	void findNeighborsWithinRadius(vector<double>* query, double radius, std::vector<int>* resultIndices, std::vector<double>* squaredDistances = 0);
+	void findNeighborsWithinRadius(Point3D* query, double radius, std::vector<int>* resultIndices, std::vector<double>* squaredDistances = 0);
+
 	FLANNParameters getParameters() const;
 
 	void setParameters(FLANNParameters p);
 
 	float getSpeedup() const;
 
+private:
 
+	/// Release the previous index and its data (if any) and allocate a new matrix.
+	void prepareDataMatrix(int rows, int cols);
 
+	/// Perform the query with a float vector of size dimension. squaredDistances may be null.
+	void findNearestNeighborsRaw(const float* queryData, std::vector<int>* resultIndices, std::vector<double>* squaredDistances, unsigned int k);
 
+	/// Perform the radius query with a float vector of size dimension. squaredDistances may be null.
+	void findNeighborsWithinRadiusRaw(const float* queryData, double radius, std::vector<int>* resultIndices, std::vector<double>* squaredDistances);
 
-private:
+	/// Common part of both batch queries.
+	void findNearestNeighborsBatch(const NearestNeighborBatchQuery& queries, NearestNeighborBatchResult* result, unsigned int k);
+
+	/// Convert a query to float. Throws if the dimension does not match the data.
+	void convertQuery(vector<double>* query, std::vector<float>* queryData);
 
 	/// Matrix in major-row representation
 	float* dataMatrix;
@@ -82,6 +126,12 @@ private:
 
 	/// Estimated speedup of used algorithm with respect to a brute force approach
 	float speedup;
+
+	/// Result indices, reused for all queries. A radius query might return all rows.
+	std::vector<int> indexBuffer;
+
+	/// Squared result distances, reused for all queries.
+	std::vector<float> distanceBuffer;
 };
 
 }
@@ -0,0 +1,223 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+
+#include "NearestNeighborKDTree.h"
+#include "NearestNeighborBatchQuery.h"
+
+#include <assert.h>
+#include <stdexcept>
+
+using std::runtime_error;
+
+namespace brics_3d {
+
+namespace {
+
+/// Range search for a batch. The tree writes directly into the slots of the result.
+template <typename TreeT>
+struct KDTreeBatchSearch {
+	const TreeT* tree;
+	double maxDistance;
+
+	void operator()(const NearestNeighborBatchQuery& queries, unsigned int begin, unsigned int end, unsigned int k, NearestNeighborBatchResult* result) {
+		double queryPoint[3];
+		for (unsigned int i = begin; i < end; ++i) {
+			const Point3D& query = queries.getPoint(i);
+			queryPoint[0] = query.getX();
+			queryPoint[1] = query.getY();
+			queryPoint[2] = query.getZ();
+			int* indices = &result->indices[i * k];
+			double* squaredDistances = &result->squaredDistances[i * k];
+			unsigned int count = tree->findNearestNeighbors(queryPoint, k, indices, squaredDistances);
+			result->offsets[i + 1] = NearestNeighborBatchQuery::applyMaxDistance(maxDistance, count, indices, squaredDistances);
+		}
+	}
+};
+
+}
+
+NearestNeighborKDTree::NearestNeighborKDTree(unsigned int leafSize) {
+	this->dimension = -1;
+	this->maxDistance = -1; //default = disable
+	setLeafSize(leafSize);
+	pointCloudTree = 0;
+	contiguousTree = 0;
+	contiguousFloatTree = 0;
+}
+
+NearestNeighborKDTree::~NearestNeighborKDTree() {
+	clear();
+}
+
+void NearestNeighborKDTree::clear() {
+	delete pointCloudTree;
+	delete contiguousTree;
+	delete contiguousFloatTree;
+	pointCloudTree = 0;
+	contiguousTree = 0;
+	contiguousFloatTree = 0;
+}
+
+void NearestNeighborKDTree::setData(PointCloud3D* data) {
+	assert(data != 0);
+	clear();
+	dimension = 3;
+	pointCloudTree = new KDTree3D<PointCloud3DAdaptor>(leafSize);
+	pointCloudTree->build(PointCloud3DAdaptor(data), maxNumberOfThreads);
+}
+
+void NearestNeighborKDTree::setData(PointCloud3DContiguous* data) {
+	assert(data != 0);
+	clear();
+	dimension = 3;
+	contiguousTree = new KDTree3D<PointCloud3DContiguousAdaptor<Coordinate> >(leafSize);
+	contiguousTree->build(PointCloud3DContiguousAdaptor<Coordinate>(data), maxNumberOfThreads);
+}
+
+void NearestNeighborKDTree::setData(PointCloud3DContiguousFloat* data) {
+	assert(data != 0);
+	clear();
+	dimension = 3;
+	contiguousFloatTree = new KDTree3D<PointCloud3DContiguousAdaptor<float> >(leafSize);
+	contiguousFloatTree->build(PointCloud3DContiguousAdaptor<float>(data), maxNumberOfThreads);
+}
+
+unsigned int NearestNeighborKDTree::getNumberOfDataPoints() const {
+	if (pointCloudTree != 0) {
+		return pointCloudTree->getSize();
+	} else if (contiguousTree != 0) {
+		return contiguousTree->getSize();
+	} else if (contiguousFloatTree != 0) {
+		return contiguousFloatTree->getSize();
+	}
+	throw runtime_error("No data set for the nearest neighbor search.");
+}
+
+void NearestNeighborKDTree::findNearestNeighbors(Point3D* query, std::vector<int>* resultIndices, unsigned int k) {
+	if (pointCloudTree != 0) {
+		findNearestNeighbors(pointCloudTree, query, resultIndices, 0, k);
+	} else if (contiguousTree != 0) {
+		findNearestNeighbors(contiguousTree, query, resultIndices, 0, k);
+	} else {
+		findNearestNeighbors(contiguousFloatTree, query, resultIndices, 0, k);
+	}
+}
+
+void NearestNeighborKDTree::findNearestNeighbors(Point3D* query, std::vector<int>* resultIndices, std::vector<double>* squaredDistances, unsigned int k) {
+	assert (squaredDistances != 0);
+	if (pointCloudTree != 0) {
+		findNearestNeighbors(pointCloudTree, query, resultIndices, squaredDistances, k);
+	} else if (contiguousTree != 0) {
+		findNearestNeighbors(contiguousTree, query, resultIndices, squaredDistances, k);
+	} else {
+		findNearestNeighbors(contiguousFloatTree, query, resultIndices, squaredDistances, k);
+	}
+}
+
+template <typename TreeT>
+void NearestNeighborKDTree::findNearestNeighbors(const TreeT* tree, Point3D* query, std::vector<int>* resultIndices, std::vector<double>* squaredDistances, unsigned int k) {
+	assert (query != 0);
+	assert (resultIndices != 0);
+	if (k > getNumberOfDataPoints()) {
+		throw runtime_error("Number of neighbors k is bigger than the amount of data points.");
+	}
+
+	std::vector<double> localSquaredDistances;
+	if (squaredDistances == 0) {
+		squaredDistances = &localSquaredDistances;
+	}
+	resultIndices->resize(k);
+	squaredDistances->resize(k);
+	if (k == 0) {
+		return;
+	}
+
+	double queryPoint[3] = {query->getX(), query->getY(), query->getZ()};
+	unsigned int count = tree->findNearestNeighbors(queryPoint, k, &(*resultIndices)[0], &(*squaredDistances)[0]);
+	count = NearestNeighborBatchQuery::applyMaxDistance(maxDistance, count, &(*resultIndices)[0], &(*squaredDistances)[0]);
+	resultIndices->resize(count);
+	squaredDistances->resize(count);
+}
+
+void NearestNeighborKDTree::findNeighborsWithinRadius(Point3D* query, double radius, std::vector<int>* resultIndices, std::vector<double>* squaredDistances) {
+	assert (query != 0);
+	assert (resultIndices != 0);
+	getNumberOfDataPoints(); // throws without data
+
+	double queryPoint[3] = {query->getX(), query->getY(), query->getZ()};
+	if (pointCloudTree != 0) {
+		pointCloudTree->findNeighborsWithinRadius(queryPoint, radius, resultIndices, squaredDistances);
+	} else if (contiguousTree != 0) {
+		contiguousTree->findNeighborsWithinRadius(queryPoint, radius, resultIndices, squaredDistances);
+	} else {
+		contiguousFloatTree->findNeighborsWithinRadius(queryPoint, radius, resultIndices, squaredDistances);
+	}
+}
+
+void NearestNeighborKDTree::findNearestNeighbors(PointCloud3D* queries, NearestNeighborBatchResult* result, unsigned int k) {
+	findNearestNeighborsBatch(NearestNeighborBatchQuery(queries, 0), result, k);
+}
+
+void NearestNeighborKDTree::findNearestNeighbors(PointCloud3D* queries, const std::vector<int>& queryIndices, NearestNeighborBatchResult* result, unsigned int k) {
+	findNearestNeighborsBatch(NearestNeighborBatchQuery(queries, &queryIndices), result, k);
+}
+
+void NearestNeighborKDTree::findNearestNeighborsBatch(const NearestNeighborBatchQuery& queries, NearestNeighborBatchResult* result, unsigned int k) {
+	assert (result != 0);
+	if (k > getNumberOfDataPoints()) {
+		throw runtime_error("Number of neighbors k is bigger than the amount of data points.");
+	}
+
+	if (pointCloudTree != 0) {
+		KDTreeBatchSearch<KDTree3D<PointCloud3DAdaptor> > search;
+		search.tree = pointCloudTree;
+		search.maxDistance = maxDistance;
+		queries.process(search, k, maxNumberOfThreads, true, result);
+	} else if (contiguousTree != 0) {
+		KDTreeBatchSearch<KDTree3D<PointCloud3DContiguousAdaptor<Coordinate> > > search;
+		search.tree = contiguousTree;
+		search.maxDistance = maxDistance;
+		queries.process(search, k, maxNumberOfThreads, true, result);
+	} else {
+		KDTreeBatchSearch<KDTree3D<PointCloud3DContiguousAdaptor<float> > > search;
+		search.tree = contiguousFloatTree;
+		search.maxDistance = maxDistance;
+		queries.process(search, k, maxNumberOfThreads, true, result);
+	}
+}
+
+bool NearestNeighborKDTree::supportsConcurrentQueries() const {
+	return true;
+}
+
+void NearestNeighborKDTree::setLeafSize(unsigned int leafSize) {
+	if (leafSize == 0) {
+		throw runtime_error("The leaf size has to be at least 1.");
+	}
+	this->leafSize = leafSize;
+}
+
+unsigned int NearestNeighborKDTree::getLeafSize() const {
+	return leafSize;
+}
+
+}
+
+/* EOF */
@@ -0,0 +1,123 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+
+#ifndef BRICS_3D_NEARESTNEIGHBORKDTREE_H_
+#define BRICS_3D_NEARESTNEIGHBORKDTREE_H_
+
+#include "brics_3d/algorithm/nearestNeighbor/INearestPoint3DNeighbor.h"
+#include "brics_3d/algorithm/nearestNeighbor/INearestNeighborSetup.h"
+#include "brics_3d/algorithm/nearestNeighbor/KDTree3D.h"
+#include "brics_3d/core/PointCloud3DContiguous.h"
+
+namespace brics_3d {
+
+class NearestNeighborBatchQuery;
+
+/**
+ * @ingroup nearestNeighbor
+ * @brief Implementation for the nearest neighbor search algorithm with the built-in KDTree3D.
+ *
+ * In contrast to the other implementations the data is not copied: the tree indexes the coordinates
+ * of the point cloud in place. Thus the point cloud must neither be changed nor deleted as long as it is
+ * set as data. Contiguous point clouds are the faster variant, as their coordinates are read from
+ * plain arrays. The search is exact and the queries may be issued concurrently.
+ *
+ */
+class NearestNeighborKDTree : public INearestPoint3DNeighbor, public INearestNeighborSetup {
+public:
+
+	/**
+	 * @brief Standard constructor
+	 * @param leafSize Maximum number of points in a leaf of the tree.
+	 */
+	NearestNeighborKDTree(unsigned int leafSize = KDTree3D<PointCloud3DAdaptor>::defaultLeafSize);
+
+	/**
+	 * @brief Standard destructor
+	 */
+	virtual ~NearestNeighborKDTree();
+
+	void setData(PointCloud3D* data);
+
+	/**
+	 * @brief Set the data from a contiguous point cloud. The coordinate columns are indexed in place.
+	 */
+	void setData(PointCloud3DContiguous* data);
+
+	/**
+	 * @brief Set the data from a single precision contiguous point cloud. The coordinate columns are indexed in place.
+	 */
+	void setData(PointCloud3DContiguousFloat* data);
+
+	void findNearestNeighbors(Point3D* query, std::vector<int>* resultIndices, unsigned int k = 1);
+	void findNearestNeighbors(Point3D* query, std::vector<int>* resultIndices, std::vector<double>* squaredDistances, unsigned int k);
+	void findNeighborsWithinRadius(Point3D* query, double radius, std::vector<int>* resultIndices, std::vector<double>* squaredDistances = 0);
+
+	/**
+	 * @brief Batch query. The queries are distributed over multiple threads.
+	 */
+	void findNearestNeighbors(PointCloud3D* queries, NearestNeighborBatchResult* result, unsigned int k = 1);
+	void findNearestNeighbors(PointCloud3D* queries, const std::vector<int>& queryIndices, NearestNeighborBatchResult* result, unsigned int k = 1);
+
+	/**
+	 * @brief The queries only use local state.
+	 */
+	bool supportsConcurrentQueries() const;
+
+	/**
+	 * @brief Maximum number of points in a leaf of the tree. Takes effect with the next setData().
+	 */
+	void setLeafSize(unsigned int leafSize);
+
+	unsigned int getLeafSize() const;
+
+private:
+
+	/// Delete the current tree (if any).
+	void clear();
+
+	/// Number of points of the current tree. Throws if no data is set.
+	unsigned int getNumberOfDataPoints() const;
+
+	/// k nearest neighbor search on one of the trees. squaredDistances may be null.
+	template <typename TreeT>
+	void findNearestNeighbors(const TreeT* tree, Point3D* query, std::vector<int>* resultIndices, std::vector<double>* squaredDistances, unsigned int k);
+
+	/// Common part of both batch queries.
+	void findNearestNeighborsBatch(const NearestNeighborBatchQuery& queries, NearestNeighborBatchResult* result, unsigned int k);
+
+	/// Maximum number of points in a leaf
+	unsigned int leafSize;
+
+	/// Tree for a PointCloud3D. At most one of the trees exists at a time.
+	KDTree3D<PointCloud3DAdaptor>* pointCloudTree;
+
+	/// Tree for a PointCloud3DContiguous
+	KDTree3D<PointCloud3DContiguousAdaptor<Coordinate> >* contiguousTree;
+
+	/// Tree for a PointCloud3DContiguousFloat
+	KDTree3D<PointCloud3DContiguousAdaptor<float> >* contiguousFloatTree;
+};
+
+}
+
+#endif /* BRICS_3D_NEARESTNEIGHBORKDTREE_H_ */
+
+/* EOF */
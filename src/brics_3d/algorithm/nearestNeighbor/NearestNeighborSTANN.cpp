@@ -18,7 +18,9 @@
 ******************************************************************************/
 
 #include "NearestNeighborSTANN.h"
+#include "NearestNeighborBatchQuery.h"
 #include <assert.h>
+#include <algorithm>
 #include <cmath>
 #include <stdexcept>
 
@@ -28,6 +30,35 @@ using std::runtime_error;
 
 namespace brics_3d {
 
+namespace {
+
+/// Range search for a batch. Every thread has its own copy and thus its own STANN result buffers.
+struct STANNBatchSearch {
+	sfcnn<STANNPoint3D, STANNPoint3DDimension, double>* handle;
+	double maxDistance;
+	std::vector<long unsigned int> stannIndices;
+	std::vector<double> stannSquaredDistances;
+
+	void operator()(const NearestNeighborBatchQuery& queries, unsigned int begin, unsigned int end, unsigned int k, NearestNeighborBatchResult* result) {
+		for (unsigned int i = begin; i < end; ++i) {
+			const Point3D& query = queries.getPoint(i);
+			STANNPoint3D queryPoint(query.getX(), query.getY(), query.getZ());
+			handle->ksearch(queryPoint, k, stannIndices, stannSquaredDistances);
+			assert(static_cast<unsigned int>(stannIndices.size()) == k);
+
+			int* indices = &result->indices[i * k];
+			double* squaredDistances = &result->squaredDistances[i * k];
+			for (unsigned int j = 0; j < k; ++j) {
+				indices[j] = static_cast<int>(stannIndices[j]);
+				squaredDistances[j] = stannSquaredDistances[j];
+			}
+			result->offsets[i + 1] = NearestNeighborBatchQuery::applyMaxDistance(maxDistance, k, indices, squaredDistances);
+		}
+	}
+};
+
+}
+
 NearestNeighborSTANN::NearestNeighborSTANN() {
 	this->dimension = -1;
 	this->maxDistance = -1; //default = disable
@@ -125,8 +156,19 @@ void NearestNeighborSTANN::findNearestNeighbors(vector<float>* query, std::vecto
 }
 
 void NearestNeighborSTANN::findNearestNeighbors(vector<double>* query, std::vector<int>* resultIndices, unsigned int k) {
+	std::vector<double> squaredDistances;
+	findNearestNeighbors(query, resultIndices, &squaredDistances, k);
+}
+
+void NearestNeighborSTANN::findNearestNeighbors(Point3D* query, std::vector<int>* resultIndices, unsigned int k) {
+	std::vector<double> squaredDistances;
+	findNearestNeighbors(query, resultIndices, &squaredDistances, k);
+}
+
+void NearestNeighborSTANN::findNearestNeighbors(vector<double>* query, std::vector<int>* resultIndices, std::vector<double>* squaredDistances, unsigned int k) {
 	assert (query != 0);
 	assert (resultIndices != 0);
+	assert (squaredDistances != 0);
 
 	if (static_cast<int>(query->size()) != dimension) {
 		throw runtime_error("Mismatch of query and data dimension.");
@@ -142,61 +184,124 @@ void NearestNeighborSTANN::findNearestNeighbors(vector<double>* query, std::vect
 
 	squaredResultDistances->clear();
 	this->resultIndices->clear(); //clear internal vector
-	resultIndices->clear(); //result vector
 
 	nearestNeigborHandle->ksearch(queryPoint, k, *(this->resultIndices), *squaredResultDistances);
 	assert( static_cast<unsigned int>(this->resultIndices->size()) == static_cast<unsigned int>(k));
-	assert( static_cast<unsigned int>(this->resultIndices->size()) > 0);
 	assert( static_cast<unsigned int>(squaredResultDistances->size()) == static_cast<unsigned int>(k));
-	assert( static_cast<unsigned int>(squaredResultDistances->size()) > 0);
-
-	brics_3d::Coordinate resultDistance; //distance has same data-type as Coordinate, although the meaning is different
-	int resultIndex;
-	for (int i = 0; i < static_cast<int>(k); i++) {
-		resultDistance = static_cast<brics_3d::Coordinate>(sqrt((*squaredResultDistances)[i])); //seems to return squared distance (although documentation does not suggest)
-		resultIndex = static_cast<int>((*(this->resultIndices))[i]);
-		if (resultDistance <= maxDistance || maxDistance < 0.0) { //if max distance is < 0 then the distance should have no influence
-			resultIndices->push_back(resultIndex);
-		}
-	}
 
+	copyResults(*(this->resultIndices), *squaredResultDistances, maxDistance, resultIndices, squaredDistances);
 }
 
-void NearestNeighborSTANN::findNearestNeighbors(Point3D* query, std::vector<int>* resultIndices, unsigned int k) {
+void NearestNeighborSTANN::findNearestNeighbors(Point3D* query, std::vector<int>* resultIndices, std::vector<double>* squaredDistances, unsigned int k) {
 	assert (query != 0);
 	assert (resultIndices != 0);
+	assert (squaredDistances != 0);
 	assert (STANNPoint3DDimension == 3);
 
 	if (static_cast<unsigned int>(k) > this->points3D->size()) {
 		throw runtime_error("Number of neighbors k is bigger than the amount of data points.");
 	}
 
+	STANNPoint3D queryPoint(query->getX(), query->getY(), query->getZ());
+	std::vector<long unsigned int> tmpResultIndices; // local buffers, so concurrent queries are possible
+	std::vector<double> tmpSquaredResultDistances;
+	nearestPoint3DNeigborHandle->ksearch(queryPoint, k, tmpResultIndices, tmpSquaredResultDistances);
+	assert( static_cast<unsigned int>(tmpResultIndices.size()) == static_cast<unsigned int>(k));
+	assert( static_cast<unsigned int>(tmpSquaredResultDistances.size()) == static_cast<unsigned int>(k));
+
+	copyResults(tmpResultIndices, tmpSquaredResultDistances, maxDistance, resultIndices, squaredDistances);
+}
+
+void NearestNeighborSTANN::findNearestNeighbors(PointCloud3D* queries, NearestNeighborBatchResult* result, unsigned int k) {
+	findNearestNeighborsBatch(NearestNeighborBatchQuery(queries, 0), result, k);
+}
+
+void NearestNeighborSTANN::findNearestNeighbors(PointCloud3D* queries, const std::vector<int>& queryIndices, NearestNeighborBatchResult* result, unsigned int k) {
+	findNearestNeighborsBatch(NearestNeighborBatchQuery(queries, &queryIndices), result, k);
+}
+
+void NearestNeighborSTANN::findNearestNeighborsBatch(const NearestNeighborBatchQuery& queries, NearestNeighborBatchResult* result, unsigned int k) {
+	assert (result != 0);
+	if (static_cast<unsigned int>(k) > this->points3D->size()) {
+		throw runtime_error("Number of neighbors k is bigger than the amount of data points.");
+	}
+
+	STANNBatchSearch search;
+	search.handle = nearestPoint3DNeigborHandle;
+	search.maxDistance = maxDistance;
+	queries.process(search, k, maxNumberOfThreads, supportsConcurrentQueries(), result);
+}
+
+void NearestNeighborSTANN::findNeighborsWithinRadius(vector<double>* query, double radius, std::vector<int>* resultIndices, std::vector<double>* squaredDistances) {
+	assert (query != 0);
+	assert (resultIndices != 0);
+
+	if (static_cast<int>(query->size()) != dimension) {
+		throw runtime_error("Mismatch of query and data dimension.");
+	}
+
+	STANNPoint queryPoint;
+	for (int i = 0; i < dimension; ++i) {
+		queryPoint[i] = (*query)[i];
+	}
+	findNeighborsWithinRadius(nearestNeigborHandle, queryPoint, static_cast<unsigned int>(points->size()), radius, resultIndices, squaredDistances);
+}
+
+void NearestNeighborSTANN::findNeighborsWithinRadius(Point3D* query, double radius, std::vector<int>* resultIndices, std::vector<double>* squaredDistances) {
+	assert (query != 0);
+	assert (resultIndices != 0);
+
+	STANNPoint3D queryPoint(query->getX(), query->getY(), query->getZ());
+	findNeighborsWithinRadius(nearestPoint3DNeigborHandle, queryPoint, static_cast<unsigned int>(points3D->size()), radius, resultIndices, squaredDistances);
+}
+
+template <typename HandleT, typename PointT>
+void NearestNeighborSTANN::findNeighborsWithinRadius(HandleT* handle, const PointT& queryPoint, unsigned int numberOfPoints, double radius,
+		std::vector<int>* resultIndices, std::vector<double>* squaredDistances) {
 	resultIndices->clear();
-	double tmpX = (*query).getX();
-	double tmpY = (*query).getY();
-	double tmpZ = (*query).getZ();
+	if (squaredDistances != 0) {
+		squaredDistances->clear();
+	}
+	if (radius < 0.0 || numberOfPoints == 0) {
+		return;
+	}
+	double squaredRadius = radius * radius;
+
+	/* the results are sorted by distance: stop as soon as the farthest one is outside of the radius */
+	std::vector<long unsigned int> tmpResultIndices;
+	std::vector<double> tmpSquaredResultDistances;
+	unsigned int k = (numberOfPoints < initialRadiusSearchSize) ? numberOfPoints : initialRadiusSearchSize;
+	while (true) {
+		handle->ksearch(queryPoint, k, tmpResultIndices, tmpSquaredResultDistances);
+		if (tmpSquaredResultDistances.back() > squaredRadius || k == numberOfPoints) {
+			break;
+		}
+		k = std::min(2 * k, numberOfPoints);
+	}
 
+	copyResults(tmpResultIndices, tmpSquaredResultDistances, radius, resultIndices, squaredDistances);
+}
 
-	STANNPoint3D queryPoint(tmpX, tmpY, tmpZ);
-	this->resultIndices->clear();
-	squaredResultDistances->clear();
-	nearestPoint3DNeigborHandle->ksearch(queryPoint, k, *(this->resultIndices), *squaredResultDistances);
-	assert( static_cast<unsigned int>(this->resultIndices->size()) == static_cast<unsigned int>(k));
-	assert( static_cast<unsigned int>(this->resultIndices->size()) > 0);
-	assert( static_cast<unsigned int>(squaredResultDistances->size()) == static_cast<unsigned int>(k));
-	assert( static_cast<unsigned int>(squaredResultDistances->size()) > 0);
-
-	brics_3d::Coordinate resultDistance; //distance has same data-type as Coordinate, although the meaning is different
-	int resultIndex;
-	for (int i = 0; i < static_cast<int>(k); i++) {
-		resultDistance = static_cast<brics_3d::Coordinate>(sqrt((*squaredResultDistances)[i])); //seems to return squared distance (although documentation does not suggest)
-		resultIndex = static_cast<int>((*(this->resultIndices))[i]);
-		if (resultDistance <= maxDistance || maxDistance < 0.0) { //if max distance is < 0 then the distance should have no influence
-			resultIndices->push_back(resultIndex);
+void NearestNeighborSTANN::copyResults(const vector<long unsigned int>& stannIndices, const vector<double>& stannSquaredDistances, double distanceLimit,
+		std::vector<int>* resultIndices, std::vector<double>* squaredDistances) {
+	resultIndices->clear();
+	if (squaredDistances != 0) {
+		squaredDistances->clear();
+	}
+	for (unsigned int i = 0; i < stannIndices.size(); i++) {
+		if (distanceLimit < 0.0 || static_cast<brics_3d::Coordinate>(sqrt(stannSquaredDistances[i])) <= distanceLimit) { //if max distance is < 0 then the distance should have no influence
+			resultIndices->push_back(static_cast<int>(stannIndices[i]));
+			if (squaredDistances != 0) {
+				squaredDistances->push_back(stannSquaredDistances[i]);
+			}
 		}
 	}
 }
 
+bool NearestNeighborSTANN::supportsConcurrentQueries() const {
+	return true;
+}
+
 }
 
 /* EOF */
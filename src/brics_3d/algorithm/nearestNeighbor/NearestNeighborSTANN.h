@@ -28,6 +28,8 @@
 
 namespace brics_3d {
 
+class NearestNeighborBatchQuery;
+
 /**
  * @brief Dimension of generic k Nearest Neighbor search.
  *
@@ -82,8 +84,47 @@ public:
 	void findNearestNeighbors(vector<double>* query, std::vector<int>* resultIndices, unsigned int k = 1);
 	void findNearestNeighbors(Point3D* query, std::vector<int>* resultIndices, unsigned int k = 1);
 
+	void findNearestNeighbors(vector<double>* query, std::vector<int>* resultIndices, std::vector<double>* squaredDistances, unsigned int k);
+	void findNearestNeighbors(Point3D* query, std::vector<int>* resultIndices, std::vector<double>* squaredDistances, unsigned int k);
+
+	/**
+	 * @brief Batch query. The queries are distributed over multiple threads.
+	 */
+	void findNearestNeighbors(PointCloud3D* queries, NearestNeighborBatchResult* result, unsigned int k = 1);
+	void findNearestNeighbors(PointCloud3D* queries, const std::vector<int>& queryIndices, NearestNeighborBatchResult* result, unsigned int k = 1);
+
+	/**
+	 * @brief Radius search.
+	 *
+	 * STANN has no native radius search. The k nearest neighbor search is repeated with a doubled k
+	 * until the farthest neighbor is outside of the radius. Like the k nearest neighbor search of STANN
+	 * the result might be approximate for regularly sampled data.
+	 */
+	void findNeighborsWithinRadius(vector<double>* query, double radius, std::vector<int>* resultIndices, std::vector<double>* squaredDistances = 0);
+	void findNeighborsWithinRadius(Point3D* query, double radius, std::vector<int>* resultIndices, std::vector<double>* squaredDistances = 0);
+
+	/**
+	 * @brief Queries with Point3D use only local buffers and the STANN search itself is thread-safe.
+	 */
+	bool supportsConcurrentQueries() const;
+
+	/// Number of neighbors of the first k nearest neighbor search of a radius search.
+	static const unsigned int initialRadiusSearchSize = 16;
+
 protected:
 
+	/// Generic radius search on one of the two STANN handles. Only local buffers are used.
+	template <typename HandleT, typename PointT>
+	void findNeighborsWithinRadius(HandleT* handle, const PointT& queryPoint, unsigned int numberOfPoints, double radius,
+			std::vector<int>* resultIndices, std::vector<double>* squaredDistances);
+
+	/// Copy the STANN results that are within distanceLimit (< 0 for no limit). squaredDistances may be null.
+	void copyResults(const vector<long unsigned int>& stannIndices, const vector<double>& stannSquaredDistances, double distanceLimit,
+			std::vector<int>* resultIndices, std::vector<double>* squaredDistances);
+
+	/// Common part of both batch queries.
+	void findNearestNeighborsBatch(const NearestNeighborBatchQuery& queries, NearestNeighborBatchResult* result, unsigned int k);
+
 	/// Handle to the STANN data representation for 3D points (Morton ordering)
 	sfcnn<STANNPoint3D, STANNPoint3DDimension, double>* nearestPoint3DNeigborHandle;
 
@@ -0,0 +1,479 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+
+#include "NearestNeighborVoxelHash.h"
+#include "NearestNeighborBatchQuery.h"
+#include "KDTree3D.h"
+#include "brics_3d/core/ParallelProcessing.h"
+
+#include <assert.h>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+
+using std::runtime_error;
+
+namespace brics_3d {
+
+namespace {
+
+/**
+ * Largest absolute cell coordinate. The distance between two cells (a ring) is then at most 2^29,
+ * so a cell coordinate plus twice a ring as used by the shell traversal cannot overflow an int.
+ */
+const double cellCoordinateLimit = 268435456.0; // 2^28
+
+/// Initial number of slots of the hash table.
+const unsigned int minimumTableSize = 1024;
+
+inline unsigned int hashCell(int x, int y, int z) {
+	return (static_cast<unsigned int>(x) * 73856093u) ^ (static_cast<unsigned int>(y) * 19349663u) ^ (static_cast<unsigned int>(z) * 83492791u);
+}
+
+/// Cell coordinates of the points [begin, end). Flags points that are too far away from the origin for the cell size.
+template <typename AccessorT>
+void computeCellCoordinates(const AccessorT* points, double cellSize, unsigned int begin, unsigned int end, int* cellCoordinates, unsigned char* isOutOfRange) {
+	for (unsigned int i = begin; i < end; ++i) {
+		const double cell[3] = {std::floor(points->x(i) / cellSize), std::floor(points->y(i) / cellSize), std::floor(points->z(i) / cellSize)};
+		for (int axis = 0; axis < 3; ++axis) {
+			if (!(std::fabs(cell[axis]) <= cellCoordinateLimit)) { // also true for NaN
+				*isOutOfRange = 1;
+				cellCoordinates[3 * i + axis] = 0;
+			} else {
+				cellCoordinates[3 * i + axis] = static_cast<int>(cell[axis]);
+			}
+		}
+	}
+}
+
+/// Number of points per cell within the points [begin, end).
+void countPoints(const unsigned int* cellOfPoint, unsigned int begin, unsigned int end, unsigned int* counts) {
+	for (unsigned int i = begin; i < end; ++i) {
+		counts[cellOfPoint[i]]++;
+	}
+}
+
+/// Copy the points [begin, end) to their cells. offsets holds the next free position per cell.
+template <typename AccessorT>
+void copyPoints(const AccessorT* points, const unsigned int* cellOfPoint, unsigned int begin, unsigned int end, unsigned int* offsets,
+		Coordinate* x, Coordinate* y, Coordinate* z, int* pointIndices) {
+	for (unsigned int i = begin; i < end; ++i) {
+		unsigned int position = offsets[cellOfPoint[i]]++;
+		x[position] = points->x(i);
+		y[position] = points->y(i);
+		z[position] = points->z(i);
+		pointIndices[position] = static_cast<int>(i);
+	}
+}
+
+}
+
+/// Range search for a batch. The grid writes directly into the slots of the result.
+struct NearestNeighborVoxelHash::BatchSearch {
+	const NearestNeighborVoxelHash* grid;
+	double maxDistance;
+
+	void operator()(const NearestNeighborBatchQuery& queries, unsigned int begin, unsigned int end, unsigned int k, NearestNeighborBatchResult* result) {
+		double queryPoint[3];
+		for (unsigned int i = begin; i < end; ++i) {
+			const Point3D& query = queries.getPoint(i);
+			queryPoint[0] = query.getX();
+			queryPoint[1] = query.getY();
+			queryPoint[2] = query.getZ();
+			int* indices = &result->indices[i * k];
+			double* squaredDistances = &result->squaredDistances[i * k];
+			unsigned int count = grid->findNearestNeighbors(queryPoint, k, indices, squaredDistances);
+			result->offsets[i + 1] = NearestNeighborBatchQuery::applyMaxDistance(maxDistance, count, indices, squaredDistances);
+		}
+	}
+};
+
+NearestNeighborVoxelHash::NearestNeighborVoxelHash(double cellSize) {
+	this->dimension = -1;
+	this->maxDistance = -1; //default = disable
+	setCellSize(cellSize);
+	for (int i = 0; i < 6; ++i) {
+		cellBounds[i] = 0;
+	}
+}
+
+NearestNeighborVoxelHash::~NearestNeighborVoxelHash() {
+
+}
+
+void NearestNeighborVoxelHash::setData(PointCloud3D* data) {
+	assert(data != 0);
+	build(PointCloud3DAdaptor(data));
+}
+
+void NearestNeighborVoxelHash::setData(PointCloud3DContiguous* data) {
+	assert(data != 0);
+	build(PointCloud3DContiguousAdaptor<Coordinate>(data));
+}
+
+template <typename AccessorT>
+void NearestNeighborVoxelHash::build(const AccessorT& points) {
+	dimension = -1;
+	cells.clear();
+	table.assign(minimumTableSize, -1);
+	unsigned int count = points.size();
+	xCoordinates.resize(count);
+	yCoordinates.resize(count);
+	zCoordinates.resize(count);
+	pointIndices.resize(count);
+	if (count == 0) {
+		dimension = 3;
+		return;
+	}
+
+	unsigned int numberOfThreads = ParallelProcessing::getNumberOfThreads(count, parallelThreshold, maxNumberOfThreads);
+	unsigned int chunkSize = count / numberOfThreads;
+
+	/* cell coordinates of all points; the last range is processed by the calling thread */
+	std::vector<int> cellCoordinates(3 * count);
+	std::vector<unsigned char> isOutOfRange(numberOfThreads, 0);
+	boost::thread_group workers;
+	for (unsigned int i = 0; i < numberOfThreads - 1; ++i) {
+		workers.create_thread(boost::bind(&computeCellCoordinates<AccessorT>, &points, cellSize, i * chunkSize, (i + 1) * chunkSize, &cellCoordinates[0], &isOutOfRange[i]));
+	}
+	computeCellCoordinates(&points, cellSize, (numberOfThreads - 1) * chunkSize, count, &cellCoordinates[0], &isOutOfRange[numberOfThreads - 1]);
+	workers.join_all();
+	for (unsigned int i = 0; i < numberOfThreads; ++i) {
+		if (isOutOfRange[i] != 0) {
+			throw runtime_error("The points are too far away from the origin for the cell size of the hash grid.");
+		}
+	}
+
+	/* look up or create the cell of every point; this pass over the hash table is sequential */
+	std::vector<unsigned int> cellOfPoint(count);
+	for (unsigned int i = 0; i < count; ++i) {
+		const int* cell = &cellCoordinates[3 * i];
+		int cellIndex = findCell(cell[0], cell[1], cell[2]);
+		if (cellIndex < 0) {
+			Cell newCell;
+			newCell.x = cell[0];
+			newCell.y = cell[1];
+			newCell.z = cell[2];
+			newCell.begin = 0;
+			newCell.end = 0;
+			cellIndex = static_cast<int>(cells.size());
+			cells.push_back(newCell);
+			insertCell(cellIndex);
+		}
+		cellOfPoint[i] = static_cast<unsigned int>(cellIndex);
+	}
+	std::vector<int>().swap(cellCoordinates);
+
+	/* counting sort by cell: every range counts its points per cell and gets its own positions within each cell */
+	unsigned int numberOfCells = static_cast<unsigned int>(cells.size());
+	std::vector<unsigned int> offsets(numberOfThreads * numberOfCells, 0);
+	for (unsigned int i = 0; i < numberOfThreads - 1; ++i) {
+		workers.create_thread(boost::bind(&countPoints, &cellOfPoint[0], i * chunkSize, (i + 1) * chunkSize, &offsets[i * numberOfCells]));
+	}
+	countPoints(&cellOfPoint[0], (numberOfThreads - 1) * chunkSize, count, &offsets[(numberOfThreads - 1) * numberOfCells]);
+	workers.join_all();
+
+	unsigned int position = 0;
+	for (unsigned int c = 0; c < numberOfCells; ++c) {
+		cells[c].begin = position;
+		for (unsigned int i = 0; i < numberOfThreads; ++i) {
+			unsigned int numberOfPoints = offsets[i * numberOfCells + c];
+			offsets[i * numberOfCells + c] = position;
+			position += numberOfPoints;
+		}
+		cells[c].end = position;
+	}
+
+	for (unsigned int i = 0; i < numberOfThreads - 1; ++i) {
+		workers.create_thread(boost::bind(&copyPoints<AccessorT>, &points, &cellOfPoint[0], i * chunkSize, (i + 1) * chunkSize, &offsets[i * numberOfCells],
+				&xCoordinates[0], &yCoordinates[0], &zCoordinates[0], &pointIndices[0]));
+	}
+	copyPoints(&points, &cellOfPoint[0], (numberOfThreads - 1) * chunkSize, count, &offsets[(numberOfThreads - 1) * numberOfCells],
+			&xCoordinates[0], &yCoordinates[0], &zCoordinates[0], &pointIndices[0]);
+	workers.join_all();
+
+	cellBounds[0] = cellBounds[3] = cells[0].x;
+	cellBounds[1] = cellBounds[4] = cells[0].y;
+	cellBounds[2] = cellBounds[5] = cells[0].z;
+	for (unsigned int c = 1; c < numberOfCells; ++c) {
+		cellBounds[0] = std::min(cellBounds[0], cells[c].x);
+		cellBounds[1] = std::min(cellBounds[1], cells[c].y);
+		cellBounds[2] = std::min(cellBounds[2], cells[c].z);
+		cellBounds[3] = std::max(cellBounds[3], cells[c].x);
+		cellBounds[4] = std::max(cellBounds[4], cells[c].y);
+		cellBounds[5] = std::max(cellBounds[5], cells[c].z);
+	}
+	dimension = 3;
+}
+
+int NearestNeighborVoxelHash::toCell(double coordinate) const {
+	double cell = std::floor(coordinate / cellSize);
+	if (cell < -cellCoordinateLimit) {
+		return -static_cast<int>(cellCoordinateLimit);
+	} else if (cell > cellCoordinateLimit) {
+		return static_cast<int>(cellCoordinateLimit);
+	} else if (cell != cell) { // NaN
+		return 0;
+	}
+	return static_cast<int>(cell);
+}
+
+int NearestNeighborVoxelHash::findCell(int x, int y, int z) const {
+	unsigned int mask = static_cast<unsigned int>(table.size()) - 1;
+	for (unsigned int slot = hashCell(x, y, z) & mask; table[slot] >= 0; slot = (slot + 1) & mask) {
+		const Cell& cell = cells[table[slot]];
+		if (cell.x == x && cell.y == y && cell.z == z) {
+			return table[slot];
+		}
+	}
+	return -1;
+}
+
+void NearestNeighborVoxelHash::insertCell(unsigned int cellIndex) {
+	/* keep the load factor below 1/2, so the probe sequences stay short */
+	if (2 * cells.size() > table.size()) {
+		table.assign(2 * table.size(), -1);
+		for (unsigned int c = 0; c < cellIndex; ++c) {
+			insertCell(c);
+		}
+	}
+	unsigned int mask = static_cast<unsigned int>(table.size()) - 1;
+	const Cell& cell = cells[cellIndex];
+	unsigned int slot = hashCell(cell.x, cell.y, cell.z) & mask;
+	while (table[slot] >= 0) {
+		slot = (slot + 1) & mask;
+	}
+	table[slot] = static_cast<int>(cellIndex);
+}
+
+void NearestNeighborVoxelHash::scanCell(const Cell& cell, const double* query, unsigned int k, unsigned int* count, int* resultIndices, double* squaredDistances) const {
+	for (unsigned int i = cell.begin; i < cell.end; ++i) {
+		double dx = xCoordinates[i] - query[0];
+		double dy = yCoordinates[i] - query[1];
+		double dz = zCoordinates[i] - query[2];
+		insertNearestNeighbor(pointIndices[i], dx * dx + dy * dy + dz * dz, k, count, resultIndices, squaredDistances);
+	}
+}
+
+unsigned int NearestNeighborVoxelHash::findNearestNeighbors(const double* query, unsigned int k, int* resultIndices, double* squaredDistances) const {
+	unsigned int count = 0;
+	if (k == 0 || cells.empty()) {
+		return count;
+	}
+
+	const int center[3] = {toCell(query[0]), toCell(query[1]), toCell(query[2])};
+
+	/* all points closer than the distance of the query to the faces of its cell plus ring * cellSize are found after the shells up to ring */
+	double innerDistance = std::numeric_limits<double>::max();
+	int lastRing = 0; // the shell that reaches the farthest occupied cell
+	for (int axis = 0; axis < 3; ++axis) {
+		double lower = query[axis] - center[axis] * cellSize;
+		double upper = (center[axis] + 1) * cellSize - query[axis];
+		innerDistance = std::min(innerDistance, std::max(0.0, std::min(lower, upper)));
+		lastRing = std::max(lastRing, std::max(center[axis] - cellBounds[axis], cellBounds[3 + axis] - center[axis]));
+	}
+
+	for (int ring = 0; ring <= lastRing; ++ring) {
+		/* the shell has more cells than the grid: scan all remaining cells directly */
+		double numberOfShellCells = (ring == 0) ? 1.0 : 24.0 * ring * ring + 2.0;
+		if (numberOfShellCells > cells.size()) {
+			for (unsigned int c = 0; c < cells.size(); ++c) {
+				const Cell& cell = cells[c];
+				int distance = std::max(std::abs(cell.x - center[0]), std::max(std::abs(cell.y - center[1]), std::abs(cell.z - center[2])));
+				if (distance >= ring) {
+					scanCell(cell, query, k, &count, resultIndices, squaredDistances);
+				}
+			}
+			break;
+		}
+
+		/* only the cells on the surface of the cube with the Chebyshev distance ring, clipped to the occupied cells */
+		int zBegin = std::max(center[2] - ring, cellBounds[2]);
+		int zEnd = std::min(center[2] + ring, cellBounds[5]);
+		int yBegin = std::max(center[1] - ring, cellBounds[1]);
+		int yEnd = std::min(center[1] + ring, cellBounds[4]);
+		int xBegin = std::max(center[0] - ring, cellBounds[0]);
+		int xEnd = std::min(center[0] + ring, cellBounds[3]);
+		for (int z = zBegin; z <= zEnd; ++z) {
+			bool isZFace = (std::abs(z - center[2]) == ring);
+			for (int y = yBegin; y <= yEnd; ++y) {
+				bool isFace = isZFace || (std::abs(y - center[1]) == ring);
+				int xStep = (isFace || ring == 0) ? 1 : 2 * ring;
+				for (int x = (isFace ? xBegin : center[0] - ring); x <= xEnd; x += xStep) {
+					if (x < xBegin) {
+						continue;
+					}
+					int cellIndex = findCell(x, y, z);
+					if (cellIndex >= 0) {
+						scanCell(cells[cellIndex], query, k, &count, resultIndices, squaredDistances);
+					}
+				}
+			}
+		}
+
+		double coveredDistance = innerDistance + ring * cellSize;
+		if (count == k && squaredDistances[k - 1] <= coveredDistance * coveredDistance) {
+			break;
+		}
+	}
+	return count;
+}
+
+unsigned int NearestNeighborVoxelHash::getNumberOfDataPoints() const {
+	if (dimension < 0) {
+		throw runtime_error("No data set for the nearest neighbor search.");
+	}
+	return static_cast<unsigned int>(pointIndices.size());
+}
+
+void NearestNeighborVoxelHash::findNearestNeighbors(Point3D* query, std::vector<int>* resultIndices, unsigned int k) {
+	std::vector<double> squaredDistances;
+	findNearestNeighbors(query, resultIndices, &squaredDistances, k);
+}
+
+void NearestNeighborVoxelHash::findNearestNeighbors(Point3D* query, std::vector<int>* resultIndices, std::vector<double>* squaredDistances, unsigned int k) {
+	assert (query != 0);
+	assert (resultIndices != 0);
+	assert (squaredDistances != 0);
+	if (k > getNumberOfDataPoints()) {
+		throw runtime_error("Number of neighbors k is bigger than the amount of data points.");
+	}
+
+	resultIndices->resize(k);
+	squaredDistances->resize(k);
+	if (k == 0) {
+		return;
+	}
+
+	double queryPoint[3] = {query->getX(), query->getY(), query->getZ()};
+	unsigned int count = findNearestNeighbors(queryPoint, k, &(*resultIndices)[0], &(*squaredDistances)[0]);
+	count = NearestNeighborBatchQuery::applyMaxDistance(maxDistance, count, &(*resultIndices)[0], &(*squaredDistances)[0]);
+	resultIndices->resize(count);
+	squaredDistances->resize(count);
+}
+
+void NearestNeighborVoxelHash::findNeighborsWithinRadius(Point3D* query, double radius, std::vector<int>* resultIndices, std::vector<double>* squaredDistances) {
+	assert (query != 0);
+	assert (resultIndices != 0);
+	getNumberOfDataPoints(); // throws without data
+	resultIndices->clear();
+	if (squaredDistances != 0) {
+		squaredDistances->clear();
+	}
+	if (radius < 0.0 || cells.empty()) {
+		return;
+	}
+
+	double queryPoint[3] = {query->getX(), query->getY(), query->getZ()};
+	double squaredRadius = radius * radius;
+	int begin[3];
+	int end[3];
+	double numberOfRangeCells = 1.0;
+	for (int axis = 0; axis < 3; ++axis) {
+		begin[axis] = std::max(toCell(queryPoint[axis] - radius), cellBounds[axis]);
+		end[axis] = std::min(toCell(queryPoint[axis] + radius), cellBounds[3 + axis]);
+		if (begin[axis] > end[axis]) {
+			return;
+		}
+		numberOfRangeCells *= end[axis] - begin[axis] + 1.0;
+	}
+
+	/* for large radii it is cheaper to check all occupied cells than to look up every cell of the range */
+	std::vector<unsigned int> rangeCells;
+	if (numberOfRangeCells > cells.size()) {
+		for (unsigned int c = 0; c < cells.size(); ++c) {
+			const Cell& cell = cells[c];
+			if (cell.x >= begin[0] && cell.x <= end[0] && cell.y >= begin[1] && cell.y <= end[1] && cell.z >= begin[2] && cell.z <= end[2]) {
+				rangeCells.push_back(c);
+			}
+		}
+	} else {
+		for (int z = begin[2]; z <= end[2]; ++z) {
+			for (int y = begin[1]; y <= end[1]; ++y) {
+				for (int x = begin[0]; x <= end[0]; ++x) {
+					int cellIndex = findCell(x, y, z);
+					if (cellIndex >= 0) {
+						rangeCells.push_back(static_cast<unsigned int>(cellIndex));
+					}
+				}
+			}
+		}
+	}
+
+	for (unsigned int c = 0; c < rangeCells.size(); ++c) {
+		const Cell& cell = cells[rangeCells[c]];
+		for (unsigned int i = cell.begin; i < cell.end; ++i) {
+			double dx = xCoordinates[i] - queryPoint[0];
+			double dy = yCoordinates[i] - queryPoint[1];
+			double dz = zCoordinates[i] - queryPoint[2];
+			double distance = dx * dx + dy * dy + dz * dz;
+			if (distance <= squaredRadius) {
+				resultIndices->push_back(pointIndices[i]);
+				if (squaredDistances != 0) {
+					squaredDistances->push_back(distance);
+				}
+			}
+		}
+	}
+}
+
+void NearestNeighborVoxelHash::findNearestNeighbors(PointCloud3D* queries, NearestNeighborBatchResult* result, unsigned int k) {
+	findNearestNeighborsBatch(NearestNeighborBatchQuery(queries, 0), result, k);
+}
+
+void NearestNeighborVoxelHash::findNearestNeighbors(PointCloud3D* queries, const std::vector<int>& queryIndices, NearestNeighborBatchResult* result, unsigned int k) {
+	findNearestNeighborsBatch(NearestNeighborBatchQuery(queries, &queryIndices), result, k);
+}
+
+void NearestNeighborVoxelHash::findNearestNeighborsBatch(const NearestNeighborBatchQuery& queries, NearestNeighborBatchResult* result, unsigned int k) {
+	assert (result != 0);
+	if (k > getNumberOfDataPoints()) {
+		throw runtime_error("Number of neighbors k is bigger than the amount of data points.");
+	}
+
+	BatchSearch search;
+	search.grid = this;
+	search.maxDistance = maxDistance;
+	queries.process(search, k, maxNumberOfThreads, true, result);
+}
+
+bool NearestNeighborVoxelHash::supportsConcurrentQueries() const {
+	return true;
+}
+
+void NearestNeighborVoxelHash::setCellSize(double cellSize) {
+	if (!(cellSize > 0.0)) {
+		throw runtime_error("The cell size has to be positive.");
+	}
+	this->cellSize = cellSize;
+}
+
+double NearestNeighborVoxelHash::getCellSize() const {
+	return cellSize;
+}
+
+unsigned int NearestNeighborVoxelHash::getNumberOfCells() const {
+	return static_cast<unsigned int>(cells.size());
+}
+
+}
+
+/* EOF */
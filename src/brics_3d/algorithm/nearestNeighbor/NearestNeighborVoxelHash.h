@@ -0,0 +1,162 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+
+#ifndef BRICS_3D_NEARESTNEIGHBORVOXELHASH_H_
+#define BRICS_3D_NEARESTNEIGHBORVOXELHASH_H_
+
+#include "brics_3d/algorithm/nearestNeighbor/INearestPoint3DNeighbor.h"
+#include "brics_3d/algorithm/nearestNeighbor/INearestNeighborSetup.h"
+#include "brics_3d/core/PointCloud3DContiguous.h"
+
+namespace brics_3d {
+
+class NearestNeighborBatchQuery;
+
+/**
+ * @ingroup nearestNeighbor
+ * @brief Implementation for the nearest neighbor search algorithm with a uniform hash grid.
+ *
+ * The space is divided into cubic cells with an edge length of getCellSize(). Only the occupied cells
+ * are stored in a hash table, and the points are copied into one contiguous array ordered by cell.
+ * The grid is built in O(n); for large point clouds the cell coordinates and the copying are distributed
+ * over multiple threads.
+ *
+ * The grid is made for a known, fixed neighborhood size, e.g. the tolerance of a clustering or the
+ * radius of a normal estimation: if the cell size is about the search radius, a radius search scans
+ * only the 27 cells around the query. A k nearest neighbor search starts with these cells as well and
+ * continues with the surrounding shells of cells only if fewer than k neighbors are found within the
+ * scanned distance. So the search is exact, but it is slow for queries far away from the data or for
+ * a cell size that is much too small. The queries may be issued concurrently.
+ *
+ */
+class NearestNeighborVoxelHash : public INearestPoint3DNeighbor, public INearestNeighborSetup {
+public:
+
+	/// Threshold for ParallelProcessing::getNumberOfThreads().
+	static const unsigned int parallelThreshold = 50000;
+
+	/**
+	 * @brief Standard constructor
+	 * @param cellSize Edge length of a cell. The default of 0.05 is suited for a radius of 5cm on data in meters.
+	 */
+	NearestNeighborVoxelHash(double cellSize = 0.05);
+
+	/**
+	 * @brief Standard destructor
+	 */
+	virtual ~NearestNeighborVoxelHash();
+
+	void setData(PointCloud3D* data);
+
+	/**
+	 * @brief Set the data from a contiguous point cloud. The coordinate columns are read directly.
+	 */
+	void setData(PointCloud3DContiguous* data);
+
+	void findNearestNeighbors(Point3D* query, std::vector<int>* resultIndices, unsigned int k = 1);
+	void findNearestNeighbors(Point3D* query, std::vector<int>* resultIndices, std::vector<double>* squaredDistances, unsigned int k);
+	void findNeighborsWithinRadius(Point3D* query, double radius, std::vector<int>* resultIndices, std::vector<double>* squaredDistances = 0);
+
+	/**
+	 * @brief Batch query. The queries are distributed over multiple threads.
+	 */
+	void findNearestNeighbors(PointCloud3D* queries, NearestNeighborBatchResult* result, unsigned int k = 1);
+	void findNearestNeighbors(PointCloud3D* queries, const std::vector<int>& queryIndices, NearestNeighborBatchResult* result, unsigned int k = 1);
+
+	/**
+	 * @brief The queries only use local state.
+	 */
+	bool supportsConcurrentQueries() const;
+
+	/**
+	 * @brief Edge length of a cell. Takes effect with the next setData(). Throws a runtime_error if it is not positive.
+	 */
+	void setCellSize(double cellSize);
+
+	double getCellSize() const;
+
+	/// Number of occupied cells of the current grid.
+	unsigned int getNumberOfCells() const;
+
+private:
+
+	/// An occupied cell. Its points are the range [begin, end) of the sorted point arrays.
+	struct Cell {
+		int x;
+		int y;
+		int z;
+		unsigned int begin;
+		unsigned int end;
+	};
+
+	/// Range search for a batch, defined in the implementation file.
+	struct BatchSearch;
+
+	/// Build the grid from the points of an accessor (see KDTree3D).
+	template <typename AccessorT>
+	void build(const AccessorT& points);
+
+	/// Cell coordinate of a point coordinate. Out of range values are clamped, see setData().
+	int toCell(double coordinate) const;
+
+	/// Index of the cell into cells, or -1 if it is not occupied.
+	int findCell(int x, int y, int z) const;
+
+	/// Insert a cell into the hash table. Grows the table if it gets too full.
+	void insertCell(unsigned int cellIndex);
+
+	/// Add the points of a cell to the k nearest neighbors found so far.
+	void scanCell(const Cell& cell, const double* query, unsigned int k, unsigned int* count, int* resultIndices, double* squaredDistances) const;
+
+	/// k nearest neighbor search. The results are sorted by increasing distance.
+	unsigned int findNearestNeighbors(const double* query, unsigned int k, int* resultIndices, double* squaredDistances) const;
+
+	/// Common part of both batch queries.
+	void findNearestNeighborsBatch(const NearestNeighborBatchQuery& queries, NearestNeighborBatchResult* result, unsigned int k);
+
+	/// Number of points of the current grid. Throws if no data is set.
+	unsigned int getNumberOfDataPoints() const;
+
+	/// Edge length of a cell
+	double cellSize;
+
+	/// All occupied cells
+	std::vector<Cell> cells;
+
+	/// Open addressing hash table with indices into cells; -1 marks a free slot. The size is a power of two.
+	std::vector<int> table;
+
+	/// Minimum and maximum x, y and z of the occupied cells
+	int cellBounds[6];
+
+	/// Coordinates of the points, ordered by cell
+	std::vector<Coordinate> xCoordinates;
+	std::vector<Coordinate> yCoordinates;
+	std::vector<Coordinate> zCoordinates;
+
+	/// Index into the original point cloud for every point
+	std::vector<int> pointIndices;
+};
+
+}
+
+#endif /* BRICS_3D_NEARESTNEIGHBORVOXELHASH_H_ */
+
+/* EOF */
@@ -51,17 +51,15 @@ void PointCorrespondenceGenericNN::createNearestNeighborCorrespondence(PointClou
 	/* prepare data */
 	nearestNeighborAlgorithm->setData(pointCloud1);
 
-	/* search for each point in pointCloud2 */
-	vector<int> resultIndices;
-	int resultIndex;
-	int k = 1; //only the nearest neighbor is considered
+	/* search for all points in pointCloud2 at once; only the nearest neighbor is considered */
+	NearestNeighborBatchResult neighbors;
+	nearestNeighborAlgorithm->findNearestNeighbors(pointCloud2, &neighbors, 1);
+	resultPointPairs->reserve(neighbors.indices.size());
 
 	for (unsigned int i = 0; i < pointCloud2->getSize(); i++) {
 
-		nearestNeighborAlgorithm->findNearestNeighbors( &(*pointCloud2->getPointCloud())[i], &resultIndices, k);
-
-		if (resultIndices.size() > 0) {
-			resultIndex = resultIndices[0];
+		if (neighbors.getNumberOfNeighbors(i) > 0) {
+			int resultIndex = neighbors.getIndices(i)[0];
 			assert (resultIndex < static_cast<int>(pointCloud1->getSize())); //plausibility check if result is in range
 
 			Point3D firstPoint = Point3D (&((*pointCloud1->getPointCloud())[resultIndex]));
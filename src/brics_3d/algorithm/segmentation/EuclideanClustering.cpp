@@ -34,14 +34,10 @@ EuclideanClustering::~EuclideanClustering() {
 void EuclideanClustering::extractClusters(brics_3d::PointCloud3D *inCloud){
 
 
-	int k = inCloud->getSize();
 	brics_3d::NearestNeighborANN nearestneighborSearch;
-	brics_3d::Point3D querryPoint3D;
 	vector<int> neighborIndices;
 
 	nearestneighborSearch.setData(inCloud);
-	nearestneighborSearch.setMaxDistance(this->clusterTolerance);
-	//	nearestneighborSearch.setMaxDistance(1000);
 	// Create a bool vector of processed point indices, and initialize it to false
 	std::vector<bool> processed (inCloud->getSize(), false);
 
@@ -55,25 +51,15 @@ void EuclideanClustering::extractClusters(brics_3d::PointCloud3D *inCloud){
 		std::vector<int> seed_queue;
 		int sq_idx = 0;
 		seed_queue.push_back (i);
-		//std::cout << "[CHEAT][EuclideanClustering3D] "<< i << " : " << seed_queue.size () << std::endl;
 		processed[i] = true;
 
 		while (sq_idx < (int)seed_queue.size ())
 		{
 
-			// Search for sq_idx
-			neighborIndices.clear();
-			querryPoint3D = (*inCloud->getPointCloud())[sq_idx];
-			nearestneighborSearch.findNearestNeighbors(&querryPoint3D, &neighborIndices, k);
+			// Search for all neighbors of the seed within the cluster tolerance
+			nearestneighborSearch.findNeighborsWithinRadius(&(*inCloud->getPointCloud())[seed_queue[sq_idx]], this->clusterTolerance, &neighborIndices);
 
-			//if (!tree->radiusSearch (seed_queue[sq_idx], tolerance, nn_indices, nn_distances))
-			if(neighborIndices.size()==0)
-			{
-				sq_idx++;
-				continue;
-			}
-
-			for (size_t j = 0; j < neighborIndices.size(); ++j)             // nn_indices[0] should be sq_idx
+			for (size_t j = 0; j < neighborIndices.size(); ++j)             // the seed itself is part of the result
 			{
 				if (processed[neighborIndices[j]])                             // Has this point been processed before ?
 					continue;
@@ -93,10 +79,11 @@ void EuclideanClustering::extractClusters(brics_3d::PointCloud3D *inCloud){
 
 			seed_queue.erase(std::unique(seed_queue.begin(), seed_queue.end()),seed_queue.end());
 			brics_3d::PointCloud3D *tempPointCloud =  new brics_3d::PointCloud3D();
+			tempPointCloud->setArena(inCloud->getArena()); // clusters share the arena of the input (if any)
 
 			for (size_t j = 0; j < seed_queue.size (); ++j) {
 
-				tempPointCloud->addPointPtr((*inCloud->getPointCloud())[seed_queue[j]].clone());
+				tempPointCloud->addPointClone((*inCloud->getPointCloud())[seed_queue[j]]);
 
 			}
 			extractedClusters.push_back(tempPointCloud);
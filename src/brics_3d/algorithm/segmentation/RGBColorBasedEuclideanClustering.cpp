@@ -19,6 +19,7 @@
 #include "brics_3d/util/PCLTypecaster.h"
 #include "brics_3d/core/ColorSpaceConvertor.h"
 #include "brics_3d/core/Logger.h"
+#include "brics_3d/core/PointCloud3DContiguous.h"
 
 #include <pcl/segmentation/extract_clusters.h>
 #include <pcl/point_types.h>
@@ -97,10 +98,16 @@ int RGBColorBasedEuclideanClustering::getMaxClusterSize() const
     	this->extractedClusters.clear();
         brics_3d::PCLTypecaster pclTypecaster;
         pcl::PointCloud<pcl::PointXYZ>::Ptr inputXYZ(new pcl::PointCloud<pcl::PointXYZ>());
-        pcl::PointCloud<pcl::PointXYZRGB>::Ptr inputXYZRGB(new pcl::PointCloud<pcl::PointXYZRGB>());
 
         pclTypecaster.convertToPCLDataType(inputXYZ, inCloud);
-        pclTypecaster.convertToPCLDataType(inputXYZRGB, inCloud);
+
+        /* gather the colors once into a packed RGB8 channel */
+        brics_3d::PointCloud3DContiguous packedCloud;
+        packedCloud.copyFrom(inCloud);
+        if (!packedCloud.hasColors()) {
+        	packedCloud.enableColors();
+        }
+        const unsigned char* colors = packedCloud.getColors();
 
 
         // Creating the KdTree object for the search method of the extraction
@@ -135,13 +142,7 @@ int RGBColorBasedEuclideanClustering::getMaxClusterSize() const
 					continue;                            // Has this point been processed before ?
 				} else {
 					// Perform a simple Euclidean clustering
-					float rgbVal24Bit = inputXYZRGB->points[i].rgb;
-					uint32_t seed_rgb = *reinterpret_cast<int*> (&rgbVal24Bit);
-
-					rgbVal24Bit = inputXYZRGB->points[nn_indices[j]].rgb;
-					uint32_t current_rgb = *reinterpret_cast<int*> (&rgbVal24Bit);
-
-					if(isSimilar(seed_rgb, current_rgb)){	//colors are similar
+					if(isSimilar(&colors[3 * i], &colors[3 * nn_indices[j]])){	//colors are similar
 						seed_queue.push_back (nn_indices[j]);
 						processed[nn_indices[j]] = true;
 					}
@@ -160,14 +161,9 @@ int RGBColorBasedEuclideanClustering::getMaxClusterSize() const
 
 			for (size_t j = 0; j < seed_queue.size (); ++j) {
 
+				const unsigned char* rgb = &colors[3 * seed_queue[j]];
 				brics_3d::ColoredPoint3D *tempPoint =  new brics_3d::ColoredPoint3D(
-						new brics_3d::Point3D(
-								(*inputPointCloud->getPointCloud())[seed_queue[j]].getX(),
-								(*inputPointCloud->getPointCloud())[seed_queue[j]].getY(),
-								(*inputPointCloud->getPointCloud())[seed_queue[j]].getZ()),
-								(*inputPointCloud->getPointCloud())[seed_queue[j]].asColoredPoint3D()->getR(),
-								(*inputPointCloud->getPointCloud())[seed_queue[j]].asColoredPoint3D()->getG(),
-								(*inputPointCloud->getPointCloud())[seed_queue[j]].asColoredPoint3D()->getB());
+						new brics_3d::Point3D(packedCloud.getPoint(seed_queue[j])), rgb[0], rgb[1], rgb[2]);
 				tempPointCloud->addPointPtr(tempPoint);
 
 				//				delete tempPoint;
@@ -36,27 +36,18 @@ class RGBColorBasedEuclideanClustering : public ISegmentation{
 
 private:
 
-	bool isSimilar(uint32_t rgb_24bit_first, uint32_t rgb_24bit_second){
+	/**
+	 * Compare two colors from a packed RGB8 channel (cf. brics_3d::PointCloud3DContiguous::getColors()).
+	 */
+	bool isSimilar(const unsigned char* rgbFirst, const unsigned char* rgbSecond){
 
-		int rgb_first[3], rgb_second[3];
+		int redDistance = rgbSecond[0] - rgbFirst[0];
+		int greenDistance = rgbSecond[1] - rgbFirst[1];
+		int blueDistance = rgbSecond[2] - rgbFirst[2];
 
-		rgb_first[0] = ((rgb_24bit_first >> 16) & 0xff);
-		rgb_first[1] = ((rgb_24bit_first >> 8) & 0xff);
-		rgb_first[2] = (rgb_24bit_first & 0xff);
+		double currentDistanceRGBSpaceSquared = redDistance * redDistance + greenDistance * greenDistance + blueDistance * blueDistance;
 
-		rgb_second[0] = ((rgb_24bit_second >> 16) & 0xff);
-		rgb_second[1] = ((rgb_24bit_second >> 8) & 0xff);
-		rgb_second[2] = (rgb_24bit_second & 0xff);
-
-		double currentDistanceRGBSpace = 	std::sqrt((rgb_second[0]-rgb_first[0])*(rgb_second[0]-rgb_first[0]) +
-				(rgb_second[1]-rgb_first[1])*(rgb_second[1]-rgb_first[1]) +
-				(rgb_second[2]-rgb_first[2])*(rgb_second[2]-rgb_first[2]));
-
-		if(currentDistanceRGBSpace <= toleranceRGBSpace){
-			return true;
-		} else {
-			return false;
-		}
+		return (currentDistanceRGBSpaceSquared <= toleranceRGBSpace * toleranceRGBSpace && toleranceRGBSpace >= 0);
 
 	}
 
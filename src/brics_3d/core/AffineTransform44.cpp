@@ -0,0 +1,239 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+#include "AffineTransform44.h"
+
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+namespace brics_3d {
+
+/*
+ * column-row layout:
+ * 0 4 8  12
+ * 1 5 9  13
+ * 2 6 10 14
+ * 3 7 11 15
+ */
+static const double identityData[AffineTransform44::matrixElements] = {
+		1.0, 0.0, 0.0, 0.0,
+		0.0, 1.0, 0.0, 0.0,
+		0.0, 0.0, 1.0, 0.0,
+		0.0, 0.0, 0.0, 1.0
+};
+
+AffineTransform44::AffineTransform44() {
+	setIdentity();
+}
+
+AffineTransform44::AffineTransform44(double r0, double r1, double r2, double r3, double r4, double r5, double r6, double r7, double r8, double t0, double t1, double t2) {
+	setIdentity();
+
+	/* rotation */
+	matrixData[matrixEntry::r11] = r0;
+	matrixData[matrixEntry::r12] = r1;
+	matrixData[matrixEntry::r13] = r2;
+	matrixData[matrixEntry::r21] = r3;
+	matrixData[matrixEntry::r22] = r4;
+	matrixData[matrixEntry::r23] = r5;
+	matrixData[matrixEntry::r31] = r6;
+	matrixData[matrixEntry::r32] = r7;
+	matrixData[matrixEntry::r33] = r8;
+
+	/* translation */
+	matrixData[matrixEntry::x] = t0;
+	matrixData[matrixEntry::y] = t1;
+	matrixData[matrixEntry::z] = t2;
+}
+
+AffineTransform44::AffineTransform44(const IHomogeneousMatrix44& matrix) {
+	memcpy(matrixData, matrix.getRawData(), sizeof(double)*matrixElements);
+}
+
+AffineTransform44::AffineTransform44(const double* rawData) {
+	assert(rawData != 0);
+	memcpy(matrixData, rawData, sizeof(double)*matrixElements);
+}
+
+AffineTransform44& AffineTransform44::operator=(const IHomogeneousMatrix44& matrix) {
+	memcpy(matrixData, matrix.getRawData(), sizeof(double)*matrixElements);
+	return *this;
+}
+
+void AffineTransform44::copyTo(IHomogeneousMatrix44* matrix) const {
+	assert(matrix != 0);
+	memcpy(matrix->setRawData(), matrixData, sizeof(double)*matrixElements);
+}
+
+const double* AffineTransform44::getRawData() const {
+	return matrixData;
+}
+
+double* AffineTransform44::setRawData() {
+	return matrixData;
+}
+
+void AffineTransform44::setIdentity() {
+	memcpy(matrixData, identityData, sizeof(double)*matrixElements);
+}
+
+bool AffineTransform44::isIdentity(double precision) const {
+	for (int i = 0; i < matrixElements; ++i) {
+		if (std::fabs(matrixData[i] - identityData[i]) > precision) {
+			return false;
+		}
+	}
+	return true;
+}
+
+AffineTransform44& AffineTransform44::operator*=(const AffineTransform44& transform) {
+	multiply(matrixData, transform.matrixData, matrixData);
+	return *this;
+}
+
+AffineTransform44& AffineTransform44::operator*=(const IHomogeneousMatrix44& matrix) {
+	multiply(matrixData, matrix.getRawData(), matrixData);
+	return *this;
+}
+
+AffineTransform44& AffineTransform44::premultiply(const AffineTransform44& transform) {
+	multiply(transform.matrixData, matrixData, matrixData);
+	return *this;
+}
+
+bool AffineTransform44::invert() {
+	const double* m = matrixData;
+
+	/* inverse of the rotational part via cofactors */
+	double c11 = m[5]*m[10] - m[9]*m[6];
+	double c12 = m[8]*m[6] - m[4]*m[10];
+	double c13 = m[4]*m[9] - m[8]*m[5];
+	double determinant = m[0]*c11 + m[1]*c12 + m[2]*c13;
+	if (std::fabs(determinant) < 1e-12) {
+		return false;
+	}
+	double invDeterminant = 1.0 / determinant;
+
+	double inverse[matrixElements];
+	inverse[0] = c11 * invDeterminant;
+	inverse[4] = c12 * invDeterminant;
+	inverse[8] = c13 * invDeterminant;
+	inverse[1] = (m[9]*m[2] - m[1]*m[10]) * invDeterminant;
+	inverse[5] = (m[0]*m[10] - m[8]*m[2]) * invDeterminant;
+	inverse[9] = (m[8]*m[1] - m[0]*m[9]) * invDeterminant;
+	inverse[2] = (m[1]*m[6] - m[5]*m[2]) * invDeterminant;
+	inverse[6] = (m[4]*m[2] - m[0]*m[6]) * invDeterminant;
+	inverse[10] = (m[0]*m[5] - m[4]*m[1]) * invDeterminant;
+
+	/* translation: -R^-1 * t */
+	inverse[12] = -(inverse[0]*m[12] + inverse[4]*m[13] + inverse[8]*m[14]);
+	inverse[13] = -(inverse[1]*m[12] + inverse[5]*m[13] + inverse[9]*m[14]);
+	inverse[14] = -(inverse[2]*m[12] + inverse[6]*m[13] + inverse[10]*m[14]);
+
+	inverse[3] = 0.0;
+	inverse[7] = 0.0;
+	inverse[11] = 0.0;
+	inverse[15] = 1.0;
+
+	memcpy(matrixData, inverse, sizeof(double)*matrixElements);
+	return true;
+}
+
+AffineTransform44 AffineTransform44::inverse() const {
+	AffineTransform44 result(*this);
+	result.invert();
+	return result;
+}
+
+void AffineTransform44::multiply(const double* lhs, const double* rhs, double* result) {
+	assert(lhs != 0);
+	assert(rhs != 0);
+	assert(result != 0);
+	double product[matrixElements]; // result might alias one of the operands
+
+	for (int column = 0; column < 4; ++column) {
+		const double* rhsColumn = &rhs[column*4];
+		for (int row = 0; row < 3; ++row) {
+			product[column*4 + row] = lhs[row] * rhsColumn[0] + lhs[4 + row] * rhsColumn[1] + lhs[8 + row] * rhsColumn[2];
+		}
+	}
+	/* translation part of lhs; the last row of rhs is (0 0 0 1) */
+	product[12] += lhs[12];
+	product[13] += lhs[13];
+	product[14] += lhs[14];
+
+	product[3] = 0.0;
+	product[7] = 0.0;
+	product[11] = 0.0;
+	product[15] = 1.0;
+
+	memcpy(result, product, sizeof(double)*matrixElements);
+}
+
+void AffineTransform44::compose(const AffineTransform44* transforms, unsigned int count, AffineTransform44& result) {
+	assert(transforms != 0 || count == 0);
+	result.setIdentity();
+	for (unsigned int i = 0; i < count; ++i) {
+		result *= transforms[i];
+	}
+}
+
+void AffineTransform44::composeBatch(const AffineTransform44& lhs, const AffineTransform44* transforms, unsigned int count, AffineTransform44* results) {
+	assert((transforms != 0 && results != 0) || count == 0);
+	AffineTransform44 tmpLhs(lhs); // lhs might be an element of results
+	for (unsigned int i = 0; i < count; ++i) {
+		multiply(tmpLhs.matrixData, transforms[i].matrixData, results[i].matrixData);
+	}
+}
+
+void AffineTransform44::transformPoints(const double* matrix, double* xyz, unsigned int count) {
+	assert(matrix != 0);
+	assert(xyz != 0 || count == 0);
+
+	/* keep the coefficients in registers rather than reloading them via the pointer */
+	const double m0 = matrix[0], m1 = matrix[1], m2 = matrix[2];
+	const double m4 = matrix[4], m5 = matrix[5], m6 = matrix[6];
+	const double m8 = matrix[8], m9 = matrix[9], m10 = matrix[10];
+	const double tx = matrix[12], ty = matrix[13], tz = matrix[14];
+
+	double* end = xyz + 3 * count;
+	for (double* point = xyz; point != end; point += 3) {
+		const double x = point[0];
+		const double y = point[1];
+		const double z = point[2];
+		point[0] = m0 * x + m4 * y + m8 * z + tx;
+		point[1] = m1 * x + m5 * y + m9 * z + ty;
+		point[2] = m2 * x + m6 * y + m10 * z + tz;
+	}
+}
+
+void AffineTransform44::transformPoints(double* xyz, unsigned int count) const {
+	transformPoints(matrixData, xyz, count);
+}
+
+AffineTransform44 operator*(const AffineTransform44& lhs, const AffineTransform44& rhs) {
+	AffineTransform44 result;
+	AffineTransform44::multiply(lhs.getRawData(), rhs.getRawData(), result.setRawData());
+	return result;
+}
+
+}
+
+/* EOF */
@@ -0,0 +1,173 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+#ifndef BRICS_3D_AFFINETRANSFORM44_H_
+#define BRICS_3D_AFFINETRANSFORM44_H_
+
+#include "IHomogeneousMatrix44.h"
+
+namespace brics_3d {
+
+/**
+ * @brief Value type for a 4x4 affine transformation.
+ *
+ * In contrast to brics_3d::HomogeneousMatrix44 this class is not polymorphic and never allocates
+ * memory on the heap: it is meant to be used on the stack, e.g. to accumulate transforms along a
+ * path of the scene graph. The 16 values are stored in the same column-row order as
+ * IHomogeneousMatrix44::getRawData(), thus data can be exchanged with a simple copy.
+ *
+ * The last row is always assumed to be (0 0 0 1). Multiplication and inversion exploit this
+ * and only process the upper 3x4 part.
+ */
+class AffineTransform44 {
+public:
+
+	/// Amount of elements in 4x4 matrix
+	static const int matrixElements = 16;
+
+	/**
+	 * @brief Default constructor. Creates the identity transform.
+	 */
+	AffineTransform44();
+
+	/**
+	 * @brief Constructor with rotation and translation coefficients.
+	 * The coefficient order is the same as for brics_3d::HomogeneousMatrix44.
+	 */
+	AffineTransform44(double r0, double r1, double r2, double r3, double r4, double r5, double r6, double r7, double r8, double t0, double t1, double t2);
+
+	/**
+	 * @brief Constructor that copies the data of a homogeneous matrix.
+	 */
+	explicit AffineTransform44(const IHomogeneousMatrix44& matrix);
+
+	/**
+	 * @brief Constructor that copies 16 raw values in column-row order.
+	 */
+	explicit AffineTransform44(const double* rawData);
+
+	/**
+	 * @brief Copy the data of a homogeneous matrix into this transform.
+	 */
+	AffineTransform44& operator=(const IHomogeneousMatrix44& matrix);
+
+	/**
+	 * @brief Write this transform into a homogeneous matrix.
+	 */
+	void copyTo(IHomogeneousMatrix44* matrix) const;
+
+	/**
+	 * @brief Read-only access to the 16 values in column-row order.
+	 */
+	const double* getRawData() const;
+
+	/**
+	 * @brief Writable access to the 16 values in column-row order.
+	 */
+	double* setRawData();
+
+	/**
+	 * @brief Reset to the identity transform.
+	 */
+	void setIdentity();
+
+	/**
+	 * @brief Quick check if this transform is approximately the identity.
+	 * @param precision Precision when matrix elemets are considered to be equal
+	 */
+	bool isIdentity(double precision = 0.00001) const;
+
+	/**
+	 * @brief In-place multiplication from the right: this = this * transform
+	 */
+	AffineTransform44& operator*=(const AffineTransform44& transform);
+
+	/**
+	 * @brief In-place multiplication from the right: this = this * matrix
+	 */
+	AffineTransform44& operator*=(const IHomogeneousMatrix44& matrix);
+
+	/**
+	 * @brief In-place multiplication from the left: this = transform * this
+	 */
+	AffineTransform44& premultiply(const AffineTransform44& transform);
+
+	/**
+	 * @brief In-place inversion.
+	 * @return False if the rotational part is singular. The transform is not changed in that case.
+	 */
+	bool invert();
+
+	/**
+	 * @brief Get the inverse as a new value.
+	 */
+	AffineTransform44 inverse() const;
+
+	/**
+	 * @brief Multiply two transforms: result = lhs * rhs
+	 *
+	 * All parameters point to 16 values in column-row order. result may be the same as lhs or rhs.
+	 */
+	static void multiply(const double* lhs, const double* rhs, double* result);
+
+	/**
+	 * @brief Compose a chain of transforms: result = transforms[0] * transforms[1] * ... * transforms[count-1]
+	 *
+	 * An empty chain results in the identity.
+	 */
+	static void compose(const AffineTransform44* transforms, unsigned int count, AffineTransform44& result);
+
+	/**
+	 * @brief Apply one transform to a batch of transforms: results[i] = lhs * transforms[i]
+	 *
+	 * Typical use is to express a set of local poses with respect to a common (global) frame.
+	 * results may be the same array as transforms.
+	 */
+	static void composeBatch(const AffineTransform44& lhs, const AffineTransform44* transforms, unsigned int count, AffineTransform44* results);
+
+	/**
+	 * @brief Transform a block of points in place: p = matrix * p
+	 *
+	 * @param matrix 16 values in column-row order. The last row is assumed to be (0 0 0 1).
+	 * @param xyz Interleaved x,y,z triples.
+	 * @param count Number of points (not values) in xyz.
+	 */
+	static void transformPoints(const double* matrix, double* xyz, unsigned int count);
+
+	/**
+	 * @brief Transform a block of points in place with this transform.
+	 */
+	void transformPoints(double* xyz, unsigned int count) const;
+
+private:
+
+	/// Array that holds data in column-row (column-major) order
+	double matrixData[matrixElements];
+};
+
+/**
+ * @brief Multiply two transforms by value.
+ */
+AffineTransform44 operator*(const AffineTransform44& lhs, const AffineTransform44& rhs);
+
+}
+
+#endif /* BRICS_3D_AFFINETRANSFORM44_H_ */
+
+/* EOF */
@@ -20,9 +20,39 @@
 #include "ColorSpaceConvertor.h"
 #include <stdio.h>
 #include <stdint.h>
+#include <assert.h>
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
 
 namespace brics_3d {
 
+const unsigned char ColorSpaceConvertor::undefinedHue;
+
+/**
+ * Reciprocal tables for the batch conversion, indexed by 8-bit channel values.
+ * All entries fit into 16 bit, so the SIMD and the scalar path can share them.
+ */
+struct HsvConversionTables {
+	/// 30*1024*256/(255*d) for the difference d = max - min. Hue is scaled by 0.5 as in rgbToHsv().
+	unsigned short hueScale[256];
+
+	/// 255*256/v for the maximum v.
+	unsigned short saturationScale[256];
+
+	HsvConversionTables() {
+		hueScale[0] = 0; // hue of gray values is undefined
+		saturationScale[0] = 0;
+		for (int i = 1; i < 256; ++i) {
+			hueScale[i] = static_cast<unsigned short>(30.0 * 1024.0 * 256.0 / (255.0 * i) + 0.5);
+			saturationScale[i] = static_cast<unsigned short>(255.0 * 256.0 / i + 0.5);
+		}
+	}
+};
+
+static const HsvConversionTables hsvConversionTables;
+
 
 ColorSpaceConvertor::ColorSpaceConvertor() {
 	 this-> epsilon = 0.0001;
@@ -91,4 +121,142 @@ void ColorSpaceConvertor::rgbToRGB24Bit(float *rgb24Bit, unsigned char r, unsign
 		  *rgb24Bit = *reinterpret_cast<float*>(&rgb);
 }
 
+void ColorSpaceConvertor::rgbToHsv(const unsigned char* rgb, unsigned char* hsv, unsigned int count) {
+	assert(rgb != 0 || count == 0);
+	assert(hsv != 0 || count == 0);
+	const unsigned short* hueScale = hsvConversionTables.hueScale;
+	const unsigned short* saturationScale = hsvConversionTables.saturationScale;
+	unsigned int i = 0;
+
+	/*
+	 * Both paths evaluate in 16 bit fixed point:
+	 *   hue        = offset + round(round(numerator * hueScale[d] * (v << 7) / 2^15) / 2^10)
+	 *   saturation = (d * saturationScale[v] + 128) / 2^8
+	 * where the numerator is at most d in magnitude, so no intermediate value leaves 16 bit.
+	 */
+#if defined(__SSSE3__)
+	/* 16 colors per iteration: split the packed triples into r, g and b lanes, and pack h, s and v again at the end */
+	const __m128i r0 = _mm_setr_epi8(0, 3, 6, 9, 12, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+	const __m128i r1 = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, 2, 5, 8, 11, 14, -1, -1, -1, -1, -1);
+	const __m128i r2 = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 1, 4, 7, 10, 13);
+	const __m128i g0 = _mm_setr_epi8(1, 4, 7, 10, 13, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+	const __m128i g1 = _mm_setr_epi8(-1, -1, -1, -1, -1, 0, 3, 6, 9, 12, 15, -1, -1, -1, -1, -1);
+	const __m128i g2 = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 2, 5, 8, 11, 14);
+	const __m128i b0 = _mm_setr_epi8(2, 5, 8, 11, 14, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+	const __m128i b1 = _mm_setr_epi8(-1, -1, -1, -1, -1, 1, 4, 7, 10, 13, -1, -1, -1, -1, -1, -1);
+	const __m128i b2 = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 3, 6, 9, 12, 15);
+	const __m128i h0 = _mm_setr_epi8(0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1, -1, 5);
+	const __m128i h1 = _mm_setr_epi8(-1, -1, 6, -1, -1, 7, -1, -1, 8, -1, -1, 9, -1, -1, 10, -1);
+	const __m128i h2 = _mm_setr_epi8(-1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15, -1, -1);
+	const __m128i s0 = _mm_setr_epi8(-1, 0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1, -1);
+	const __m128i s1 = _mm_setr_epi8(5, -1, -1, 6, -1, -1, 7, -1, -1, 8, -1, -1, 9, -1, -1, 10);
+	const __m128i s2 = _mm_setr_epi8(-1, -1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15, -1);
+	const __m128i v0 = _mm_setr_epi8(-1, -1, 0, -1, -1, 1, -1, -1, 2, -1, -1, 3, -1, -1, 4, -1);
+	const __m128i v1 = _mm_setr_epi8(-1, 5, -1, -1, 6, -1, -1, 7, -1, -1, 8, -1, -1, 9, -1, -1);
+	const __m128i v2 = _mm_setr_epi8(10, -1, -1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15);
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i allSet = _mm_set1_epi8(-1);
+	const __m128i greenOffset = _mm_set1_epi16(90);
+	const __m128i blueOffset = _mm_set1_epi16(120);
+	const __m128i hueRounding = _mm_set1_epi16(512);
+	const __m128i wrapOffset = _mm_set1_epi16(180);
+	const __m128i maxHue = _mm_set1_epi16(179);
+	const __m128i saturationRounding = _mm_set1_epi16(128);
+	unsigned char valueBlock[16];
+	unsigned char differenceBlock[16];
+
+	for (; i + 16 <= count; i += 16) {
+		__m128i packed0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgb));
+		__m128i packed1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgb + 16));
+		__m128i packed2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgb + 32));
+		__m128i r = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(packed0, r0), _mm_shuffle_epi8(packed1, r1)), _mm_shuffle_epi8(packed2, r2));
+		__m128i g = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(packed0, g0), _mm_shuffle_epi8(packed1, g1)), _mm_shuffle_epi8(packed2, g2));
+		__m128i b = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(packed0, b0), _mm_shuffle_epi8(packed1, b1)), _mm_shuffle_epi8(packed2, b2));
+		__m128i value = _mm_max_epu8(r, _mm_max_epu8(g, b));
+		__m128i difference = _mm_sub_epi8(value, _mm_min_epu8(r, _mm_min_epu8(g, b)));
+
+		/* same precedence as in the scalar version: red, then green, then blue */
+		__m128i isRed = _mm_cmpeq_epi8(value, r);
+		__m128i isGreen = _mm_andnot_si128(isRed, _mm_cmpeq_epi8(value, g));
+		__m128i isBlue = _mm_andnot_si128(_mm_or_si128(isRed, isGreen), allSet);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(valueBlock), value);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(differenceBlock), difference);
+
+		__m128i hue[2];
+		__m128i saturation[2];
+		for (int half = 0; half < 2; ++half) {
+			const unsigned char* v = &valueBlock[8 * half];
+			const unsigned char* d = &differenceBlock[8 * half];
+			__m128i r16 = half ? _mm_unpackhi_epi8(r, zero) : _mm_unpacklo_epi8(r, zero);
+			__m128i g16 = half ? _mm_unpackhi_epi8(g, zero) : _mm_unpacklo_epi8(g, zero);
+			__m128i b16 = half ? _mm_unpackhi_epi8(b, zero) : _mm_unpacklo_epi8(b, zero);
+			__m128i value16 = half ? _mm_unpackhi_epi8(value, zero) : _mm_unpacklo_epi8(value, zero);
+			__m128i difference16 = half ? _mm_unpackhi_epi8(difference, zero) : _mm_unpacklo_epi8(difference, zero);
+			__m128i isRed16 = half ? _mm_unpackhi_epi8(isRed, isRed) : _mm_unpacklo_epi8(isRed, isRed);
+			__m128i isGreen16 = half ? _mm_unpackhi_epi8(isGreen, isGreen) : _mm_unpacklo_epi8(isGreen, isGreen);
+			__m128i isBlue16 = half ? _mm_unpackhi_epi8(isBlue, isBlue) : _mm_unpacklo_epi8(isBlue, isBlue);
+
+			__m128i numerator = _mm_or_si128(_mm_or_si128(_mm_and_si128(isRed16, _mm_sub_epi16(g16, b16)), _mm_and_si128(isGreen16, _mm_sub_epi16(b16, r16))),
+					_mm_and_si128(isBlue16, _mm_sub_epi16(r16, g16)));
+			__m128i offset = _mm_or_si128(_mm_and_si128(isGreen16, greenOffset), _mm_and_si128(isBlue16, blueOffset));
+			__m128i hueReciprocal = _mm_setr_epi16(hueScale[d[0]], hueScale[d[1]], hueScale[d[2]], hueScale[d[3]],
+					hueScale[d[4]], hueScale[d[5]], hueScale[d[6]], hueScale[d[7]]);
+			__m128i saturationReciprocal = _mm_setr_epi16(saturationScale[v[0]], saturationScale[v[1]], saturationScale[v[2]], saturationScale[v[3]],
+					saturationScale[v[4]], saturationScale[v[5]], saturationScale[v[6]], saturationScale[v[7]]);
+
+			__m128i h = _mm_mulhrs_epi16(_mm_mullo_epi16(numerator, hueReciprocal), _mm_slli_epi16(value16, 7));
+			h = _mm_add_epi16(offset, _mm_srai_epi16(_mm_add_epi16(h, hueRounding), 10));
+			h = _mm_add_epi16(h, _mm_and_si128(_mm_cmpgt_epi16(zero, h), wrapOffset));
+			hue[half] = _mm_sub_epi16(h, _mm_and_si128(_mm_cmpgt_epi16(h, maxHue), wrapOffset));
+			saturation[half] = _mm_srli_epi16(_mm_adds_epu16(_mm_mullo_epi16(difference16, saturationReciprocal), saturationRounding), 8);
+		}
+		__m128i h = _mm_or_si128(_mm_packus_epi16(hue[0], hue[1]), _mm_cmpeq_epi8(difference, zero)); // gray: undefinedHue
+		__m128i s = _mm_packus_epi16(saturation[0], saturation[1]);
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(hsv),
+				_mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(h, h0), _mm_shuffle_epi8(s, s0)), _mm_shuffle_epi8(value, v0)));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(hsv + 16),
+				_mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(h, h1), _mm_shuffle_epi8(s, s1)), _mm_shuffle_epi8(value, v1)));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(hsv + 32),
+				_mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(h, h2), _mm_shuffle_epi8(s, s2)), _mm_shuffle_epi8(value, v2)));
+		rgb += 48;
+		hsv += 48;
+	}
+#endif
+
+	/* scalar loop for the remainder (or everything if no SIMD support is available) */
+	for (; i < count; ++i) {
+		int r = rgb[0];
+		int g = rgb[1];
+		int b = rgb[2];
+		int v = r ^ ((r ^ g) & -(r < g)); // maximum and minimum without branches
+		v = v ^ ((v ^ b) & -(v < b));
+		int min = r ^ ((r ^ g) & -(g < r));
+		min = min ^ ((min ^ b) & -(b < min));
+		int difference = v - min;
+
+		/* same precedence as in the scalar version: red, then green, then blue; selected via bit masks */
+		int isRed = -(v == r);
+		int isGreen = ~isRed & -(v == g);
+		int isBlue = ~(isRed | isGreen);
+		int numerator = (isRed & (g - b)) | (isGreen & (b - r)) | (isBlue & (r - g));
+		int offset = (isGreen & 90) | (isBlue & 120);
+
+		int h = (numerator * hueScale[difference] * (v << 7) + (1 << 14)) >> 15;
+		h = offset + ((h + 512) >> 10);
+		h += (h >> 31) & 180;
+		h -= -(h > 179) & 180;
+		h |= -(difference == 0); // gray: undefinedHue
+		int s = difference * saturationScale[v] + 128;
+		s = (s > 0xffff) ? 0xffff : s;
+
+		hsv[0] = static_cast<unsigned char>(h);
+		hsv[1] = static_cast<unsigned char>(s >> 8);
+		hsv[2] = static_cast<unsigned char>(v);
+
+		rgb += 3;
+		hsv += 3;
+	}
+}
+
 }
@@ -116,6 +116,25 @@ public:
 	void rgbToHsv(int red, int green, int blue, double *hue, double *sat, double *val);
 
 
+	/// Hue of gray values (including black) in the 8-bit HSV values of the batch conversion.
+	static const unsigned char undefinedHue = 255;
+
+	/**
+	 * Converts a buffer of RGB-24 colors (three bytes per color) into 8-bit HSV values.
+	 *
+	 * The results are those of rgbToHsv(int, int, int, double*, double*, double*) rounded to integers
+	 * (off by at most one): hue in [0, 180), saturation and value in [0, 255]. The hue of gray values
+	 * is undefinedHue. The divisions are replaced by lookup tables of reciprocals and the per color
+	 * branches by selects. With SSSE3 enabled (e.g. -mssse3) 16 colors are converted at once, which
+	 * makes this suitable to process a complete camera frame.
+	 *
+	 * @param rgb Interleaved r, g, b triples
+	 * @param hsv Interleaved h, s, v triples. Must have space for 3*count values.
+	 * @param count Number of colors (not bytes) in rgb
+	 */
+	static void rgbToHsv(const unsigned char* rgb, unsigned char* hsv, unsigned int count);
+
+
 	/**
 	 * Calculates R, G, B value for rgb-24 bit encoding
 	 * @param rgb24Bit
@@ -18,7 +18,9 @@
 ******************************************************************************/
 
 #include "ColoredPoint3D.h"
+#include "Point3DArena.h"
 
+#include <new>
 #include <stdexcept>
 
 using std::runtime_error;
@@ -124,6 +126,13 @@ Point3D* ColoredPoint3D::clone() const {
 	return new ColoredPoint3D(point->clone(), red, green, blue);
 }
 
+Point3D* ColoredPoint3D::cloneInto(Point3DArena* arena) const {
+	if (arena == 0) {
+		return clone();
+	}
+	return new (arena->allocate(sizeof(ColoredPoint3D))) ColoredPoint3D(point->cloneInto(arena), red, green, blue);
+}
+
 ColoredPoint3D* ColoredPoint3D::asColoredPoint3D() {
 	return this;
 }
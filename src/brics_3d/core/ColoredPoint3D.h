@@ -94,6 +94,8 @@ public:
 
 	virtual Point3D* clone() const;
 
+	virtual Point3D* cloneInto(Point3DArena* arena) const;
+
     ColoredPoint3D* asColoredPoint3D();
 
 	/**
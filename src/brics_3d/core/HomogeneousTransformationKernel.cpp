@@ -0,0 +1,208 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+#include "HomogeneousTransformationKernel.h"
+#include "ParallelProcessing.h"
+
+#include <cassert>
+#include <boost/thread.hpp>
+#include <boost/bind.hpp>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace brics_3d {
+
+/**
+ * Split the work into one chunk per thread if the block is large enough.
+ * The last chunk is processed by the calling thread.
+ */
+template <typename ScalarT>
+static void transformInChunks(const double* matrix, const ScalarT* xIn, const ScalarT* yIn, const ScalarT* zIn,
+		ScalarT* xOut, ScalarT* yOut, ScalarT* zOut, unsigned int count) {
+
+	void (*transformBlock)(const double*, const ScalarT*, const ScalarT*, const ScalarT*, ScalarT*, ScalarT*, ScalarT*, unsigned int) =
+			&HomogeneousTransformationKernel::transformBlock;
+
+	unsigned int numberOfThreads = ParallelProcessing::getNumberOfThreads(count, HomogeneousTransformationKernel::parallelThreshold);
+	if (numberOfThreads == 1) {
+		transformBlock(matrix, xIn, yIn, zIn, xOut, yOut, zOut, count);
+		return;
+	}
+
+	unsigned int chunkSize = count / numberOfThreads;
+	boost::thread_group workers;
+	for (unsigned int i = 0; i < numberOfThreads - 1; ++i) {
+		unsigned int offset = i * chunkSize;
+		workers.create_thread(boost::bind(transformBlock, matrix,
+				xIn + offset, yIn + offset, zIn + offset, xOut + offset, yOut + offset, zOut + offset, chunkSize));
+	}
+	unsigned int offset = (numberOfThreads - 1) * chunkSize;
+	transformBlock(matrix, xIn + offset, yIn + offset, zIn + offset, xOut + offset, yOut + offset, zOut + offset, count - offset);
+	workers.join_all();
+}
+
+void HomogeneousTransformationKernel::transform(const double* matrix, double* x, double* y, double* z, unsigned int count) {
+	transformInChunks<double>(matrix, x, y, z, x, y, z, count);
+}
+
+void HomogeneousTransformationKernel::transform(const double* matrix, float* x, float* y, float* z, unsigned int count) {
+	transformInChunks<float>(matrix, x, y, z, x, y, z, count);
+}
+
+void HomogeneousTransformationKernel::transform(const double* matrix, const double* xIn, const double* yIn, const double* zIn,
+		double* xOut, double* yOut, double* zOut, unsigned int count) {
+	transformInChunks<double>(matrix, xIn, yIn, zIn, xOut, yOut, zOut, count);
+}
+
+void HomogeneousTransformationKernel::transform(const double* matrix, const float* xIn, const float* yIn, const float* zIn,
+		float* xOut, float* yOut, float* zOut, unsigned int count) {
+	transformInChunks<float>(matrix, xIn, yIn, zIn, xOut, yOut, zOut, count);
+}
+
+void HomogeneousTransformationKernel::transformBlock(const double* matrix, const double* xIn, const double* yIn, const double* zIn,
+		double* xOut, double* yOut, double* zOut, unsigned int count) {
+	assert(matrix != 0);
+
+	/*
+	 * layout:
+	 * 0 4 8  12
+	 * 1 5 9  13
+	 * 2 6 10 14
+	 * 3 7 11 15
+	 */
+	const double r0 = matrix[0], r1 = matrix[1], r2 = matrix[2];
+	const double r4 = matrix[4], r5 = matrix[5], r6 = matrix[6];
+	const double r8 = matrix[8], r9 = matrix[9], r10 = matrix[10];
+	const double tx = matrix[12], ty = matrix[13], tz = matrix[14];
+
+	unsigned int i = 0;
+
+#if defined(__AVX__)
+	const __m256d m0 = _mm256_set1_pd(r0), m1 = _mm256_set1_pd(r1), m2 = _mm256_set1_pd(r2);
+	const __m256d m4 = _mm256_set1_pd(r4), m5 = _mm256_set1_pd(r5), m6 = _mm256_set1_pd(r6);
+	const __m256d m8 = _mm256_set1_pd(r8), m9 = _mm256_set1_pd(r9), m10 = _mm256_set1_pd(r10);
+	const __m256d t0 = _mm256_set1_pd(tx), t1 = _mm256_set1_pd(ty), t2 = _mm256_set1_pd(tz);
+
+	for (; i + 4 <= count; i += 4) {
+		__m256d vx = _mm256_loadu_pd(xIn + i);
+		__m256d vy = _mm256_loadu_pd(yIn + i);
+		__m256d vz = _mm256_loadu_pd(zIn + i);
+		__m256d resultX = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(vx, m0), _mm256_mul_pd(vy, m4)), _mm256_add_pd(_mm256_mul_pd(vz, m8), t0));
+		__m256d resultY = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(vx, m1), _mm256_mul_pd(vy, m5)), _mm256_add_pd(_mm256_mul_pd(vz, m9), t1));
+		__m256d resultZ = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(vx, m2), _mm256_mul_pd(vy, m6)), _mm256_add_pd(_mm256_mul_pd(vz, m10), t2));
+		_mm256_storeu_pd(xOut + i, resultX);
+		_mm256_storeu_pd(yOut + i, resultY);
+		_mm256_storeu_pd(zOut + i, resultZ);
+	}
+#elif defined(__SSE2__)
+	const __m128d m0 = _mm_set1_pd(r0), m1 = _mm_set1_pd(r1), m2 = _mm_set1_pd(r2);
+	const __m128d m4 = _mm_set1_pd(r4), m5 = _mm_set1_pd(r5), m6 = _mm_set1_pd(r6);
+	const __m128d m8 = _mm_set1_pd(r8), m9 = _mm_set1_pd(r9), m10 = _mm_set1_pd(r10);
+	const __m128d t0 = _mm_set1_pd(tx), t1 = _mm_set1_pd(ty), t2 = _mm_set1_pd(tz);
+
+	for (; i + 2 <= count; i += 2) {
+		__m128d vx = _mm_loadu_pd(xIn + i);
+		__m128d vy = _mm_loadu_pd(yIn + i);
+		__m128d vz = _mm_loadu_pd(zIn + i);
+		__m128d resultX = _mm_add_pd(_mm_add_pd(_mm_mul_pd(vx, m0), _mm_mul_pd(vy, m4)), _mm_add_pd(_mm_mul_pd(vz, m8), t0));
+		__m128d resultY = _mm_add_pd(_mm_add_pd(_mm_mul_pd(vx, m1), _mm_mul_pd(vy, m5)), _mm_add_pd(_mm_mul_pd(vz, m9), t1));
+		__m128d resultZ = _mm_add_pd(_mm_add_pd(_mm_mul_pd(vx, m2), _mm_mul_pd(vy, m6)), _mm_add_pd(_mm_mul_pd(vz, m10), t2));
+		_mm_storeu_pd(xOut + i, resultX);
+		_mm_storeu_pd(yOut + i, resultY);
+		_mm_storeu_pd(zOut + i, resultZ);
+	}
+#endif
+
+	/* scalar loop for the remainder (or everything if no SIMD support is available) */
+	for (; i < count; ++i) {
+		double xTemp = xIn[i];
+		double yTemp = yIn[i];
+		double zTemp = zIn[i];
+		xOut[i] = xTemp * r0 + yTemp * r4 + zTemp * r8 + tx;
+		yOut[i] = xTemp * r1 + yTemp * r5 + zTemp * r9 + ty;
+		zOut[i] = xTemp * r2 + yTemp * r6 + zTemp * r10 + tz;
+	}
+}
+
+void HomogeneousTransformationKernel::transformBlock(const double* matrix, const float* xIn, const float* yIn, const float* zIn,
+		float* xOut, float* yOut, float* zOut, unsigned int count) {
+	assert(matrix != 0);
+
+	/* same layout as for the double precision version */
+	const float r0 = static_cast<float>(matrix[0]), r1 = static_cast<float>(matrix[1]), r2 = static_cast<float>(matrix[2]);
+	const float r4 = static_cast<float>(matrix[4]), r5 = static_cast<float>(matrix[5]), r6 = static_cast<float>(matrix[6]);
+	const float r8 = static_cast<float>(matrix[8]), r9 = static_cast<float>(matrix[9]), r10 = static_cast<float>(matrix[10]);
+	const float tx = static_cast<float>(matrix[12]), ty = static_cast<float>(matrix[13]), tz = static_cast<float>(matrix[14]);
+
+	unsigned int i = 0;
+
+#if defined(__AVX__)
+	const __m256 m0 = _mm256_set1_ps(r0), m1 = _mm256_set1_ps(r1), m2 = _mm256_set1_ps(r2);
+	const __m256 m4 = _mm256_set1_ps(r4), m5 = _mm256_set1_ps(r5), m6 = _mm256_set1_ps(r6);
+	const __m256 m8 = _mm256_set1_ps(r8), m9 = _mm256_set1_ps(r9), m10 = _mm256_set1_ps(r10);
+	const __m256 t0 = _mm256_set1_ps(tx), t1 = _mm256_set1_ps(ty), t2 = _mm256_set1_ps(tz);
+
+	for (; i + 8 <= count; i += 8) {
+		__m256 vx = _mm256_loadu_ps(xIn + i);
+		__m256 vy = _mm256_loadu_ps(yIn + i);
+		__m256 vz = _mm256_loadu_ps(zIn + i);
+		__m256 resultX = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(vx, m0), _mm256_mul_ps(vy, m4)), _mm256_add_ps(_mm256_mul_ps(vz, m8), t0));
+		__m256 resultY = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(vx, m1), _mm256_mul_ps(vy, m5)), _mm256_add_ps(_mm256_mul_ps(vz, m9), t1));
+		__m256 resultZ = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(vx, m2), _mm256_mul_ps(vy, m6)), _mm256_add_ps(_mm256_mul_ps(vz, m10), t2));
+		_mm256_storeu_ps(xOut + i, resultX);
+		_mm256_storeu_ps(yOut + i, resultY);
+		_mm256_storeu_ps(zOut + i, resultZ);
+	}
+#elif defined(__SSE2__)
+	const __m128 m0 = _mm_set1_ps(r0), m1 = _mm_set1_ps(r1), m2 = _mm_set1_ps(r2);
+	const __m128 m4 = _mm_set1_ps(r4), m5 = _mm_set1_ps(r5), m6 = _mm_set1_ps(r6);
+	const __m128 m8 = _mm_set1_ps(r8), m9 = _mm_set1_ps(r9), m10 = _mm_set1_ps(r10);
+	const __m128 t0 = _mm_set1_ps(tx), t1 = _mm_set1_ps(ty), t2 = _mm_set1_ps(tz);
+
+	for (; i + 4 <= count; i += 4) {
+		__m128 vx = _mm_loadu_ps(xIn + i);
+		__m128 vy = _mm_loadu_ps(yIn + i);
+		__m128 vz = _mm_loadu_ps(zIn + i);
+		__m128 resultX = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, m0), _mm_mul_ps(vy, m4)), _mm_add_ps(_mm_mul_ps(vz, m8), t0));
+		__m128 resultY = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, m1), _mm_mul_ps(vy, m5)), _mm_add_ps(_mm_mul_ps(vz, m9), t1));
+		__m128 resultZ = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, m2), _mm_mul_ps(vy, m6)), _mm_add_ps(_mm_mul_ps(vz, m10), t2));
+		_mm_storeu_ps(xOut + i, resultX);
+		_mm_storeu_ps(yOut + i, resultY);
+		_mm_storeu_ps(zOut + i, resultZ);
+	}
+#endif
+
+	/* scalar loop for the remainder (or everything if no SIMD support is available) */
+	for (; i < count; ++i) {
+		float xTemp = xIn[i];
+		float yTemp = yIn[i];
+		float zTemp = zIn[i];
+		xOut[i] = xTemp * r0 + yTemp * r4 + zTemp * r8 + tx;
+		yOut[i] = xTemp * r1 + yTemp * r5 + zTemp * r9 + ty;
+		zOut[i] = xTemp * r2 + yTemp * r6 + zTemp * r10 + tz;
+	}
+}
+
+}
+
+/* EOF */
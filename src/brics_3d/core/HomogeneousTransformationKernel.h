@@ -0,0 +1,96 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+#ifndef BRICS_3D_HOMOGENEOUSTRANSFORMATIONKERNEL_H_
+#define BRICS_3D_HOMOGENEOUSTRANSFORMATIONKERNEL_H_
+
+#include "Point3D.h"
+
+namespace brics_3d {
+
+/**
+ * @brief Batched application of a homogeneous transformation to blocks of coordinates.
+ *
+ * The coordinates are expected in structure of arrays layout (cf. brics_3d::PointCloud3DContiguous).
+ * Double and single precision coordinates are supported; the matrix is always given in double precision.
+ * The matrix is read once per call. Depending on the compile flags the inner loop is
+ * implemented with AVX (__AVX__) or SSE2 (__SSE2__) intrinsics, otherwise a plain scalar loop is used.
+ * Large blocks (more than parallelThreshold points) are split and processed by multiple threads.
+ */
+class HomogeneousTransformationKernel {
+public:
+
+	/// Threshold for ParallelProcessing::getNumberOfThreads().
+	static const unsigned int parallelThreshold = 1000000;
+
+	/**
+	 * @brief Transform a block of coordinates in place.
+	 * @param[in] matrix Column-major 4x4 homogeneous matrix as returned by IHomogeneousMatrix44::getRawData()
+	 * @param[in,out] x Array of x coordinates.
+	 * @param[in,out] y Array of y coordinates.
+	 * @param[in,out] z Array of z coordinates.
+	 * @param[in] count Number of points.
+	 */
+	static void transform(const double* matrix, double* x, double* y, double* z, unsigned int count);
+
+	/**
+	 * @brief Single precision version of the in place transform(). The matrix is converted to float once.
+	 */
+	static void transform(const double* matrix, float* x, float* y, float* z, unsigned int count);
+
+	/**
+	 * @brief Transform a block of coordinates and write the result to separate arrays.
+	 * Input and output arrays may be the same (in place transformation) but must not partially overlap.
+	 * @param[in] matrix Column-major 4x4 homogeneous matrix as returned by IHomogeneousMatrix44::getRawData()
+	 * @param[in] xIn Array of x coordinates.
+	 * @param[in] yIn Array of y coordinates.
+	 * @param[in] zIn Array of z coordinates.
+	 * @param[out] xOut Array for the transformed x coordinates.
+	 * @param[out] yOut Array for the transformed y coordinates.
+	 * @param[out] zOut Array for the transformed z coordinates.
+	 * @param[in] count Number of points.
+	 */
+	static void transform(const double* matrix, const double* xIn, const double* yIn, const double* zIn,
+			double* xOut, double* yOut, double* zOut, unsigned int count);
+
+	/**
+	 * @brief Single precision version of transform().
+	 */
+	static void transform(const double* matrix, const float* xIn, const float* yIn, const float* zIn,
+			float* xOut, float* yOut, float* zOut, unsigned int count);
+
+	/**
+	 * @brief Single threaded version of transform(). Used for the individual chunks of the parallel version.
+	 */
+	static void transformBlock(const double* matrix, const double* xIn, const double* yIn, const double* zIn,
+			double* xOut, double* yOut, double* zOut, unsigned int count);
+
+	/**
+	 * @brief Single threaded, single precision version of transform().
+	 */
+	static void transformBlock(const double* matrix, const float* xIn, const float* yIn, const float* zIn,
+			float* xOut, float* yOut, float* zOut, unsigned int count);
+
+};
+
+}
+
+#endif /* BRICS_3D_HOMOGENEOUSTRANSFORMATIONKERNEL_H_ */
+
+/* EOF */
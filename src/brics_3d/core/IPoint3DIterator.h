@@ -44,6 +44,22 @@ namespace brics_3d {
  *	}
  *	delete it;
  * @endcode
+ *
+ * For larger point sets the points can be fetched block-wise with nextBlock(). This avoids a
+ * virtual call per coordinate and allows implementations to transform a whole block at once:
+ *
+ *  @code
+ *	const unsigned int blockSize = 1024;
+ *	Coordinate xyz[3 * blockSize];
+ *	unsigned int count;
+ *	for (it->begin(); (count = it->nextBlock(blockSize, xyz)) > 0; ) {
+ *		for (unsigned int i = 0; i < count; ++i) {
+ *			xyz[3*i+0]; // x
+ *			xyz[3*i+1]; // y
+ *			xyz[3*i+2]; // z
+ *		}
+ *	}
+ * @endcode
  */
 class IPoint3DIterator {
 public:
@@ -109,6 +125,28 @@ public:
 	 */
 	virtual Point3D* getRawData() = 0; //not transformed, but might have additional data like color, etc.
 
+	/**
+	 * @brief Copy the (possibly transformed) coordinates of up to maxPoints points into a buffer and advance the iterator behind them.
+	 *
+	 * The iteration starts at the current point, so nextBlock() can be mixed with next(). The default
+	 * implementation is based on getX(), getY(), getZ() and next(). Implementations should override it
+	 * with a version that transforms the whole block at once.
+	 *
+	 * @param maxPoints Maximal number of points that will be copied.
+	 * @param xyz Caller supplied buffer for at least 3*maxPoints values. The coordinates are stored interleaved as x,y,z triples.
+	 * @return Number of copied points. 0 if the end has been reached.
+	 */
+	virtual unsigned int nextBlock(unsigned int maxPoints, Coordinate* xyz) {
+		unsigned int count = 0;
+		for (; (count < maxPoints) && !end(); next()) {
+			xyz[3 * count + 0] = getX();
+			xyz[3 * count + 1] = getY();
+			xyz[3 * count + 2] = getZ();
+			++count;
+		}
+		return count;
+	}
+
 };
 
 }
@@ -0,0 +1,41 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+
+#include "ParallelProcessing.h"
+
+#include <algorithm>
+#include <boost/thread.hpp>
+
+namespace brics_3d {
+
+unsigned int ParallelProcessing::getNumberOfThreads(unsigned int count, unsigned int parallelThreshold, unsigned int maxNumberOfThreads) {
+	if (count < parallelThreshold) {
+		return 1;
+	}
+	unsigned int numberOfThreads = boost::thread::hardware_concurrency();
+	if (maxNumberOfThreads > 0) {
+		numberOfThreads = std::min(numberOfThreads, maxNumberOfThreads);
+	}
+	return std::max(numberOfThreads, 1u); // hardware_concurrency() is 0 if unknown
+}
+
+}
+
+/* EOF */
@@ -0,0 +1,53 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+
+#ifndef BRICS_3D_PARALLELPROCESSING_H_
+#define BRICS_3D_PARALLELPROCESSING_H_
+
+namespace brics_3d {
+
+/**
+ * @brief Common rules for distributing work over multiple threads.
+ *
+ * Algorithms that split their input (points, voxels, queries, ...) into one range per thread ask
+ * getNumberOfThreads() how many ranges to create; the last range is processed by the calling thread.
+ * Each such algorithm defines a parallelThreshold: smaller inputs are processed by the calling thread
+ * only, as starting threads would cost more than it saves. Algorithms that expose a maxNumberOfThreads
+ * setting forward it as upper limit, where 0 means as many threads as the hardware supports.
+ */
+class ParallelProcessing {
+public:
+
+	/**
+	 * @brief Number of threads to process a given amount of elements.
+	 * @param count Number of elements to be processed.
+	 * @param parallelThreshold Number of elements from which on multiple threads are used.
+	 * @param maxNumberOfThreads Upper limit for the amount of threads. 0 for no limit.
+	 * @return Number of threads including the calling one, at least 1.
+	 */
+	static unsigned int getNumberOfThreads(unsigned int count, unsigned int parallelThreshold, unsigned int maxNumberOfThreads = 0);
+
+};
+
+}
+
+#endif /* BRICS_3D_PARALLELPROCESSING_H_ */
+
+/* EOF */
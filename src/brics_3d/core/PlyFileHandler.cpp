@@ -0,0 +1,943 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+#include "PlyFileHandler.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace brics_3d {
+
+/// Scalar types of PLY properties.
+enum PlyType {
+	plyInt8,
+	plyUint8,
+	plyInt16,
+	plyUint16,
+	plyInt32,
+	plyUint32,
+	plyFloat32,
+	plyFloat64,
+	plyUnknown
+};
+
+/// Meaning of a vertex property.
+enum PlyRole {
+	plyRoleNone,
+	plyRoleX,
+	plyRoleY,
+	plyRoleZ,
+	plyRoleRed,
+	plyRoleGreen,
+	plyRoleBlue,
+	plyRoleNx,
+	plyRoleNy,
+	plyRoleNz,
+	plyRoleIntensity
+};
+
+enum PlyEncoding {
+	plyAscii,
+	plyBinaryLittleEndian,
+	plyBinaryBigEndian
+};
+
+struct PlyProperty {
+	std::string name;
+	PlyType type; // item type for lists
+	bool isList;
+	PlyType countType; // lists only
+	std::size_t offset; // offset within a record; only valid for fixed size records
+};
+
+struct PlyElement {
+	std::string name;
+	unsigned int count;
+	std::vector<PlyProperty> properties;
+	std::size_t recordSize; // 0 for records with variable size, i.e. with list properties
+};
+
+struct PlyHeader {
+	PlyEncoding encoding;
+	std::vector<PlyElement> elements;
+	std::size_t dataOffset; // first byte after end_header
+};
+
+/// Number of records that are buffered before they are written to a file.
+static const unsigned int plyWriteChunkSize = 65536;
+
+static std::size_t plyTypeSize(PlyType type) {
+	switch (type) {
+	case plyInt8:
+	case plyUint8:
+		return 1;
+	case plyInt16:
+	case plyUint16:
+		return 2;
+	case plyInt32:
+	case plyUint32:
+	case plyFloat32:
+		return 4;
+	case plyFloat64:
+		return 8;
+	default:
+		return 0;
+	}
+}
+
+static PlyType plyTypeFromString(const std::string& name) {
+	if (name == "char" || name == "int8") return plyInt8;
+	if (name == "uchar" || name == "uint8") return plyUint8;
+	if (name == "short" || name == "int16") return plyInt16;
+	if (name == "ushort" || name == "uint16") return plyUint16;
+	if (name == "int" || name == "int32") return plyInt32;
+	if (name == "uint" || name == "uint32") return plyUint32;
+	if (name == "float" || name == "float32") return plyFloat32;
+	if (name == "double" || name == "float64") return plyFloat64;
+	return plyUnknown;
+}
+
+static PlyRole plyRoleFromName(const std::string& name) {
+	if (name == "x") return plyRoleX;
+	if (name == "y") return plyRoleY;
+	if (name == "z") return plyRoleZ;
+	if (name == "red" || name == "diffuse_red") return plyRoleRed;
+	if (name == "green" || name == "diffuse_green") return plyRoleGreen;
+	if (name == "blue" || name == "diffuse_blue") return plyRoleBlue;
+	if (name == "nx") return plyRoleNx;
+	if (name == "ny") return plyRoleNy;
+	if (name == "nz") return plyRoleNz;
+	if (name == "intensity" || name == "scalar_intensity") return plyRoleIntensity;
+	return plyRoleNone;
+}
+
+static bool isLittleEndianHost() {
+	const unsigned short probe = 1;
+	return *reinterpret_cast<const unsigned char*>(&probe) == 1;
+}
+
+template <typename T>
+static inline void swapBytes(T& value) {
+	unsigned char* bytes = reinterpret_cast<unsigned char*>(&value);
+	std::reverse(bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+static inline T readBinaryValue(const char* data, bool swap) {
+	T value;
+	memcpy(&value, data, sizeof(T));
+	if (swap) {
+		swapBytes(value);
+	}
+	return value;
+}
+
+static double readBinaryValue(const char* data, PlyType type, bool swap) {
+	switch (type) {
+	case plyInt8:
+		return readBinaryValue<signed char>(data, swap);
+	case plyUint8:
+		return readBinaryValue<unsigned char>(data, swap);
+	case plyInt16:
+		return readBinaryValue<short>(data, swap);
+	case plyUint16:
+		return readBinaryValue<unsigned short>(data, swap);
+	case plyInt32:
+		return readBinaryValue<int>(data, swap);
+	case plyUint32:
+		return readBinaryValue<unsigned int>(data, swap);
+	case plyFloat32:
+		return readBinaryValue<float>(data, swap);
+	case plyFloat64:
+		return readBinaryValue<double>(data, swap);
+	default:
+		throw std::runtime_error("PlyFileHandler: unknown property type.");
+	}
+}
+
+template <typename T>
+static inline void writeBinaryValue(char*& data, T value, bool swap) {
+	if (swap) {
+		swapBytes(value);
+	}
+	memcpy(data, &value, sizeof(T));
+	data += sizeof(T);
+}
+
+/// Strided copy of one property out of fixed size records.
+template <typename SourceT, typename TargetT>
+static void extractBinaryColumn(const char* data, std::size_t recordSize, unsigned int count, bool swap, TargetT* target, unsigned int targetStride) {
+	for (unsigned int i = 0; i < count; ++i) {
+		target[i * targetStride] = static_cast<TargetT>(readBinaryValue<SourceT>(data + i * recordSize, swap));
+	}
+}
+
+template <typename TargetT>
+static void extractBinaryColumn(const char* data, std::size_t recordSize, unsigned int count, PlyType type, bool swap, TargetT* target, unsigned int targetStride) {
+	switch (type) {
+	case plyInt8:
+		extractBinaryColumn<signed char>(data, recordSize, count, swap, target, targetStride);
+		break;
+	case plyUint8:
+		extractBinaryColumn<unsigned char>(data, recordSize, count, swap, target, targetStride);
+		break;
+	case plyInt16:
+		extractBinaryColumn<short>(data, recordSize, count, swap, target, targetStride);
+		break;
+	case plyUint16:
+		extractBinaryColumn<unsigned short>(data, recordSize, count, swap, target, targetStride);
+		break;
+	case plyInt32:
+		extractBinaryColumn<int>(data, recordSize, count, swap, target, targetStride);
+		break;
+	case plyUint32:
+		extractBinaryColumn<unsigned int>(data, recordSize, count, swap, target, targetStride);
+		break;
+	case plyFloat32:
+		extractBinaryColumn<float>(data, recordSize, count, swap, target, targetStride);
+		break;
+	case plyFloat64:
+		extractBinaryColumn<double>(data, recordSize, count, swap, target, targetStride);
+		break;
+	default:
+		throw std::runtime_error("PlyFileHandler: unknown property type.");
+	}
+}
+
+/// Convert a color value of a PLY file: integer types are taken as they are, floating point types are scaled from 0..1.
+static unsigned char plyColorValue(double value, PlyType type) {
+	if (type == plyFloat32 || type == plyFloat64) {
+		value *= 255.0;
+	}
+	if (value <= 0.0) {
+		return 0;
+	}
+	if (value >= 255.0) {
+		return 255;
+	}
+	return static_cast<unsigned char>(value + 0.5);
+}
+
+static void extractBinaryColorColumn(const char* data, std::size_t recordSize, unsigned int count, PlyType type, bool swap, unsigned char* target) {
+	if (type == plyUint8) { // the common case
+		extractBinaryColumn<unsigned char>(data, recordSize, count, swap, target, 3);
+		return;
+	}
+	for (unsigned int i = 0; i < count; ++i) {
+		target[i * 3] = plyColorValue(readBinaryValue(data + i * recordSize, type, swap), type);
+	}
+}
+
+/// Parse the next whitespace separated number of an ascii data section.
+static double parseAsciiValue(const char*& position, const char* end) {
+	while (position < end && isspace(static_cast<unsigned char>(*position))) {
+		++position;
+	}
+	const char* tokenStart = position;
+	while (position < end && !isspace(static_cast<unsigned char>(*position))) {
+		++position;
+	}
+
+	const std::size_t maxTokenLength = 63;
+	std::size_t length = position - tokenStart;
+	if (length == 0 || length > maxTokenLength) {
+		throw std::runtime_error("PlyFileHandler: unexpected end of data or invalid ascii value.");
+	}
+	char token[maxTokenLength + 1]; // the mapped data is not null terminated
+	memcpy(token, tokenStart, length);
+	token[length] = '\0';
+
+	char* tokenEnd;
+	double value = strtod(token, &tokenEnd);
+	if (tokenEnd != token + length) {
+		throw std::runtime_error("PlyFileHandler: invalid ascii value.");
+	}
+	return value;
+}
+
+static PlyHeader parsePlyHeader(const char* data, std::size_t size) {
+	PlyHeader header;
+	std::size_t position = 0;
+	bool isFirstLine = true;
+	bool hasFormat = false;
+
+	while (true) {
+		const char* lineEnd = (position < size) ? static_cast<const char*>(memchr(data + position, '\n', size - position)) : 0;
+		if (lineEnd == 0) {
+			throw std::runtime_error("PlyFileHandler: incomplete header.");
+		}
+		std::string line(data + position, lineEnd);
+		position = (lineEnd - data) + 1;
+		if (!line.empty() && line[line.size() - 1] == '\r') {
+			line.erase(line.size() - 1);
+		}
+
+		std::istringstream lineStream(line);
+		std::string keyword;
+		lineStream >> keyword;
+
+		if (isFirstLine) {
+			if (keyword != "ply") {
+				throw std::runtime_error("PlyFileHandler: not a PLY file.");
+			}
+			isFirstLine = false;
+		} else if (keyword == "format") {
+			std::string encodingName;
+			lineStream >> encodingName;
+			if (encodingName == "ascii") {
+				header.encoding = plyAscii;
+			} else if (encodingName == "binary_little_endian") {
+				header.encoding = plyBinaryLittleEndian;
+			} else if (encodingName == "binary_big_endian") {
+				header.encoding = plyBinaryBigEndian;
+			} else {
+				throw std::runtime_error("PlyFileHandler: unknown format " + encodingName);
+			}
+			hasFormat = true;
+		} else if (keyword == "element") {
+			PlyElement element;
+			lineStream >> element.name >> element.count;
+			if (lineStream.fail()) {
+				throw std::runtime_error("PlyFileHandler: invalid element definition: " + line);
+			}
+			element.recordSize = 0;
+			header.elements.push_back(element);
+		} else if (keyword == "property") {
+			if (header.elements.empty()) {
+				throw std::runtime_error("PlyFileHandler: property without element: " + line);
+			}
+			PlyProperty property;
+			std::string typeName;
+			lineStream >> typeName;
+			if (typeName == "list") {
+				std::string countTypeName;
+				lineStream >> countTypeName >> typeName >> property.name;
+				property.isList = true;
+				property.countType = plyTypeFromString(countTypeName);
+			} else {
+				lineStream >> property.name;
+				property.isList = false;
+				property.countType = plyUint8;
+			}
+			property.type = plyTypeFromString(typeName);
+			property.offset = 0;
+			if (lineStream.fail() || property.type == plyUnknown || property.countType == plyUnknown) {
+				throw std::runtime_error("PlyFileHandler: invalid property definition: " + line);
+			}
+			header.elements.back().properties.push_back(property);
+		} else if (keyword == "end_header") {
+			break;
+		}
+		/* comment, obj_info and empty lines are ignored */
+	}
+
+	if (!hasFormat) {
+		throw std::runtime_error("PlyFileHandler: missing format definition.");
+	}
+	header.dataOffset = position;
+
+	/* layout of fixed size records */
+	for (unsigned int i = 0; i < header.elements.size(); ++i) {
+		PlyElement& element = header.elements[i];
+		std::size_t offset = 0;
+		bool isFixedSize = true;
+		for (unsigned int j = 0; j < element.properties.size(); ++j) {
+			element.properties[j].offset = offset;
+			isFixedSize = isFixedSize && !element.properties[j].isList;
+			offset += plyTypeSize(element.properties[j].type);
+		}
+		element.recordSize = isFixedSize ? offset : 0;
+	}
+
+	return header;
+}
+
+/// Skip all records of an element. position is advanced behind the element.
+static void skipPlyElement(const PlyElement& element, PlyEncoding encoding, bool swap, const char* data, std::size_t size, std::size_t& position) {
+	if (encoding == plyAscii) {
+		const char* asciiPosition = data + position;
+		for (unsigned int i = 0; i < element.count; ++i) {
+			for (unsigned int j = 0; j < element.properties.size(); ++j) {
+				unsigned int values = 1;
+				if (element.properties[j].isList) {
+					values = static_cast<unsigned int>(parseAsciiValue(asciiPosition, data + size));
+				}
+				for (unsigned int k = 0; k < values; ++k) {
+					parseAsciiValue(asciiPosition, data + size);
+				}
+			}
+		}
+		position = asciiPosition - data;
+		return;
+	}
+
+	if (element.recordSize > 0) {
+		position += static_cast<std::size_t>(element.count) * element.recordSize;
+		return;
+	}
+	for (unsigned int i = 0; i < element.count; ++i) {
+		for (unsigned int j = 0; j < element.properties.size(); ++j) {
+			const PlyProperty& property = element.properties[j];
+			if (property.isList) {
+				if (position + plyTypeSize(property.countType) > size) {
+					throw std::runtime_error("PlyFileHandler: unexpected end of data.");
+				}
+				std::size_t listSize = static_cast<std::size_t>(readBinaryValue(data + position, property.countType, swap));
+				position += plyTypeSize(property.countType) + listSize * plyTypeSize(property.type);
+			} else {
+				position += plyTypeSize(property.type);
+			}
+		}
+	}
+}
+
+/// Read the vertex element into a contiguous point cloud. position is advanced behind the element.
+template <typename ScalarT>
+static void readPlyVertices(const PlyElement& vertices, PlyEncoding encoding, bool swap, const char* data, std::size_t size, std::size_t& position, PointCloud3DContiguousT<ScalarT>& pointCloud) {
+	const unsigned int count = vertices.count;
+
+	std::vector<PlyRole> roles(vertices.properties.size());
+	bool hasRole[plyRoleIntensity + 1] = {false};
+	for (unsigned int i = 0; i < vertices.properties.size(); ++i) {
+		roles[i] = vertices.properties[i].isList ? plyRoleNone : plyRoleFromName(vertices.properties[i].name);
+		hasRole[roles[i]] = true;
+	}
+	if (!hasRole[plyRoleX] || !hasRole[plyRoleY] || !hasRole[plyRoleZ]) {
+		throw std::runtime_error("PlyFileHandler: vertex element has no x, y and z properties.");
+	}
+
+	/* prepare the columns */
+	pointCloud.clear();
+	pointCloud.disableAttributes();
+	std::vector<ScalarT> x(count);
+	std::vector<ScalarT> y(count);
+	std::vector<ScalarT> z(count);
+	pointCloud.adoptCoordinates(x, y, z);
+	if (hasRole[plyRoleRed] && hasRole[plyRoleGreen] && hasRole[plyRoleBlue]) {
+		pointCloud.enableColors();
+	}
+	if (hasRole[plyRoleNx] && hasRole[plyRoleNy] && hasRole[plyRoleNz]) {
+		pointCloud.enableNormals();
+	}
+	if (hasRole[plyRoleIntensity]) {
+		pointCloud.enableIntensities();
+	}
+	ScalarT* coordinates[3] = {pointCloud.getXCoordinates(), pointCloud.getYCoordinates(), pointCloud.getZCoordinates()};
+	unsigned char* colors = pointCloud.getColors();
+	float* normals = pointCloud.getNormals();
+	float* intensities = pointCloud.getIntensities();
+
+	if (encoding == plyAscii) {
+		const char* asciiPosition = data + position;
+		const char* end = data + size;
+		for (unsigned int i = 0; i < count; ++i) {
+			for (unsigned int j = 0; j < vertices.properties.size(); ++j) {
+				const PlyProperty& property = vertices.properties[j];
+				if (property.isList) {
+					unsigned int listSize = static_cast<unsigned int>(parseAsciiValue(asciiPosition, end));
+					for (unsigned int k = 0; k < listSize; ++k) {
+						parseAsciiValue(asciiPosition, end);
+					}
+					continue;
+				}
+				double value = parseAsciiValue(asciiPosition, end);
+				switch (roles[j]) {
+				case plyRoleX:
+				case plyRoleY:
+				case plyRoleZ:
+					coordinates[roles[j] - plyRoleX][i] = static_cast<ScalarT>(value);
+					break;
+				case plyRoleRed:
+				case plyRoleGreen:
+				case plyRoleBlue:
+					if (colors != 0) {
+						colors[3 * i + (roles[j] - plyRoleRed)] = plyColorValue(value, property.type);
+					}
+					break;
+				case plyRoleNx:
+				case plyRoleNy:
+				case plyRoleNz:
+					if (normals != 0) {
+						normals[3 * i + (roles[j] - plyRoleNx)] = static_cast<float>(value);
+					}
+					break;
+				case plyRoleIntensity:
+					intensities[i] = static_cast<float>(value);
+					break;
+				default:
+					break;
+				}
+			}
+		}
+		position = asciiPosition - data;
+		return;
+	}
+
+	/* binary: copy every property column straight out of the mapped records */
+	if (vertices.recordSize == 0) {
+		throw std::runtime_error("PlyFileHandler: list properties within binary vertex elements are not supported.");
+	}
+	if (position > size || static_cast<std::size_t>(count) * vertices.recordSize > size - position) {
+		pointCloud.clear();
+		throw std::runtime_error("PlyFileHandler: unexpected end of data.");
+	}
+	const char* records = data + position;
+
+	for (unsigned int j = 0; j < vertices.properties.size(); ++j) {
+		const PlyProperty& property = vertices.properties[j];
+		const char* column = records + property.offset;
+		switch (roles[j]) {
+		case plyRoleX:
+		case plyRoleY:
+		case plyRoleZ:
+			extractBinaryColumn(column, vertices.recordSize, count, property.type, swap, coordinates[roles[j] - plyRoleX], 1);
+			break;
+		case plyRoleRed:
+		case plyRoleGreen:
+		case plyRoleBlue:
+			if (colors != 0) {
+				extractBinaryColorColumn(column, vertices.recordSize, count, property.type, swap, colors + (roles[j] - plyRoleRed));
+			}
+			break;
+		case plyRoleNx:
+		case plyRoleNy:
+		case plyRoleNz:
+			if (normals != 0) {
+				extractBinaryColumn(column, vertices.recordSize, count, property.type, swap, normals + (roles[j] - plyRoleNx), 3);
+			}
+			break;
+		case plyRoleIntensity:
+			extractBinaryColumn(column, vertices.recordSize, count, property.type, swap, intensities, 1);
+			break;
+		default:
+			break;
+		}
+	}
+	position += static_cast<std::size_t>(count) * vertices.recordSize;
+}
+
+/// Read the face element as triangle index triples. Polygons are split into triangle fans.
+static void readPlyFaces(const PlyElement& faces, PlyEncoding encoding, bool swap, const char* data, std::size_t size, std::size_t& position, unsigned int numberOfVertices, std::vector<int>& indices) {
+	const char* asciiPosition = data + position;
+	const char* end = data + size;
+	std::vector<int> polygon;
+	bool hasIndexList = false;
+
+	for (unsigned int i = 0; i < faces.count; ++i) {
+		for (unsigned int j = 0; j < faces.properties.size(); ++j) {
+			const PlyProperty& property = faces.properties[j];
+			bool isIndexList = property.isList && (property.name == "vertex_indices" || property.name == "vertex_index");
+			hasIndexList = hasIndexList || isIndexList;
+
+			unsigned int values = 1;
+			if (property.isList) {
+				if (encoding == plyAscii) {
+					values = static_cast<unsigned int>(parseAsciiValue(asciiPosition, end));
+				} else {
+					if (position + plyTypeSize(property.countType) > size) {
+						throw std::runtime_error("PlyFileHandler: unexpected end of data.");
+					}
+					values = static_cast<unsigned int>(readBinaryValue(data + position, property.countType, swap));
+					position += plyTypeSize(property.countType);
+				}
+			}
+
+			polygon.clear();
+			for (unsigned int k = 0; k < values; ++k) {
+				double value;
+				if (encoding == plyAscii) {
+					value = parseAsciiValue(asciiPosition, end);
+				} else {
+					if (position + plyTypeSize(property.type) > size) {
+						throw std::runtime_error("PlyFileHandler: unexpected end of data.");
+					}
+					value = readBinaryValue(data + position, property.type, swap);
+					position += plyTypeSize(property.type);
+				}
+				if (isIndexList) {
+					if (value < 0 || value >= numberOfVertices) {
+						throw std::runtime_error("PlyFileHandler: face refers to a non existing vertex.");
+					}
+					polygon.push_back(static_cast<int>(value));
+				}
+			}
+
+			for (unsigned int k = 2; k < polygon.size(); ++k) {
+				indices.push_back(polygon[0]);
+				indices.push_back(polygon[k - 1]);
+				indices.push_back(polygon[k]);
+			}
+		}
+	}
+
+	if (!hasIndexList && faces.count > 0) {
+		throw std::runtime_error("PlyFileHandler: face element has no vertex_indices property.");
+	}
+	if (encoding == plyAscii) {
+		position = asciiPosition - data;
+	}
+}
+
+/**
+ * Read-only mapping of a whole file into memory. Platforms without mmap read the file into a buffer.
+ */
+class PlyMappedFile {
+public:
+	PlyMappedFile(const std::string& filename);
+	~PlyMappedFile();
+
+	const char* getData() const {
+		return data;
+	}
+
+	std::size_t getSize() const {
+		return size;
+	}
+
+private:
+	PlyMappedFile(const PlyMappedFile&);
+	PlyMappedFile& operator=(const PlyMappedFile&);
+
+	const char* data;
+	std::size_t size;
+#ifdef WIN32
+	std::vector<char> buffer;
+#else
+	void* mapping;
+#endif
+};
+
+PlyMappedFile::PlyMappedFile(const std::string& filename) {
+	data = 0;
+	size = 0;
+#ifdef WIN32
+	std::ifstream inputFile(filename.c_str(), std::ios::in | std::ios::binary);
+	if (!inputFile.is_open()) {
+		throw std::runtime_error("PlyFileHandler: cannot open file " + filename);
+	}
+	inputFile.seekg(0, std::ios::end);
+	size = static_cast<std::size_t>(inputFile.tellg());
+	inputFile.seekg(0, std::ios::beg);
+	buffer.resize(size);
+	if (size > 0) {
+		inputFile.read(&buffer[0], size);
+		data = &buffer[0];
+	}
+#else
+	mapping = 0;
+	int fileDescriptor = open(filename.c_str(), O_RDONLY);
+	if (fileDescriptor < 0) {
+		throw std::runtime_error("PlyFileHandler: cannot open file " + filename);
+	}
+	struct stat fileStatus;
+	if (fstat(fileDescriptor, &fileStatus) != 0) {
+		close(fileDescriptor);
+		throw std::runtime_error("PlyFileHandler: cannot determine size of file " + filename);
+	}
+	size = static_cast<std::size_t>(fileStatus.st_size);
+	if (size > 0) {
+		mapping = mmap(0, size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+		if (mapping == MAP_FAILED) {
+			mapping = 0;
+			close(fileDescriptor);
+			throw std::runtime_error("PlyFileHandler: cannot map file " + filename);
+		}
+#ifdef MADV_SEQUENTIAL
+		madvise(mapping, size, MADV_SEQUENTIAL);
+#endif
+		data = static_cast<const char*>(mapping);
+	}
+	close(fileDescriptor); // the mapping stays valid
+#endif
+}
+
+PlyMappedFile::~PlyMappedFile() {
+#ifndef WIN32
+	if (mapping != 0) {
+		munmap(mapping, size);
+	}
+#endif
+}
+
+template <typename ScalarT>
+void PlyFileHandler::write(const PointCloud3DContiguousT<ScalarT>& pointCloud, const std::string& filename, Format format) {
+	std::ofstream outputFile(filename.c_str(), std::ios::out | std::ios::binary);
+	if (!outputFile.is_open()) {
+		throw std::runtime_error("PlyFileHandler: cannot open file " + filename + " for writing.");
+	}
+
+	const unsigned int size = pointCloud.getSize();
+	const bool hasColors = pointCloud.hasColors();
+	const bool hasNormals = pointCloud.hasNormals();
+	const bool hasIntensities = pointCloud.hasIntensities();
+	const char* coordinateType = (sizeof(ScalarT) == sizeof(float)) ? "float" : "double";
+
+	/* header */
+	outputFile << "ply\n";
+	outputFile << "format " << ((format == ascii) ? "ascii" : "binary_little_endian") << " 1.0\n";
+	outputFile << "comment created by brics_3d::PlyFileHandler\n";
+	outputFile << "element vertex " << size << "\n";
+	outputFile << "property " << coordinateType << " x\n";
+	outputFile << "property " << coordinateType << " y\n";
+	outputFile << "property " << coordinateType << " z\n";
+	if (hasColors) {
+		outputFile << "property uchar red\n";
+		outputFile << "property uchar green\n";
+		outputFile << "property uchar blue\n";
+	}
+	if (hasNormals) {
+		outputFile << "property float nx\n";
+		outputFile << "property float ny\n";
+		outputFile << "property float nz\n";
+	}
+	if (hasIntensities) {
+		outputFile << "property float intensity\n";
+	}
+	outputFile << "end_header\n";
+
+	const ScalarT* x = pointCloud.getXCoordinates();
+	const ScalarT* y = pointCloud.getYCoordinates();
+	const ScalarT* z = pointCloud.getZCoordinates();
+	const unsigned char* colors = pointCloud.getColors();
+	const float* normals = pointCloud.getNormals();
+	const float* intensities = pointCloud.getIntensities();
+
+	if (format == ascii) {
+		const int coordinatePrecision = std::numeric_limits<ScalarT>::digits10 + 3; // enough digits for a lossless round trip
+		const int attributePrecision = std::numeric_limits<float>::digits10 + 3;
+		char line[512];
+		std::string buffer;
+		for (unsigned int i = 0; i < size; ++i) {
+			int length = sprintf(line, "%.*g %.*g %.*g", coordinatePrecision, static_cast<double>(x[i]), coordinatePrecision, static_cast<double>(y[i]), coordinatePrecision, static_cast<double>(z[i]));
+			if (hasColors) {
+				length += sprintf(line + length, " %u %u %u", static_cast<unsigned int>(colors[3 * i + 0]), static_cast<unsigned int>(colors[3 * i + 1]), static_cast<unsigned int>(colors[3 * i + 2]));
+			}
+			if (hasNormals) {
+				length += sprintf(line + length, " %.*g %.*g %.*g", attributePrecision, normals[3 * i + 0], attributePrecision, normals[3 * i + 1], attributePrecision, normals[3 * i + 2]);
+			}
+			if (hasIntensities) {
+				length += sprintf(line + length, " %.*g", attributePrecision, intensities[i]);
+			}
+			line[length++] = '\n';
+			buffer.append(line, length);
+			if (((i + 1) % plyWriteChunkSize) == 0) {
+				outputFile.write(buffer.data(), buffer.size());
+				buffer.clear();
+			}
+		}
+		outputFile.write(buffer.data(), buffer.size());
+	} else {
+		const bool swap = !isLittleEndianHost();
+		const std::size_t recordSize = 3 * sizeof(ScalarT) + (hasColors ? 3 : 0) + (hasNormals ? 3 * sizeof(float) : 0) + (hasIntensities ? sizeof(float) : 0);
+		std::vector<char> buffer(recordSize * std::min(size, plyWriteChunkSize));
+		for (unsigned int chunkStart = 0; chunkStart < size; chunkStart += plyWriteChunkSize) {
+			unsigned int chunkEnd = std::min(size, chunkStart + plyWriteChunkSize);
+			char* record = &buffer[0];
+			for (unsigned int i = chunkStart; i < chunkEnd; ++i) {
+				writeBinaryValue(record, x[i], swap);
+				writeBinaryValue(record, y[i], swap);
+				writeBinaryValue(record, z[i], swap);
+				if (hasColors) {
+					*record++ = static_cast<char>(colors[3 * i + 0]);
+					*record++ = static_cast<char>(colors[3 * i + 1]);
+					*record++ = static_cast<char>(colors[3 * i + 2]);
+				}
+				if (hasNormals) {
+					writeBinaryValue(record, normals[3 * i + 0], swap);
+					writeBinaryValue(record, normals[3 * i + 1], swap);
+					writeBinaryValue(record, normals[3 * i + 2], swap);
+				}
+				if (hasIntensities) {
+					writeBinaryValue(record, intensities[i], swap);
+				}
+			}
+			outputFile.write(&buffer[0], record - &buffer[0]);
+		}
+	}
+
+	if (!outputFile.good()) {
+		throw std::runtime_error("PlyFileHandler: error while writing file " + filename);
+	}
+	outputFile.close();
+}
+
+template <typename ScalarT>
+void PlyFileHandler::read(const std::string& filename, PointCloud3DContiguousT<ScalarT>& pointCloud) {
+	PlyMappedFile file(filename);
+	PlyHeader header = parsePlyHeader(file.getData(), file.getSize());
+	const bool swap = (header.encoding == plyBinaryLittleEndian) != isLittleEndianHost();
+
+	std::size_t position = header.dataOffset;
+	for (unsigned int i = 0; i < header.elements.size(); ++i) {
+		if (header.elements[i].name == "vertex") {
+			readPlyVertices(header.elements[i], header.encoding, swap, file.getData(), file.getSize(), position, pointCloud);
+			return;
+		}
+		skipPlyElement(header.elements[i], header.encoding, swap, file.getData(), file.getSize(), position);
+	}
+	throw std::runtime_error("PlyFileHandler: file has no vertex element: " + filename);
+}
+
+void PlyFileHandler::write(PointCloud3D* pointCloud, const std::string& filename, Format format) {
+	assert(pointCloud != 0);
+	PointCloud3DContiguous contiguousPointCloud;
+	contiguousPointCloud.copyFrom(pointCloud);
+	write(contiguousPointCloud, filename, format);
+}
+
+void PlyFileHandler::read(const std::string& filename, PointCloud3D* pointCloud) {
+	assert(pointCloud != 0);
+	PointCloud3DContiguous contiguousPointCloud;
+	read(filename, contiguousPointCloud);
+	contiguousPointCloud.copyTo(pointCloud);
+}
+
+void PlyFileHandler::write(TriangleMeshImplicit* mesh, const std::string& filename, Format format) {
+	assert(mesh != 0);
+	std::ofstream outputFile(filename.c_str(), std::ios::out | std::ios::binary);
+	if (!outputFile.is_open()) {
+		throw std::runtime_error("PlyFileHandler: cannot open file " + filename + " for writing.");
+	}
+
+	const std::vector<Point3D>& vertices = *mesh->getVertices();
+	const std::vector<int>& indices = *mesh->getIndices();
+	const unsigned int numberOfTriangles = static_cast<unsigned int>(indices.size() / 3);
+
+	outputFile << "ply\n";
+	outputFile << "format " << ((format == ascii) ? "ascii" : "binary_little_endian") << " 1.0\n";
+	outputFile << "comment created by brics_3d::PlyFileHandler\n";
+	outputFile << "element vertex " << vertices.size() << "\n";
+	outputFile << "property double x\n";
+	outputFile << "property double y\n";
+	outputFile << "property double z\n";
+	outputFile << "element face " << numberOfTriangles << "\n";
+	outputFile << "property list uchar int vertex_indices\n";
+	outputFile << "end_header\n";
+
+	if (format == ascii) {
+		const int coordinatePrecision = std::numeric_limits<Coordinate>::digits10 + 3;
+		char line[256];
+		std::string buffer;
+		for (unsigned int i = 0; i < vertices.size(); ++i) {
+			int length = sprintf(line, "%.*g %.*g %.*g\n", coordinatePrecision, vertices[i].getX(), coordinatePrecision, vertices[i].getY(), coordinatePrecision, vertices[i].getZ());
+			buffer.append(line, length);
+		}
+		for (unsigned int i = 0; i < numberOfTriangles; ++i) {
+			int length = sprintf(line, "3 %d %d %d\n", indices[3 * i + 0], indices[3 * i + 1], indices[3 * i + 2]);
+			buffer.append(line, length);
+		}
+		outputFile.write(buffer.data(), buffer.size());
+	} else {
+		const bool swap = !isLittleEndianHost();
+		const std::size_t vertexRecordSize = 3 * sizeof(double);
+		const std::size_t faceRecordSize = 1 + 3 * sizeof(int);
+		std::vector<char> buffer(vertices.size() * vertexRecordSize + numberOfTriangles * faceRecordSize);
+		char* record = buffer.empty() ? 0 : &buffer[0];
+		for (unsigned int i = 0; i < vertices.size(); ++i) {
+			writeBinaryValue(record, static_cast<double>(vertices[i].getX()), swap);
+			writeBinaryValue(record, static_cast<double>(vertices[i].getY()), swap);
+			writeBinaryValue(record, static_cast<double>(vertices[i].getZ()), swap);
+		}
+		for (unsigned int i = 0; i < numberOfTriangles; ++i) {
+			*record++ = 3;
+			writeBinaryValue(record, indices[3 * i + 0], swap);
+			writeBinaryValue(record, indices[3 * i + 1], swap);
+			writeBinaryValue(record, indices[3 * i + 2], swap);
+		}
+		if (!buffer.empty()) {
+			outputFile.write(&buffer[0], buffer.size());
+		}
+	}
+
+	if (!outputFile.good()) {
+		throw std::runtime_error("PlyFileHandler: error while writing file " + filename);
+	}
+	outputFile.close();
+}
+
+void PlyFileHandler::read(const std::string& filename, TriangleMeshImplicit* mesh) {
+	assert(mesh != 0);
+	PlyMappedFile file(filename);
+	PlyHeader header = parsePlyHeader(file.getData(), file.getSize());
+	const bool swap = (header.encoding == plyBinaryLittleEndian) != isLittleEndianHost();
+
+	unsigned int numberOfVertices = 0;
+	bool hasVertices = false;
+	for (unsigned int i = 0; i < header.elements.size(); ++i) {
+		if (header.elements[i].name == "vertex") {
+			numberOfVertices = header.elements[i].count;
+			hasVertices = true;
+		}
+	}
+	if (!hasVertices) {
+		throw std::runtime_error("PlyFileHandler: file has no vertex element: " + filename);
+	}
+
+	PointCloud3DContiguous vertexCloud;
+	std::vector<int>* indices = new std::vector<int>();
+	try {
+		std::size_t position = header.dataOffset;
+		for (unsigned int i = 0; i < header.elements.size(); ++i) {
+			if (header.elements[i].name == "vertex") {
+				readPlyVertices(header.elements[i], header.encoding, swap, file.getData(), file.getSize(), position, vertexCloud);
+			} else if (header.elements[i].name == "face") {
+				readPlyFaces(header.elements[i], header.encoding, swap, file.getData(), file.getSize(), position, numberOfVertices, *indices);
+			} else {
+				skipPlyElement(header.elements[i], header.encoding, swap, file.getData(), file.getSize(), position);
+			}
+		}
+	} catch (std::runtime_error&) {
+		delete indices;
+		throw;
+	}
+
+	std::vector<Point3D>* vertices = new std::vector<Point3D>();
+	vertices->reserve(vertexCloud.getSize());
+	for (unsigned int i = 0; i < vertexCloud.getSize(); ++i) {
+		vertices->push_back(vertexCloud.getPoint(i));
+	}
+	mesh->setVertices(vertices);
+	mesh->setIndices(indices);
+}
+
+/* explicit instantiation for the supported precisions */
+template void PlyFileHandler::write<double>(const PointCloud3DContiguousT<double>& pointCloud, const std::string& filename, Format format);
+template void PlyFileHandler::write<float>(const PointCloud3DContiguousT<float>& pointCloud, const std::string& filename, Format format);
+template void PlyFileHandler::read<double>(const std::string& filename, PointCloud3DContiguousT<double>& pointCloud);
+template void PlyFileHandler::read<float>(const std::string& filename, PointCloud3DContiguousT<float>& pointCloud);
+
+}
+
+/* EOF */
@@ -0,0 +1,118 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+#ifndef BRICS_3D_PLYFILEHANDLER_H_
+#define BRICS_3D_PLYFILEHANDLER_H_
+
+#include <string>
+
+#include "PointCloud3D.h"
+#include "PointCloud3DContiguous.h"
+#include "TriangleMeshImplicit.h"
+
+namespace brics_3d {
+
+/**
+ * @brief Reads and writes point clouds and triangle meshes in the PLY (Stanford polygon) file format.
+ *
+ * Supported are the ascii, binary_little_endian and binary_big_endian encodings. Besides the
+ * x, y and z coordinates the following vertex properties are handled:
+ *  - red, green, blue: colors (integer values 0..255 or floating point values 0..1)
+ *  - nx, ny, nz: normals
+ *  - intensity
+ * Other vertex properties are skipped. For point clouds all other elements (e.g. faces) are skipped as well;
+ * for meshes the vertex_indices of the face element are read, polygons are split into triangles.
+ *
+ * Files are read via a memory mapping: the header is the only part that is parsed. For binary
+ * files the vertex records are then copied from the mapped memory directly into the columns of a
+ * brics_3d::PointCloud3DContiguous.
+ *
+ * Errors are reported as std::runtime_error.
+ */
+class PlyFileHandler {
+public:
+
+	/// Encoding of the data section of a PLY file.
+	enum Format {
+		ascii,
+		binaryLittleEndian
+	};
+
+	/**
+	 * @brief Write a contiguous point cloud including its color, normal and intensity channels.
+	 *
+	 * The coordinates are written with the precision of the point cloud, i.e. as float or double property.
+	 * @param pointCloud The point cloud to be written.
+	 * @param filename Name of the file e.g. point_cloud.ply
+	 * @param format Encoding of the data.
+	 */
+	template <typename ScalarT>
+	static void write(const PointCloud3DContiguousT<ScalarT>& pointCloud, const std::string& filename, Format format = binaryLittleEndian);
+
+	/**
+	 * @brief Read a PLY file into a contiguous point cloud.
+	 *
+	 * The previous content of the point cloud is replaced. Color, normal and intensity channels
+	 * are enabled when the file has the according properties.
+	 * @param filename Name of the file e.g. point_cloud.ply
+	 * @param pointCloud The point cloud that will hold the data.
+	 */
+	template <typename ScalarT>
+	static void read(const std::string& filename, PointCloud3DContiguousT<ScalarT>& pointCloud);
+
+	/**
+	 * @brief Write a point cloud. ColoredPoint3D, Point3DNormal and Point3DIntensity decorations are stored as properties.
+	 * @param pointCloud The point cloud to be written.
+	 * @param filename Name of the file e.g. point_cloud.ply
+	 * @param format Encoding of the data.
+	 */
+	static void write(PointCloud3D* pointCloud, const std::string& filename, Format format = binaryLittleEndian);
+
+	/**
+	 * @brief Read a PLY file and append its points to a point cloud.
+	 *
+	 * Points with colors, normals or intensities are decorated accordingly.
+	 * @param filename Name of the file e.g. point_cloud.ply
+	 * @param pointCloud The point cloud where the points are appended.
+	 */
+	static void read(const std::string& filename, PointCloud3D* pointCloud);
+
+	/**
+	 * @brief Write an indexed triangle mesh as vertex and face elements.
+	 * @param mesh The mesh to be written.
+	 * @param filename Name of the file e.g. mesh.ply
+	 * @param format Encoding of the data.
+	 */
+	static void write(TriangleMeshImplicit* mesh, const std::string& filename, Format format = binaryLittleEndian);
+
+	/**
+	 * @brief Read the vertices and faces of a PLY file into an indexed triangle mesh.
+	 *
+	 * The previous content of the mesh is replaced.
+	 * @param filename Name of the file e.g. mesh.ply
+	 * @param mesh The mesh that will hold the data.
+	 */
+	static void read(const std::string& filename, TriangleMeshImplicit* mesh);
+};
+
+}
+
+#endif /* BRICS_3D_PLYFILEHANDLER_H_ */
+
+/* EOF */
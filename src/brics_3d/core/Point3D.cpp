@@ -18,9 +18,11 @@
 ******************************************************************************/
 
 #include "Point3D.h"
+#include "Point3DArena.h"
 
 #include <math.h>
 #include <cmath>
+#include <new>
 #include <stdexcept>
 
 using std::runtime_error;
@@ -204,6 +206,13 @@ Point3D* Point3D::clone() const {
 	return new Point3D(*this);
 }
 
+Point3D* Point3D::cloneInto(Point3DArena* arena) const {
+	if (arena == 0) {
+		return clone();
+	}
+	return new (arena->allocate(sizeof(Point3D))) Point3D(*this);
+}
+
 ColoredPoint3D* Point3D::asColoredPoint3D() {
 	return 0;
 }
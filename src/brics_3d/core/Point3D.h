@@ -42,6 +42,7 @@ typedef double	Coordinate;				// coordinate data type
 //typedef float	Coordinate;				// coordinate data type
 
 class ColoredPoint3D;
+class Point3DArena;
 
 /**
  * @brief A class to represent a point in the Cartesian space
@@ -189,6 +190,15 @@ public:
 	 */
 	virtual Point3D* clone() const;
 
+	/**
+	 * @brief Creates a clone of the point and all potential decoration layers within an arena.
+	 * Points in an arena must not be deleted, their memory is released together with the arena.
+	 * Classes derived from Point3D have to override this together with clone().
+	 * @param arena The arena. For a null pointer this is the same as clone().
+	 * @return Pointer to cloned object
+	 */
+	virtual Point3D* cloneInto(Point3DArena* arena) const;
+
 	/**
 	 * @brief Convenience function to deduce if this point is decorated with color information.
 	 * @return Pointer to color object or null if there is no such decoration
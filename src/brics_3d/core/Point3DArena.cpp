@@ -0,0 +1,136 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+#include "Point3DArena.h"
+
+#include <cassert>
+#include <cstdlib>
+#include <functional>
+#include <new>
+
+namespace brics_3d {
+
+/// Alignment of all allocations within an arena.
+union ArenaAlignment {
+	void* pointer;
+	double value;
+};
+
+static const std::size_t arenaAlignment = sizeof(ArenaAlignment);
+
+Point3DArena::Point3DArena(std::size_t blockSize) {
+	assert(blockSize >= arenaAlignment);
+	this->blockSize = blockSize & ~(arenaAlignment - 1);
+	current = 0;
+	remaining = 0;
+	allocatedBytes = 0;
+	numberOfAllocations = 0;
+}
+
+Point3DArena::~Point3DArena() {
+	reset();
+	if (!blocks.empty()) {
+		std::free(blocks[0]);
+	}
+}
+
+void* Point3DArena::allocate(std::size_t size) {
+	size = (size + arenaAlignment - 1) & ~(arenaAlignment - 1);
+	allocatedBytes += size;
+	numberOfAllocations++;
+
+	if (size > blockSize) { // dedicated block, the current block is continued afterwards
+		char* block = static_cast<char*>(std::malloc(size));
+		if (block == 0) {
+			throw std::bad_alloc();
+		}
+		largeBlocks.push_back(block);
+		largeBlockSizes.push_back(size);
+		return block;
+	}
+
+	if (size > remaining) {
+		addBlock();
+	}
+	void* result = current;
+	current += size;
+	remaining -= size;
+	return result;
+}
+
+void Point3DArena::reset() {
+	for (unsigned int i = 0; i < largeBlocks.size(); ++i) {
+		std::free(largeBlocks[i]);
+	}
+	largeBlocks.clear();
+	largeBlockSizes.clear();
+	for (unsigned int i = 1; i < blocks.size(); ++i) {
+		std::free(blocks[i]);
+	}
+	if (!blocks.empty()) {
+		blocks.resize(1);
+		current = blocks[0];
+		remaining = blockSize;
+	}
+	allocatedBytes = 0;
+	numberOfAllocations = 0;
+}
+
+bool Point3DArena::contains(const void* object) const {
+	/* std::less gives a total order for pointers into unrelated blocks */
+	std::less<const char*> isLess;
+	const char* address = static_cast<const char*>(object);
+	for (unsigned int i = 0; i < blocks.size(); ++i) {
+		if (!isLess(address, blocks[i]) && isLess(address, blocks[i] + blockSize)) {
+			return true;
+		}
+	}
+	for (unsigned int i = 0; i < largeBlocks.size(); ++i) {
+		if (!isLess(address, largeBlocks[i]) && isLess(address, largeBlocks[i] + largeBlockSizes[i])) {
+			return true;
+		}
+	}
+	return false;
+}
+
+std::size_t Point3DArena::getAllocatedBytes() const {
+	return allocatedBytes;
+}
+
+unsigned int Point3DArena::getNumberOfAllocations() const {
+	return numberOfAllocations;
+}
+
+unsigned int Point3DArena::getNumberOfBlocks() const {
+	return static_cast<unsigned int>(blocks.size() + largeBlocks.size());
+}
+
+void Point3DArena::addBlock() {
+	char* block = static_cast<char*>(std::malloc(blockSize));
+	if (block == 0) {
+		throw std::bad_alloc();
+	}
+	blocks.push_back(block);
+	current = block;
+	remaining = blockSize;
+}
+
+}
+
+/* EOF */
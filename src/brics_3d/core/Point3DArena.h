@@ -0,0 +1,137 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+#ifndef BRICS_3D_POINT3DARENA_H_
+#define BRICS_3D_POINT3DARENA_H_
+
+#include <cstddef>
+#include <vector>
+#include <boost/shared_ptr.hpp>
+
+namespace brics_3d {
+
+/**
+ * @brief Arena (bump pointer) allocator for brics_3d::Point3D and its decoration layers.
+ *
+ * An allocation is just a pointer increment within a large memory block. The arena is only used
+ * on request: brics_3d::Point3D::cloneInto() places a copy of a point (and all of its decoration layers)
+ * into an arena, and a brics_3d::PointCloud3D with an arena (see brics_3d::PointCloud3D::setArena())
+ * creates all of its points that way. Points in an arena are never deleted one by one, so their
+ * destructors do not run; all memory is released at once when the arena is reset() or destroyed.
+ *
+ * A typical use is one arena per frame:
+ *  @code
+ *	Point3DArena::Point3DArenaPtr frameArena(new Point3DArena());
+ *	{
+ *		PointCloud3D cloud;
+ *		cloud.setArena(frameArena);
+ *		... // fill cloud, run filters, segmentation, ...
+ *	} // cloud is destroyed without releasing the points one by one
+ *	frameArena->reset(); // recycle the memory for the next frame
+ *	@endcode
+ *
+ * All points that live in an arena must no longer be used when the arena is reset or destroyed.
+ * An arena is not thread safe.
+ */
+class Point3DArena {
+public:
+
+	typedef boost::shared_ptr<Point3DArena> Point3DArenaPtr;
+
+	/// Default size of one memory block in bytes.
+	static const std::size_t defaultBlockSize = 1024 * 1024;
+
+	/**
+	 * @brief Constructor.
+	 * @param blockSize Size of the memory blocks in bytes. Requests that exceed the block size get a dedicated block.
+	 */
+	Point3DArena(std::size_t blockSize = defaultBlockSize);
+
+	/**
+	 * @brief Destructor. Releases all memory of this arena.
+	 */
+	virtual ~Point3DArena();
+
+	/**
+	 * @brief Allocate raw memory within the arena. The memory is aligned for doubles and pointers.
+	 * @param size Number of bytes.
+	 * @return Pointer to the memory. It is valid until reset() or destruction of the arena.
+	 */
+	void* allocate(std::size_t size);
+
+	/**
+	 * @brief Release all allocations at once. The first block is kept for reuse.
+	 */
+	void reset();
+
+	/**
+	 * @brief Check if memory was handed out by this arena. The costs are linear in the number of blocks.
+	 * @param object Pointer to the memory.
+	 * @return True if the memory belongs to one of the blocks of this arena.
+	 */
+	bool contains(const void* object) const;
+
+	/**
+	 * @brief Number of bytes handed out by allocate() since construction or the last reset().
+	 */
+	std::size_t getAllocatedBytes() const;
+
+	/**
+	 * @brief Number of allocations since construction or the last reset().
+	 */
+	unsigned int getNumberOfAllocations() const;
+
+	/**
+	 * @brief Number of memory blocks that are currently held.
+	 */
+	unsigned int getNumberOfBlocks() const;
+
+private:
+
+	Point3DArena(const Point3DArena&);
+	Point3DArena& operator=(const Point3DArena&);
+
+	/// Start a new regular block.
+	void addBlock();
+
+	/// All regular memory blocks of this arena. The last one is the current block.
+	std::vector<char*> blocks;
+
+	/// Dedicated blocks for requests that exceed the block size.
+	std::vector<char*> largeBlocks;
+
+	/// Size of every dedicated block
+	std::vector<std::size_t> largeBlockSizes;
+
+	/// Next free byte in the current block.
+	char* current;
+
+	/// Number of free bytes in the current block.
+	std::size_t remaining;
+
+	std::size_t blockSize;
+	std::size_t allocatedBytes;
+	unsigned int numberOfAllocations;
+};
+
+}
+
+#endif /* BRICS_3D_POINT3DARENA_H_ */
+
+/* EOF */
@@ -18,6 +18,9 @@
 ******************************************************************************/
 
 #include "Point3DIntensity.h"
+#include "Point3DArena.h"
+
+#include <new>
 
 namespace brics_3d {
 
@@ -68,6 +71,13 @@ Point3D* Point3DIntensity::clone() const {
 	return new Point3DIntensity(point->clone(), intensity);
 }
 
+Point3D* Point3DIntensity::cloneInto(Point3DArena* arena) const {
+	if (arena == 0) {
+		return clone();
+	}
+	return new (arena->allocate(sizeof(Point3DIntensity))) Point3DIntensity(point->cloneInto(arena), intensity);
+}
+
 }
 
 /* EOF */
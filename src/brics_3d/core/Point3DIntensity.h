@@ -46,6 +46,8 @@ public:
 
     virtual Point3D* clone() const;
 
+    virtual Point3D* cloneInto(Point3DArena* arena) const;
+
 protected:
 	double intensity;
 };
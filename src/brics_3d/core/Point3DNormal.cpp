@@ -18,6 +18,9 @@
 ******************************************************************************/
 
 #include "Point3DNormal.h"
+#include "Point3DArena.h"
+
+#include <new>
 
 namespace brics_3d {
 
@@ -74,6 +77,13 @@ Point3D* Point3DNormal::clone() const {
 	return new Point3DNormal(point->clone(), normal);
 }
 
+Point3D* Point3DNormal::cloneInto(Point3DArena* arena) const {
+	if (arena == 0) {
+		return clone();
+	}
+	return new (arena->allocate(sizeof(Point3DNormal))) Point3DNormal(point->cloneInto(arena), normal);
+}
+
 }  // namespace brics_3d
 
 
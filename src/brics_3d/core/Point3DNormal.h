@@ -29,6 +29,7 @@ namespace brics_3d {
  * Decoration layer for a Point3D that carries normal vector information.
  */
 class Point3DNormal : public Point3DDecorator  {
+public:
 
 	Point3DNormal();
 	Point3DNormal(Point3D* point);
@@ -49,6 +50,8 @@ class Point3DNormal : public Point3DDecorator  {
 
     virtual Point3D* clone() const;
 
+    virtual Point3D* cloneInto(Point3DArena* arena) const;
+
 protected:
 	Normal3D normal;
 
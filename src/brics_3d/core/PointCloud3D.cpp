@@ -18,11 +18,14 @@
 ******************************************************************************/
 
 #include "PointCloud3D.h"
+#include "PlyFileHandler.h"
 #include <iostream>
 #include <fstream>
 #include <string>
 #include <sstream>
 #include <stdexcept>
+#include <cassert>
+#include <new>
 
 using namespace std;
 
@@ -41,19 +44,51 @@ PointCloud3D::PointCloud3D() {
 
 PointCloud3D::~PointCloud3D() {
 	if (pointCloud != NULL) {
-		pointCloud->clear();
+		clear();
 		delete pointCloud;
 	}
 }
 
 #ifdef USE_POINTER_VECTOR
 
-void PointCloud3D::addPoint(Point3D point) {
-	pointCloud->push_back(new Point3D(point));
+void PointCloud3D::addPoint(const Point3D& point) {
+	addPoint(point.getX(), point.getY(), point.getZ());
+}
+
+void PointCloud3D::addPoint(Coordinate x, Coordinate y, Coordinate z) {
+	if (arena != 0) {
+		pointCloud->push_back(new (arena->allocate(sizeof(Point3D))) Point3D(x, y, z));
+	} else {
+		pointCloud->push_back(new Point3D(x, y, z));
+	}
 }
 
 void PointCloud3D::addPointPtr(Point3D* point) {
 	pointCloud->push_back(point);
+	if (arena != 0 && !arena->contains(point)) {
+		moveIntoArena(pointCloud->size() - 1);
+	}
+}
+
+void PointCloud3D::addPointClone(const Point3D& point) {
+	pointCloud->push_back(point.cloneInto(arena.get()));
+}
+
+void PointCloud3D::clear() {
+	releaseArenaPoints();
+	pointCloud->clear();
+}
+
+void PointCloud3D::releaseArenaPoints() {
+	if (arena != 0) {
+		pointCloud->base().clear(); // only drops the pointers
+	}
+}
+
+void PointCloud3D::moveIntoArena(unsigned int begin) {
+	for (unsigned int i = begin; i < pointCloud->size(); ++i) {
+		pointCloud->replace(i, (*pointCloud)[i].cloneInto(arena.get())); // the returned heap point is deleted right away
+	}
 }
 
 boost::ptr_vector<Point3D> *PointCloud3D::getPointCloud() {
@@ -61,77 +96,120 @@ boost::ptr_vector<Point3D> *PointCloud3D::getPointCloud() {
 }
 
 void PointCloud3D::setPointCloud(boost::ptr_vector<Point3D> *pointCloud) {
-	if (pointCloud != NULL) {
-		pointCloud->clear();
-		delete pointCloud;
+	if (this->pointCloud != NULL && this->pointCloud != pointCloud) {
+		clear();
+		delete this->pointCloud;
 	}
 	this->pointCloud = pointCloud;
+	if (arena != 0) {
+		moveIntoArena(0);
+	}
+}
+
+void PointCloud3D::adoptPoints(boost::ptr_vector<Point3D>& points) {
+	unsigned int previousSize = pointCloud->size();
+	if (pointCloud->empty()) {
+		pointCloud->swap(points);
+	} else {
+		pointCloud->transfer(pointCloud->end(), points);
+	}
+	if (arena != 0) {
+		moveIntoArena(previousSize);
+	}
 }
 
 #else
 
-void PointCloud3D::addPoint(Point3D point) {
+void PointCloud3D::addPoint(const Point3D& point) {
 	pointCloud->push_back(point);
 }
 
+void PointCloud3D::addPoint(Coordinate x, Coordinate y, Coordinate z) {
+	pointCloud->push_back(Point3D(x, y, z));
+}
+
 void PointCloud3D::addPointPtr(Point3D* point) {
 	pointCloud->push_back(new Point3D(point));
 	delete point;
 }
 
+void PointCloud3D::addPointClone(const Point3D& point) {
+	pointCloud->push_back(Point3D(point));
+}
+
+void PointCloud3D::clear() {
+	pointCloud->clear();
+}
+
 std::vector<Point3D> *PointCloud3D::getPointCloud() {
 	return pointCloud;
 }
 
 void PointCloud3D::setPointCloud(std::vector<Point3D> *pointCloud) {
-	if (pointCloud != NULL) {
-		pointCloud->clear();
-		delete pointCloud;
+	if (this->pointCloud != NULL && this->pointCloud != pointCloud) {
+		this->pointCloud->clear();
+		delete this->pointCloud;
 	}
 	this->pointCloud = pointCloud;
 }
 
+void PointCloud3D::adoptPoints(std::vector<Point3D>& points) {
+	if (pointCloud->empty()) {
+		pointCloud->swap(points);
+	} else {
+		pointCloud->insert(pointCloud->end(), points.begin(), points.end());
+		points.clear();
+	}
+}
+
 
 #endif
 
+void PointCloud3D::addPoints(const double* xyzBuffer, unsigned int numberOfPoints) {
+	assert(xyzBuffer != 0 || numberOfPoints == 0);
+	reserve(getSize() + numberOfPoints);
+	const double* end = xyzBuffer + 3 * numberOfPoints;
+	for (const double* xyz = xyzBuffer; xyz < end; xyz += 3) {
+		addPoint(xyz[0], xyz[1], xyz[2]);
+	}
+}
+
+void PointCloud3D::addPoints(const float* xyzBuffer, unsigned int numberOfPoints) {
+	assert(xyzBuffer != 0 || numberOfPoints == 0);
+	reserve(getSize() + numberOfPoints);
+	const float* end = xyzBuffer + 3 * numberOfPoints;
+	for (const float* xyz = xyzBuffer; xyz < end; xyz += 3) {
+		addPoint(xyz[0], xyz[1], xyz[2]);
+	}
+}
+
+void PointCloud3D::reserve(unsigned int numberOfPoints) {
+	pointCloud->reserve(numberOfPoints);
+}
+
+void PointCloud3D::setArena(Point3DArena::Point3DArenaPtr arena) {
+	if (this->arena != arena && !pointCloud->empty()) {
+		throw runtime_error("PointCloud3D: the arena of a non empty point cloud cannot be set or exchanged.");
+	}
+	this->arena = arena;
+}
+
+Point3DArena::Point3DArenaPtr PointCloud3D::getArena() const {
+	return arena;
+}
+
 unsigned int PointCloud3D::getSize() {
 	return pointCloud->size();
 }
 
-void PointCloud3D::storeToPlyFile(std::string filename) {
-	ofstream outputFile;
-	outputFile.open(filename.c_str());
+void PointCloud3D::storeToPlyFile(std::string filename, bool binary) {
 	cout << "INFO: Saving point cloud to: " << filename << endl;
+	PlyFileHandler::write(this, filename, binary ? PlyFileHandler::binaryLittleEndian : PlyFileHandler::ascii);
+}
 
-	/* write ply header */
-	outputFile << "ply" << endl;
-	outputFile << "format ascii 1.0" << endl;
-	outputFile << "comment created by brics_3d::PointCloud3D::storeToPlyFile" << endl;
-	outputFile << "element vertex " << pointCloud->size() << endl;
-	outputFile << "property float32 x" << endl;
-	outputFile << "property float32 y" << endl;
-	outputFile << "property float32 z" << endl;
-	outputFile << "end_header" << endl;
-
-	/*
-	ply
-	format ascii 1.0
-	comment created by MATLAB plywrite
-	element vertex 24364
-	property float32 x
-	property float32 y
-	property float32 z
-	end_header
-	*/
-
-	/* add data to file */
-	for (unsigned int i = 0; i < pointCloud->size(); ++i) {
-		outputFile << (*pointCloud)[i].getX() << " ";
-		outputFile << (*pointCloud)[i].getY() << " ";
-		outputFile << (*pointCloud)[i].getZ() << endl;
-	}
-
-	outputFile.close();
+void PointCloud3D::readFromPlyFile(std::string filename) {
+	cout << "INFO: Reading point cloud from: " << filename << endl;
+	PlyFileHandler::read(filename, this);
 }
 
 void PointCloud3D::storeToTxtFile(std::string filename) {
@@ -25,6 +25,7 @@
 #include <boost/ptr_container/ptr_vector.hpp>
 
 #include "Point3D.h"
+#include "Point3DArena.h"
 
 #define USE_POINTER_VECTOR
 
@@ -53,15 +54,60 @@ public:
 	 * @brief Add a point to the point cloud
 	 * @param point Point that will be added
 	 */
-	void addPoint(Point3D point);
+	void addPoint(const Point3D& point);
+
+	/**
+	 * @brief Add a point to the point cloud
+	 * The point is directly created from the coordinates without any intermediate copies.
+	 * @param x X coordinate of the new point.
+	 * @param y Y coordinate of the new point.
+	 * @param z Z coordinate of the new point.
+	 */
+	void addPoint(Coordinate x, Coordinate y, Coordinate z);
+
+	/**
+	 * @brief Append a set of points from an interleaved buffer (x1 y1 z1 x2 y2 z2 ...)
+	 * @param xyzBuffer Buffer with 3*numberOfPoints values. The buffer is only read.
+	 * @param numberOfPoints Number of points in the buffer.
+	 */
+	void addPoints(const double* xyzBuffer, unsigned int numberOfPoints);
+
+	/**
+	 * @brief Append a set of points from an interleaved single precision buffer (x1 y1 z1 x2 y2 z2 ...)
+	 * @param xyzBuffer Buffer with 3*numberOfPoints values. The buffer is only read.
+	 * @param numberOfPoints Number of points in the buffer.
+	 */
+	void addPoints(const float* xyzBuffer, unsigned int numberOfPoints);
+
+	/**
+	 * @brief Reserve memory for a known number of points to avoid reallocations while adding points.
+	 * @param numberOfPoints Total number of points the point cloud is expected to hold.
+	 */
+	void reserve(unsigned int numberOfPoints);
 
 	/**
 	 * @brief Add a point to the point cloud with reference semantics.
 	 * Take this function to add complex/decorated point types.
+	 * If the point cloud has an arena, a heap allocated point is moved into the arena, i.e. it is cloned and deleted.
 	 * @param point Pointer to the point. The point cloud will take over ownership for the pointer and take care about automatic deletion.
 	 */
 	void addPointPtr(Point3D* point);
 
+	/**
+	 * @brief Add a copy of a point including all of its decoration layers.
+	 * The copy is placed into the arena of the point cloud (if any), so algorithms should prefer this
+	 * over addPointPtr(point.clone()).
+	 * @param point Point that will be copied.
+	 */
+	void addPointClone(const Point3D& point);
+
+	/**
+	 * @brief Remove all points.
+	 * Points in an arena are not deleted one by one, so this takes constant time for them.
+	 * Use this rather than getPointCloud()->clear(), which must not be called if the point cloud has an arena.
+	 */
+	void clear();
+
 #ifdef USE_POINTER_VECTOR
 	/**
 	 * @brief Get the pointer to the point cloud
@@ -75,9 +121,18 @@ public:
 	 */
     void setPointCloud(boost::ptr_vector<Point3D>* pointCloud);
 
+	/**
+	 * @brief Take over all points of a container without copying them.
+	 * The points are appended to this point cloud. The ownership of the points is transferred, so
+	 * the container is empty afterwards. If this point cloud is empty the storage is swapped in O(1).
+	 * @param points Container with the points to be taken over.
+	 */
+    void adoptPoints(boost::ptr_vector<Point3D>& points);
+
 #else
     std::vector<Point3D>* getPointCloud();
     void setPointCloud(std::vector<Point3D>* pointCloud);
+    void adoptPoints(std::vector<Point3D>& points);
 #endif
 
     /**
@@ -88,9 +143,18 @@ public:
 
     /**
      * @brief Stores the point cloud into a ply file (Stanford polygon file format)
+     *
+     * Colors, normals and intensities of decorated points are stored as well, see brics_3d::PlyFileHandler.
+     * @param filename Specifies the name of the file .e.g. point_cloud.ply
+     * @param binary If true the data is stored in the (much faster and smaller) binary_little_endian encoding, otherwise as ascii.
+     */
+    void storeToPlyFile(std::string filename, bool binary = false);
+
+    /**
+     * @brief Reads data from a ply file (ascii or binary) and appends it to this point cloud
      * @param filename Specifies the name of the file .e.g. point_cloud.ply
      */
-    void storeToPlyFile(std::string filename);
+    void readFromPlyFile(std::string filename);
 
     /**
      * @brief Stores the point cloud into a sipmle text file (x y z)
@@ -133,8 +197,40 @@ public:
 	 */
 	void homogeneousTransformation(IHomogeneousMatrix44* transformation);
 
+	/**
+	 * @brief Place the points of this point cloud into an arena.
+	 *
+	 * All points of the point cloud are allocated within the arena: points created by addPoint(),
+	 * addPoints() and addPointClone(), and points taken over by addPointPtr(), adoptPoints() and setPointCloud().
+	 * Destroying or clearing the point cloud then does not release the points one by one, the memory is
+	 * released together with the arena. The point cloud keeps the arena alive; the same arena can be shared
+	 * by several point clouds (e.g. all clusters of a frame).
+	 *
+	 * As the container returned by getPointCloud() would delete its points, points must not be removed
+	 * through it (use clear()) and must not be moved from it into other containers.
+	 * An arena can only be set or exchanged while the point cloud is empty.
+	 *
+	 * @param arena The arena or a null pointer to allocate new points on the heap.
+	 */
+	void setArena(Point3DArena::Point3DArenaPtr arena);
+
+	/**
+	 * @brief Get the arena for new points of this point cloud.
+	 * @return The arena or a null pointer if points are allocated on the heap.
+	 */
+	Point3DArena::Point3DArenaPtr getArena() const;
+
 protected:
 
+	/// Hand the points over to the arena, so the container does not delete them.
+	void releaseArenaPoints();
+
+	/// Replace the heap allocated points from position begin on by clones within the arena.
+	void moveIntoArena(unsigned int begin);
+
+	/// Optional arena that owns all points
+	Point3DArena::Point3DArenaPtr arena;
+
 #ifdef USE_POINTER_VECTOR
 
 	///Pointer to vector which represents a Cartesian point cloud
@@ -0,0 +1,118 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+
+#ifndef BRICS_3D_POINTCLOUD3DADAPTOR_H_
+#define BRICS_3D_POINTCLOUD3DADAPTOR_H_
+
+#include "PointCloud3D.h"
+#include "PointCloud3DContiguous.h"
+
+#include <cassert>
+
+namespace brics_3d {
+
+/**
+ * @brief Reads the coordinates of a PointCloud3D in place.
+ *
+ * Together with PointCloud3DContiguousAdaptor this gives algorithms that are templated on the point
+ * access (e.g. the KDTree3D, the density grid or the spatial reordering) a uniform interface to both
+ * kinds of point clouds: size(), x(i), y(i) and z(i), all in double precision.
+ *
+ * The point cloud must neither be changed nor deleted as long as the adaptor is in use.
+ */
+class PointCloud3DAdaptor {
+public:
+
+	PointCloud3DAdaptor() : points(0) {
+	}
+
+	PointCloud3DAdaptor(PointCloud3D* pointCloud) {
+		assert(pointCloud != 0);
+		points = pointCloud->getPointCloud();
+	}
+
+	unsigned int size() const {
+		return static_cast<unsigned int>(points->size());
+	}
+
+	double x(unsigned int index) const {
+		return (*points)[index].getX();
+	}
+
+	double y(unsigned int index) const {
+		return (*points)[index].getY();
+	}
+
+	double z(unsigned int index) const {
+		return (*points)[index].getZ();
+	}
+
+private:
+	const boost::ptr_vector<Point3D>* points;
+};
+
+/**
+ * @brief Reads the coordinate columns of a PointCloud3DContiguousT in place.
+ *
+ * The coordinate arrays are invalidated as soon as points are added to the point cloud.
+ */
+template <typename ScalarT>
+class PointCloud3DContiguousAdaptor {
+public:
+
+	PointCloud3DContiguousAdaptor() : xCoordinates(0), yCoordinates(0), zCoordinates(0), count(0) {
+	}
+
+	PointCloud3DContiguousAdaptor(const PointCloud3DContiguousT<ScalarT>* pointCloud) {
+		assert(pointCloud != 0);
+		xCoordinates = pointCloud->getXCoordinates();
+		yCoordinates = pointCloud->getYCoordinates();
+		zCoordinates = pointCloud->getZCoordinates();
+		count = pointCloud->getSize();
+	}
+
+	unsigned int size() const {
+		return count;
+	}
+
+	double x(unsigned int index) const {
+		return xCoordinates[index];
+	}
+
+	double y(unsigned int index) const {
+		return yCoordinates[index];
+	}
+
+	double z(unsigned int index) const {
+		return zCoordinates[index];
+	}
+
+private:
+	const ScalarT* xCoordinates;
+	const ScalarT* yCoordinates;
+	const ScalarT* zCoordinates;
+	unsigned int count;
+};
+
+}
+
+#endif /* BRICS_3D_POINTCLOUD3DADAPTOR_H_ */
+
+/* EOF */
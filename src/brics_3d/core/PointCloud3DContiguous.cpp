@@ -0,0 +1,421 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+#include "PointCloud3DContiguous.h"
+#include "HomogeneousTransformationKernel.h"
+#include "ColoredPoint3D.h"
+#include "Point3DNormal.h"
+#include "Point3DIntensity.h"
+
+#include <cassert>
+#include <stdexcept>
+
+namespace brics_3d {
+
+template <typename ScalarT>
+PointCloud3DContiguousT<ScalarT>::PointCloud3DContiguousT() {
+	colorsEnabled = false;
+	normalsEnabled = false;
+	intensitiesEnabled = false;
+	clear();
+}
+
+template <typename ScalarT>
+PointCloud3DContiguousT<ScalarT>::~PointCloud3DContiguousT() {
+
+}
+
+template <typename ScalarT>
+void PointCloud3DContiguousT<ScalarT>::addPoint(const Point3D& point) {
+	xCoordinates.push_back(static_cast<ScalarT>(point.getX()));
+	yCoordinates.push_back(static_cast<ScalarT>(point.getY()));
+	zCoordinates.push_back(static_cast<ScalarT>(point.getZ()));
+	resizeAttributes();
+}
+
+template <typename ScalarT>
+void PointCloud3DContiguousT<ScalarT>::addPoint(ScalarT x, ScalarT y, ScalarT z) {
+	xCoordinates.push_back(x);
+	yCoordinates.push_back(y);
+	zCoordinates.push_back(z);
+	resizeAttributes();
+}
+
+template <typename ScalarT>
+void PointCloud3DContiguousT<ScalarT>::addPointFrom(const PointCloud3DContiguousT<ScalarT>& source, unsigned int index) {
+	assert(&source != this);
+	assert(index < source.getSize());
+	xCoordinates.push_back(source.xCoordinates[index]);
+	yCoordinates.push_back(source.yCoordinates[index]);
+	zCoordinates.push_back(source.zCoordinates[index]);
+
+	colorsEnabled = colorsEnabled || source.colorsEnabled;
+	normalsEnabled = normalsEnabled || source.normalsEnabled;
+	intensitiesEnabled = intensitiesEnabled || source.intensitiesEnabled;
+	resizeAttributes();
+
+	unsigned int newIndex = getSize() - 1;
+	if (source.colorsEnabled) {
+		colors[3 * newIndex + 0] = source.colors[3 * index + 0];
+		colors[3 * newIndex + 1] = source.colors[3 * index + 1];
+		colors[3 * newIndex + 2] = source.colors[3 * index + 2];
+	}
+	if (source.normalsEnabled) {
+		normals[3 * newIndex + 0] = source.normals[3 * index + 0];
+		normals[3 * newIndex + 1] = source.normals[3 * index + 1];
+		normals[3 * newIndex + 2] = source.normals[3 * index + 2];
+	}
+	if (source.intensitiesEnabled) {
+		intensities[newIndex] = source.intensities[index];
+	}
+}
+
+template <typename ScalarT>
+void PointCloud3DContiguousT<ScalarT>::addPointPtr(Point3D* point) {
+	assert(point != 0);
+	addPoint(*point);
+	delete point;
+}
+
+template <typename ScalarT>
+void PointCloud3DContiguousT<ScalarT>::addPoints(const double* xyzBuffer, unsigned int numberOfPoints) {
+	assert(xyzBuffer != 0 || numberOfPoints == 0);
+	unsigned int offset = getSize();
+	xCoordinates.resize(offset + numberOfPoints);
+	yCoordinates.resize(offset + numberOfPoints);
+	zCoordinates.resize(offset + numberOfPoints);
+
+	for (unsigned int i = 0; i < numberOfPoints; ++i) {
+		xCoordinates[offset + i] = static_cast<ScalarT>(xyzBuffer[3 * i + 0]);
+		yCoordinates[offset + i] = static_cast<ScalarT>(xyzBuffer[3 * i + 1]);
+		zCoordinates[offset + i] = static_cast<ScalarT>(xyzBuffer[3 * i + 2]);
+	}
+	resizeAttributes();
+}
+
+template <typename ScalarT>
+void PointCloud3DContiguousT<ScalarT>::addPoints(const float* xyzBuffer, unsigned int numberOfPoints) {
+	assert(xyzBuffer != 0 || numberOfPoints == 0);
+	unsigned int offset = getSize();
+	xCoordinates.resize(offset + numberOfPoints);
+	yCoordinates.resize(offset + numberOfPoints);
+	zCoordinates.resize(offset + numberOfPoints);
+
+	for (unsigned int i = 0; i < numberOfPoints; ++i) {
+		xCoordinates[offset + i] = static_cast<ScalarT>(xyzBuffer[3 * i + 0]);
+		yCoordinates[offset + i] = static_cast<ScalarT>(xyzBuffer[3 * i + 1]);
+		zCoordinates[offset + i] = static_cast<ScalarT>(xyzBuffer[3 * i + 2]);
+	}
+	resizeAttributes();
+}
+
+template <typename ScalarT>
+void PointCloud3DContiguousT<ScalarT>::reserve(unsigned int numberOfPoints) {
+	xCoordinates.reserve(numberOfPoints);
+	yCoordinates.reserve(numberOfPoints);
+	zCoordinates.reserve(numberOfPoints);
+	if (colorsEnabled) {
+		colors.reserve(3 * numberOfPoints);
+	}
+	if (normalsEnabled) {
+		normals.reserve(3 * numberOfPoints);
+	}
+	if (intensitiesEnabled) {
+		intensities.reserve(numberOfPoints);
+	}
+}
+
+template <typename ScalarT>
+void PointCloud3DContiguousT<ScalarT>::adoptCoordinates(std::vector<ScalarT>& x, std::vector<ScalarT>& y, std::vector<ScalarT>& z) {
+	if ((x.size() != y.size()) || (x.size() != z.size())) {
+		throw std::runtime_error("PointCloud3DContiguous: coordinate columns must have the same size.");
+	}
+	xCoordinates.swap(x);
+	yCoordinates.swap(y);
+	zCoordinates.swap(z);
+	resizeAttributes();
+}
+
+template <typename ScalarT>
+Point3D PointCloud3DContiguousT<ScalarT>::getPoint(unsigned int index) const {
+	assert(index < getSize());
+	return Point3D(static_cast<Coordinate>(xCoordinates[index]), static_cast<Coordinate>(yCoordinates[index]), static_cast<Coordinate>(zCoordinates[index]));
+}
+
+template <typename ScalarT>
+void PointCloud3DContiguousT<ScalarT>::setPoint(unsigned int index, const Point3D& point) {
+	assert(index < getSize());
+	xCoordinates[index] = static_cast<ScalarT>(point.getX());
+	yCoordinates[index] = static_cast<ScalarT>(point.getY());
+	zCoordinates[index] = static_cast<ScalarT>(point.getZ());
+}
+
+template <typename ScalarT>
+unsigned int PointCloud3DContiguousT<ScalarT>::getSize() const {
+	return static_cast<unsigned int>(xCoordinates.size());
+}
+
+template <typename ScalarT>
+void PointCloud3DContiguousT<ScalarT>::clear() {
+	xCoordinates.clear();
+	yCoordinates.clear();
+	zCoordinates.clear();
+	colors.clear();
+	normals.clear();
+	intensities.clear();
+}
+
+template <typename ScalarT>
+ScalarT* PointCloud3DContiguousT<ScalarT>::getXCoordinates() {
+	return xCoordinates.empty() ? 0 : &xCoordinates[0];
+}
+
+template <typename ScalarT>
+const ScalarT* PointCloud3DContiguousT<ScalarT>::getXCoordinates() const {
+	return xCoordinates.empty() ? 0 : &xCoordinates[0];
+}
+
+template <typename ScalarT>
+ScalarT* PointCloud3DContiguousT<ScalarT>::getYCoordinates() {
+	return yCoordinates.empty() ? 0 : &yCoordinates[0];
+}
+
+template <typename ScalarT>
+const ScalarT* PointCloud3DContiguousT<ScalarT>::getYCoordinates() const {
+	return yCoordinates.empty() ? 0 : &yCoordinates[0];
+}
+
+template <typename ScalarT>
+ScalarT* PointCloud3DContiguousT<ScalarT>::getZCoordinates() {
+	return zCoordinates.empty() ? 0 : &zCoordinates[0];
+}
+
+template <typename ScalarT>
+const ScalarT* PointCloud3DContiguousT<ScalarT>::getZCoordinates() const {
+	return zCoordinates.empty() ? 0 : &zCoordinates[0];
+}
+
+template <typename ScalarT>
+void PointCloud3DContiguousT<ScalarT>::copyFrom(PointCloud3D* pointCloud) {
+	assert(pointCloud != 0);
+	unsigned int size = pointCloud->getSize();
+
+	xCoordinates.resize(size);
+	yCoordinates.resize(size);
+	zCoordinates.resize(size);
+	disableAttributes();
+
+	for (unsigned int i = 0; i < size; ++i) {
+		Point3D* tmpPoint = &(*pointCloud->getPointCloud())[i]; //only one operator[] access
+		xCoordinates[i] = static_cast<ScalarT>(tmpPoint->getX());
+		yCoordinates[i] = static_cast<ScalarT>(tmpPoint->getY());
+		zCoordinates[i] = static_cast<ScalarT>(tmpPoint->getZ());
+
+		if (dynamic_cast<Point3DDecorator*>(tmpPoint) == 0) {
+			continue; // plain point: no attributes to look for
+		}
+
+		ColoredPoint3D* coloredPoint = getPointType<ColoredPoint3D>(tmpPoint);
+		if (coloredPoint != 0) {
+			setColor(i, coloredPoint->getR(), coloredPoint->getG(), coloredPoint->getB());
+		}
+		Point3DNormal* normalPoint = getPointType<Point3DNormal>(tmpPoint);
+		if (normalPoint != 0) {
+			Normal3D normal = normalPoint->getNormal();
+			setNormal(i, static_cast<float>(normal.getX()), static_cast<float>(normal.getY()), static_cast<float>(normal.getZ()));
+		}
+		Point3DIntensity* intensityPoint = getPointType<Point3DIntensity>(tmpPoint);
+		if (intensityPoint != 0) {
+			setIntensity(i, static_cast<float>(intensityPoint->getIntensity()));
+		}
+	}
+}
+
+template <typename ScalarT>
+void PointCloud3DContiguousT<ScalarT>::copyTo(PointCloud3D* pointCloud) const {
+	assert(pointCloud != 0);
+	pointCloud->reserve(pointCloud->getSize() + getSize());
+
+	if (!colorsEnabled && !normalsEnabled && !intensitiesEnabled) {
+		for (unsigned int i = 0; i < getSize(); ++i) {
+			pointCloud->addPoint(static_cast<Coordinate>(xCoordinates[i]), static_cast<Coordinate>(yCoordinates[i]), static_cast<Coordinate>(zCoordinates[i]));
+		}
+		return;
+	}
+
+	for (unsigned int i = 0; i < getSize(); ++i) {
+		Point3D* tmpPoint = new Point3D(static_cast<Coordinate>(xCoordinates[i]), static_cast<Coordinate>(yCoordinates[i]), static_cast<Coordinate>(zCoordinates[i]));
+		if (intensitiesEnabled) {
+			tmpPoint = new Point3DIntensity(tmpPoint, intensities[i]);
+		}
+		if (normalsEnabled) {
+			tmpPoint = new Point3DNormal(tmpPoint, Normal3D(normals[3 * i + 0], normals[3 * i + 1], normals[3 * i + 2]));
+		}
+		if (colorsEnabled) { // outermost layer, as this is the most frequently queried one
+			tmpPoint = new ColoredPoint3D(tmpPoint, colors[3 * i + 0], colors[3 * i + 1], colors[3 * i + 2]);
+		}
+		pointCloud->addPointPtr(tmpPoint);
+	}
+}
+
+template <typename ScalarT>
+void PointCloud3DContiguousT<ScalarT>::homogeneousTransformation(IHomogeneousMatrix44* transformation) {
+	assert(transformation != 0);
+	HomogeneousTransformationKernel::transform(transformation->getRawData(), getXCoordinates(), getYCoordinates(), getZCoordinates(), getSize());
+
+	if (normalsEnabled) { // rotate only, cf. Normal3D::homogeneousTransformation
+		const double* matrix = transformation->getRawData();
+		float* normal = getNormals();
+		for (unsigned int i = 0; i < getSize(); ++i) {
+			double nx = normal[0];
+			double ny = normal[1];
+			double nz = normal[2];
+			normal[0] = static_cast<float>(nx * matrix[0] + ny * matrix[4] + nz * matrix[8]);
+			normal[1] = static_cast<float>(nx * matrix[1] + ny * matrix[5] + nz * matrix[9]);
+			normal[2] = static_cast<float>(nx * matrix[2] + ny * matrix[6] + nz * matrix[10]);
+			normal += 3;
+		}
+	}
+}
+
+template <typename ScalarT>
+void PointCloud3DContiguousT<ScalarT>::enableColors() {
+	colorsEnabled = true;
+	resizeAttributes();
+}
+
+template <typename ScalarT>
+void PointCloud3DContiguousT<ScalarT>::enableNormals() {
+	normalsEnabled = true;
+	resizeAttributes();
+}
+
+template <typename ScalarT>
+void PointCloud3DContiguousT<ScalarT>::enableIntensities() {
+	intensitiesEnabled = true;
+	resizeAttributes();
+}
+
+template <typename ScalarT>
+void PointCloud3DContiguousT<ScalarT>::disableAttributes() {
+	colorsEnabled = false;
+	normalsEnabled = false;
+	intensitiesEnabled = false;
+	std::vector<unsigned char>().swap(colors);
+	std::vector<float>().swap(normals);
+	std::vector<float>().swap(intensities);
+}
+
+template <typename ScalarT>
+bool PointCloud3DContiguousT<ScalarT>::hasColors() const {
+	return colorsEnabled;
+}
+
+template <typename ScalarT>
+bool PointCloud3DContiguousT<ScalarT>::hasNormals() const {
+	return normalsEnabled;
+}
+
+template <typename ScalarT>
+bool PointCloud3DContiguousT<ScalarT>::hasIntensities() const {
+	return intensitiesEnabled;
+}
+
+template <typename ScalarT>
+unsigned char* PointCloud3DContiguousT<ScalarT>::getColors() {
+	return colors.empty() ? 0 : &colors[0];
+}
+
+template <typename ScalarT>
+const unsigned char* PointCloud3DContiguousT<ScalarT>::getColors() const {
+	return colors.empty() ? 0 : &colors[0];
+}
+
+template <typename ScalarT>
+float* PointCloud3DContiguousT<ScalarT>::getNormals() {
+	return normals.empty() ? 0 : &normals[0];
+}
+
+template <typename ScalarT>
+const float* PointCloud3DContiguousT<ScalarT>::getNormals() const {
+	return normals.empty() ? 0 : &normals[0];
+}
+
+template <typename ScalarT>
+float* PointCloud3DContiguousT<ScalarT>::getIntensities() {
+	return intensities.empty() ? 0 : &intensities[0];
+}
+
+template <typename ScalarT>
+const float* PointCloud3DContiguousT<ScalarT>::getIntensities() const {
+	return intensities.empty() ? 0 : &intensities[0];
+}
+
+template <typename ScalarT>
+void PointCloud3DContiguousT<ScalarT>::setColor(unsigned int index, unsigned char red, unsigned char green, unsigned char blue) {
+	assert(index < getSize());
+	if (!colorsEnabled) {
+		enableColors();
+	}
+	colors[3 * index + 0] = red;
+	colors[3 * index + 1] = green;
+	colors[3 * index + 2] = blue;
+}
+
+template <typename ScalarT>
+void PointCloud3DContiguousT<ScalarT>::setNormal(unsigned int index, float nx, float ny, float nz) {
+	assert(index < getSize());
+	if (!normalsEnabled) {
+		enableNormals();
+	}
+	normals[3 * index + 0] = nx;
+	normals[3 * index + 1] = ny;
+	normals[3 * index + 2] = nz;
+}
+
+template <typename ScalarT>
+void PointCloud3DContiguousT<ScalarT>::setIntensity(unsigned int index, float intensity) {
+	assert(index < getSize());
+	if (!intensitiesEnabled) {
+		enableIntensities();
+	}
+	intensities[index] = intensity;
+}
+
+template <typename ScalarT>
+void PointCloud3DContiguousT<ScalarT>::resizeAttributes() {
+	unsigned int size = getSize();
+	if (colorsEnabled) {
+		colors.resize(3 * size, 0);
+	}
+	if (normalsEnabled) {
+		normals.resize(3 * size, 0.0f);
+	}
+	if (intensitiesEnabled) {
+		intensities.resize(size, 0.0f);
+	}
+}
+
+/* explicit instantiation for the supported precisions */
+template class PointCloud3DContiguousT<double>;
+template class PointCloud3DContiguousT<float>;
+
+}
+
+/* EOF */
@@ -0,0 +1,336 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+#ifndef BRICS_3D_POINTCLOUD3DCONTIGUOUS_H_
+#define BRICS_3D_POINTCLOUD3DCONTIGUOUS_H_
+
+#include <vector>
+#include <boost/shared_ptr.hpp>
+
+#include "Point3D.h"
+#include "PointCloud3D.h"
+#include "IHomogeneousMatrix44.h"
+
+namespace brics_3d {
+
+/**
+ * @brief Cartesian 3D point cloud with contiguous (structure of arrays) storage.
+ *
+ * The template parameter defines the precision of the stored coordinates. Use the typedefs
+ * brics_3d::PointCloud3DContiguous (Coordinate, i.e. double) or brics_3d::PointCloud3DContiguousFloat
+ * (single precision, half the memory bandwidth and twice the SIMD width). All interfaces that
+ * deal with brics_3d::Point3D convert explicitly from and to Coordinate.
+ *
+ * In contrast to brics_3d::PointCloud3D, which stores every point as a separately allocated
+ * brics_3d::Point3D, this class keeps all x, all y and all z coordinates in three contiguous
+ * columns. Algorithms can directly work on the raw arrays returned by getXCoordinates(),
+ * getYCoordinates() and getZCoordinates(), which is cache friendly and allows the compiler
+ * to vectorize the loops.
+ *
+ * The point oriented API of brics_3d::PointCloud3D (addPoint, addPointPtr, getSize, ...) is
+ * supported as well. Conversion from and to a brics_3d::PointCloud3D is possible with copyFrom()
+ * and copyTo().
+ *
+ * Optionally a point cloud carries per point attribute channels that are stored as contiguous
+ * columns next to the coordinates: color (packed RGB8), normal (3 floats) and intensity (float).
+ * A channel is switched on with enableColors(), enableNormals() or enableIntensities(); all enabled
+ * channels always hold exactly getSize() entries. Points that are added without an attribute get
+ * zero values. copyFrom() and copyTo() translate the channels from and to the decoration layers
+ * brics_3d::ColoredPoint3D, brics_3d::Point3DNormal and brics_3d::Point3DIntensity.
+ *
+ *  @code
+ *	PointCloud3DContiguous* cloud = new PointCloud3DContiguous();
+ *	cloud->addPoint(Point3D(1,2,3));
+ *	cloud->addPoint(4,5,6);
+ *
+ *	Coordinate* x = cloud->getXCoordinates();
+ *	for (unsigned int i = 0; i < cloud->getSize(); ++i) {
+ *		x[i] += 1.0;
+ *	}
+ *	delete cloud;
+ *	@endcode
+ */
+template <typename ScalarT>
+class PointCloud3DContiguousT {
+public:
+
+	typedef ScalarT Scalar;
+	typedef boost::shared_ptr<PointCloud3DContiguousT<ScalarT> > PointCloud3DContiguousPtr;
+	typedef boost::shared_ptr<PointCloud3DContiguousT<ScalarT> const> PointCloud3DContiguousConstPtr;
+
+	/**
+	 * @brief Standard constuctor
+	 */
+	PointCloud3DContiguousT();
+
+	/**
+	 * @brief Standard destructor
+	 */
+	virtual ~PointCloud3DContiguousT();
+
+	/**
+	 * @brief Add a point to the point cloud
+	 * @param point Point that will be added. Only the x,y and z coordinates are stored.
+	 */
+	void addPoint(const Point3D& point);
+
+	/**
+	 * @brief Add a point to the point cloud
+	 * @param x X coordinate of the new point.
+	 * @param y Y coordinate of the new point.
+	 * @param z Z coordinate of the new point.
+	 */
+	void addPoint(ScalarT x, ScalarT y, ScalarT z);
+
+	/**
+	 * @brief Append the ith point of another point cloud including its attributes.
+	 * Channels that are enabled in the source are enabled here as well. Typically used by filters
+	 * that copy a selected subset of a point cloud.
+	 * @param source The point cloud to copy from. Must not be this point cloud.
+	 * @param index Index of the point within source.
+	 */
+	void addPointFrom(const PointCloud3DContiguousT<ScalarT>& source, unsigned int index);
+
+	/**
+	 * @brief Add a point to the point cloud with the same semantics as brics_3d::PointCloud3D::addPointPtr
+	 * The coordinates are copied and the point will be deleted afterwards.
+	 * @param point Pointer to the point. The point cloud takes over ownership.
+	 */
+	void addPointPtr(Point3D* point);
+
+	/**
+	 * @brief Append a set of points from an interleaved buffer (x1 y1 z1 x2 y2 z2 ...)
+	 * @param xyzBuffer Buffer with 3*numberOfPoints values. The buffer is only read.
+	 * @param numberOfPoints Number of points in the buffer.
+	 */
+	void addPoints(const double* xyzBuffer, unsigned int numberOfPoints);
+
+	/**
+	 * @brief Append a set of points from an interleaved single precision buffer (x1 y1 z1 x2 y2 z2 ...)
+	 * @param xyzBuffer Buffer with 3*numberOfPoints values. The buffer is only read.
+	 * @param numberOfPoints Number of points in the buffer.
+	 */
+	void addPoints(const float* xyzBuffer, unsigned int numberOfPoints);
+
+	/**
+	 * @brief Reserve memory for a known number of points to avoid reallocations while adding points.
+	 * @param numberOfPoints Total number of points the point cloud is expected to hold.
+	 */
+	void reserve(unsigned int numberOfPoints);
+
+	/**
+	 * @brief Take over existing coordinate columns without copying them.
+	 * The current content of the point cloud is exchanged with the given vectors (O(1) swap), so
+	 * the vectors hold the previous coordinates afterwards.
+	 * @param x X coordinates. Must have the same size as y and z.
+	 * @param y Y coordinates.
+	 * @param z Z coordinates.
+	 */
+	void adoptCoordinates(std::vector<ScalarT>& x, std::vector<ScalarT>& y, std::vector<ScalarT>& z);
+
+	/**
+	 * @brief Get a copy of the ith point.
+	 * @param index Index of the point. Must be smaller than getSize().
+	 * @return The point.
+	 */
+	Point3D getPoint(unsigned int index) const;
+
+	/**
+	 * @brief Overwrite the coordinates of the ith point.
+	 * @param index Index of the point. Must be smaller than getSize().
+	 * @param point The new coordinates.
+	 */
+	void setPoint(unsigned int index, const Point3D& point);
+
+	/**
+	 * @brief Get the number of points in the point cloud
+	 * @return Size of point cloud (= number of stored points)
+	 */
+	unsigned int getSize() const;
+
+	/**
+	 * @brief Remove all points.
+	 */
+	void clear();
+
+	/**
+	 * @brief Get the raw array of all x coordinates.
+	 * The array holds getSize() elements. The pointer is invalidated as soon as points are added.
+	 */
+	ScalarT* getXCoordinates();
+	const ScalarT* getXCoordinates() const;
+
+	/**
+	 * @brief Get the raw array of all y coordinates.
+	 * The array holds getSize() elements. The pointer is invalidated as soon as points are added.
+	 */
+	ScalarT* getYCoordinates();
+	const ScalarT* getYCoordinates() const;
+
+	/**
+	 * @brief Get the raw array of all z coordinates.
+	 * The array holds getSize() elements. The pointer is invalidated as soon as points are added.
+	 */
+	ScalarT* getZCoordinates();
+	const ScalarT* getZCoordinates() const;
+
+	/**
+	 * @brief Replace the content of this point cloud by the coordinates of a brics_3d::PointCloud3D
+	 * Color, normal and intensity decoration layers are translated into the corresponding channels.
+	 * A channel is enabled if at least one point carries such a decoration.
+	 * @param pointCloud The point cloud that will be copied.
+	 */
+	void copyFrom(PointCloud3D* pointCloud);
+
+	/**
+	 * @brief Append all points of this point cloud to a brics_3d::PointCloud3D
+	 * Enabled attribute channels are translated into the corresponding decoration layers.
+	 * This allows to use algorithms that still require the brics_3d::PointCloud3D::getPointCloud() interface.
+	 * @param pointCloud The point cloud where the points will be appended to.
+	 */
+	void copyTo(PointCloud3D* pointCloud) const;
+
+	/**
+	 * @brief Replace the content of this point cloud by the coordinates of a point cloud with a different precision.
+	 * @param pointCloud The point cloud that will be copied. Values are explicitly casted to ScalarT.
+	 */
+	template <typename OtherScalarT>
+	void copyFrom(const PointCloud3DContiguousT<OtherScalarT>& pointCloud) {
+		unsigned int size = pointCloud.getSize();
+		xCoordinates.assign(pointCloud.getXCoordinates(), pointCloud.getXCoordinates() + size);
+		yCoordinates.assign(pointCloud.getYCoordinates(), pointCloud.getYCoordinates() + size);
+		zCoordinates.assign(pointCloud.getZCoordinates(), pointCloud.getZCoordinates() + size);
+
+		/* attributes do not depend on the precision */
+		colorsEnabled = pointCloud.hasColors();
+		normalsEnabled = pointCloud.hasNormals();
+		intensitiesEnabled = pointCloud.hasIntensities();
+		colors.assign(pointCloud.getColors(), pointCloud.getColors() + (colorsEnabled ? 3 * size : 0));
+		normals.assign(pointCloud.getNormals(), pointCloud.getNormals() + (normalsEnabled ? 3 * size : 0));
+		intensities.assign(pointCloud.getIntensities(), pointCloud.getIntensities() + (intensitiesEnabled ? size : 0));
+	}
+
+	/**
+	 * @brief Applies a homogeneous transformation to the point cloud
+	 * Normals (if enabled) are rotated as well.
+	 *
+	 * @param[in] transformation The homogeneous transformation matrix that will be applied
+	 */
+	void homogeneousTransformation(IHomogeneousMatrix44* transformation);
+
+	/**
+	 * @brief Add a color channel. Already existing points get the color (0,0,0).
+	 */
+	void enableColors();
+
+	/**
+	 * @brief Add a normal channel. Already existing points get the normal (0,0,0).
+	 */
+	void enableNormals();
+
+	/**
+	 * @brief Add an intensity channel. Already existing points get the intensity 0.
+	 */
+	void enableIntensities();
+
+	/**
+	 * @brief Remove all attribute channels and release their memory.
+	 */
+	void disableAttributes();
+
+	bool hasColors() const;
+	bool hasNormals() const;
+	bool hasIntensities() const;
+
+	/**
+	 * @brief Get the raw array of packed colors (r1 g1 b1 r2 g2 b2 ...).
+	 * The array holds 3*getSize() elements or is null if there is no color channel.
+	 */
+	unsigned char* getColors();
+	const unsigned char* getColors() const;
+
+	/**
+	 * @brief Get the raw array of interleaved normals (nx1 ny1 nz1 nx2 ny2 nz2 ...).
+	 * The array holds 3*getSize() elements or is null if there is no normal channel.
+	 */
+	float* getNormals();
+	const float* getNormals() const;
+
+	/**
+	 * @brief Get the raw array of intensities.
+	 * The array holds getSize() elements or is null if there is no intensity channel.
+	 */
+	float* getIntensities();
+	const float* getIntensities() const;
+
+	/**
+	 * @brief Set the color of the ith point. The color channel is enabled if necessary.
+	 */
+	void setColor(unsigned int index, unsigned char red, unsigned char green, unsigned char blue);
+
+	/**
+	 * @brief Set the normal of the ith point. The normal channel is enabled if necessary.
+	 */
+	void setNormal(unsigned int index, float nx, float ny, float nz);
+
+	/**
+	 * @brief Set the intensity of the ith point. The intensity channel is enabled if necessary.
+	 */
+	void setIntensity(unsigned int index, float intensity);
+
+protected:
+
+	/// Bring all enabled attribute channels to the size of the coordinate columns.
+	void resizeAttributes();
+
+	/// All x coordinates
+	std::vector<ScalarT> xCoordinates;
+
+	/// All y coordinates
+	std::vector<ScalarT> yCoordinates;
+
+	/// All z coordinates
+	std::vector<ScalarT> zCoordinates;
+
+	/// Packed RGB8 colors, valid if colorsEnabled is set
+	std::vector<unsigned char> colors;
+
+	/// Interleaved normals, valid if normalsEnabled is set
+	std::vector<float> normals;
+
+	/// Intensities, valid if intensitiesEnabled is set
+	std::vector<float> intensities;
+
+	bool colorsEnabled;
+	bool normalsEnabled;
+	bool intensitiesEnabled;
+
+};
+
+/// Contiguous point cloud with the default Coordinate precision.
+typedef PointCloud3DContiguousT<Coordinate> PointCloud3DContiguous;
+
+/// Contiguous point cloud with single precision coordinates.
+typedef PointCloud3DContiguousT<float> PointCloud3DContiguousFloat;
+
+}
+
+#endif /* BRICS_3D_POINTCLOUD3DCONTIGUOUS_H_ */
+
+/* EOF */
@@ -0,0 +1,183 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+#include "PointCloud3DContiguousIterator.h"
+#include "HomogeneousMatrix44.h"
+#include "AffineTransform44.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace brics_3d {
+
+template <typename ScalarT>
+PointCloud3DContiguousIteratorT<ScalarT>::PointCloud3DContiguousIteratorT() {
+	begin();
+}
+
+template <typename ScalarT>
+PointCloud3DContiguousIteratorT<ScalarT>::~PointCloud3DContiguousIteratorT() {
+
+}
+
+template <>
+std::string PointCloud3DContiguousIteratorT<double>::getPointCloudTypeName() {
+	return "brics_3d::PointCloud3DContiguous";
+}
+
+template <>
+std::string PointCloud3DContiguousIteratorT<float>::getPointCloudTypeName() {
+	return "brics_3d::PointCloud3DContiguousFloat";
+}
+
+template <typename ScalarT>
+void PointCloud3DContiguousIteratorT<ScalarT>::begin() {
+	index = 0;
+	cloudIndex = 0;
+
+	while(!end() && (pointClouds[cloudIndex]->getSize() <= 0)) { //skip empty clouds
+		cloudIndex++;
+	}
+
+	if (!end()) {
+		updateCurrentPoint();
+	}
+}
+
+template <typename ScalarT>
+void PointCloud3DContiguousIteratorT<ScalarT>::next() {
+	if (end()) {
+		return;
+	}
+
+	++index;
+	if (index >= pointClouds[cloudIndex]->getSize()) { //wrap over - advance to next point cloud
+		index = 0;
+		cloudIndex++;
+		while(!end() && (pointClouds[cloudIndex]->getSize() <= 0)) { //skip further empty clouds
+			cloudIndex++;
+		}
+	}
+
+	if (!end()) {
+		updateCurrentPoint();
+	}
+}
+
+template <typename ScalarT>
+bool PointCloud3DContiguousIteratorT<ScalarT>::end() {
+	return (cloudIndex >= pointClouds.size());
+}
+
+template <typename ScalarT>
+Coordinate PointCloud3DContiguousIteratorT<ScalarT>::getX() {
+	return currentTransformedPoint.getX();
+}
+
+template <typename ScalarT>
+Coordinate PointCloud3DContiguousIteratorT<ScalarT>::getY() {
+	return currentTransformedPoint.getY();
+}
+
+template <typename ScalarT>
+Coordinate PointCloud3DContiguousIteratorT<ScalarT>::getZ() {
+	return currentTransformedPoint.getZ();
+}
+
+template <typename ScalarT>
+Point3D* PointCloud3DContiguousIteratorT<ScalarT>::getRawData() {
+	return &currentRawPoint;
+}
+
+template <typename ScalarT>
+unsigned int PointCloud3DContiguousIteratorT<ScalarT>::nextBlock(unsigned int maxPoints, Coordinate* xyz) {
+	assert(xyz != 0 || maxPoints == 0);
+	unsigned int count = 0;
+
+	while (!end() && (count < maxPoints)) {
+		/* interleave as many points of the current cloud as fit into the block... */
+		const PointCloudType* cloud = pointClouds[cloudIndex].get();
+		unsigned int blockSize = std::min(maxPoints - count, cloud->getSize() - index);
+		const ScalarT* x = cloud->getXCoordinates() + index;
+		const ScalarT* y = cloud->getYCoordinates() + index;
+		const ScalarT* z = cloud->getZCoordinates() + index;
+		Coordinate* blockStart = xyz + 3 * count;
+		for (unsigned int i = 0; i < blockSize; ++i) {
+			blockStart[3 * i + 0] = static_cast<Coordinate>(x[i]);
+			blockStart[3 * i + 1] = static_cast<Coordinate>(y[i]);
+			blockStart[3 * i + 2] = static_cast<Coordinate>(z[i]);
+		}
+
+		/* ...and transform them at once */
+		if (associatedTransformIsIdentity[cloudIndex] == false) {
+			AffineTransform44::transformPoints(associatedTransforms[cloudIndex]->getRawData(), blockStart, blockSize);
+		}
+
+		count += blockSize;
+		index += blockSize;
+		if (index >= cloud->getSize()) { //wrap over - advance to next point cloud
+			index = 0;
+			cloudIndex++;
+			while(!end() && (pointClouds[cloudIndex]->getSize() <= 0)) { //skip further empty clouds
+				cloudIndex++;
+			}
+		}
+	}
+
+	if (!end()) {
+		updateCurrentPoint();
+	}
+	return count;
+}
+
+template <typename ScalarT>
+void PointCloud3DContiguousIteratorT<ScalarT>::insert(typename PointCloudType::PointCloud3DContiguousPtr pointCloud, IHomogeneousMatrix44::IHomogeneousMatrix44Ptr associatedTransform) {
+	assert(pointCloud != 0);
+	assert(associatedTransform != 0);
+	pointClouds.push_back(pointCloud);
+	associatedTransforms.push_back(associatedTransform);
+	associatedTransformIsIdentity.push_back(associatedTransform->isIdentity());
+}
+
+template <typename ScalarT>
+void PointCloud3DContiguousIteratorT<ScalarT>::insert(typename PointCloudType::PointCloud3DContiguousPtr pointCloud) {
+	IHomogeneousMatrix44::IHomogeneousMatrix44Ptr identityTransform(new HomogeneousMatrix44());
+	insert(pointCloud, identityTransform);
+}
+
+template <typename ScalarT>
+void PointCloud3DContiguousIteratorT<ScalarT>::updateCurrentPoint() {
+	const PointCloudType* cloud = pointClouds[cloudIndex].get();
+	currentRawPoint.setX(static_cast<Coordinate>(cloud->getXCoordinates()[index]));
+	currentRawPoint.setY(static_cast<Coordinate>(cloud->getYCoordinates()[index]));
+	currentRawPoint.setZ(static_cast<Coordinate>(cloud->getZCoordinates()[index]));
+
+	currentTransformedPoint = currentRawPoint;
+	if (associatedTransformIsIdentity[cloudIndex] == false) { // the non "lazyness" case
+		currentTransformedPoint.homogeneousTransformation(associatedTransforms[cloudIndex].get());
+	}
+}
+
+/* explicit instantiation for the supported precisions */
+template class PointCloud3DContiguousIteratorT<double>;
+template class PointCloud3DContiguousIteratorT<float>;
+
+}
+
+/* EOF */
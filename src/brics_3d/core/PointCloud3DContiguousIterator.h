@@ -0,0 +1,125 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+#ifndef BRICS_3D_POINTCLOUD3DCONTIGUOUSITERATOR_H_
+#define BRICS_3D_POINTCLOUD3DCONTIGUOUSITERATOR_H_
+
+#include <vector>
+
+#include "IPoint3DIterator.h"
+#include "PointCloud3DContiguous.h"
+#include "IHomogeneousMatrix44.h"
+
+namespace brics_3d {
+
+/**
+ * @brief Point iterator implementation for brics_3d::PointCloud3DContiguous
+ *
+ * Works like brics_3d::PointCloud3DIterator: a list of point clouds with associated rigid
+ * transforms can be inserted and getX(), getY() and getZ() return the transformed coordinates.
+ * The clouds are iterated in the order of insertion.
+ *
+ * As a brics_3d::PointCloud3DContiguous has no per point objects, getRawData() returns a pointer
+ * to an internal copy of the current (untransformed) point that is only valid until the next
+ * call of next().
+ *
+ * The template parameter is the precision of the iterated point clouds. The coordinates are
+ * converted to Coordinate when they are accessed via the IPoint3DIterator interface.
+ */
+template <typename ScalarT>
+class PointCloud3DContiguousIteratorT : public IPoint3DIterator {
+
+public:
+
+	typedef PointCloud3DContiguousT<ScalarT> PointCloudType;
+	typedef boost::shared_ptr<PointCloud3DContiguousIteratorT<ScalarT> > PointCloud3DContiguousIteratorPtr;
+	typedef boost::shared_ptr<PointCloud3DContiguousIteratorT<ScalarT> const> PointCloud3DContiguousIteratorConstPtr;
+
+	/**
+	 * @brief Standard constructor.
+	 */
+	PointCloud3DContiguousIteratorT();
+
+	/**
+	 * @brief Standard destructor.
+	 */
+	virtual ~PointCloud3DContiguousIteratorT();
+
+	std::string getPointCloudTypeName();
+	void begin();
+	void next();
+	bool end();
+
+	virtual Coordinate getX(); // (possibly) transformed
+	virtual Coordinate getY(); // (possibly) transformed
+	virtual Coordinate getZ(); // (possibly) transformed
+	virtual Point3D* getRawData(); //not transformed
+	virtual unsigned int nextBlock(unsigned int maxPoints, Coordinate* xyz);
+
+	/**
+	 * @brief Add a point cloud with its associated transform.
+	 * @param pointCloud The point cloud to be added.
+	 * @param associatedTransform Transform that will be automatically applied to all points of that point cloud when calling getX(), getY() or getZ().
+	 */
+	void insert(typename PointCloudType::PointCloud3DContiguousPtr pointCloud, IHomogeneousMatrix44::IHomogeneousMatrix44Ptr associatedTransform);
+
+	/**
+	 * @brief Add a point cloud with an assumed identity transform.
+	 * @param pointCloud The point cloud to be added.
+	 */
+	void insert(typename PointCloudType::PointCloud3DContiguousPtr pointCloud);
+
+protected:
+
+	/// Compute the transformed version of the current point.
+	void updateCurrentPoint();
+
+	/// The stored point clouds. Destruction of the iterator will not delete them.
+	std::vector<typename PointCloudType::PointCloud3DContiguousPtr> pointClouds;
+
+	/// Associated transforms. The ith entry belongs to the ith point cloud.
+	std::vector<IHomogeneousMatrix44::IHomogeneousMatrix44Ptr> associatedTransforms;
+
+	/// Shortcut for identity transforms. The ith entry belongs to the ith point cloud.
+	std::vector<bool> associatedTransformIsIdentity;
+
+	/// Internal outer iteration handle.
+	unsigned int cloudIndex;
+
+	/// Internal inner iteration handle.
+	unsigned int index;
+
+	/// The cached transformed data.
+	Point3D currentTransformedPoint;
+
+	/// The cached raw data.
+	Point3D currentRawPoint;
+};
+
+/// Iterator for point clouds with the default Coordinate precision.
+typedef PointCloud3DContiguousIteratorT<Coordinate> PointCloud3DContiguousIterator;
+
+/// Iterator for point clouds with single precision coordinates.
+typedef PointCloud3DContiguousIteratorT<float> PointCloud3DContiguousFloatIterator;
+
+}
+
+#endif /* BRICS_3D_POINTCLOUD3DCONTIGUOUSITERATOR_H_ */
+
+/* EOF */
@@ -20,8 +20,11 @@
 
 #include "PointCloud3DIterator.h"
 #include "HomogeneousMatrix44.h"
+#include "AffineTransform44.h"
 #include "Logger.h"
 
+#include <algorithm>
+
 namespace brics_3d {
 
 PointCloud3DIterator::PointCloud3DIterator() {
@@ -48,15 +51,7 @@ void PointCloud3DIterator::begin() {
 	}
 
 	if ( !end() ) {
-
-		Point3D* tmpHandle = &((*pointCloudsIterator->first->getPointCloud())[index]); //only one operator[] access - which is sightly faster
-		currentTransformedPoint.setX(tmpHandle->getX());
-		currentTransformedPoint.setY(tmpHandle->getY());
-		currentTransformedPoint.setZ(tmpHandle->getZ());
-		if(*associatedTransformIsIdentityIterator == false) { // the non "lazyness" case
-			currentTransformedPoint.homogeneousTransformation(pointCloudsIterator->second.get());
-		}
-
+		updateCurrentPoint();
 	} else {
 		pointCloudsIterator = pointCloudsWithTransforms.end(); // empty iterator
 	}
@@ -68,27 +63,11 @@ void PointCloud3DIterator::next() {
 	if ( !end() ) {
 
 		if(index >= pointCloudsIterator->first->getSize()) { //wrap over - advance to next point cloud
-			index = 0;
-			pointCloudsIterator++;
-			associatedTransformIsIdentityIterator++;
-
-			while(!end() && (pointCloudsIterator->first->getSize() <= 0)) { //skip further empty clouds
-				pointCloudsIterator++;
-				associatedTransformIsIdentityIterator++;
-				LOG(WARNING) << "PointCloud3DIterator contains empty point clouds.";
-			}
+			advanceToNextPointCloud();
 		}
 
 		if ( !end() ) { // end could be reach meanwhile so we have to check again
-
-			Point3D* tmpHandle = &((*pointCloudsIterator->first->getPointCloud())[index]); //only one operator[] access - which is slightly faster
-			currentTransformedPoint.setX(tmpHandle->getX());
-			currentTransformedPoint.setY(tmpHandle->getY());
-			currentTransformedPoint.setZ(tmpHandle->getZ());
-			if(*associatedTransformIsIdentityIterator == false) { // the non "lazyness" case
-				currentTransformedPoint.homogeneousTransformation(pointCloudsIterator->second.get());
-			}
-
+			updateCurrentPoint();
 		}
 	} else {
 		/* no further iterations, we are at the end */
@@ -118,6 +97,63 @@ Point3D* PointCloud3DIterator::getRawData() {
 	return &(*pointCloudsIterator->first->getPointCloud())[index];
 }
 
+unsigned int PointCloud3DIterator::nextBlock(unsigned int maxPoints, Coordinate* xyz) {
+	assert(xyz != 0 || maxPoints == 0);
+	unsigned int count = 0;
+
+	while (!end() && (count < maxPoints)) {
+		/* copy as many points of the current cloud as fit into the block... */
+		boost::ptr_vector<Point3D>* points = pointCloudsIterator->first->getPointCloud();
+		unsigned int blockSize = std::min(maxPoints - count, static_cast<unsigned int>(points->size()) - index);
+		Coordinate* blockStart = xyz + 3 * count;
+		Coordinate* blockData = blockStart;
+		for (unsigned int i = index; i < index + blockSize; ++i) {
+			const Point3D& point = (*points)[i];
+			*blockData++ = point.getX();
+			*blockData++ = point.getY();
+			*blockData++ = point.getZ();
+		}
+
+		/* ...and transform them at once */
+		if(*associatedTransformIsIdentityIterator == false) {
+			AffineTransform44::transformPoints(pointCloudsIterator->second->getRawData(), blockStart, blockSize);
+		}
+
+		count += blockSize;
+		index += blockSize;
+		if (index >= points->size()) {
+			advanceToNextPointCloud();
+		}
+	}
+
+	if (!end()) {
+		updateCurrentPoint();
+	}
+	return count;
+}
+
+void PointCloud3DIterator::updateCurrentPoint() {
+	Point3D* tmpHandle = &((*pointCloudsIterator->first->getPointCloud())[index]); //only one operator[] access - which is slightly faster
+	currentTransformedPoint.setX(tmpHandle->getX());
+	currentTransformedPoint.setY(tmpHandle->getY());
+	currentTransformedPoint.setZ(tmpHandle->getZ());
+	if(*associatedTransformIsIdentityIterator == false) { // the non "lazyness" case
+		currentTransformedPoint.homogeneousTransformation(pointCloudsIterator->second.get());
+	}
+}
+
+void PointCloud3DIterator::advanceToNextPointCloud() {
+	index = 0;
+	pointCloudsIterator++;
+	associatedTransformIsIdentityIterator++;
+
+	while(!end() && (pointCloudsIterator->first->getSize() <= 0)) { //skip further empty clouds
+		pointCloudsIterator++;
+		associatedTransformIsIdentityIterator++;
+		LOG(WARNING) << "PointCloud3DIterator contains empty point clouds.";
+	}
+}
+
 void PointCloud3DIterator::insert(PointCloud3D::PointCloud3DPtr pointCloud, IHomogeneousMatrix44::IHomogeneousMatrix44Ptr associatedTransform) {
 	assert(pointCloud != 0);
 	assert(associatedTransform != 0);
@@ -84,6 +84,7 @@ public:
 	virtual Coordinate getY(); // (possibly) transformed
 	virtual Coordinate getZ(); // (possibly) transformed
 	virtual Point3D* getRawData(); //not transformed, but might have additional data like color, etc.
+	virtual unsigned int nextBlock(unsigned int maxPoints, Coordinate* xyz);
 
 	/**
 	 * @brief Add a point cloud with its associated transform.
@@ -102,6 +103,12 @@ public:
 
 protected:
 
+	/// Compute the transformed version of the current point.
+	void updateCurrentPoint();
+
+	/// Move to the first point of the next non empty point cloud.
+	void advanceToNextPointCloud();
+
 	/**
 	 * The stored pointers to the point clouds with associated transforms.
 	 * Destruction of the iterator will not delete the pointers.
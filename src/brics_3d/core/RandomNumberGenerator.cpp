@@ -0,0 +1,73 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+
+#include "RandomNumberGenerator.h"
+
+#include <cassert>
+
+namespace brics_3d {
+
+RandomNumberGenerator::RandomNumberGenerator(boost::uint64_t seed) {
+	setSeed(seed);
+}
+
+RandomNumberGenerator::~RandomNumberGenerator() {
+
+}
+
+void RandomNumberGenerator::setSeed(boost::uint64_t seed) {
+	/* one splitmix64 step decorrelates similar seeds */
+	boost::uint64_t z = seed + 0x9E3779B97F4A7C15ULL;
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	z = z ^ (z >> 31);
+	state = (z != 0) ? z : 0x9E3779B97F4A7C15ULL; // xorshift must not start with 0
+}
+
+boost::uint64_t RandomNumberGenerator::nextUInt64() {
+	state ^= state >> 12;
+	state ^= state << 25;
+	state ^= state >> 27;
+	return state * 0x2545F4914F6CDD1DULL;
+}
+
+boost::uint32_t RandomNumberGenerator::nextUInt(boost::uint32_t bound) {
+	assert(bound > 0);
+
+	/* multiply and shift instead of a modulo; the rejection removes the bias of the remaining range */
+	boost::uint64_t product = (nextUInt64() >> 32) * bound;
+	boost::uint32_t low = static_cast<boost::uint32_t>(product);
+	if (low < bound) {
+		boost::uint32_t threshold = static_cast<boost::uint32_t>(-bound) % bound;
+		while (low < threshold) {
+			product = (nextUInt64() >> 32) * bound;
+			low = static_cast<boost::uint32_t>(product);
+		}
+	}
+	return static_cast<boost::uint32_t>(product >> 32);
+}
+
+double RandomNumberGenerator::nextDouble() {
+	return static_cast<double>(nextUInt64() >> 11) * (1.0 / 9007199254740992.0); // 53 bits / 2^53
+}
+
+}
+
+/* EOF */
@@ -0,0 +1,78 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+
+#ifndef BRICS_3D_RANDOMNUMBERGENERATOR_H_
+#define BRICS_3D_RANDOMNUMBERGENERATOR_H_
+
+#include <boost/cstdint.hpp>
+
+namespace brics_3d {
+
+/**
+ * @brief Small and fast pseudo random number generator with an explicit seed.
+ *
+ * Implements the xorshift64* generator; the seed is expanded with splitmix64, so every seed
+ * (including 0) results in a valid state. In contrast to std::rand() the state is held per
+ * object: sequences are reproducible for a given seed and independent of other users.
+ * An object is not thread safe, use one generator per thread instead.
+ */
+class RandomNumberGenerator {
+public:
+
+	/**
+	 * @brief Constructor.
+	 * @param seed Seed of the sequence.
+	 */
+	RandomNumberGenerator(boost::uint64_t seed = 0);
+
+	virtual ~RandomNumberGenerator();
+
+	/**
+	 * @brief Restart the sequence with a new seed.
+	 */
+	void setSeed(boost::uint64_t seed);
+
+	/**
+	 * @brief Next 64 random bits.
+	 */
+	boost::uint64_t nextUInt64();
+
+	/**
+	 * @brief Uniformly distributed integer in [0, bound).
+	 * @param bound Exclusive upper limit. Must be greater than 0.
+	 */
+	boost::uint32_t nextUInt(boost::uint32_t bound);
+
+	/**
+	 * @brief Uniformly distributed value in [0, 1).
+	 */
+	double nextDouble();
+
+private:
+
+	/// State of the generator. Never 0.
+	boost::uint64_t state;
+};
+
+}
+
+#endif /* BRICS_3D_RANDOMNUMBERGENERATOR_H_ */
+
+/* EOF */
@@ -0,0 +1,325 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+
+#include "SpatialReordering.h"
+#include "PointCloud3DAdaptor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace brics_3d {
+
+namespace {
+
+/// Spread the lowest 21 bits of value such that two zero bits follow every bit.
+inline boost::uint64_t spreadBits(boost::uint64_t value) {
+	value &= 0x1FFFFFULL;
+	value = (value | (value << 32)) & 0x1F00000000FFFFULL;
+	value = (value | (value << 16)) & 0x1F0000FF0000FFULL;
+	value = (value | (value << 8)) & 0x100F00F00F00F00FULL;
+	value = (value | (value << 4)) & 0x10C30C30C30C30C3ULL;
+	value = (value | (value << 2)) & 0x1249249249249249ULL;
+	return value;
+}
+
+/// Copy the rows of a packed attribute channel with rowSize elements per point in the order of the permutation.
+template <typename T>
+void permuteRows(const std::vector<unsigned int>& permutation, T* data, unsigned int rowSize) {
+	std::vector<T> original(data, data + permutation.size() * rowSize);
+	for (unsigned int i = 0; i < permutation.size(); ++i) {
+		memcpy(&data[i * rowSize], &original[permutation[i] * rowSize], sizeof(T) * rowSize);
+	}
+}
+
+}
+
+SpatialReordering::SpatialReordering(CurveType curve, unsigned int bitsPerAxis) {
+	this->curve = curve;
+	this->relocatePoints = true;
+	setBitsPerAxis(bitsPerAxis);
+}
+
+SpatialReordering::~SpatialReordering() {
+
+}
+
+SpatialReordering::CurveType SpatialReordering::getCurveType() const {
+	return curve;
+}
+
+void SpatialReordering::setCurveType(CurveType curve) {
+	this->curve = curve;
+}
+
+unsigned int SpatialReordering::getBitsPerAxis() const {
+	return bitsPerAxis;
+}
+
+void SpatialReordering::setBitsPerAxis(unsigned int bitsPerAxis) {
+	if (bitsPerAxis < 1 || bitsPerAxis > maxBitsPerAxis) {
+		throw std::runtime_error("SpatialReordering: bitsPerAxis has to be in [1, 21].");
+	}
+	this->bitsPerAxis = bitsPerAxis;
+}
+
+bool SpatialReordering::getRelocatePoints() const {
+	return relocatePoints;
+}
+
+void SpatialReordering::setRelocatePoints(bool relocatePoints) {
+	this->relocatePoints = relocatePoints;
+}
+
+void SpatialReordering::computePermutation(PointCloud3D* pointCloud, std::vector<unsigned int>* permutation) {
+	assert(pointCloud != 0);
+	computeOrder(PointCloud3DAdaptor(pointCloud), pointCloud->getSize(), permutation);
+}
+
+template <typename ScalarT>
+void SpatialReordering::computePermutation(const PointCloud3DContiguousT<ScalarT>& pointCloud, std::vector<unsigned int>* permutation) {
+	computeOrder(PointCloud3DContiguousAdaptor<ScalarT>(&pointCloud), pointCloud.getSize(), permutation);
+}
+
+void SpatialReordering::reorder(PointCloud3D* pointCloud, std::vector<unsigned int>* permutation) {
+	std::vector<unsigned int> order;
+	computePermutation(pointCloud, &order);
+	applyPermutation(order, pointCloud, relocatePoints);
+	if (permutation != 0) {
+		permutation->swap(order);
+	}
+}
+
+template <typename ScalarT>
+void SpatialReordering::reorder(PointCloud3DContiguousT<ScalarT>& pointCloud, std::vector<unsigned int>* permutation) {
+	std::vector<unsigned int> order;
+	computePermutation(pointCloud, &order);
+	applyPermutation(order, pointCloud);
+	if (permutation != 0) {
+		permutation->swap(order);
+	}
+}
+
+void SpatialReordering::applyPermutation(const std::vector<unsigned int>& permutation, PointCloud3D* pointCloud, bool relocatePoints) {
+	assert(pointCloud != 0);
+	boost::ptr_vector<Point3D>& points = *pointCloud->getPointCloud();
+	assert(permutation.size() == points.size());
+	unsigned int size = static_cast<unsigned int>(points.size());
+	if (size == 0) {
+		return;
+	}
+
+	if (relocatePoints) {
+		Point3DArena* arena = pointCloud->getArena().get();
+		boost::ptr_vector<Point3D> relocatedPoints;
+		relocatedPoints.reserve(size);
+		for (unsigned int i = 0; i < size; ++i) {
+			relocatedPoints.push_back(points[permutation[i]].cloneInto(arena));
+		}
+		points.swap(relocatedPoints);
+		if (arena != 0) {
+			relocatedPoints.base().clear(); // the previous points stay in the arena until it is reset
+		}
+		return; // otherwise the previous points are released together with relocatedPoints
+	}
+
+	/* only exchange the pointers; the ownership stays with the container */
+	Point3D** rawPoints = points.c_array();
+	std::vector<Point3D*> original(rawPoints, rawPoints + size);
+	for (unsigned int i = 0; i < size; ++i) {
+		rawPoints[i] = original[permutation[i]];
+	}
+}
+
+template <typename ScalarT>
+void SpatialReordering::applyPermutation(const std::vector<unsigned int>& permutation, PointCloud3DContiguousT<ScalarT>& pointCloud) {
+	unsigned int size = pointCloud.getSize();
+	assert(permutation.size() == size);
+
+	std::vector<ScalarT> x(size);
+	std::vector<ScalarT> y(size);
+	std::vector<ScalarT> z(size);
+	const ScalarT* xCoordinates = pointCloud.getXCoordinates();
+	const ScalarT* yCoordinates = pointCloud.getYCoordinates();
+	const ScalarT* zCoordinates = pointCloud.getZCoordinates();
+	for (unsigned int i = 0; i < size; ++i) {
+		unsigned int index = permutation[i];
+		x[i] = xCoordinates[index];
+		y[i] = yCoordinates[index];
+		z[i] = zCoordinates[index];
+	}
+	pointCloud.adoptCoordinates(x, y, z);
+
+	if (pointCloud.hasColors()) {
+		permuteRows(permutation, pointCloud.getColors(), 3);
+	}
+	if (pointCloud.hasNormals()) {
+		permuteRows(permutation, pointCloud.getNormals(), 3);
+	}
+	if (pointCloud.hasIntensities()) {
+		permuteRows(permutation, pointCloud.getIntensities(), 1);
+	}
+}
+
+void SpatialReordering::invertPermutation(const std::vector<unsigned int>& permutation, std::vector<unsigned int>* inverse) {
+	assert(inverse != 0);
+	inverse->resize(permutation.size());
+	for (unsigned int i = 0; i < permutation.size(); ++i) {
+		assert(permutation[i] < permutation.size());
+		(*inverse)[permutation[i]] = i;
+	}
+}
+
+boost::uint64_t SpatialReordering::mortonCode(boost::uint32_t x, boost::uint32_t y, boost::uint32_t z) {
+	return (spreadBits(x) << 2) | (spreadBits(y) << 1) | spreadBits(z);
+}
+
+boost::uint64_t SpatialReordering::hilbertCode(boost::uint32_t x, boost::uint32_t y, boost::uint32_t z, unsigned int bitsPerAxis) {
+	assert(bitsPerAxis >= 1 && bitsPerAxis <= maxBitsPerAxis);
+
+	/*
+	 * Transform the cell coordinates into the "transposed" Hilbert index (J. Skilling, "Programming the Hilbert curve",
+	 * AIP Conf. Proc. 707, 2004). Interleaving the bits of the transposed form yields the position along the curve.
+	 */
+	boost::uint32_t axes[3] = {x, y, z};
+	const boost::uint32_t highestBit = 1u << (bitsPerAxis - 1);
+
+	/* inverse undo excess work */
+	for (boost::uint32_t q = highestBit; q > 1; q >>= 1) {
+		boost::uint32_t p = q - 1;
+		for (int i = 0; i < 3; ++i) {
+			if (axes[i] & q) {
+				axes[0] ^= p; // invert
+			} else {
+				boost::uint32_t t = (axes[0] ^ axes[i]) & p; // exchange
+				axes[0] ^= t;
+				axes[i] ^= t;
+			}
+		}
+	}
+
+	/* gray encode */
+	axes[1] ^= axes[0];
+	axes[2] ^= axes[1];
+	boost::uint32_t t = 0;
+	for (boost::uint32_t q = highestBit; q > 1; q >>= 1) {
+		if (axes[2] & q) {
+			t ^= q - 1;
+		}
+	}
+	axes[0] ^= t;
+	axes[1] ^= t;
+	axes[2] ^= t;
+
+	return mortonCode(axes[0], axes[1], axes[2]);
+}
+
+template <typename AccessorT>
+void SpatialReordering::computeOrder(const AccessorT& points, unsigned int size, std::vector<unsigned int>* permutation) {
+	assert(permutation != 0);
+
+	/* bounding box of all valid points */
+	double minimum[3] = {std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), std::numeric_limits<double>::max()};
+	double maximum[3] = {-std::numeric_limits<double>::max(), -std::numeric_limits<double>::max(), -std::numeric_limits<double>::max()};
+	for (unsigned int i = 0; i < size; ++i) {
+		double x = points.x(i);
+		double y = points.y(i);
+		double z = points.z(i);
+		if (!(std::fabs(x) <= std::numeric_limits<double>::max() && std::fabs(y) <= std::numeric_limits<double>::max() && std::fabs(z) <= std::numeric_limits<double>::max())) {
+			continue;
+		}
+		minimum[0] = std::min(minimum[0], x);
+		minimum[1] = std::min(minimum[1], y);
+		minimum[2] = std::min(minimum[2], z);
+		maximum[0] = std::max(maximum[0], x);
+		maximum[1] = std::max(maximum[1], y);
+		maximum[2] = std::max(maximum[2], z);
+	}
+
+	/* cubic cells, the largest extent of the bounding box is divided into 2^bitsPerAxis cells */
+	const boost::uint32_t maxCell = (1u << bitsPerAxis) - 1;
+	double extent = std::max(maximum[0] - minimum[0], std::max(maximum[1] - minimum[1], maximum[2] - minimum[2]));
+	double scale = (extent > 0.0) ? (maxCell + 1) / extent : 0.0;
+	const boost::uint64_t invalidCode = static_cast<boost::uint64_t>(1) << (3 * bitsPerAxis); // behind all valid codes
+
+	std::vector<SortKey> keys(size);
+	for (unsigned int i = 0; i < size; ++i) {
+		double x = points.x(i);
+		double y = points.y(i);
+		double z = points.z(i);
+		keys[i].index = i;
+		if (!(std::fabs(x) <= std::numeric_limits<double>::max() && std::fabs(y) <= std::numeric_limits<double>::max() && std::fabs(z) <= std::numeric_limits<double>::max())) {
+			keys[i].code = invalidCode;
+			continue;
+		}
+		boost::uint32_t cellX = std::min(static_cast<boost::uint32_t>((x - minimum[0]) * scale), maxCell);
+		boost::uint32_t cellY = std::min(static_cast<boost::uint32_t>((y - minimum[1]) * scale), maxCell);
+		boost::uint32_t cellZ = std::min(static_cast<boost::uint32_t>((z - minimum[2]) * scale), maxCell);
+		keys[i].code = (curve == hilbertOrder) ? hilbertCode(cellX, cellY, cellZ, bitsPerAxis) : mortonCode(cellX, cellY, cellZ);
+	}
+
+	radixSort(keys, 3 * bitsPerAxis + 1);
+
+	permutation->resize(size);
+	for (unsigned int i = 0; i < size; ++i) {
+		(*permutation)[i] = keys[i].index;
+	}
+}
+
+void SpatialReordering::radixSort(std::vector<SortKey>& keys, unsigned int numberOfBits) {
+	if (keys.size() < 2) {
+		return;
+	}
+	std::vector<SortKey> buffer(keys.size());
+	unsigned int histogram[256];
+	for (unsigned int shift = 0; shift < numberOfBits; shift += 8) {
+		memset(histogram, 0, sizeof(histogram));
+		for (unsigned int i = 0; i < keys.size(); ++i) {
+			histogram[(keys[i].code >> shift) & 0xFF]++;
+		}
+		if (histogram[(keys[0].code >> shift) & 0xFF] == keys.size()) {
+			continue; // all keys share this digit
+		}
+
+		unsigned int offset = 0;
+		for (unsigned int digit = 0; digit < 256; ++digit) {
+			unsigned int count = histogram[digit];
+			histogram[digit] = offset;
+			offset += count;
+		}
+		for (unsigned int i = 0; i < keys.size(); ++i) {
+			buffer[histogram[(keys[i].code >> shift) & 0xFF]++] = keys[i];
+		}
+		keys.swap(buffer);
+	}
+}
+
+template void SpatialReordering::computePermutation<double>(const PointCloud3DContiguousT<double>& pointCloud, std::vector<unsigned int>* permutation);
+template void SpatialReordering::computePermutation<float>(const PointCloud3DContiguousT<float>& pointCloud, std::vector<unsigned int>* permutation);
+template void SpatialReordering::reorder<double>(PointCloud3DContiguousT<double>& pointCloud, std::vector<unsigned int>* permutation);
+template void SpatialReordering::reorder<float>(PointCloud3DContiguousT<float>& pointCloud, std::vector<unsigned int>* permutation);
+template void SpatialReordering::applyPermutation<double>(const std::vector<unsigned int>& permutation, PointCloud3DContiguousT<double>& pointCloud);
+template void SpatialReordering::applyPermutation<float>(const std::vector<unsigned int>& permutation, PointCloud3DContiguousT<float>& pointCloud);
+
+}
+
+/* EOF */
@@ -0,0 +1,204 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+
+#ifndef BRICS_3D_SPATIALREORDERING_H_
+#define BRICS_3D_SPATIALREORDERING_H_
+
+#include "PointCloud3D.h"
+#include "PointCloud3DContiguous.h"
+
+#include <boost/cstdint.hpp>
+#include <cassert>
+#include <vector>
+
+namespace brics_3d {
+
+/**
+ * @brief Reorders the points of a point cloud along a space filling curve.
+ *
+ * The order of a point cloud usually follows the scan pattern of the sensor or the order of insertion,
+ * so points that are close in space might be far apart in memory. Algorithms that visit the neighborhood
+ * of every point (nearest neighbor queries, normal estimation, clustering, ...) then jump all over memory.
+ * This class sorts the points by the Morton (Z-order) or Hilbert code of their quantized coordinates, so
+ * that spatially close points are mostly close in memory as well.
+ *
+ * The coordinates are quantized within the bounding box of the point cloud into 2^bitsPerAxis cells per
+ * axis (equal cell size for all axes). Points with equal codes keep their relative order. Points with
+ * non finite coordinates are moved to the end.
+ *
+ * Every reordering yields a permutation with permutation[newIndex] = oldIndex. It can be applied to further
+ * data that is indexed like the point cloud with permute(). invertPermutation() yields the mapping from old
+ * to new indices.
+ */
+class SpatialReordering {
+public:
+
+	/// Supported space filling curves.
+	enum CurveType {
+		mortonOrder,
+		hilbertOrder
+	};
+
+	/// Maximum resolution of the quantization. 3 * 21 bits fit into one 64 bit code.
+	static const unsigned int maxBitsPerAxis = 21;
+
+	/**
+	 * @brief Constructor.
+	 * @param curve The space filling curve.
+	 * @param bitsPerAxis Resolution of the quantization: the bounding box is divided into 2^bitsPerAxis cells per axis.
+	 */
+	SpatialReordering(CurveType curve = mortonOrder, unsigned int bitsPerAxis = 10);
+
+	virtual ~SpatialReordering();
+
+	CurveType getCurveType() const;
+	void setCurveType(CurveType curve);
+
+	unsigned int getBitsPerAxis() const;
+
+	/**
+	 * @brief Set the resolution of the quantization.
+	 * @param bitsPerAxis Value in [1, maxBitsPerAxis]. Other values throw a runtime_error.
+	 */
+	void setBitsPerAxis(unsigned int bitsPerAxis);
+
+	bool getRelocatePoints() const;
+
+	/**
+	 * @brief Define if reorder() allocates the points of a brics_3d::PointCloud3D again.
+	 *
+	 * A brics_3d::PointCloud3D only holds pointers to its points. Permuting the pointers alone does not change
+	 * where the points are located in memory. If relocation is enabled (default) the points are cloned in the
+	 * new order, so consecutive points are also consecutive in memory. Clones are allocated in the arena of the
+	 * point cloud if it has one; the previous points then remain in the arena until it is released.
+	 */
+	void setRelocatePoints(bool relocatePoints);
+
+	/**
+	 * @brief Compute the order of the points along the curve without changing the point cloud.
+	 * @param[in] pointCloud The point cloud.
+	 * @param[out] permutation permutation[newIndex] = oldIndex. The content is replaced.
+	 */
+	void computePermutation(PointCloud3D* pointCloud, std::vector<unsigned int>* permutation);
+
+	/**
+	 * @brief Compute the order of the points along the curve without changing the point cloud.
+	 * @param[in] pointCloud The point cloud.
+	 * @param[out] permutation permutation[newIndex] = oldIndex. The content is replaced.
+	 */
+	template <typename ScalarT>
+	void computePermutation(const PointCloud3DContiguousT<ScalarT>& pointCloud, std::vector<unsigned int>* permutation);
+
+	/**
+	 * @brief Reorder a point cloud along the curve. Decorations (colors, normals, ...) move with their points.
+	 * @param[in,out] pointCloud The point cloud.
+	 * @param[out] permutation Optional: receives the applied permutation (permutation[newIndex] = oldIndex).
+	 */
+	void reorder(PointCloud3D* pointCloud, std::vector<unsigned int>* permutation = 0);
+
+	/**
+	 * @brief Reorder a point cloud along the curve, including all enabled attribute channels.
+	 * @param[in,out] pointCloud The point cloud.
+	 * @param[out] permutation Optional: receives the applied permutation (permutation[newIndex] = oldIndex).
+	 */
+	template <typename ScalarT>
+	void reorder(PointCloud3DContiguousT<ScalarT>& pointCloud, std::vector<unsigned int>* permutation = 0);
+
+	/**
+	 * @brief Apply a permutation to a point cloud.
+	 * @param permutation permutation[newIndex] = oldIndex. Must have as many elements as the point cloud.
+	 * @param pointCloud The point cloud.
+	 * @param relocatePoints Clone the points in the new order, see setRelocatePoints().
+	 */
+	static void applyPermutation(const std::vector<unsigned int>& permutation, PointCloud3D* pointCloud, bool relocatePoints = true);
+
+	/**
+	 * @brief Apply a permutation to a point cloud and all its enabled attribute channels.
+	 * @param permutation permutation[newIndex] = oldIndex. Must have as many elements as the point cloud.
+	 * @param pointCloud The point cloud.
+	 */
+	template <typename ScalarT>
+	static void applyPermutation(const std::vector<unsigned int>& permutation, PointCloud3DContiguousT<ScalarT>& pointCloud);
+
+	/**
+	 * @brief Reorder arbitrary per point data like the point cloud: data[newIndex] = oldData[permutation[newIndex]]
+	 * @param permutation permutation[newIndex] = oldIndex.
+	 * @param data Data with one element per point.
+	 */
+	template <typename T>
+	static void permute(const std::vector<unsigned int>& permutation, std::vector<T>& data) {
+		assert(permutation.size() == data.size());
+		std::vector<T> permuted;
+		permuted.reserve(data.size());
+		for (unsigned int i = 0; i < permutation.size(); ++i) {
+			permuted.push_back(data[permutation[i]]);
+		}
+		data.swap(permuted);
+	}
+
+	/**
+	 * @brief Compute the mapping from old to new indices.
+	 * @param[in] permutation permutation[newIndex] = oldIndex.
+	 * @param[out] inverse inverse[oldIndex] = newIndex. The content is replaced.
+	 */
+	static void invertPermutation(const std::vector<unsigned int>& permutation, std::vector<unsigned int>* inverse);
+
+	/**
+	 * @brief Interleave the bits of three cell coordinates (x is the most significant axis).
+	 * @param x,y,z Cell coordinates with at most maxBitsPerAxis bits.
+	 */
+	static boost::uint64_t mortonCode(boost::uint32_t x, boost::uint32_t y, boost::uint32_t z);
+
+	/**
+	 * @brief Position of a cell along the Hilbert curve.
+	 *
+	 * Consecutive codes belong to cells that share a face.
+	 * @param x,y,z Cell coordinates with at most bitsPerAxis bits.
+	 * @param bitsPerAxis Resolution of the grid.
+	 */
+	static boost::uint64_t hilbertCode(boost::uint32_t x, boost::uint32_t y, boost::uint32_t z, unsigned int bitsPerAxis);
+
+private:
+
+	/// Sort key of one point.
+	struct SortKey {
+		boost::uint64_t code;
+		unsigned int index;
+	};
+
+	/// Quantize and encode all points, then sort them by code.
+	template <typename AccessorT>
+	void computeOrder(const AccessorT& points, unsigned int size, std::vector<unsigned int>* permutation);
+
+	/// Stable LSD radix sort of the keys by the lowest numberOfBits bits of their codes.
+	static void radixSort(std::vector<SortKey>& keys, unsigned int numberOfBits);
+
+	CurveType curve;
+
+	unsigned int bitsPerAxis;
+
+	bool relocatePoints;
+};
+
+}
+
+#endif /* BRICS_3D_SPATIALREORDERING_H_ */
+
+/* EOF */
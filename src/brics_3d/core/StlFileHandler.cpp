@@ -0,0 +1,192 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+#include "StlFileHandler.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace brics_3d {
+
+/// Size of the binary header.
+static const std::size_t stlHeaderSize = 80;
+
+/// Size of one binary facet record: normal, three vertices (12 floats) and the attribute byte count.
+static const std::size_t stlFacetSize = 12 * sizeof(float) + 2;
+
+static bool isLittleEndianHost() {
+	const unsigned short probe = 1;
+	return *reinterpret_cast<const unsigned char*>(&probe) == 1;
+}
+
+/* STL is always little endian */
+template <typename T>
+static inline T readLittleEndian(const char* data) {
+	T value;
+	memcpy(&value, data, sizeof(T));
+	if (!isLittleEndianHost()) {
+		unsigned char* bytes = reinterpret_cast<unsigned char*>(&value);
+		std::reverse(bytes, bytes + sizeof(T));
+	}
+	return value;
+}
+
+template <typename T>
+static inline void writeLittleEndian(char*& data, T value) {
+	if (!isLittleEndianHost()) {
+		unsigned char* bytes = reinterpret_cast<unsigned char*>(&value);
+		std::reverse(bytes, bytes + sizeof(T));
+	}
+	memcpy(data, &value, sizeof(T));
+	data += sizeof(T);
+}
+
+void StlFileHandler::write(ITriangleMesh* mesh, const std::string& filename) {
+	assert(mesh != 0);
+	std::ofstream outputFile(filename.c_str(), std::ios::out | std::ios::binary);
+	if (!outputFile.is_open()) {
+		throw std::runtime_error("StlFileHandler: cannot open file " + filename + " for writing.");
+	}
+
+	const unsigned int numberOfTriangles = static_cast<unsigned int>(mesh->getSize());
+	std::vector<char> buffer(stlHeaderSize + sizeof(unsigned int) + numberOfTriangles * stlFacetSize, 0);
+	const char headerText[] = "binary STL created by brics_3d::StlFileHandler";
+	memcpy(&buffer[0], headerText, sizeof(headerText) - 1); // must not start with "solid"
+
+	char* record = &buffer[stlHeaderSize];
+	writeLittleEndian(record, static_cast<unsigned int>(numberOfTriangles));
+	for (unsigned int i = 0; i < numberOfTriangles; ++i) {
+		Point3D* vertex1 = mesh->getTriangleVertex(i, 0);
+		Point3D* vertex2 = mesh->getTriangleVertex(i, 1);
+		Point3D* vertex3 = mesh->getTriangleVertex(i, 2);
+
+		/* facet normal: (v2 - v1) x (v3 - v1) */
+		Coordinate ux = vertex2->getX() - vertex1->getX();
+		Coordinate uy = vertex2->getY() - vertex1->getY();
+		Coordinate uz = vertex2->getZ() - vertex1->getZ();
+		Coordinate vx = vertex3->getX() - vertex1->getX();
+		Coordinate vy = vertex3->getY() - vertex1->getY();
+		Coordinate vz = vertex3->getZ() - vertex1->getZ();
+		Coordinate nx = uy * vz - uz * vy;
+		Coordinate ny = uz * vx - ux * vz;
+		Coordinate nz = ux * vy - uy * vx;
+		Coordinate length = std::sqrt(nx * nx + ny * ny + nz * nz);
+		if (length > 0.0) {
+			nx /= length;
+			ny /= length;
+			nz /= length;
+		}
+
+		writeLittleEndian(record, static_cast<float>(nx));
+		writeLittleEndian(record, static_cast<float>(ny));
+		writeLittleEndian(record, static_cast<float>(nz));
+		Point3D* vertices[3] = {vertex1, vertex2, vertex3};
+		for (int j = 0; j < 3; ++j) {
+			writeLittleEndian(record, static_cast<float>(vertices[j]->getX()));
+			writeLittleEndian(record, static_cast<float>(vertices[j]->getY()));
+			writeLittleEndian(record, static_cast<float>(vertices[j]->getZ()));
+		}
+		writeLittleEndian(record, static_cast<unsigned short>(0)); // attribute byte count
+	}
+
+	outputFile.write(&buffer[0], buffer.size());
+	if (!outputFile.good()) {
+		throw std::runtime_error("StlFileHandler: error while writing file " + filename);
+	}
+	outputFile.close();
+}
+
+void StlFileHandler::read(const std::string& filename, TriangleMeshImplicit* mesh, Coordinate weldingTolerance) {
+	assert(mesh != 0);
+	std::ifstream inputFile(filename.c_str(), std::ios::in | std::ios::binary);
+	if (!inputFile.is_open()) {
+		throw std::runtime_error("StlFileHandler: cannot open file " + filename);
+	}
+	inputFile.seekg(0, std::ios::end);
+	std::size_t size = static_cast<std::size_t>(inputFile.tellg());
+	inputFile.seekg(0, std::ios::beg);
+	std::vector<char> buffer(size);
+	if (size > 0) {
+		inputFile.read(&buffer[0], size);
+	}
+	inputFile.close();
+
+	mesh->getVertices()->clear();
+	mesh->getIndices()->clear();
+	mesh->enableVertexWelding(weldingTolerance);
+
+	/* binary files are identified by their size, as some of them start with "solid" as well */
+	std::size_t numberOfTriangles = 0;
+	if (size >= stlHeaderSize + sizeof(unsigned int)) {
+		numberOfTriangles = readLittleEndian<unsigned int>(&buffer[stlHeaderSize]);
+	}
+	if (size >= stlHeaderSize + sizeof(unsigned int) && (size - stlHeaderSize - sizeof(unsigned int)) == numberOfTriangles * stlFacetSize) {
+		mesh->getIndices()->reserve(3 * numberOfTriangles);
+		mesh->getVertices()->reserve(numberOfTriangles); // a closed mesh has about half as many vertices as triangles
+
+		const char* record = &buffer[stlHeaderSize + sizeof(unsigned int)];
+		for (std::size_t i = 0; i < numberOfTriangles; ++i) {
+			Point3D vertices[3];
+			for (int j = 0; j < 3; ++j) {
+				const char* vertex = record + (3 + 3 * j) * sizeof(float); // skip the normal
+				vertices[j] = Point3D(readLittleEndian<float>(vertex), readLittleEndian<float>(vertex + sizeof(float)), readLittleEndian<float>(vertex + 2 * sizeof(float)));
+			}
+			mesh->addTriangle(vertices[0], vertices[1], vertices[2]);
+			record += stlFacetSize;
+		}
+		return;
+	}
+
+	/* ascii: every facet consists of three "vertex x y z" lines */
+	if (size < 5 || std::string(&buffer[0], 5) != "solid") {
+		throw std::runtime_error("StlFileHandler: not a STL file: " + filename);
+	}
+	std::istringstream inStream(std::string(buffer.begin(), buffer.end()));
+	std::string keyword;
+	Point3D vertices[3];
+	int vertexIndex = 0;
+	while (inStream >> keyword) {
+		if (keyword != "vertex") {
+			continue;
+		}
+		Coordinate x, y, z;
+		inStream >> x >> y >> z;
+		if (inStream.fail()) {
+			throw std::runtime_error("StlFileHandler: invalid vertex in file " + filename);
+		}
+		vertices[vertexIndex++] = Point3D(x, y, z);
+		if (vertexIndex == 3) {
+			mesh->addTriangle(vertices[0], vertices[1], vertices[2]);
+			vertexIndex = 0;
+		}
+	}
+	if (vertexIndex != 0) {
+		throw std::runtime_error("StlFileHandler: incomplete facet in file " + filename);
+	}
+}
+
+}
+
+/* EOF */
@@ -0,0 +1,64 @@
+/******************************************************************************
+* BRICS_3D - 3D Perception and Modeling Library
+* Copyright (c) 2026, KU Leuven
+*
+* Author: Sebastian Blumenthal
+*
+*
+* This software is published under a dual-license: GNU Lesser General Public
+* License LGPL 2.1 and Modified BSD license. The dual-license implies that
+* users of this code may choose which terms they prefer.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU Lesser General Public License LGPL and the BSD license for
+* more details.
+*
+******************************************************************************/
+
+#ifndef BRICS_3D_STLFILEHANDLER_H_
+#define BRICS_3D_STLFILEHANDLER_H_
+
+#include <string>
+
+#include "ITriangleMesh.h"
+#include "TriangleMeshImplicit.h"
+
+namespace brics_3d {
+
+/**
+ * @brief Reads and writes triangle meshes in the STL (stereolithography) file format.
+ *
+ * Meshes are written in the binary encoding with single precision. Both the binary and the
+ * ascii encoding can be read. As STL stores a plain triangle soup, the vertices are welded
+ * while reading, so the resulting brics_3d::TriangleMeshImplicit shares common vertices.
+ *
+ * Errors are reported as std::runtime_error.
+ */
+class StlFileHandler {
+public:
+
+	/**
+	 * @brief Write a mesh as binary STL file. Facet normals are computed from the vertex order.
+	 * @param mesh The mesh to be written.
+	 * @param filename Name of the file e.g. mesh.stl
+	 */
+	static void write(ITriangleMesh* mesh, const std::string& filename);
+
+	/**
+	 * @brief Read a binary or ascii STL file into an indexed mesh.
+	 *
+	 * The previous content of the mesh is replaced. Vertex welding of the mesh is enabled with the given tolerance.
+	 * @param filename Name of the file e.g. mesh.stl
+	 * @param mesh The mesh that will hold the data.
+	 * @param weldingTolerance Maximal distance of vertices that will be merged. 0 merges identical vertices only.
+	 */
+	static void read(const std::string& filename, TriangleMeshImplicit* mesh, Coordinate weldingTolerance = 0.0);
+};
+
+}
+
+#endif /* BRICS_3D_STLFILEHANDLER_H_ */
+
+/* EOF */
@@ -20,6 +20,9 @@
 #include "TriangleMeshImplicit.h"
 #include "assert.h"
 
+#include <cmath>
+#include <boost/functional/hash.hpp>
+
 namespace brics_3d {
 
 TriangleMeshImplicit::TriangleMeshImplicit() {
@@ -28,6 +31,10 @@ TriangleMeshImplicit::TriangleMeshImplicit() {
 
 	indices =  new std::vector<int> ();
 	indices->clear();
+
+	weldingEnabled = false;
+	weldingTolerance = 0.0;
+	numberOfWeldedVertices = 0;
 }
 
 TriangleMeshImplicit::~TriangleMeshImplicit() {
@@ -53,6 +60,8 @@ void TriangleMeshImplicit::setVertices(std::vector<Point3D>* vertices) {
 		delete this->vertices;
 	}
 	this->vertices = vertices;
+	weldingGrid.clear(); // will be rebuilt on demand
+	numberOfWeldedVertices = 0;
 }
 
 
@@ -84,22 +93,19 @@ Point3D* TriangleMeshImplicit::getTriangleVertex(int triangleIndex, int vertexIn
 	assert ((0 <= triangleIndex) && (triangleIndex < this->getSize()));
 	assert ((0 <= vertexIndex) && (vertexIndex <= 2));
 
-	return &((*vertices)[triangleIndex + vertexIndex]);
+	return &((*vertices)[(*indices)[3 * triangleIndex + vertexIndex]]);
 }
 
 int TriangleMeshImplicit::addTriangle(Point3D vertex1, Point3D vertex2, Point3D vertex3) {
 	assert((static_cast<int>(indices->size()) % 3) == 0); //postcondition
 
-	/* append at end */
-	vertices->push_back(vertex1); //TODO: check for duplication?
-	indices->push_back(static_cast<int>(vertices->size())); // important: must follow a vertices->push_back()
-	vertices->push_back(vertex2);
-	indices->push_back(static_cast<int>(vertices->size())); // important: must follow a vertices->push_back()
-	vertices->push_back(vertex3);
-	indices->push_back(static_cast<int>(vertices->size())); // important: must follow a vertices->push_back()
+	/* append at end; welded vertices are shared */
+	indices->push_back(addVertex(vertex1));
+	indices->push_back(addVertex(vertex2));
+	indices->push_back(addVertex(vertex3));
 
 	assert((static_cast<int>(indices->size()) % 3) == 0); //precondition
-	return this->getSize();
+	return (this->getSize() - 1); // inserted as last entry
 }
 
 void TriangleMeshImplicit::removeTriangle (int triangleIndex) {
@@ -111,6 +117,106 @@ void TriangleMeshImplicit::homogeneousTransformation(IHomogeneousMatrix44 *trans
 	for (int i = 0; i < static_cast<int>(vertices->size()); ++i) { // propagate transformation to triangles
 		(*vertices)[i].homogeneousTransformation(transformation);
 	}
+	weldingGrid.clear(); // will be rebuilt on demand
+	numberOfWeldedVertices = 0;
+}
+
+void TriangleMeshImplicit::enableVertexWelding(Coordinate tolerance) {
+	assert(tolerance >= 0.0);
+	weldingEnabled = true;
+	weldingTolerance = tolerance;
+	weldingGrid.clear(); // will be rebuilt on demand
+	numberOfWeldedVertices = 0;
+}
+
+void TriangleMeshImplicit::disableVertexWelding() {
+	weldingEnabled = false;
+	weldingGrid.clear();
+	numberOfWeldedVertices = 0;
+}
+
+bool TriangleMeshImplicit::isVertexWeldingEnabled() {
+	return weldingEnabled;
+}
+
+void TriangleMeshImplicit::copyFrom(TriangleMeshExplicit* mesh, Coordinate weldingTolerance) {
+	assert(mesh != 0);
+	int numberOfTriangles = mesh->getSize();
+
+	vertices->clear();
+	indices->clear();
+	enableVertexWelding(weldingTolerance);
+
+	vertices->reserve(numberOfTriangles); // a closed mesh has about half as many vertices as triangles
+	indices->reserve(3 * numberOfTriangles);
+	weldingGrid.rehash(numberOfTriangles);
+
+	for (int i = 0; i < numberOfTriangles; ++i) {
+		for (int j = 0; j < 3; ++j) {
+			indices->push_back(addVertex(*mesh->getTriangleVertex(i, j)));
+		}
+	}
+}
+
+int TriangleMeshImplicit::addVertex(const Point3D& vertex) {
+	if (weldingEnabled) {
+		updateWeldingGrid();
+
+		/* with a tolerance a matching vertex can reside in a neighboring cell */
+		int range = (weldingTolerance > 0.0) ? 1 : 0;
+		Coordinate squaredTolerance = weldingTolerance * weldingTolerance;
+		for (int dx = -range; dx <= range; ++dx) {
+			for (int dy = -range; dy <= range; ++dy) {
+				for (int dz = -range; dz <= range; ++dz) {
+					std::pair<boost::unordered_multimap<std::size_t, int>::const_iterator, boost::unordered_multimap<std::size_t, int>::const_iterator> candidates;
+					candidates = weldingGrid.equal_range(getWeldingCellKey(vertex, dx, dy, dz));
+					for (boost::unordered_multimap<std::size_t, int>::const_iterator it = candidates.first; it != candidates.second; ++it) {
+						const Point3D& candidate = (*vertices)[it->second];
+						Coordinate deltaX = candidate.getX() - vertex.getX();
+						Coordinate deltaY = candidate.getY() - vertex.getY();
+						Coordinate deltaZ = candidate.getZ() - vertex.getZ();
+						if (deltaX * deltaX + deltaY * deltaY + deltaZ * deltaZ <= squaredTolerance) {
+							return it->second;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	vertices->push_back(vertex);
+	int index = static_cast<int>(vertices->size()) - 1;
+	if (weldingEnabled) {
+		weldingGrid.insert(std::make_pair(getWeldingCellKey(vertex, 0, 0, 0), index));
+		numberOfWeldedVertices = static_cast<unsigned int>(vertices->size());
+	}
+	return index;
+}
+
+void TriangleMeshImplicit::updateWeldingGrid() {
+	if (numberOfWeldedVertices > vertices->size()) { // vertices have been removed meanwhile
+		weldingGrid.clear();
+		numberOfWeldedVertices = 0;
+	}
+	for (unsigned int i = numberOfWeldedVertices; i < vertices->size(); ++i) {
+		weldingGrid.insert(std::make_pair(getWeldingCellKey((*vertices)[i], 0, 0, 0), static_cast<int>(i)));
+	}
+	numberOfWeldedVertices = static_cast<unsigned int>(vertices->size());
+}
+
+std::size_t TriangleMeshImplicit::getWeldingCellKey(const Point3D& vertex, int dx, int dy, int dz) {
+	std::size_t key = 0;
+	if (weldingTolerance > 0.0) { // cells with the size of the tolerance
+		boost::hash_combine(key, static_cast<long long>(std::floor(vertex.getX() / weldingTolerance)) + dx);
+		boost::hash_combine(key, static_cast<long long>(std::floor(vertex.getY() / weldingTolerance)) + dy);
+		boost::hash_combine(key, static_cast<long long>(std::floor(vertex.getZ() / weldingTolerance)) + dz);
+	} else { // exact matches only: hash the coordinates themselves
+		assert(dx == 0 && dy == 0 && dz == 0);
+		boost::hash_combine(key, vertex.getX() + 0.0); // + 0.0 maps -0.0 to 0.0
+		boost::hash_combine(key, vertex.getY() + 0.0);
+		boost::hash_combine(key, vertex.getZ() + 0.0);
+	}
+	return key;
 }
 
 void TriangleMeshImplicit::read(std::istream& inStream) {
@@ -118,10 +224,10 @@ void TriangleMeshImplicit::read(std::istream& inStream) {
 }
 
 void TriangleMeshImplicit::write(std::ostream& outStream) {
-	for (int i = 0; i < this->getSize(); ++i) {
+	for (int i = 0; i < static_cast<int>(vertices->size()); ++i) {
 		outStream << (*vertices)[i] << std::endl;
 	}
-	for (int i = 0; i < static_cast<int>(indices->size()); ++i) {
+	for (int i = 0; i < this->getSize(); ++i) {
 		outStream << (*indices)[3*i] << ", ";
 		outStream << (*indices)[3*i + 1] << ", ";
 		outStream << (*indices)[3*i + 2] << std::endl;
@@ -21,12 +21,19 @@
 #define BRICS_3D_TRIANGLEMESHIMPLICIT_H_
 
 #include "brics_3d/core/ITriangleMesh.h"
+#include "brics_3d/core/TriangleMeshExplicit.h"
 #include <vector>
+#include <boost/unordered_map.hpp>
 
 namespace brics_3d {
 
 /**
  * @brief @e Implicit triangle mesh representation.
+ *
+ * Vertices are stored once and triangles refer to them by index triples. By default addTriangle()
+ * appends three new vertices. With enableVertexWelding() a vertex that is (nearly) equal to an
+ * already stored vertex is reused instead; the lookup is done with a spatial hash, so shared vertices
+ * are stored only once.
  */
 class TriangleMeshImplicit : public ITriangleMesh {
 public:
@@ -86,8 +93,47 @@ public:
 
 	void homogeneousTransformation(IHomogeneousMatrix44 *transformation);
 
+	/**
+	 * @brief Reuse existing vertices in addTriangle() instead of appending duplicates.
+	 *
+	 * Vertices that are already part of the mesh are taken into account. Modifications of the vertices
+	 * via getVertices() are not tracked; call enableVertexWelding() again in that case.
+	 * @param tolerance Maximal (Euclidean) distance of two vertices that will be merged. 0 merges identical vertices only.
+	 */
+	void enableVertexWelding(Coordinate tolerance = 0.0);
+
+	/**
+	 * @brief Switch back to appending three new vertices per addTriangle().
+	 */
+	void disableVertexWelding();
+
+	/**
+	 * @brief Check if addTriangle() welds vertices.
+	 */
+	bool isVertexWeldingEnabled();
+
+	/**
+	 * @brief Convert a triangle soup into this indexed mesh.
+	 *
+	 * The previous content of this mesh is replaced. Vertex welding is enabled with the given tolerance.
+	 * @param mesh The explicit mesh with the triangles.
+	 * @param weldingTolerance Maximal distance of vertices that will be merged.
+	 */
+	void copyFrom(TriangleMeshExplicit* mesh, Coordinate weldingTolerance = 0.0);
+
 protected:
 
+	/**
+	 * @brief Get the index of a vertex. The vertex is appended if there is no matching vertex yet.
+	 */
+	int addVertex(const Point3D& vertex);
+
+	/// Add all vertices that are not yet part of the welding grid.
+	void updateWeldingGrid();
+
+	/// Spatial hash key of a cell of the welding grid.
+	std::size_t getWeldingCellKey(const Point3D& vertex, int dx, int dy, int dz);
+
 	/// Pointer to vector with vertices
 	std::vector<Point3D>* vertices;
 
@@ -97,6 +143,18 @@ protected:
 	 */
 	std::vector<int>* indices;
 
+	/// Switch for vertex welding.
+	bool weldingEnabled;
+
+	/// Maximal distance of merged vertices.
+	Coordinate weldingTolerance;
+
+	/// Spatial hash: cell key -> indices of the vertices in that cell.
+	boost::unordered_multimap<std::size_t, int> weldingGrid;
+
+	/// Number of vertices (from the beginning of vertices) that are already in the weldingGrid.
+	unsigned int numberOfWeldedVertices;
+
 private:
 
 	void read(std::istream& inStream);
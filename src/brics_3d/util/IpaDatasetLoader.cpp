@@ -128,13 +128,16 @@ PointCloud3D* IpaDatasetLoader::getPointCloud() {
 	unsigned char blue;
 
 
+	/* worst case: every pixel becomes a point */
+	pointCloud->reserve(xyzImage->height * xyzImage->width);
+
 	/* loop over all pixels and add those who are above a certain threshold */
 	for (int row = 0; row < xyzImage->height; ++row) {
 		for (int col = 0; col < xyzImage->width; ++col) {
 			this->getData(row, col, x, y, z, red, green, blue);
 
 			if (!((red == 0) && (green == 0) && (blue == 0))) { //discard "black" points as they don't belong to the object itself
-				pointCloud->addPoint(Point3D(x, y, z));
+				pointCloud->addPoint(x, y, z);
 			}
 		}
 	}
@@ -157,6 +160,9 @@ PointCloud3D* IpaDatasetLoader::getColoredPointCloud() {
 	unsigned char blue;
 
 
+	/* worst case: every pixel becomes a point */
+	pointCloud->reserve(xyzImage->height * xyzImage->width);
+
 	/* loop over all pixels and add those who are above a certain threshold */
 	for (int row = 0; row < xyzImage->height; ++row) {
 		for (int col = 0; col < xyzImage->width; ++col) {
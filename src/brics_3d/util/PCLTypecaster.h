@@ -61,18 +61,14 @@ public:
 	 */
 	inline void convertToBRICS3DDataType(pcl::PointCloud<pcl::PointXYZ>::ConstPtr pclCloudPtr,
 			brics_3d::PointCloud3D* pointCloud3DPtr ){
-		pointCloud3DPtr->getPointCloud()->resize(pclCloudPtr->size());
+		pointCloud3DPtr->reserve(pointCloud3DPtr->getSize() + pclCloudPtr->size());
 
 		for (unsigned int i =0 ; i < pclCloudPtr->size()  ; i++){
 			if(!std::isnan(pclCloudPtr->points[i].x) && !std::isinf(pclCloudPtr->points[i].x) &&
 					!std::isnan(pclCloudPtr->points[i].y) && !std::isinf(pclCloudPtr->points[i].y) &&
 					!std::isnan(pclCloudPtr->points[i].z) && !std::isinf(pclCloudPtr->points[i].z) ) {
 
-			(*pointCloud3DPtr->getPointCloud())[i].setX(pclCloudPtr->points[i].x);
-			(*pointCloud3DPtr->getPointCloud())[i].setY(pclCloudPtr->points[i].y);
-			(*pointCloud3DPtr->getPointCloud())[i].setZ(pclCloudPtr->points[i].z);
-			//		pointCloud3DPtr->addPoint(new Point3D(pclCloudPtr->points[i].x,
-			//							pclCloudPtr->points[i].y, pclCloudPtr->points[i].z));
+				pointCloud3DPtr->addPoint(pclCloudPtr->points[i].x, pclCloudPtr->points[i].y, pclCloudPtr->points[i].z);
 
 			}
 		}
@@ -93,7 +89,7 @@ public:
 		uint32_t rgbVal;
 		unsigned char red, green, blue;
 		float rgbVal24Bit;
-//		pointCloud3DPtr->getPointCloud()->resize(pclCloudPtr->size());
+		pointCloud3DPtr->reserve(pointCloud3DPtr->getSize() + pclCloudPtr->size());
 
 		for (unsigned int i =0 ; i < pclCloudPtr->size()  ; i++){
 			if(!std::isnan(pclCloudPtr->points[i].x) && !std::isinf(pclCloudPtr->points[i].x) &&
@@ -138,7 +134,7 @@ public:
 		uint32_t rgbVal;
 		unsigned char red, green, blue;
 		float rgbVal24Bit;
-//		pointCloud3DPtr->getPointCloud()->resize(pclCloudPtr->size());
+		pointCloud3DPtr->reserve(pointCloud3DPtr->getSize() + pclCloudPtr.size());
 
 		for (unsigned int i =0 ; i < pclCloudPtr.size()  ; i++){
 			if(!std::isnan(pclCloudPtr.points[i].x) && !std::isinf(pclCloudPtr.points[i].x) &&
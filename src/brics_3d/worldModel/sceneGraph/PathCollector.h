@@ -52,7 +52,7 @@ public:
 
 	virtual void reset();
 
-	Node::NodePathList getNodePaths() const
+	const Node::NodePathList& getNodePaths() const
     {
         return nodePaths;
     }
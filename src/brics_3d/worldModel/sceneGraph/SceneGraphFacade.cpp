@@ -21,6 +21,7 @@
 #include "SimpleIdGenerator.h"
 #include "UuidGenerator.h"
 #include "brics_3d/core/Logger.h"
+#include "brics_3d/core/HomogeneousMatrix44.h"
 #include "AttributeFinder.h"
 #include "RootFinder.h"
 
@@ -268,7 +269,12 @@ bool SceneGraphFacade::getTransformForNode (Id id, Id idReferenceNode, TimeStamp
 	Node::NodePtr referenceNode= tmpReferenceNode.lock();
 	if ((node != 0) && (referenceNode != 0)) {
 //		transform = getGlobalTransform(node);
-		transform = getTransformBetweenNodes(node, referenceNode, timeStamp, actualTimeStamp);
+		AffineTransform44 transformBetweenNodes;
+		if (!getTransformBetweenNodes(node, referenceNode, timeStamp, actualTimeStamp, transformBetweenNodes)) {
+			return false;
+		}
+		transform = IHomogeneousMatrix44::IHomogeneousMatrix44Ptr(new HomogeneousMatrix44());
+		transformBetweenNodes.copyTo(transform.get());
 		return true;
 	}
 	return false;
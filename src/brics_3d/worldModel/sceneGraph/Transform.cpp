@@ -29,34 +29,59 @@ namespace brics_3d {
 namespace rsg {
 
 IHomogeneousMatrix44::IHomogeneousMatrix44Ptr getGlobalTransformAlongPath(Node::NodePath nodePath, TimeStamp timeStamp, TimeStamp& latestStampAlongPath){
-	IHomogeneousMatrix44::IHomogeneousMatrix44Ptr result(new HomogeneousMatrix44()); //identity matrix
+	AffineTransform44 accumulatedTransform;
+	getGlobalTransformAlongPath(nodePath, timeStamp, latestStampAlongPath, accumulatedTransform);
+
+	IHomogeneousMatrix44::IHomogeneousMatrix44Ptr result(new HomogeneousMatrix44());
+	accumulatedTransform.copyTo(result.get());
+	return result;
+}
+
+IHomogeneousMatrix44::IHomogeneousMatrix44Ptr getGlobalTransform(Node::NodePtr node, TimeStamp timeStamp, TimeStamp& actualTimeStamp) {
+	AffineTransform44 accumulatedTransform;
+	getGlobalTransform(node, timeStamp, actualTimeStamp, accumulatedTransform);
+
+	IHomogeneousMatrix44::IHomogeneousMatrix44Ptr result(new HomogeneousMatrix44());
+	accumulatedTransform.copyTo(result.get());
+	return result;
+}
+
+IHomogeneousMatrix44::IHomogeneousMatrix44Ptr getTransformBetweenNodes(Node::NodePtr node, Node::NodePtr referenceNode, TimeStamp timeStamp, TimeStamp& actualTimeStamp) {
+	AffineTransform44 transformBetweenNodes;
+	getTransformBetweenNodes(node, referenceNode, timeStamp, actualTimeStamp, transformBetweenNodes);
+
+	IHomogeneousMatrix44::IHomogeneousMatrix44Ptr result(new HomogeneousMatrix44());
+	transformBetweenNodes.copyTo(result.get());
+	return result;
+}
+
+void getGlobalTransformAlongPath(const Node::NodePath& nodePath, TimeStamp timeStamp, TimeStamp& latestStampAlongPath, AffineTransform44& result) {
+	result.setIdentity();
 	latestStampAlongPath = TimeStamp(0);
 	TimeStamp currentTimeStamp = TimeStamp(0);
 
 	for (unsigned int i = 0; i < static_cast<unsigned int>(nodePath.size()); ++i) {
 		Transform* tmpTransform = dynamic_cast<Transform*>(nodePath[i]);
 		if (tmpTransform) {
-			*result = *( (*result) * (*tmpTransform->getTransform(timeStamp, currentTimeStamp)) );
+			result *= *tmpTransform->getTransform(timeStamp, currentTimeStamp);
 			if(currentTimeStamp >= latestStampAlongPath) { // store latest stamp
 				latestStampAlongPath = currentTimeStamp;
 			}
 		}
 	}
-	return result;
 }
 
-IHomogeneousMatrix44::IHomogeneousMatrix44Ptr getGlobalTransform(Node::NodePtr node, TimeStamp timeStamp, TimeStamp& actualTimeStamp) {
-	IHomogeneousMatrix44::IHomogeneousMatrix44Ptr result(new HomogeneousMatrix44()); //identity matrix
-	IHomogeneousMatrix44::IHomogeneousMatrix44Ptr accumulatedTransform;
+void getGlobalTransform(Node::NodePtr node, TimeStamp timeStamp, TimeStamp& actualTimeStamp, AffineTransform44& result) {
+	result.setIdentity();
 	actualTimeStamp = TimeStamp(0); // The latest stamp will be memorized
 
 	/* accumulate parent paths and take the _first_ found path  */
-	PathCollector* pathCollector = new PathCollector();
-	node->accept(pathCollector);
-	if (static_cast<unsigned int>(pathCollector->getNodePaths().size()) > 0) { // != root
-		//*result = *((*result) * (*(getGlobalTransformAlongPath(pathCollector->getNodePaths()[0], timeStamp))));
-		*result = *((*result) * (*(getGlobalTransformAlongPath(pathCollector->getNodePaths().back(), timeStamp, actualTimeStamp))));
-		if (static_cast<unsigned int>(pathCollector->getNodePaths().size()) > 1) {
+	PathCollector pathCollector;
+	node->accept(&pathCollector);
+	const Node::NodePathList& nodePaths = pathCollector.getNodePaths();
+	if (static_cast<unsigned int>(nodePaths.size()) > 0) { // != root
+		getGlobalTransformAlongPath(nodePaths.back(), timeStamp, actualTimeStamp, result);
+		if (static_cast<unsigned int>(nodePaths.size()) > 1) {
 			LOG(WARNING) << "Multiple transform paths to this node detected. Taking last path and ignoring the rest.";
 		}
 	}
@@ -64,26 +89,20 @@ IHomogeneousMatrix44::IHomogeneousMatrix44Ptr getGlobalTransform(Node::NodePtr n
 	/* check if node is a transform on its own ... */
 	Transform::TransformPtr tmpTransform = boost::dynamic_pointer_cast<Transform>(node);
 	if (tmpTransform) {
-		 TimeStamp currentTimeStamp;
-		*result = *( (*result) * (*tmpTransform->getTransform(timeStamp, currentTimeStamp)) );
+		TimeStamp currentTimeStamp;
+		result *= *tmpTransform->getTransform(timeStamp, currentTimeStamp);
 		if(currentTimeStamp >= actualTimeStamp) {
 			actualTimeStamp = currentTimeStamp;
 		}
 	}
-
-	delete pathCollector;
-	return result;
 }
 
-IHomogeneousMatrix44::IHomogeneousMatrix44Ptr getTransformBetweenNodes(Node::NodePtr node, Node::NodePtr referenceNode, TimeStamp timeStamp, TimeStamp& actualTimeStamp) {
-	IHomogeneousMatrix44::IHomogeneousMatrix44Ptr result(new HomogeneousMatrix44()); //identity matrix
+bool getTransformBetweenNodes(Node::NodePtr node, Node::NodePtr referenceNode, TimeStamp timeStamp, TimeStamp& actualTimeStamp, AffineTransform44& result) {
 	TimeStamp latestStampAlongPath1;
 	TimeStamp latestStampAlongPath2;
-	IHomogeneousMatrix44::IHomogeneousMatrix44Ptr rootToNodeTransform = getGlobalTransform(node, timeStamp, latestStampAlongPath1);
-	IHomogeneousMatrix44::IHomogeneousMatrix44Ptr rootToReferenceNodeTransform = getGlobalTransform(referenceNode, timeStamp, latestStampAlongPath2);
-
-	rootToReferenceNodeTransform->inverse();
-	*result = *( (*rootToReferenceNodeTransform) * (*rootToNodeTransform) ); //cf. Craig p39
+	AffineTransform44 rootToNodeTransform;
+	getGlobalTransform(node, timeStamp, latestStampAlongPath1, rootToNodeTransform);
+	getGlobalTransform(referenceNode, timeStamp, latestStampAlongPath2, result);
 
 	if(latestStampAlongPath1 >= latestStampAlongPath2) {
 		actualTimeStamp = latestStampAlongPath1;
@@ -91,8 +110,12 @@ IHomogeneousMatrix44::IHomogeneousMatrix44Ptr getTransformBetweenNodes(Node::Nod
 		actualTimeStamp = latestStampAlongPath2;
 	}
 
-
-	return result;
+	if (!result.invert()) {
+		LOG(ERROR) << "The global transform of reference node " << referenceNode->getId() << " is singular. Cannot compute the transform between the nodes.";
+		return false;
+	}
+	result *= rootToNodeTransform; //cf. Craig p39
+	return true;
 }
 
 
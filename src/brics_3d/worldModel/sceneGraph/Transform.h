@@ -21,6 +21,7 @@
 #define RSG_TRANSFORM_H
 
 #include "brics_3d/core/IHomogeneousMatrix44.h"
+#include "brics_3d/core/AffineTransform44.h"
 #include "Group.h"
 #include "TemporalCache.h"
 
@@ -60,6 +61,28 @@ extern IHomogeneousMatrix44::IHomogeneousMatrix44Ptr getGlobalTransform(Node::No
 
 extern IHomogeneousMatrix44::IHomogeneousMatrix44Ptr getTransformBetweenNodes(Node::NodePtr node, Node::NodePtr referenceNode, TimeStamp timeStamp, TimeStamp& actualTimeStamp);
 
+/**
+ * @brief Allocation free version of getGlobalTransformAlongPath().
+ * @param[out] result The accumulated transform.
+ * @ingroup sceneGraph
+ */
+extern void getGlobalTransformAlongPath(const Node::NodePath& nodePath, TimeStamp timeStamp, TimeStamp& latestStampAlongPath, AffineTransform44& result);
+
+/**
+ * @brief Allocation free version of getGlobalTransform() for the composition of the transforms.
+ * @param[out] result The accumulated transform.
+ * @ingroup sceneGraph
+ */
+extern void getGlobalTransform(Node::NodePtr node, TimeStamp timeStamp, TimeStamp& actualTimeStamp, AffineTransform44& result);
+
+/**
+ * @brief Allocation free version of getTransformBetweenNodes() for the composition of the transforms.
+ * @param[out] result The transform of node with respect to referenceNode.
+ * @return False if the global transform of referenceNode cannot be inverted. result is not valid in that case.
+ * @ingroup sceneGraph
+ */
+extern bool getTransformBetweenNodes(Node::NodePtr node, Node::NodePtr referenceNode, TimeStamp timeStamp, TimeStamp& actualTimeStamp, AffineTransform44& result);
+
 
 /**
  * @brief A node that expresses a geometric transformation between its parents and children.
@@ -0,0 +1,173 @@
+/**
+ * @file
+ * AffineTransform44Test.cpp
+ *
+ * @date: Oct 17, 2026
+ * @author: sblume
+ */
+
+#include "AffineTransform44Test.h"
+
+#include <cstring>
+
+namespace unitTests {
+
+CPPUNIT_TEST_SUITE_REGISTRATION( AffineTransform44Test );
+
+void AffineTransform44Test::setUp() {
+
+}
+
+void AffineTransform44Test::tearDown() {
+
+}
+
+void AffineTransform44Test::assertEqualData(const double* expected, const double* actual) {
+	for (int i = 0; i < AffineTransform44::matrixElements; ++i) {
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(expected[i], actual[i], maxTolerance);
+	}
+}
+
+void AffineTransform44Test::testConstructors() {
+	AffineTransform44 identity;
+	CPPUNIT_ASSERT(identity.isIdentity());
+
+	HomogeneousMatrix44 matrix(0,-1,0, 1,0,0, 0,0,1, 1,2,3);
+	AffineTransform44 transform(0,-1,0, 1,0,0, 0,0,1, 1,2,3);
+	assertEqualData(matrix.getRawData(), transform.getRawData());
+	CPPUNIT_ASSERT(!transform.isIdentity());
+
+	AffineTransform44 copiedTransform(matrix);
+	assertEqualData(matrix.getRawData(), copiedTransform.getRawData());
+
+	AffineTransform44 rawTransform(matrix.getRawData());
+	assertEqualData(matrix.getRawData(), rawTransform.getRawData());
+
+	identity = matrix;
+	assertEqualData(matrix.getRawData(), identity.getRawData());
+
+	HomogeneousMatrix44 resultMatrix;
+	transform.copyTo(&resultMatrix);
+	assertEqualData(transform.getRawData(), resultMatrix.getRawData());
+
+	transform.setIdentity();
+	CPPUNIT_ASSERT(transform.isIdentity());
+}
+
+void AffineTransform44Test::testMultiplication() {
+	AngleAxis<double> rotation1(M_PI_2/4.0, Vector3d(1,0,0));
+	Transform3d transformation1;
+	transformation1 = rotation1;
+	transformation1.translate(Vector3d(5,6,99.9));
+	AngleAxis<double> rotation2(-0.3, Vector3d(0,1,1).normalized());
+	Transform3d transformation2;
+	transformation2 = rotation2;
+	transformation2.translate(Vector3d(-1,0.5,2));
+
+	HomogeneousMatrix44 matrix1(&transformation1);
+	HomogeneousMatrix44 matrix2(&transformation2);
+	AffineTransform44 transform1(matrix1);
+	AffineTransform44 transform2(matrix2);
+
+	/* reference: generic multiplication of HomogeneousMatrix44 (in place for the left operand) */
+	HomogeneousMatrix44 expected(matrix1);
+	expected * matrix2;
+
+	AffineTransform44 result = transform1 * transform2;
+	assertEqualData(expected.getRawData(), result.getRawData());
+
+	result = transform1;
+	result *= transform2;
+	assertEqualData(expected.getRawData(), result.getRawData());
+
+	result = transform1;
+	result *= matrix2;
+	assertEqualData(expected.getRawData(), result.getRawData());
+
+	result = transform2;
+	result.premultiply(transform1);
+	assertEqualData(expected.getRawData(), result.getRawData());
+
+	/* aliased operands */
+	double rawData[AffineTransform44::matrixElements];
+	memcpy(rawData, matrix1.getRawData(), sizeof(rawData));
+	AffineTransform44::multiply(rawData, matrix2.getRawData(), rawData);
+	assertEqualData(expected.getRawData(), rawData);
+
+	HomogeneousMatrix44 expectedSquare(matrix1);
+	expectedSquare * matrix1;
+	result = transform1;
+	result *= result;
+	assertEqualData(expectedSquare.getRawData(), result.getRawData());
+}
+
+void AffineTransform44Test::testInverse() {
+	AffineTransform44 pureTranslation(1,0,0, 0,1,0, 0,0,1, 1,2,3);
+	CPPUNIT_ASSERT(pureTranslation.invert());
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(-1.0, pureTranslation.getRawData()[matrixEntry::x], maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(-2.0, pureTranslation.getRawData()[matrixEntry::y], maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(-3.0, pureTranslation.getRawData()[matrixEntry::z], maxTolerance);
+
+	AngleAxis<double> rotation(M_PI_2/4.0, Vector3d(1,0,0));
+	Transform3d transformation;
+	transformation = rotation;
+	transformation.translate(Vector3d(5,6,99.9));
+	HomogeneousMatrix44 matrix(&transformation);
+	AffineTransform44 transform(matrix);
+
+	matrix.inverse();
+	AffineTransform44 inverseTransform = transform.inverse();
+	assertEqualData(matrix.getRawData(), inverseTransform.getRawData());
+	CPPUNIT_ASSERT((transform * inverseTransform).isIdentity());
+	CPPUNIT_ASSERT((inverseTransform * transform).isIdentity());
+
+	/* non rigid (scaled) transform */
+	AffineTransform44 scaledTransform(2,0,0, 0,4,0, 0,0,0.5, 1,1,1);
+	CPPUNIT_ASSERT((scaledTransform * scaledTransform.inverse()).isIdentity());
+
+	/* singular transforms are rejected and stay untouched */
+	AffineTransform44 singularTransform(1,0,0, 0,0,0, 0,0,1, 1,2,3);
+	AffineTransform44 singularTransformCopy(singularTransform);
+	CPPUNIT_ASSERT(!singularTransform.invert());
+	assertEqualData(singularTransformCopy.getRawData(), singularTransform.getRawData());
+}
+
+void AffineTransform44Test::testCompose() {
+	const unsigned int count = 5;
+	AffineTransform44 transforms[count];
+	HomogeneousMatrix44 expected;
+	for (unsigned int i = 0; i < count; ++i) {
+		AngleAxis<double> rotation(0.1 * (i+1), Vector3d(i,1,2).normalized());
+		Transform3d transformation;
+		transformation = rotation;
+		transformation.translate(Vector3d(i,-1.0*i,0.5));
+		HomogeneousMatrix44 matrix(&transformation);
+		transforms[i] = matrix;
+		expected * matrix;
+	}
+
+	AffineTransform44 result(1,0,0, 0,1,0, 0,0,1, 7,8,9);
+	AffineTransform44::compose(transforms, count, result);
+	assertEqualData(expected.getRawData(), result.getRawData());
+
+	AffineTransform44::compose(transforms, 0, result);
+	CPPUNIT_ASSERT(result.isIdentity());
+
+	/* batch: express all transforms with respect to the first one */
+	AffineTransform44 lhs = transforms[0];
+	AffineTransform44 results[count];
+	AffineTransform44::composeBatch(lhs, transforms, count, results);
+	for (unsigned int i = 0; i < count; ++i) {
+		assertEqualData((lhs * transforms[i]).getRawData(), results[i].getRawData());
+	}
+
+	/* in place batch */
+	AffineTransform44::composeBatch(transforms[0], transforms, count, transforms);
+	for (unsigned int i = 0; i < count; ++i) {
+		assertEqualData(results[i].getRawData(), transforms[i].getRawData());
+	}
+}
+
+}
+
+/* EOF */
@@ -0,0 +1,58 @@
+/**
+ * @file
+ * AffineTransform44Test.h
+ *
+ * @date: Oct 17, 2026
+ * @author: sblume
+ */
+
+#ifndef AFFINETRANSFORM44TEST_H_
+#define AFFINETRANSFORM44TEST_H_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <Eigen/Geometry>
+#include "brics_3d/core/AffineTransform44.h"
+#include "brics_3d/core/HomogeneousMatrix44.h"
+
+namespace unitTests {
+
+using namespace std;
+using namespace brics_3d;
+using namespace Eigen;
+
+/**
+ * @brief UnitTest for the AffineTransform44 class
+ */
+class AffineTransform44Test : public CPPUNIT_NS::TestFixture {
+
+	CPPUNIT_TEST_SUITE( AffineTransform44Test );
+	CPPUNIT_TEST( testConstructors );
+	CPPUNIT_TEST( testMultiplication );
+	CPPUNIT_TEST( testInverse );
+	CPPUNIT_TEST( testCompose );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp();
+	void tearDown();
+
+	void testConstructors();
+	void testMultiplication();
+	void testInverse();
+	void testCompose();
+
+private:
+
+	/// Compare the raw data of a transform with a homogeneous matrix.
+	void assertEqualData(const double* expected, const double* actual);
+
+	static const double maxTolerance = 0.00001;
+};
+
+}
+
+#endif /* AFFINETRANSFORM44TEST_H_ */
+
+/* EOF */
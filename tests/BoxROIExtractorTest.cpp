@@ -7,6 +7,8 @@
  */
 
 #include "BoxROIExtractorTest.h"
+#include "brics_3d/core/ColoredPoint3D.h"
+#include <cstdlib>
 
 namespace unitTests {
 
@@ -242,7 +244,65 @@ void BoxROIExtractorTest::testBoxExtraction() {
 	delete resultPointCloud;
 }
 
+void BoxROIExtractorTest::testBlockwiseExtraction() {
+	/* enough points for multiple blocks and threads */
+	std::srand(0);
+	PointCloud3D pointCloud;
+	for (unsigned int i = 0; i < 2 * BoxROIExtractor::parallelThreshold + 17; ++i) {
+		Point3D* point = new Point3D(std::rand() / (RAND_MAX + 1.0) * 4.0 - 2.0,
+				std::rand() / (RAND_MAX + 1.0) * 4.0 - 2.0,
+				std::rand() / (RAND_MAX + 1.0) * 4.0 - 2.0);
+		pointCloud.addPointPtr(new ColoredPoint3D(point, i % 256, 0, 0));
+	}
+	PointCloud3DContiguous contiguousPointCloud;
+	contiguousPointCloud.copyFrom(&pointCloud);
+
+	BoxROIExtractor boxFilter(1.0, 2.0, 1.5);
+	HomogeneousMatrix44::IHomogeneousMatrix44Ptr boxOrigin(new HomogeneousMatrix44(0,-1,0, 1,0,0, 0,0,1, 0.3,0.2,0.1));
+	boxFilter.setBoxOrigin(boxOrigin);
+
+	/* reference: point by point */
+	HomogeneousMatrix44 inverseOrigin(0,-1,0, 1,0,0, 0,0,1, 0.3,0.2,0.1);
+	inverseOrigin.inverse();
+	std::vector<unsigned int> expectedIndices;
+	for (unsigned int i = 0; i < pointCloud.getSize(); ++i) {
+		Point3D tmpPoint = (*pointCloud.getPointCloud())[i];
+		tmpPoint.homogeneousTransformation(&inverseOrigin);
+		if (tmpPoint.getX() >= -0.5 && tmpPoint.getX() <= 0.5 &&
+				tmpPoint.getY() >= -1.0 && tmpPoint.getY() <= 1.0 &&
+				tmpPoint.getZ() >= -0.75 && tmpPoint.getZ() <= 0.75) {
+			expectedIndices.push_back(i);
+		}
+	}
+	CPPUNIT_ASSERT(expectedIndices.size() > 0);
+
+	unsigned int threads[] = {1, 4};
+	for (unsigned int run = 0; run < 2; ++run) {
+		boxFilter.setMaxNumberOfThreads(threads[run]);
+		CPPUNIT_ASSERT_EQUAL(threads[run], boxFilter.getMaxNumberOfThreads());
+
+		PointCloud3D result;
+		boxFilter.filter(&pointCloud, &result);
+		PointCloud3DContiguous contiguousResult;
+		boxFilter.filter(&contiguousPointCloud, &contiguousResult);
+
+		CPPUNIT_ASSERT_EQUAL(static_cast<unsigned int>(expectedIndices.size()), result.getSize());
+		CPPUNIT_ASSERT_EQUAL(static_cast<unsigned int>(expectedIndices.size()), contiguousResult.getSize());
+		CPPUNIT_ASSERT(contiguousResult.hasColors());
+		for (unsigned int i = 0; i < expectedIndices.size(); ++i) { // same order as the input
+			const Point3D& expected = (*pointCloud.getPointCloud())[expectedIndices[i]];
+			CPPUNIT_ASSERT_DOUBLES_EQUAL(expected.getX(), (*result.getPointCloud())[i].getX(), maxTolerance);
+			CPPUNIT_ASSERT_DOUBLES_EQUAL(expected.getY(), (*result.getPointCloud())[i].getY(), maxTolerance);
+			CPPUNIT_ASSERT_DOUBLES_EQUAL(expected.getZ(), (*result.getPointCloud())[i].getZ(), maxTolerance);
+			CPPUNIT_ASSERT((*result.getPointCloud())[i].asColoredPoint3D() != 0);
+			CPPUNIT_ASSERT_DOUBLES_EQUAL(expected.getX(), contiguousResult.getXCoordinates()[i], maxTolerance);
+			CPPUNIT_ASSERT_EQUAL(static_cast<unsigned char>(expectedIndices[i] % 256), contiguousResult.getColors()[3 * i]);
+		}
+	}
 }
 
+}
+
+
 
 /* EOF */
@@ -24,6 +24,7 @@ class BoxROIExtractorTest : public CPPUNIT_NS::TestFixture {
 	CPPUNIT_TEST_SUITE( BoxROIExtractorTest );
 	CPPUNIT_TEST( testConstructor );
 	CPPUNIT_TEST( testBoxExtraction );
+	CPPUNIT_TEST( testBlockwiseExtraction );
 	CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -33,6 +34,7 @@ public:
 
 	void testConstructor();
 	void testBoxExtraction();
+	void testBlockwiseExtraction();
 
 	EIGEN_MAKE_ALIGNED_OPERATOR_NEW //Required by Eigen2
 
@@ -0,0 +1,143 @@
+/**
+ * @file 
+ * ColorSpaceConvertorTest.cpp
+ *
+ * @date: Oct 17, 2026
+ * @author: sblume
+ */
+
+#include "ColorSpaceConvertorTest.h"
+#include "brics_3d/core/ColoredPoint3D.h"
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+namespace unitTests {
+
+CPPUNIT_TEST_SUITE_REGISTRATION( ColorSpaceConvertorTest );
+
+void ColorSpaceConvertorTest::setUp() {
+
+}
+
+void ColorSpaceConvertorTest::tearDown() {
+
+}
+
+void ColorSpaceConvertorTest::testPrimaryColors() {
+	const unsigned char rgb[] = {
+			255, 0, 0,
+			0, 255, 0,
+			0, 0, 255,
+			255, 0, 255,
+			128, 128, 128,
+			0, 0, 0};
+	unsigned char hsv[18];
+	ColorSpaceConvertor::rgbToHsv(rgb, hsv, 6);
+
+	CPPUNIT_ASSERT_EQUAL(0, static_cast<int>(hsv[0])); // red
+	CPPUNIT_ASSERT_EQUAL(255, static_cast<int>(hsv[1]));
+	CPPUNIT_ASSERT_EQUAL(255, static_cast<int>(hsv[2]));
+	CPPUNIT_ASSERT_EQUAL(90, static_cast<int>(hsv[3])); // green
+	CPPUNIT_ASSERT_EQUAL(120, static_cast<int>(hsv[6])); // blue
+	CPPUNIT_ASSERT_EQUAL(150, static_cast<int>(hsv[9])); // magenta wraps around
+	CPPUNIT_ASSERT_EQUAL(255, static_cast<int>(hsv[10]));
+
+	/* gray values have no hue */
+	CPPUNIT_ASSERT_EQUAL(ColorSpaceConvertor::undefinedHue, hsv[12]);
+	CPPUNIT_ASSERT_EQUAL(0, static_cast<int>(hsv[13]));
+	CPPUNIT_ASSERT_EQUAL(128, static_cast<int>(hsv[14]));
+	CPPUNIT_ASSERT_EQUAL(ColorSpaceConvertor::undefinedHue, hsv[15]);
+	CPPUNIT_ASSERT_EQUAL(0, static_cast<int>(hsv[16]));
+	CPPUNIT_ASSERT_EQUAL(0, static_cast<int>(hsv[17]));
+
+	ColorSpaceConvertor::rgbToHsv(rgb, hsv, 0); // nothing to do
+}
+
+void ColorSpaceConvertorTest::testBatchConversion() {
+	/* compare against the scalar version on a subsampled color cube */
+	std::vector<unsigned char> rgb;
+	for (int r = 0; r < 256; r += 5) {
+		for (int g = 0; g < 256; g += 3) {
+			for (int b = 0; b < 256; b += 7) {
+				rgb.push_back(static_cast<unsigned char>(r));
+				rgb.push_back(static_cast<unsigned char>(g));
+				rgb.push_back(static_cast<unsigned char>(b));
+			}
+		}
+	}
+	unsigned int count = static_cast<unsigned int>(rgb.size() / 3);
+	std::vector<unsigned char> hsv(3 * count);
+	ColorSpaceConvertor::rgbToHsv(&rgb[0], &hsv[0], count);
+
+	ColorSpaceConvertor colorConvertor;
+	double h, s, v;
+	for (unsigned int i = 0; i < count; ++i) {
+		colorConvertor.rgbToHsv(rgb[3 * i], rgb[3 * i + 1], rgb[3 * i + 2], &h, &s, &v);
+		if (h != h) { // gray
+			CPPUNIT_ASSERT_EQUAL(ColorSpaceConvertor::undefinedHue, hsv[3 * i]);
+		} else {
+			CPPUNIT_ASSERT(hsv[3 * i] < 180);
+			double hueDifference = std::fabs(h - hsv[3 * i]);
+			CPPUNIT_ASSERT(std::min(hueDifference, 180.0 - hueDifference) <= 1.0); // 179.6 may be rounded to 0
+		}
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(s, hsv[3 * i + 1], 1.0);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(v, hsv[3 * i + 2], maxTolerance);
+	}
+
+	/* unaligned start and a count that is not a multiple of the SIMD width give the same values */
+	std::vector<unsigned char> partialHsv(3 * 21);
+	ColorSpaceConvertor::rgbToHsv(&rgb[3 * 1001], &partialHsv[0], 21);
+	for (unsigned int i = 0; i < 3 * 21; ++i) {
+		CPPUNIT_ASSERT_EQUAL(hsv[3 * 1001 + i], partialHsv[i]);
+	}
+}
+
+void ColorSpaceConvertorTest::testHSVExtraction() {
+	/* more points than one conversion block, with undecorated points in between */
+	PointCloud3D pointCloud;
+	unsigned int expectedCount = 0;
+	for (int i = 0; i < 3000; ++i) {
+		if (i % 7 == 0) {
+			pointCloud.addPoint(Point3D(i, 0, 0));
+			continue;
+		}
+		unsigned char green = static_cast<unsigned char>(i % 256);
+		pointCloud.addPointPtr(new ColoredPoint3D(new Point3D(i, 0, 0), 0, green, 0));
+		if (green > 0) {
+			expectedCount++;
+		}
+	}
+
+	ColorBasedROIExtractorHSV hsvFilter;
+	hsvFilter.setMinH(80);
+	hsvFilter.setMaxH(100);
+	hsvFilter.setMinS(100);
+	hsvFilter.setMaxS(255);
+	PointCloud3D result;
+	hsvFilter.filter(&pointCloud, &result);
+	CPPUNIT_ASSERT_EQUAL(expectedCount, result.getSize());
+	for (unsigned int i = 0; i < result.getSize(); ++i) {
+		CPPUNIT_ASSERT((*result.getPointCloud())[i].asColoredPoint3D()->getG() > 0);
+	}
+
+	PointCloud3DContiguous packedCloud;
+	packedCloud.copyFrom(&pointCloud);
+	PointCloud3DContiguous packedResult;
+	hsvFilter.filter(&packedCloud, &packedResult);
+	CPPUNIT_ASSERT_EQUAL(expectedCount, packedResult.getSize()); // undecorated points are black in the packed cloud, black has no hue
+
+	std::vector<unsigned int> indices(pointCloud.getSize());
+	for (unsigned int i = 0; i < indices.size(); ++i) {
+		indices[i] = i;
+	}
+	unsigned int passed = hsvFilter.select(&pointCloud, &indices[0], static_cast<unsigned int>(indices.size()));
+	CPPUNIT_ASSERT_EQUAL(expectedCount, passed);
+	for (unsigned int i = 0; i < passed; ++i) {
+		CPPUNIT_ASSERT_DOUBLES_EQUAL((*result.getPointCloud())[i].getX(), indices[i], maxTolerance);
+	}
+}
+
+}
+
+/* EOF */
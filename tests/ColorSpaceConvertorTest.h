@@ -0,0 +1,47 @@
+/**
+ * @file 
+ * ColorSpaceConvertorTest.h
+ *
+ * @date: Oct 17, 2026
+ * @author: sblume
+ */
+
+#ifndef COLORSPACECONVERTORTEST_H_
+#define COLORSPACECONVERTORTEST_H_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "brics_3d/core/ColorSpaceConvertor.h"
+#include "brics_3d/algorithm/filtering/ColorBasedROIExtractorHSV.h"
+
+using namespace std;
+using namespace brics_3d;
+
+namespace unitTests {
+
+class ColorSpaceConvertorTest : public CPPUNIT_NS::TestFixture {
+
+	CPPUNIT_TEST_SUITE( ColorSpaceConvertorTest );
+	CPPUNIT_TEST( testPrimaryColors );
+	CPPUNIT_TEST( testBatchConversion );
+	CPPUNIT_TEST( testHSVExtraction );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp();
+	void tearDown();
+
+	void testPrimaryColors();
+	void testBatchConversion();
+	void testHSVExtraction();
+
+private:
+	static const double maxTolerance = 0.00001;
+};
+
+}
+
+#endif /* COLORSPACECONVERTORTEST_H_ */
+
+/* EOF */
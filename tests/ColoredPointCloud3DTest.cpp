@@ -13,6 +13,9 @@
 #include <stdexcept>
 
 #include "brics_3d/core/HomogeneousMatrix44.h"
+#include "brics_3d/core/PointCloud3DContiguous.h"
+#include "brics_3d/algorithm/filtering/ColorBasedROIExtractorHSV.h"
+#include "brics_3d/algorithm/filtering/ColorBasedROIExtractorRGB.h"
 
 namespace unitTests {
 
@@ -471,6 +474,56 @@ void ColoredPointCloud3DTest::testPolymorphPointCloud() {
 
 }
 
+void ColoredPointCloud3DTest::testColorChannelFiltering() {
+	PointCloud3D coloredCloud;
+	coloredCloud.addPointPtr(new ColoredPoint3D(new Point3D(1,0,0), 255, 0, 0));     // red
+	coloredCloud.addPointPtr(new ColoredPoint3D(new Point3D(2,0,0), 0, 255, 0));     // green
+	coloredCloud.addPointPtr(new ColoredPoint3D(new Point3D(3,0,0), 0, 0, 255));     // blue
+	coloredCloud.addPointPtr(new ColoredPoint3D(new Point3D(4,0,0), 0, 128, 0));     // dark green
+	coloredCloud.addPointPtr(new ColoredPoint3D(new Point3D(5,0,0), 255, 200, 200)); // pale red
+
+	PointCloud3DContiguous packedCloud;
+	packedCloud.copyFrom(&coloredCloud);
+	CPPUNIT_ASSERT(packedCloud.hasColors());
+
+	/* HSV: decorated and packed variant have to select the same points */
+	ColorBasedROIExtractorHSV hsvFilter;
+	hsvFilter.setMinH(80);
+	hsvFilter.setMaxH(100);
+	hsvFilter.setMinS(100);
+	hsvFilter.setMaxS(255);
+
+	PointCloud3D decoratedResult;
+	PointCloud3DContiguous packedResult;
+	hsvFilter.filter(&coloredCloud, &decoratedResult);
+	hsvFilter.filter(&packedCloud, &packedResult);
+	CPPUNIT_ASSERT_EQUAL(2u, decoratedResult.getSize());
+	CPPUNIT_ASSERT_EQUAL(decoratedResult.getSize(), packedResult.getSize());
+	CPPUNIT_ASSERT(packedResult.hasColors());
+	for (unsigned int i = 0; i < packedResult.getSize(); ++i) {
+		CPPUNIT_ASSERT_DOUBLES_EQUAL((*decoratedResult.getPointCloud())[i].getX(), packedResult.getXCoordinates()[i], maxTolerance);
+		CPPUNIT_ASSERT_EQUAL((*decoratedResult.getPointCloud())[i].asColoredPoint3D()->getG(), packedResult.getColors()[3 * i + 1]);
+	}
+
+	/* RGB distance */
+	ColorBasedROIExtractorRGB rgbFilter;
+	rgbFilter.setGreen(255);
+	rgbFilter.setDistanceThresholdMinimum(0.0);
+	rgbFilter.setDistanceThresholdMaximum(130.0);
+	decoratedResult.getPointCloud()->clear();
+	rgbFilter.filter(&coloredCloud, &decoratedResult);
+	rgbFilter.filter(&packedCloud, &packedResult);
+	CPPUNIT_ASSERT_EQUAL(2u, decoratedResult.getSize());
+	CPPUNIT_ASSERT_EQUAL(decoratedResult.getSize(), packedResult.getSize());
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(2.0, packedResult.getXCoordinates()[0], maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(4.0, packedResult.getXCoordinates()[1], maxTolerance);
+
+	/* without a color channel nothing passes */
+	packedCloud.disableAttributes();
+	hsvFilter.filter(&packedCloud, &packedResult);
+	CPPUNIT_ASSERT_EQUAL(0u, packedResult.getSize());
+}
+
 }
 
 
@@ -33,6 +33,7 @@ class ColoredPointCloud3DTest : public CPPUNIT_NS::TestFixture {
 	CPPUNIT_TEST( testTransformation );
 	CPPUNIT_TEST( testMassiveData );
 	CPPUNIT_TEST( testPolymorphPointCloud );
+	CPPUNIT_TEST( testColorChannelFiltering );
 	CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -46,6 +47,7 @@ public:
 	  void testTransformation();
 	  void testMassiveData();
 	  void testPolymorphPointCloud();
+	  void testColorChannelFiltering();
 
 	  EIGEN_MAKE_ALIGNED_OPERATOR_NEW //Required by Eigen2
 
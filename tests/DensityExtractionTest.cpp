@@ -18,6 +18,8 @@
  ******************************************************************************/
 
 #include "DensityExtractionTest.h"
+#include <limits>
+#include <stdexcept>
 
 namespace unitTests {
 
@@ -96,6 +98,79 @@ void DensityExtractionTest::testSimpleDensityExtraction() {
 
 }
 
+void DensityExtractionTest::testDensityGrid() {
+	DensityExtractor densityExtractor;
+	DensityGrid grid;
+	PointCloud3D unitCube; // computeDensity() deletes its input, so the fixture point clouds cannot be used here
+	for (int i = 0; i < 8; ++i) {
+		unitCube.addPoint(Point3D(i & 1, (i >> 1) & 1, (i >> 2) & 1));
+	}
+
+	Density result = densityExtractor.computeDensityGrid(&unitCube, 1.0, &grid);
+	CPPUNIT_ASSERT_EQUAL(8, result.numberOfPoints);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(8.0, result.volume, maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, result.density, maxTolerance);
+	CPPUNIT_ASSERT_EQUAL(2u, grid.dimensionX);
+	CPPUNIT_ASSERT_EQUAL(2u, grid.dimensionY);
+	CPPUNIT_ASSERT_EQUAL(2u, grid.dimensionZ);
+	CPPUNIT_ASSERT_EQUAL(8u, grid.numberOfOccupiedVoxels);
+	CPPUNIT_ASSERT_EQUAL(1u, grid.getCount(1, 0, 1));
+
+	/* finer grid: only the corners are occupied */
+	unitCube.addPoint(Point3D(0.1, 0.1, 0.1));
+	unitCube.addPoint(Point3D(std::numeric_limits<double>::quiet_NaN(), 0, 0)); // ignored
+	result = densityExtractor.computeDensityGrid(&unitCube, 0.5, &grid);
+	CPPUNIT_ASSERT_EQUAL(9, result.numberOfPoints);
+	CPPUNIT_ASSERT_EQUAL(3u, grid.dimensionX);
+	CPPUNIT_ASSERT_EQUAL(27u, static_cast<unsigned int>(grid.counts.size()));
+	CPPUNIT_ASSERT_EQUAL(8u, grid.numberOfOccupiedVoxels);
+	CPPUNIT_ASSERT_EQUAL(2u, grid.getCount(0, 0, 0));
+	CPPUNIT_ASSERT_EQUAL(0u, grid.getCount(1, 1, 1));
+	CPPUNIT_ASSERT_EQUAL(1u, grid.getCount(2, 2, 2));
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(16.0, grid.getDensity(0, 0, 0), maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(9.0, result.density, maxTolerance); // 9 points in 8 * 0.125
+
+	PointCloud3D emptyPointCloud;
+	result = densityExtractor.computeDensityGrid(&emptyPointCloud, 0.5, &grid);
+	CPPUNIT_ASSERT_EQUAL(0, result.numberOfPoints);
+	CPPUNIT_ASSERT_EQUAL(0u, static_cast<unsigned int>(grid.counts.size()));
+
+	CPPUNIT_ASSERT_THROW(densityExtractor.computeDensityGrid(&unitCube, 0.0, &grid), std::runtime_error);
+	CPPUNIT_ASSERT_THROW(densityExtractor.computeDensityGrid(&unitCube, 1e-4, &grid), std::runtime_error); // 10^12 voxels
+}
+
+void DensityExtractionTest::testDensityGridLarge() {
+	/* enough points for the parallel histogram: a 10x10x10 grid with a known number of points per cell */
+	PointCloud3DContiguousFloat pointCloud;
+	unsigned int expectedCounts[1000];
+	for (unsigned int cell = 0; cell < 1000; ++cell) {
+		expectedCounts[cell] = 100 + cell % 50;
+		for (unsigned int i = 0; i < expectedCounts[cell]; ++i) {
+			float offset = 0.1f + 0.8f * i / expectedCounts[cell];
+			pointCloud.addPoint(Point3D(cell % 10 + offset, (cell / 10) % 10 + offset, cell / 100 + offset));
+		}
+	}
+	pointCloud.addPoint(Point3D(0, 0, 0)); // fix the origin of the grid
+	CPPUNIT_ASSERT(pointCloud.getSize() > DensityExtractor::parallelThreshold);
+
+	DensityExtractor densityExtractor;
+	densityExtractor.setMaxNumberOfThreads(4);
+	DensityGrid grid;
+	Density result = densityExtractor.computeDensityGrid(pointCloud, 1.0, &grid);
+	CPPUNIT_ASSERT_EQUAL(static_cast<int>(pointCloud.getSize()), result.numberOfPoints);
+	CPPUNIT_ASSERT_EQUAL(1000u, grid.numberOfOccupiedVoxels);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(pointCloud.getSize() / 1000.0, result.density, maxTolerance);
+	for (unsigned int cell = 1; cell < 1000; ++cell) {
+		CPPUNIT_ASSERT_EQUAL(expectedCounts[cell], grid.getCount(cell % 10, (cell / 10) % 10, cell / 100));
+	}
+	CPPUNIT_ASSERT_EQUAL(expectedCounts[0] + 1, grid.getCount(0, 0, 0));
+
+	/* more cells than points per thread: counted without partial histograms */
+	result = densityExtractor.computeDensityGrid(pointCloud, 0.1, &grid);
+	CPPUNIT_ASSERT(grid.counts.size() > pointCloud.getSize());
+	CPPUNIT_ASSERT_EQUAL(static_cast<int>(pointCloud.getSize()), result.numberOfPoints);
+}
+
 } /* namespace unitTests */
 
 
@@ -33,6 +33,8 @@ class DensityExtractionTest : public CPPUNIT_NS::TestFixture {
 
 	CPPUNIT_TEST_SUITE( DensityExtractionTest );
 	CPPUNIT_TEST( testSimpleDensityExtraction );
+	CPPUNIT_TEST( testDensityGrid );
+	CPPUNIT_TEST( testDensityGridLarge );
 	CPPUNIT_TEST_SUITE_END();
 public:
 
@@ -40,6 +42,8 @@ public:
 	void tearDown();
 
 	void testSimpleDensityExtraction();
+	void testDensityGrid();
+	void testDensityGridLarge();
 
 	/// Maximum deviation for equality check of double variables
 	static const double maxTolerance = 0.00001;
@@ -0,0 +1,139 @@
+/**
+ * @file 
+ * FilterPipelineTest.cpp
+ *
+ * @date: Oct 17, 2026
+ * @author: sblume
+ */
+
+#include "FilterPipelineTest.h"
+#include "brics_3d/core/HomogeneousMatrix44.h"
+#include <cstdlib>
+#include <stdexcept>
+
+namespace unitTests {
+
+CPPUNIT_TEST_SUITE_REGISTRATION( FilterPipelineTest );
+
+void FilterPipelineTest::setUp() {
+	std::srand(0);
+	pointCloud = new PointCloud3D();
+	for (int i = 0; i < 10000; ++i) {
+		Point3D* point = new Point3D(std::rand() / (RAND_MAX + 1.0) * 4.0 - 2.0,
+				std::rand() / (RAND_MAX + 1.0) * 4.0 - 2.0,
+				std::rand() / (RAND_MAX + 1.0) * 4.0 - 2.0);
+		if (i % 10 == 0) {
+			pointCloud->addPointPtr(point); // some points without color
+		} else {
+			pointCloud->addPointPtr(new ColoredPoint3D(point, std::rand() % 256, std::rand() % 256, std::rand() % 256));
+		}
+	}
+
+	boxFilter = new BoxROIExtractor(2.0, 3.0, 2.5);
+	IHomogeneousMatrix44::IHomogeneousMatrix44Ptr boxOrigin(new HomogeneousMatrix44(0,-1,0, 1,0,0, 0,0,1, 0.3,0.2,0.1));
+	boxFilter->setBoxOrigin(boxOrigin);
+
+	colorFilter = new ColorBasedROIExtractorHSV();
+	colorFilter->setMinH(20);
+	colorFilter->setMaxH(120);
+	colorFilter->setMinS(50);
+	colorFilter->setMaxS(255);
+}
+
+void FilterPipelineTest::tearDown() {
+	delete colorFilter;
+	delete boxFilter;
+	delete pointCloud;
+}
+
+void FilterPipelineTest::testStages() {
+	FilterPipeline pipeline;
+	VoxelGridFilter reduction(0.5);
+	CPPUNIT_ASSERT_EQUAL(0u, pipeline.getNumberOfStages());
+	CPPUNIT_ASSERT_EQUAL(FilterPipeline::defaultChunkSize, pipeline.getChunkSize());
+	CPPUNIT_ASSERT_THROW(pipeline.setChunkSize(0), std::runtime_error);
+
+	pipeline.setReductionStage(&reduction, "voxels");
+	pipeline.addStage(boxFilter, "box");
+	pipeline.addStage(colorFilter, "hsv");
+	CPPUNIT_ASSERT_EQUAL(3u, pipeline.getNumberOfStages());
+	CPPUNIT_ASSERT(pipeline.getStageName(0).compare("box") == 0);
+	CPPUNIT_ASSERT(pipeline.getStageName(1).compare("hsv") == 0);
+	CPPUNIT_ASSERT(pipeline.getStageName(2).compare("voxels") == 0); // reduction stays last
+	CPPUNIT_ASSERT_THROW(pipeline.getStageTime(3), std::runtime_error);
+
+	pipeline.setReductionStage(0);
+	CPPUNIT_ASSERT_EQUAL(2u, pipeline.getNumberOfStages());
+	pipeline.clearStages();
+	CPPUNIT_ASSERT_EQUAL(0u, pipeline.getNumberOfStages());
+
+	/* an empty pipeline copies the input */
+	PointCloud3D result;
+	pipeline.filter(pointCloud, &result);
+	CPPUNIT_ASSERT_EQUAL(pointCloud->getSize(), result.getSize());
+	CPPUNIT_ASSERT((*result.getPointCloud())[1].asColoredPoint3D() != 0);
+}
+
+void FilterPipelineTest::testSelectors() {
+	/* reference: one filter after the other */
+	PointCloud3D boxResult;
+	PointCloud3D referenceResult;
+	boxFilter->filter(pointCloud, &boxResult);
+	colorFilter->filter(&boxResult, &referenceResult);
+	CPPUNIT_ASSERT(referenceResult.getSize() > 0);
+	CPPUNIT_ASSERT(referenceResult.getSize() < boxResult.getSize());
+
+	FilterPipeline pipeline;
+	pipeline.setChunkSize(333); // chunks do not match the size of the input
+	pipeline.addStage(boxFilter, "box");
+	pipeline.addStage(colorFilter, "hsv");
+	PointCloud3D result;
+	result.addPoint(Point3D(100.0, 100.0, 100.0)); // the result is replaced, not appended to
+	pipeline.filter(pointCloud, &result);
+
+	CPPUNIT_ASSERT_EQUAL(referenceResult.getSize(), result.getSize());
+	for (unsigned int i = 0; i < result.getSize(); ++i) {
+		CPPUNIT_ASSERT_DOUBLES_EQUAL((*referenceResult.getPointCloud())[i].getX(), (*result.getPointCloud())[i].getX(), maxTolerance);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL((*referenceResult.getPointCloud())[i].getY(), (*result.getPointCloud())[i].getY(), maxTolerance);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL((*referenceResult.getPointCloud())[i].getZ(), (*result.getPointCloud())[i].getZ(), maxTolerance);
+		CPPUNIT_ASSERT((*result.getPointCloud())[i].asColoredPoint3D() != 0);
+	}
+	CPPUNIT_ASSERT_EQUAL(boxResult.getSize(), pipeline.getStageOutputCount(0));
+	CPPUNIT_ASSERT_EQUAL(referenceResult.getSize(), pipeline.getStageOutputCount(1));
+	CPPUNIT_ASSERT(pipeline.getStageTime(0) >= 0.0);
+	CPPUNIT_ASSERT(pipeline.getOutputTime() >= 0.0);
+
+	pipeline.resetTimings();
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, static_cast<double>(pipeline.getStageTime(0)), maxTolerance);
+}
+
+void FilterPipelineTest::testReduction() {
+	VoxelGridFilter reduction(0.5);
+
+	PointCloud3D boxResult;
+	PointCloud3D colorResult;
+	PointCloud3D referenceResult;
+	boxFilter->filter(pointCloud, &boxResult);
+	colorFilter->filter(&boxResult, &colorResult);
+	reduction.filter(&colorResult, &referenceResult);
+
+	FilterPipeline pipeline;
+	pipeline.addStage(boxFilter, "box");
+	pipeline.addStage(colorFilter, "hsv");
+	pipeline.setReductionStage(&reduction, "voxels");
+	PointCloud3D result;
+	result.addPoint(Point3D(100.0, 100.0, 100.0)); // the result is replaced, not appended to
+	pipeline.filter(pointCloud, &result);
+
+	CPPUNIT_ASSERT_EQUAL(referenceResult.getSize(), result.getSize());
+	CPPUNIT_ASSERT_EQUAL(result.getSize(), pipeline.getStageOutputCount(2));
+	for (unsigned int i = 0; i < result.getSize(); ++i) {
+		CPPUNIT_ASSERT_DOUBLES_EQUAL((*referenceResult.getPointCloud())[i].getX(), (*result.getPointCloud())[i].getX(), maxTolerance);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL((*referenceResult.getPointCloud())[i].getY(), (*result.getPointCloud())[i].getY(), maxTolerance);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL((*referenceResult.getPointCloud())[i].getZ(), (*result.getPointCloud())[i].getZ(), maxTolerance);
+	}
+}
+
+}
+
+/* EOF */
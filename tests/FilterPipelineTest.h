@@ -0,0 +1,55 @@
+/**
+ * @file 
+ * FilterPipelineTest.h
+ *
+ * @date: Oct 17, 2026
+ * @author: sblume
+ */
+
+#ifndef FILTERPIPELINETEST_H_
+#define FILTERPIPELINETEST_H_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "brics_3d/algorithm/filtering/FilterPipeline.h"
+#include "brics_3d/algorithm/filtering/BoxROIExtractor.h"
+#include "brics_3d/algorithm/filtering/ColorBasedROIExtractorHSV.h"
+#include "brics_3d/algorithm/filtering/VoxelGridFilter.h"
+#include "brics_3d/core/ColoredPoint3D.h"
+
+using namespace std;
+using namespace brics_3d;
+
+namespace unitTests {
+
+class FilterPipelineTest : public CPPUNIT_NS::TestFixture {
+
+	CPPUNIT_TEST_SUITE( FilterPipelineTest );
+	CPPUNIT_TEST( testStages );
+	CPPUNIT_TEST( testSelectors );
+	CPPUNIT_TEST( testReduction );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp();
+	void tearDown();
+
+	void testStages();
+	void testSelectors();
+	void testReduction();
+
+private:
+
+	static const double maxTolerance = 0.00001;
+
+	PointCloud3D* pointCloud;
+	BoxROIExtractor* boxFilter;
+	ColorBasedROIExtractorHSV* colorFilter;
+};
+
+}
+
+#endif /* FILTERPIPELINETEST_H_ */
+
+/* EOF */
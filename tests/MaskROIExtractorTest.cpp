@@ -0,0 +1,114 @@
+/**
+ * @file 
+ * MaskROIExtractorTest.cpp
+ *
+ * @date: Oct 17, 2026
+ * @author: sblume
+ */
+
+#include "MaskROIExtractorTest.h"
+
+namespace unitTests {
+
+CPPUNIT_TEST_SUITE_REGISTRATION( MaskROIExtractorTest );
+
+void MaskROIExtractorTest::setUp() {
+	pointCloud = new PointCloud3D();
+	for (int i = 0; i < 10; ++i) {
+		pointCloud->addPoint(Point3D(i, 2 * i, 3 * i));
+	}
+}
+
+void MaskROIExtractorTest::tearDown() {
+	delete pointCloud;
+}
+
+void MaskROIExtractorTest::testMask() {
+	MaskROIExtractor extractor;
+	std::vector<int> mask;
+	mask.push_back(7);
+	mask.push_back(2);
+	mask.push_back(5);
+	extractor.setMask(&mask);
+
+	PointCloud3D result;
+	extractor.filter(pointCloud, &result);
+	CPPUNIT_ASSERT_EQUAL(3u, result.getSize());
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(7.0, (*result.getPointCloud())[0].getX(), maxTolerance); // order of the mask
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(4.0, (*result.getPointCloud())[1].getY(), maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(15.0, (*result.getPointCloud())[2].getZ(), maxTolerance);
+
+	/* previous content is replaced */
+	mask.pop_back();
+	extractor.filter(pointCloud, &result);
+	CPPUNIT_ASSERT_EQUAL(2u, result.getSize());
+}
+
+void MaskROIExtractorTest::testInvertedMask() {
+	MaskROIExtractor extractor;
+	std::vector<int> mask;
+	mask.push_back(9);
+	mask.push_back(0);
+	mask.push_back(4);
+	extractor.setMask(&mask);
+	extractor.setUseInvertedMask(true);
+	CPPUNIT_ASSERT(extractor.getUseInvertedMask());
+
+	PointCloud3D result;
+	extractor.filter(pointCloud, &result);
+	CPPUNIT_ASSERT_EQUAL(7u, result.getSize());
+	double expectedX[] = {1, 2, 3, 5, 6, 7, 8};
+	for (unsigned int i = 0; i < result.getSize(); ++i) {
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(expectedX[i], (*result.getPointCloud())[i].getX(), maxTolerance);
+	}
+	CPPUNIT_ASSERT_EQUAL(9, mask[0]); // the mask is not modified
+
+	/* an empty mask selects everything */
+	mask.clear();
+	extractor.filter(pointCloud, &result);
+	CPPUNIT_ASSERT_EQUAL(10u, result.getSize());
+
+	/* a full mask selects nothing */
+	for (int i = 0; i < 10; ++i) {
+		mask.push_back(i);
+	}
+	extractor.filter(pointCloud, &result);
+	CPPUNIT_ASSERT_EQUAL(0u, result.getSize());
+}
+
+void MaskROIExtractorTest::testLargeMask() {
+	PointCloud3D largePointCloud;
+	std::vector<int> mask;
+	unsigned int numberOfPoints = 3 * MaskROIExtractor::parallelThreshold;
+	for (unsigned int i = 0; i < numberOfPoints; ++i) {
+		largePointCloud.addPoint(Point3D(i, 0, 0));
+		if (i % 3 == 0) {
+			mask.push_back(i);
+		}
+	}
+
+	unsigned int threads[] = {1, 4};
+	for (unsigned int run = 0; run < 2; ++run) {
+		MaskROIExtractor extractor;
+		extractor.setMaxNumberOfThreads(threads[run]);
+		extractor.setMask(&mask);
+
+		PointCloud3D result;
+		extractor.filter(&largePointCloud, &result);
+		CPPUNIT_ASSERT_EQUAL(numberOfPoints / 3, result.getSize());
+		for (unsigned int i = 0; i < result.getSize(); ++i) {
+			CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0 * i, (*result.getPointCloud())[i].getX(), maxTolerance);
+		}
+
+		extractor.setUseInvertedMask(true);
+		extractor.filter(&largePointCloud, &result);
+		CPPUNIT_ASSERT_EQUAL(numberOfPoints - numberOfPoints / 3, result.getSize());
+		for (unsigned int i = 0; i < result.getSize(); ++i) {
+			CPPUNIT_ASSERT_DOUBLES_EQUAL(static_cast<double>(i + i / 2 + 1), (*result.getPointCloud())[i].getX(), maxTolerance);
+		}
+	}
+}
+
+}
+
+/* EOF */
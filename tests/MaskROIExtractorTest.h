@@ -0,0 +1,49 @@
+/**
+ * @file 
+ * MaskROIExtractorTest.h
+ *
+ * @date: Oct 17, 2026
+ * @author: sblume
+ */
+
+#ifndef MASKROIEXTRACTORTEST_H_
+#define MASKROIEXTRACTORTEST_H_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "brics_3d/algorithm/filtering/MaskROIExtractor.h"
+
+using namespace std;
+using namespace brics_3d;
+
+namespace unitTests {
+
+class MaskROIExtractorTest : public CPPUNIT_NS::TestFixture {
+
+	CPPUNIT_TEST_SUITE( MaskROIExtractorTest );
+	CPPUNIT_TEST( testMask );
+	CPPUNIT_TEST( testInvertedMask );
+	CPPUNIT_TEST( testLargeMask );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp();
+	void tearDown();
+
+	void testMask();
+	void testInvertedMask();
+	void testLargeMask();
+
+private:
+
+	static const double maxTolerance = 0.00001;
+
+	PointCloud3D* pointCloud;
+};
+
+}
+
+#endif /* MASKROIEXTRACTORTEST_H_ */
+
+/* EOF */
@@ -7,6 +7,9 @@
  */
 
 #include "NearestNeighborTest.h"
+#include <algorithm>
+#include <cstdlib>
+#include <limits>
 
 #include <sstream>
 #include <stdexcept>
@@ -279,6 +282,53 @@ void NearestNeighborTest::testFLANNHighDimension() {
 
 }
 
+void NearestNeighborTest::testFLANNSinglePrecision() {
+	nearestNeigborFLANN = new NearestNeighborFLANN();
+
+	/* float vector data */
+	vector<vector<float> > data;
+	for (unsigned int i = 0; i < pointCloudCube->getSize(); ++i) {
+		vector<float> row(3);
+		row[0] = static_cast<float>((*pointCloudCube->getPointCloud())[i].getX());
+		row[1] = static_cast<float>((*pointCloudCube->getPointCloud())[i].getY());
+		row[2] = static_cast<float>((*pointCloudCube->getPointCloud())[i].getZ());
+		data.push_back(row);
+	}
+	nearestNeigborFLANN->setData(&data);
+	CPPUNIT_ASSERT_EQUAL(3, nearestNeigborFLANN->getDimension());
+
+	vector<int> resultIndices;
+	for (unsigned int i = 0; i < data.size(); ++i) {
+		nearestNeigborFLANN->findNearestNeighbors(&data[i], &resultIndices);
+		CPPUNIT_ASSERT_EQUAL(1, static_cast<int>(resultIndices.size()));
+		CPPUNIT_ASSERT_EQUAL(static_cast<int>(i), resultIndices[0]);
+	}
+
+	vector<float> invalidQuery(4);
+	CPPUNIT_ASSERT_THROW(nearestNeigborFLANN->findNearestNeighbors(&invalidQuery, &resultIndices), runtime_error);
+
+	/* contiguous single precision point cloud; replaces the previous data */
+	PointCloud3DContiguousFloat floatCloud;
+	floatCloud.copyFrom(pointCloudCube);
+	nearestNeigborFLANN->setData(&floatCloud);
+	CPPUNIT_ASSERT_EQUAL(3, nearestNeigborFLANN->getDimension());
+	for (unsigned int i = 0; i < pointCloudCube->getSize(); ++i) {
+		nearestNeigborFLANN->findNearestNeighbors(&(*pointCloudCube->getPointCloud())[i], &resultIndices);
+		CPPUNIT_ASSERT_EQUAL(1, static_cast<int>(resultIndices.size()));
+		CPPUNIT_ASSERT_EQUAL(static_cast<int>(i), resultIndices[0]);
+	}
+
+	/* contiguous double precision point cloud */
+	PointCloud3DContiguous doubleCloud;
+	doubleCloud.copyFrom(pointCloudCube);
+	nearestNeigborFLANN->setData(&doubleCloud);
+	for (unsigned int i = 0; i < pointCloudCube->getSize(); ++i) {
+		nearestNeigborFLANN->findNearestNeighbors(&(*pointCloudCube->getPointCloud())[i], &resultIndices, 2);
+		CPPUNIT_ASSERT_EQUAL(2, static_cast<int>(resultIndices.size()));
+		CPPUNIT_ASSERT_EQUAL(static_cast<int>(i), resultIndices[0]);
+	}
+}
+
 void NearestNeighborTest::testSTANNConstructor() {
 	CPPUNIT_ASSERT(nearestNeigborSTANN == 0);
 	nearestNeigborSTANN = new NearestNeighborSTANN();
@@ -675,6 +725,591 @@ void NearestNeighborTest::testANNHighDimension() {
 
 }
 
+void NearestNeighborTest::checkRadiusSearch(INearestPoint3DNeighbor* nearestNeighbor, INearestNeighborSetup* setup, bool isExact) {
+	vector<int> resultIndices;
+	vector<double> squaredDistances;
+	nearestNeighbor->setData(pointCloudCube);
+
+	/* k nearest neighbors with distances: 1 point at 0, 3 at 1, 3 at sqrt(2), 1 at sqrt(3) */
+	const double expectedSquaredDistances[] = {0, 1, 1, 1, 2, 2, 2, 3};
+	nearestNeighbor->findNearestNeighbors(point000, &resultIndices, &squaredDistances, 8);
+	CPPUNIT_ASSERT_EQUAL(8, static_cast<int>(resultIndices.size()));
+	CPPUNIT_ASSERT_EQUAL(8, static_cast<int>(squaredDistances.size()));
+	CPPUNIT_ASSERT_EQUAL(0, resultIndices[0]);
+	for (unsigned int i = 0; i < 8; ++i) {
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(expectedSquaredDistances[i], squaredDistances[i], maxTolerance);
+	}
+	setup->setMaxDistance(1.1); // distances are limited as for the search without distances
+	nearestNeighbor->findNearestNeighbors(point000, &resultIndices, &squaredDistances, 8);
+	CPPUNIT_ASSERT_EQUAL(4, static_cast<int>(resultIndices.size()));
+	CPPUNIT_ASSERT_EQUAL(4, static_cast<int>(squaredDistances.size()));
+
+	/* radius search; the maximum distance has no influence */
+	nearestNeighbor->findNeighborsWithinRadius(point000, 0.5, &resultIndices, &squaredDistances);
+	CPPUNIT_ASSERT_EQUAL(1, static_cast<int>(resultIndices.size()));
+	CPPUNIT_ASSERT_EQUAL(0, resultIndices[0]);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, squaredDistances[0], maxTolerance);
+	nearestNeighbor->findNeighborsWithinRadius(point000, 1.0, &resultIndices, &squaredDistances);
+	CPPUNIT_ASSERT_EQUAL(4, static_cast<int>(resultIndices.size()));
+	nearestNeighbor->findNeighborsWithinRadius(point000, 1.5, &resultIndices);
+	CPPUNIT_ASSERT_EQUAL(7, static_cast<int>(resultIndices.size()));
+	CPPUNIT_ASSERT(std::find(resultIndices.begin(), resultIndices.end(), 6) == resultIndices.end()); // point111 is too far away
+	nearestNeighbor->findNeighborsWithinRadius(point111, 1.8, &resultIndices, &squaredDistances);
+	CPPUNIT_ASSERT_EQUAL(8, static_cast<int>(resultIndices.size()));
+	CPPUNIT_ASSERT_EQUAL(8, static_cast<int>(squaredDistances.size()));
+	double sum = 0.0;
+	for (unsigned int i = 0; i < squaredDistances.size(); ++i) {
+		sum += squaredDistances[i];
+	}
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(12.0, sum, maxTolerance);
+	Point3D farAway(10, 10, 10);
+	nearestNeighbor->findNeighborsWithinRadius(&farAway, 1.0, &resultIndices, &squaredDistances);
+	CPPUNIT_ASSERT_EQUAL(0, static_cast<int>(resultIndices.size()));
+	CPPUNIT_ASSERT_EQUAL(0, static_cast<int>(squaredDistances.size()));
+	setup->setMaxDistance(-1);
+
+	/* compare against a brute force search on a random point cloud */
+	PointCloud3D randomPointCloud;
+	std::srand(0);
+	for (int i = 0; i < 2000; ++i) {
+		randomPointCloud.addPoint(Point3D(std::rand() / (RAND_MAX + 1.0), std::rand() / (RAND_MAX + 1.0), std::rand() / (RAND_MAX + 1.0)));
+	}
+	nearestNeighbor->setData(&randomPointCloud);
+	const double radius = 0.1;
+	unsigned int numberOfFound = 0;
+	unsigned int numberOfExpected = 0;
+	for (unsigned int i = 0; i < randomPointCloud.getSize(); i += 37) {
+		Point3D* query = &(*randomPointCloud.getPointCloud())[i];
+		nearestNeighbor->findNeighborsWithinRadius(query, radius, &resultIndices, &squaredDistances);
+		CPPUNIT_ASSERT_EQUAL(resultIndices.size(), squaredDistances.size());
+		for (unsigned int j = 0; j < resultIndices.size(); ++j) {
+			Point3D* neighbor = &(*randomPointCloud.getPointCloud())[resultIndices[j]];
+			double dx = neighbor->getX() - query->getX();
+			double dy = neighbor->getY() - query->getY();
+			double dz = neighbor->getZ() - query->getZ();
+			CPPUNIT_ASSERT_DOUBLES_EQUAL(dx * dx + dy * dy + dz * dz, squaredDistances[j], maxTolerance);
+			CPPUNIT_ASSERT(squaredDistances[j] <= radius * radius + maxTolerance);
+		}
+		numberOfFound += static_cast<unsigned int>(resultIndices.size());
+
+		unsigned int expected = 0;
+		for (unsigned int j = 0; j < randomPointCloud.getSize(); ++j) {
+			Point3D* point = &(*randomPointCloud.getPointCloud())[j];
+			double dx = point->getX() - query->getX();
+			double dy = point->getY() - query->getY();
+			double dz = point->getZ() - query->getZ();
+			expected += (dx * dx + dy * dy + dz * dz <= radius * radius) ? 1 : 0;
+		}
+		numberOfExpected += expected;
+		if (isExact) {
+			CPPUNIT_ASSERT_EQUAL(expected, static_cast<unsigned int>(resultIndices.size()));
+		}
+	}
+	CPPUNIT_ASSERT(numberOfFound >= 0.9 * numberOfExpected);
+}
+
+void NearestNeighborTest::testANNRadiusSearch() {
+	nearestNeigborANN = new NearestNeighborANN();
+	checkRadiusSearch(nearestNeigborANN, nearestNeigborANN, true);
+
+	/* generic interface */
+	vector< vector<double> > data;
+	for (unsigned int i = 0; i < pointCloudCube->getSize(); ++i) {
+		vector<double> row(3);
+		row[0] = (*pointCloudCube->getPointCloud())[i].getX();
+		row[1] = (*pointCloudCube->getPointCloud())[i].getY();
+		row[2] = (*pointCloudCube->getPointCloud())[i].getZ();
+		data.push_back(row);
+	}
+	nearestNeigborANN->setData(&data);
+	vector<int> resultIndices;
+	vector<double> squaredDistances;
+	nearestNeigborANN->findNeighborsWithinRadius(&data[6], 1.0, &resultIndices, &squaredDistances);
+	CPPUNIT_ASSERT_EQUAL(4, static_cast<int>(resultIndices.size()));
+	nearestNeigborANN->findNearestNeighbors(&data[6], &resultIndices, &squaredDistances, 2);
+	CPPUNIT_ASSERT_EQUAL(6, resultIndices[0]);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, squaredDistances[1], maxTolerance);
+}
+
+void NearestNeighborTest::testFLANNRadiusSearch() {
+	nearestNeigborFLANN = new NearestNeighborFLANN();
+	checkRadiusSearch(nearestNeigborFLANN, nearestNeigborFLANN, true);
+}
+
+void NearestNeighborTest::testSTANNRadiusSearch() {
+	nearestNeigborSTANN = new NearestNeighborSTANN();
+	checkRadiusSearch(nearestNeigborSTANN, nearestNeigborSTANN, false); // STANN might be approximate
+}
+
+void NearestNeighborTest::compareBatchWithSingleQueries(INearestPoint3DNeighbor* nearestNeighbor, PointCloud3D* queries, const vector<int>& queryIndices,
+		const NearestNeighborBatchResult& result, unsigned int k) {
+	vector<int> resultIndices;
+	vector<double> squaredDistances;
+	CPPUNIT_ASSERT_EQUAL(static_cast<unsigned int>(queryIndices.size()), result.getNumberOfQueries());
+	CPPUNIT_ASSERT_EQUAL(result.indices.size(), result.squaredDistances.size());
+	CPPUNIT_ASSERT_EQUAL(static_cast<unsigned int>(result.indices.size()), result.offsets.back());
+	for (unsigned int i = 0; i < queryIndices.size(); ++i) {
+		nearestNeighbor->findNearestNeighbors(&(*queries->getPointCloud())[queryIndices[i]], &resultIndices, &squaredDistances, k);
+		CPPUNIT_ASSERT_EQUAL(static_cast<unsigned int>(resultIndices.size()), result.getNumberOfNeighbors(i));
+		for (unsigned int j = 0; j < resultIndices.size(); ++j) {
+			CPPUNIT_ASSERT_EQUAL(resultIndices[j], result.getIndices(i)[j]);
+			CPPUNIT_ASSERT_DOUBLES_EQUAL(squaredDistances[j], result.getSquaredDistances(i)[j], maxTolerance);
+		}
+	}
+}
+
+void NearestNeighborTest::checkExactAgainstBruteForce(INearestPoint3DNeighbor* nearestNeighbor, PointCloud3D* pointCloud, double farOffset, double tolerance) {
+	const unsigned int k = 7;
+	vector<int> resultIndices;
+	vector<double> squaredDistances;
+	vector<double> bruteForceDistances(pointCloud->getSize());
+	for (unsigned int i = 0; i < pointCloud->getSize(); i += 29) {
+		double offset = (i % 4 == 0) ? farOffset : 0.01;
+		Point3D query((*pointCloud->getPointCloud())[i].getX() + offset, (*pointCloud->getPointCloud())[i].getY(), (*pointCloud->getPointCloud())[i].getZ());
+		for (unsigned int j = 0; j < pointCloud->getSize(); ++j) {
+			Point3D* point = &(*pointCloud->getPointCloud())[j];
+			double dx = point->getX() - query.getX();
+			double dy = point->getY() - query.getY();
+			double dz = point->getZ() - query.getZ();
+			bruteForceDistances[j] = dx * dx + dy * dy + dz * dz;
+		}
+		std::sort(bruteForceDistances.begin(), bruteForceDistances.end());
+
+		nearestNeighbor->findNearestNeighbors(&query, &resultIndices, &squaredDistances, k);
+		CPPUNIT_ASSERT_EQUAL(k, static_cast<unsigned int>(resultIndices.size()));
+		for (unsigned int j = 0; j < k; ++j) {
+			CPPUNIT_ASSERT_DOUBLES_EQUAL(bruteForceDistances[j], squaredDistances[j], tolerance);
+		}
+
+		unsigned int expected = static_cast<unsigned int>(std::upper_bound(bruteForceDistances.begin(), bruteForceDistances.end(), 0.01) - bruteForceDistances.begin());
+		nearestNeighbor->findNeighborsWithinRadius(&query, 0.1, &resultIndices);
+		CPPUNIT_ASSERT_EQUAL(expected, static_cast<unsigned int>(resultIndices.size()));
+	}
+}
+
+void NearestNeighborTest::checkBatchQueries(INearestPoint3DNeighbor* nearestNeighbor, INearestNeighborSetup* setup) {
+	PointCloud3D data;
+	PointCloud3D queries;
+	std::srand(0);
+	for (int i = 0; i < 3000; ++i) {
+		data.addPoint(Point3D(std::rand() / (RAND_MAX + 1.0), std::rand() / (RAND_MAX + 1.0), std::rand() / (RAND_MAX + 1.0)));
+	}
+	for (int i = 0; i < 1500; ++i) { // more than NearestNeighborBatchQuery::parallelThreshold
+		queries.addPoint(Point3D(std::rand() / (RAND_MAX + 1.0), std::rand() / (RAND_MAX + 1.0), std::rand() / (RAND_MAX + 1.0)));
+	}
+	nearestNeighbor->setData(&data);
+	vector<int> allIndices(queries.getSize());
+	for (unsigned int i = 0; i < allIndices.size(); ++i) {
+		allIndices[i] = i;
+	}
+
+	/* whole query cloud */
+	NearestNeighborBatchResult result;
+	const unsigned int k = 5;
+	nearestNeighbor->findNearestNeighbors(&queries, &result, k);
+	CPPUNIT_ASSERT_EQUAL(static_cast<unsigned int>(queries.getSize() * k), static_cast<unsigned int>(result.indices.size()));
+	compareBatchWithSingleQueries(nearestNeighbor, &queries, allIndices, result, k);
+	setup->setMaxNumberOfThreads(2);
+	nearestNeighbor->findNearestNeighbors(&queries, &result, k); // the result is reused
+	compareBatchWithSingleQueries(nearestNeighbor, &queries, allIndices, result, k);
+	setup->setMaxNumberOfThreads(0);
+
+	/* subset of the queries in arbitrary order */
+	vector<int> queryIndices;
+	for (int i = static_cast<int>(queries.getSize()) - 1; i >= 0; i -= 3) {
+		queryIndices.push_back(i);
+	}
+	nearestNeighbor->findNearestNeighbors(&queries, queryIndices, &result, k);
+	compareBatchWithSingleQueries(nearestNeighbor, &queries, queryIndices, result, k);
+
+	/* varying number of neighbors per query */
+	setup->setMaxDistance(0.06);
+	nearestNeighbor->findNearestNeighbors(&queries, &result, k);
+	CPPUNIT_ASSERT(result.indices.size() < queries.getSize() * k);
+	CPPUNIT_ASSERT(result.indices.size() > 0);
+	compareBatchWithSingleQueries(nearestNeighbor, &queries, allIndices, result, k);
+	setup->setMaxDistance(-1);
+
+	/* the data points themselves: the nearest neighbor is the point itself */
+	nearestNeighbor->findNearestNeighbors(&data, &result, 1);
+	CPPUNIT_ASSERT_EQUAL(data.getSize(), result.getNumberOfQueries());
+	for (unsigned int i = 0; i < data.getSize(); ++i) {
+		CPPUNIT_ASSERT_EQUAL(1u, result.getNumberOfNeighbors(i));
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, result.getSquaredDistances(i)[0], maxTolerance);
+	}
+
+	/* corner cases */
+	nearestNeighbor->findNearestNeighbors(&queries, &result, 0);
+	CPPUNIT_ASSERT_EQUAL(queries.getSize(), result.getNumberOfQueries());
+	CPPUNIT_ASSERT_EQUAL(0u, result.getNumberOfNeighbors(0));
+	CPPUNIT_ASSERT(result.indices.empty());
+	PointCloud3D emptyQueries;
+	nearestNeighbor->findNearestNeighbors(&emptyQueries, &result, k);
+	CPPUNIT_ASSERT_EQUAL(0u, result.getNumberOfQueries());
+	CPPUNIT_ASSERT(result.indices.empty());
+
+	queryIndices.push_back(static_cast<int>(queries.getSize()));
+	bool exceptionThrown = false;
+	try {
+		nearestNeighbor->findNearestNeighbors(&queries, queryIndices, &result, k);
+	} catch (runtime_error &e) {
+		exceptionThrown = true;
+	}
+	CPPUNIT_ASSERT(exceptionThrown);
+	exceptionThrown = false;
+	try {
+		nearestNeighbor->findNearestNeighbors(&queries, &result, data.getSize() + 1);
+	} catch (runtime_error &e) {
+		exceptionThrown = true;
+	}
+	CPPUNIT_ASSERT(exceptionThrown);
+}
+
+void NearestNeighborTest::testANNBatchQueries() {
+	nearestNeigborANN = new NearestNeighborANN();
+	checkBatchQueries(nearestNeigborANN, nearestNeigborANN);
+}
+
+void NearestNeighborTest::testFLANNBatchQueries() {
+	nearestNeigborFLANN = new NearestNeighborFLANN();
+	checkBatchQueries(nearestNeigborFLANN, nearestNeigborFLANN);
+}
+
+void NearestNeighborTest::testSTANNBatchQueries() {
+	nearestNeigborSTANN = new NearestNeighborSTANN();
+	checkBatchQueries(nearestNeigborSTANN, nearestNeigborSTANN);
+}
+
+void NearestNeighborTest::testKDTreeSimple() {
+	NearestNeighborKDTree nearestNeighborKDTree;
+	CPPUNIT_ASSERT_EQUAL(-1, nearestNeighborKDTree.getDimension());
+	vector<int> resultIndices;
+	bool exceptionThrown = false;
+	try {
+		nearestNeighborKDTree.findNearestNeighbors(point000, &resultIndices);
+	} catch (runtime_error &e) { // no data
+		exceptionThrown = true;
+	}
+	CPPUNIT_ASSERT(exceptionThrown);
+
+	nearestNeighborKDTree.setData(pointCloudCube);
+	CPPUNIT_ASSERT_EQUAL(3, nearestNeighborKDTree.getDimension());
+	for (unsigned int i = 0;  i < pointCloudCube->getSize(); ++ i) {
+		nearestNeighborKDTree.findNearestNeighbors(&(*pointCloudCube->getPointCloud())[i], &resultIndices);
+		CPPUNIT_ASSERT_EQUAL(1, static_cast<int>(resultIndices.size()));
+		CPPUNIT_ASSERT_EQUAL(static_cast<int>(i), resultIndices[0]); // must find the same (index)
+	}
+
+	Point3D query(0.6, 0.1, 0.9);
+	nearestNeighborKDTree.findNearestNeighbors(&query, &resultIndices, 2);
+	CPPUNIT_ASSERT_EQUAL(2, static_cast<int>(resultIndices.size()));
+	CPPUNIT_ASSERT_EQUAL(5, resultIndices[0]); // point101
+	nearestNeighborKDTree.setMaxDistance(0.5);
+	nearestNeighborKDTree.findNearestNeighbors(&query, &resultIndices, 2);
+	CPPUNIT_ASSERT_EQUAL(1, static_cast<int>(resultIndices.size()));
+
+	exceptionThrown = false;
+	try {
+		nearestNeighborKDTree.findNearestNeighbors(&query, &resultIndices, 9);
+	} catch (runtime_error &e) {
+		exceptionThrown = true;
+	}
+	CPPUNIT_ASSERT(exceptionThrown);
+}
+
+void NearestNeighborTest::testKDTreeExact() {
+	/* compare against a brute force search, including duplicates and points on a plane */
+	PointCloud3D randomPointCloud;
+	std::srand(0);
+	for (int i = 0; i < 3000; ++i) {
+		randomPointCloud.addPoint(Point3D(std::rand() / (RAND_MAX + 1.0), std::rand() / (RAND_MAX + 1.0), std::rand() / (RAND_MAX + 1.0)));
+	}
+	for (int i = 0; i < 200; ++i) {
+		randomPointCloud.addPoint(Point3D(0.5, 0.5, 0.5));
+		randomPointCloud.addPoint(Point3D(std::rand() / (RAND_MAX + 1.0), std::rand() / (RAND_MAX + 1.0), 0.25));
+	}
+	PointCloud3DContiguous contiguousPointCloud;
+	contiguousPointCloud.copyFrom(&randomPointCloud);
+	PointCloud3DContiguousFloat contiguousFloatPointCloud;
+	contiguousFloatPointCloud.copyFrom(&randomPointCloud);
+
+	const unsigned int leafSizes[] = {1, 10, 100, 5000};
+	for (unsigned int variant = 0; variant < 6; ++variant) {
+		NearestNeighborKDTree nearestNeighborKDTree(leafSizes[variant % 4]);
+		if (variant == 4) {
+			nearestNeighborKDTree.setData(&contiguousPointCloud);
+		} else if (variant == 5) {
+			nearestNeighborKDTree.setData(&contiguousFloatPointCloud);
+		} else {
+			nearestNeighborKDTree.setData(&randomPointCloud);
+		}
+
+		checkExactAgainstBruteForce(&nearestNeighborKDTree, &randomPointCloud, 0.01, (variant == 5) ? 1e-6 : maxTolerance);
+	}
+
+	/* all points at the same position */
+	vector<int> resultIndices;
+	PointCloud3D duplicates;
+	for (int i = 0; i < 100; ++i) {
+		duplicates.addPoint(Point3D(1, 2, 3));
+	}
+	NearestNeighborKDTree nearestNeighborKDTree(1);
+	nearestNeighborKDTree.setData(&duplicates);
+	nearestNeighborKDTree.findNearestNeighbors(point000, &resultIndices, 100);
+	CPPUNIT_ASSERT_EQUAL(100, static_cast<int>(resultIndices.size()));
+	std::sort(resultIndices.begin(), resultIndices.end());
+	for (int i = 0; i < 100; ++i) {
+		CPPUNIT_ASSERT_EQUAL(i, resultIndices[i]);
+	}
+}
+
+void NearestNeighborTest::testKDTreeRadiusSearch() {
+	NearestNeighborKDTree nearestNeighborKDTree;
+	checkRadiusSearch(&nearestNeighborKDTree, &nearestNeighborKDTree, true);
+}
+
+void NearestNeighborTest::testKDTreeBatchQueries() {
+	NearestNeighborKDTree nearestNeighborKDTree;
+	checkBatchQueries(&nearestNeighborKDTree, &nearestNeighborKDTree);
+}
+
+void NearestNeighborTest::testDynamicKDTreeInsertion() {
+	/* insert points one by one and in blocks; the results must match a brute force search over all points so far */
+	NearestNeighborDynamicKDTree nearestNeighborDynamicKDTree(4, 16);
+	CPPUNIT_ASSERT_EQUAL(0u, nearestNeighborDynamicKDTree.getSize());
+	vector<Point3D> points;
+	std::srand(0);
+	const unsigned int k = 5;
+	vector<int> resultIndices;
+	vector<double> squaredDistances;
+	for (int step = 0; step < 40; ++step) {
+		if (step % 3 == 0) {
+			PointCloud3D block;
+			for (int i = 0; i < 70; ++i) {
+				block.addPoint(Point3D(std::rand() / (RAND_MAX + 1.0), std::rand() / (RAND_MAX + 1.0), std::rand() / (RAND_MAX + 1.0)));
+			}
+			int firstId = nearestNeighborDynamicKDTree.insertPoints(&block);
+			CPPUNIT_ASSERT_EQUAL(static_cast<int>(points.size()), firstId);
+			for (unsigned int i = 0; i < block.getSize(); ++i) {
+				points.push_back((*block.getPointCloud())[i]);
+			}
+		} else {
+			for (int i = 0; i < 11; ++i) {
+				Point3D point(std::rand() / (RAND_MAX + 1.0), std::rand() / (RAND_MAX + 1.0), std::rand() / (RAND_MAX + 1.0));
+				CPPUNIT_ASSERT_EQUAL(static_cast<int>(points.size()), nearestNeighborDynamicKDTree.insertPoint(point));
+				points.push_back(point);
+			}
+		}
+		CPPUNIT_ASSERT_EQUAL(static_cast<unsigned int>(points.size()), nearestNeighborDynamicKDTree.getSize());
+
+		Point3D query(std::rand() / (RAND_MAX + 1.0), std::rand() / (RAND_MAX + 1.0), std::rand() / (RAND_MAX + 1.0));
+		vector<std::pair<double, int> > bruteForce;
+		for (unsigned int i = 0; i < points.size(); ++i) {
+			double dx = points[i].getX() - query.getX();
+			double dy = points[i].getY() - query.getY();
+			double dz = points[i].getZ() - query.getZ();
+			bruteForce.push_back(std::make_pair(dx * dx + dy * dy + dz * dz, static_cast<int>(i)));
+		}
+		std::sort(bruteForce.begin(), bruteForce.end());
+
+		nearestNeighborDynamicKDTree.findNearestNeighbors(&query, &resultIndices, &squaredDistances, k);
+		CPPUNIT_ASSERT_EQUAL(k, static_cast<unsigned int>(resultIndices.size()));
+		for (unsigned int j = 0; j < k; ++j) {
+			CPPUNIT_ASSERT_EQUAL(bruteForce[j].second, resultIndices[j]);
+			CPPUNIT_ASSERT_DOUBLES_EQUAL(bruteForce[j].first, squaredDistances[j], maxTolerance);
+		}
+	}
+
+	/* the forest stays logarithmic: at most one tree per level, 1266 points need the levels 0 to 7 with a buffer of 16 */
+	CPPUNIT_ASSERT(nearestNeighborDynamicKDTree.getNumberOfTrees() <= 8);
+
+	/* setData starts over, the ids are the indices into the point cloud */
+	nearestNeighborDynamicKDTree.setData(pointCloudCube);
+	CPPUNIT_ASSERT_EQUAL(pointCloudCube->getSize(), nearestNeighborDynamicKDTree.getSize());
+	nearestNeighborDynamicKDTree.findNearestNeighbors(point111, &resultIndices, 1);
+	CPPUNIT_ASSERT_EQUAL(1u, static_cast<unsigned int>(resultIndices.size()));
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, (*pointCloudCube->getPointCloud())[resultIndices[0]].getX(), maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, (*pointCloudCube->getPointCloud())[resultIndices[0]].getY(), maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, (*pointCloudCube->getPointCloud())[resultIndices[0]].getZ(), maxTolerance);
+
+	nearestNeighborDynamicKDTree.clear();
+	CPPUNIT_ASSERT_EQUAL(0u, nearestNeighborDynamicKDTree.getSize());
+	CPPUNIT_ASSERT_THROW(nearestNeighborDynamicKDTree.findNearestNeighbors(point000, &resultIndices, 1), std::runtime_error);
+}
+
+void NearestNeighborTest::testDynamicKDTreeBoxRemoval() {
+	/* a grid of 20^3 points with ids x + 20 * y + 400 * z */
+	PointCloud3D grid;
+	for (int z = 0; z < 20; ++z) {
+		for (int y = 0; y < 20; ++y) {
+			for (int x = 0; x < 20; ++x) {
+				grid.addPoint(Point3D(x, y, z));
+			}
+		}
+	}
+	NearestNeighborDynamicKDTree nearestNeighborDynamicKDTree(8, 32);
+	nearestNeighborDynamicKDTree.setData(&grid);
+	vector<unsigned char> isRemoved(grid.getSize(), 0);
+
+	/* remove boxes of growing size, the tree is rebuilt once most of its points are gone */
+	std::srand(1);
+	vector<int> resultIndices;
+	vector<double> squaredDistances;
+	for (int step = 0; step < 12; ++step) {
+		int minimum[3];
+		int maximum[3];
+		for (int axis = 0; axis < 3; ++axis) {
+			minimum[axis] = std::rand() % 20;
+			maximum[axis] = std::min(19, minimum[axis] + 2 + step);
+		}
+		unsigned int expectedCount = 0;
+		for (int z = minimum[2]; z <= maximum[2]; ++z) {
+			for (int y = minimum[1]; y <= maximum[1]; ++y) {
+				for (int x = minimum[0]; x <= maximum[0]; ++x) {
+					int id = x + 20 * y + 400 * z;
+					if (isRemoved[id] == 0) {
+						isRemoved[id] = 1;
+						expectedCount++;
+					}
+				}
+			}
+		}
+		unsigned int removedCount = nearestNeighborDynamicKDTree.removePointsInBox(Point3D(minimum[0], minimum[1], minimum[2]), Point3D(maximum[0], maximum[1], maximum[2]));
+		CPPUNIT_ASSERT_EQUAL(expectedCount, removedCount);
+
+		/* interleave new points; their ids continue after the grid */
+		Point3D newPoint(minimum[0] + 0.5, minimum[1] + 0.5, minimum[2] + 0.5);
+		int newId = nearestNeighborDynamicKDTree.insertPoint(newPoint);
+		CPPUNIT_ASSERT_EQUAL(static_cast<int>(grid.getSize()) + step, newId);
+		nearestNeighborDynamicKDTree.findNearestNeighbors(&newPoint, &resultIndices, 1);
+		CPPUNIT_ASSERT_EQUAL(newId, resultIndices[0]);
+		nearestNeighborDynamicKDTree.removePointsInBox(newPoint, newPoint);
+
+		/* no query returns a removed point */
+		for (int i = 0; i < 50; ++i) {
+			Point3D query(std::rand() % 20, std::rand() % 20, std::rand() % 20);
+			nearestNeighborDynamicKDTree.findNearestNeighbors(&query, &resultIndices, &squaredDistances, 3);
+			CPPUNIT_ASSERT_EQUAL(3u, static_cast<unsigned int>(resultIndices.size()));
+			for (unsigned int j = 0; j < resultIndices.size(); ++j) {
+				CPPUNIT_ASSERT(resultIndices[j] < static_cast<int>(grid.getSize()));
+				CPPUNIT_ASSERT_EQUAL(0, static_cast<int>(isRemoved[resultIndices[j]]));
+			}
+
+			/* the nearest remaining grid point by brute force */
+			double bruteForceDistance = std::numeric_limits<double>::max();
+			for (unsigned int id = 0; id < grid.getSize(); ++id) {
+				if (isRemoved[id] == 0) {
+					Point3D* point = &(*grid.getPointCloud())[id];
+					double dx = point->getX() - query.getX();
+					double dy = point->getY() - query.getY();
+					double dz = point->getZ() - query.getZ();
+					bruteForceDistance = std::min(bruteForceDistance, dx * dx + dy * dy + dz * dz);
+				}
+			}
+			CPPUNIT_ASSERT_DOUBLES_EQUAL(bruteForceDistance, squaredDistances[0], maxTolerance);
+
+			nearestNeighborDynamicKDTree.findNeighborsWithinRadius(&query, 1.5, &resultIndices);
+			for (unsigned int j = 0; j < resultIndices.size(); ++j) {
+				CPPUNIT_ASSERT_EQUAL(0, static_cast<int>(isRemoved[resultIndices[j]]));
+			}
+		}
+	}
+
+	unsigned int remaining = 0;
+	for (unsigned int id = 0; id < isRemoved.size(); ++id) {
+		remaining += (isRemoved[id] == 0) ? 1 : 0;
+	}
+	CPPUNIT_ASSERT_EQUAL(remaining, nearestNeighborDynamicKDTree.getSize());
+
+	/* removing everything leaves an empty forest */
+	nearestNeighborDynamicKDTree.removePointsInBox(Point3D(-1, -1, -1), Point3D(20, 20, 20));
+	CPPUNIT_ASSERT_EQUAL(0u, nearestNeighborDynamicKDTree.getSize());
+	CPPUNIT_ASSERT_EQUAL(0u, nearestNeighborDynamicKDTree.getNumberOfTrees());
+}
+
+void NearestNeighborTest::testDynamicKDTreeRadiusSearch() {
+	NearestNeighborDynamicKDTree nearestNeighborDynamicKDTree;
+	checkRadiusSearch(&nearestNeighborDynamicKDTree, &nearestNeighborDynamicKDTree, true);
+}
+
+void NearestNeighborTest::testDynamicKDTreeBatchQueries() {
+	NearestNeighborDynamicKDTree nearestNeighborDynamicKDTree;
+	checkBatchQueries(&nearestNeighborDynamicKDTree, &nearestNeighborDynamicKDTree);
+}
+
+void NearestNeighborTest::testVoxelHashExact() {
+	/* compare against a brute force search for cells that are much smaller, about as big and much bigger than the neighborhoods */
+	PointCloud3D randomPointCloud;
+	std::srand(0);
+	for (int i = 0; i < 3000; ++i) {
+		randomPointCloud.addPoint(Point3D(std::rand() / (RAND_MAX + 1.0) - 0.5, std::rand() / (RAND_MAX + 1.0) - 0.5, std::rand() / (RAND_MAX + 1.0) - 0.5));
+	}
+	for (int i = 0; i < 200; ++i) {
+		randomPointCloud.addPoint(Point3D(0.25, 0.25, 0.25));
+	}
+	PointCloud3DContiguous contiguousPointCloud;
+	contiguousPointCloud.copyFrom(&randomPointCloud);
+
+	const double cellSizes[] = {0.005, 0.05, 0.1, 10.0};
+	for (unsigned int variant = 0; variant < 5; ++variant) {
+		NearestNeighborVoxelHash nearestNeighborVoxelHash(cellSizes[variant % 4]);
+		if (variant == 4) {
+			nearestNeighborVoxelHash.setData(&contiguousPointCloud);
+		} else {
+			nearestNeighborVoxelHash.setData(&randomPointCloud);
+		}
+		CPPUNIT_ASSERT(nearestNeighborVoxelHash.getNumberOfCells() > 0);
+
+		checkExactAgainstBruteForce(&nearestNeighborVoxelHash, &randomPointCloud, 1.0, maxTolerance); // every fourth query lies outside of the data
+	}
+
+	/* all points in one cell */
+	NearestNeighborVoxelHash nearestNeighborVoxelHash(0.1);
+	vector<int> resultIndices;
+	PointCloud3D duplicates;
+	for (int i = 0; i < 100; ++i) {
+		duplicates.addPoint(Point3D(1, 2, 3));
+	}
+	nearestNeighborVoxelHash.setData(&duplicates);
+	CPPUNIT_ASSERT_EQUAL(1u, nearestNeighborVoxelHash.getNumberOfCells());
+	nearestNeighborVoxelHash.findNearestNeighbors(point000, &resultIndices, 100);
+	CPPUNIT_ASSERT_EQUAL(100, static_cast<int>(resultIndices.size()));
+	std::sort(resultIndices.begin(), resultIndices.end());
+	for (int i = 0; i < 100; ++i) {
+		CPPUNIT_ASSERT_EQUAL(i, resultIndices[i]);
+	}
+
+	/* queries beyond the representable cells are clamped to the border of the grid */
+	PointCloud3D farPoints;
+	farPoints.addPoint(Point3D(2.5e8, 0, 0));
+	farPoints.addPoint(Point3D(-2.5e8, 0, 0));
+	NearestNeighborVoxelHash coarseCells(1.0);
+	coarseCells.setData(&farPoints);
+	Point3D farQuery(1e12, 0, 0);
+	coarseCells.findNearestNeighbors(&farQuery, &resultIndices, 2);
+	CPPUNIT_ASSERT_EQUAL(2, static_cast<int>(resultIndices.size()));
+	CPPUNIT_ASSERT_EQUAL(0, resultIndices[0]);
+	farQuery.setX(-1e12);
+	coarseCells.findNeighborsWithinRadius(&farQuery, 1e12 - 2e8, &resultIndices);
+	CPPUNIT_ASSERT_EQUAL(1, static_cast<int>(resultIndices.size()));
+	CPPUNIT_ASSERT_EQUAL(1, resultIndices[0]);
+
+	CPPUNIT_ASSERT_THROW(nearestNeighborVoxelHash.setCellSize(0.0), std::runtime_error);
+	NearestNeighborVoxelHash tinyCells(1e-12);
+	CPPUNIT_ASSERT_THROW(tinyCells.setData(&duplicates), std::runtime_error);
+	CPPUNIT_ASSERT_THROW(tinyCells.findNearestNeighbors(point000, &resultIndices, 1), std::runtime_error);
+}
+
+void NearestNeighborTest::testVoxelHashRadiusSearch() {
+	NearestNeighborVoxelHash nearestNeighborVoxelHash(0.5);
+	checkRadiusSearch(&nearestNeighborVoxelHash, &nearestNeighborVoxelHash, true);
+}
+
+void NearestNeighborTest::testVoxelHashBatchQueries() {
+	NearestNeighborVoxelHash nearestNeighborVoxelHash(0.1);
+	checkBatchQueries(&nearestNeighborVoxelHash, &nearestNeighborVoxelHash);
+}
+
 }
 
 /* EOF */
@@ -15,6 +15,9 @@
 #include "brics_3d/algorithm/nearestNeighbor/NearestNeighborFLANN.h"
 #include "brics_3d/algorithm/nearestNeighbor/NearestNeighborSTANN.h"
 #include "brics_3d/algorithm/nearestNeighbor/NearestNeighborANN.h"
+#include "brics_3d/algorithm/nearestNeighbor/NearestNeighborKDTree.h"
+#include "brics_3d/algorithm/nearestNeighbor/NearestNeighborDynamicKDTree.h"
+#include "brics_3d/algorithm/nearestNeighbor/NearestNeighborVoxelHash.h"
 #include "brics_3d/core/HomogeneousMatrix44.h"
 #include <Eigen/Geometry>
 
@@ -31,6 +34,7 @@ class NearestNeighborTest : public CPPUNIT_NS::TestFixture {
 	CPPUNIT_TEST( testFLANNSimple );
 	CPPUNIT_TEST( testFLANNExtended );
 	CPPUNIT_TEST( testFLANNHighDimension );
+	CPPUNIT_TEST( testFLANNSinglePrecision );
 	CPPUNIT_TEST( testSTANNConstructor );
 	CPPUNIT_TEST( testSTANNSimple );
 	CPPUNIT_TEST( testSTANNExtended );
@@ -39,6 +43,23 @@ class NearestNeighborTest : public CPPUNIT_NS::TestFixture {
 	CPPUNIT_TEST( testANNSimple );
 	CPPUNIT_TEST( testANNExtended );
 	CPPUNIT_TEST( testANNHighDimension );
+	CPPUNIT_TEST( testANNRadiusSearch );
+	CPPUNIT_TEST( testFLANNRadiusSearch );
+	CPPUNIT_TEST( testSTANNRadiusSearch );
+	CPPUNIT_TEST( testANNBatchQueries );
+	CPPUNIT_TEST( testFLANNBatchQueries );
+	CPPUNIT_TEST( testSTANNBatchQueries );
+	CPPUNIT_TEST( testKDTreeSimple );
+	CPPUNIT_TEST( testKDTreeExact );
+	CPPUNIT_TEST( testKDTreeRadiusSearch );
+	CPPUNIT_TEST( testKDTreeBatchQueries );
+	CPPUNIT_TEST( testDynamicKDTreeInsertion );
+	CPPUNIT_TEST( testDynamicKDTreeBoxRemoval );
+	CPPUNIT_TEST( testDynamicKDTreeRadiusSearch );
+	CPPUNIT_TEST( testDynamicKDTreeBatchQueries );
+	CPPUNIT_TEST( testVoxelHashExact );
+	CPPUNIT_TEST( testVoxelHashRadiusSearch );
+	CPPUNIT_TEST( testVoxelHashBatchQueries );
 	CPPUNIT_TEST_SUITE_END();
 
 
@@ -50,6 +71,7 @@ public:
 	void testFLANNSimple();
 	void testFLANNExtended();
 	void testFLANNHighDimension();
+	void testFLANNSinglePrecision();
 	void testSTANNConstructor();
 	void testSTANNSimple();
 	void testSTANNExtended();
@@ -58,9 +80,42 @@ public:
 	void testANNSimple();
 	void testANNExtended();
 	void testANNHighDimension();
+	void testANNRadiusSearch();
+	void testFLANNRadiusSearch();
+	void testSTANNRadiusSearch();
+	void testANNBatchQueries();
+	void testFLANNBatchQueries();
+	void testSTANNBatchQueries();
+	void testKDTreeSimple();
+	void testKDTreeExact();
+	void testKDTreeRadiusSearch();
+	void testKDTreeBatchQueries();
+	void testDynamicKDTreeInsertion();
+	void testDynamicKDTreeBoxRemoval();
+	void testDynamicKDTreeRadiusSearch();
+	void testDynamicKDTreeBatchQueries();
+	void testVoxelHashExact();
+	void testVoxelHashRadiusSearch();
+	void testVoxelHashBatchQueries();
 
 private:
 
+	/// Radius search and k nearest neighbors with distances on the cube and on a random point cloud.
+	void checkRadiusSearch(INearestPoint3DNeighbor* nearestNeighbor, INearestNeighborSetup* setup, bool isExact);
+
+	/**
+	 * Compare k nearest neighbors and radius search of queries close to every 29th point of pointCloud with a brute force search.
+	 * The data of nearestNeighbor has to be set to (a copy of) pointCloud. Every fourth query is moved by farOffset along x.
+	 */
+	void checkExactAgainstBruteForce(INearestPoint3DNeighbor* nearestNeighbor, PointCloud3D* pointCloud, double farOffset, double tolerance);
+
+	/// Batch queries have to yield the same neighbors as the single queries.
+	void checkBatchQueries(INearestPoint3DNeighbor* nearestNeighbor, INearestNeighborSetup* setup);
+
+	/// Compare the neighbors of every query of a batch with the single query of the same point.
+	void compareBatchWithSingleQueries(INearestPoint3DNeighbor* nearestNeighbor, PointCloud3D* queries, const vector<int>& queryIndices,
+			const NearestNeighborBatchResult& result, unsigned int k);
+
 	INearestNeighbor* abstractNearestNeigbor;
 	NearestNeighborFLANN* nearestNeigborFLANN;
 	NearestNeighborSTANN* nearestNeigborSTANN;
@@ -274,6 +274,56 @@ void OctreeTest::testPartition() {
 	delete octreeComponent;
 }
 
+void OctreeTest::testPartitionIndices() {
+	octreeComponent = new Octree();
+	std::vector<int> pointIndices;
+	std::vector<int> cellOffsets;
+
+	/* only one cell with default parameter 0.0 */
+	octreeComponent->partitionPointCloud(pointCloudCube, &pointIndices, &cellOffsets);
+	CPPUNIT_ASSERT_EQUAL(2, static_cast<int>(cellOffsets.size()));
+	CPPUNIT_ASSERT_EQUAL(0, cellOffsets[0]);
+	CPPUNIT_ASSERT_EQUAL(10, cellOffsets[1]);
+	CPPUNIT_ASSERT_EQUAL(10, static_cast<int>(pointIndices.size()));
+	CPPUNIT_ASSERT_EQUAL(4, pointIndices[4]);
+
+	/* same cells as the point cloud based version */
+	octreeComponent->setVoxelSize(0.1);
+	octreeComponent->partitionPointCloud(pointCloudCube, &pointIndices, &cellOffsets);
+	CPPUNIT_ASSERT_EQUAL(10, static_cast<int>(cellOffsets.size()));
+	CPPUNIT_ASSERT_EQUAL(10, cellOffsets.back());
+	CPPUNIT_ASSERT_EQUAL(10, static_cast<int>(pointIndices.size()));
+
+	vector<PointCloud3D*> partition;
+	octreeComponent->partitionPointCloud(pointCloudCube, &partition);
+	CPPUNIT_ASSERT_EQUAL(static_cast<int>(cellOffsets.size()) - 1, static_cast<int>(partition.size()));
+
+	std::vector<bool> visited(10, false);
+	for (unsigned int i = 0; i < partition.size(); ++i) {
+		CPPUNIT_ASSERT_EQUAL(static_cast<int>(partition[i]->getSize()), cellOffsets[i + 1] - cellOffsets[i]);
+		for (int j = cellOffsets[i]; j < cellOffsets[i + 1]; ++j) {
+			CPPUNIT_ASSERT(pointIndices[j] >= 0 && pointIndices[j] < 10);
+			CPPUNIT_ASSERT(!visited[pointIndices[j]]); // every point belongs to exactly one cell
+			visited[pointIndices[j]] = true;
+
+			Point3D* cellPoint = &(*partition[i]->getPointCloud())[j - cellOffsets[i]];
+			Point3D* originalPoint = &(*pointCloudCube->getPointCloud())[pointIndices[j]];
+			CPPUNIT_ASSERT_DOUBLES_EQUAL(originalPoint->getX(), cellPoint->getX(), maxTolerance);
+			CPPUNIT_ASSERT_DOUBLES_EQUAL(originalPoint->getY(), cellPoint->getY(), maxTolerance);
+			CPPUNIT_ASSERT_DOUBLES_EQUAL(originalPoint->getZ(), cellPoint->getZ(), maxTolerance);
+		}
+		delete partition[i];
+	}
+
+	/* empty input */
+	PointCloud3D emptyPointCloud;
+	octreeComponent->partitionPointCloud(&emptyPointCloud, &pointIndices, &cellOffsets);
+	CPPUNIT_ASSERT_EQUAL(1, static_cast<int>(cellOffsets.size()));
+	CPPUNIT_ASSERT_EQUAL(0, static_cast<int>(pointIndices.size()));
+
+	delete octreeComponent;
+}
+
 }
 
 /* EOF */
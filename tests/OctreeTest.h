@@ -29,6 +29,7 @@ class OctreeTest : public CPPUNIT_NS::TestFixture {
 	CPPUNIT_TEST( testSetupInterface );
 	CPPUNIT_TEST( testSizeReduction );
 	CPPUNIT_TEST( testPartition );
+	CPPUNIT_TEST( testPartitionIndices );
 	CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -39,6 +40,7 @@ public:
 	void testSetupInterface();
 	void testSizeReduction();
 	void testPartition();
+	void testPartitionIndices();
 
 private:
 
@@ -0,0 +1,172 @@
+/**
+ * @file 
+ * OutlierRemovalTest.cpp
+ *
+ * @date: Oct 17, 2026
+ * @author: sblume
+ */
+
+#include "OutlierRemovalTest.h"
+#include <stdexcept>
+
+namespace unitTests {
+
+CPPUNIT_TEST_SUITE_REGISTRATION( OutlierRemovalTest );
+
+void OutlierRemovalTest::setUp() {
+	pointCloud = new PointCloud3D();
+
+	/* 10x10x10 grid with a spacing of 0.1; outliers are placed in between */
+	for (int x = 0; x < 10; ++x) {
+		for (int y = 0; y < 10; ++y) {
+			for (int z = 0; z < 10; ++z) {
+				if (x == 5 && y == 5 && z == 5) {
+					pointCloud->addPoint(Point3D(5.0, 5.0, 5.0)); // outlier inside of the grid sequence
+				}
+				pointCloud->addPointPtr(new ColoredPoint3D(new Point3D(x * 0.1, y * 0.1, z * 0.1), x, y, z));
+			}
+		}
+	}
+	numberOfGridPoints = 1000;
+	pointCloud->addPoint(Point3D(-3.0, 0.0, 0.0));
+	pointCloud->addPoint(Point3D(0.0, 4.0, 0.0));
+	pointCloud->addPoint(Point3D(2.0, 2.0, -2.5));
+}
+
+void OutlierRemovalTest::tearDown() {
+	delete pointCloud;
+}
+
+void OutlierRemovalTest::checkInliers(PointCloud3D* result) {
+	CPPUNIT_ASSERT_EQUAL(numberOfGridPoints, result->getSize());
+	for (unsigned int i = 0; i < result->getSize(); ++i) {
+		ColoredPoint3D* point = (*result->getPointCloud())[i].asColoredPoint3D();
+		CPPUNIT_ASSERT(point != 0); // decorations are kept
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(point->getR() * 0.1, point->getX(), maxTolerance);
+	}
+	/* order of the input */
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, (*result->getPointCloud())[0].getZ(), maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.1, (*result->getPointCloud())[1].getZ(), maxTolerance);
+}
+
+void OutlierRemovalTest::testParameters() {
+	StatisticalOutlierRemoval statisticalFilter;
+	CPPUNIT_ASSERT_EQUAL(8u, statisticalFilter.getK());
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, statisticalFilter.getStandardDeviationMultiplier(), maxTolerance);
+	CPPUNIT_ASSERT(statisticalFilter.getNearestNeighborAlgorithm() != 0);
+	CPPUNIT_ASSERT_THROW(statisticalFilter.setK(0), std::runtime_error);
+	statisticalFilter.setK(4);
+	statisticalFilter.setStandardDeviationMultiplier(2.5);
+	CPPUNIT_ASSERT_EQUAL(4u, statisticalFilter.getK());
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(2.5, statisticalFilter.getStandardDeviationMultiplier(), maxTolerance);
+
+	RadiusOutlierRemoval radiusFilter(0.5, 3);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.5, radiusFilter.getRadius(), maxTolerance);
+	CPPUNIT_ASSERT_EQUAL(3u, radiusFilter.getMinNumberOfNeighbors());
+	CPPUNIT_ASSERT_THROW(radiusFilter.setRadius(0.0), std::runtime_error);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.5, radiusFilter.getRadius(), maxTolerance);
+
+	radiusFilter.setMaxNumberOfThreads(2);
+	CPPUNIT_ASSERT_EQUAL(2u, radiusFilter.getMaxNumberOfThreads());
+
+	/* only the STANN wrapper supports concurrent queries */
+	CPPUNIT_ASSERT(NearestNeighborSTANN().supportsConcurrentQueries());
+	CPPUNIT_ASSERT(!NearestNeighborANN().supportsConcurrentQueries());
+	CPPUNIT_ASSERT(!NearestNeighborFLANN().supportsConcurrentQueries());
+}
+
+void OutlierRemovalTest::testStatisticalOutlierRemoval() {
+	StatisticalOutlierRemoval filter(8, 1.0);
+	PointCloud3D result;
+	filter.filter(pointCloud, &result);
+	checkInliers(&result);
+	CPPUNIT_ASSERT(filter.getDistanceThreshold() > 0.1);
+
+	/* same with other search strategies */
+	filter.setNearestNeighborAlgorithm(new NearestNeighborFLANN());
+	result.getPointCloud()->clear();
+	filter.filter(pointCloud, &result);
+	checkInliers(&result);
+
+	/* STANN is approximate on the grid, but it has to find the outliers */
+	filter.setNearestNeighborAlgorithm(new NearestNeighborSTANN());
+	filter.setMaxNumberOfThreads(4);
+	result.getPointCloud()->clear();
+	filter.filter(pointCloud, &result);
+	CPPUNIT_ASSERT(result.getSize() <= numberOfGridPoints);
+	CPPUNIT_ASSERT(result.getSize() > numberOfGridPoints / 2);
+	for (unsigned int i = 0; i < result.getSize(); ++i) {
+		CPPUNIT_ASSERT((*result.getPointCloud())[i].asColoredPoint3D() != 0);
+	}
+}
+
+void OutlierRemovalTest::testRadiusOutlierRemoval() {
+	RadiusOutlierRemoval filter(0.15, 3);
+	PointCloud3D result;
+	filter.filter(pointCloud, &result);
+	checkInliers(&result);
+
+	/* corners of the grid have only 3 neighbors with a distance of 0.1 */
+	filter.setRadius(0.11);
+	filter.setMinNumberOfNeighbors(4);
+	result.getPointCloud()->clear();
+	filter.filter(pointCloud, &result);
+	CPPUNIT_ASSERT_EQUAL(numberOfGridPoints - 8, result.getSize());
+
+	filter.setNearestNeighborAlgorithm(new NearestNeighborFLANN());
+	filter.setRadius(0.15);
+	filter.setMinNumberOfNeighbors(3);
+	result.getPointCloud()->clear();
+	filter.filter(pointCloud, &result);
+	checkInliers(&result);
+
+	/* no neighbors needed: everything passes */
+	filter.setMinNumberOfNeighbors(0);
+	result.getPointCloud()->clear();
+	filter.filter(pointCloud, &result);
+	CPPUNIT_ASSERT_EQUAL(pointCloud->getSize(), result.getSize());
+
+	/* more points than one batch of queries: only the corners of a 30x30x30 grid are removed */
+	PointCloud3D largeGrid;
+	for (int x = 0; x < 30; ++x) {
+		for (int y = 0; y < 30; ++y) {
+			for (int z = 0; z < 30; ++z) {
+				largeGrid.addPoint(Point3D(x * 0.1, y * 0.1, z * 0.1));
+			}
+		}
+	}
+	filter.setNearestNeighborAlgorithm(new NearestNeighborANN());
+	filter.setRadius(0.11);
+	filter.setMinNumberOfNeighbors(4);
+	result.getPointCloud()->clear();
+	filter.filter(&largeGrid, &result);
+	CPPUNIT_ASSERT_EQUAL(largeGrid.getSize() - 8, result.getSize());
+}
+
+void OutlierRemovalTest::testSmallPointClouds() {
+	PointCloud3D smallPointCloud;
+	PointCloud3D result;
+	StatisticalOutlierRemoval statisticalFilter(8, 1.0);
+	RadiusOutlierRemoval radiusFilter(1.0, 2);
+
+	statisticalFilter.filter(&smallPointCloud, &result);
+	radiusFilter.filter(&smallPointCloud, &result);
+	CPPUNIT_ASSERT_EQUAL(0u, result.getSize());
+
+	/* less points than neighbors */
+	smallPointCloud.addPoint(Point3D(0.0, 0.0, 0.0));
+	smallPointCloud.addPoint(Point3D(0.5, 0.0, 0.0));
+	radiusFilter.filter(&smallPointCloud, &result);
+	CPPUNIT_ASSERT_EQUAL(0u, result.getSize());
+	statisticalFilter.filter(&smallPointCloud, &result);
+	CPPUNIT_ASSERT_EQUAL(2u, result.getSize());
+
+	smallPointCloud.addPoint(Point3D(0.0, 0.5, 0.0));
+	result.getPointCloud()->clear();
+	radiusFilter.filter(&smallPointCloud, &result);
+	CPPUNIT_ASSERT_EQUAL(3u, result.getSize());
+}
+
+}
+
+/* EOF */
@@ -0,0 +1,62 @@
+/**
+ * @file 
+ * OutlierRemovalTest.h
+ *
+ * @date: Oct 17, 2026
+ * @author: sblume
+ */
+
+#ifndef OUTLIERREMOVALTEST_H_
+#define OUTLIERREMOVALTEST_H_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "brics_3d/algorithm/filtering/StatisticalOutlierRemoval.h"
+#include "brics_3d/algorithm/filtering/RadiusOutlierRemoval.h"
+#include "brics_3d/algorithm/nearestNeighbor/NearestNeighborANN.h"
+#include "brics_3d/algorithm/nearestNeighbor/NearestNeighborFLANN.h"
+#include "brics_3d/algorithm/nearestNeighbor/NearestNeighborSTANN.h"
+#include "brics_3d/core/ColoredPoint3D.h"
+
+using namespace std;
+using namespace brics_3d;
+
+namespace unitTests {
+
+class OutlierRemovalTest : public CPPUNIT_NS::TestFixture {
+
+	CPPUNIT_TEST_SUITE( OutlierRemovalTest );
+	CPPUNIT_TEST( testParameters );
+	CPPUNIT_TEST( testStatisticalOutlierRemoval );
+	CPPUNIT_TEST( testRadiusOutlierRemoval );
+	CPPUNIT_TEST( testSmallPointClouds );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp();
+	void tearDown();
+
+	void testParameters();
+	void testStatisticalOutlierRemoval();
+	void testRadiusOutlierRemoval();
+	void testSmallPointClouds();
+
+private:
+
+	/// Check that exactly the grid points survived.
+	void checkInliers(PointCloud3D* result);
+
+	static const double maxTolerance = 0.00001;
+
+	/// Regular grid with some isolated outliers.
+	PointCloud3D* pointCloud;
+
+	unsigned int numberOfGridPoints;
+};
+
+}
+
+#endif /* OUTLIERREMOVALTEST_H_ */
+
+/* EOF */
@@ -0,0 +1,218 @@
+/**
+ * @file 
+ * PersistentOctreeTest.cpp
+ *
+ * @date: Oct 17, 2026
+ * @author: sblume
+ */
+
+#include "PersistentOctreeTest.h"
+#include <limits>
+#include <stdexcept>
+
+namespace unitTests {
+
+CPPUNIT_TEST_SUITE_REGISTRATION( PersistentOctreeTest );
+
+void PersistentOctreeTest::setUp() {
+	/* voxel size 1.0 is used: every point is in a distinct leaf unless stated otherwise */
+	firstFrame = new PointCloud3D();
+	firstFrame->addPoint(Point3D(0.2, 0.2, 0.2));
+	firstFrame->addPoint(Point3D(0.4, 0.6, 0.8)); // same leaf as the first point
+	firstFrame->addPoint(Point3D(1.5, 0.5, 0.5));
+	firstFrame->addPoint(Point3D(3.5, 3.5, 3.5));
+
+	secondFrame = new PointCloud3D();
+	secondFrame->addPoint(Point3D(0.6, 0.4, 0.2)); // same leaf as in the first frame
+	secondFrame->addPoint(Point3D(-2.5, -0.5, 7.5)); // forces the tree to grow
+	secondFrame->addPoint(Point3D(std::numeric_limits<double>::quiet_NaN(), 0.0, 0.0));
+}
+
+void PersistentOctreeTest::tearDown() {
+	delete firstFrame;
+	delete secondFrame;
+}
+
+void PersistentOctreeTest::testSetupInterface() {
+	PersistentOctree octree(1.0);
+	IOctreeSetup* setup = &octree;
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, setup->getVoxelSize(), maxTolerance);
+	CPPUNIT_ASSERT_THROW(setup->setVoxelSize(0.0), std::runtime_error);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, setup->getVoxelSize(), maxTolerance);
+
+	octree.insert(firstFrame);
+	CPPUNIT_ASSERT_EQUAL(3u, octree.getNumberOfLeaves());
+
+	/* the stored points are sorted into the new grid */
+	setup->setVoxelSize(10.0);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(10.0, setup->getVoxelSize(), maxTolerance);
+	CPPUNIT_ASSERT_EQUAL(4u, octree.getSize());
+	CPPUNIT_ASSERT_EQUAL(1u, octree.getNumberOfLeaves());
+	CPPUNIT_ASSERT_EQUAL(0u, octree.getDepth());
+}
+
+void PersistentOctreeTest::testIncrementalInsert() {
+	PersistentOctree octree(1.0);
+	CPPUNIT_ASSERT_EQUAL(0u, octree.getSize());
+	CPPUNIT_ASSERT_EQUAL(0u, octree.getNumberOfNodes());
+
+	CPPUNIT_ASSERT_EQUAL(0u, octree.insert(firstFrame));
+	CPPUNIT_ASSERT_EQUAL(4u, octree.getSize());
+	CPPUNIT_ASSERT_EQUAL(3u, octree.getNumberOfLeaves());
+	unsigned int depth = octree.getDepth();
+	CPPUNIT_ASSERT(depth >= 2); // at least cells 0..3 have to be covered
+	CPPUNIT_ASSERT(depth <= 4);
+
+	CPPUNIT_ASSERT_EQUAL(1u, octree.insert(secondFrame));
+	CPPUNIT_ASSERT_EQUAL(6u, octree.getSize()); // NaN is skipped
+	CPPUNIT_ASSERT_EQUAL(4u, octree.getNumberOfLeaves());
+	CPPUNIT_ASSERT(octree.getDepth() >= depth);
+	CPPUNIT_ASSERT(octree.getDepth() <= 5); // cells -3..7
+	CPPUNIT_ASSERT_EQUAL(2u, octree.getCurrentFrame());
+
+	PointCloud3D reduced;
+	octree.getReducedPointCloud(&reduced);
+	CPPUNIT_ASSERT_EQUAL(4u, reduced.getSize());
+	bool foundMergedLeaf = false;
+	for (unsigned int i = 0; i < reduced.getSize(); ++i) {
+		const Point3D& point = (*reduced.getPointCloud())[i];
+		if (point.getX() < 1.0 && point.getX() > 0.0) {
+			CPPUNIT_ASSERT_DOUBLES_EQUAL(0.4, point.getX(), maxTolerance);
+			CPPUNIT_ASSERT_DOUBLES_EQUAL(0.4, point.getY(), maxTolerance);
+			CPPUNIT_ASSERT_DOUBLES_EQUAL(0.4, point.getZ(), maxTolerance);
+			foundMergedLeaf = true;
+		}
+	}
+	CPPUNIT_ASSERT(foundMergedLeaf);
+
+	/* clear keeps the frame counter */
+	octree.clear();
+	CPPUNIT_ASSERT_EQUAL(0u, octree.getSize());
+	CPPUNIT_ASSERT_EQUAL(0u, octree.getNumberOfLeaves());
+	CPPUNIT_ASSERT_EQUAL(2u, octree.insert(firstFrame));
+}
+
+void PersistentOctreeTest::testOccupancy() {
+	PersistentOctree octree(1.0);
+	octree.insert(firstFrame);
+	octree.insert(secondFrame);
+
+	CPPUNIT_ASSERT_EQUAL(3u, octree.getOccupancy(Point3D(0.9, 0.9, 0.9)));
+	CPPUNIT_ASSERT_EQUAL(1u, octree.getOccupancy(Point3D(1.1, 0.1, 0.1)));
+	CPPUNIT_ASSERT_EQUAL(0u, octree.getOccupancy(Point3D(2.5, 2.5, 2.5)));
+	CPPUNIT_ASSERT_EQUAL(1u, octree.getOccupancy(Point3D(-2.1, -0.1, 7.1)));
+
+	/* occupancy grows with the level up to the root */
+	for (unsigned int level = 1; level <= octree.getDepth(); ++level) {
+		CPPUNIT_ASSERT(octree.getOccupancy(Point3D(0.5, 0.5, 0.5), level) >= octree.getOccupancy(Point3D(0.5, 0.5, 0.5), level - 1));
+	}
+	CPPUNIT_ASSERT_EQUAL(6u, octree.getOccupancy(Point3D(0.5, 0.5, 0.5), octree.getDepth()));
+	CPPUNIT_ASSERT_EQUAL(0u, octree.getOccupancy(Point3D(0.5, 0.5, 0.5), octree.getDepth() + 1));
+	CPPUNIT_ASSERT_EQUAL(0u, octree.getOccupancy(Point3D(100.0, 0.5, 0.5)));
+}
+
+void PersistentOctreeTest::testQueries() {
+	PersistentOctree octree(1.0);
+	octree.insert(firstFrame);
+	octree.insert(secondFrame);
+
+	PointCloud3D result;
+	octree.getPointsInBox(Point3D(0.0, 0.0, 0.0), Point3D(2.0, 2.0, 2.0), &result);
+	CPPUNIT_ASSERT_EQUAL(4u, result.getSize());
+
+	result.getPointCloud()->clear();
+	octree.getPointsInBox(Point3D(0.3, 0.0, 0.0), Point3D(1.0, 1.0, 1.0), &result);
+	CPPUNIT_ASSERT_EQUAL(2u, result.getSize());
+
+	result.getPointCloud()->clear();
+	octree.getPointsInBox(Point3D(-3.0, -1.0, 7.0), Point3D(-2.0, 0.0, 8.0), &result);
+	CPPUNIT_ASSERT_EQUAL(1u, result.getSize());
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(-2.5, (*result.getPointCloud())[0].getX(), maxTolerance);
+
+	result.getPointCloud()->clear();
+	octree.getPointsInRadius(Point3D(0.0, 0.0, 0.0), 0.5, &result);
+	CPPUNIT_ASSERT_EQUAL(1u, result.getSize());
+
+	result.getPointCloud()->clear();
+	octree.getPointsInRadius(Point3D(1.0, 0.5, 0.5), 0.6, &result);
+	CPPUNIT_ASSERT_EQUAL(2u, result.getSize()); // (0.4 0.6 0.8) is just outside
+
+	result.getPointCloud()->clear();
+	octree.getPointsInRadius(Point3D(1.0, 0.5, 0.5), 100.0, &result);
+	CPPUNIT_ASSERT_EQUAL(6u, result.getSize());
+}
+
+void PersistentOctreeTest::testRemoveOldFrames() {
+	PersistentOctree firstFrameOnly(1.0);
+	firstFrameOnly.insert(firstFrame);
+
+	PersistentOctree octree(1.0);
+	octree.insert(firstFrame);
+	unsigned int frame = octree.insert(secondFrame);
+	unsigned int allNodes = octree.getNumberOfNodes();
+
+	octree.removeFramesOlderThan(frame);
+	CPPUNIT_ASSERT_EQUAL(2u, octree.getSize());
+	CPPUNIT_ASSERT_EQUAL(2u, octree.getNumberOfLeaves());
+	CPPUNIT_ASSERT(octree.getNumberOfNodes() < allNodes);
+	CPPUNIT_ASSERT_EQUAL(1u, octree.getOccupancy(Point3D(0.5, 0.5, 0.5)));
+	CPPUNIT_ASSERT_EQUAL(0u, octree.getOccupancy(Point3D(1.5, 0.5, 0.5)));
+
+	/* freed nodes are recycled */
+	octree.insert(firstFrame);
+	CPPUNIT_ASSERT_EQUAL(6u, octree.getSize());
+	CPPUNIT_ASSERT_EQUAL(allNodes, octree.getNumberOfNodes());
+
+	/* only the last frame remains; the tree shrinks to the same shape as when built from scratch */
+	octree.removeFramesOlderThan(octree.getCurrentFrame() - 1);
+	CPPUNIT_ASSERT_EQUAL(4u, octree.getSize());
+	CPPUNIT_ASSERT_EQUAL(firstFrameOnly.getDepth(), octree.getDepth());
+	CPPUNIT_ASSERT_EQUAL(firstFrameOnly.getNumberOfNodes(), octree.getNumberOfNodes());
+
+	octree.removeFramesOlderThan(octree.getCurrentFrame());
+	CPPUNIT_ASSERT_EQUAL(0u, octree.getSize());
+	CPPUNIT_ASSERT_EQUAL(0u, octree.getNumberOfNodes());
+}
+
+void PersistentOctreeTest::testFilterAndPartition() {
+	PersistentOctree octree(1.0);
+	IOctreeReductionFilter* filter = &octree;
+	IOctreePartition* partition = &octree;
+
+	PointCloud3D result;
+	filter->filter(firstFrame, &result);
+	CPPUNIT_ASSERT_EQUAL(3u, result.getSize());
+	CPPUNIT_ASSERT_EQUAL(4u, octree.getSize());
+
+	/* the leaf of the second frame also holds the points of the first frame */
+	filter->filter(secondFrame, &result);
+	CPPUNIT_ASSERT_EQUAL(2u, result.getSize());
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.4, (*result.getPointCloud())[0].getX(), maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.4, (*result.getPointCloud())[0].getY(), maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.4, (*result.getPointCloud())[0].getZ(), maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(-2.5, (*result.getPointCloud())[1].getX(), maxTolerance);
+
+	/* indices refer to the given point cloud; the invalid point is left out */
+	std::vector<int> pointIndices;
+	std::vector<int> cellOffsets;
+	partition->partitionPointCloud(secondFrame, &pointIndices, &cellOffsets);
+	CPPUNIT_ASSERT_EQUAL(3u, static_cast<unsigned int>(cellOffsets.size()));
+	CPPUNIT_ASSERT_EQUAL(2u, static_cast<unsigned int>(pointIndices.size()));
+	CPPUNIT_ASSERT_EQUAL(0, pointIndices[0]);
+	CPPUNIT_ASSERT_EQUAL(1, pointIndices[1]);
+	CPPUNIT_ASSERT_EQUAL(8u, octree.getSize());
+
+	std::vector<PointCloud3D*> cells;
+	partition->partitionPointCloud(firstFrame, &cells);
+	CPPUNIT_ASSERT_EQUAL(3u, static_cast<unsigned int>(cells.size()));
+	CPPUNIT_ASSERT_EQUAL(2u, cells[0]->getSize());
+	CPPUNIT_ASSERT_EQUAL(1u, cells[1]->getSize());
+	CPPUNIT_ASSERT_EQUAL(1u, cells[2]->getSize());
+	for (unsigned int i = 0; i < cells.size(); ++i) {
+		delete cells[i];
+	}
+}
+
+}
+
+/* EOF */
@@ -0,0 +1,56 @@
+/**
+ * @file 
+ * PersistentOctreeTest.h
+ *
+ * @date: Oct 17, 2026
+ * @author: sblume
+ */
+
+#ifndef PERSISTENTOCTREETEST_H_
+#define PERSISTENTOCTREETEST_H_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "brics_3d/algorithm/filtering/PersistentOctree.h"
+
+using namespace std;
+using namespace brics_3d;
+
+namespace unitTests {
+
+class PersistentOctreeTest : public CPPUNIT_NS::TestFixture {
+
+	CPPUNIT_TEST_SUITE( PersistentOctreeTest );
+	CPPUNIT_TEST( testSetupInterface );
+	CPPUNIT_TEST( testIncrementalInsert );
+	CPPUNIT_TEST( testOccupancy );
+	CPPUNIT_TEST( testQueries );
+	CPPUNIT_TEST( testRemoveOldFrames );
+	CPPUNIT_TEST( testFilterAndPartition );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp();
+	void tearDown();
+
+	void testSetupInterface();
+	void testIncrementalInsert();
+	void testOccupancy();
+	void testQueries();
+	void testRemoveOldFrames();
+	void testFilterAndPartition();
+
+private:
+
+	static const double maxTolerance = 0.00001;
+
+	PointCloud3D* firstFrame;
+	PointCloud3D* secondFrame;
+};
+
+}
+
+#endif /* PERSISTENTOCTREETEST_H_ */
+
+/* EOF */
@@ -0,0 +1,241 @@
+/**
+ * @file
+ * PlyFileHandlerTest.cpp
+ *
+ * @date: Oct 17, 2026
+ * @author: sblume
+ */
+
+#include "PlyFileHandlerTest.h"
+
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+
+namespace unitTests {
+
+CPPUNIT_TEST_SUITE_REGISTRATION( PlyFileHandlerTest );
+
+void PlyFileHandlerTest::setUp() {
+	filename = "plyFileHandlerTest.ply";
+}
+
+void PlyFileHandlerTest::tearDown() {
+	std::remove(filename.c_str());
+}
+
+void PlyFileHandlerTest::createPointCloud(PointCloud3DContiguous& pointCloud, unsigned int numberOfPoints) {
+	pointCloud.clear();
+	for (unsigned int i = 0; i < numberOfPoints; ++i) {
+		pointCloud.addPoint(i * 0.1 + 0.123456789, -1.0 * i, 1e6 + i);
+		pointCloud.setColor(i, i % 256, (2 * i) % 256, 255 - (i % 256));
+		pointCloud.setNormal(i, 0.0f, 1.0f, i * 0.5f);
+		pointCloud.setIntensity(i, i * 2.0f);
+	}
+}
+
+void PlyFileHandlerTest::assertEqualPointClouds(const PointCloud3DContiguous& expected, const PointCloud3DContiguous& actual, double tolerance) {
+	CPPUNIT_ASSERT_EQUAL(expected.getSize(), actual.getSize());
+	CPPUNIT_ASSERT_EQUAL(expected.hasColors(), actual.hasColors());
+	CPPUNIT_ASSERT_EQUAL(expected.hasNormals(), actual.hasNormals());
+	CPPUNIT_ASSERT_EQUAL(expected.hasIntensities(), actual.hasIntensities());
+
+	for (unsigned int i = 0; i < expected.getSize(); ++i) {
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(expected.getXCoordinates()[i], actual.getXCoordinates()[i], tolerance);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(expected.getYCoordinates()[i], actual.getYCoordinates()[i], tolerance);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(expected.getZCoordinates()[i], actual.getZCoordinates()[i], tolerance);
+		for (unsigned int j = 0; j < 3; ++j) {
+			if (expected.hasColors()) {
+				CPPUNIT_ASSERT_EQUAL(expected.getColors()[3 * i + j], actual.getColors()[3 * i + j]);
+			}
+			if (expected.hasNormals()) {
+				CPPUNIT_ASSERT_DOUBLES_EQUAL(expected.getNormals()[3 * i + j], actual.getNormals()[3 * i + j], maxTolerance);
+			}
+		}
+		if (expected.hasIntensities()) {
+			CPPUNIT_ASSERT_DOUBLES_EQUAL(expected.getIntensities()[i], actual.getIntensities()[i], maxTolerance);
+		}
+	}
+}
+
+void PlyFileHandlerTest::writeFile(const std::string& content) {
+	std::ofstream outputFile(filename.c_str(), std::ios::out | std::ios::binary);
+	outputFile.write(content.data(), content.size());
+	outputFile.close();
+}
+
+void PlyFileHandlerTest::testBinaryRoundTrip() {
+	PointCloud3DContiguous pointCloud;
+	PointCloud3DContiguous resultPointCloud;
+
+	/* coordinates only */
+	for (unsigned int i = 0; i < 100; ++i) {
+		pointCloud.addPoint(i, 2.0 * i, -3.0 * i);
+	}
+	PlyFileHandler::write(pointCloud, filename);
+	PlyFileHandler::read(filename, resultPointCloud);
+	assertEqualPointClouds(pointCloud, resultPointCloud, 0.0);
+
+	/* all attributes; more than one write chunk */
+	createPointCloud(pointCloud, 70000);
+	PlyFileHandler::write(pointCloud, filename, PlyFileHandler::binaryLittleEndian);
+	PlyFileHandler::read(filename, resultPointCloud);
+	assertEqualPointClouds(pointCloud, resultPointCloud, 0.0); // double precision is stored lossless
+
+	/* empty */
+	pointCloud.clear();
+	pointCloud.disableAttributes();
+	PlyFileHandler::write(pointCloud, filename);
+	PlyFileHandler::read(filename, resultPointCloud);
+	CPPUNIT_ASSERT_EQUAL(0u, resultPointCloud.getSize());
+	CPPUNIT_ASSERT(!resultPointCloud.hasColors());
+}
+
+void PlyFileHandlerTest::testAsciiRoundTrip() {
+	PointCloud3DContiguous pointCloud;
+	PointCloud3DContiguous resultPointCloud;
+	createPointCloud(pointCloud, 1000);
+
+	PlyFileHandler::write(pointCloud, filename, PlyFileHandler::ascii);
+	PlyFileHandler::read(filename, resultPointCloud);
+	assertEqualPointClouds(pointCloud, resultPointCloud, 1e-9);
+}
+
+void PlyFileHandlerTest::testSinglePrecision() {
+	PointCloud3DContiguousFloat pointCloud;
+	for (unsigned int i = 0; i < 10; ++i) {
+		pointCloud.addPoint(i * 0.5f, 1.0f, -0.25f * i);
+		pointCloud.setColor(i, 1, 2, 3);
+	}
+	PlyFileHandler::write(pointCloud, filename);
+
+	/* read a float file into both precisions */
+	PointCloud3DContiguousFloat resultPointCloud;
+	PlyFileHandler::read(filename, resultPointCloud);
+	CPPUNIT_ASSERT_EQUAL(10u, resultPointCloud.getSize());
+	CPPUNIT_ASSERT(resultPointCloud.hasColors());
+	CPPUNIT_ASSERT(!resultPointCloud.hasNormals());
+
+	PointCloud3DContiguous resultPointCloudDouble;
+	PlyFileHandler::read(filename, resultPointCloudDouble);
+	CPPUNIT_ASSERT_EQUAL(10u, resultPointCloudDouble.getSize());
+	for (unsigned int i = 0; i < 10; ++i) {
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(pointCloud.getXCoordinates()[i], resultPointCloud.getXCoordinates()[i], 0.0);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(pointCloud.getZCoordinates()[i], resultPointCloudDouble.getZCoordinates()[i], 0.0);
+		CPPUNIT_ASSERT_EQUAL(static_cast<unsigned char>(3), resultPointCloudDouble.getColors()[3 * i + 2]);
+	}
+}
+
+void PlyFileHandlerTest::testDecoratedPointCloud() {
+	PointCloud3D pointCloud;
+	pointCloud.addPoint(Point3D(1, 2, 3));
+	pointCloud.addPointPtr(new ColoredPoint3D(new Point3D(4, 5, 6), 10, 20, 30));
+	pointCloud.addPointPtr(new Point3DNormal(new Point3D(7, 8, 9), Normal3D(0, 0, 1)));
+
+	for (int binary = 0; binary <= 1; ++binary) {
+		pointCloud.storeToPlyFile(filename, binary == 1);
+
+		PointCloud3D resultPointCloud;
+		resultPointCloud.addPoint(Point3D(-1, -1, -1));
+		resultPointCloud.readFromPlyFile(filename); // appends
+		CPPUNIT_ASSERT_EQUAL(4u, resultPointCloud.getSize());
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(-1.0, (*resultPointCloud.getPointCloud())[0].getX(), maxTolerance);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, (*resultPointCloud.getPointCloud())[1].getX(), maxTolerance);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(6.0, (*resultPointCloud.getPointCloud())[2].getZ(), maxTolerance);
+
+		/* all points of the file get the channels that at least one point has */
+		ColoredPoint3D* coloredPoint = getPointType<ColoredPoint3D>(&(*resultPointCloud.getPointCloud())[2]);
+		CPPUNIT_ASSERT(coloredPoint != 0);
+		CPPUNIT_ASSERT_EQUAL(static_cast<unsigned char>(20), coloredPoint->getG());
+		Point3DNormal* normalPoint = getPointType<Point3DNormal>(&(*resultPointCloud.getPointCloud())[3]);
+		CPPUNIT_ASSERT(normalPoint != 0);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, normalPoint->getNormal().getZ(), maxTolerance);
+	}
+}
+
+void PlyFileHandlerTest::testForeignFiles() {
+	PointCloud3DContiguous resultPointCloud;
+
+	/* ascii with a face element and unknown properties, colors as floats */
+	writeFile("ply\r\n"
+			"format ascii 1.0\r\n"
+			"comment some other tool\r\n"
+			"element vertex 3\r\n"
+			"property float x\r\n"
+			"property float y\r\n"
+			"property float z\r\n"
+			"property float confidence\r\n"
+			"property float red\r\n"
+			"property float green\r\n"
+			"property float blue\r\n"
+			"element face 1\r\n"
+			"property list uchar int vertex_indices\r\n"
+			"end_header\r\n"
+			"0 0 0 0.5 1 0 0\r\n"
+			"1 0 0 0.5 0 1 0\r\n"
+			"0 1 0 0.5 0 0 0.5\r\n"
+			"3 0 1 2\r\n");
+	PlyFileHandler::read(filename, resultPointCloud);
+	CPPUNIT_ASSERT_EQUAL(3u, resultPointCloud.getSize());
+	CPPUNIT_ASSERT(resultPointCloud.hasColors());
+	CPPUNIT_ASSERT(!resultPointCloud.hasNormals());
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, resultPointCloud.getYCoordinates()[2], maxTolerance);
+	CPPUNIT_ASSERT_EQUAL(static_cast<unsigned char>(255), resultPointCloud.getColors()[0]);
+	CPPUNIT_ASSERT_EQUAL(static_cast<unsigned char>(255), resultPointCloud.getColors()[4]);
+	CPPUNIT_ASSERT_EQUAL(static_cast<unsigned char>(128), resultPointCloud.getColors()[8]);
+
+	/* big endian with a leading element with variable record size */
+	std::string content = "ply\n"
+			"format binary_big_endian 1.0\n"
+			"element camera 2\n"
+			"property list uchar short ids\n"
+			"element vertex 2\n"
+			"property short x\n"
+			"property int y\n"
+			"property uchar z\n"
+			"property float intensity\n"
+			"end_header\n";
+	const unsigned char data[] = {
+			2, 0x00, 0x01, 0x00, 0x02, // camera 0: two ids
+			0, // camera 1: no ids
+			0xFF, 0xFE, 0x00, 0x00, 0x01, 0x00, 0x07, 0x3F, 0x80, 0x00, 0x00, // vertex 0: -2 256 7 1.0
+			0x00, 0x03, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x40, 0x00, 0x00, 0x00  // vertex 1: 3 -1 0 2.0
+	};
+	content.append(reinterpret_cast<const char*>(data), sizeof(data));
+	writeFile(content);
+	PlyFileHandler::read(filename, resultPointCloud);
+	CPPUNIT_ASSERT_EQUAL(2u, resultPointCloud.getSize());
+	CPPUNIT_ASSERT(!resultPointCloud.hasColors());
+	CPPUNIT_ASSERT(resultPointCloud.hasIntensities());
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(-2.0, resultPointCloud.getXCoordinates()[0], maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(256.0, resultPointCloud.getYCoordinates()[0], maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(7.0, resultPointCloud.getZCoordinates()[0], maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, resultPointCloud.getIntensities()[0], maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0, resultPointCloud.getXCoordinates()[1], maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(-1.0, resultPointCloud.getYCoordinates()[1], maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(2.0, resultPointCloud.getIntensities()[1], maxTolerance);
+}
+
+void PlyFileHandlerTest::testInvalidFiles() {
+	PointCloud3DContiguous resultPointCloud;
+	CPPUNIT_ASSERT_THROW(PlyFileHandler::read("/nonexistent/file.ply", resultPointCloud), std::runtime_error);
+
+	writeFile("not a ply file\n");
+	CPPUNIT_ASSERT_THROW(PlyFileHandler::read(filename, resultPointCloud), std::runtime_error);
+
+	writeFile("ply\nformat ascii 1.0\nelement vertex 1\nproperty float x\nproperty float y\n");
+	CPPUNIT_ASSERT_THROW(PlyFileHandler::read(filename, resultPointCloud), std::runtime_error); // no end_header
+
+	writeFile("ply\nformat ascii 1.0\nelement vertex 1\nproperty float x\nproperty float y\nend_header\n1 2\n");
+	CPPUNIT_ASSERT_THROW(PlyFileHandler::read(filename, resultPointCloud), std::runtime_error); // no z
+
+	writeFile("ply\nformat ascii 1.0\nelement vertex 2\nproperty float x\nproperty float y\nproperty float z\nend_header\n1 2 3\n");
+	CPPUNIT_ASSERT_THROW(PlyFileHandler::read(filename, resultPointCloud), std::runtime_error); // truncated
+
+	writeFile("ply\nformat binary_little_endian 1.0\nelement vertex 2\nproperty float x\nproperty float y\nproperty float z\nend_header\n123");
+	CPPUNIT_ASSERT_THROW(PlyFileHandler::read(filename, resultPointCloud), std::runtime_error); // truncated
+}
+
+}
+
+/* EOF */
@@ -0,0 +1,71 @@
+/**
+ * @file
+ * PlyFileHandlerTest.h
+ *
+ * @date: Oct 17, 2026
+ * @author: sblume
+ */
+
+#ifndef PLYFILEHANDLERTEST_H_
+#define PLYFILEHANDLERTEST_H_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "brics_3d/core/PlyFileHandler.h"
+#include "brics_3d/core/PointCloud3D.h"
+#include "brics_3d/core/PointCloud3DContiguous.h"
+#include "brics_3d/core/ColoredPoint3D.h"
+#include "brics_3d/core/Point3DNormal.h"
+
+using namespace std;
+using namespace brics_3d;
+
+namespace unitTests {
+
+/**
+ * @brief UnitTest for the PlyFileHandler class
+ */
+class PlyFileHandlerTest : public CPPUNIT_NS::TestFixture {
+
+	CPPUNIT_TEST_SUITE( PlyFileHandlerTest );
+	CPPUNIT_TEST( testBinaryRoundTrip );
+	CPPUNIT_TEST( testAsciiRoundTrip );
+	CPPUNIT_TEST( testSinglePrecision );
+	CPPUNIT_TEST( testDecoratedPointCloud );
+	CPPUNIT_TEST( testForeignFiles );
+	CPPUNIT_TEST( testInvalidFiles );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp();
+	void tearDown();
+
+	void testBinaryRoundTrip();
+	void testAsciiRoundTrip();
+	void testSinglePrecision();
+	void testDecoratedPointCloud();
+	void testForeignFiles();
+	void testInvalidFiles();
+
+private:
+
+	/// Create a point cloud with all attribute channels.
+	void createPointCloud(PointCloud3DContiguous& pointCloud, unsigned int numberOfPoints);
+
+	/// Compare two point clouds including their attribute channels.
+	void assertEqualPointClouds(const PointCloud3DContiguous& expected, const PointCloud3DContiguous& actual, double tolerance);
+
+	/// Write a file with arbitrary content.
+	void writeFile(const std::string& content);
+
+	std::string filename;
+
+	static const double maxTolerance = 0.00001;
+};
+
+}
+
+#endif /* PLYFILEHANDLERTEST_H_ */
+
+/* EOF */
@@ -0,0 +1,156 @@
+/**
+ * @file
+ * Point3DArenaTest.cpp
+ *
+ * @date: Oct 17, 2026
+ * @author: sblume
+ */
+
+#include "Point3DArenaTest.h"
+
+#include <stdexcept>
+
+namespace unitTests {
+
+CPPUNIT_TEST_SUITE_REGISTRATION( Point3DArenaTest );
+
+void Point3DArenaTest::setUp() {
+
+}
+
+void Point3DArenaTest::tearDown() {
+
+}
+
+void Point3DArenaTest::testAllocation() {
+	Point3DArena arena(256);
+	CPPUNIT_ASSERT_EQUAL(0u, arena.getNumberOfBlocks());
+	CPPUNIT_ASSERT_EQUAL(0u, arena.getNumberOfAllocations());
+
+	void* first = arena.allocate(3);
+	void* second = arena.allocate(8);
+	CPPUNIT_ASSERT(first != 0);
+	CPPUNIT_ASSERT(second != 0);
+	CPPUNIT_ASSERT_EQUAL(0u, static_cast<unsigned int>(reinterpret_cast<size_t>(second) % sizeof(double))); // aligned
+	CPPUNIT_ASSERT_EQUAL(1u, arena.getNumberOfBlocks());
+	CPPUNIT_ASSERT_EQUAL(2u, arena.getNumberOfAllocations());
+
+	/* fill the first block, then a second one is needed */
+	for (int i = 0; i < 40; ++i) {
+		arena.allocate(8);
+	}
+	CPPUNIT_ASSERT(arena.getNumberOfBlocks() > 1u);
+
+	/* oversized requests get a dedicated block */
+	unsigned int blocks = arena.getNumberOfBlocks();
+	void* large = arena.allocate(1000);
+	CPPUNIT_ASSERT(large != 0);
+	CPPUNIT_ASSERT_EQUAL(blocks + 1, arena.getNumberOfBlocks());
+
+	/* reset keeps only the first block */
+	arena.reset();
+	CPPUNIT_ASSERT_EQUAL(1u, arena.getNumberOfBlocks());
+	CPPUNIT_ASSERT_EQUAL(0u, arena.getNumberOfAllocations());
+	CPPUNIT_ASSERT(arena.allocate(3) == first); // memory is recycled
+}
+
+void Point3DArenaTest::testCloneInto() {
+	Point3DArena arena;
+	Point3D heapPoint(1, 2, 3);
+	CPPUNIT_ASSERT(!arena.contains(&heapPoint));
+
+	Point3D* arenaPoint = heapPoint.cloneInto(&arena);
+	CPPUNIT_ASSERT(arena.contains(arenaPoint));
+	CPPUNIT_ASSERT_EQUAL(1u, arena.getNumberOfAllocations());
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(2.0, arenaPoint->getY(), maxTolerance);
+
+	/* a null arena is the same as clone() */
+	Point3D* clonedPoint = heapPoint.cloneInto(0);
+	CPPUNIT_ASSERT(!arena.contains(clonedPoint));
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0, clonedPoint->getZ(), maxTolerance);
+	delete clonedPoint;
+
+	/* plain new and delete are not affected by arenas */
+	Point3D* newPoint = new Point3D(4, 5, 6);
+	CPPUNIT_ASSERT(!arena.contains(newPoint));
+	delete newPoint;
+	CPPUNIT_ASSERT_EQUAL(1u, arena.getNumberOfAllocations());
+
+	/* large blocks are covered as well */
+	void* large = arena.allocate(2 * Point3DArena::defaultBlockSize);
+	CPPUNIT_ASSERT(arena.contains(static_cast<char*>(large) + Point3DArena::defaultBlockSize));
+
+	arena.reset();
+	CPPUNIT_ASSERT(!arena.contains(large));
+}
+
+void Point3DArenaTest::testDecoratedPoints() {
+	Point3DArena arena;
+	ColoredPoint3D coloredPoint(new Point3D(1, 2, 3), 10, 20, 30);
+
+	Point3D* clonedPoint = coloredPoint.cloneInto(&arena);
+	CPPUNIT_ASSERT(arena.contains(clonedPoint));
+	CPPUNIT_ASSERT(clonedPoint->asColoredPoint3D() != 0);
+	CPPUNIT_ASSERT(arena.contains(clonedPoint->asColoredPoint3D()->getPoint())); // all decoration layers
+	CPPUNIT_ASSERT_EQUAL(20, static_cast<int>(clonedPoint->asColoredPoint3D()->getG()));
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0, clonedPoint->getZ(), maxTolerance);
+	CPPUNIT_ASSERT_EQUAL(2u, arena.getNumberOfAllocations());
+
+	/* clone of a clone */
+	Point3D* secondClone = clonedPoint->cloneInto(&arena);
+	CPPUNIT_ASSERT_EQUAL(10, static_cast<int>(secondClone->asColoredPoint3D()->getR()));
+	CPPUNIT_ASSERT_EQUAL(4u, arena.getNumberOfAllocations());
+}
+
+void Point3DArenaTest::testPointCloudArena() {
+	Point3DArena::Point3DArenaPtr arena(new Point3DArena());
+	PointCloud3D* pointCloud = new PointCloud3D();
+	CPPUNIT_ASSERT(pointCloud->getArena() == 0);
+	pointCloud->setArena(arena);
+	CPPUNIT_ASSERT(pointCloud->getArena() == arena);
+
+	pointCloud->addPoint(1, 2, 3);
+	pointCloud->addPoint(Point3D(4, 5, 6));
+	double buffer[] = {7, 8, 9, 10, 11, 12};
+	pointCloud->addPoints(buffer, 2);
+	pointCloud->addPointPtr(new Point3D(13, 14, 15)); // heap point, moved into the arena
+	ColoredPoint3D coloredPoint(new Point3D(16, 17, 18), 1, 2, 3);
+	pointCloud->addPointClone(coloredPoint);
+	CPPUNIT_ASSERT_EQUAL(6u, pointCloud->getSize());
+	CPPUNIT_ASSERT_EQUAL(7u, arena->getNumberOfAllocations());
+	for (unsigned int i = 0; i < pointCloud->getSize(); ++i) {
+		CPPUNIT_ASSERT(arena->contains(&(*pointCloud->getPointCloud())[i]));
+	}
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(11.0, (*pointCloud->getPointCloud())[3].getY(), maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(14.0, (*pointCloud->getPointCloud())[4].getY(), maxTolerance);
+	CPPUNIT_ASSERT((*pointCloud->getPointCloud())[5].asColoredPoint3D() != 0);
+
+	/* adopted points are moved into the arena as well */
+	boost::ptr_vector<Point3D> heapPoints;
+	heapPoints.push_back(new Point3D(19, 20, 21));
+	pointCloud->adoptPoints(heapPoints);
+	CPPUNIT_ASSERT_EQUAL(7u, pointCloud->getSize());
+	CPPUNIT_ASSERT(arena->contains(&(*pointCloud->getPointCloud())[6]));
+
+	/* the arena can not be exchanged any more */
+	Point3DArena::Point3DArenaPtr otherArena(new Point3DArena());
+	CPPUNIT_ASSERT_THROW(pointCloud->setArena(otherArena), runtime_error);
+
+	/* clearing does not touch the points */
+	pointCloud->clear();
+	CPPUNIT_ASSERT_EQUAL(0u, pointCloud->getSize());
+	CPPUNIT_ASSERT_EQUAL(8u, arena->getNumberOfAllocations());
+	pointCloud->setArena(otherArena); // possible again for an empty point cloud
+	pointCloud->setArena(arena);
+
+	/* the point cloud keeps the arena alive */
+	pointCloud->addPoint(1, 2, 3);
+	Point3DArena* rawArena = arena.get();
+	arena.reset();
+	CPPUNIT_ASSERT(pointCloud->getArena().get() == rawArena);
+	delete pointCloud;
+}
+
+}
+
+/* EOF */
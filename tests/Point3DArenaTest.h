@@ -0,0 +1,55 @@
+/**
+ * @file
+ * Point3DArenaTest.h
+ *
+ * @date: Oct 17, 2026
+ * @author: sblume
+ */
+
+#ifndef POINT3DARENATEST_H_
+#define POINT3DARENATEST_H_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "brics_3d/core/Point3DArena.h"
+#include "brics_3d/core/Point3D.h"
+#include "brics_3d/core/ColoredPoint3D.h"
+#include "brics_3d/core/PointCloud3D.h"
+
+using namespace std;
+using namespace brics_3d;
+
+namespace unitTests {
+
+/**
+ * @brief UnitTest for the Point3DArena class
+ */
+class Point3DArenaTest : public CPPUNIT_NS::TestFixture {
+
+	CPPUNIT_TEST_SUITE( Point3DArenaTest );
+	CPPUNIT_TEST( testAllocation );
+	CPPUNIT_TEST( testCloneInto );
+	CPPUNIT_TEST( testDecoratedPoints );
+	CPPUNIT_TEST( testPointCloudArena );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp();
+	void tearDown();
+
+	void testAllocation();
+	void testCloneInto();
+	void testDecoratedPoints();
+	void testPointCloudArena();
+
+private:
+
+	static const double maxTolerance = 0.00001;
+};
+
+}
+
+#endif /* POINT3DARENATEST_H_ */
+
+/* EOF */
@@ -0,0 +1,479 @@
+/**
+ * @file
+ * PointCloud3DContiguousTest.cpp
+ *
+ * @date: Oct 17, 2026
+ * @author: sblume
+ */
+
+#include "PointCloud3DContiguousTest.h"
+#include "brics_3d/core/ColoredPoint3D.h"
+#include "brics_3d/core/Point3DNormal.h"
+#include "brics_3d/core/Point3DIntensity.h"
+
+#include <stdexcept>
+
+namespace unitTests {
+
+CPPUNIT_TEST_SUITE_REGISTRATION( PointCloud3DContiguousTest );
+
+void PointCloud3DContiguousTest::setUp() {
+	pointCloudCube = new PointCloud3DContiguous();
+
+	pointCloudCube->addPoint(Point3D(0,0,0));
+	pointCloudCube->addPoint(Point3D(0,0,1));
+	pointCloudCube->addPoint(Point3D(0,1,1));
+	pointCloudCube->addPoint(Point3D(0,1,0));
+	pointCloudCube->addPoint(1,0,0);
+	pointCloudCube->addPoint(1,0,1);
+	pointCloudCube->addPoint(1,1,1);
+	pointCloudCube->addPointPtr(new Point3D(1,1,0));
+}
+
+void PointCloud3DContiguousTest::tearDown() {
+	delete pointCloudCube;
+}
+
+void PointCloud3DContiguousTest::testConstructor() {
+	PointCloud3DContiguous emptyCloud;
+	CPPUNIT_ASSERT_EQUAL(0u, emptyCloud.getSize());
+	CPPUNIT_ASSERT(emptyCloud.getXCoordinates() == 0);
+	CPPUNIT_ASSERT(emptyCloud.getYCoordinates() == 0);
+	CPPUNIT_ASSERT(emptyCloud.getZCoordinates() == 0);
+
+	CPPUNIT_ASSERT_EQUAL(8u, pointCloudCube->getSize());
+
+	/* copy constructor duplicates the columns */
+	PointCloud3DContiguous cubeCopy(*pointCloudCube);
+	CPPUNIT_ASSERT_EQUAL(8u, cubeCopy.getSize());
+	CPPUNIT_ASSERT(cubeCopy.getXCoordinates() != pointCloudCube->getXCoordinates());
+
+	pointCloudCube->clear();
+	CPPUNIT_ASSERT_EQUAL(0u, pointCloudCube->getSize());
+	CPPUNIT_ASSERT_EQUAL(8u, cubeCopy.getSize());
+}
+
+void PointCloud3DContiguousTest::testContent() {
+	Point3D resultPoint = pointCloudCube->getPoint(2);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, resultPoint.getX(), maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, resultPoint.getY(), maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, resultPoint.getZ(), maxTolerance);
+
+	resultPoint = pointCloudCube->getPoint(7);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, resultPoint.getX(), maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, resultPoint.getY(), maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, resultPoint.getZ(), maxTolerance);
+
+	/* raw columns */
+	Coordinate* x = pointCloudCube->getXCoordinates();
+	Coordinate* y = pointCloudCube->getYCoordinates();
+	Coordinate* z = pointCloudCube->getZCoordinates();
+	CPPUNIT_ASSERT(x != 0);
+	CPPUNIT_ASSERT(y != 0);
+	CPPUNIT_ASSERT(z != 0);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, x[4], maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, y[4], maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, z[4], maxTolerance);
+
+	/* write through the raw columns */
+	x[4] = 10.0;
+	y[4] = 20.0;
+	z[4] = 30.0;
+	resultPoint = pointCloudCube->getPoint(4);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(10.0, resultPoint.getX(), maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(20.0, resultPoint.getY(), maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(30.0, resultPoint.getZ(), maxTolerance);
+
+	pointCloudCube->setPoint(4, Point3D(-1,-2,-3));
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(-1.0, x[4], maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(-2.0, y[4], maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(-3.0, z[4], maxTolerance);
+}
+
+void PointCloud3DContiguousTest::testConversion() {
+	PointCloud3D* legacyCloud = new PointCloud3D();
+	legacyCloud->addPoint(Point3D(1,2,3));
+	legacyCloud->addPointPtr(new ColoredPoint3D(new Point3D(4,5,6), 255, 0, 0));
+
+	PointCloud3DContiguous contiguousCloud;
+	contiguousCloud.addPoint(100, 100, 100); // will be replaced
+	contiguousCloud.copyFrom(legacyCloud);
+	CPPUNIT_ASSERT_EQUAL(2u, contiguousCloud.getSize());
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, contiguousCloud.getXCoordinates()[0], maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(2.0, contiguousCloud.getYCoordinates()[0], maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0, contiguousCloud.getZCoordinates()[0], maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(4.0, contiguousCloud.getXCoordinates()[1], maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(5.0, contiguousCloud.getYCoordinates()[1], maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(6.0, contiguousCloud.getZCoordinates()[1], maxTolerance);
+
+	PointCloud3D* resultCloud = new PointCloud3D();
+	pointCloudCube->copyTo(resultCloud);
+	CPPUNIT_ASSERT_EQUAL(8u, resultCloud->getSize());
+	for (unsigned int i = 0; i < resultCloud->getSize(); ++i) {
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(pointCloudCube->getXCoordinates()[i], (*resultCloud->getPointCloud())[i].getX(), maxTolerance);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(pointCloudCube->getYCoordinates()[i], (*resultCloud->getPointCloud())[i].getY(), maxTolerance);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(pointCloudCube->getZCoordinates()[i], (*resultCloud->getPointCloud())[i].getZ(), maxTolerance);
+	}
+
+	delete resultCloud;
+	delete legacyCloud;
+}
+
+void PointCloud3DContiguousTest::testBulkInsertion() {
+	PointCloud3DContiguous pointCloud;
+	pointCloud.reserve(4);
+	CPPUNIT_ASSERT_EQUAL(0u, pointCloud.getSize());
+
+	double xyzBuffer[] = {1,2,3, 4,5,6};
+	pointCloud.addPoints(xyzBuffer, 2);
+	float xyzFloatBuffer[] = {7,8,9, 10,11,12};
+	pointCloud.addPoints(xyzFloatBuffer, 2);
+	CPPUNIT_ASSERT_EQUAL(4u, pointCloud.getSize());
+
+	for (unsigned int i = 0; i < pointCloud.getSize(); ++i) {
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0 * i + 1, pointCloud.getXCoordinates()[i], maxTolerance);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0 * i + 2, pointCloud.getYCoordinates()[i], maxTolerance);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0 * i + 3, pointCloud.getZCoordinates()[i], maxTolerance);
+	}
+
+	/* adopt columns without copying them */
+	std::vector<Coordinate> x(3, 1.0);
+	std::vector<Coordinate> y(3, 2.0);
+	std::vector<Coordinate> z(3, 3.0);
+	const Coordinate* adoptedData = &x[0];
+	pointCloud.adoptCoordinates(x, y, z);
+	CPPUNIT_ASSERT_EQUAL(3u, pointCloud.getSize());
+	CPPUNIT_ASSERT(adoptedData == pointCloud.getXCoordinates());
+	CPPUNIT_ASSERT_EQUAL(4u, static_cast<unsigned int>(x.size())); // previous content
+
+	std::vector<Coordinate> tooShort(2, 0.0);
+	CPPUNIT_ASSERT_THROW(pointCloud.adoptCoordinates(x, y, tooShort), std::runtime_error);
+	CPPUNIT_ASSERT_EQUAL(3u, pointCloud.getSize());
+}
+
+void PointCloud3DContiguousTest::testTransformation() {
+
+	/* rotate 90° about X and translate */
+	AngleAxis<double> rotation(M_PI_2, Vector3d(1,0,0));
+	transformation = rotation;
+	transformation.translation() = Vector3d(1,2,3);
+	IHomogeneousMatrix44* homogeneousTransformation = new HomogeneousMatrix44(&transformation);
+
+	/* reference: the per point transformation of a PointCloud3D */
+	PointCloud3D* referenceCloud = new PointCloud3D();
+	pointCloudCube->copyTo(referenceCloud);
+	referenceCloud->homogeneousTransformation(homogeneousTransformation);
+
+	pointCloudCube->homogeneousTransformation(homogeneousTransformation);
+	CPPUNIT_ASSERT_EQUAL(8u, pointCloudCube->getSize());
+
+	for (unsigned int i = 0; i < pointCloudCube->getSize(); ++i) {
+		Point3D resultPoint = pointCloudCube->getPoint(i);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL((*referenceCloud->getPointCloud())[i].getX(), resultPoint.getX(), maxTolerance);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL((*referenceCloud->getPointCloud())[i].getY(), resultPoint.getY(), maxTolerance);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL((*referenceCloud->getPointCloud())[i].getZ(), resultPoint.getZ(), maxTolerance);
+	}
+
+	/* point (0,0,1) rotated about X is (0,-1,0), then shifted */
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, pointCloudCube->getXCoordinates()[1], maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, pointCloudCube->getYCoordinates()[1], maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0, pointCloudCube->getZCoordinates()[1], maxTolerance);
+
+	delete referenceCloud;
+	delete homogeneousTransformation;
+}
+
+void PointCloud3DContiguousTest::testTransformationKernel() {
+	HomogeneousMatrix44 homogeneousTransformation(1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 1.0, 2.0, 3.0);
+
+	/* odd number of points to cover the non SIMD remainder as well */
+	const unsigned int count = 11;
+	Coordinate x[count], y[count], z[count];
+	Coordinate xResult[count], yResult[count], zResult[count];
+	for (unsigned int i = 0; i < count; ++i) {
+		x[i] = i;
+		y[i] = -2.0 * i;
+		z[i] = 0.5 * i + 1;
+	}
+
+	HomogeneousTransformationKernel::transform(homogeneousTransformation.getRawData(), x, y, z, xResult, yResult, zResult, count);
+	for (unsigned int i = 0; i < count; ++i) {
+		Point3D referencePoint(x[i], y[i], z[i]);
+		referencePoint.homogeneousTransformation(&homogeneousTransformation);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(referencePoint.getX(), xResult[i], maxTolerance);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(referencePoint.getY(), yResult[i], maxTolerance);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(referencePoint.getZ(), zResult[i], maxTolerance);
+	}
+
+	/* in place version */
+	HomogeneousTransformationKernel::transform(homogeneousTransformation.getRawData(), x, y, z, count);
+	for (unsigned int i = 0; i < count; ++i) {
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(xResult[i], x[i], maxTolerance);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(yResult[i], y[i], maxTolerance);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(zResult[i], z[i], maxTolerance);
+	}
+
+	/* large cloud that might be processed by multiple threads */
+	PointCloud3DContiguous largeCloud;
+	unsigned int largeCount = HomogeneousTransformationKernel::parallelThreshold + 3;
+	for (unsigned int i = 0; i < largeCount; ++i) {
+		largeCloud.addPoint(i, i % 7, -1.0 * i);
+	}
+	largeCloud.homogeneousTransformation(&homogeneousTransformation);
+	CPPUNIT_ASSERT_EQUAL(largeCount, largeCloud.getSize());
+	unsigned int testIndices[] = {0, 1, largeCount / 2, largeCount - 2, largeCount - 1};
+	for (unsigned int j = 0; j < 5; ++j) {
+		unsigned int i = testIndices[j];
+		Point3D referencePoint(i, i % 7, -1.0 * i);
+		referencePoint.homogeneousTransformation(&homogeneousTransformation);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(referencePoint.getX(), largeCloud.getXCoordinates()[i], maxTolerance);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(referencePoint.getY(), largeCloud.getYCoordinates()[i], maxTolerance);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(referencePoint.getZ(), largeCloud.getZCoordinates()[i], maxTolerance);
+	}
+}
+
+void PointCloud3DContiguousTest::testIterator() {
+	PointCloud3DContiguous::PointCloud3DContiguousPtr cloud1(new PointCloud3DContiguous());
+	cloud1->addPoint(1,2,3);
+	cloud1->addPoint(4,5,6);
+	PointCloud3DContiguous::PointCloud3DContiguousPtr emptyCloud(new PointCloud3DContiguous());
+	PointCloud3DContiguous::PointCloud3DContiguousPtr cloud2(new PointCloud3DContiguous());
+	cloud2->addPoint(7,8,9);
+
+	IHomogeneousMatrix44::IHomogeneousMatrix44Ptr shift100(new HomogeneousMatrix44(1,0,0, 0,1,0, 0,0,1, 100,100,100));
+
+	PointCloud3DContiguousIterator it;
+	CPPUNIT_ASSERT(it.end());
+	it.insert(cloud1);
+	it.insert(emptyCloud);
+	it.insert(cloud2, shift100);
+	CPPUNIT_ASSERT_EQUAL(std::string("brics_3d::PointCloud3DContiguous"), it.getPointCloudTypeName());
+
+	Coordinate expectedX[] = {1, 4, 107};
+	Coordinate expectedRawX[] = {1, 4, 7};
+	unsigned int count = 0;
+	for (it.begin(); !it.end(); it.next()) {
+		CPPUNIT_ASSERT(count < 3u);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(expectedX[count], it.getX(), maxTolerance);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(expectedRawX[count], it.getRawData()->getX(), maxTolerance);
+		count++;
+	}
+	CPPUNIT_ASSERT_EQUAL(3u, count);
+
+	it.begin();
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, it.getX(), maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(2.0, it.getY(), maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0, it.getZ(), maxTolerance);
+}
+
+void PointCloud3DContiguousTest::testBlockIterator() {
+	PointCloud3DContiguous::PointCloud3DContiguousPtr cloud1(new PointCloud3DContiguous());
+	PointCloud3D::PointCloud3DPtr legacyCloud1(new PointCloud3D());
+	for (int i = 0; i < 5; ++i) {
+		cloud1->addPoint(i, 2*i, 3*i);
+		legacyCloud1->addPoint(Point3D(i, 2*i, 3*i));
+	}
+	PointCloud3DContiguous::PointCloud3DContiguousPtr emptyCloud(new PointCloud3DContiguous());
+	PointCloud3D::PointCloud3DPtr legacyEmptyCloud(new PointCloud3D());
+	PointCloud3DContiguous::PointCloud3DContiguousPtr cloud2(new PointCloud3DContiguous());
+	PointCloud3D::PointCloud3DPtr legacyCloud2(new PointCloud3D());
+	for (int i = 0; i < 4; ++i) {
+		cloud2->addPoint(-i, 0.5*i, 7);
+		legacyCloud2->addPoint(Point3D(-i, 0.5*i, 7));
+	}
+
+	IHomogeneousMatrix44::IHomogeneousMatrix44Ptr rotateAndShift(new HomogeneousMatrix44(0.5,0.8660254,0, -0.8660254,0.5,0, 0,0,1, 1,-2,3));
+
+	PointCloud3DContiguousIterator it;
+	it.insert(cloud1);
+	it.insert(emptyCloud);
+	it.insert(cloud2, rotateAndShift);
+	PointCloud3DIterator legacyIt; // orders the clouds by their pointers
+	legacyIt.insert(legacyCloud1);
+	legacyIt.insert(legacyEmptyCloud);
+	legacyIt.insert(legacyCloud2, rotateAndShift);
+
+	IPoint3DIterator* iterators[] = {&it, &legacyIt};
+	for (int k = 0; k < 2; ++k) {
+		IPoint3DIterator* iterator = iterators[k];
+
+		/* reference values via the point wise interface */
+		std::vector<Coordinate> expected;
+		for (iterator->begin(); !iterator->end(); iterator->next()) {
+			expected.push_back(iterator->getX());
+			expected.push_back(iterator->getY());
+			expected.push_back(iterator->getZ());
+		}
+		CPPUNIT_ASSERT_EQUAL(27u, static_cast<unsigned int>(expected.size()));
+
+		/* blocks that do not match the cloud boundaries */
+		const unsigned int blockSize = 2;
+		Coordinate xyz[3 * blockSize];
+		std::vector<Coordinate> result;
+		unsigned int count;
+		for (iterator->begin(); (count = iterator->nextBlock(blockSize, xyz)) > 0; ) {
+			CPPUNIT_ASSERT(count <= blockSize);
+			result.insert(result.end(), xyz, xyz + 3 * count);
+		}
+		CPPUNIT_ASSERT(iterator->end());
+		CPPUNIT_ASSERT_EQUAL(expected.size(), result.size());
+		for (unsigned int i = 0; i < expected.size(); ++i) {
+			CPPUNIT_ASSERT_DOUBLES_EQUAL(expected[i], result[i], maxTolerance);
+		}
+
+		/* mixed with next(); one large block returns the rest */
+		Coordinate largeBlock[3 * 20];
+		iterator->begin();
+		CPPUNIT_ASSERT_EQUAL(4u, iterator->nextBlock(4, largeBlock));
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(expected[12], iterator->getX(), maxTolerance); // current point is the 5th
+		iterator->next();
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(expected[15], iterator->getX(), maxTolerance);
+		CPPUNIT_ASSERT_EQUAL(4u, iterator->nextBlock(20, largeBlock));
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(expected[15], largeBlock[0], maxTolerance);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(expected[26], largeBlock[11], maxTolerance);
+		CPPUNIT_ASSERT(iterator->end());
+		CPPUNIT_ASSERT_EQUAL(0u, iterator->nextBlock(20, largeBlock));
+	}
+}
+
+void PointCloud3DContiguousTest::testSinglePrecision() {
+	PointCloud3DContiguousFloat floatCloud;
+	CPPUNIT_ASSERT_EQUAL(0u, floatCloud.getSize());
+
+	/* conversion across precisions */
+	floatCloud.copyFrom(*pointCloudCube);
+	CPPUNIT_ASSERT_EQUAL(8u, floatCloud.getSize());
+	float* x = floatCloud.getXCoordinates();
+	CPPUNIT_ASSERT(x != 0);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, x[4], maxTolerance);
+	Point3D resultPoint = floatCloud.getPoint(2);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, resultPoint.getX(), maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, resultPoint.getY(), maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, resultPoint.getZ(), maxTolerance);
+
+	PointCloud3DContiguous doubleCloud;
+	doubleCloud.copyFrom(floatCloud);
+	CPPUNIT_ASSERT_EQUAL(8u, doubleCloud.getSize());
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, doubleCloud.getXCoordinates()[4], maxTolerance);
+
+	PointCloud3D pointCloud;
+	floatCloud.copyTo(&pointCloud);
+	CPPUNIT_ASSERT_EQUAL(8u, pointCloud.getSize());
+
+	/* transformation with the single precision kernel (odd size to cover the remainder loop) */
+	floatCloud.addPoint(0.5f, 0.25f, -0.75f);
+	HomogeneousMatrix44 homogeneousTransformation(0.5,0.8660254,0, -0.8660254,0.5,0, 0,0,1, 1,-2,3);
+	floatCloud.homogeneousTransformation(&homogeneousTransformation);
+	pointCloudCube->addPoint(0.5, 0.25, -0.75);
+	pointCloudCube->homogeneousTransformation(&homogeneousTransformation);
+	for (unsigned int i = 0; i < floatCloud.getSize(); ++i) {
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(pointCloudCube->getXCoordinates()[i], floatCloud.getXCoordinates()[i], maxTolerance);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(pointCloudCube->getYCoordinates()[i], floatCloud.getYCoordinates()[i], maxTolerance);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(pointCloudCube->getZCoordinates()[i], floatCloud.getZCoordinates()[i], maxTolerance);
+	}
+
+	/* iterator */
+	PointCloud3DContiguousFloat::PointCloud3DContiguousPtr sharedCloud(new PointCloud3DContiguousFloat());
+	sharedCloud->addPoint(1.5f, 2.5f, 3.5f);
+	PointCloud3DContiguousFloatIterator it;
+	it.insert(sharedCloud);
+	CPPUNIT_ASSERT_EQUAL(std::string("brics_3d::PointCloud3DContiguousFloat"), it.getPointCloudTypeName());
+	it.begin();
+	CPPUNIT_ASSERT(!it.end());
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(2.5, it.getY(), maxTolerance);
+	it.next();
+	CPPUNIT_ASSERT(it.end());
+}
+
+void PointCloud3DContiguousTest::testAttributes() {
+	CPPUNIT_ASSERT(!pointCloudCube->hasColors());
+	CPPUNIT_ASSERT(!pointCloudCube->hasNormals());
+	CPPUNIT_ASSERT(!pointCloudCube->hasIntensities());
+	CPPUNIT_ASSERT(pointCloudCube->getColors() == 0);
+
+	/* enabling a channel fills it for the existing points */
+	pointCloudCube->enableColors();
+	CPPUNIT_ASSERT(pointCloudCube->hasColors());
+	CPPUNIT_ASSERT(pointCloudCube->getColors() != 0);
+	CPPUNIT_ASSERT_EQUAL(0, static_cast<int>(pointCloudCube->getColors()[3 * 7 + 2]));
+	pointCloudCube->setColor(1, 10, 20, 30);
+	pointCloudCube->setIntensity(2, 0.5f);
+	pointCloudCube->setNormal(3, 1.0f, 0.0f, 0.0f);
+	CPPUNIT_ASSERT(pointCloudCube->hasIntensities());
+	CPPUNIT_ASSERT(pointCloudCube->hasNormals());
+
+	/* new points get zero attributes */
+	pointCloudCube->addPoint(2, 2, 2);
+	CPPUNIT_ASSERT_EQUAL(9u, pointCloudCube->getSize());
+	CPPUNIT_ASSERT_EQUAL(0, static_cast<int>(pointCloudCube->getColors()[3 * 8 + 0]));
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, pointCloudCube->getIntensities()[8], maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, pointCloudCube->getNormals()[3 * 8 + 0], maxTolerance);
+
+	/* conversion to decorated points and back */
+	PointCloud3D decoratedCloud;
+	pointCloudCube->copyTo(&decoratedCloud);
+	CPPUNIT_ASSERT_EQUAL(9u, decoratedCloud.getSize());
+	ColoredPoint3D* coloredPoint = (*decoratedCloud.getPointCloud())[1].asColoredPoint3D();
+	CPPUNIT_ASSERT(coloredPoint != 0);
+	CPPUNIT_ASSERT_EQUAL(20, static_cast<int>(coloredPoint->getG()));
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, coloredPoint->getX(), maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, coloredPoint->getY(), maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, coloredPoint->getZ(), maxTolerance);
+	Point3DIntensity* intensityPoint = getPointType<Point3DIntensity>(&(*decoratedCloud.getPointCloud())[2]);
+	CPPUNIT_ASSERT(intensityPoint != 0);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.5, intensityPoint->getIntensity(), maxTolerance);
+	Point3DNormal* normalPoint = getPointType<Point3DNormal>(&(*decoratedCloud.getPointCloud())[3]);
+	CPPUNIT_ASSERT(normalPoint != 0);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, normalPoint->getNormal().getX(), maxTolerance);
+
+	PointCloud3DContiguous roundTrip;
+	roundTrip.copyFrom(&decoratedCloud);
+	CPPUNIT_ASSERT_EQUAL(9u, roundTrip.getSize());
+	CPPUNIT_ASSERT(roundTrip.hasColors());
+	CPPUNIT_ASSERT(roundTrip.hasNormals());
+	CPPUNIT_ASSERT(roundTrip.hasIntensities());
+	for (unsigned int i = 0; i < 3 * roundTrip.getSize(); ++i) {
+		CPPUNIT_ASSERT_EQUAL(pointCloudCube->getColors()[i], roundTrip.getColors()[i]);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(pointCloudCube->getNormals()[i], roundTrip.getNormals()[i], maxTolerance);
+	}
+	for (unsigned int i = 0; i < roundTrip.getSize(); ++i) {
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(pointCloudCube->getIntensities()[i], roundTrip.getIntensities()[i], maxTolerance);
+	}
+
+	/* a plain point cloud has no channels */
+	PointCloud3D plainCloud;
+	plainCloud.addPoint(1, 2, 3);
+	roundTrip.copyFrom(&plainCloud);
+	CPPUNIT_ASSERT_EQUAL(1u, roundTrip.getSize());
+	CPPUNIT_ASSERT(!roundTrip.hasColors());
+	CPPUNIT_ASSERT(!roundTrip.hasNormals());
+	CPPUNIT_ASSERT(!roundTrip.hasIntensities());
+
+	/* normals are rotated, but not translated */
+	HomogeneousMatrix44 rotateZ90(0,-1,0, 1,0,0, 0,0,1, 5,6,7);
+	pointCloudCube->homogeneousTransformation(&rotateZ90);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, pointCloudCube->getNormals()[3 * 3 + 0], maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, pointCloudCube->getNormals()[3 * 3 + 1], maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, pointCloudCube->getNormals()[3 * 3 + 2], maxTolerance);
+
+	/* copying single points keeps the attributes */
+	PointCloud3DContiguousFloat subset;
+	PointCloud3DContiguousFloat floatCloud;
+	floatCloud.copyFrom(*pointCloudCube);
+	CPPUNIT_ASSERT(floatCloud.hasColors());
+	subset.addPointFrom(floatCloud, 1);
+	CPPUNIT_ASSERT_EQUAL(1u, subset.getSize());
+	CPPUNIT_ASSERT(subset.hasColors());
+	CPPUNIT_ASSERT_EQUAL(30, static_cast<int>(subset.getColors()[2]));
+
+	/* clear keeps the channels, disableAttributes removes them */
+	subset.clear();
+	CPPUNIT_ASSERT(subset.hasColors());
+	CPPUNIT_ASSERT(subset.getColors() == 0);
+	subset.disableAttributes();
+	CPPUNIT_ASSERT(!subset.hasColors());
+}
+
+}
+
+/* EOF */
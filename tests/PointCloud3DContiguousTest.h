@@ -0,0 +1,78 @@
+/**
+ * @file
+ * PointCloud3DContiguousTest.h
+ *
+ * @date: Oct 17, 2026
+ * @author: sblume
+ */
+
+#ifndef POINTCLOUD3DCONTIGUOUSTEST_H_
+#define POINTCLOUD3DCONTIGUOUSTEST_H_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "brics_3d/core/PointCloud3D.h"
+#include "brics_3d/core/PointCloud3DContiguous.h"
+#include "brics_3d/core/PointCloud3DContiguousIterator.h"
+#include "brics_3d/core/PointCloud3DIterator.h"
+#include "brics_3d/core/HomogeneousMatrix44.h"
+#include "brics_3d/core/HomogeneousTransformationKernel.h"
+
+using namespace std;
+using namespace brics_3d;
+using namespace Eigen;
+
+namespace unitTests {
+
+/**
+ * @brief UnitTest for the PointCloud3DContiguous class
+ */
+class PointCloud3DContiguousTest: public CPPUNIT_NS::TestFixture {
+
+	CPPUNIT_TEST_SUITE( PointCloud3DContiguousTest );
+	CPPUNIT_TEST( testConstructor );
+	CPPUNIT_TEST( testContent );
+	CPPUNIT_TEST( testConversion );
+	CPPUNIT_TEST( testBulkInsertion );
+	CPPUNIT_TEST( testTransformation );
+	CPPUNIT_TEST( testTransformationKernel );
+	CPPUNIT_TEST( testIterator );
+	CPPUNIT_TEST( testBlockIterator );
+	CPPUNIT_TEST( testSinglePrecision );
+	CPPUNIT_TEST( testAttributes );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	  void setUp();
+	  void tearDown();
+
+	  void testConstructor();
+	  void testContent();
+	  void testConversion();
+	  void testBulkInsertion();
+	  void testTransformation();
+	  void testTransformationKernel();
+	  void testIterator();
+	  void testBlockIterator();
+	  void testSinglePrecision();
+	  void testAttributes();
+
+	  EIGEN_MAKE_ALIGNED_OPERATOR_NEW //Required by Eigen2
+
+private:
+
+	  /// Simple cube with 8 points
+	  PointCloud3DContiguous* pointCloudCube;
+
+	  static const double maxTolerance = 0.00001;
+
+	  /// Eigen2 container for homogeneous transformations
+	  Transform3d transformation;
+};
+
+}
+
+#endif /* POINTCLOUD3DCONTIGUOUSTEST_H_ */
+
+/* EOF */
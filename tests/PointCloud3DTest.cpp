@@ -274,6 +274,49 @@ void PointCloud3DTest::testTransformation() {
 	delete homogeneousTransformation;
 }
 
+void PointCloud3DTest::testBulkInsertion() {
+	PointCloud3D pointCloud;
+	pointCloud.reserve(5);
+	CPPUNIT_ASSERT_EQUAL(0u, pointCloud.getSize());
+
+	double xyzBuffer[] = {1,2,3, 4,5,6};
+	pointCloud.addPoints(xyzBuffer, 2);
+	CPPUNIT_ASSERT_EQUAL(2u, pointCloud.getSize());
+
+	float xyzFloatBuffer[] = {7,8,9, 10,11,12};
+	pointCloud.addPoints(xyzFloatBuffer, 2);
+	pointCloud.addPoint(13, 14, 15);
+	CPPUNIT_ASSERT_EQUAL(5u, pointCloud.getSize());
+
+	for (unsigned int i = 0; i < pointCloud.getSize(); ++i) {
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0 * i + 1, (*pointCloud.getPointCloud())[i].getX(), maxTolerance);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0 * i + 2, (*pointCloud.getPointCloud())[i].getY(), maxTolerance);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0 * i + 3, (*pointCloud.getPointCloud())[i].getZ(), maxTolerance);
+	}
+
+	/* adopt points without copying them */
+	boost::ptr_vector<Point3D> points;
+	points.push_back(new Point3D(-1,-2,-3));
+	Point3D* adoptedPoint = &points[0];
+	pointCloud.adoptPoints(points);
+	CPPUNIT_ASSERT_EQUAL(6u, pointCloud.getSize());
+	CPPUNIT_ASSERT_EQUAL(0u, static_cast<unsigned int>(points.size()));
+	CPPUNIT_ASSERT(adoptedPoint == &(*pointCloud.getPointCloud())[5]);
+
+	PointCloud3D emptyPointCloud;
+	emptyPointCloud.adoptPoints(*pointCloud.getPointCloud());
+	CPPUNIT_ASSERT_EQUAL(6u, emptyPointCloud.getSize());
+	CPPUNIT_ASSERT_EQUAL(0u, pointCloud.getSize());
+	CPPUNIT_ASSERT(adoptedPoint == &(*emptyPointCloud.getPointCloud())[5]);
+
+	/* setPointCloud takes over the new container */
+	boost::ptr_vector<Point3D>* newPoints = new boost::ptr_vector<Point3D>();
+	newPoints->push_back(new Point3D(1,1,1));
+	pointCloud.setPointCloud(newPoints);
+	CPPUNIT_ASSERT(newPoints == pointCloud.getPointCloud());
+	CPPUNIT_ASSERT_EQUAL(1u, pointCloud.getSize());
+}
+
 }
 
 /* EOF */
@@ -32,6 +32,7 @@ class PointCloud3DTest: public CPPUNIT_NS::TestFixture {
 	//CPPUNIT_TEST( testLimits ); //is time consuming
 	CPPUNIT_TEST( testStreaming );
 	CPPUNIT_TEST( testTransformation );
+	CPPUNIT_TEST( testBulkInsertion );
 	CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -43,6 +44,7 @@ public:
 	  void testLimits();
 	  void testStreaming();
 	  void testTransformation();
+	  void testBulkInsertion();
 
 	  EIGEN_MAKE_ALIGNED_OPERATOR_NEW //Required by Eigen2
 
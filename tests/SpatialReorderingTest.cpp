@@ -0,0 +1,172 @@
+/**
+ * @file 
+ * SpatialReorderingTest.cpp
+ *
+ * @date: Oct 17, 2026
+ * @author: sblume
+ */
+
+#include "SpatialReorderingTest.h"
+#include "brics_3d/core/ColoredPoint3D.h"
+#include <cmath>
+#include <limits>
+
+namespace unitTests {
+
+CPPUNIT_TEST_SUITE_REGISTRATION( SpatialReorderingTest );
+
+void SpatialReorderingTest::setUp() {
+
+}
+
+void SpatialReorderingTest::tearDown() {
+
+}
+
+void SpatialReorderingTest::createScrambledGrid(unsigned int size, PointCloud3D* pointCloud) {
+	unsigned int numberOfCells = size * size * size;
+	for (unsigned int i = 0; i < numberOfCells; ++i) {
+		unsigned int cell = (i * 37) % numberOfCells; // 37 is coprime to 2^n, so every cell is visited once
+		pointCloud->addPoint(Point3D(cell % size, (cell / size) % size, cell / (size * size)));
+	}
+}
+
+void SpatialReorderingTest::testCodes() {
+	CPPUNIT_ASSERT_EQUAL(static_cast<boost::uint64_t>(0), SpatialReordering::mortonCode(0, 0, 0));
+	CPPUNIT_ASSERT_EQUAL(static_cast<boost::uint64_t>(4), SpatialReordering::mortonCode(1, 0, 0));
+	CPPUNIT_ASSERT_EQUAL(static_cast<boost::uint64_t>(2), SpatialReordering::mortonCode(0, 1, 0));
+	CPPUNIT_ASSERT_EQUAL(static_cast<boost::uint64_t>(1), SpatialReordering::mortonCode(0, 0, 1));
+	CPPUNIT_ASSERT_EQUAL(static_cast<boost::uint64_t>(7 << 3), SpatialReordering::mortonCode(2, 2, 2));
+	boost::uint32_t maxCell = (1u << SpatialReordering::maxBitsPerAxis) - 1;
+	CPPUNIT_ASSERT_EQUAL((static_cast<boost::uint64_t>(1) << 63) - 1, SpatialReordering::mortonCode(maxCell, maxCell, maxCell));
+
+	/* the Hilbert curve is a bijection on the grid */
+	std::vector<bool> isUsed(512, false);
+	for (boost::uint32_t x = 0; x < 8; ++x) {
+		for (boost::uint32_t y = 0; y < 8; ++y) {
+			for (boost::uint32_t z = 0; z < 8; ++z) {
+				boost::uint64_t code = SpatialReordering::hilbertCode(x, y, z, 3);
+				CPPUNIT_ASSERT(code < 512);
+				CPPUNIT_ASSERT(!isUsed[code]);
+				isUsed[code] = true;
+			}
+		}
+	}
+	CPPUNIT_ASSERT_EQUAL(static_cast<boost::uint64_t>(0), SpatialReordering::hilbertCode(0, 0, 0, 3));
+
+	CPPUNIT_ASSERT_THROW(SpatialReordering(SpatialReordering::mortonOrder, 0), std::runtime_error);
+	CPPUNIT_ASSERT_THROW(SpatialReordering(SpatialReordering::mortonOrder, 22), std::runtime_error);
+}
+
+void SpatialReorderingTest::testMortonOrder() {
+	PointCloud3D pointCloud;
+	createScrambledGrid(8, &pointCloud);
+	pointCloud.addPoint(Point3D(std::numeric_limits<double>::quiet_NaN(), 0, 0)); // invalid points are moved to the end
+
+	SpatialReordering reordering(SpatialReordering::mortonOrder, 3);
+	std::vector<unsigned int> permutation;
+	reordering.computePermutation(&pointCloud, &permutation);
+	CPPUNIT_ASSERT_EQUAL(pointCloud.getSize(), static_cast<unsigned int>(permutation.size()));
+	CPPUNIT_ASSERT_EQUAL(512u, permutation[512]);
+
+	/* every aligned block of 8 codes is a 2x2x2 cube */
+	for (unsigned int block = 0; block < 512; block += 8) {
+		const Point3D& first = (*pointCloud.getPointCloud())[permutation[block]];
+		for (unsigned int i = 1; i < 8; ++i) {
+			const Point3D& point = (*pointCloud.getPointCloud())[permutation[block + i]];
+			CPPUNIT_ASSERT_DOUBLES_EQUAL(std::floor(first.getX() / 2), std::floor(point.getX() / 2), maxTolerance);
+			CPPUNIT_ASSERT_DOUBLES_EQUAL(std::floor(first.getY() / 2), std::floor(point.getY() / 2), maxTolerance);
+			CPPUNIT_ASSERT_DOUBLES_EQUAL(std::floor(first.getZ() / 2), std::floor(point.getZ() / 2), maxTolerance);
+		}
+	}
+	const Point3D& origin = (*pointCloud.getPointCloud())[permutation[0]];
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, origin.getX() + origin.getY() + origin.getZ(), maxTolerance);
+}
+
+void SpatialReorderingTest::testHilbertOrder() {
+	PointCloud3D pointCloud;
+	createScrambledGrid(8, &pointCloud);
+
+	SpatialReordering reordering(SpatialReordering::hilbertOrder, 3);
+	reordering.reorder(&pointCloud);
+
+	/* consecutive points are direct neighbors in the grid */
+	boost::ptr_vector<Point3D>& points = *pointCloud.getPointCloud();
+	for (unsigned int i = 1; i < points.size(); ++i) {
+		double manhattanDistance = std::fabs(points[i].getX() - points[i - 1].getX()) +
+				std::fabs(points[i].getY() - points[i - 1].getY()) +
+				std::fabs(points[i].getZ() - points[i - 1].getZ());
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, manhattanDistance, maxTolerance);
+	}
+}
+
+void SpatialReorderingTest::testReorderPointCloud3D() {
+	PointCloud3D pointCloud;
+	for (int i = 0; i < 100; ++i) {
+		double x = (i * 17) % 100;
+		pointCloud.addPointPtr(new ColoredPoint3D(new Point3D(x, 0.5 * x, 0), static_cast<unsigned char>(x), 0, 0));
+	}
+	PointCloud3D original;
+	for (unsigned int i = 0; i < pointCloud.getSize(); ++i) {
+		original.addPointPtr((*pointCloud.getPointCloud())[i].clone());
+	}
+
+	SpatialReordering reordering;
+	std::vector<unsigned int> permutation;
+	std::vector<unsigned int> inverse;
+	for (int relocate = 0; relocate < 2; ++relocate) {
+		reordering.setRelocatePoints(relocate != 0);
+		reordering.reorder(&pointCloud, &permutation);
+		CPPUNIT_ASSERT_EQUAL(100u, pointCloud.getSize());
+		SpatialReordering::invertPermutation(permutation, &inverse);
+
+		/* the Morton order is monotone in every coordinate, decorations move with the points */
+		for (unsigned int i = 0; i < pointCloud.getSize(); ++i) {
+			Point3D& point = (*pointCloud.getPointCloud())[i];
+			CPPUNIT_ASSERT_DOUBLES_EQUAL(static_cast<double>(i), point.getX(), maxTolerance);
+			CPPUNIT_ASSERT(point.asColoredPoint3D() != 0);
+			CPPUNIT_ASSERT_EQUAL(static_cast<int>(i), static_cast<int>(point.asColoredPoint3D()->getR()));
+			CPPUNIT_ASSERT_EQUAL(i, inverse[permutation[i]]);
+		}
+
+		/* restore the original order */
+		SpatialReordering::applyPermutation(inverse, &pointCloud, relocate != 0);
+		for (unsigned int i = 0; i < pointCloud.getSize(); ++i) {
+			CPPUNIT_ASSERT_DOUBLES_EQUAL((*original.getPointCloud())[i].getX(), (*pointCloud.getPointCloud())[i].getX(), maxTolerance);
+		}
+	}
+
+	PointCloud3D emptyPointCloud;
+	reordering.reorder(&emptyPointCloud, &permutation);
+	CPPUNIT_ASSERT_EQUAL(0u, static_cast<unsigned int>(permutation.size()));
+}
+
+void SpatialReorderingTest::testReorderContiguous() {
+	PointCloud3DContiguousFloat pointCloud;
+	for (int i = 0; i < 64; ++i) {
+		float z = static_cast<float>((i * 5) % 64);
+		pointCloud.addPoint(Point3D(1, 2, z));
+		pointCloud.setColor(i, 0, 0, static_cast<unsigned char>(z));
+		pointCloud.setNormal(i, 0, z, 0);
+		pointCloud.setIntensity(i, -z);
+	}
+	std::vector<float> userData(pointCloud.getIntensities(), pointCloud.getIntensities() + pointCloud.getSize());
+
+	SpatialReordering reordering;
+	std::vector<unsigned int> permutation;
+	reordering.reorder(pointCloud, &permutation);
+	SpatialReordering::permute(permutation, userData);
+
+	for (unsigned int i = 0; i < pointCloud.getSize(); ++i) {
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(static_cast<double>(i), pointCloud.getZCoordinates()[i], maxTolerance);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, pointCloud.getXCoordinates()[i], maxTolerance);
+		CPPUNIT_ASSERT_EQUAL(static_cast<int>(i), static_cast<int>(pointCloud.getColors()[3 * i + 2]));
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(static_cast<double>(i), pointCloud.getNormals()[3 * i + 1], maxTolerance);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(-static_cast<double>(i), pointCloud.getIntensities()[i], maxTolerance);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(-static_cast<double>(i), userData[i], maxTolerance);
+	}
+}
+
+}
+
+/* EOF */
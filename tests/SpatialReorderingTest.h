@@ -0,0 +1,54 @@
+/**
+ * @file 
+ * SpatialReorderingTest.h
+ *
+ * @date: Oct 17, 2026
+ * @author: sblume
+ */
+
+#ifndef SPATIALREORDERINGTEST_H_
+#define SPATIALREORDERINGTEST_H_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "brics_3d/core/SpatialReordering.h"
+
+using namespace std;
+using namespace brics_3d;
+
+namespace unitTests {
+
+class SpatialReorderingTest : public CPPUNIT_NS::TestFixture {
+
+	CPPUNIT_TEST_SUITE( SpatialReorderingTest );
+	CPPUNIT_TEST( testCodes );
+	CPPUNIT_TEST( testMortonOrder );
+	CPPUNIT_TEST( testHilbertOrder );
+	CPPUNIT_TEST( testReorderPointCloud3D );
+	CPPUNIT_TEST( testReorderContiguous );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp();
+	void tearDown();
+
+	void testCodes();
+	void testMortonOrder();
+	void testHilbertOrder();
+	void testReorderPointCloud3D();
+	void testReorderContiguous();
+
+private:
+
+	/// Add the cells of a size^3 grid in scrambled order.
+	void createScrambledGrid(unsigned int size, PointCloud3D* pointCloud);
+
+	static const double maxTolerance = 0.00001;
+};
+
+}
+
+#endif /* SPATIALREORDERINGTEST_H_ */
+
+/* EOF */
@@ -0,0 +1,241 @@
+/**
+ * @file 
+ * SubsamplingTest.cpp
+ *
+ * @date: Oct 17, 2026
+ * @author: sblume
+ */
+
+#include "SubsamplingTest.h"
+#include "brics_3d/core/ColoredPoint3D.h"
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace unitTests {
+
+CPPUNIT_TEST_SUITE_REGISTRATION( SubsamplingTest );
+
+void SubsamplingTest::setUp() {
+	pointCloud = new PointCloud3D();
+	for (int i = 0; i < 1000; ++i) {
+		pointCloud->addPointPtr(new ColoredPoint3D(new Point3D(i, i * 0.5, 0.0), 1, 2, 3));
+	}
+}
+
+void SubsamplingTest::tearDown() {
+	delete pointCloud;
+}
+
+void SubsamplingTest::filterInChunks(SubsamplingFilter* filter, unsigned int chunkSize, PointCloud3D* result) {
+	filter->reset();
+	for (unsigned int begin = 0; begin < pointCloud->getSize(); begin += chunkSize) {
+		PointCloud3D chunk;
+		for (unsigned int i = begin; i < begin + chunkSize && i < pointCloud->getSize(); ++i) {
+			chunk.addPointPtr((*pointCloud->getPointCloud())[i].clone());
+		}
+		filter->addChunk(&chunk, result);
+	}
+	filter->finish(result);
+	CPPUNIT_ASSERT_EQUAL(static_cast<boost::uint64_t>(pointCloud->getSize()), filter->getNumberOfProcessedPoints());
+}
+
+void SubsamplingTest::testRandomNumberGenerator() {
+	RandomNumberGenerator generator1(42);
+	RandomNumberGenerator generator2(42);
+	RandomNumberGenerator generator3(43);
+	bool isDifferent = false;
+	for (int i = 0; i < 100; ++i) {
+		boost::uint64_t value = generator1.nextUInt64();
+		CPPUNIT_ASSERT(value == generator2.nextUInt64());
+		isDifferent |= (value != generator3.nextUInt64());
+	}
+	CPPUNIT_ASSERT(isDifferent);
+
+	/* restart of the sequence */
+	generator1.setSeed(7);
+	boost::uint64_t firstValue = generator1.nextUInt64();
+	generator1.setSeed(7);
+	CPPUNIT_ASSERT(firstValue == generator1.nextUInt64());
+
+	/* ranges and a rough check of the distribution */
+	RandomNumberGenerator generator(0);
+	std::vector<int> histogram(10, 0);
+	for (int i = 0; i < 100000; ++i) {
+		boost::uint32_t value = generator.nextUInt(10);
+		CPPUNIT_ASSERT(value < 10);
+		histogram[value]++;
+		double uniform = generator.nextDouble();
+		CPPUNIT_ASSERT(uniform >= 0.0 && uniform < 1.0);
+	}
+	for (int i = 0; i < 10; ++i) {
+		CPPUNIT_ASSERT(histogram[i] > 9500 && histogram[i] < 10500);
+	}
+	CPPUNIT_ASSERT_EQUAL(0u, static_cast<unsigned int>(generator.nextUInt(1)));
+	CPPUNIT_ASSERT(generator.nextUInt(std::numeric_limits<boost::uint32_t>::max()) < std::numeric_limits<boost::uint32_t>::max());
+}
+
+void SubsamplingTest::testStrideSubsampling() {
+	CPPUNIT_ASSERT_THROW(StrideSubsampling(0), std::runtime_error);
+	StrideSubsampling stride(7);
+	CPPUNIT_ASSERT_EQUAL(7u, stride.getStride());
+
+	PointCloud3D result;
+	stride.filter(pointCloud, &result);
+	CPPUNIT_ASSERT_EQUAL(143u, result.getSize()); // 0, 7, ..., 994
+	for (unsigned int i = 0; i < result.getSize(); ++i) {
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(7.0 * i, (*result.getPointCloud())[i].getX(), maxTolerance);
+		CPPUNIT_ASSERT((*result.getPointCloud())[i].asColoredPoint3D() != 0);
+	}
+
+	/* chunks that are not aligned with the stride */
+	unsigned int chunkSizes[] = {1, 3, 7, 100, 999};
+	for (int j = 0; j < 5; ++j) {
+		PointCloud3D chunkedResult;
+		filterInChunks(&stride, chunkSizes[j], &chunkedResult);
+		CPPUNIT_ASSERT_EQUAL(result.getSize(), chunkedResult.getSize());
+		for (unsigned int i = 0; i < result.getSize(); ++i) {
+			CPPUNIT_ASSERT_DOUBLES_EQUAL((*result.getPointCloud())[i].getX(), (*chunkedResult.getPointCloud())[i].getX(), maxTolerance);
+		}
+	}
+
+	/* stride 1 keeps everything, the result is appended */
+	stride.setStride(1);
+	stride.filter(pointCloud, &result);
+	CPPUNIT_ASSERT_EQUAL(143u + 1000u, result.getSize());
+}
+
+void SubsamplingTest::testRandomSubsampling() {
+	RandomSubsampling sampling(100, 5);
+	CPPUNIT_ASSERT_EQUAL(100u, sampling.getMaxNumberOfPoints());
+	CPPUNIT_ASSERT(sampling.getSeed() == 5);
+
+	PointCloud3D result;
+	sampling.filter(pointCloud, &result);
+	CPPUNIT_ASSERT_EQUAL(100u, result.getSize());
+	for (unsigned int i = 0; i < result.getSize(); ++i) {
+		Point3D& point = (*result.getPointCloud())[i];
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(point.getX() * 0.5, point.getY(), maxTolerance); // an original point
+		CPPUNIT_ASSERT(point.asColoredPoint3D() != 0);
+		if (i > 0) {
+			CPPUNIT_ASSERT(point.getX() > (*result.getPointCloud())[i - 1].getX()); // order of the stream, no duplicates
+		}
+	}
+	CPPUNIT_ASSERT((*result.getPointCloud())[result.getSize() - 1].getX() > 500.0); // not just the first points
+
+	/* the result only depends on the seed, not on the chunks */
+	unsigned int chunkSizes[] = {1, 13, 100, 333};
+	for (int j = 0; j < 4; ++j) {
+		PointCloud3D chunkedResult;
+		filterInChunks(&sampling, chunkSizes[j], &chunkedResult);
+		CPPUNIT_ASSERT_EQUAL(result.getSize(), chunkedResult.getSize());
+		for (unsigned int i = 0; i < result.getSize(); ++i) {
+			CPPUNIT_ASSERT_DOUBLES_EQUAL((*result.getPointCloud())[i].getX(), (*chunkedResult.getPointCloud())[i].getX(), maxTolerance);
+		}
+	}
+
+	/* another seed gives another sample */
+	sampling.setSeed(6);
+	PointCloud3D otherResult;
+	sampling.filter(pointCloud, &otherResult);
+	CPPUNIT_ASSERT_EQUAL(100u, otherResult.getSize());
+	bool isDifferent = false;
+	for (unsigned int i = 0; i < result.getSize(); ++i) {
+		isDifferent |= ((*result.getPointCloud())[i].getX() != (*otherResult.getPointCloud())[i].getX());
+	}
+	CPPUNIT_ASSERT(isDifferent);
+
+	/* less points than the sample size */
+	sampling.setMaxNumberOfPoints(2000);
+	otherResult.getPointCloud()->clear();
+	sampling.filter(pointCloud, &otherResult);
+	CPPUNIT_ASSERT_EQUAL(1000u, otherResult.getSize());
+
+	sampling.setMaxNumberOfPoints(0);
+	otherResult.getPointCloud()->clear();
+	sampling.filter(pointCloud, &otherResult);
+	CPPUNIT_ASSERT_EQUAL(0u, otherResult.getSize());
+}
+
+void SubsamplingTest::testRandomSubsamplingDistribution() {
+	/* every point has to be selected with probability 1/10 */
+	RandomSubsampling sampling(100);
+	std::vector<int> histogram(10, 0);
+	for (int run = 0; run < 200; ++run) {
+		sampling.setSeed(run);
+		PointCloud3D result;
+		sampling.filter(pointCloud, &result);
+		CPPUNIT_ASSERT_EQUAL(100u, result.getSize());
+		for (unsigned int i = 0; i < result.getSize(); ++i) {
+			histogram[static_cast<int>((*result.getPointCloud())[i].getX()) / 100]++; // 2000 expected per bin
+		}
+	}
+	for (int i = 0; i < 10; ++i) {
+		CPPUNIT_ASSERT(histogram[i] > 1800 && histogram[i] < 2200);
+	}
+
+	/* a long stream of small chunks with a small sample moves the reservoir into new memory several times */
+	sampling.setMaxNumberOfPoints(5);
+	sampling.reset();
+	PointCloud3D chunk;
+	for (int i = 0; i < 10; ++i) {
+		chunk.addPointPtr(new ColoredPoint3D(new Point3D(i, 0.0, 0.0), 1, 2, 3));
+	}
+	PointCloud3D result;
+	for (int run = 0; run < 5000; ++run) {
+		sampling.addChunk(&chunk, &result);
+	}
+	CPPUNIT_ASSERT_EQUAL(0u, result.getSize());
+	sampling.finish(&result);
+	CPPUNIT_ASSERT_EQUAL(5u, result.getSize());
+	for (unsigned int i = 0; i < result.getSize(); ++i) {
+		CPPUNIT_ASSERT((*result.getPointCloud())[i].asColoredPoint3D() != 0);
+		CPPUNIT_ASSERT_EQUAL(2, static_cast<int>((*result.getPointCloud())[i].asColoredPoint3D()->getG()));
+	}
+}
+
+void SubsamplingTest::testMaxPointsPerVoxelSubsampling() {
+	CPPUNIT_ASSERT_THROW(MaxPointsPerVoxelSubsampling(0.0, 1), std::runtime_error);
+	MaxPointsPerVoxelSubsampling voxelSubsampling(10.0, 3);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(10.0, voxelSubsampling.getVoxelSize(), maxTolerance);
+	CPPUNIT_ASSERT_EQUAL(3u, voxelSubsampling.getMaxPointsPerVoxel());
+
+	/* x = 0..999 with a voxel size of 10: 100 voxels, y and z stay in one voxel row */
+	PointCloud3D input;
+	for (int i = 0; i < 1000; ++i) {
+		input.addPoint(Point3D(i, 5.0, -5.0));
+	}
+	input.addPoint(Point3D(std::numeric_limits<double>::quiet_NaN(), 0.0, 0.0));
+	input.addPoint(Point3D(1e30, 0.0, 0.0));
+	PointCloud3D result;
+	voxelSubsampling.filter(&input, &result);
+	CPPUNIT_ASSERT_EQUAL(300u, result.getSize());
+	CPPUNIT_ASSERT_EQUAL(100u, voxelSubsampling.getNumberOfVoxels());
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, (*result.getPointCloud())[0].getX(), maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(2.0, (*result.getPointCloud())[2].getX(), maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(10.0, (*result.getPointCloud())[3].getX(), maxTolerance);
+
+	/* negative coordinates are in other voxels */
+	PointCloud3D mirrored;
+	mirrored.addPoint(Point3D(-0.5, 0.0, 0.0));
+	mirrored.addPoint(Point3D(0.5, 0.0, 0.0));
+	mirrored.addPoint(Point3D(-0.5, 0.0, 0.0));
+	voxelSubsampling.setVoxelSize(1.0);
+	voxelSubsampling.setMaxPointsPerVoxel(1);
+	result.getPointCloud()->clear();
+	voxelSubsampling.filter(&mirrored, &result);
+	CPPUNIT_ASSERT_EQUAL(2u, result.getSize());
+
+	/* streaming: the voxel counts are kept across chunks */
+	voxelSubsampling.setVoxelSize(100.0);
+	voxelSubsampling.setMaxPointsPerVoxel(5);
+	PointCloud3D chunkedResult;
+	filterInChunks(&voxelSubsampling, 3, &chunkedResult);
+	CPPUNIT_ASSERT_EQUAL(50u, chunkedResult.getSize());
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(104.0, (*chunkedResult.getPointCloud())[9].getX(), maxTolerance);
+	CPPUNIT_ASSERT((*chunkedResult.getPointCloud())[9].asColoredPoint3D() != 0);
+}
+
+}
+
+/* EOF */
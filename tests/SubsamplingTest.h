@@ -0,0 +1,60 @@
+/**
+ * @file 
+ * SubsamplingTest.h
+ *
+ * @date: Oct 17, 2026
+ * @author: sblume
+ */
+
+#ifndef SUBSAMPLINGTEST_H_
+#define SUBSAMPLINGTEST_H_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "brics_3d/core/RandomNumberGenerator.h"
+#include "brics_3d/algorithm/filtering/RandomSubsampling.h"
+#include "brics_3d/algorithm/filtering/StrideSubsampling.h"
+#include "brics_3d/algorithm/filtering/MaxPointsPerVoxelSubsampling.h"
+
+using namespace std;
+using namespace brics_3d;
+
+namespace unitTests {
+
+class SubsamplingTest : public CPPUNIT_NS::TestFixture {
+
+	CPPUNIT_TEST_SUITE( SubsamplingTest );
+	CPPUNIT_TEST( testRandomNumberGenerator );
+	CPPUNIT_TEST( testStrideSubsampling );
+	CPPUNIT_TEST( testRandomSubsampling );
+	CPPUNIT_TEST( testRandomSubsamplingDistribution );
+	CPPUNIT_TEST( testMaxPointsPerVoxelSubsampling );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp();
+	void tearDown();
+
+	void testRandomNumberGenerator();
+	void testStrideSubsampling();
+	void testRandomSubsampling();
+	void testRandomSubsamplingDistribution();
+	void testMaxPointsPerVoxelSubsampling();
+
+private:
+
+	/// Feed the point cloud in chunks of the given size into the filter.
+	void filterInChunks(SubsamplingFilter* filter, unsigned int chunkSize, PointCloud3D* result);
+
+	static const double maxTolerance = 0.00001;
+
+	/// Points with x = 0, 1, 2, ... The y coordinate encodes the index as well.
+	PointCloud3D* pointCloud;
+};
+
+}
+
+#endif /* SUBSAMPLINGTEST_H_ */
+
+/* EOF */
@@ -7,11 +7,15 @@
  */
 
 #include "TriangleMeshTest.h"
+#include <cstdio>
 
 namespace unitTests {
 
 CPPUNIT_TEST_SUITE_REGISTRATION( TriangleMeshTest );
 
+const char* TriangleMeshTest::plyFileName = "triangleMeshTest.ply";
+const char* TriangleMeshTest::stlFileName = "triangleMeshTest.stl";
+
 
 void TriangleMeshTest::setUp() {
 	abstractMesh = 0;
@@ -57,6 +61,9 @@ void TriangleMeshTest::tearDown() {
 	delete vertex001;
 	delete vertex110;
 	delete vertex111;
+
+	std::remove(plyFileName);
+	std::remove(stlFileName);
 }
 
 void TriangleMeshTest::testExplicitMeshConstructor() {
@@ -167,6 +174,136 @@ void TriangleMeshTest::testImplicitMeshModification() {
 	delete mesh;
 }
 
+void TriangleMeshTest::checkEqualTriangles(ITriangleMesh* expected, ITriangleMesh* actual, double tolerance) {
+	CPPUNIT_ASSERT_EQUAL(expected->getSize(), actual->getSize());
+	for (int i = 0; i < expected->getSize(); ++i) {
+		for (int j = 0; j < 3; ++j) {
+			CPPUNIT_ASSERT_DOUBLES_EQUAL(expected->getTriangleVertex(i, j)->getX(), actual->getTriangleVertex(i, j)->getX(), tolerance);
+			CPPUNIT_ASSERT_DOUBLES_EQUAL(expected->getTriangleVertex(i, j)->getY(), actual->getTriangleVertex(i, j)->getY(), tolerance);
+			CPPUNIT_ASSERT_DOUBLES_EQUAL(expected->getTriangleVertex(i, j)->getZ(), actual->getTriangleVertex(i, j)->getZ(), tolerance);
+		}
+	}
+}
+
+void TriangleMeshTest::testVertexWelding() {
+	TriangleMeshImplicit* mesh = new TriangleMeshImplicit();
+	CPPUNIT_ASSERT(!mesh->isVertexWeldingEnabled());
+
+	/* exact welding */
+	mesh->enableVertexWelding();
+	CPPUNIT_ASSERT(mesh->isVertexWeldingEnabled());
+	CPPUNIT_ASSERT_EQUAL(0, mesh->addTriangle(*testTriangle1->getVertex(0), *testTriangle1->getVertex(1), *testTriangle1->getVertex(2)));
+	CPPUNIT_ASSERT_EQUAL(3, mesh->getNumberOfVertices());
+	mesh->addTriangle(*testTriangle2->getVertex(0), *testTriangle2->getVertex(1), *testTriangle2->getVertex(2));
+	CPPUNIT_ASSERT_EQUAL(4, mesh->getNumberOfVertices());
+	mesh->addTriangle(*testTriangle3->getVertex(0), *testTriangle3->getVertex(1), *testTriangle3->getVertex(2));
+	CPPUNIT_ASSERT_EQUAL(5, mesh->getNumberOfVertices());
+	CPPUNIT_ASSERT_EQUAL(3, mesh->addTriangle(*testTriangle4->getVertex(0), *testTriangle4->getVertex(1), *testTriangle4->getVertex(2)));
+	CPPUNIT_ASSERT_EQUAL(6, mesh->getNumberOfVertices());
+	CPPUNIT_ASSERT_EQUAL(4, mesh->getSize());
+
+	/* shared vertices are referenced by the same index */
+	CPPUNIT_ASSERT_EQUAL((*mesh->getIndices())[2], (*mesh->getIndices())[3]); // (1,0,1)
+	CPPUNIT_ASSERT_EQUAL((*mesh->getIndices())[0], (*mesh->getIndices())[5]); // (0,0,0)
+
+	/* getTriangleVertex resolves the indices */
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, mesh->getTriangleVertex(3, 2)->getX(), maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, mesh->getTriangleVertex(3, 2)->getY(), maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, mesh->getTriangleVertex(3, 2)->getZ(), maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, mesh->getTriangleVertex(1, 1)->getX(), maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, mesh->getTriangleVertex(1, 1)->getZ(), maxTolerance);
+
+	/* a slightly displaced vertex is only welded with a tolerance */
+	Point3D displaced(1.0 + 0.001, 1.0, 1.0);
+	mesh->addTriangle(*vertex000, *vertex110, displaced);
+	CPPUNIT_ASSERT_EQUAL(7, mesh->getNumberOfVertices());
+
+	mesh->enableVertexWelding(0.01);
+	mesh->addTriangle(*vertex000, *vertex110, displaced);
+	CPPUNIT_ASSERT_EQUAL(7, mesh->getNumberOfVertices());
+	Point3D displaced2(1.0, 1.0 - 0.005, 1.0 + 0.005);
+	mesh->addTriangle(*vertex001, *vertex100, displaced2);
+	CPPUNIT_ASSERT_EQUAL(7, mesh->getNumberOfVertices());
+	CPPUNIT_ASSERT_EQUAL(7, mesh->getSize());
+
+	/* without welding every vertex is appended */
+	mesh->disableVertexWelding();
+	mesh->addTriangle(*vertex000, *vertex100, *vertex101);
+	CPPUNIT_ASSERT_EQUAL(10, mesh->getNumberOfVertices());
+
+	delete mesh;
+}
+
+void TriangleMeshTest::testCopyFromExplicitMesh() {
+	TriangleMeshExplicit* soup = new TriangleMeshExplicit();
+	soup->addTriangle(testTriangle1);
+	soup->addTriangle(testTriangle2);
+	soup->addTriangle(testTriangle3);
+	soup->addTriangle(testTriangle4);
+	CPPUNIT_ASSERT_EQUAL(12, soup->getNumberOfVertices());
+
+	TriangleMeshImplicit* mesh = new TriangleMeshImplicit();
+	mesh->addTriangle(*vertex111, *vertex111, *vertex111); // will be replaced
+	mesh->copyFrom(soup);
+	CPPUNIT_ASSERT_EQUAL(4, mesh->getSize());
+	CPPUNIT_ASSERT_EQUAL(6, mesh->getNumberOfVertices());
+	CPPUNIT_ASSERT_EQUAL(12, static_cast<int>(mesh->getIndices()->size()));
+	checkEqualTriangles(soup, mesh, maxTolerance);
+
+	delete mesh;
+	delete soup;
+}
+
+void TriangleMeshTest::testMeshFileIO() {
+	TriangleMeshImplicit* mesh = new TriangleMeshImplicit();
+	mesh->enableVertexWelding();
+	mesh->addTriangle(*vertex000, *vertex100, *vertex101);
+	mesh->addTriangle(*vertex101, *vertex001, *vertex000);
+	mesh->addTriangle(*vertex100, *vertex110, *vertex101);
+	mesh->addTriangle(*vertex101, *vertex110, Point3D(1.5, 1.25, 0.125));
+	CPPUNIT_ASSERT_EQUAL(6, mesh->getNumberOfVertices());
+
+	/* PLY, binary and ascii */
+	TriangleMeshImplicit* resultMesh = new TriangleMeshImplicit();
+	PlyFileHandler::write(mesh, plyFileName);
+	PlyFileHandler::read(plyFileName, resultMesh);
+	CPPUNIT_ASSERT_EQUAL(6, resultMesh->getNumberOfVertices());
+	checkEqualTriangles(mesh, resultMesh, maxTolerance);
+
+	PlyFileHandler::write(mesh, plyFileName, PlyFileHandler::ascii);
+	PlyFileHandler::read(plyFileName, resultMesh);
+	CPPUNIT_ASSERT_EQUAL(6, resultMesh->getNumberOfVertices());
+	checkEqualTriangles(mesh, resultMesh, maxTolerance);
+
+	/* STL stores a triangle soup; reading welds the vertices again */
+	StlFileHandler::write(mesh, stlFileName);
+	StlFileHandler::read(stlFileName, resultMesh);
+	CPPUNIT_ASSERT_EQUAL(4, resultMesh->getSize());
+	CPPUNIT_ASSERT_EQUAL(6, resultMesh->getNumberOfVertices());
+	checkEqualTriangles(mesh, resultMesh, maxTolerance);
+
+	/* ascii STL */
+	FILE* stlFile = std::fopen(stlFileName, "w");
+	CPPUNIT_ASSERT(stlFile != 0);
+	std::fprintf(stlFile, "solid test\n");
+	for (int i = 0; i < mesh->getSize(); ++i) {
+		std::fprintf(stlFile, " facet normal 0 0 0\n  outer loop\n");
+		for (int j = 0; j < 3; ++j) {
+			Point3D* vertex = mesh->getTriangleVertex(i, j);
+			std::fprintf(stlFile, "   vertex %f %f %f\n", vertex->getX(), vertex->getY(), vertex->getZ());
+		}
+		std::fprintf(stlFile, "  endloop\n endfacet\n");
+	}
+	std::fprintf(stlFile, "endsolid test\n");
+	std::fclose(stlFile);
+	StlFileHandler::read(stlFileName, resultMesh);
+	CPPUNIT_ASSERT_EQUAL(6, resultMesh->getNumberOfVertices());
+	checkEqualTriangles(mesh, resultMesh, maxTolerance);
+
+	delete resultMesh;
+	delete mesh;
+}
+
 }
 
 /* EOF */
@@ -14,6 +14,8 @@
 
 #include "brics_3d/core/TriangleMeshExplicit.h"
 #include "brics_3d/core/TriangleMeshImplicit.h"
+#include "brics_3d/core/PlyFileHandler.h"
+#include "brics_3d/core/StlFileHandler.h"
 
 using namespace brics_3d;
 using namespace std;
@@ -28,6 +30,9 @@ class TriangleMeshTest : public CPPUNIT_NS::TestFixture {
 	CPPUNIT_TEST( testImplicitMeshConstructor );
 	CPPUNIT_TEST( testPolymorphMeshConstructor );
 	CPPUNIT_TEST( testImplicitMeshModification );
+	CPPUNIT_TEST( testVertexWelding );
+	CPPUNIT_TEST( testCopyFromExplicitMesh );
+	CPPUNIT_TEST( testMeshFileIO );
 	CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -38,6 +43,9 @@ public:
 	void testImplicitMeshConstructor();
 	void testPolymorphMeshConstructor();
 	void testImplicitMeshModification();
+	void testVertexWelding();
+	void testCopyFromExplicitMesh();
+	void testMeshFileIO();
 
 private:
 
@@ -55,6 +63,13 @@ private:
 
 	ITriangleMesh* abstractMesh;
 
+	/// Checks that both meshes describe the same triangles.
+	void checkEqualTriangles(ITriangleMesh* expected, ITriangleMesh* actual, double tolerance);
+
+	static const double maxTolerance = 0.00001;
+	static const char* plyFileName;
+	static const char* stlFileName;
+
 };
 
 }
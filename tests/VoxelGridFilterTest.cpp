@@ -0,0 +1,175 @@
+/**
+ * @file 
+ * VoxelGridFilterTest.cpp
+ *
+ * @date: Oct 17, 2026
+ * @author: sblume
+ */
+
+#include "VoxelGridFilterTest.h"
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+
+namespace unitTests {
+
+CPPUNIT_TEST_SUITE_REGISTRATION( VoxelGridFilterTest );
+
+void VoxelGridFilterTest::setUp() {
+	pointCloud = new PointCloud3D();
+	pointCloud->addPointPtr(new ColoredPoint3D(new Point3D(0.1, 0.1, 0.1), 255, 0, 0));
+	pointCloud->addPoint(Point3D(5.2, 0.2, 0.3));
+	pointCloud->addPoint(Point3D(0.2, 0.3, 0.2));
+	pointCloud->addPoint(Point3D(0.3, 0.2, 0.6));
+	pointCloud->addPoint(Point3D(5.3, 0.4, 0.1));
+	pointCloud->addPoint(Point3D(2.9, 2.9, 2.9));
+}
+
+void VoxelGridFilterTest::tearDown() {
+	delete pointCloud;
+}
+
+void VoxelGridFilterTest::testSetupInterface() {
+	IOctreeSetup* setup = new VoxelGridFilter();
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.0, setup->getVoxelSize(), maxTolerance);
+	setup->setVoxelSize(0.5);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.5, setup->getVoxelSize(), maxTolerance);
+
+	CPPUNIT_ASSERT_THROW(setup->setVoxelSize(-1.0), std::runtime_error);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.5, setup->getVoxelSize(), maxTolerance);
+	delete setup;
+
+	VoxelGridFilter filter(1.0, VoxelGridFilter::firstPoint);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0, filter.getVoxelSize(), maxTolerance);
+	CPPUNIT_ASSERT(filter.getSelectionMode() == VoxelGridFilter::firstPoint);
+	filter.setSelectionMode(VoxelGridFilter::voxelCenter);
+	CPPUNIT_ASSERT(filter.getSelectionMode() == VoxelGridFilter::voxelCenter);
+	CPPUNIT_ASSERT_EQUAL(0u, filter.getMaxNumberOfThreads());
+	filter.setMaxNumberOfThreads(2);
+	CPPUNIT_ASSERT_EQUAL(2u, filter.getMaxNumberOfThreads());
+
+	/* voxel size 0 copies the data */
+	IOctreeReductionFilter* reductionFilter = new VoxelGridFilter();
+	PointCloud3D resultPointCloud;
+	reductionFilter->filter(pointCloud, &resultPointCloud);
+	CPPUNIT_ASSERT_EQUAL(6u, resultPointCloud.getSize());
+	delete reductionFilter;
+}
+
+void VoxelGridFilterTest::testSelectionModes() {
+	VoxelGridFilter filter(1.0);
+	PointCloud3D resultPointCloud;
+
+	/* centroid; the output is ordered by the first occurrence of a voxel */
+	filter.filter(pointCloud, &resultPointCloud);
+	CPPUNIT_ASSERT_EQUAL(3u, resultPointCloud.getSize());
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.2, (*resultPointCloud.getPointCloud())[0].getX(), maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.2, (*resultPointCloud.getPointCloud())[0].getY(), maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.3, (*resultPointCloud.getPointCloud())[0].getZ(), maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(5.25, (*resultPointCloud.getPointCloud())[1].getX(), maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.3, (*resultPointCloud.getPointCloud())[1].getY(), maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.2, (*resultPointCloud.getPointCloud())[1].getZ(), maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(2.9, (*resultPointCloud.getPointCloud())[2].getX(), maxTolerance);
+
+	/* decorations of the first point are preserved */
+	ColoredPoint3D* coloredPoint = dynamic_cast<ColoredPoint3D*>(&(*resultPointCloud.getPointCloud())[0]);
+	CPPUNIT_ASSERT(coloredPoint != 0);
+	CPPUNIT_ASSERT_EQUAL(255, static_cast<int>(coloredPoint->getR()));
+
+	/* first point */
+	resultPointCloud.getPointCloud()->clear();
+	filter.setSelectionMode(VoxelGridFilter::firstPoint);
+	filter.filter(pointCloud, &resultPointCloud);
+	CPPUNIT_ASSERT_EQUAL(3u, resultPointCloud.getSize());
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.1, (*resultPointCloud.getPointCloud())[0].getX(), maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(5.2, (*resultPointCloud.getPointCloud())[1].getX(), maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.2, (*resultPointCloud.getPointCloud())[1].getY(), maxTolerance);
+
+	/* voxel center; the grid starts at the minimum (0.1, 0.1, 0.1) */
+	filter.setSelectionMode(VoxelGridFilter::voxelCenter);
+	filter.filter(pointCloud, &resultPointCloud);
+	CPPUNIT_ASSERT_EQUAL(3u, resultPointCloud.getSize());
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.6, (*resultPointCloud.getPointCloud())[0].getX(), maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.6, (*resultPointCloud.getPointCloud())[0].getZ(), maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(5.6, (*resultPointCloud.getPointCloud())[1].getX(), maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(2.6, (*resultPointCloud.getPointCloud())[2].getY(), maxTolerance);
+
+	/* invalid points are skipped */
+	pointCloud->addPoint(Point3D(std::numeric_limits<double>::quiet_NaN(), 0, 0));
+	filter.filter(pointCloud, &resultPointCloud);
+	CPPUNIT_ASSERT_EQUAL(3u, resultPointCloud.getSize());
+
+	/* too many voxels for the extent */
+	filter.setVoxelSize(1e-9);
+	CPPUNIT_ASSERT_THROW(filter.filter(pointCloud, &resultPointCloud), std::runtime_error);
+}
+
+void VoxelGridFilterTest::testContiguousPointCloud() {
+	PointCloud3DContiguous contiguousCloud;
+	contiguousCloud.copyFrom(pointCloud);
+	CPPUNIT_ASSERT(contiguousCloud.hasColors());
+	PointCloud3DContiguous resultCloud;
+
+	VoxelGridFilter filter(1.0);
+	filter.filter(contiguousCloud, resultCloud);
+	CPPUNIT_ASSERT_EQUAL(3u, resultCloud.getSize());
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.2, resultCloud.getXCoordinates()[0], maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(0.3, resultCloud.getZCoordinates()[0], maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(5.25, resultCloud.getXCoordinates()[1], maxTolerance);
+	CPPUNIT_ASSERT(resultCloud.hasColors());
+	CPPUNIT_ASSERT_EQUAL(255, static_cast<int>(resultCloud.getColors()[0]));
+
+	PointCloud3DContiguousFloat floatCloud;
+	floatCloud.copyFrom(contiguousCloud);
+	PointCloud3DContiguousFloat floatResultCloud;
+	filter.setSelectionMode(VoxelGridFilter::firstPoint);
+	filter.filter(floatCloud, floatResultCloud);
+	CPPUNIT_ASSERT_EQUAL(3u, floatResultCloud.getSize());
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(5.2, floatResultCloud.getXCoordinates()[1], maxTolerance);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(2.9, floatResultCloud.getXCoordinates()[2], maxTolerance);
+
+	/* voxel size 0 copies the data */
+	filter.setVoxelSize(0.0);
+	filter.filter(floatCloud, floatResultCloud);
+	CPPUNIT_ASSERT_EQUAL(6u, floatResultCloud.getSize());
+}
+
+void VoxelGridFilterTest::testParallelBinning() {
+	PointCloud3DContiguous contiguousCloud;
+	std::srand(0);
+	unsigned int numberOfPoints = 2 * VoxelGridFilter::parallelThreshold + 17;
+	contiguousCloud.reserve(numberOfPoints);
+	for (unsigned int i = 0; i < numberOfPoints; ++i) {
+		contiguousCloud.addPoint(std::rand() % 1000 / 100.0, std::rand() % 1000 / 100.0, std::rand() % 1000 / 100.0);
+	}
+
+	VoxelGridFilter filter(0.5);
+	PointCloud3DContiguous sequentialResult;
+	filter.setMaxNumberOfThreads(1);
+	filter.filter(contiguousCloud, sequentialResult);
+	CPPUNIT_ASSERT_EQUAL(8000u, sequentialResult.getSize()); // 20 x 20 x 20 voxels
+
+	/* the parallel version yields the same voxels in the same order */
+	PointCloud3DContiguous parallelResult;
+	filter.setMaxNumberOfThreads(4);
+	filter.filter(contiguousCloud, parallelResult);
+	CPPUNIT_ASSERT_EQUAL(sequentialResult.getSize(), parallelResult.getSize());
+	for (unsigned int i = 0; i < sequentialResult.getSize(); ++i) {
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(sequentialResult.getXCoordinates()[i], parallelResult.getXCoordinates()[i], maxTolerance);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(sequentialResult.getYCoordinates()[i], parallelResult.getYCoordinates()[i], maxTolerance);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL(sequentialResult.getZCoordinates()[i], parallelResult.getZCoordinates()[i], maxTolerance);
+	}
+
+	/* the PointCloud3D version agrees */
+	PointCloud3D legacyCloud;
+	contiguousCloud.copyTo(&legacyCloud);
+	PointCloud3D legacyResult;
+	filter.filter(&legacyCloud, &legacyResult);
+	CPPUNIT_ASSERT_EQUAL(sequentialResult.getSize(), legacyResult.getSize());
+	CPPUNIT_ASSERT_DOUBLES_EQUAL(sequentialResult.getXCoordinates()[42], (*legacyResult.getPointCloud())[42].getX(), maxTolerance);
+}
+
+}
+
+/* EOF */
@@ -0,0 +1,54 @@
+/**
+ * @file 
+ * VoxelGridFilterTest.h
+ *
+ * @date: Oct 17, 2026
+ * @author: sblume
+ */
+
+#ifndef VOXELGRIDFILTERTEST_H_
+#define VOXELGRIDFILTERTEST_H_
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "brics_3d/algorithm/filtering/VoxelGridFilter.h"
+#include "brics_3d/algorithm/filtering/Octree.h"
+#include "brics_3d/core/ColoredPoint3D.h"
+
+using namespace std;
+using namespace brics_3d;
+
+namespace unitTests {
+
+class VoxelGridFilterTest : public CPPUNIT_NS::TestFixture {
+
+	CPPUNIT_TEST_SUITE( VoxelGridFilterTest );
+	CPPUNIT_TEST( testSetupInterface );
+	CPPUNIT_TEST( testSelectionModes );
+	CPPUNIT_TEST( testContiguousPointCloud );
+	CPPUNIT_TEST( testParallelBinning );
+	CPPUNIT_TEST_SUITE_END();
+
+public:
+	void setUp();
+	void tearDown();
+
+	void testSetupInterface();
+	void testSelectionModes();
+	void testContiguousPointCloud();
+	void testParallelBinning();
+
+private:
+
+	static const double maxTolerance = 0.00001;
+
+	/// Two clusters with 3 and 2 points and one single point.
+	PointCloud3D* pointCloud;
+};
+
+}
+
+#endif /* VOXELGRIDFILTERTEST_H_ */
+
+/* EOF */